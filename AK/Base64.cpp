@@ -7,6 +7,8 @@
 #include <AK/Array.h>
 #include <AK/Base64.h>
 #include <AK/ByteBuffer.h>
+#include <AK/CharacterTypes.h>
+#include <AK/SIMD.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
 #include <AK/StringView.h>
@@ -52,22 +54,84 @@ size_t calculate_base64_encoded_length(ReadonlyBytes input)
 
 ByteBuffer decode_base64(const StringView& input)
 {
+    // Be tolerant of ASCII whitespace: PEM certificates and data: URIs are
+    // routinely wrapped with newlines.
+    Vector<char> compacted;
+    StringView data = input;
+    if (input.contains('\n') || input.contains('\r') || input.contains(' ') || input.contains('\t')) {
+        compacted.ensure_capacity(input.length());
+        for (auto ch : input) {
+            if (!is_ascii_space(ch))
+                compacted.append(ch);
+        }
+        data = { compacted.data(), compacted.size() };
+    }
+
     auto get = [&](const size_t offset, bool* is_padding = nullptr) -> u8 {
         constexpr auto table = make_lookup_table();
-        if (offset >= input.length())
+        if (offset >= data.length())
             return 0;
-        if (input[offset] == '=') {
+        if (data[offset] == '=') {
             if (is_padding)
                 *is_padding = true;
             return 0;
         }
-        return table[input[offset]];
+        return table[static_cast<u8>(data[offset])];
     };
 
     Vector<u8> output;
-    output.ensure_capacity(calculate_base64_decoded_length(input));
+    size_t i = 0;
+
+#if !defined(KERNEL) && defined(__SSSE3__)
+    // Translate 16 characters to 12 bytes per step with the usual
+    // lookup-shuffle technique: map ASCII to 6-bit values with a per-nibble
+    // shift table, then merge the 6-bit fields with two multiply-adds.
+    // The final (possibly padded) quantum is always left to the scalar loop.
+    if (data.length() >= 16 + 4) {
+        using AK::SIMD::c8x16;
+        using AK::SIMD::i8x16;
+        using AK::SIMD::i16x8;
+        using AK::SIMD::i32x4;
+
+        output.resize_uninitialized(data.length() / 4 * 3 + 4);
+        size_t output_index = 0;
+
+        constexpr c8x16 shift_lut = { 0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0 };
+        constexpr c8x16 pack_shuffle = { 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1 };
+        constexpr i8x16 merge_bytes = { 0x40, 0x01, 0x40, 0x01, 0x40, 0x01, 0x40, 0x01, 0x40, 0x01, 0x40, 0x01, 0x40, 0x01, 0x40, 0x01 };
+        constexpr i16x8 merge_words = { 0x1000, 0x0001, 0x1000, 0x0001, 0x1000, 0x0001, 0x1000, 0x0001 };
+
+        while (i + 16 + 4 <= data.length()) {
+            c8x16 chunk;
+            __builtin_memcpy(&chunk, data.characters_without_null_termination() + i, 16);
+
+            // Bail to the scalar loop if this chunk contains padding.
+            if (__builtin_ia32_pmovmskb128((c8x16)(chunk == '=')))
+                break;
+
+            auto hi_nibbles = (c8x16)(((AK::SIMD::u16x8)chunk >> 4) & 0x0f0f);
+            auto shift = __builtin_ia32_pshufb128(shift_lut, hi_nibbles);
+            auto eq_2f = (c8x16)(chunk == '/');
+            // The shift table yields 19 ('+') for the 0x2X column; '/' needs 16.
+            shift = (c8x16)(shift - (eq_2f & 3));
+
+            auto values = (c8x16)(chunk + shift);
+            auto merged16 = __builtin_ia32_pmaddubsw128(values, (c8x16)merge_bytes);
+            auto merged32 = __builtin_ia32_pmaddwd128(merged16, merge_words);
+            auto packed = __builtin_ia32_pshufb128((c8x16)merged32, pack_shuffle);
+
+            __builtin_memcpy(output.data() + output_index, &packed, 16);
+            output_index += 12;
+            i += 16;
+        }
+
+        output.resize(output_index, true);
+    }
+#endif
 
-    for (size_t i = 0; i < input.length(); i += 4) {
+    output.ensure_capacity(output.size() + calculate_base64_decoded_length(data.substring_view(i)));
+
+    for (; i < data.length(); i += 4) {
         bool in2_is_padding = false;
         bool in3_is_padding = false;
 
@@ -94,7 +158,53 @@ ByteBuffer decode_base64(const StringView& input)
 String encode_base64(ReadonlyBytes input)
 {
     constexpr auto alphabet = make_alphabet();
-    StringBuilder output(calculate_base64_encoded_length(input));
+
+    auto output_length = calculate_base64_encoded_length(input);
+    if (!output_length)
+        return String::empty();
+
+    char* buffer = nullptr;
+    auto impl = StringImpl::create_uninitialized(output_length, buffer);
+    size_t output_index = 0;
+    size_t i = 0;
+
+#if !defined(KERNEL) && defined(__SSSE3__)
+    // Translate 12 bytes to 16 characters per step: split out the four 6-bit
+    // fields with two multiplies, then add the per-range ASCII offset looked
+    // up via a shuffle.
+    {
+        using AK::SIMD::c8x16;
+        using AK::SIMD::i8x16;
+        using AK::SIMD::i16x8;
+        using AK::SIMD::u16x8;
+        using AK::SIMD::u32x4;
+
+        constexpr c8x16 spread_shuffle = { 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10 };
+        constexpr c8x16 offset_lut = { 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 65, 0, 0 };
+
+        while (i + 16 <= input.size()) {
+            c8x16 chunk;
+            __builtin_memcpy(&chunk, input.data() + i, 16);
+
+            auto in = __builtin_ia32_pshufb128(chunk, spread_shuffle);
+            auto t0 = (u32x4)in & 0x0fc0fc00;
+            auto t1 = __builtin_ia32_pmulhuw128((i16x8)t0, (i16x8)(u16x8) { 0x0040, 0x0400, 0x0040, 0x0400, 0x0040, 0x0400, 0x0040, 0x0400 });
+            auto t2 = (u32x4)in & 0x003f03f0;
+            auto t3 = (u16x8)t2 * (u16x8) { 0x0010, 0x0100, 0x0010, 0x0100, 0x0010, 0x0100, 0x0010, 0x0100 };
+            auto indices = (c8x16)((u32x4)t1 | (u32x4)t3);
+
+            auto reduced = (c8x16)__builtin_ia32_psubusb128(indices, (c8x16)(i8x16 {} + 51));
+            auto less = (c8x16)(indices < (c8x16)(i8x16 {} + 26));
+            reduced = (c8x16)(reduced | (less & 13));
+            auto offsets = __builtin_ia32_pshufb128(offset_lut, reduced);
+            auto ascii = (c8x16)(indices + offsets);
+
+            __builtin_memcpy(buffer + output_index, &ascii, 16);
+            output_index += 16;
+            i += 12;
+        }
+    }
+#endif
 
     auto get = [&](const size_t offset, bool* need_padding = nullptr) -> u8 {
         if (offset >= input.size()) {
@@ -105,7 +215,7 @@ String encode_base64(ReadonlyBytes input)
         return input[offset];
     };
 
-    for (size_t i = 0; i < input.size(); i += 3) {
+    for (; i < input.size(); i += 3) {
         bool is_8bit = false;
         bool is_16bit = false;
 
@@ -118,18 +228,14 @@ String encode_base64(ReadonlyBytes input)
         const u8 index2 = ((in1 << 2) | (in2 >> 6)) & 0x3f;
         const u8 index3 = in2 & 0x3f;
 
-        const u8 out0 = alphabet[index0];
-        const u8 out1 = alphabet[index1];
-        const u8 out2 = is_16bit ? '=' : alphabet[index2];
-        const u8 out3 = is_8bit ? '=' : alphabet[index3];
-
-        output.append(out0);
-        output.append(out1);
-        output.append(out2);
-        output.append(out3);
+        buffer[output_index++] = alphabet[index0];
+        buffer[output_index++] = alphabet[index1];
+        buffer[output_index++] = is_16bit ? '=' : alphabet[index2];
+        buffer[output_index++] = is_8bit ? '=' : alphabet[index3];
     }
 
-    return output.to_string();
+    VERIFY(output_index == output_length);
+    return String(move(impl));
 }
 
 }
@@ -146,6 +146,156 @@ private:
     InputStream& m_stream;
 };
 
+// A little-endian (lsb-first) input bit stream that buffers up to 64 bits in a
+// reservoir refilled with whole-word reads from the underlying stream. This
+// makes individual bit reads much cheaper than InputBitStream's, and it allows
+// peeking a handful of bits ahead of consuming them, which table-driven
+// Huffman decoders depend on.
+//
+// Note that the reservoir may buffer bytes past the data the user of this
+// stream is interested in, so anything following the bit-packed data (e.g. a
+// trailing checksum) has to be read through this stream as well.
+class LittleEndianInputBitStream final : public InputStream {
+public:
+    explicit LittleEndianInputBitStream(InputStream& stream)
+        : m_stream(stream)
+    {
+    }
+
+    size_t read(Bytes bytes) override
+    {
+        if (has_any_error())
+            return 0;
+
+        // Whole bytes can only be handed out on a byte boundary.
+        VERIFY(m_bit_count % 8 == 0);
+
+        size_t nread = 0;
+        while (m_bit_count > 0 && nread < bytes.size()) {
+            bytes[nread++] = m_buffer & 0xff;
+            m_buffer >>= 8;
+            m_bit_count -= 8;
+        }
+
+        return nread + m_stream.read(bytes.slice(nread));
+    }
+
+    bool read_or_error(Bytes bytes) override
+    {
+        if (read(bytes) != bytes.size()) {
+            set_fatal_error();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool discard_or_error(size_t count) override
+    {
+        VERIFY(m_bit_count % 8 == 0);
+
+        while (m_bit_count > 0 && count > 0) {
+            m_buffer >>= 8;
+            m_bit_count -= 8;
+            --count;
+        }
+
+        if (count == 0)
+            return true;
+
+        return m_stream.discard_or_error(count);
+    }
+
+    bool unreliable_eof() const override { return m_bit_count == 0 && m_stream.unreliable_eof(); }
+
+    u64 read_bits(size_t count)
+    {
+        VERIFY(count <= maximum_reliable_bit_count);
+
+        if (m_bit_count < count) {
+            refill_reservoir();
+
+            if (m_bit_count < count) {
+                set_fatal_error();
+                return 0;
+            }
+        }
+
+        const u64 result = m_buffer & (((u64)1 << count) - 1);
+        m_buffer >>= count;
+        m_bit_count -= count;
+        return result;
+    }
+
+    bool read_bit() { return static_cast<bool>(read_bits(1)); }
+
+    // Returns the next count bits without consuming them. Bits past the end of
+    // the underlying stream read as zero; they only become an error if they
+    // are actually consumed later on.
+    u32 peek_bits(size_t count)
+    {
+        VERIFY(count <= 32 && count <= maximum_reliable_bit_count);
+
+        if (m_bit_count < count)
+            refill_reservoir();
+
+        return m_buffer & (((u64)1 << count) - 1);
+    }
+
+    void discard_bits(size_t count)
+    {
+        if (m_bit_count < count) {
+            // We're consuming (zero) bits that peek_bits() made up past the
+            // end of the underlying stream.
+            set_fatal_error();
+            m_buffer = 0;
+            m_bit_count = 0;
+            return;
+        }
+
+        m_buffer >>= count;
+        m_bit_count -= count;
+    }
+
+    void align_to_byte_boundary()
+    {
+        const auto partial_bits = m_bit_count % 8;
+        m_buffer >>= partial_bits;
+        m_bit_count -= partial_bits;
+    }
+
+    bool handle_any_error() override
+    {
+        bool handled_errors = m_stream.handle_any_error();
+        return Stream::handle_any_error() || handled_errors;
+    }
+
+private:
+    // The reservoir holds at most 63 bits after a refill (with 7 bits already
+    // buffered, only 7 more bytes fit), so this is the largest read that is
+    // guaranteed to succeed on a sufficiently long stream.
+    static constexpr size_t maximum_reliable_bit_count = 57;
+
+    void refill_reservoir()
+    {
+        while (m_bit_count + 8 <= 64) {
+            u8 bytes[8];
+            const auto nread = m_stream.read({ bytes, (64 - m_bit_count) / 8 });
+            if (nread == 0)
+                return;
+
+            for (size_t i = 0; i < nread; ++i) {
+                m_buffer |= (u64)bytes[i] << m_bit_count;
+                m_bit_count += 8;
+            }
+        }
+    }
+
+    u64 m_buffer { 0 };
+    size_t m_bit_count { 0 };
+    InputStream& m_stream;
+};
+
 class OutputBitStream final : public OutputStream {
 public:
     explicit OutputBitStream(OutputStream& stream)
@@ -239,4 +389,5 @@ private:
 }
 
 using AK::InputBitStream;
+using AK::LittleEndianInputBitStream;
 using AK::OutputBitStream;
@@ -4,9 +4,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
 #include <AK/FlyString.h>
 #include <AK/HashTable.h>
 #include <AK/Optional.h>
+#include <AK/ScopeGuard.h>
 #include <AK/Singleton.h>
 #include <AK/String.h>
 #include <AK/StringUtils.h>
@@ -24,16 +27,49 @@ struct FlyStringImplTraits : public Traits<StringImpl*> {
     }
 };
 
-static Singleton<HashTable<StringImpl*, FlyStringImplTraits>> s_table;
+// The intern table is sharded by string hash so that parser threads interning
+// different names rarely contend on the same lock. Each shard is guarded by a
+// tiny spinlock; the critical sections are just a hash lookup or insert.
+struct InternTableShard {
+    void lock()
+    {
+        while (m_lock.exchange(true, AK::memory_order_acquire)) {
+            while (m_lock.load(AK::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    void unlock()
+    {
+        m_lock.store(false, AK::memory_order_release);
+    }
+
+    HashTable<StringImpl*, FlyStringImplTraits> table;
+
+private:
+    Atomic<bool> m_lock { false };
+};
+
+static constexpr size_t intern_table_shard_count = 16;
+static_assert((intern_table_shard_count & (intern_table_shard_count - 1)) == 0);
 
-static HashTable<StringImpl*, FlyStringImplTraits>& fly_impls()
+static Singleton<Array<InternTableShard, intern_table_shard_count>> s_table;
+
+static InternTableShard& shard_for_hash(unsigned hash)
 {
-    return *s_table;
+    return (*s_table)[hash & (intern_table_shard_count - 1)];
 }
 
 void FlyString::did_destroy_impl(Badge<StringImpl>, StringImpl& impl)
 {
-    fly_impls().remove(&impl);
+    auto& shard = shard_for_hash(impl.hash());
+    shard.lock();
+    ScopeGuard unlock = [&] { shard.unlock(); };
+    // Remove by pointer identity: an equal (but distinct) impl may have been
+    // interned in our place while we were waiting to die.
+    auto it = shard.table.find(impl.hash(), [&](auto& candidate) { return candidate == &impl; });
+    if (it != shard.table.end())
+        shard.table.remove(it);
 }
 
 FlyString::FlyString(const String& string)
@@ -44,33 +80,50 @@ FlyString::FlyString(const String& string)
         m_impl = string.impl();
         return;
     }
-    auto it = fly_impls().find(const_cast<StringImpl*>(string.impl()));
-    if (it == fly_impls().end()) {
-        fly_impls().set(const_cast<StringImpl*>(string.impl()));
-        string.impl()->set_fly({}, true);
-        m_impl = string.impl();
-    } else {
+    auto& shard = shard_for_hash(string.impl()->hash());
+    shard.lock();
+    ScopeGuard unlock = [&] { shard.unlock(); };
+    auto it = shard.table.find(const_cast<StringImpl*>(string.impl()));
+    if (it != shard.table.end() && (*it)->try_ref()) {
         VERIFY((*it)->is_fly());
         m_impl = *it;
+        (*it)->unref();
+        return;
+    }
+    if (it != shard.table.end()) {
+        // The interned impl is concurrently being destroyed; evict it and
+        // intern ours instead.
+        shard.table.remove(it);
     }
+    shard.table.set(const_cast<StringImpl*>(string.impl()));
+    string.impl()->set_fly({}, true);
+    m_impl = string.impl();
 }
 
 FlyString::FlyString(StringView const& string)
 {
     if (string.is_null())
         return;
-    auto it = fly_impls().find(string.hash(), [&](auto& candidate) {
-        return string == candidate;
+    auto& shard = shard_for_hash(string.hash());
+    shard.lock();
+    ScopeGuard unlock = [&] { shard.unlock(); };
+    auto it = shard.table.find(string.hash(), [&](auto& candidate) {
+        // Compare via StringView so we never take a reference to a candidate
+        // whose last reference is concurrently being dropped.
+        return string == candidate->view();
     });
-    if (it == fly_impls().end()) {
-        auto new_string = string.to_string();
-        fly_impls().set(new_string.impl());
-        new_string.impl()->set_fly({}, true);
-        m_impl = new_string.impl();
-    } else {
+    if (it != shard.table.end() && (*it)->try_ref()) {
         VERIFY((*it)->is_fly());
         m_impl = *it;
+        (*it)->unref();
+        return;
     }
+    if (it != shard.table.end())
+        shard.table.remove(it);
+    auto new_string = string.to_string();
+    shard.table.set(new_string.impl());
+    new_string.impl()->set_fly({}, true);
+    m_impl = new_string.impl();
 }
 
 template<typename T>
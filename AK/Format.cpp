@@ -7,6 +7,7 @@
 #include <AK/CharacterTypes.h>
 #include <AK/Format.h>
 #include <AK/GenericLexer.h>
+#include <AK/MemMem.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
 #include <AK/kstdio.h>
@@ -77,24 +78,24 @@ static constexpr size_t convert_unsigned_to_string(u64 value, Array<u8, 128>& bu
 
 void vformat_impl(TypeErasedFormatParams& params, FormatBuilder& builder, FormatParser& parser)
 {
-    const auto literal = parser.consume_literal();
-    builder.put_literal(literal);
-
-    FormatParser::FormatSpecifier specifier;
-    if (!parser.consume_specifier(specifier)) {
-        VERIFY(parser.is_eof());
-        return;
-    }
-
-    if (specifier.index == use_next_index)
-        specifier.index = params.take_next_index();
+    for (;;) {
+        const auto literal = parser.consume_literal();
+        builder.put_literal(literal);
+
+        FormatParser::FormatSpecifier specifier;
+        if (!parser.consume_specifier(specifier)) {
+            VERIFY(parser.is_eof());
+            return;
+        }
 
-    auto& parameter = params.parameters().at(specifier.index);
+        if (specifier.index == use_next_index)
+            specifier.index = params.take_next_index();
 
-    FormatParser argparser { specifier.flags };
-    parameter.formatter(params, builder, argparser, parameter.value);
+        auto& parameter = params.parameters().at(specifier.index);
 
-    vformat_impl(params, builder, parser);
+        FormatParser argparser { specifier.flags };
+        parameter.formatter(params, builder, argparser, parameter.value);
+    }
 }
 
 } // namespace AK::{anonymous}
@@ -117,10 +118,20 @@ StringView FormatParser::consume_literal()
         if (next_is(is_any_of("{}")))
             return m_input.substring_view(begin, tell() - begin);
 
-        consume();
+        // Skip ahead to the next brace in one scan instead of lexing the
+        // literal character by character.
+        auto remainder = remaining();
+        auto const* characters = (const u8*)remainder.characters_without_null_termination();
+        auto next_open = find_first_byte(characters, remainder.length(), '{');
+        auto next_close = find_first_byte(characters, remainder.length(), '}');
+        if (!next_open.has_value() && !next_close.has_value()) {
+            ignore(remainder.length());
+            break;
+        }
+        ignore(min(next_open.value_or(NumericLimits<size_t>::max()), next_close.value_or(NumericLimits<size_t>::max())));
     }
 
-    return m_input.substring_view(begin);
+    return m_input.substring_view(begin, tell() - begin);
 }
 bool FormatParser::consume_number(size_t& value)
 {
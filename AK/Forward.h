@@ -22,6 +22,7 @@ class IPv4Address;
 class JsonArray;
 class JsonObject;
 class JsonValue;
+class SmallString;
 class StackInfo;
 class String;
 class StringBuilder;
@@ -38,6 +39,7 @@ class InputMemoryStream;
 class DuplexMemoryStream;
 class OutputStream;
 class InputBitStream;
+class LittleEndianInputBitStream;
 class OutputBitStream;
 class OutputMemoryStream;
 
@@ -68,6 +70,12 @@ class DoublyLinkedList;
 template<typename T, size_t capacity>
 class CircularQueue;
 
+template<typename T, size_t Capacity>
+class MPMCQueue;
+
+template<typename T, size_t Capacity>
+class SPSCQueue;
+
 template<typename T>
 struct Traits;
 
@@ -144,12 +152,14 @@ using AK::GenericLexer;
 using AK::HashMap;
 using AK::HashTable;
 using AK::InputBitStream;
+using AK::LittleEndianInputBitStream;
 using AK::InputMemoryStream;
 using AK::InputStream;
 using AK::IPv4Address;
 using AK::JsonArray;
 using AK::JsonObject;
 using AK::JsonValue;
+using AK::MPMCQueue;
 using AK::NonnullOwnPtr;
 using AK::NonnullOwnPtrVector;
 using AK::NonnullRefPtr;
@@ -162,7 +172,9 @@ using AK::OwnPtr;
 using AK::ReadonlyBytes;
 using AK::RefPtr;
 using AK::SinglyLinkedList;
+using AK::SmallString;
 using AK::Span;
+using AK::SPSCQueue;
 using AK::StackInfo;
 using AK::String;
 using AK::StringBuilder;
@@ -8,6 +8,7 @@
 
 #include <AK/Forward.h>
 #include <AK/HashFunctions.h>
+#include <AK/SIMD.h>
 #include <AK/StdLibExtras.h>
 #include <AK/Types.h>
 #include <AK/kmalloc.h>
@@ -83,6 +84,16 @@ template<typename T, typename TraitsForT, bool IsOrdered>
 class HashTable {
     static constexpr size_t load_factor_in_percent = 60;
 
+    // The unordered table keeps a separate byte of metadata per bucket: 0xff
+    // for an empty bucket, 0x80 for a tombstone, and the low 7 bits of the
+    // hash ("H2") for a used bucket. Lookups probe the metadata array in
+    // groups of 16 bytes (one SSE2 compare per group where available), so a
+    // probe touches at most one bucket cache line per candidate instead of
+    // one per probed slot.
+    static constexpr size_t group_size = 16;
+    static constexpr u8 metadata_empty = 0xff;
+    static constexpr u8 metadata_deleted = 0x80;
+
     struct Bucket {
         bool used;
         bool deleted;
@@ -130,6 +141,8 @@ public:
         }
 
         kfree_sized(m_buckets, size_in_bytes(m_capacity));
+        if constexpr (!IsOrdered)
+            kfree_sized(m_metadata, m_capacity);
     }
 
     HashTable(const HashTable& other)
@@ -148,6 +161,7 @@ public:
 
     HashTable(HashTable&& other) noexcept
         : m_buckets(other.m_buckets)
+        , m_metadata(other.m_metadata)
         , m_collection_data(other.m_collection_data)
         , m_size(other.m_size)
         , m_capacity(other.m_capacity)
@@ -157,6 +171,7 @@ public:
         other.m_capacity = 0;
         other.m_deleted_count = 0;
         other.m_buckets = nullptr;
+        other.m_metadata = nullptr;
         if constexpr (IsOrdered)
             other.m_collection_data = { nullptr, nullptr };
     }
@@ -171,6 +186,7 @@ public:
     friend void swap(HashTable& a, HashTable& b) noexcept
     {
         swap(a.m_buckets, b.m_buckets);
+        swap(a.m_metadata, b.m_metadata);
         swap(a.m_size, b.m_size);
         swap(a.m_capacity, b.m_capacity);
         swap(a.m_deleted_count, b.m_deleted_count);
@@ -326,6 +342,8 @@ public:
         bucket.slot()->~T();
         bucket.used = false;
         bucket.deleted = true;
+        if constexpr (!IsOrdered)
+            m_metadata[&bucket - m_buckets] = metadata_deleted;
         --m_size;
         ++m_deleted_count;
 
@@ -373,8 +391,13 @@ private:
     {
         new_capacity = max(new_capacity, static_cast<size_t>(4));
         new_capacity = kmalloc_good_size(new_capacity * sizeof(BucketType)) / sizeof(BucketType);
+        if constexpr (!IsOrdered) {
+            // Group probing scans the metadata in aligned chunks of group_size.
+            new_capacity = (new_capacity + group_size - 1) / group_size * group_size;
+        }
 
         auto* old_buckets = m_buckets;
+        auto* old_metadata = m_metadata;
         auto old_capacity = m_capacity;
         Iterator old_iter = begin();
 
@@ -386,6 +409,9 @@ private:
         } else {
             m_buckets = (BucketType*)kmalloc(size_in_bytes(new_capacity));
             __builtin_memset(m_buckets, 0, size_in_bytes(new_capacity));
+
+            m_metadata = (u8*)kmalloc(new_capacity);
+            __builtin_memset(m_metadata, metadata_empty, new_capacity);
         }
 
         m_capacity = new_capacity;
@@ -403,6 +429,38 @@ private:
         }
 
         kfree_sized(old_buckets, size_in_bytes(old_capacity));
+        if constexpr (!IsOrdered)
+            kfree_sized(old_metadata, old_capacity);
+    }
+
+    [[nodiscard]] static u8 h2_from_hash(unsigned hash) { return hash & 0x7f; }
+
+    struct GroupMatch {
+        u32 matches;
+        u32 empties;
+    };
+
+    [[nodiscard]] ALWAYS_INLINE GroupMatch match_group(u8 const* metadata, u8 h2) const
+    {
+#if !defined(KERNEL) && defined(__SSE2__)
+        AK::SIMD::c8x16 group;
+        __builtin_memcpy(&group, metadata, group_size);
+        auto h2s = (AK::SIMD::c8x16)(AK::SIMD::i8x16 {} + (i8)h2);
+        auto empties = (AK::SIMD::c8x16)(AK::SIMD::i8x16 {} + (i8)metadata_empty);
+        u32 match_mask = __builtin_ia32_pmovmskb128((AK::SIMD::c8x16)(group == h2s));
+        u32 empty_mask = __builtin_ia32_pmovmskb128((AK::SIMD::c8x16)(group == empties));
+        return { match_mask, empty_mask };
+#else
+        u32 match_mask = 0;
+        u32 empty_mask = 0;
+        for (size_t i = 0; i < group_size; ++i) {
+            if (metadata[i] == h2)
+                match_mask |= 1u << i;
+            else if (metadata[i] == metadata_empty)
+                empty_mask |= 1u << i;
+        }
+        return { match_mask, empty_mask };
+#endif
     }
 
     template<typename TUnaryPredicate>
@@ -411,6 +469,26 @@ private:
         if (is_empty())
             return nullptr;
 
+        if constexpr (!IsOrdered) {
+            auto h2 = h2_from_hash(hash);
+            size_t group_count = m_capacity / group_size;
+            size_t group = (hash % m_capacity) / group_size;
+            for (size_t probes = 0; probes < group_count; ++probes) {
+                auto match = match_group(m_metadata + group * group_size, h2);
+                while (match.matches) {
+                    auto& bucket = m_buckets[group * group_size + __builtin_ctz(match.matches)];
+                    if (predicate(*bucket.slot()))
+                        return &bucket;
+                    match.matches &= match.matches - 1;
+                }
+                if (match.empties)
+                    return nullptr;
+                if (++group == group_count)
+                    group = 0;
+            }
+            return nullptr;
+        }
+
         for (;;) {
             auto& bucket = m_buckets[hash % m_capacity];
 
@@ -430,6 +508,41 @@ private:
             rehash(capacity() * 2);
 
         auto hash = TraitsForT::hash(value);
+
+        if constexpr (!IsOrdered) {
+            auto h2 = h2_from_hash(hash);
+            size_t group_count = m_capacity / group_size;
+            size_t group = (hash % m_capacity) / group_size;
+            size_t first_free_index = m_capacity;
+            for (size_t probes = 0; probes < group_count; ++probes) {
+                auto const* metadata = m_metadata + group * group_size;
+                auto match = match_group(metadata, h2);
+                while (match.matches) {
+                    auto& bucket = m_buckets[group * group_size + __builtin_ctz(match.matches)];
+                    if (TraitsForT::equals(*bucket.slot(), value))
+                        return bucket;
+                    match.matches &= match.matches - 1;
+                }
+                if (first_free_index == m_capacity) {
+                    for (size_t i = 0; i < group_size; ++i) {
+                        if (metadata[i] & 0x80) {
+                            first_free_index = group * group_size + i;
+                            break;
+                        }
+                    }
+                }
+                if (match.empties) {
+                    // The key is not in the table; claim the first tombstone
+                    // or empty slot we passed on the way here.
+                    m_metadata[first_free_index] = h2;
+                    return m_buckets[first_free_index];
+                }
+                if (++group == group_count)
+                    group = 0;
+            }
+            VERIFY_NOT_REACHED();
+        }
+
         BucketType* first_empty_bucket = nullptr;
         for (;;) {
             auto& bucket = m_buckets[hash % m_capacity];
@@ -453,6 +566,7 @@ private:
     [[nodiscard]] bool should_grow() const { return ((used_bucket_count() + 1) * 100) >= (m_capacity * load_factor_in_percent); }
 
     BucketType* m_buckets { nullptr };
+    u8* m_metadata { nullptr };
 
     [[no_unique_address]] CollectionDataType m_collection_data;
     size_t m_size { 0 };
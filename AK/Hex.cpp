@@ -43,12 +43,20 @@ Optional<ByteBuffer> decode_hex(const StringView& input)
 
 String encode_hex(const ReadonlyBytes input)
 {
-    StringBuilder output(input.size() * 2);
+    if (input.is_empty())
+        return String::empty();
 
-    for (auto ch : input)
-        output.appendff("{:02x}", ch);
+    constexpr auto hex_digits = "0123456789abcdef";
 
-    return output.build();
+    char* buffer = nullptr;
+    auto impl = StringImpl::create_uninitialized(input.size() * 2, buffer);
+
+    for (size_t i = 0; i < input.size(); ++i) {
+        buffer[i * 2] = hex_digits[input[i] >> 4];
+        buffer[i * 2 + 1] = hex_digits[input[i] & 0xf];
+    }
+
+    return String(move(impl));
 }
 
 }
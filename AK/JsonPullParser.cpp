@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <AK/JsonPullParser.h>
+#include <AK/StringBuilder.h>
+#include <AK/StringUtils.h>
+
+namespace AK {
+
+static constexpr bool is_json_space(char ch)
+{
+    return ch == '\t' || ch == '\n' || ch == '\r' || ch == ' ';
+}
+
+JsonPullParser::Event JsonPullParser::fail()
+{
+    m_hit_error = true;
+    return Event::ParseError;
+}
+
+void JsonPullParser::did_complete_value()
+{
+    if (m_scopes.is_empty())
+        m_expect = Expect::TopLevelDone;
+    else
+        m_expect = Expect::CommaOrEnd;
+}
+
+bool JsonPullParser::consume_string_payload(StringView& payload)
+{
+    if (!consume_specific('"'))
+        return false;
+    auto start = tell();
+    while (!is_eof()) {
+        auto ch = peek();
+        if (ch == '"') {
+            payload = m_input.substring_view(start, tell() - start);
+            ignore();
+            return true;
+        }
+        if (is_ascii_c0_control(ch))
+            return false;
+        if (ch == '\\') {
+            ignore();
+            if (is_eof())
+                return false;
+        }
+        ignore();
+    }
+    return false;
+}
+
+JsonPullParser::Event JsonPullParser::parse_value()
+{
+    if (is_eof())
+        return fail();
+
+    switch (peek()) {
+    case '{':
+        ignore();
+        m_scopes.append(Scope::Object);
+        m_expect = Expect::KeyOrEnd;
+        return Event::StartObject;
+    case '[':
+        ignore();
+        m_scopes.append(Scope::Array);
+        m_expect = Expect::ValueOrEnd;
+        return Event::StartArray;
+    case '"':
+        if (!consume_string_payload(m_last_string))
+            return fail();
+        did_complete_value();
+        return Event::StringValue;
+    case 't':
+        if (!consume_specific("true"))
+            return fail();
+        did_complete_value();
+        return Event::TrueValue;
+    case 'f':
+        if (!consume_specific("false"))
+            return fail();
+        did_complete_value();
+        return Event::FalseValue;
+    case 'n':
+        if (!consume_specific("null"))
+            return fail();
+        did_complete_value();
+        return Event::NullValue;
+    default: {
+        auto start = tell();
+        if (next_is('-'))
+            ignore();
+        while (next_is(is_ascii_digit) || next_is('.') || next_is('e') || next_is('E') || next_is('+') || next_is('-'))
+            ignore();
+        if (tell() == start)
+            return fail();
+        m_last_number = m_input.substring_view(start, tell() - start);
+        did_complete_value();
+        return Event::NumberValue;
+    }
+    }
+}
+
+JsonPullParser::Event JsonPullParser::parse_key()
+{
+    if (!consume_string_payload(m_last_string))
+        return fail();
+    ignore_while(is_json_space);
+    if (!consume_specific(':'))
+        return fail();
+    m_expect = Expect::Value;
+    return Event::Key;
+}
+
+JsonPullParser::Event JsonPullParser::next()
+{
+    if (m_hit_error)
+        return Event::ParseError;
+
+    for (;;) {
+        ignore_while(is_json_space);
+
+        switch (m_expect) {
+        case Expect::Value:
+            return parse_value();
+        case Expect::ValueOrEnd:
+            if (consume_specific(']')) {
+                m_scopes.take_last();
+                did_complete_value();
+                return Event::EndArray;
+            }
+            return parse_value();
+        case Expect::Key:
+            return parse_key();
+        case Expect::KeyOrEnd:
+            if (consume_specific('}')) {
+                m_scopes.take_last();
+                did_complete_value();
+                return Event::EndObject;
+            }
+            return parse_key();
+        case Expect::CommaOrEnd: {
+            VERIFY(!m_scopes.is_empty());
+            auto scope = m_scopes.last();
+            if (consume_specific(',')) {
+                m_expect = scope == Scope::Object ? Expect::Key : Expect::Value;
+                continue;
+            }
+            if (scope == Scope::Object && consume_specific('}')) {
+                m_scopes.take_last();
+                did_complete_value();
+                return Event::EndObject;
+            }
+            if (scope == Scope::Array && consume_specific(']')) {
+                m_scopes.take_last();
+                did_complete_value();
+                return Event::EndArray;
+            }
+            return fail();
+        }
+        case Expect::TopLevelDone:
+            if (!is_eof())
+                return fail();
+            return Event::Done;
+        }
+        VERIFY_NOT_REACHED();
+    }
+}
+
+Optional<String> JsonPullParser::decode_last_string() const
+{
+    if (!m_last_string.contains('\\'))
+        return m_last_string.to_string();
+
+    StringBuilder builder;
+    GenericLexer lexer { m_last_string };
+    while (!lexer.is_eof()) {
+        auto ch = lexer.consume();
+        if (ch != '\\') {
+            builder.append(ch);
+            continue;
+        }
+        if (lexer.is_eof())
+            return {};
+        switch (lexer.consume()) {
+        case '"':
+            builder.append('"');
+            break;
+        case '\\':
+            builder.append('\\');
+            break;
+        case '/':
+            builder.append('/');
+            break;
+        case 'n':
+            builder.append('\n');
+            break;
+        case 'r':
+            builder.append('\r');
+            break;
+        case 't':
+            builder.append('\t');
+            break;
+        case 'b':
+            builder.append('\b');
+            break;
+        case 'f':
+            builder.append('\f');
+            break;
+        case 'u': {
+            if (lexer.tell_remaining() < 4)
+                return {};
+            auto code_point = StringUtils::convert_to_uint_from_hex(lexer.consume(4));
+            if (!code_point.has_value())
+                return {};
+            builder.append_code_point(code_point.value());
+            break;
+        }
+        default:
+            return {};
+        }
+    }
+    return builder.to_string();
+}
+
+}
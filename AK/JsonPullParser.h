@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/GenericLexer.h>
+#include <AK/String.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// A pull-style JSON parser that emits a stream of events instead of
+// materializing a JsonValue tree. String and number payloads are exposed as
+// views into the input buffer, so walking a multi-megabyte document does not
+// allocate (beyond the nesting stack). Callers that only care about a few
+// keys can skip everything else; use JsonParser when you actually want the
+// whole tree.
+class JsonPullParser : private GenericLexer {
+public:
+    enum class Event {
+        StartObject,
+        EndObject,
+        StartArray,
+        EndArray,
+        Key,
+        StringValue,
+        NumberValue,
+        TrueValue,
+        FalseValue,
+        NullValue,
+        Done,
+        ParseError,
+    };
+
+    explicit JsonPullParser(StringView input)
+        : GenericLexer(input)
+    {
+    }
+
+    Event next();
+
+    // Raw contents (between the quotes, escape sequences unprocessed) of the
+    // payload of the last Key or StringValue event.
+    [[nodiscard]] StringView last_string() const { return m_last_string; }
+
+    // Text of the last NumberValue event.
+    [[nodiscard]] StringView last_number() const { return m_last_number; }
+
+    // Processes escape sequences in last_string(). This is the only API on
+    // this parser that may allocate.
+    [[nodiscard]] Optional<String> decode_last_string() const;
+
+private:
+    enum class Scope : u8 {
+        Object,
+        Array,
+    };
+
+    enum class Expect : u8 {
+        Value,
+        ValueOrEnd,
+        Key,
+        KeyOrEnd,
+        CommaOrEnd,
+        TopLevelDone,
+    };
+
+    Event parse_value();
+    Event parse_key();
+    Event fail();
+    void did_complete_value();
+    bool consume_string_payload(StringView&);
+
+    Vector<Scope, 16> m_scopes;
+    Expect m_expect { Expect::Value };
+    StringView m_last_string;
+    StringView m_last_number;
+    bool m_hit_error { false };
+};
+
+}
+
+using AK::JsonPullParser;
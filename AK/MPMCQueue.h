@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+
+namespace AK {
+
+// A bounded, lock-free, multi-producer multi-consumer queue after Dmitry
+// Vyukov's design. Each slot carries a sequence number that tells producers
+// and consumers whether the slot is theirs to use, so the only contended
+// operations are a compare-exchange on the enqueue or dequeue position.
+//
+// Unlike CircularQueue, enqueuing into a full queue does not overwrite the
+// oldest element; it fails, and the caller decides what to do.
+//
+// Note that both try_enqueue() and try_dequeue() spin briefly when racing
+// other threads, so this is not safe to use from interrupt handlers that
+// might interrupt one of the losing threads mid-operation.
+template<typename T, size_t Capacity>
+class MPMCQueue {
+    AK_MAKE_NONCOPYABLE(MPMCQueue);
+    AK_MAKE_NONMOVABLE(MPMCQueue);
+
+    static_assert(Capacity >= 2 && !(Capacity & (Capacity - 1)), "Capacity must be a power of two");
+
+public:
+    MPMCQueue()
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+            m_slots[i].sequence.store(i, memory_order_relaxed);
+    }
+
+    ~MPMCQueue()
+    {
+        while (try_dequeue().has_value())
+            ;
+    }
+
+    constexpr size_t capacity() const { return Capacity; }
+
+    template<typename U = T>
+    [[nodiscard]] bool try_enqueue(U&& value)
+    {
+        Slot* slot;
+        size_t position = m_enqueue_position.load(memory_order_relaxed);
+        for (;;) {
+            slot = &m_slots[position & (Capacity - 1)];
+            size_t sequence = slot->sequence.load(memory_order_acquire);
+            // The positions wrap around eventually (quickly on 32-bit!), so
+            // compare them via a signed difference rather than directly.
+            auto difference = static_cast<ssize_t>(sequence - position);
+            if (difference == 0) {
+                if (m_enqueue_position.compare_exchange_strong(position, position + 1, memory_order_relaxed))
+                    break;
+                // The compare-exchange reloaded position for us; try again.
+            } else if (difference < 0) {
+                // The slot still holds an element from the previous lap around
+                // the ring, i.e. the queue is full.
+                return false;
+            } else {
+                // Another producer claimed this slot; catch up to it.
+                position = m_enqueue_position.load(memory_order_relaxed);
+            }
+        }
+        new (&slot->storage) T(forward<U>(value));
+        slot->sequence.store(position + 1, memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]] Optional<T> try_dequeue()
+    {
+        Slot* slot;
+        size_t position = m_dequeue_position.load(memory_order_relaxed);
+        for (;;) {
+            slot = &m_slots[position & (Capacity - 1)];
+            size_t sequence = slot->sequence.load(memory_order_acquire);
+            auto difference = static_cast<ssize_t>(sequence - (position + 1));
+            if (difference == 0) {
+                if (m_dequeue_position.compare_exchange_strong(position, position + 1, memory_order_relaxed))
+                    break;
+            } else if (difference < 0) {
+                // No producer has filled this slot yet, i.e. the queue is empty.
+                return {};
+            } else {
+                position = m_dequeue_position.load(memory_order_relaxed);
+            }
+        }
+        auto& element = *reinterpret_cast<T*>(&slot->storage);
+        T value = move(element);
+        element.~T();
+        slot->sequence.store(position + Capacity, memory_order_release);
+        return value;
+    }
+
+private:
+    // Slots, the enqueue position and the dequeue position each live on their
+    // own cache line so that producers and consumers don't false-share.
+    static constexpr size_t cache_line_size = 64;
+
+    struct Slot {
+        Atomic<size_t> sequence;
+        alignas(T) u8 storage[sizeof(T)];
+    };
+
+    alignas(cache_line_size) Slot m_slots[Capacity];
+    alignas(cache_line_size) Atomic<size_t> m_enqueue_position { 0 };
+    alignas(cache_line_size) Atomic<size_t> m_dequeue_position { 0 };
+};
+
+}
+
+using AK::MPMCQueue;
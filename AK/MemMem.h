@@ -8,13 +8,54 @@
 
 #include <AK/Array.h>
 #include <AK/Assertions.h>
+#include <AK/SIMD.h>
 #include <AK/Span.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 
 namespace AK {
 
+// Scans for the first occurrence of a byte, 16 bytes at a time where the
+// target supports it. The kernel is built without SIMD, so it takes the
+// scalar path below.
+static inline Optional<size_t> find_first_byte(const u8* haystack, size_t haystack_length, u8 needle)
+{
+    size_t i = 0;
+#if !defined(KERNEL) && (defined(__SSE2__) || defined(__ARM_NEON))
+    auto needles = (AK::SIMD::c8x16)(AK::SIMD::i8x16 {} + (i8)needle);
+    // GCC reports a bogus -Warray-bounds for the 16-byte load when the
+    // haystack is a smaller fixed-size array, even though the loop condition
+    // guarantees the load never happens for such haystacks.
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Warray-bounds"
+    for (; i + 16 <= haystack_length; i += 16) {
+        AK::SIMD::c8x16 chunk;
+        __builtin_memcpy(&chunk, haystack + i, 16);
+        auto matches = (AK::SIMD::c8x16)(chunk == needles);
+#    if defined(__SSE2__)
+        if (auto mask = __builtin_ia32_pmovmskb128(matches))
+            return i + __builtin_ctz(mask);
+#    else
+        auto match_words = (AK::SIMD::u64x2)matches;
+        if (match_words[0] | match_words[1]) {
+            for (size_t j = 0; j < 16; ++j) {
+                if (matches[j])
+                    return i + j;
+            }
+        }
+#    endif
+    }
+#    pragma GCC diagnostic pop
+#endif
+    for (; i < haystack_length; ++i) {
+        if (haystack[i] == needle)
+            return i;
+    }
+    return {};
+}
+
 namespace {
+#if defined(KERNEL) || !(defined(__SSE2__) || defined(__ARM_NEON))
 const static void* bitap_bitwise(const void* haystack, size_t haystack_length, const void* needle, size_t needle_length)
 {
     VERIFY(needle_length < 32);
@@ -40,6 +81,7 @@ const static void* bitap_bitwise(const void* haystack, size_t haystack_length, c
 
     return nullptr;
 }
+#endif
 }
 
 template<typename HaystackIterT>
@@ -115,10 +157,27 @@ static inline Optional<size_t> memmem_optional(const void* haystack, size_t hays
     }
 
     if (needle_length < 32) {
+#if !defined(KERNEL) && (defined(__SSE2__) || defined(__ARM_NEON))
+        // Vector-scan for the first needle byte, then verify candidates with memcmp.
+        auto const* typed_haystack = (const u8*)haystack;
+        auto first_byte = ((const u8*)needle)[0];
+        size_t offset = 0;
+        while (haystack_length - offset >= needle_length) {
+            auto candidate = find_first_byte(typed_haystack + offset, haystack_length - offset - (needle_length - 1), first_byte);
+            if (!candidate.has_value())
+                return {};
+            offset += candidate.value();
+            if (__builtin_memcmp(typed_haystack + offset + 1, (const u8*)needle + 1, needle_length - 1) == 0)
+                return offset;
+            ++offset;
+        }
+        return {};
+#else
         auto ptr = bitap_bitwise(haystack, haystack_length, needle, needle_length);
         if (ptr)
             return static_cast<size_t>((FlatPtr)ptr - (FlatPtr)haystack);
         return {};
+#endif
     }
 
     // Fallback to KMP.
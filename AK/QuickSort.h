@@ -10,29 +10,89 @@
 
 namespace AK {
 
+// Partitions at or below this size are finished with insertion sort, which
+// beats any quicksort on tiny and mostly-sorted runs.
+static constexpr int insertion_sort_cutoff = 16;
+
+template<typename Collection, typename LessThan>
+void insertion_sort(Collection& col, int start, int end, LessThan& less_than)
+{
+    for (int i = start + 1; i <= end; ++i) {
+        for (int j = i; j > start && less_than(col[j], col[j - 1]); --j)
+            swap(col[j], col[j - 1]);
+    }
+}
+
+template<typename Collection, typename LessThan>
+void heap_sort(Collection& col, int start, int end, LessThan& less_than)
+{
+    int size = end - start + 1;
+    auto sift_down = [&](int root, int count) {
+        for (;;) {
+            int child = 2 * root + 1;
+            if (child >= count)
+                return;
+            if (child + 1 < count && less_than(col[start + child], col[start + child + 1]))
+                ++child;
+            if (!less_than(col[start + root], col[start + child]))
+                return;
+            swap(col[start + root], col[start + child]);
+            root = child;
+        }
+    };
+    for (int i = size / 2 - 1; i >= 0; --i)
+        sift_down(i, size);
+    for (int i = size - 1; i > 0; --i) {
+        swap(col[start], col[start + i]);
+        sift_down(0, i);
+    }
+}
+
+namespace Detail {
+
+constexpr int sort_depth_limit(int size)
+{
+    int depth = 0;
+    for (int n = size; n > 1; n >>= 1)
+        ++depth;
+    return 2 * depth;
+}
+
+}
+
 /* This is a dual pivot quick sort. It is quite a bit faster than the single
  * pivot quick_sort below. The other quick_sort below should only be used when
  * you are stuck with simple iterators to a container and you don't have access
  * to the container itself.
+ *
+ * Small partitions are handled with insertion sort, and partitions that keep
+ * degenerating (adversarial or already-sorted inputs) fall back to heapsort
+ * once the recursion depth exceeds 2*log2(n), so the worst case is O(n log n).
  */
 template<typename Collection, typename LessThan>
-void dual_pivot_quick_sort(Collection& col, int start, int end, LessThan less_than)
+void dual_pivot_quick_sort(Collection& col, int start, int end, LessThan less_than, int depth_limit = -1)
 {
+    if (depth_limit < 0)
+        depth_limit = Detail::sort_depth_limit(end - start + 1);
+
     while (start < end) {
         int size = end - start + 1;
-        if (size > 3) {
-            int third = size / 3;
-            if (less_than(col[start + third], col[end - third])) {
-                swap(col[start + third], col[start]);
-                swap(col[end - third], col[end]);
-            } else {
-                swap(col[start + third], col[end]);
-                swap(col[end - third], col[start]);
-            }
+        if (size <= insertion_sort_cutoff) {
+            insertion_sort(col, start, end, less_than);
+            return;
+        }
+        if (depth_limit-- == 0) {
+            heap_sort(col, start, end, less_than);
+            return;
+        }
+
+        int third = size / 3;
+        if (less_than(col[start + third], col[end - third])) {
+            swap(col[start + third], col[start]);
+            swap(col[end - third], col[end]);
         } else {
-            if (!less_than(col[start], col[end])) {
-                swap(col[start], col[end]);
-            }
+            swap(col[start + third], col[end]);
+            swap(col[end - third], col[start]);
         }
 
         int j = start + 1;
@@ -73,30 +133,64 @@ void dual_pivot_quick_sort(Collection& col, int start, int end, LessThan less_th
         int right_size = (end + 1) - (right_pointer + 1);
 
         if (left_size >= middle_size && left_size >= right_size) {
-            dual_pivot_quick_sort(col, left_pointer + 1, right_pointer - 1, less_than);
-            dual_pivot_quick_sort(col, right_pointer + 1, end, less_than);
+            dual_pivot_quick_sort(col, left_pointer + 1, right_pointer - 1, less_than, depth_limit);
+            dual_pivot_quick_sort(col, right_pointer + 1, end, less_than, depth_limit);
             end = left_pointer - 1;
         } else if (middle_size >= right_size) {
-            dual_pivot_quick_sort(col, start, left_pointer - 1, less_than);
-            dual_pivot_quick_sort(col, right_pointer + 1, end, less_than);
+            dual_pivot_quick_sort(col, start, left_pointer - 1, less_than, depth_limit);
+            dual_pivot_quick_sort(col, right_pointer + 1, end, less_than, depth_limit);
             start = left_pointer + 1;
             end = right_pointer - 1;
         } else {
-            dual_pivot_quick_sort(col, start, left_pointer - 1, less_than);
-            dual_pivot_quick_sort(col, left_pointer + 1, right_pointer - 1, less_than);
+            dual_pivot_quick_sort(col, start, left_pointer - 1, less_than, depth_limit);
+            dual_pivot_quick_sort(col, left_pointer + 1, right_pointer - 1, less_than, depth_limit);
             start = right_pointer + 1;
         }
     }
 }
 
 template<typename Iterator, typename LessThan>
-void single_pivot_quick_sort(Iterator start, Iterator end, LessThan less_than)
+void single_pivot_quick_sort(Iterator start, Iterator end, LessThan less_than, int depth_limit = -1)
 {
+    if (depth_limit < 0)
+        depth_limit = Detail::sort_depth_limit(end - start);
+
     for (;;) {
         int size = end - start;
         if (size <= 1)
             return;
 
+        if (size <= insertion_sort_cutoff) {
+            for (int i = 1; i < size; ++i) {
+                for (int j = i; j > 0 && less_than(*(start + j), *(start + j - 1)); --j)
+                    swap(*(start + j), *(start + j - 1));
+            }
+            return;
+        }
+
+        if (depth_limit-- == 0) {
+            auto sift_down = [&](int root, int count) {
+                for (;;) {
+                    int child = 2 * root + 1;
+                    if (child >= count)
+                        return;
+                    if (child + 1 < count && less_than(*(start + child), *(start + child + 1)))
+                        ++child;
+                    if (!less_than(*(start + root), *(start + child)))
+                        return;
+                    swap(*(start + root), *(start + child));
+                    root = child;
+                }
+            };
+            for (int i = size / 2 - 1; i >= 0; --i)
+                sift_down(i, size);
+            for (int i = size - 1; i > 0; --i) {
+                swap(*start, *(start + i));
+                sift_down(0, i);
+            }
+            return;
+        }
+
         int pivot_point = size / 2;
         if (pivot_point)
             swap(*(start + pivot_point), *start);
@@ -115,10 +209,10 @@ void single_pivot_quick_sort(Iterator start, Iterator end, LessThan less_than)
         // Recur into the shorter part of the remaining data
         // to ensure a stack depth of at most log(n).
         if (i > size / 2) {
-            single_pivot_quick_sort(start + i, end, less_than);
+            single_pivot_quick_sort(start + i, end, less_than, depth_limit);
             end = start + i - 1;
         } else {
-            single_pivot_quick_sort(start, start + i - 1, less_than);
+            single_pivot_quick_sort(start, start + i - 1, less_than, depth_limit);
             start = start + i;
         }
     }
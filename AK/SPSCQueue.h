@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+
+namespace AK {
+
+// A bounded, wait-free queue for exactly one producer thread and exactly one
+// consumer thread. This is the single-producer single-consumer counterpart to
+// MPMCQueue: because each index is only ever written by one side, it gets by
+// without compare-exchange loops entirely, and each side caches the other's
+// index so the common case touches no shared cache lines at all.
+template<typename T, size_t Capacity>
+class SPSCQueue {
+    AK_MAKE_NONCOPYABLE(SPSCQueue);
+    AK_MAKE_NONMOVABLE(SPSCQueue);
+
+    static_assert(Capacity >= 2 && !(Capacity & (Capacity - 1)), "Capacity must be a power of two");
+
+public:
+    SPSCQueue() = default;
+
+    ~SPSCQueue()
+    {
+        while (try_dequeue().has_value())
+            ;
+    }
+
+    constexpr size_t capacity() const { return Capacity; }
+
+    // May only be called from the producer thread.
+    template<typename U = T>
+    [[nodiscard]] bool try_enqueue(U&& value)
+    {
+        size_t head = m_head.load(memory_order_relaxed);
+        if (head - m_cached_tail == Capacity) {
+            m_cached_tail = m_tail.load(memory_order_acquire);
+            if (head - m_cached_tail == Capacity)
+                return false;
+        }
+        new (&elements()[head & (Capacity - 1)]) T(forward<U>(value));
+        m_head.store(head + 1, memory_order_release);
+        return true;
+    }
+
+    // May only be called from the consumer thread.
+    [[nodiscard]] Optional<T> try_dequeue()
+    {
+        size_t tail = m_tail.load(memory_order_relaxed);
+        if (tail == m_cached_head) {
+            m_cached_head = m_head.load(memory_order_acquire);
+            if (tail == m_cached_head)
+                return {};
+        }
+        auto& element = elements()[tail & (Capacity - 1)];
+        T value = move(element);
+        element.~T();
+        m_tail.store(tail + 1, memory_order_release);
+        return value;
+    }
+
+private:
+    static constexpr size_t cache_line_size = 64;
+
+    T* elements() { return reinterpret_cast<T*>(m_storage); }
+
+    alignas(T) u8 m_storage[sizeof(T) * Capacity];
+    alignas(cache_line_size) Atomic<size_t> m_head { 0 };
+    size_t m_cached_tail { 0 };
+    alignas(cache_line_size) Atomic<size_t> m_tail { 0 };
+    size_t m_cached_head { 0 };
+};
+
+}
+
+using AK::SPSCQueue;
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BumpAllocator.h>
+#include <AK/Noncopyable.h>
+#include <AK/StdLibExtras.h>
+
+namespace AK {
+
+// An arena for parser-shaped workloads: allocate millions of short-lived
+// objects through create(), then release all of the memory in bulk when the
+// arena goes out of scope. Destructors of non-trivial objects are run (in
+// reverse creation order); trivially destructible objects cost nothing but
+// the bump-pointer advance.
+class ScopedArena {
+    AK_MAKE_NONCOPYABLE(ScopedArena);
+    AK_MAKE_NONMOVABLE(ScopedArena);
+
+public:
+    ScopedArena() = default;
+
+    ~ScopedArena()
+    {
+        for (auto* entry = m_destructors; entry; entry = entry->next)
+            entry->destroy(entry->object);
+    }
+
+    template<typename T, typename... Args>
+    T& create(Args&&... args)
+    {
+        auto* slot = m_allocator.allocate<T>();
+        VERIFY(slot);
+        new (slot) T(forward<Args>(args)...);
+        if constexpr (!IsTriviallyDestructible<T>) {
+            auto* entry = m_allocator.allocate<DestructorEntry>();
+            VERIFY(entry);
+            entry->object = slot;
+            entry->destroy = [](void* object) { static_cast<T*>(object)->~T(); };
+            entry->next = m_destructors;
+            m_destructors = entry;
+        }
+        return *slot;
+    }
+
+    void* allocate(size_t size, size_t align)
+    {
+        return m_allocator.allocate(size, align);
+    }
+
+private:
+    // Bookkeeping lives in the arena itself, so creation does one or two bump
+    // allocations and no heap traffic.
+    struct DestructorEntry {
+        void* object;
+        void (*destroy)(void*);
+        DestructorEntry* next;
+    };
+
+    BumpAllocator<false, 64 * KiB> m_allocator;
+    DestructorEntry* m_destructors { nullptr };
+};
+
+}
+
+using AK::ScopedArena;
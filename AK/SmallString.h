@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Format.h>
+#include <AK/String.h>
+#include <AK/StringHash.h>
+#include <AK/StringImpl.h>
+#include <AK/StringView.h>
+#include <AK/Traits.h>
+#include <AK/Types.h>
+
+namespace AK {
+
+// A string with small-string optimization: strings up to 23 bytes are stored
+// inline and never touch the heap, anything longer falls back to a ref-counted
+// StringImpl. The whole object is the size of two pointers and is cheap to
+// copy either way.
+//
+// The discriminator is the lowest bit of the first byte: StringImpl pointers
+// are always aligned, so their low bit is 0 (on our little-endian targets),
+// while the inline representation stores (length << 1) | 1 there.
+class SmallString {
+public:
+    static constexpr size_t inline_capacity = 23;
+
+    SmallString()
+    {
+        m_inline.tagged_length = 1;
+    }
+
+    SmallString(StringView const& view)
+    {
+        if (view.length() <= inline_capacity) {
+            m_inline.tagged_length = static_cast<u8>((view.length() << 1) | 1);
+            __builtin_memcpy(m_inline.buffer, view.characters_without_null_termination(), view.length());
+        } else {
+            m_impl = StringImpl::create(view.characters_without_null_termination(), view.length()).leak_ref();
+        }
+    }
+
+    SmallString(char const* cstring)
+        : SmallString(StringView(cstring))
+    {
+    }
+
+    SmallString(String const& string)
+    {
+        if (string.length() <= inline_capacity) {
+            m_inline.tagged_length = static_cast<u8>((string.length() << 1) | 1);
+            __builtin_memcpy(m_inline.buffer, string.characters(), string.length());
+        } else {
+            m_impl = const_cast<StringImpl*>(string.impl());
+            m_impl->ref();
+        }
+    }
+
+    SmallString(SmallString const& other)
+    {
+        __builtin_memcpy(this, &other, sizeof(SmallString));
+        if (!is_inline())
+            m_impl->ref();
+    }
+
+    SmallString(SmallString&& other)
+    {
+        __builtin_memcpy(this, &other, sizeof(SmallString));
+        other.m_inline.tagged_length = 1;
+    }
+
+    ~SmallString()
+    {
+        if (!is_inline())
+            m_impl->unref();
+    }
+
+    SmallString& operator=(SmallString const& other)
+    {
+        if (this != &other) {
+            this->~SmallString();
+            new (this) SmallString(other);
+        }
+        return *this;
+    }
+
+    SmallString& operator=(SmallString&& other)
+    {
+        if (this != &other) {
+            this->~SmallString();
+            new (this) SmallString(move(other));
+        }
+        return *this;
+    }
+
+    [[nodiscard]] bool is_inline() const { return m_inline.tagged_length & 1; }
+    [[nodiscard]] bool is_empty() const { return length() == 0; }
+
+    [[nodiscard]] size_t length() const
+    {
+        if (is_inline())
+            return m_inline.tagged_length >> 1;
+        return m_impl->length();
+    }
+
+    [[nodiscard]] char const* characters_without_null_termination() const
+    {
+        if (is_inline())
+            return m_inline.buffer;
+        return m_impl->characters();
+    }
+
+    [[nodiscard]] StringView view() const { return { characters_without_null_termination(), length() }; }
+    [[nodiscard]] String to_string() const { return view().to_string(); }
+
+    char operator[](size_t index) const
+    {
+        VERIFY(index < length());
+        return characters_without_null_termination()[index];
+    }
+
+    bool operator==(SmallString const& other) const { return view() == other.view(); }
+    bool operator!=(SmallString const& other) const { return !(*this == other); }
+    bool operator==(StringView const& other) const { return view() == other; }
+    bool operator!=(StringView const& other) const { return view() != other; }
+    bool operator==(String const& other) const { return view() == other.view(); }
+    bool operator!=(String const& other) const { return view() != other.view(); }
+    bool operator==(char const* cstring) const { return view() == cstring; }
+    bool operator!=(char const* cstring) const { return view() != cstring; }
+
+    [[nodiscard]] unsigned hash() const
+    {
+        if (!is_inline())
+            return m_impl->hash();
+        return string_hash(m_inline.buffer, length());
+    }
+
+private:
+    struct Inline {
+        u8 tagged_length;
+        char buffer[inline_capacity];
+    };
+
+    union {
+        Inline m_inline;
+        StringImpl* m_impl;
+    };
+};
+
+static_assert(sizeof(SmallString) == 3 * sizeof(u64));
+
+template<>
+struct Traits<SmallString> : public GenericTraits<SmallString> {
+    static unsigned hash(SmallString const& s) { return s.hash(); }
+};
+
+template<>
+struct Formatter<SmallString> : Formatter<StringView> {
+    void format(FormatBuilder& builder, SmallString const& value)
+    {
+        Formatter<StringView>::format(builder, value.view());
+    }
+};
+
+}
+
+using AK::SmallString;
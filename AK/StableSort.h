@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/QuickSort.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// A stable merge sort: equal elements keep their relative order, which is
+// what e.g. GUI::SortingProxyModel wants when re-sorting by another column.
+// Runs are seeded with (stable) insertion sort and then merged bottom-up
+// through a scratch buffer holding at most half the collection.
+template<typename Collection, typename LessThan>
+void stable_sort(Collection& collection, LessThan less_than)
+{
+    int size = static_cast<int>(collection.size());
+    if (size <= 1)
+        return;
+
+    constexpr int run_length = 32;
+    for (int lo = 0; lo < size; lo += run_length)
+        insertion_sort(collection, lo, min(lo + run_length, size) - 1, less_than);
+
+    if (size <= run_length)
+        return;
+
+    using ValueType = RemoveCVReference<decltype(collection[0])>;
+    Vector<ValueType> scratch;
+
+    for (int width = run_length; width < size; width *= 2) {
+        for (int lo = 0; lo + width < size; lo += 2 * width) {
+            int mid = lo + width;
+            int hi = min(lo + 2 * width, size);
+
+            scratch.clear_with_capacity();
+            for (int i = lo; i < mid; ++i)
+                scratch.append(move(collection[i]));
+
+            int left = 0;
+            int right = mid;
+            int out = lo;
+            while (left < static_cast<int>(scratch.size()) && right < hi) {
+                // Only take from the right run when strictly less, so equal
+                // elements stay in their original order.
+                if (less_than(collection[right], scratch[left]))
+                    collection[out++] = move(collection[right++]);
+                else
+                    collection[out++] = move(scratch[left]), ++left;
+            }
+            while (left < static_cast<int>(scratch.size()))
+                collection[out++] = move(scratch[left++]);
+        }
+    }
+}
+
+template<typename Collection>
+void stable_sort(Collection& collection)
+{
+    stable_sort(collection, [](auto& a, auto& b) { return a < b; });
+}
+
+}
+
+using AK::stable_sort;
@@ -325,11 +325,10 @@ Optional<size_t> find(StringView const& haystack, char needle, size_t start)
 {
     if (start >= haystack.length())
         return {};
-    for (size_t i = start; i < haystack.length(); ++i) {
-        if (haystack[i] == needle)
-            return i;
-    }
-    return {};
+    auto index = AK::find_first_byte(
+        (const u8*)haystack.characters_without_null_termination() + start,
+        haystack.length() - start, needle);
+    return index.has_value() ? (*index + start) : index;
 }
 
 Optional<size_t> find(StringView const& haystack, StringView const& needle, size_t start)
@@ -6,6 +6,7 @@
  */
 
 #include <AK/Assertions.h>
+#include <AK/ByteReader.h>
 #include <AK/Format.h>
 #include <AK/Utf8View.h>
 
@@ -140,7 +141,22 @@ static inline bool decode_first_byte(
 bool Utf8View::validate(size_t& valid_bytes) const
 {
     valid_bytes = 0;
-    for (auto ptr = begin_ptr(); ptr < end_ptr(); ptr++) {
+    auto ptr = begin_ptr();
+
+    while (ptr < end_ptr()) {
+        // ASCII bytes validate trivially, and most input is dominated by
+        // them, so skip over whole words of ASCII at a time by checking
+        // for high bits in bulk.
+        while (ptr + sizeof(u64) <= end_ptr()) {
+            auto word = ByteReader::load64(ptr);
+            if (word & 0x8080808080808080ull)
+                break;
+            ptr += sizeof(u64);
+            valid_bytes += sizeof(u64);
+        }
+        if (ptr >= end_ptr())
+            break;
+
         size_t code_point_length_in_bytes;
         u32 value;
         bool first_byte_makes_sense = decode_first_byte(*ptr, code_point_length_in_bytes, value);
@@ -155,6 +171,7 @@ bool Utf8View::validate(size_t& valid_bytes) const
                 return false;
         }
 
+        ptr++;
         valid_bytes += code_point_length_in_bytes;
     }
 
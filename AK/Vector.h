@@ -652,8 +652,12 @@ public:
         if (!try_ensure_capacity(new_size))
             return false;
 
-        for (size_t i = size(); i < new_size; ++i)
-            new (slot(i)) StorageType {};
+        if constexpr (Traits<StorageType>::is_trivial()) {
+            __builtin_memset(slot(size()), 0, (new_size - size()) * sizeof(StorageType));
+        } else {
+            for (size_t i = size(); i < new_size; ++i)
+                new (slot(i)) StorageType {};
+        }
         m_size = new_size;
         return true;
     }
@@ -663,6 +667,23 @@ public:
         return try_resize(new_size, true);
     }
 
+    // Grows the vector without initializing the new elements, so the caller
+    // can fill them in bulk (e.g. via memcpy or a read() into the buffer).
+    // Only available for trivial element types.
+    [[nodiscard]] bool try_resize_uninitialized(size_t new_size, bool keep_capacity = false) requires(!contains_reference && Traits<StorageType>::is_trivial())
+    {
+        if (new_size <= size()) {
+            shrink(new_size, keep_capacity);
+            return true;
+        }
+
+        if (!try_ensure_capacity(new_size))
+            return false;
+
+        m_size = new_size;
+        return true;
+    }
+
     void grow_capacity(size_t needed_capacity)
     {
         auto did_allocate = try_grow_capacity(needed_capacity);
@@ -706,6 +727,12 @@ public:
         VERIFY(did_allocate);
     }
 
+    void resize_uninitialized(size_t new_size, bool keep_capacity = false) requires(!contains_reference && Traits<StorageType>::is_trivial())
+    {
+        auto did_allocate = try_resize_uninitialized(new_size, keep_capacity);
+        VERIFY(did_allocate);
+    }
+
     using ConstIterator = SimpleIterator<Vector const, T const>;
     using Iterator = SimpleIterator<Vector, T>;
 
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/EnumBits.h>
+#include <AK/Types.h>
+
+// An event queue keeps a persistent set of file descriptor registrations in
+// the kernel, so an event loop doesn't have to rebuild (and the kernel
+// re-copy) its whole interest set on every iteration the way select() and
+// poll() do. Readiness comes back from event_queue_wait() as a compact list
+// of these:
+struct EventQueueEvent {
+    enum Type : u32 {
+        Read = 1 << 0,
+        Write = 1 << 1,
+        // Error and HangUp are always reported; a registration's interest
+        // mask only selects Read and/or Write.
+        Error = 1 << 2,
+        HangUp = 1 << 3,
+    };
+
+    int fd { -1 };
+    u32 events { 0 };
+};
+
+enum class EventQueueCtlOp : int {
+    Add = 0,
+    Modify = 1,
+    Remove = 2,
+};
+
+enum class EventQueueFlags : u32 {
+    None = 0,
+    CloseOnExec = 1 << 0,
+};
+
+AK_ENUM_BITWISE_OPERATORS(EventQueueFlags);
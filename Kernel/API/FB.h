@@ -57,4 +57,17 @@ ALWAYS_INLINE int fb_flush_buffers(int fd, int index, FBRect const* rects, unsig
     return ioctl(fd, FB_IOCTL_FLUSH_BUFFERS, &fb_flush_rects);
 }
 
+ALWAYS_INLINE int fb_set_cursor(int fd, FBCursorImage const* image)
+{
+    return ioctl(fd, FB_IOCTL_SET_CURSOR, image);
+}
+
+ALWAYS_INLINE int fb_move_cursor(int fd, int x, int y)
+{
+    FBCursorPosition fb_cursor_position;
+    fb_cursor_position.x = x;
+    fb_cursor_position.y = y;
+    return ioctl(fd, FB_IOCTL_MOVE_CURSOR, &fb_cursor_position);
+}
+
 __END_DECLS
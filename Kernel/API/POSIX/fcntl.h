@@ -21,6 +21,8 @@ extern "C" {
 #define F_GETLK 6
 #define F_SETLK 7
 #define F_SETLKW 8
+#define F_GETPIPE_SZ 9
+#define F_SETPIPE_SZ 10
 
 #define FD_CLOEXEC 1
 
@@ -16,6 +16,11 @@ struct sched_param {
     int sched_priority;
 };
 
+#define SCHED_FIFO 0
+#define SCHED_RR 1
+#define SCHED_OTHER 2
+#define SCHED_BATCH 3
+
 #ifdef __cplusplus
 }
 #endif
@@ -36,6 +36,21 @@ enum {
 
 #define PERF_EVENT_MASK_ALL (~0ull)
 
+enum IOBatchOpcode {
+    IOBATCH_OP_READ = 0,
+    IOBATCH_OP_WRITE = 1,
+};
+
+struct iobatch_op {
+    int fd;
+    uint16_t opcode;
+    uint16_t padding;
+    void* buffer;
+    size_t size;
+    /* Number of bytes transferred, or a negative errno code. */
+    ssize_t result;
+};
+
 #define THREAD_PRIORITY_MIN 1
 #define THREAD_PRIORITY_LOW 10
 #define THREAD_PRIORITY_NORMAL 30
@@ -23,6 +23,7 @@ extern "C" {
 #define MAP_NORESERVE 0x80
 #define MAP_RANDOMIZED 0x100
 #define MAP_PURGEABLE 0x200
+#define MAP_POPULATE 0x400
 
 #define PROT_READ 0x1
 #define PROT_WRITE 0x2
@@ -33,6 +34,7 @@ extern "C" {
 
 #define MADV_SET_VOLATILE 0x100
 #define MADV_SET_NONVOLATILE 0x200
+#define MADV_WILLNEED 0x400
 
 #ifdef __cplusplus
 }
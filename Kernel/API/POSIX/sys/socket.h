@@ -70,6 +70,11 @@ struct msghdr {
     int msg_flags;
 };
 
+struct mmsghdr {
+    struct msghdr msg_hdr;
+    unsigned int msg_len;
+};
+
 struct sockaddr {
     sa_family_t sa_family;
     char sa_data[14];
@@ -103,6 +108,7 @@ enum {
     SO_TIMESTAMP,
     SO_BROADCAST,
     SO_LINGER,
+    SO_REUSEPORT,
 };
 #define SO_RCVTIMEO SO_RCVTIMEO
 #define SO_SNDTIMEO SO_SNDTIMEO
@@ -117,6 +123,7 @@ enum {
 #define SO_SNDBUF SO_SNDBUF
 #define SO_RCVBUF SO_RCVBUF
 #define SO_LINGER SO_LINGER
+#define SO_REUSEPORT SO_REUSEPORT
 
 enum {
     SCM_TIMESTAMP,
@@ -17,6 +17,9 @@
 constexpr int syscall_vector = 0x82;
 
 extern "C" {
+struct EventQueueEvent;
+struct iobatch_op;
+struct mmsghdr;
 struct pollfd;
 struct timeval;
 struct timespec;
@@ -69,6 +72,9 @@ enum class NeedsBigProcessLock {
     S(dump_backtrace, NeedsBigProcessLock::No)              \
     S(dup2, NeedsBigProcessLock::Yes)                       \
     S(emuctl, NeedsBigProcessLock::Yes)                     \
+    S(event_queue_create, NeedsBigProcessLock::Yes)         \
+    S(event_queue_ctl, NeedsBigProcessLock::Yes)            \
+    S(event_queue_wait, NeedsBigProcessLock::Yes)           \
     S(execve, NeedsBigProcessLock::Yes)                     \
     S(exit, NeedsBigProcessLock::Yes)                       \
     S(exit_thread, NeedsBigProcessLock::Yes)                \
@@ -108,6 +114,7 @@ enum class NeedsBigProcessLock {
     S(halt, NeedsBigProcessLock::Yes)                       \
     S(inode_watcher_add_watch, NeedsBigProcessLock::Yes)    \
     S(inode_watcher_remove_watch, NeedsBigProcessLock::Yes) \
+    S(iobatch, NeedsBigProcessLock::Yes)                    \
     S(ioctl, NeedsBigProcessLock::Yes)                      \
     S(join_thread, NeedsBigProcessLock::Yes)                \
     S(kill, NeedsBigProcessLock::Yes)                       \
@@ -147,13 +154,18 @@ enum class NeedsBigProcessLock {
     S(realpath, NeedsBigProcessLock::Yes)                   \
     S(reboot, NeedsBigProcessLock::Yes)                     \
     S(recvfd, NeedsBigProcessLock::Yes)                     \
+    S(recvmmsg, NeedsBigProcessLock::Yes)                   \
     S(recvmsg, NeedsBigProcessLock::Yes)                    \
     S(rename, NeedsBigProcessLock::Yes)                     \
     S(rmdir, NeedsBigProcessLock::Yes)                      \
     S(sched_getparam, NeedsBigProcessLock::Yes)             \
+    S(sched_getscheduler, NeedsBigProcessLock::Yes)         \
     S(sched_setparam, NeedsBigProcessLock::Yes)             \
+    S(sched_setscheduler, NeedsBigProcessLock::Yes)         \
     S(select, NeedsBigProcessLock::Yes)                     \
     S(sendfd, NeedsBigProcessLock::Yes)                     \
+    S(sendfile, NeedsBigProcessLock::Yes)                   \
+    S(sendmmsg, NeedsBigProcessLock::Yes)                   \
     S(sendmsg, NeedsBigProcessLock::Yes)                    \
     S(set_coredump_metadata, NeedsBigProcessLock::Yes)      \
     S(set_mmap_name, NeedsBigProcessLock::Yes)              \
@@ -192,6 +204,7 @@ enum class NeedsBigProcessLock {
     S(unlink, NeedsBigProcessLock::Yes)                     \
     S(unveil, NeedsBigProcessLock::Yes)                     \
     S(utime, NeedsBigProcessLock::Yes)                      \
+    S(vfork, NeedsBigProcessLock::Yes)                      \
     S(waitid, NeedsBigProcessLock::Yes)                     \
     S(write, NeedsBigProcessLock::Yes)                      \
     S(writev, NeedsBigProcessLock::Yes)                     \
@@ -322,6 +335,21 @@ struct SC_getpeername_params {
     socklen_t* addrlen;
 };
 
+struct SC_recvmmsg_params {
+    int sockfd;
+    struct mmsghdr* msgvec;
+    unsigned vlen;
+    int flags;
+    const struct timespec* timeout;
+};
+
+struct SC_sendmmsg_params {
+    int sockfd;
+    struct mmsghdr* msgvec;
+    unsigned vlen;
+    int flags;
+};
+
 struct SC_socketpair_params {
     int domain;
     int type;
@@ -341,6 +369,19 @@ struct SC_futex_params {
     u32 val3;
 };
 
+struct SC_sendfile_params {
+    int out_fd;
+    int in_fd;
+    // In/out file offset; pass null to use (and advance) in_fd's cursor.
+    i64* offset;
+    size_t count;
+};
+
+struct SC_iobatch_params {
+    struct iobatch_op* ops;
+    size_t count;
+};
+
 struct SC_setkeymap_params {
     const u32* map;
     const u32* shift_map;
@@ -476,6 +517,20 @@ struct SC_set_coredump_metadata_params {
     StringArgument value;
 };
 
+struct SC_event_queue_ctl_params {
+    int queue_fd;
+    int op;
+    int fd;
+    u32 events;
+};
+
+struct SC_event_queue_wait_params {
+    int queue_fd;
+    struct EventQueueEvent* events;
+    size_t max_events;
+    const struct timespec* timeout;
+};
+
 struct SC_inode_watcher_add_watch_params {
     int fd;
     StringArgument user_path;
@@ -676,6 +676,16 @@ void Processor::check_invoke_scheduler()
 
 void Processor::flush_tlb_local(VirtualAddress vaddr, size_t page_count)
 {
+    // Above this many pages it's cheaper to drop all non-global translations
+    // in one go than to invlpg every single page. Kernel mappings are global
+    // (and kernel ranges this large are rare anyway), so only user ranges
+    // take this shortcut.
+    static constexpr size_t full_flush_threshold = 64;
+    if (page_count >= full_flush_threshold && Memory::is_user_address(vaddr)) {
+        write_cr3(read_cr3());
+        return;
+    }
+
     auto ptr = vaddr.as_ptr();
     while (page_count > 0) {
         // clang-format off
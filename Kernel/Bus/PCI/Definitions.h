@@ -57,6 +57,8 @@ namespace Kernel {
 #define PCI_IDE_CTRL_SUBCLASS_ID 0x1
 #define PCI_SATA_CTRL_SUBCLASS_ID 0x6
 #define PCI_AHCI_IF_PROGIF 0x1
+#define PCI_NVME_CTRL_SUBCLASS_ID 0x8
+#define PCI_NVME_IF_PROGIF 0x2
 
 namespace PCI {
 struct ID {
@@ -196,6 +196,24 @@ UNMAP_AFTER_INIT AHCIResetMode CommandLine::ahci_reset_mode() const
     PANIC("Unknown AHCIResetMode: {}", ahci_reset_mode);
 }
 
+UNMAP_AFTER_INIT size_t CommandLine::e1000_rx_ring_size() const
+{
+    const auto ring_size = lookup("e1000_rx_ring_size"sv).value_or("256"sv);
+    auto value = ring_size.to_uint();
+    if (value.has_value())
+        return value.value();
+    PANIC("Invalid e1000_rx_ring_size value: {}", ring_size);
+}
+
+UNMAP_AFTER_INIT size_t CommandLine::e1000_tx_ring_size() const
+{
+    const auto ring_size = lookup("e1000_tx_ring_size"sv).value_or("64"sv);
+    auto value = ring_size.to_uint();
+    if (value.has_value())
+        return value.value();
+    PANIC("Invalid e1000_tx_ring_size value: {}", ring_size);
+}
+
 BootMode CommandLine::boot_mode(Validate should_validate) const
 {
     const auto boot_mode = lookup("boot_mode"sv).value_or("graphical"sv);
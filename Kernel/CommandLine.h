@@ -75,6 +75,8 @@ public:
     [[nodiscard]] bool disable_usb() const;
     [[nodiscard]] bool disable_virtio() const;
     [[nodiscard]] AHCIResetMode ahci_reset_mode() const;
+    [[nodiscard]] size_t e1000_rx_ring_size() const;
+    [[nodiscard]] size_t e1000_tx_ring_size() const;
     [[nodiscard]] StringView userspace_init() const;
     [[nodiscard]] Vector<String> userspace_init_args() const;
     [[nodiscard]] StringView root_device() const;
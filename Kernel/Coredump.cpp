@@ -156,18 +156,18 @@ KResult Coredump::write_regions()
         for (size_t i = 0; i < region->page_count(); i++) {
             auto* page = region->physical_page(i);
 
-            uint8_t zero_buffer[PAGE_SIZE] = {};
-            Optional<UserOrKernelBuffer> src_buffer;
-
-            if (page) {
-                src_buffer = UserOrKernelBuffer::for_user_buffer(reinterpret_cast<uint8_t*>((region->vaddr().as_ptr() + (i * PAGE_SIZE))), PAGE_SIZE);
-            } else {
-                // If the current page is not backed by a physical page, we zero it in the coredump file.
-                // TODO: Do we want to include the contents of pages that have not been faulted-in in the coredump?
-                //       (A page may not be backed by a physical page because it has never been faulted in when the process ran).
-                src_buffer = UserOrKernelBuffer::for_kernel_buffer(zero_buffer);
+            // Pages that were never faulted in (or that still point at the
+            // shared zero page) read back as zeroes, so represent them as a
+            // hole in the dump file instead of writing a page of zeroes.
+            // That keeps the ELF layout intact while the filesystem stores
+            // nothing at all for untouched pages.
+            if (!page || page->is_shared_zero_page() || page->is_lazy_committed_page()) {
+                TRY(m_description->seek(PAGE_SIZE, SEEK_CUR));
+                continue;
             }
-            TRY(m_description->write(src_buffer.value(), PAGE_SIZE));
+
+            auto src_buffer = UserOrKernelBuffer::for_user_buffer(reinterpret_cast<uint8_t*>((region->vaddr().as_ptr() + (i * PAGE_SIZE))), PAGE_SIZE);
+            TRY(m_description->write(src_buffer, PAGE_SIZE));
         }
     }
     return KSuccess;
@@ -186,14 +186,15 @@ String Device::absolute_path(const OpenFileDescription&) const
     return absolute_path();
 }
 
-void Device::process_next_queued_request(Badge<AsyncDeviceRequest>, const AsyncDeviceRequest& completed_request)
+void Device::process_next_queued_request(Badge<AsyncDeviceRequest>, const AsyncDeviceRequest&)
 {
     SpinlockLocker lock(m_requests_lock);
-    VERIFY(!m_requests.is_empty());
-    VERIFY(m_requests.first().ptr() == &completed_request);
-    m_requests.remove(m_requests.begin());
-    if (!m_requests.is_empty()) {
-        auto* next_request = m_requests.first().ptr();
+    VERIFY(m_started_requests_count > 0);
+    --m_started_requests_count;
+    if (!m_requests.is_empty() && m_started_requests_count < max_parallel_requests()) {
+        RefPtr<AsyncDeviceRequest> next_request = m_requests.first();
+        m_requests.remove(m_requests.begin());
+        ++m_started_requests_count;
         next_request->do_start(move(lock));
     }
 
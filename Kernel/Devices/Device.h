@@ -58,15 +58,21 @@ public:
     {
         auto request = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) AsyncRequestType(*this, forward<Args>(args)...)));
         SpinlockLocker lock(m_requests_lock);
-        bool was_empty = m_requests.is_empty();
-        m_requests.append(request);
-        if (was_empty)
+        if (m_started_requests_count < max_parallel_requests()) {
+            ++m_started_requests_count;
             request->do_start(move(lock));
+        } else {
+            m_requests.append(request);
+        }
         return request;
     }
 
 protected:
     Device(unsigned major, unsigned minor);
+
+    // Devices that can process multiple requests at once (e.g. NCQ-capable
+    // disks) override this with the queue depth they can handle.
+    virtual size_t max_parallel_requests() const { return 1; }
     void set_uid(UserID uid) { m_uid = uid; }
     void set_gid(GroupID gid) { m_gid = gid; }
 
@@ -82,6 +88,7 @@ private:
 
     Spinlock m_requests_lock;
     DoublyLinkedList<RefPtr<AsyncDeviceRequest>> m_requests;
+    size_t m_started_requests_count { 0 };
     WeakPtr<SysFSDeviceComponent> m_sysfs_component;
 };
 
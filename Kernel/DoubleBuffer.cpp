@@ -36,6 +36,41 @@ DoubleBuffer::DoubleBuffer(size_t capacity, NonnullOwnPtr<KBuffer> storage)
     m_space_for_writing = capacity;
 }
 
+KResult DoubleBuffer::try_resize(size_t new_capacity)
+{
+    MutexLocker locker(m_lock);
+    if (new_capacity == m_capacity)
+        return KSuccess;
+    size_t buffered_bytes = (m_read_buffer->size - m_read_buffer_index) + m_write_buffer->size;
+    if (buffered_bytes > new_capacity)
+        return EBUSY;
+    auto new_storage = TRY(KBuffer::try_create_with_size(new_capacity * 2, Memory::Region::Access::ReadWrite, "DoubleBuffer"));
+
+    // Move all currently buffered bytes into the new read buffer, preserving
+    // the order the reader would have seen them in.
+    u8* new_data = new_storage->data();
+    size_t copied = 0;
+    size_t unread_bytes = m_read_buffer->size - m_read_buffer_index;
+    memcpy(new_data, m_read_buffer->data + m_read_buffer_index, unread_bytes);
+    copied += unread_bytes;
+    memcpy(new_data + copied, m_write_buffer->data, m_write_buffer->size);
+    copied += m_write_buffer->size;
+
+    m_storage = move(new_storage);
+    m_capacity = new_capacity;
+    m_buffer1.data = m_storage->data();
+    m_buffer1.size = copied;
+    m_buffer2.data = m_storage->data() + new_capacity;
+    m_buffer2.size = 0;
+    m_read_buffer = &m_buffer1;
+    m_write_buffer = &m_buffer2;
+    m_read_buffer_index = 0;
+    compute_lockfree_metadata();
+    if (m_unblock_callback && m_space_for_writing > 0)
+        m_unblock_callback();
+    return KSuccess;
+}
+
 void DoubleBuffer::flip()
 {
     VERIFY(m_read_buffer_index == m_read_buffer->size);
@@ -37,6 +37,9 @@ public:
 
     bool is_empty() const { return m_empty; }
 
+    size_t capacity() const { return m_capacity; }
+    KResult try_resize(size_t new_capacity);
+
     size_t space_for_writing() const { return m_space_for_writing; }
     size_t immediately_readable() const
     {
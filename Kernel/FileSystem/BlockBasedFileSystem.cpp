@@ -8,6 +8,7 @@
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/BlockBasedFileSystem.h>
 #include <Kernel/Process.h>
+#include <Kernel/Tasks/SyncTask.h>
 
 namespace Kernel {
 
@@ -16,6 +17,7 @@ struct CacheEntry {
     BlockBasedFileSystem::BlockIndex block_index { 0 };
     u8* data { nullptr };
     bool has_data { false };
+    bool is_dirty { false };
 };
 
 class DiskCache {
@@ -39,22 +41,38 @@ public:
 
     void mark_all_clean()
     {
-        while (auto* entry = m_dirty_list.first())
+        while (auto* entry = m_dirty_list.first()) {
+            entry->is_dirty = false;
             m_clean_list.prepend(*entry);
+        }
         m_dirty = false;
+        m_dirty_count = 0;
     }
 
     void mark_dirty(CacheEntry& entry)
     {
+        if (!entry.is_dirty) {
+            entry.is_dirty = true;
+            ++m_dirty_count;
+        }
         m_dirty_list.prepend(entry);
         m_dirty = true;
     }
 
     void mark_clean(CacheEntry& entry)
     {
+        if (entry.is_dirty) {
+            entry.is_dirty = false;
+            VERIFY(m_dirty_count > 0);
+            --m_dirty_count;
+        }
         m_clean_list.prepend(entry);
     }
 
+    // Once this many blocks are dirty we ask the sync task to start flushing
+    // in the background, well before writers would stall on a full cache.
+    bool should_request_background_flush() const { return m_dirty_count >= EntryCount / 4; }
+
     CacheEntry& get(BlockBasedFileSystem::BlockIndex block_index) const
     {
         if (auto it = m_hash.find(block_index); it != m_hash.end()) {
@@ -101,6 +119,7 @@ private:
     mutable IntrusiveList<CacheEntry, RawPtr<CacheEntry>, &CacheEntry::list_node> m_dirty_list;
     NonnullOwnPtr<KBuffer> m_cached_block_data;
     NonnullOwnPtr<KBuffer> m_entries;
+    size_t m_dirty_count { 0 };
     bool m_dirty { false };
 };
 
@@ -151,6 +170,9 @@ KResult BlockBasedFileSystem::write_block(BlockIndex index, const UserOrKernelBu
 
         cache->mark_dirty(entry);
         entry.has_data = true;
+
+        if (cache->should_request_background_flush())
+            SyncTask::request_sync();
         return KSuccess;
     });
 }
@@ -250,24 +272,56 @@ KResult BlockBasedFileSystem::read_blocks(BlockIndex index, unsigned count, User
     return KSuccess;
 }
 
+void BlockBasedFileSystem::read_blocks_ahead(BlockIndex index, unsigned count) const
+{
+    VERIFY(m_logical_block_size);
+    if (count < 2)
+        return;
+    dbgln_if(BBFS_DEBUG, "BlockBasedFileSystem::read_blocks_ahead {}, count={}", index, count);
+
+    // This is just a hint, so we don't report errors to the caller; any block
+    // we fail to prefetch here will simply be read on demand later instead.
+    auto buffer_or_error = KBuffer::try_create_with_size(count * block_size());
+    if (buffer_or_error.is_error())
+        return;
+    auto buffer = buffer_or_error.release_value();
+
+    m_cache.with_exclusive([&](auto& cache) {
+        auto base_offset = index.value() * block_size();
+        auto read_buffer = UserOrKernelBuffer::for_kernel_buffer(buffer->data());
+        auto nread = file_description().read(read_buffer, base_offset, count * block_size());
+        if (nread.is_error() || nread.value() != count * block_size())
+            return;
+        for (unsigned i = 0; i < count; ++i) {
+            auto& entry = cache->get(BlockIndex { index.value() + i });
+            // Don't overwrite blocks that are already cached; they may contain
+            // newer (dirty) data than what we just read from disk.
+            if (entry.has_data)
+                continue;
+            memcpy(entry.data, buffer->data() + i * block_size(), block_size());
+            entry.has_data = true;
+        }
+    });
+}
+
 void BlockBasedFileSystem::flush_specific_block_if_needed(BlockIndex index)
 {
     m_cache.with_exclusive([&](auto& cache) {
         if (!cache->is_dirty())
             return;
-        Vector<CacheEntry*, 32> cleaned_entries;
+        CacheEntry* entry_to_clean = nullptr;
         cache->for_each_dirty_entry([&](CacheEntry& entry) {
-            if (entry.block_index != index) {
+            if (entry.block_index == index) {
                 size_t base_offset = entry.block_index.value() * block_size();
                 auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
                 [[maybe_unused]] auto rc = file_description().write(base_offset, entry_data_buffer, block_size());
-                cleaned_entries.append(&entry);
+                entry_to_clean = &entry;
             }
         });
-        // NOTE: We make a separate pass to mark entries clean since marking them clean
-        //       moves them out of the dirty list which would disturb the iteration above.
-        for (auto* entry : cleaned_entries)
-            cache->mark_clean(*entry);
+        // NOTE: We mark the entry clean after iterating since doing so moves it
+        //       out of the dirty list, which would disturb the iteration above.
+        if (entry_to_clean)
+            cache->mark_clean(*entry_to_clean);
     });
 }
 
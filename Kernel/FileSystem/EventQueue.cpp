@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/EventQueue.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/StdLib.h>
+
+namespace Kernel {
+
+using BlockFlags = Thread::FileBlocker::BlockFlags;
+
+KResultOr<NonnullRefPtr<EventQueue>> EventQueue::try_create()
+{
+    return adopt_nonnull_ref_or_enomem(new (nothrow) EventQueue);
+}
+
+EventQueue::~EventQueue()
+{
+}
+
+bool EventQueue::can_read(const OpenFileDescription&, size_t) const
+{
+    MutexLocker locker(m_lock);
+    for (auto& it : m_registrations) {
+        auto& description = *it.value.description;
+        if ((it.value.events & EventQueueEvent::Read) && description.can_read())
+            return true;
+        if ((it.value.events & EventQueueEvent::Write) && description.can_write())
+            return true;
+    }
+    return false;
+}
+
+String EventQueue::absolute_path(const OpenFileDescription&) const
+{
+    return String::formatted("EventQueue:({})", m_registrations.size());
+}
+
+KResult EventQueue::register_description(int fd, NonnullRefPtr<OpenFileDescription> description, u32 events)
+{
+    // Queues watching queues could deadlock on each other's locks; nobody
+    // needs that badly enough.
+    if (description->is_event_queue())
+        return EINVAL;
+    MutexLocker locker(m_lock);
+    if (m_registrations.contains(fd))
+        return EEXIST;
+    m_registrations.set(fd, Registration { move(description), events });
+    return KSuccess;
+}
+
+KResult EventQueue::modify_registration(int fd, u32 events)
+{
+    MutexLocker locker(m_lock);
+    auto it = m_registrations.find(fd);
+    if (it == m_registrations.end())
+        return ENOENT;
+    it->value.events = events;
+    return KSuccess;
+}
+
+KResult EventQueue::unregister_description(int fd)
+{
+    MutexLocker locker(m_lock);
+    if (!m_registrations.remove(fd))
+        return ENOENT;
+    return KSuccess;
+}
+
+KResultOr<size_t> EventQueue::wait(Userspace<EventQueueEvent*> user_events, size_t max_events, Thread::BlockTimeout const& timeout)
+{
+    if (max_events == 0)
+        return EINVAL;
+
+    // Snapshot the registrations so we don't hold our lock while blocked;
+    // additions and removals from other threads simply apply to the next
+    // wait. The descriptions themselves are refcounted, so a registration
+    // removed mid-wait stays valid until we're done with it.
+    Thread::SelectBlocker::FDVector fds_info;
+    Vector<int, FD_SETSIZE> registered_fds;
+    {
+        MutexLocker locker(m_lock);
+        for (auto& it : m_registrations) {
+            auto block_flags = BlockFlags::Exception;
+            if (it.value.events & EventQueueEvent::Read)
+                block_flags |= BlockFlags::Read;
+            if (it.value.events & EventQueueEvent::Write)
+                block_flags |= BlockFlags::Write;
+            if (!fds_info.try_append({ it.value.description, block_flags }))
+                return ENOMEM;
+            if (!registered_fds.try_append(it.key))
+                return ENOMEM;
+        }
+    }
+
+    if (Thread::current()->block<Thread::SelectBlocker>(timeout, fds_info).was_interrupted())
+        return EINTR;
+
+    size_t event_count = 0;
+    for (size_t i = 0; i < fds_info.size() && event_count < max_events; ++i) {
+        auto& fd_entry = fds_info[i];
+        if (fd_entry.unblocked_flags == BlockFlags::None)
+            continue;
+
+        EventQueueEvent event { registered_fds[i], 0 };
+        if (has_flag(fd_entry.unblocked_flags, BlockFlags::Read))
+            event.events |= EventQueueEvent::Read;
+        if (has_flag(fd_entry.unblocked_flags, BlockFlags::Write))
+            event.events |= EventQueueEvent::Write;
+        if (has_any_flag(fd_entry.unblocked_flags, BlockFlags::WriteError | BlockFlags::WriteNotOpen))
+            event.events |= EventQueueEvent::Error;
+        if (has_any_flag(fd_entry.unblocked_flags, BlockFlags::WriteHangUp | BlockFlags::ReadHangUp))
+            event.events |= EventQueueEvent::HangUp;
+        if (!event.events)
+            continue;
+
+        TRY(copy_to_user(user_events.unsafe_userspace_ptr() + event_count, &event));
+        event_count++;
+    }
+    // Readiness is level-triggered: anything that didn't fit in the buffer
+    // is still ready and will be reported by the next wait.
+    return event_count;
+}
+
+}
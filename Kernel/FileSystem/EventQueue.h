@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <Kernel/API/EventQueue.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/Forward.h>
+#include <Kernel/Thread.h>
+
+namespace Kernel {
+
+// The kernel half of the event_queue_*() syscalls: a persistent set of file
+// descriptor registrations that a thread can wait on, getting readiness back
+// as a compact event list instead of handing the kernel its whole interest
+// set on every call like select() and poll() do.
+class EventQueue final : public File {
+public:
+    static KResultOr<NonnullRefPtr<EventQueue>> try_create();
+    virtual ~EventQueue() override;
+
+    virtual bool can_read(const OpenFileDescription&, size_t) const override;
+    // Events are collected with event_queue_wait(), not read().
+    virtual KResultOr<size_t> read(OpenFileDescription&, u64, UserOrKernelBuffer&, size_t) override { return EINVAL; }
+    // Can't write to an event queue.
+    virtual bool can_write(const OpenFileDescription&, size_t) const override { return true; }
+    virtual KResultOr<size_t> write(OpenFileDescription&, u64, const UserOrKernelBuffer&, size_t) override { return EIO; }
+
+    virtual String absolute_path(const OpenFileDescription&) const override;
+    virtual StringView class_name() const override { return "EventQueue"; };
+    virtual bool is_event_queue() const override { return true; }
+
+    KResult register_description(int fd, NonnullRefPtr<OpenFileDescription>, u32 events);
+    KResult modify_registration(int fd, u32 events);
+    KResult unregister_description(int fd);
+
+    KResultOr<size_t> wait(Userspace<EventQueueEvent*>, size_t max_events, Thread::BlockTimeout const&);
+
+private:
+    EventQueue() { }
+
+    struct Registration {
+        NonnullRefPtr<OpenFileDescription> description;
+        u32 events { 0 };
+    };
+
+    mutable Mutex m_lock;
+    // Keyed by the file descriptor number userspace registered. The
+    // registration pins the description, so it stays watched (and keeps
+    // reporting readiness) until it's explicitly removed, even if userspace
+    // closes the last descriptor referring to it in the meantime.
+    HashMap<int, Registration> m_registrations;
+};
+
+}
@@ -864,6 +864,11 @@ KResultOr<size_t> Ext2FSInode::read_bytes(off_t offset, size_t count, UserOrKern
     size_t nread = 0;
     auto remaining_count = min((off_t)count, (off_t)size() - offset);
 
+    // If this read picks up where the previous one left off, assume sequential
+    // access and prefetch the physically contiguous run of blocks following it
+    // into the disk cache, so they're already there when the next reads arrive.
+    bool is_sequential_read = allow_cache && offset == m_previous_read_end_offset;
+
     dbgln_if(EXT2_VERY_DEBUG, "Ext2FSInode[{}]::read_bytes(): Reading up to {} bytes, {} bytes into inode to {}", identifier(), count, offset, buffer.user_or_kernel_ptr());
 
     for (auto bi = first_block_logical_index; remaining_count && bi <= last_block_logical_index; bi = bi.value() + 1) {
@@ -884,6 +889,24 @@ KResultOr<size_t> Ext2FSInode::read_bytes(off_t offset, size_t count, UserOrKern
         nread += num_bytes_to_copy;
     }
 
+    m_previous_read_end_offset = offset + nread;
+
+    if (is_sequential_read) {
+        constexpr size_t max_readahead_blocks = 16;
+        size_t readahead_start = last_block_logical_index.value() + 1;
+        size_t run_length = 0;
+        while (run_length < max_readahead_blocks && readahead_start + run_length < m_block_list.size()) {
+            auto block_index = m_block_list[readahead_start + run_length];
+            if (block_index.value() == 0)
+                break;
+            if (run_length > 0 && block_index.value() != m_block_list[readahead_start + run_length - 1].value() + 1)
+                break;
+            run_length++;
+        }
+        if (run_length > 1)
+            fs().read_blocks_ahead(m_block_list[readahead_start], run_length);
+    }
+
     return nread;
 }
 
@@ -915,7 +938,7 @@ KResult Ext2FSInode::resize(u64 new_size)
         m_block_list = this->compute_block_list();
 
     if (blocks_needed_after > blocks_needed_before) {
-        auto blocks = TRY(fs().allocate_blocks(fs().group_index_from_inode(index()), blocks_needed_after - blocks_needed_before));
+        auto blocks = TRY(fs().allocate_blocks(fs().group_index_from_inode(index()), blocks_needed_after - blocks_needed_before, m_block_list.is_empty() ? BlockIndex { 0 } : m_block_list.last()));
         if (!m_block_list.try_extend(move(blocks)))
             return ENOMEM;
     } else if (blocks_needed_after < blocks_needed_before) {
@@ -1260,9 +1283,9 @@ bool Ext2FS::write_ext2_inode(InodeIndex inode, const ext2_inode& e2inode)
     return true;
 }
 
-auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count) -> KResultOr<Vector<BlockIndex>>
+auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count, BlockIndex hint) -> KResultOr<Vector<BlockIndex>>
 {
-    dbgln_if(EXT2_DEBUG, "Ext2FS: allocate_blocks(preferred group: {}, count {})", preferred_group_index, count);
+    dbgln_if(EXT2_DEBUG, "Ext2FS: allocate_blocks(preferred group: {}, count {}, hint {})", preferred_group_index, count, hint);
     if (count == 0)
         return Vector<BlockIndex> {};
 
@@ -1271,6 +1294,31 @@ auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count) ->
         return ENOMEM;
 
     MutexLocker locker(m_lock);
+
+    // If the caller gave us a hint, try to continue the allocation right after
+    // it first, so that successive allocations for the same inode form
+    // contiguous runs that sequential reads can fetch with merged requests.
+    if (hint != 0) {
+        auto hint_group_index = group_index_from_block_index(hint);
+        auto& bgd = group_descriptor(hint_group_index);
+        if (bgd.bg_free_blocks_count) {
+            if (auto cached_bitmap_or_error = get_bitmap_block(bgd.bg_block_bitmap); !cached_bitmap_or_error.is_error()) {
+                size_t blocks_in_group = min(blocks_per_group(), super_block().s_blocks_count);
+                auto block_bitmap = cached_bitmap_or_error.value()->bitmap(blocks_in_group);
+                BlockIndex first_block_in_group = (hint_group_index.value() - 1) * blocks_per_group() + first_block_index().value();
+                size_t bit = hint.value() + 1 - first_block_in_group.value();
+                for (; blocks.size() < count && bit < blocks_in_group && !block_bitmap.get(bit); ++bit) {
+                    BlockIndex block_index = bit + first_block_in_group.value();
+                    TRY(set_block_allocation_state(block_index, true));
+                    blocks.unchecked_append(block_index);
+                    dbgln_if(EXT2_DEBUG, "  allocated (following hint) > {}", block_index);
+                }
+            }
+        }
+        if (blocks.size() == count)
+            return blocks;
+    }
+
     auto group_index = preferred_group_index;
 
     if (!group_descriptor(preferred_group_index).bg_free_blocks_count) {
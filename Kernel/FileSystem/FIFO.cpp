@@ -9,6 +9,7 @@
 #include <Kernel/FileSystem/FIFO.h>
 #include <Kernel/FileSystem/OpenFileDescription.h>
 #include <Kernel/Locking/Mutex.h>
+#include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Process.h>
 #include <Kernel/Thread.h>
 
@@ -22,6 +23,17 @@ KResultOr<NonnullRefPtr<FIFO>> FIFO::try_create(UserID uid)
     return adopt_nonnull_ref_or_enomem(new (nothrow) FIFO(uid, move(buffer)));
 }
 
+KResult FIFO::try_set_buffer_capacity(size_t capacity)
+{
+    if (capacity == 0 || capacity > maximum_buffer_capacity)
+        return EINVAL;
+    // Round up to whole pages so userspace can rely on getting at least
+    // what it asked for back from F_GETPIPE_SZ.
+    if (Memory::page_round_up_would_wrap(capacity))
+        return EINVAL;
+    return m_buffer->try_resize(Memory::page_round_up(capacity));
+}
+
 KResultOr<NonnullRefPtr<OpenFileDescription>> FIFO::open_direction(FIFO::Direction direction)
 {
     auto description = TRY(OpenFileDescription::try_create(*this));
@@ -29,6 +29,11 @@ public:
 
     UserID uid() const { return m_uid; }
 
+    static constexpr size_t maximum_buffer_capacity = 4 * MiB;
+
+    size_t buffer_capacity() const { return m_buffer->capacity(); }
+    KResult try_set_buffer_capacity(size_t);
+
     KResultOr<NonnullRefPtr<OpenFileDescription>> open_direction(Direction);
     KResultOr<NonnullRefPtr<OpenFileDescription>> open_direction_blocking(Direction);
 
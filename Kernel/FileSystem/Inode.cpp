@@ -199,6 +199,8 @@ void Inode::set_metadata_dirty(bool metadata_dirty)
 
 void Inode::did_add_child(InodeIdentifier const&, String const& name)
 {
+    VirtualFileSystem::the().invalidate_directory_entry_cache(identifier(), name);
+
     MutexLocker locker(m_inode_lock);
 
     for (auto& watcher : m_watchers) {
@@ -208,6 +210,8 @@ void Inode::did_add_child(InodeIdentifier const&, String const& name)
 
 void Inode::did_remove_child(InodeIdentifier const&, String const& name)
 {
+    VirtualFileSystem::the().invalidate_directory_entry_cache(identifier(), name);
+
     MutexLocker locker(m_inode_lock);
 
     if (name == "." || name == "..") {
@@ -31,6 +31,26 @@ KResultOr<size_t> InodeFile::read(OpenFileDescription& description, u64 offset,
     if (Checked<off_t>::addition_would_overflow(offset, count))
         return EOVERFLOW;
 
+    // If someone has this inode mapped into memory, serve the read straight
+    // from the pages of its SharedInodeVMObject when they're all paged in.
+    // This skips the extra copy through the disk cache, and makes read()
+    // observe writes done through shared memory mappings.
+    if (auto shared_vmobject = m_inode->shared_vmobject()) {
+        auto inode_size = static_cast<u64>(m_inode->size());
+        if (offset >= inode_size)
+            return 0;
+        size_t nread_limit = min(static_cast<u64>(count), inode_size - offset);
+        auto nread_from_cache = TRY(shared_vmobject->read_from_cached_pages(offset, nread_limit, buffer));
+        if (nread_from_cache == nread_limit) {
+            if (nread_from_cache > 0) {
+                Thread::current()->did_file_read(nread_from_cache);
+                evaluate_block_conditions();
+            }
+            return nread_from_cache;
+        }
+        // Some of the pages weren't in memory, so read through the filesystem instead.
+    }
+
     auto nread = TRY(m_inode->read_bytes(offset, count, buffer, &description));
     if (nread > 0) {
         Thread::current()->did_file_read(nread);
@@ -46,6 +66,10 @@ KResultOr<size_t> InodeFile::write(OpenFileDescription& description, u64 offset,
 
     auto nwritten = TRY(m_inode->write_bytes(offset, count, data, &description));
     if (nwritten > 0) {
+        // Propagate the write into any already-cached pages of a shared memory
+        // mapping of this inode, so mappings don't keep seeing stale data.
+        if (auto shared_vmobject = m_inode->shared_vmobject())
+            TRY(shared_vmobject->write_to_cached_pages(offset, nwritten, data));
         auto mtime_result = m_inode->set_mtime(kgettimeofday().to_truncated_seconds());
         Thread::current()->did_file_write(nwritten);
         evaluate_block_conditions();
@@ -323,6 +323,25 @@ InodeWatcher* OpenFileDescription::inode_watcher()
     return static_cast<InodeWatcher*>(m_file.ptr());
 }
 
+bool OpenFileDescription::is_event_queue() const
+{
+    return m_file->is_event_queue();
+}
+
+const EventQueue* OpenFileDescription::event_queue() const
+{
+    if (!is_event_queue())
+        return nullptr;
+    return static_cast<const EventQueue*>(m_file.ptr());
+}
+
+EventQueue* OpenFileDescription::event_queue()
+{
+    if (!is_event_queue())
+        return nullptr;
+    return static_cast<EventQueue*>(m_file.ptr());
+}
+
 bool OpenFileDescription::is_master_pty() const
 {
     return m_file->is_master_pty();
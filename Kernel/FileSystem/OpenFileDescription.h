@@ -86,6 +86,10 @@ public:
     const InodeWatcher* inode_watcher() const;
     InodeWatcher* inode_watcher();
 
+    bool is_event_queue() const;
+    const EventQueue* event_queue() const;
+    EventQueue* event_queue();
+
     bool is_master_pty() const;
     const MasterPTY* master_pty() const;
     MasterPTY* master_pty();
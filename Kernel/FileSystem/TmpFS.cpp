@@ -5,6 +5,7 @@
  */
 
 #include <Kernel/FileSystem/TmpFS.h>
+#include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Process.h>
 #include <LibC/limits.h>
 
@@ -129,16 +130,34 @@ KResultOr<size_t> TmpFSInode::read_bytes(off_t offset, size_t size, UserOrKernel
     VERIFY(!is_directory());
     VERIFY(offset >= 0);
 
-    if (!m_content)
-        return 0;
-
     if (offset >= m_metadata.size)
         return 0;
 
     if (static_cast<off_t>(size) > m_metadata.size - offset)
         size = m_metadata.size - offset;
 
-    TRY(buffer.write(m_content->data() + offset, size));
+    u8 page_buffer[PAGE_SIZE];
+    size_t nread = 0;
+    while (nread < size) {
+        size_t page_index = offset / PAGE_SIZE;
+        size_t offset_in_page = offset % PAGE_SIZE;
+        size_t num_bytes_to_copy = min(PAGE_SIZE - offset_in_page, size - nread);
+        auto page = page_index < m_content_pages.size() ? m_content_pages[page_index] : RefPtr<Memory::PhysicalPage> {};
+        if (page.is_null()) {
+            // Pages that were never written to read as zeroes.
+            TRY(buffer.offset(nread).memset(0, num_bytes_to_copy));
+        } else {
+            {
+                SpinlockLocker mm_locker(Memory::s_mm_lock);
+                u8* src_ptr = MM.quickmap_page(*page);
+                memcpy(page_buffer, src_ptr + offset_in_page, num_bytes_to_copy);
+                MM.unquickmap_page();
+            }
+            TRY(buffer.offset(nread).write(page_buffer, num_bytes_to_copy));
+        }
+        offset += num_bytes_to_copy;
+        nread += num_bytes_to_copy;
+    }
     return size;
 }
 
@@ -159,27 +178,33 @@ KResultOr<size_t> TmpFSInode::write_bytes(off_t offset, size_t size, const UserO
         return ENOMEM;                                                   // we won't be able to resize to this capacity
 
     if (new_size > old_size) {
-        if (m_content && static_cast<off_t>(m_content->capacity()) >= new_size) {
-            m_content->set_size(new_size);
-        } else {
-            // Grow the content buffer 2x the new sizeto accommodate repeating write() calls.
-            // Note that we're not actually committing physical memory to the buffer
-            // until it's needed. We only grow VM here.
-
-            // FIXME: Fix this so that no memcpy() is necessary, and we can just grow the
-            //        KBuffer and it will add physical pages as needed while keeping the
-            //        existing ones.
-            auto tmp = TRY(KBuffer::try_create_with_size(new_size * 2));
-            tmp->set_size(new_size);
-            if (m_content)
-                memcpy(tmp->data(), m_content->data(), old_size);
-            m_content = move(tmp);
-        }
+        TRY(resize_content_pages(new_size));
         m_metadata.size = new_size;
         notify_watchers();
     }
 
-    TRY(buffer.read(m_content->data() + offset, size)); // TODO: partial reads?
+    u8 page_buffer[PAGE_SIZE];
+    size_t nwritten = 0;
+    while (nwritten < size) {
+        size_t page_index = offset / PAGE_SIZE;
+        size_t offset_in_page = offset % PAGE_SIZE;
+        size_t num_bytes_to_copy = min(PAGE_SIZE - offset_in_page, size - nwritten);
+        auto& page = m_content_pages[page_index];
+        if (page.is_null()) {
+            page = MM.allocate_user_physical_page(Memory::MemoryManager::ShouldZeroFill::Yes);
+            if (page.is_null())
+                return ENOMEM;
+        }
+        TRY(buffer.offset(nwritten).read(page_buffer, num_bytes_to_copy));
+        {
+            SpinlockLocker mm_locker(Memory::s_mm_lock);
+            u8* dest_ptr = MM.quickmap_page(*page);
+            memcpy(dest_ptr + offset_in_page, page_buffer, num_bytes_to_copy);
+            MM.unquickmap_page();
+        }
+        offset += num_bytes_to_copy;
+        nwritten += num_bytes_to_copy;
+    }
 
     did_modify_contents();
     return size;
@@ -314,20 +339,20 @@ KResult TmpFSInode::truncate(u64 size)
     MutexLocker locker(m_inode_lock);
     VERIFY(!is_directory());
 
-    if (size == 0)
-        m_content.clear();
-    else if (!m_content) {
-        m_content = TRY(KBuffer::try_create_with_size(size));
-    } else if (static_cast<size_t>(size) < m_content->capacity()) {
-        size_t prev_size = m_metadata.size;
-        m_content->set_size(size);
-        if (prev_size < static_cast<size_t>(size))
-            memset(m_content->data() + prev_size, 0, size - prev_size);
-    } else {
-        size_t prev_size = m_metadata.size;
-        auto tmp = TRY(KBuffer::try_create_with_size(size));
-        memcpy(tmp->data(), m_content->data(), prev_size);
-        m_content = move(tmp);
+    u64 old_size = m_metadata.size;
+    TRY(resize_content_pages(size));
+
+    if (size < old_size && size % PAGE_SIZE != 0) {
+        // Zero out the tail of the last remaining page, so that growing the
+        // file again later exposes zeroes rather than the old contents.
+        auto& page = m_content_pages[size / PAGE_SIZE];
+        if (!page.is_null()) {
+            size_t offset_in_page = size % PAGE_SIZE;
+            SpinlockLocker mm_locker(Memory::s_mm_lock);
+            u8* page_ptr = MM.quickmap_page(*page);
+            memset(page_ptr + offset_in_page, 0, PAGE_SIZE - offset_in_page);
+            MM.unquickmap_page();
+        }
     }
 
     m_metadata.size = size;
@@ -335,6 +360,14 @@ KResult TmpFSInode::truncate(u64 size)
     return KSuccess;
 }
 
+KResult TmpFSInode::resize_content_pages(size_t new_size)
+{
+    size_t new_page_count = ceil_div(new_size, static_cast<size_t>(PAGE_SIZE));
+    if (!m_content_pages.try_resize(new_page_count))
+        return ENOMEM;
+    return KSuccess;
+}
+
 KResult TmpFSInode::set_atime(time_t time)
 {
     MutexLocker locker(m_inode_lock);
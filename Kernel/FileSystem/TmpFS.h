@@ -8,7 +8,7 @@
 
 #include <Kernel/FileSystem/FileSystem.h>
 #include <Kernel/FileSystem/Inode.h>
-#include <Kernel/KBuffer.h>
+#include <Kernel/Memory/PhysicalPage.h>
 
 namespace Kernel {
 
@@ -87,7 +87,12 @@ private:
     InodeMetadata m_metadata;
     InodeIdentifier m_parent;
 
-    OwnPtr<KBuffer> m_content;
+    KResult resize_content_pages(size_t new_size);
+
+    // File content is stored directly in physical pages, so growing a file
+    // just appends pages instead of reallocating and copying a buffer.
+    // A null page reads as zeroes and is only allocated when written to.
+    Vector<RefPtr<Memory::PhysicalPage>> m_content_pages;
 
     Child::List m_children;
 };
@@ -92,6 +92,11 @@ KResult VirtualFileSystem::unmount(Inode& guest_inode)
 {
     dbgln("VirtualFileSystem: unmount called with inode {}", guest_inode.identifier());
 
+    // Drop all cached directory entries, both because they may refer to the
+    // filesystem being unmounted and because the refs they hold would make
+    // prepare_to_unmount() consider it busy.
+    clear_directory_entry_cache();
+
     return m_mounts.with_exclusive([&](auto& mounts) -> KResult {
         for (size_t i = 0; i < mounts.size(); ++i) {
             auto& mount = mounts[i];
@@ -160,6 +165,47 @@ bool VirtualFileSystem::is_vfs_root(InodeIdentifier inode) const
     return inode == root_inode_id();
 }
 
+Optional<RefPtr<Inode>> VirtualFileSystem::lookup_directory_entry_in_cache(InodeIdentifier parent, StringView name)
+{
+    SpinlockLocker locker(m_directory_entry_cache_lock);
+    auto it = m_directory_entry_cache.find(DirectoryCacheKey { parent, name });
+    if (it == m_directory_entry_cache.end())
+        return {};
+    return it->value;
+}
+
+void VirtualFileSystem::add_directory_entry_to_cache(InodeIdentifier parent, StringView name, RefPtr<Inode> child)
+{
+    // NOTE: Evicted entries must not be destroyed while holding the cache
+    //       lock, since dropping the last reference to an inode can block.
+    HashMap<DirectoryCacheKey, RefPtr<Inode>> evicted_entries;
+    SpinlockLocker locker(m_directory_entry_cache_lock);
+    if (m_directory_entry_cache.size() >= maximum_directory_entry_cache_size) {
+        // The cache is full; just drop everything and start over rather than
+        // doing any clever eviction bookkeeping on the hot path.
+        evicted_entries = move(m_directory_entry_cache);
+    }
+    m_directory_entry_cache.set(DirectoryCacheKey { parent, name }, move(child));
+}
+
+void VirtualFileSystem::invalidate_directory_entry_cache(InodeIdentifier parent, StringView name)
+{
+    RefPtr<Inode> cached_child;
+    SpinlockLocker locker(m_directory_entry_cache_lock);
+    auto it = m_directory_entry_cache.find(DirectoryCacheKey { parent, name });
+    if (it != m_directory_entry_cache.end()) {
+        cached_child = move(it->value);
+        m_directory_entry_cache.remove(it);
+    }
+}
+
+void VirtualFileSystem::clear_directory_entry_cache()
+{
+    HashMap<DirectoryCacheKey, RefPtr<Inode>> evicted_entries;
+    SpinlockLocker locker(m_directory_entry_cache_lock);
+    evicted_entries = move(m_directory_entry_cache);
+}
+
 KResult VirtualFileSystem::traverse_directory_inode(Inode& dir_inode, Function<bool(FileSystem::DirectoryEntryView const&)> callback)
 {
     return dir_inode.traverse_as_directory([&](auto& entry) {
@@ -886,18 +932,35 @@ KResultOr<NonnullRefPtr<Custody>> VirtualFileSystem::resolve_path_without_veil(S
             continue;
         }
 
-        // Okay, let's look up this part.
-        auto child_or_error = parent.inode().lookup(part);
-        if (child_or_error.is_error()) {
+        // Okay, let's look up this part, consulting the directory entry cache
+        // first so that repeated path resolution doesn't go through the
+        // filesystem every time. Only file-backed filesystems are cacheable;
+        // synthetic ones like ProcFS gain and lose entries without notice.
+        RefPtr<Inode> child_inode;
+        bool is_cacheable = parent.inode().fs().is_file_backed();
+        Optional<RefPtr<Inode>> cached_entry;
+        if (is_cacheable)
+            cached_entry = lookup_directory_entry_in_cache(parent.inode().identifier(), part);
+        if (cached_entry.has_value()) {
+            child_inode = cached_entry.release_value();
+        } else {
+            auto child_or_error = parent.inode().lookup(part);
+            if (!child_or_error.is_error())
+                child_inode = child_or_error.release_value();
+            else if (child_or_error.error() != ENOENT)
+                return child_or_error.error();
+            if (is_cacheable)
+                add_directory_entry_to_cache(parent.inode().identifier(), part, child_inode);
+        }
+        if (!child_inode) {
             if (out_parent) {
                 // ENOENT with a non-null parent custody signals to caller that
                 // we found the immediate parent of the file, but the file itself
                 // does not exist yet.
                 *out_parent = have_more_parts ? nullptr : &parent;
             }
-            return child_or_error.error();
+            return ENOENT;
         }
-        auto child_inode = child_or_error.release_value();
 
         int mount_flags_for_child = parent.mount_flags();
 
@@ -8,6 +8,7 @@
 
 #include <AK/Badge.h>
 #include <AK/Function.h>
+#include <AK/HashFunctions.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtrVector.h>
 #include <AK/OwnPtr.h>
@@ -21,6 +22,7 @@
 #include <Kernel/FileSystem/UnveilNode.h>
 #include <Kernel/Forward.h>
 #include <Kernel/Locking/MutexProtected.h>
+#include <Kernel/Locking/Spinlock.h>
 
 namespace Kernel {
 
@@ -33,6 +35,25 @@ struct UidAndGid {
     GroupID gid;
 };
 
+struct DirectoryCacheKey {
+    InodeIdentifier parent;
+    String name;
+
+    bool operator==(DirectoryCacheKey const& other) const { return parent == other.parent && name == other.name; }
+};
+
+}
+
+template<>
+struct AK::Traits<Kernel::DirectoryCacheKey> : public AK::GenericTraits<Kernel::DirectoryCacheKey> {
+    static unsigned hash(Kernel::DirectoryCacheKey const& key)
+    {
+        return pair_int_hash(pair_int_hash(key.parent.fsid(), u64_hash(key.parent.index().value())), key.name.hash());
+    }
+};
+
+namespace Kernel {
+
 class VirtualFileSystem {
     AK_MAKE_ETERNAL
 public:
@@ -76,6 +97,8 @@ public:
     KResultOr<NonnullRefPtr<Custody>> resolve_path(StringView path, Custody& base, RefPtr<Custody>* out_parent = nullptr, int options = 0, int symlink_recursion_level = 0);
     KResultOr<NonnullRefPtr<Custody>> resolve_path_without_veil(StringView path, Custody& base, RefPtr<Custody>* out_parent = nullptr, int options = 0, int symlink_recursion_level = 0);
 
+    void invalidate_directory_entry_cache(InodeIdentifier parent, StringView name);
+
 private:
     friend class OpenFileDescription;
 
@@ -90,10 +113,21 @@ private:
     Mount* find_mount_for_host(InodeIdentifier);
     Mount* find_mount_for_guest(InodeIdentifier);
 
+    Optional<RefPtr<Inode>> lookup_directory_entry_in_cache(InodeIdentifier parent, StringView name);
+    void add_directory_entry_to_cache(InodeIdentifier parent, StringView name, RefPtr<Inode> child);
+    void clear_directory_entry_cache();
+
     RefPtr<Inode> m_root_inode;
     RefPtr<Custody> m_root_custody;
 
     MutexProtected<Vector<Mount, 16>> m_mounts;
+
+    // Cache of directory entries used during path resolution, mapping
+    // (parent inode, name) to the child inode. A null child means we've
+    // cached the fact that the entry does *not* exist (a negative entry).
+    static constexpr size_t maximum_directory_entry_cache_size = 4096;
+    Spinlock m_directory_entry_cache_lock;
+    HashMap<DirectoryCacheKey, RefPtr<Inode>> m_directory_entry_cache;
 };
 
 }
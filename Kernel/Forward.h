@@ -23,6 +23,7 @@ class DevTmpFSRootDirectoryInode;
 class Device;
 class DiskCache;
 class DoubleBuffer;
+class EventQueue;
 class File;
 class OpenFileDescription;
 class FileSystem;
@@ -417,13 +417,35 @@ public:
 
 private:
     ProcFSOverallProcesses();
-    virtual KResult try_generate(KBufferBuilder& builder) override
+
+    struct CachedProcessData {
+        u64 change_ticket { 0 };
+        u64 generation { 0 };
+        String json_fragment;
+    };
+
+    // A cheap summary of all the inputs to a process's serialized form. A
+    // process can't have run, made a syscall, or gained or lost threads
+    // without this value changing, so if it matches the previous poll we can
+    // reuse the cached JSON fragment instead of formatting it all over again.
+    static u64 compute_change_ticket(const Process& process)
     {
-        JsonObjectSerializer<KBufferBuilder> json { builder };
+        u64 ticket = 0;
+        process.for_each_thread([&](const Thread& thread) {
+            ticket = ticket * 31 + thread.tid().value();
+            ticket += thread.times_scheduled();
+            ticket += thread.time_in_user();
+            ticket += thread.time_in_kernel();
+            ticket += thread.syscall_count();
+        });
+        return ticket;
+    }
 
-        // Keep this in sync with CProcessStatistics.
-        auto build_process = [&](JsonArraySerializer<KBufferBuilder>& array, const Process& process) {
-            auto process_object = array.add_object();
+    // Keep this in sync with CProcessStatistics.
+    KResult try_serialize_process(KBufferBuilder& builder, const Process& process)
+    {
+        {
+            JsonObjectSerializer<KBufferBuilder> process_object { builder };
 
             if (process.is_user_process()) {
                 StringBuilder pledge_builder;
@@ -499,24 +521,65 @@ private:
                 thread_object.add("ipv4_socket_read_bytes", thread.ipv4_socket_read_bytes());
                 thread_object.add("ipv4_socket_write_bytes", thread.ipv4_socket_write_bytes());
             });
-        };
+        }
+        return KSuccess;
+    }
 
-        SpinlockLocker lock(g_scheduler_lock);
-        {
-            {
-                auto array = json.add_array("processes");
-                auto processes = Process::all_processes();
-                build_process(array, *Scheduler::colonel());
-                for (auto& process : processes)
-                    build_process(array, process);
-            }
+    KResult try_append_process(KBufferBuilder& builder, const Process& process, bool& first)
+    {
+        auto ticket = compute_change_ticket(process);
+        auto pid = process.pid().value();
+        auto it = m_cached_processes.find(pid);
+        if (it == m_cached_processes.end() || it->value.change_ticket != ticket) {
+            auto fragment_builder = TRY(KBufferBuilder::try_create());
+            TRY(try_serialize_process(fragment_builder, process));
+            auto fragment_buffer = fragment_builder.build();
+            if (!fragment_buffer)
+                return ENOMEM;
+            String fragment { StringView { fragment_buffer->data(), fragment_buffer->size() } };
+            m_cached_processes.set(pid, CachedProcessData { ticket, m_generation, move(fragment) });
+            it = m_cached_processes.find(pid);
+        } else {
+            it->value.generation = m_generation;
+        }
+        if (!first)
+            TRY(builder.append(','));
+        first = false;
+        return builder.append(it->value.json_fragment);
+    }
 
-            auto total_time_scheduled = Scheduler::get_total_time_scheduled();
-            json.add("total_time", total_time_scheduled.total);
-            json.add("total_time_kernel", total_time_scheduled.total_kernel);
+    virtual KResult try_generate(KBufferBuilder& builder) override
+    {
+        ++m_generation;
+
+        // Snapshot the process list up front so that no global lock is held
+        // while formatting; the only locks taken below are each process's
+        // own thread list lock, one process at a time.
+        auto processes = Process::all_processes();
+
+        TRY(builder.append("{\"processes\":["sv));
+        bool first = true;
+        TRY(try_append_process(builder, *Scheduler::colonel(), first));
+        for (auto& process : processes)
+            TRY(try_append_process(builder, process, first));
+
+        auto total_time_scheduled = Scheduler::get_total_time_scheduled();
+        TRY(builder.appendff("],\"total_time\":{},\"total_time_kernel\":{}}}", total_time_scheduled.total, total_time_scheduled.total_kernel));
+
+        // Forget about processes that have disappeared since the last poll.
+        Vector<pid_t> dead_processes;
+        for (auto& entry : m_cached_processes) {
+            if (entry.value.generation != m_generation)
+                dead_processes.append(entry.key);
         }
+        for (auto dead_pid : dead_processes)
+            m_cached_processes.remove(dead_pid);
+
         return KSuccess;
     }
+
+    u64 m_generation { 0 };
+    HashMap<pid_t, CachedProcessData> m_cached_processes;
 };
 class ProcFSCPUInformation final : public ProcFSGlobalInformation {
 public:
@@ -136,6 +136,57 @@ bool FrameBufferDevice::try_to_set_resolution(size_t width, size_t height)
     return true;
 }
 
+KResult FrameBufferDevice::set_cursor(FBCursorImage const& cursor_image)
+{
+    auto cursor_buffer_size = calculate_framebuffer_size(cursor_width, cursor_height);
+    if (!m_cursor_buffer)
+        m_cursor_buffer = TRY(MM.allocate_kernel_region(cursor_buffer_size, String::formatted("VirtGPU Cursor #{}", m_scanout.value()), Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
+
+    MutexLocker locker(m_gpu.operation_lock());
+    if (cursor_image.width == 0 || cursor_image.height == 0) {
+        // An empty image hides the cursor
+        if (m_cursor_resource.value() != 0) {
+            m_gpu.update_cursor(m_scanout, 0, 0, 0);
+            m_gpu.delete_resource(m_cursor_resource);
+            m_cursor_resource = 0;
+        }
+        return KSuccess;
+    }
+
+    // Copy the image into the top-left corner of the cursor resource and
+    // leave the rest transparent.
+    auto* cursor_data = m_cursor_buffer->vaddr().as_ptr();
+    memset(cursor_data, 0, cursor_buffer_size);
+    for (size_t y = 0; y < cursor_image.height; ++y) {
+        auto* row = reinterpret_cast<u32*>(cursor_data + y * cursor_width * sizeof(u32));
+        TRY(copy_from_user(row, &cursor_image.pixels[y * cursor_image.width], cursor_image.width * sizeof(u32)));
+    }
+
+    if (m_cursor_resource.value() != 0)
+        m_gpu.delete_resource(m_cursor_resource);
+    Protocol::Rect cursor_rect {
+        .x = 0,
+        .y = 0,
+        .width = cursor_width,
+        .height = cursor_height,
+    };
+    // Unlike the framebuffer resources the cursor needs an alpha channel
+    m_cursor_resource = m_gpu.create_2d_resource(cursor_rect, Protocol::TextureFormat::VIRTIO_GPU_FORMAT_B8G8R8A8_UNORM);
+    m_gpu.ensure_backing_storage(*m_cursor_buffer, 0, cursor_buffer_size, m_cursor_resource);
+    // Note: The transfer offset works out to 0 for the top-left corner,
+    // regardless of the scanout's current resolution.
+    m_gpu.transfer_framebuffer_data_to_host(m_scanout, cursor_rect, m_cursor_resource);
+    m_gpu.update_cursor(m_scanout, m_cursor_resource, cursor_image.hot_x, cursor_image.hot_y);
+    return KSuccess;
+}
+
+KResult FrameBufferDevice::move_cursor(int x, int y)
+{
+    MutexLocker locker(m_gpu.operation_lock());
+    m_gpu.move_cursor(m_scanout, max(x, 0), max(y, 0));
+    return KSuccess;
+}
+
 void FrameBufferDevice::set_buffer(int buffer_index)
 {
     auto& buffer = buffer_index == 0 ? m_main_buffer : m_back_buffer;
@@ -232,6 +283,20 @@ KResult FrameBufferDevice::ioctl(OpenFileDescription&, unsigned request, Userspa
         buffer_offset.offset = (size_t)buffer_offset.buffer_index * m_buffer_size;
         return copy_to_user(user_buffer_offset, &buffer_offset);
     }
+    case FB_IOCTL_SET_CURSOR: {
+        auto user_cursor_image = static_ptr_cast<FBCursorImage*>(arg);
+        FBCursorImage cursor_image;
+        TRY(copy_from_user(&cursor_image, user_cursor_image));
+        if (cursor_image.width > cursor_width || cursor_image.height > cursor_height)
+            return EINVAL;
+        return set_cursor(cursor_image);
+    }
+    case FB_IOCTL_MOVE_CURSOR: {
+        auto user_cursor_position = static_ptr_cast<FBCursorPosition*>(arg);
+        FBCursorPosition cursor_position;
+        TRY(copy_from_user(&cursor_position, user_cursor_position));
+        return move_cursor(cursor_position.x, cursor_position.y);
+    }
     default:
         return EINVAL;
     };
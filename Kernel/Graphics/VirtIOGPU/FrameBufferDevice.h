@@ -11,6 +11,8 @@
 #include <Kernel/Devices/BlockDevice.h>
 #include <Kernel/Graphics/VirtIOGPU/GPU.h>
 
+struct FBCursorImage;
+
 namespace Kernel::Graphics::VirtIOGPU {
 
 class FrameBufferDevice final : public BlockDevice {
@@ -42,6 +44,10 @@ public:
         return Memory::page_round_up(sizeof(u32) * width * height);
     }
 
+    // The device requires cursor resources to be exactly this size
+    static constexpr size_t cursor_width = 64;
+    static constexpr size_t cursor_height = 64;
+
     void flush_dirty_window(Protocol::Rect const&, Buffer&);
     void transfer_framebuffer_data_to_host(Protocol::Rect const&, Buffer&);
     void flush_displayed_image(Protocol::Rect const&, Buffer&);
@@ -59,6 +65,8 @@ private:
     KResult create_framebuffer();
     void create_buffer(Buffer&, size_t, size_t);
     void set_buffer(int);
+    KResult set_cursor(FBCursorImage const&);
+    KResult move_cursor(int x, int y);
 
     virtual KResult ioctl(OpenFileDescription&, unsigned request, Userspace<void*> arg) override;
     virtual KResultOr<Memory::Region*> mmap(Process&, OpenFileDescription&, Memory::VirtualRange const&, u64 offset, int prot, bool shared) override;
@@ -87,6 +95,8 @@ private:
     Buffer m_back_buffer;
     OwnPtr<Memory::Region> m_framebuffer;
     RefPtr<Memory::VMObject> m_framebuffer_sink_vmobject;
+    OwnPtr<Memory::Region> m_cursor_buffer;
+    ResourceID m_cursor_resource { 0 };
     size_t m_buffer_size { 0 };
     bool m_are_writes_active { true };
     // FIXME: This needs to be cleaned up if the WindowServer exits while we are in a tty
@@ -86,12 +86,17 @@ bool GPU::handle_device_config_change()
 void GPU::handle_queue_update(u16 queue_index)
 {
     dbgln_if(VIRTIO_DEBUG, "GPU: Handle queue update");
-    VERIFY(queue_index == CONTROLQ);
+    VERIFY(queue_index == CONTROLQ || queue_index == CURSORQ);
 
-    auto& queue = get_queue(CONTROLQ);
-    SpinlockLocker queue_lock(queue.lock());
-    queue.discard_used_buffers();
-    m_outstanding_request.wake_all();
+    auto& queue = get_queue(queue_index);
+    {
+        SpinlockLocker queue_lock(queue.lock());
+        queue.discard_used_buffers();
+    }
+    if (queue_index == CONTROLQ)
+        m_outstanding_request.wake_all();
+    else
+        m_outstanding_cursor_request.wake_all();
 }
 
 u32 GPU::get_pending_events()
@@ -124,7 +129,7 @@ void GPU::query_display_information()
     VERIFY(m_default_scanout.has_value());
 }
 
-ResourceID GPU::create_2d_resource(Protocol::Rect rect)
+ResourceID GPU::create_2d_resource(Protocol::Rect rect, Protocol::TextureFormat format)
 {
     VERIFY(m_operation_lock.is_locked());
     auto writer = create_scratchspace_writer();
@@ -137,7 +142,7 @@ ResourceID GPU::create_2d_resource(Protocol::Rect rect)
     request.resource_id = resource_id.value();
     request.width = rect.width;
     request.height = rect.height;
-    request.format = static_cast<u32>(Protocol::TextureFormat::VIRTIO_GPU_FORMAT_B8G8R8X8_UNORM);
+    request.format = static_cast<u32>(format);
 
     synchronous_virtio_gpu_command(start_of_scratch_space(), sizeof(request), sizeof(response));
 
@@ -244,6 +249,45 @@ void GPU::flush_displayed_image(Protocol::Rect const& dirty_rect, ResourceID res
     VERIFY(response.type == static_cast<u32>(Protocol::CommandType::VIRTIO_GPU_RESP_OK_NODATA));
 }
 
+void GPU::update_cursor(ScanoutID scanout, ResourceID resource_id, u32 hot_x, u32 hot_y)
+{
+    VERIFY(m_operation_lock.is_locked());
+    auto writer = create_scratchspace_writer();
+    auto& request = writer.append_structure<Protocol::UpdateCursor>();
+
+    populate_virtio_gpu_request_header(request.header, Protocol::CommandType::VIRTIO_GPU_CMD_UPDATE_CURSOR);
+    request.position.scanout_id = scanout.value();
+    request.position.x = 0;
+    request.position.y = 0;
+    request.position.padding = 0;
+    request.resource_id = resource_id.value();
+    request.hot_x = hot_x;
+    request.hot_y = hot_y;
+    request.padding = 0;
+
+    synchronous_virtio_gpu_cursor_command(start_of_scratch_space(), sizeof(request));
+}
+
+void GPU::move_cursor(ScanoutID scanout, u32 x, u32 y)
+{
+    VERIFY(m_operation_lock.is_locked());
+    auto writer = create_scratchspace_writer();
+    auto& request = writer.append_structure<Protocol::UpdateCursor>();
+
+    populate_virtio_gpu_request_header(request.header, Protocol::CommandType::VIRTIO_GPU_CMD_MOVE_CURSOR);
+    request.position.scanout_id = scanout.value();
+    request.position.x = x;
+    request.position.y = y;
+    request.position.padding = 0;
+    // The other fields are ignored when only moving the cursor
+    request.resource_id = 0;
+    request.hot_x = 0;
+    request.hot_y = 0;
+    request.padding = 0;
+
+    synchronous_virtio_gpu_cursor_command(start_of_scratch_space(), sizeof(request));
+}
+
 void GPU::synchronous_virtio_gpu_command(PhysicalAddress buffer_start, size_t request_size, size_t response_size)
 {
     VERIFY(m_operation_lock.is_locked());
@@ -260,6 +304,23 @@ void GPU::synchronous_virtio_gpu_command(PhysicalAddress buffer_start, size_t re
     m_outstanding_request.wait_forever();
 }
 
+void GPU::synchronous_virtio_gpu_cursor_command(PhysicalAddress buffer_start, size_t request_size)
+{
+    // Cursor queue commands don't generate a response, the device simply
+    // consumes the request buffer and marks it used.
+    VERIFY(m_operation_lock.is_locked());
+    VERIFY(m_outstanding_cursor_request.is_empty());
+    auto& queue = get_queue(CURSORQ);
+    {
+        SpinlockLocker lock(queue.lock());
+        VirtIO::QueueChain chain { queue };
+        chain.add_buffer_to_chain(buffer_start, request_size, VirtIO::BufferType::DeviceReadable);
+        supply_chain_and_notify(CURSORQ, chain);
+        full_memory_barrier();
+    }
+    m_outstanding_cursor_request.wait_forever();
+}
+
 void GPU::populate_virtio_gpu_request_header(Protocol::ControlHeader& header, Protocol::CommandType ctrl_type, u32 flags)
 {
     header.type = static_cast<u32>(ctrl_type);
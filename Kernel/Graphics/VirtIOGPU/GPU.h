@@ -101,16 +101,19 @@ private:
         return { Bytes(m_scratch_space->vaddr().as_ptr(), m_scratch_space->size()) };
     }
     void synchronous_virtio_gpu_command(PhysicalAddress buffer_start, size_t request_size, size_t response_size);
+    void synchronous_virtio_gpu_cursor_command(PhysicalAddress buffer_start, size_t request_size);
     void populate_virtio_gpu_request_header(Protocol::ControlHeader& header, Protocol::CommandType ctrl_type, u32 flags = 0);
 
     void query_display_information();
-    ResourceID create_2d_resource(Protocol::Rect rect);
+    ResourceID create_2d_resource(Protocol::Rect rect, Protocol::TextureFormat format = Protocol::TextureFormat::VIRTIO_GPU_FORMAT_B8G8R8X8_UNORM);
     void delete_resource(ResourceID resource_id);
     void ensure_backing_storage(Memory::Region const& region, size_t buffer_offset, size_t buffer_length, ResourceID resource_id);
     void detach_backing_storage(ResourceID resource_id);
     void set_scanout_resource(ScanoutID scanout, ResourceID resource_id, Protocol::Rect rect);
     void transfer_framebuffer_data_to_host(ScanoutID scanout, Protocol::Rect const& rect, ResourceID resource_id);
     void flush_displayed_image(Protocol::Rect const& dirty_rect, ResourceID resource_id);
+    void update_cursor(ScanoutID scanout, ResourceID resource_id, u32 hot_x, u32 hot_y);
+    void move_cursor(ScanoutID scanout, u32 x, u32 y);
 
     Optional<ScanoutID> m_default_scanout;
     size_t m_num_scanouts { 0 };
@@ -121,6 +124,7 @@ private:
 
     // Synchronous commands
     WaitQueue m_outstanding_request;
+    WaitQueue m_outstanding_cursor_request;
     Mutex m_operation_lock;
     OwnPtr<Memory::Region> m_scratch_space;
 };
@@ -149,4 +149,22 @@ struct ResourceFlush {
     u32 padding;
 };
 
+// Specification equivalent: struct virtio_gpu_cursor_pos
+struct CursorPosition {
+    u32 scanout_id;
+    u32 x;
+    u32 y;
+    u32 padding;
+};
+
+// Specification equivalent: struct virtio_gpu_update_cursor
+struct UpdateCursor {
+    ControlHeader header;
+    CursorPosition position;
+    u32 resource_id;
+    u32 hot_x;
+    u32 hot_y;
+    u32 padding;
+};
+
 }
@@ -6,6 +6,7 @@
 
 #include <AK/Assertions.h>
 #include <AK/Memory.h>
+#include <Kernel/Arch/x86/Processor.h>
 #include <Kernel/Heap/SlabAllocator.h>
 #include <Kernel/Heap/kmalloc.h>
 #include <Kernel/Memory/Region.h>
@@ -39,29 +40,25 @@ public:
 
     void* alloc()
     {
-        FreeSlab* free_slab;
+        void* ptr = nullptr;
         {
             // We want to avoid being swapped out in the middle of this
             ScopedCritical critical;
-            FreeSlab* next_free;
-            free_slab = m_freelist.load(AK::memory_order_consume);
-            do {
-                if (!free_slab)
-                    return kmalloc(slab_size());
-                // It's possible another processor is doing the same thing at
-                // the same time, so next_free *can* be a bogus pointer. However,
-                // in that case compare_exchange_strong would fail and we would
-                // try again.
-                next_free = free_slab->next;
-            } while (!m_freelist.compare_exchange_strong(free_slab, next_free, AK::memory_order_acq_rel));
-
-            m_num_allocated++;
+            auto& cache = m_caches[Processor::current_id()];
+            if (cache.count == 0)
+                refill_cache(cache);
+            if (cache.count > 0) {
+                ptr = cache.rounds[--cache.count];
+                m_num_allocated++;
+            }
         }
+        if (!ptr)
+            return kmalloc(slab_size());
 
 #ifdef SANITIZE_SLABS
-        memset(free_slab, SLAB_ALLOC_SCRUB_BYTE, slab_size());
+        memset(ptr, SLAB_ALLOC_SCRUB_BYTE, slab_size());
 #endif
-        return free_slab;
+        return ptr;
     }
 
     void dealloc(void* ptr)
@@ -79,11 +76,10 @@ public:
 
         // We want to avoid being swapped out in the middle of this
         ScopedCritical critical;
-        FreeSlab* next_free = m_freelist.load(AK::memory_order_consume);
-        do {
-            free_slab->next = next_free;
-        } while (!m_freelist.compare_exchange_strong(next_free, free_slab, AK::memory_order_acq_rel));
-
+        auto& cache = m_caches[Processor::current_id()];
+        if (cache.count == ProcessorCache::capacity)
+            flush_cache(cache);
+        cache.rounds[cache.count++] = free_slab;
         m_num_allocated--;
     }
 
@@ -96,11 +92,67 @@ private:
         char padding[templated_slab_size - sizeof(FreeSlab*)];
     };
 
+    // Each processor keeps a small magazine of recently freed slabs so the
+    // common alloc/dealloc pairs never touch the shared freelist (whose head
+    // otherwise ping-pongs between cores even though it's lock-free). The
+    // shared freelist acts as the depot: magazines refill from it in batches
+    // and return their colder half in a single linked push when they overflow.
+    struct alignas(64) ProcessorCache {
+        static constexpr size_t capacity = 32;
+        size_t count { 0 };
+        void* rounds[capacity];
+    };
+
+    void refill_cache(ProcessorCache& cache)
+    {
+        while (cache.count < ProcessorCache::capacity / 2) {
+            FreeSlab* free_slab = m_freelist.load(AK::memory_order_consume);
+            FreeSlab* next_free;
+            do {
+                if (!free_slab)
+                    return;
+                // It's possible another processor is doing the same thing at
+                // the same time, so next_free *can* be a bogus pointer. However,
+                // in that case compare_exchange_strong would fail and we would
+                // try again.
+                next_free = free_slab->next;
+            } while (!m_freelist.compare_exchange_strong(free_slab, next_free, AK::memory_order_acq_rel));
+            cache.rounds[cache.count++] = free_slab;
+        }
+    }
+
+    void flush_cache(ProcessorCache& cache)
+    {
+        // Return the older (bottom) half of the magazine to the depot,
+        // keeping the most recently freed slabs local. The rounds are linked
+        // together first so the shared list head only has to be touched once.
+        constexpr size_t flush_count = ProcessorCache::capacity / 2;
+        FreeSlab* head = (FreeSlab*)cache.rounds[0];
+        FreeSlab* tail = head;
+        for (size_t i = 1; i < flush_count; ++i) {
+            auto* free_slab = (FreeSlab*)cache.rounds[i];
+            tail->next = free_slab;
+            tail = free_slab;
+        }
+        FreeSlab* next_free = m_freelist.load(AK::memory_order_consume);
+        do {
+            tail->next = next_free;
+        } while (!m_freelist.compare_exchange_strong(next_free, head, AK::memory_order_acq_rel));
+
+        for (size_t i = flush_count; i < ProcessorCache::capacity; ++i)
+            cache.rounds[i - flush_count] = cache.rounds[i];
+        cache.count -= flush_count;
+    }
+
+    // Bounded by the width of the thread affinity mask.
+    static constexpr size_t max_processor_count = sizeof(u32) * 8;
+
     Atomic<FreeSlab*> m_freelist { nullptr };
     Atomic<size_t, AK::MemoryOrder::memory_order_relaxed> m_num_allocated;
     size_t m_slab_count;
     void* m_base { nullptr };
     void* m_end { nullptr };
+    ProcessorCache m_caches[max_processor_count];
 
     static_assert(AssertSize<FreeSlab, templated_slab_size>());
 };
@@ -41,6 +41,7 @@ public:
     [[nodiscard]] u8 const* data() const { return m_region->vaddr().as_ptr(); }
     [[nodiscard]] size_t size() const { return m_size; }
     [[nodiscard]] size_t capacity() const { return m_region->size(); }
+    [[nodiscard]] Memory::Region const& region() const { return *m_region; }
 
     void set_size(size_t size)
     {
@@ -133,8 +133,13 @@ KResultOr<VirtualRange> AddressSpace::try_allocate_range(VirtualAddress vaddr, s
 {
     vaddr.mask(PAGE_MASK);
     size = page_round_up(size);
-    if (vaddr.is_null())
+    if (vaddr.is_null()) {
+        // Align large allocations to 2 MiB so their regions can be eligible
+        // for huge page mappings.
+        if (size >= 2 * MiB && alignment < 2 * MiB)
+            alignment = 2 * MiB;
         return page_directory().range_allocator().try_allocate_anywhere(size, alignment);
+    }
     return page_directory().range_allocator().try_allocate_specific(vaddr, size);
 }
 
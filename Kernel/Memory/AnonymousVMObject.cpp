@@ -118,8 +118,19 @@ AnonymousVMObject::AnonymousVMObject(size_t size, AllocationStrategy strategy, O
     , m_unused_committed_pages(move(committed_pages))
 {
     if (strategy == AllocationStrategy::AllocateNow) {
-        // Allocate all pages right now. We know we can get all because we committed the amount needed
-        for (size_t i = 0; i < page_count(); ++i)
+        // Allocate all pages right now. We know we can get all because we committed the amount needed.
+        // Grab physically contiguous 2 MiB chunks while the buddy allocator can still provide them;
+        // regions that map us can then install huge (PDE-level) mappings over those spans.
+        constexpr size_t pages_per_huge_page = (2 * MiB) / PAGE_SIZE;
+        size_t i = 0;
+        while (i + pages_per_huge_page <= page_count()) {
+            auto contiguous_pages = m_unused_committed_pages->try_take_contiguous(pages_per_huge_page);
+            if (contiguous_pages.is_empty())
+                break;
+            for (auto& page : contiguous_pages)
+                physical_pages()[i++] = page;
+        }
+        for (; i < page_count(); ++i)
             physical_pages()[i] = m_unused_committed_pages->take_one();
     } else {
         auto& initial_page = (strategy == AllocationStrategy::Reserve) ? MM.lazy_committed_page() : MM.shared_zero_page();
@@ -108,11 +108,14 @@ UNMAP_AFTER_INIT void MemoryManager::protect_readonly_after_init_memory()
     SpinlockLocker page_lock(kernel_page_directory().get_lock());
     SpinlockLocker mm_lock(s_mm_lock);
     // Disable writing to the .ro_after_init section
-    for (auto i = (FlatPtr)&start_of_ro_after_init; i < (FlatPtr)&end_of_ro_after_init; i += PAGE_SIZE) {
+    auto start = (FlatPtr)&start_of_ro_after_init;
+    auto end = (FlatPtr)&end_of_ro_after_init;
+    for (auto i = start; i < end; i += PAGE_SIZE) {
         auto& pte = *ensure_pte(kernel_page_directory(), VirtualAddress(i));
         pte.set_writable(false);
-        flush_tlb(&kernel_page_directory(), VirtualAddress(i));
     }
+    // Flush the whole range in one go rather than broadcasting an IPI per page.
+    flush_tlb(&kernel_page_directory(), VirtualAddress(start), (end - start) / PAGE_SIZE);
 }
 
 void MemoryManager::unmap_text_after_init()
@@ -127,8 +130,9 @@ void MemoryManager::unmap_text_after_init()
     for (auto i = start; i < end; i += PAGE_SIZE) {
         auto& pte = *ensure_pte(kernel_page_directory(), VirtualAddress(i));
         pte.clear();
-        flush_tlb(&kernel_page_directory(), VirtualAddress(i));
     }
+    // Flush the whole range in one go rather than broadcasting an IPI per page.
+    flush_tlb(&kernel_page_directory(), VirtualAddress(start), (end - start) / PAGE_SIZE);
 
     dmesgln("Unmapped {} KiB of kernel text after init! :^)", (end - start) / KiB);
 }
@@ -145,8 +149,9 @@ void MemoryManager::unmap_ksyms_after_init()
     for (auto i = start; i < end; i += PAGE_SIZE) {
         auto& pte = *ensure_pte(kernel_page_directory(), VirtualAddress(i));
         pte.clear();
-        flush_tlb(&kernel_page_directory(), VirtualAddress(i));
     }
+    // Flush the whole range in one go rather than broadcasting an IPI per page.
+    flush_tlb(&kernel_page_directory(), VirtualAddress(start), (end - start) / PAGE_SIZE);
 
     dmesgln("Unmapped {} KiB of kernel symbols after init! :^)", (end - start) / KiB);
 }
@@ -519,6 +524,12 @@ PageTableEntry* MemoryManager::pte(PageDirectory& page_directory, VirtualAddress
     PageDirectoryEntry const& pde = pd[page_directory_index];
     if (!pde.is_present())
         return nullptr;
+    if (pde.is_huge()) {
+        // This range is covered by a huge (2 MiB) mapping; there are no
+        // individual PTEs to hand out. Use ensure_pte() if you need one,
+        // it will split the mapping.
+        return nullptr;
+    }
 
     return &quickmap_pt(PhysicalAddress((FlatPtr)pde.page_table_base()))[page_table_index];
 }
@@ -534,6 +545,17 @@ PageTableEntry* MemoryManager::ensure_pte(PageDirectory& page_directory, Virtual
 
     auto* pd = quickmap_pd(page_directory, page_directory_table_index);
     PageDirectoryEntry& pde = pd[page_directory_index];
+    if (pde.is_present() && pde.is_huge()) {
+        // The caller wants to manipulate an individual 4 KiB page, but this
+        // range is covered by a huge (2 MiB) mapping, so demote it to a page
+        // table first. Note that the quickmapped pd slot stays at the same
+        // virtual address, so the pde reference remains valid afterwards.
+        if (!split_huge_pde(page_directory, vaddr))
+            return nullptr;
+        pd = quickmap_pd(page_directory, page_directory_table_index);
+        VERIFY(&pde == &pd[page_directory_index]); // Sanity check
+        VERIFY(!pde.is_huge());
+    }
     if (!pde.is_present()) {
         bool did_purge = false;
         auto page_table = allocate_user_physical_page(ShouldZeroFill::Yes, &did_purge);
@@ -577,6 +599,14 @@ void MemoryManager::release_pte(PageDirectory& page_directory, VirtualAddress va
     auto* pd = quickmap_pd(page_directory, page_directory_table_index);
     PageDirectoryEntry& pde = pd[page_directory_index];
     if (pde.is_present()) {
+        if (pde.is_huge()) {
+            // A huge (2 MiB) mapping is only ever installed for a span that's
+            // fully covered by a single region, and unmapping that region
+            // will call us for every page of the span. Just drop the whole
+            // mapping the first time we get here.
+            pde.clear();
+            return;
+        }
         auto* page_table = quickmap_pt(PhysicalAddress((FlatPtr)pde.page_table_base()));
         auto& pte = page_table[page_table_index];
         pte.clear();
@@ -601,6 +631,91 @@ void MemoryManager::release_pte(PageDirectory& page_directory, VirtualAddress va
     }
 }
 
+bool MemoryManager::map_huge_page(PageDirectory& page_directory, VirtualAddress vaddr, PhysicalAddress paddr, bool writable, bool executable, bool user_allowed, bool cache_disabled)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    VERIFY(s_mm_lock.is_locked_by_current_processor());
+    VERIFY(page_directory.get_lock().is_locked_by_current_processor());
+    VERIFY(vaddr.get() % (2 * MiB) == 0);
+    VERIFY(paddr.get() % (2 * MiB) == 0);
+    u32 page_directory_table_index = (vaddr.get() >> 30) & 0x1ff;
+    u32 page_directory_index = (vaddr.get() >> 21) & 0x1ff;
+
+    auto* pd = quickmap_pd(page_directory, page_directory_table_index);
+    auto& pde = pd[page_directory_index];
+    if (!pde.is_null()) {
+        // If this range is already mapped with the same huge mapping we can
+        // just refresh the flags. If there's a page table here (or a huge
+        // mapping of something else), stick to 4 KiB mappings.
+        if (!pde.is_huge() || PhysicalAddress((FlatPtr)pde.page_table_base()) != paddr)
+            return false;
+        pde.clear();
+    }
+    pde.set_page_table_base(paddr.get());
+    pde.set_huge(true);
+    pde.set_user_allowed(user_allowed);
+    pde.set_writable(writable);
+    pde.set_cache_disabled(cache_disabled);
+    if (Processor::current().has_feature(CPUFeature::NX))
+        pde.set_execute_disabled(!executable);
+    pde.set_present(true);
+    return true;
+}
+
+bool MemoryManager::split_huge_pde(PageDirectory& page_directory, VirtualAddress vaddr)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    VERIFY(s_mm_lock.is_locked_by_current_processor());
+    VERIFY(page_directory.get_lock().is_locked_by_current_processor());
+    u32 page_directory_table_index = (vaddr.get() >> 30) & 0x1ff;
+    u32 page_directory_index = (vaddr.get() >> 21) & 0x1ff;
+
+    auto page_table = allocate_user_physical_page(ShouldZeroFill::Yes);
+    if (!page_table) {
+        dbgln("MM: Unable to allocate page table to split huge mapping at {}", vaddr);
+        return false;
+    }
+
+    // The allocation above may have purged and re-quickmapped things, so only
+    // look at the PDE now that we have the page table in hand.
+    auto* pd = quickmap_pd(page_directory, page_directory_table_index);
+    auto& pde = pd[page_directory_index];
+    if (!pde.is_present() || !pde.is_huge())
+        return true; // Somebody already split (or unmapped) it for us.
+
+    auto base_paddr = PhysicalAddress((FlatPtr)pde.page_table_base());
+    bool writable = pde.is_writable();
+    bool user_allowed = pde.is_user_allowed();
+    bool global = pde.is_global();
+    bool execute_disabled = pde.is_execute_disabled();
+    bool cache_disabled = pde.is_cache_disabled();
+
+    auto* pt = quickmap_pt(page_table->paddr());
+    for (u32 i = 0; i < 512; ++i) {
+        auto& pte = pt[i];
+        pte.set_physical_page_base(base_paddr.offset((PhysicalPtr)i * PAGE_SIZE).get());
+        pte.set_writable(writable);
+        pte.set_user_allowed(user_allowed);
+        pte.set_global(global);
+        pte.set_cache_disabled(cache_disabled);
+        if (Processor::current().has_feature(CPUFeature::NX))
+            pte.set_execute_disabled(execute_disabled);
+        pte.set_present(true);
+    }
+
+    pde.set_page_table_base(page_table->paddr().get());
+    pde.set_huge(false);
+
+    auto result = page_directory.m_page_tables.set(vaddr.get() & ~(FlatPtr)0x1fffff, page_table.release_nonnull());
+    VERIFY(result == AK::HashSetResult::InsertedNewEntry);
+
+    // The new 4 KiB translations are identical to the huge one they replace,
+    // so no shootdown is needed here; whoever goes on to modify one of the
+    // new PTEs will flush as usual, and invlpg drops a stale huge TLB entry
+    // covering the page just like a 4 KiB one.
+    return true;
+}
+
 UNMAP_AFTER_INIT void MemoryManager::initialize(u32 cpu)
 {
     ProcessorSpecific<MemoryManagerData>::initialize();
@@ -832,8 +947,69 @@ NonnullRefPtr<PhysicalPage> MemoryManager::allocate_committed_user_physical_page
     return page.release_nonnull();
 }
 
+void MemoryManager::refill_free_page_cache(MemoryManagerData& mm_data)
+{
+    SpinlockLocker lock(s_mm_lock);
+    while (mm_data.m_free_page_cache_count < MemoryManagerData::free_page_cache_capacity / 2) {
+        // Don't hoard the last few pages in per-processor caches; let the
+        // slow path (and its purging fallback) arbitrate them instead.
+        if (m_system_memory_info.user_physical_pages_uncommitted <= MemoryManagerData::free_page_cache_capacity)
+            return;
+        auto page = find_free_user_physical_page(false);
+        if (!page)
+            return;
+        // Zero the page up front, while we already hold the lock and have the
+        // page at hand. This way handing it out later is a pure cache pop.
+        auto* ptr = quickmap_page(*page);
+        memset(ptr, 0, PAGE_SIZE);
+        unquickmap_page();
+        mm_data.m_free_page_cache[mm_data.m_free_page_cache_count++] = move(page);
+    }
+}
+
+NonnullRefPtrVector<PhysicalPage> MemoryManager::allocate_committed_contiguous_user_physical_pages(Badge<CommittedPhysicalPageSet>, size_t count)
+{
+    SpinlockLocker lock(s_mm_lock);
+    VERIFY(m_system_memory_info.user_physical_pages_committed >= count);
+
+    NonnullRefPtrVector<PhysicalPage> pages;
+    for (auto& region : m_user_physical_regions) {
+        pages = region.take_contiguous_free_pages(count);
+        if (!pages.is_empty())
+            break;
+    }
+    if (pages.is_empty())
+        return pages;
+
+    m_system_memory_info.user_physical_pages_committed -= count;
+    m_system_memory_info.user_physical_pages_used += count;
+
+    for (auto& page : pages) {
+        auto* ptr = quickmap_page(page);
+        memset(ptr, 0, PAGE_SIZE);
+        unquickmap_page();
+    }
+    return pages;
+}
+
 RefPtr<PhysicalPage> MemoryManager::allocate_user_physical_page(ShouldZeroFill should_zero_fill, bool* did_purge)
 {
+    {
+        // Fast path: hand out one of this processor's cached pages without
+        // touching s_mm_lock. Cached pages are pre-zeroed, which also covers
+        // (harmlessly) the callers that didn't ask for zero-filling.
+        ScopedCritical critical;
+        auto& mm_data = get_data();
+        if (mm_data.m_free_page_cache_count == 0)
+            refill_free_page_cache(mm_data);
+        if (mm_data.m_free_page_cache_count > 0) {
+            auto page = move(mm_data.m_free_page_cache[--mm_data.m_free_page_cache_count]);
+            if (did_purge)
+                *did_purge = false;
+            return page;
+        }
+    }
+
     SpinlockLocker lock(s_mm_lock);
     auto page = find_free_user_physical_page(false);
     bool purged_pages = false;
@@ -1106,6 +1282,15 @@ NonnullRefPtr<PhysicalPage> CommittedPhysicalPageSet::take_one()
     return MM.allocate_committed_user_physical_page({}, MemoryManager::ShouldZeroFill::Yes);
 }
 
+NonnullRefPtrVector<PhysicalPage> CommittedPhysicalPageSet::try_take_contiguous(size_t count)
+{
+    VERIFY(m_page_count >= count);
+    auto pages = MM.allocate_committed_contiguous_user_physical_pages({}, count);
+    if (!pages.is_empty())
+        m_page_count -= count;
+    return pages;
+}
+
 void CommittedPhysicalPageSet::uncommit_one()
 {
     VERIFY(m_page_count > 0);
@@ -98,6 +98,13 @@ struct MemoryManagerData {
 
     PhysicalAddress m_last_quickmap_pd;
     PhysicalAddress m_last_quickmap_pt;
+
+    // A small cache of free, already-zeroed physical pages. It's refilled in
+    // batches under s_mm_lock, so the common anonymous zero-fill fault path
+    // can usually allocate a page without taking any shared lock.
+    static constexpr size_t free_page_cache_capacity = 16;
+    RefPtr<PhysicalPage> m_free_page_cache[free_page_cache_capacity];
+    size_t m_free_page_cache_count { 0 };
 };
 
 extern RecursiveSpinlock s_mm_lock;
@@ -126,6 +133,7 @@ public:
     size_t page_count() const { return m_page_count; }
 
     [[nodiscard]] NonnullRefPtr<PhysicalPage> take_one();
+    [[nodiscard]] NonnullRefPtrVector<PhysicalPage> try_take_contiguous(size_t count);
     void uncommit_one();
 
     void operator=(CommittedPhysicalPageSet&&) = delete;
@@ -175,6 +183,7 @@ public:
     void uncommit_user_physical_pages(Badge<CommittedPhysicalPageSet>, size_t page_count);
 
     NonnullRefPtr<PhysicalPage> allocate_committed_user_physical_page(Badge<CommittedPhysicalPageSet>, ShouldZeroFill = ShouldZeroFill::Yes);
+    NonnullRefPtrVector<PhysicalPage> allocate_committed_contiguous_user_physical_pages(Badge<CommittedPhysicalPageSet>, size_t count);
     RefPtr<PhysicalPage> allocate_user_physical_page(ShouldZeroFill = ShouldZeroFill::Yes, bool* did_purge = nullptr);
     RefPtr<PhysicalPage> allocate_supervisor_physical_page();
     NonnullRefPtrVector<PhysicalPage> allocate_contiguous_supervisor_physical_pages(size_t size);
@@ -259,6 +268,7 @@ private:
     static Region* find_region_from_vaddr(VirtualAddress);
 
     RefPtr<PhysicalPage> find_free_user_physical_page(bool);
+    void refill_free_page_cache(MemoryManagerData&);
 
     ALWAYS_INLINE u8* quickmap_page(PhysicalPage& page)
     {
@@ -274,6 +284,9 @@ private:
     PageTableEntry* ensure_pte(PageDirectory&, VirtualAddress);
     void release_pte(PageDirectory&, VirtualAddress, bool);
 
+    bool map_huge_page(PageDirectory&, VirtualAddress, PhysicalAddress, bool writable, bool executable, bool user_allowed, bool cache_disabled);
+    bool split_huge_pde(PageDirectory&, VirtualAddress);
+
     RefPtr<PageDirectory> m_kernel_page_directory;
 
     RefPtr<PhysicalPage> m_shared_zero_page;
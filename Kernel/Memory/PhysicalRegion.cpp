@@ -56,6 +56,26 @@ void PhysicalRegion::initialize_zones()
             dmesgln(" * {}x PhysicalZone ({} MiB) @ {:016x}-{:016x}", zone_count, pages_per_zone / 256, first_address.get(), base_address.get() - pages_per_zone * PAGE_SIZE - 1);
     };
 
+    // Cover any stretch before the first 2 MiB boundary with small zones, so
+    // that the zones below start 2 MiB aligned and their high-order buddy
+    // blocks can back huge (2 MiB) page mappings.
+    if (auto head_misalignment = base_address.get() % (2 * MiB)) {
+        size_t head_pages = min(((2 * MiB) - head_misalignment) / PAGE_SIZE, remaining_pages);
+        while (head_pages >= 256) {
+            m_zones.append(make<PhysicalZone>(base_address, 256));
+            m_usable_zones.append(m_zones.last());
+            base_address = base_address.offset(256 * PAGE_SIZE);
+            remaining_pages -= 256;
+            head_pages -= 256;
+        }
+        if (head_pages > 0) {
+            m_zones.append(make<PhysicalZone>(base_address, head_pages));
+            m_usable_zones.append(m_zones.last());
+            base_address = base_address.offset(head_pages * PAGE_SIZE);
+            remaining_pages -= head_pages;
+        }
+    }
+
     // First make 16 MiB zones (with 4096 pages each)
     make_zones(4096);
 
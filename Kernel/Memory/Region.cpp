@@ -6,6 +6,7 @@
 
 #include <AK/Memory.h>
 #include <AK/StringView.h>
+#include <Kernel/Arch/x86/InterruptDisabler.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/Inode.h>
 #include <Kernel/Memory/AnonymousVMObject.h>
@@ -99,6 +100,24 @@ KResultOr<NonnullOwnPtr<Region>> Region::try_clone()
     return clone_region;
 }
 
+KResultOr<NonnullOwnPtr<Region>> Region::try_clone_sharing_memory()
+{
+    VERIFY(Process::has_current());
+
+    OwnPtr<KString> region_name;
+    if (m_name)
+        region_name = TRY(m_name->try_clone());
+
+    auto region = TRY(Region::try_create_user_accessible(
+        m_range, m_vmobject, m_offset_in_vmobject, move(region_name), access(), m_cacheable ? Cacheable::Yes : Cacheable::No, m_shared));
+    region->set_mmap(m_mmap);
+    region->set_shared(m_shared);
+    if (m_stack)
+        region->set_stack(true);
+    region->set_syscall_region(is_syscall_region());
+    return region;
+}
+
 void Region::set_vmobject(NonnullRefPtr<VMObject>&& obj)
 {
     if (m_vmobject.ptr() == obj.ptr())
@@ -202,6 +221,49 @@ bool Region::map_individual_page_impl(size_t page_index)
     return true;
 }
 
+bool Region::map_huge_span_impl(size_t page_index)
+{
+    VERIFY(m_page_directory->get_lock().is_locked_by_current_processor());
+    constexpr size_t pages_per_huge_page = (2 * MiB) / PAGE_SIZE;
+
+    auto page_vaddr = vaddr_from_page_index(page_index);
+    if (page_vaddr.get() % (2 * MiB) != 0)
+        return false;
+    if (page_index + pages_per_huge_page > page_count())
+        return false;
+    if (m_shared || !m_cacheable)
+        return false;
+    if (!is_readable() && !is_writable())
+        return false;
+
+    // The whole span must be backed by contiguous, 2 MiB aligned physical
+    // memory, and every page must want the exact same PTE flags; any page
+    // that may still fault (zero/lazy/COW) rules the span out.
+    auto* first_page = physical_page(page_index);
+    if (!first_page)
+        return false;
+    auto base_paddr = first_page->paddr();
+    if (base_paddr.get() % (2 * MiB) != 0)
+        return false;
+    for (size_t i = 0; i < pages_per_huge_page; ++i) {
+        auto* page = physical_page(page_index + i);
+        if (!page || page->paddr() != base_paddr.offset((PhysicalPtr)i * PAGE_SIZE))
+            return false;
+        if (page->is_shared_zero_page() || page->is_lazy_committed_page())
+            return false;
+        if (should_cow(page_index + i))
+            return false;
+    }
+
+    bool user_allowed = page_vaddr.get() >= 0x00800000 && is_user_address(page_vaddr);
+    if (is_mmap() && !user_allowed) {
+        PANIC("About to map mmap'ed page at a kernel address");
+    }
+
+    SpinlockLocker mm_locker(s_mm_lock);
+    return MM.map_huge_page(*m_page_directory, page_vaddr, base_paddr, is_writable(), is_executable(), user_allowed, !m_cacheable);
+}
+
 bool Region::do_remap_vmobject_page(size_t page_index, bool with_flush)
 {
     SpinlockLocker lock(vmobject().m_lock);
@@ -266,6 +328,13 @@ KResult Region::map(PageDirectory& page_directory, ShouldFlushTLB should_flush_t
     set_page_directory(page_directory);
     size_t page_index = 0;
     while (page_index < page_count()) {
+        // Use a huge (2 MiB) mapping for any fully-backed, physically
+        // contiguous span; this cuts TLB pressure enormously for large
+        // eagerly-allocated anonymous regions.
+        if (map_huge_span_impl(page_index)) {
+            page_index += (2 * MiB) / PAGE_SIZE;
+            continue;
+        }
         if (!map_individual_page_impl(page_index))
             break;
         ++page_index;
@@ -330,6 +399,35 @@ PageFaultResponse Region::handle_fault(PageFault const& fault)
     return PageFaultResponse::ShouldCrash;
 }
 
+KResult Region::populate_pages()
+{
+    // There's nothing to fault in if the region isn't even readable.
+    if (!is_readable())
+        return KSuccess;
+
+    for (size_t page_index = 0; page_index < page_count(); ++page_index) {
+        {
+            SpinlockLocker locker(vmobject().m_lock);
+            auto* page = physical_page(page_index);
+            if (page && !page->is_shared_zero_page() && !page->is_lazy_committed_page())
+                continue;
+        }
+        PageFaultResponse response;
+        {
+            // The fault handlers expect to be entered with interrupts
+            // disabled, just like when they're invoked by a hardware fault.
+            InterruptDisabler disabler;
+            PageFault fault { PageFaultFlags::NotPresent | PageFaultFlags::Read, vaddr().offset(page_index * PAGE_SIZE) };
+            response = handle_fault(fault);
+        }
+        if (response == PageFaultResponse::OutOfMemory)
+            return ENOMEM;
+        if (response != PageFaultResponse::Continue)
+            return EFAULT;
+    }
+    return KSuccess;
+}
+
 PageFaultResponse Region::handle_zero_fault(size_t page_index_in_region)
 {
     VERIFY_INTERRUPTS_DISABLED();
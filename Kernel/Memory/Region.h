@@ -90,8 +90,19 @@ public:
 
     PageFaultResponse handle_fault(PageFault const&);
 
+    // Eagerly faults in every page of the region that hasn't been paged in
+    // yet, e.g. for MAP_POPULATE and MADV_WILLNEED. This fronts the cost of
+    // physical allocation (and inode reads) so that later accesses don't
+    // have to take a page fault per page.
+    KResult populate_pages();
+
     KResultOr<NonnullOwnPtr<Region>> try_clone();
 
+    // Like try_clone(), but the clone maps the same VMObject without any
+    // CoW setup, so parent and child see each other's writes. Only safe for
+    // vfork(), where the parent stays blocked until the child execs or exits.
+    KResultOr<NonnullOwnPtr<Region>> try_clone_sharing_memory();
+
     [[nodiscard]] bool contains(VirtualAddress vaddr) const
     {
         return m_range.contains(vaddr);
@@ -201,6 +212,7 @@ private:
     [[nodiscard]] PageFaultResponse handle_zero_fault(size_t page_index);
 
     [[nodiscard]] bool map_individual_page_impl(size_t page_index);
+    [[nodiscard]] bool map_huge_span_impl(size_t page_index);
 
     RefPtr<PageDirectory> m_page_directory;
     VirtualRange m_range;
@@ -5,6 +5,7 @@
  */
 
 #include <Kernel/FileSystem/Inode.h>
+#include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Memory/SharedInodeVMObject.h>
 
 namespace Kernel::Memory {
@@ -34,4 +35,75 @@ SharedInodeVMObject::SharedInodeVMObject(SharedInodeVMObject const& other)
 {
 }
 
+KResultOr<size_t> SharedInodeVMObject::read_from_cached_pages(off_t offset, size_t count, UserOrKernelBuffer& buffer) const
+{
+    VERIFY(offset >= 0);
+    u8 page_buffer[PAGE_SIZE];
+    size_t nread = 0;
+    while (count > 0) {
+        size_t page_index = offset / PAGE_SIZE;
+        size_t offset_in_page = offset % PAGE_SIZE;
+        size_t num_bytes_to_copy = min(PAGE_SIZE - offset_in_page, count);
+
+        RefPtr<PhysicalPage> page;
+        {
+            SpinlockLocker locker(m_lock);
+            if (page_index >= physical_pages().size())
+                break;
+            page = physical_pages()[page_index];
+        }
+        // Stop at the first page that hasn't been paged in yet; the caller
+        // falls back to reading through the filesystem for the rest.
+        if (page.is_null())
+            break;
+
+        {
+            SpinlockLocker mm_locker(s_mm_lock);
+            u8* src_ptr = MM.quickmap_page(*page);
+            memcpy(page_buffer, src_ptr + offset_in_page, num_bytes_to_copy);
+            MM.unquickmap_page();
+        }
+        TRY(buffer.offset(nread).write(page_buffer, num_bytes_to_copy));
+
+        offset += num_bytes_to_copy;
+        count -= num_bytes_to_copy;
+        nread += num_bytes_to_copy;
+    }
+    return nread;
+}
+
+KResult SharedInodeVMObject::write_to_cached_pages(off_t offset, size_t count, UserOrKernelBuffer const& buffer)
+{
+    VERIFY(offset >= 0);
+    u8 page_buffer[PAGE_SIZE];
+    size_t nwritten = 0;
+    while (count > 0) {
+        size_t page_index = offset / PAGE_SIZE;
+        size_t offset_in_page = offset % PAGE_SIZE;
+        size_t num_bytes_to_copy = min(PAGE_SIZE - offset_in_page, count);
+
+        RefPtr<PhysicalPage> page;
+        {
+            SpinlockLocker locker(m_lock);
+            if (page_index >= physical_pages().size())
+                break;
+            page = physical_pages()[page_index];
+        }
+        // Pages that were never paged in will read fresh data from the inode
+        // on their next fault, so there's nothing to update for them.
+        if (!page.is_null()) {
+            TRY(buffer.offset(nwritten).read(page_buffer, num_bytes_to_copy));
+            SpinlockLocker mm_locker(s_mm_lock);
+            u8* dest_ptr = MM.quickmap_page(*page);
+            memcpy(dest_ptr + offset_in_page, page_buffer, num_bytes_to_copy);
+            MM.unquickmap_page();
+        }
+
+        offset += num_bytes_to_copy;
+        count -= num_bytes_to_copy;
+        nwritten += num_bytes_to_copy;
+    }
+    return KSuccess;
+}
+
 }
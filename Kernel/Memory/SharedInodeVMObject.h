@@ -19,6 +19,9 @@ public:
     static KResultOr<NonnullRefPtr<SharedInodeVMObject>> try_create_with_inode(Inode&);
     virtual KResultOr<NonnullRefPtr<VMObject>> try_clone() override;
 
+    KResultOr<size_t> read_from_cached_pages(off_t offset, size_t count, UserOrKernelBuffer&) const;
+    KResult write_to_cached_pages(off_t offset, size_t count, UserOrKernelBuffer const&);
+
 private:
     virtual bool is_shared_inode() const override { return true; }
 
@@ -7,6 +7,7 @@
 #include <AK/MACAddress.h>
 #include <Kernel/Bus/PCI/API.h>
 #include <Kernel/Bus/PCI/IDs.h>
+#include <Kernel/CommandLine.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Net/E1000NetworkAdapter.h>
 #include <Kernel/Sections.h>
@@ -38,6 +39,7 @@ namespace Kernel {
 #define REG_RADV 0x282C             // RX Int. Absolute Delay Timer
 #define REG_RSRPD 0x2C00            // RX Small Packet Detect Interrupt
 #define REG_TIPG 0x0410             // Transmit Inter Packet Gap
+#define REG_RXCSUM 0x5000           // RX Checksum Control
 #define ECTRL_SLU 0x40              //set link up
 #define RCTL_EN (1 << 1)            // Receiver Enable
 #define RCTL_SBP (1 << 2)           // Store Bad Packets
@@ -70,6 +72,17 @@ namespace Kernel {
 #define RCTL_BSIZE_8192 ((2 << 16) | (1 << 25))
 #define RCTL_BSIZE_16384 ((1 << 16) | (1 << 25))
 
+// RX Checksum Control
+
+#define RXCSUM_IPOFL (1 << 8) // IP Checksum Offload Enable
+#define RXCSUM_TUOFL (1 << 9) // TCP/UDP Checksum Offload Enable
+
+// RX Descriptor status/error bits
+
+#define RXD_STATUS_IXSM (1 << 2) // Ignore Checksum Indication
+#define RXD_ERROR_TCPE (1 << 5)  // TCP/UDP Checksum Error
+#define RXD_ERROR_IPE (1 << 6)   // IPv4 Checksum Error
+
 // Transmit Command
 
 #define CMD_EOP (1 << 0)  // End of Packet
@@ -221,11 +234,18 @@ UNMAP_AFTER_INIT bool E1000NetworkAdapter::initialize()
     return true;
 }
 
+UNMAP_AFTER_INIT static size_t sanitized_ring_size(size_t requested)
+{
+    return clamp(requested & ~(size_t)7, E1000NetworkAdapter::minimum_ring_size, E1000NetworkAdapter::maximum_ring_size);
+}
+
 UNMAP_AFTER_INIT E1000NetworkAdapter::E1000NetworkAdapter(PCI::Address address, u8 irq)
     : PCI::Device(address)
     , IRQHandler(irq)
-    , m_rx_descriptors_region(MM.allocate_contiguous_kernel_region(Memory::page_round_up(sizeof(e1000_rx_desc) * number_of_rx_descriptors + 16), "E1000 RX Descriptors", Memory::Region::Access::ReadWrite).release_value())
-    , m_tx_descriptors_region(MM.allocate_contiguous_kernel_region(Memory::page_round_up(sizeof(e1000_tx_desc) * number_of_tx_descriptors + 16), "E1000 TX Descriptors", Memory::Region::Access::ReadWrite).release_value())
+    , m_rx_ring_size(sanitized_ring_size(kernel_command_line().e1000_rx_ring_size()))
+    , m_tx_ring_size(sanitized_ring_size(kernel_command_line().e1000_tx_ring_size()))
+    , m_rx_descriptors_region(MM.allocate_contiguous_kernel_region(Memory::page_round_up(sizeof(e1000_rx_desc) * m_rx_ring_size + 16), "E1000 RX Descriptors", Memory::Region::Access::ReadWrite).release_value())
+    , m_tx_descriptors_region(MM.allocate_contiguous_kernel_region(Memory::page_round_up(sizeof(e1000_tx_desc) * m_tx_ring_size + 16), "E1000 TX Descriptors", Memory::Region::Access::ReadWrite).release_value())
 {
     set_interface_name(pci_address());
 }
@@ -255,6 +275,15 @@ bool E1000NetworkAdapter::handle_irq(const RegisterState&)
     }
     if (status & INTERRUPT_RXT0) {
         receive();
+        // Hybrid interrupt/polling receive: if the packet queue has backed
+        // up, NetworkTask isn't keeping up with the interrupt rate. Mask the
+        // receive interrupt and let did_dequeue_packet_buffer() poll the ring
+        // while the queue drains; frames meanwhile accumulate in the RX ring
+        // instead of storming us with interrupts.
+        if (!m_rx_polling && packet_queue_size() >= max_packet_buffers / 2) {
+            m_rx_polling = true;
+            out32(REG_INTERRUPT_MASK_CLEAR, INTERRUPT_RXT0 | INTERRUPT_RXO | INTERRUPT_RXDMT0);
+        }
     }
 
     m_wait_queue.wake_all();
@@ -319,45 +348,54 @@ bool E1000NetworkAdapter::link_up()
 
 UNMAP_AFTER_INIT void E1000NetworkAdapter::initialize_rx_descriptors()
 {
-    auto* rx_descriptors = (e1000_tx_desc*)m_rx_descriptors_region->vaddr().as_ptr();
-    constexpr auto rx_buffer_size = 8192;
-    constexpr auto rx_buffer_page_count = rx_buffer_size / PAGE_SIZE;
-
-    m_rx_buffer_region = MM.allocate_contiguous_kernel_region(rx_buffer_size * number_of_rx_descriptors, "E1000 RX buffers", Memory::Region::Access::ReadWrite).release_value();
-    for (size_t i = 0; i < number_of_rx_descriptors; ++i) {
+    auto* rx_descriptors = (e1000_rx_desc*)m_rx_descriptors_region->vaddr().as_ptr();
+
+    m_rx_buffer_region = MM.allocate_contiguous_kernel_region(Memory::page_round_up(rx_buffer_size * m_rx_ring_size), "E1000 RX buffers", Memory::Region::Access::ReadWrite).release_value();
+    // The buffer region is physically contiguous, so sub-page-sized buffers
+    // can be addressed with a simple offset from the first page.
+    auto rx_buffers_physical_base = m_rx_buffer_region->physical_page(0)->paddr().get();
+    m_rx_buffers.ensure_capacity(m_rx_ring_size);
+    for (size_t i = 0; i < m_rx_ring_size; ++i) {
         auto& descriptor = rx_descriptors[i];
-        m_rx_buffers[i] = m_rx_buffer_region->vaddr().as_ptr() + rx_buffer_size * i;
-        descriptor.addr = m_rx_buffer_region->physical_page(rx_buffer_page_count * i)->paddr().get();
+        m_rx_buffers.append(m_rx_buffer_region->vaddr().as_ptr() + rx_buffer_size * i);
+        descriptor.addr = rx_buffers_physical_base + rx_buffer_size * i;
         descriptor.status = 0;
     }
 
     out32(REG_RXDESCLO, m_rx_descriptors_region->physical_page(0)->paddr().get());
     out32(REG_RXDESCHI, 0);
-    out32(REG_RXDESCLEN, number_of_rx_descriptors * sizeof(e1000_rx_desc));
+    out32(REG_RXDESCLEN, m_rx_ring_size * sizeof(e1000_rx_desc));
     out32(REG_RXDESCHEAD, 0);
-    out32(REG_RXDESCTAIL, number_of_rx_descriptors - 1);
+    out32(REG_RXDESCTAIL, m_rx_ring_size - 1);
 
-    out32(REG_RCTRL, RCTL_EN | RCTL_SBP | RCTL_UPE | RCTL_MPE | RCTL_LBM_NONE | RTCL_RDMTS_HALF | RCTL_BAM | RCTL_SECRC | RCTL_BSIZE_8192);
+    out32(REG_RCTRL, RCTL_EN | RCTL_SBP | RCTL_UPE | RCTL_MPE | RCTL_LBM_NONE | RTCL_RDMTS_HALF | RCTL_BAM | RCTL_SECRC | RCTL_BSIZE_2048);
+
+    // Have the hardware verify IP and TCP/UDP checksums as frames arrive;
+    // receive() drops anything it flags, so the software stack never has
+    // to checksum inbound packets.
+    out32(REG_RXCSUM, RXCSUM_IPOFL | RXCSUM_TUOFL);
 }
 
 UNMAP_AFTER_INIT void E1000NetworkAdapter::initialize_tx_descriptors()
 {
     auto* tx_descriptors = (e1000_tx_desc*)m_tx_descriptors_region->vaddr().as_ptr();
 
-    constexpr auto tx_buffer_size = 8192;
     constexpr auto tx_buffer_page_count = tx_buffer_size / PAGE_SIZE;
-    m_tx_buffer_region = MM.allocate_contiguous_kernel_region(tx_buffer_size * number_of_tx_descriptors, "E1000 TX buffers", Memory::Region::Access::ReadWrite).release_value();
+    m_tx_buffer_region = MM.allocate_contiguous_kernel_region(tx_buffer_size * m_tx_ring_size, "E1000 TX buffers", Memory::Region::Access::ReadWrite).release_value();
 
-    for (size_t i = 0; i < number_of_tx_descriptors; ++i) {
+    m_tx_buffers.ensure_capacity(m_tx_ring_size);
+    m_tx_buffers_physical.ensure_capacity(m_tx_ring_size);
+    for (size_t i = 0; i < m_tx_ring_size; ++i) {
         auto& descriptor = tx_descriptors[i];
-        m_tx_buffers[i] = m_tx_buffer_region->vaddr().as_ptr() + tx_buffer_size * i;
-        descriptor.addr = m_tx_buffer_region->physical_page(tx_buffer_page_count * i)->paddr().get();
+        m_tx_buffers.append(m_tx_buffer_region->vaddr().as_ptr() + tx_buffer_size * i);
+        m_tx_buffers_physical.append(m_tx_buffer_region->physical_page(tx_buffer_page_count * i)->paddr().get());
+        descriptor.addr = m_tx_buffers_physical[i];
         descriptor.cmd = 0;
     }
 
     out32(REG_TXDESCLO, m_tx_descriptors_region->physical_page(0)->paddr().get());
     out32(REG_TXDESCHI, 0);
-    out32(REG_TXDESCLEN, number_of_tx_descriptors * sizeof(e1000_tx_desc));
+    out32(REG_TXDESCLEN, m_tx_ring_size * sizeof(e1000_tx_desc));
     out32(REG_TXDESCHEAD, 0);
     out32(REG_TXDESCTAIL, 0);
 
@@ -425,18 +463,19 @@ u32 E1000NetworkAdapter::in32(u16 address)
 void E1000NetworkAdapter::send_raw(ReadonlyBytes payload)
 {
     disable_irq();
-    size_t tx_current = in32(REG_TXDESCTAIL) % number_of_tx_descriptors;
+    size_t tx_current = in32(REG_TXDESCTAIL) % m_tx_ring_size;
     dbgln_if(E1000_DEBUG, "E1000: Sending packet ({} bytes)", payload.size());
     auto* tx_descriptors = (e1000_tx_desc*)m_tx_descriptors_region->vaddr().as_ptr();
     auto& descriptor = tx_descriptors[tx_current];
-    VERIFY(payload.size() <= 8192);
+    VERIFY(payload.size() <= tx_buffer_size);
     auto* vptr = (void*)m_tx_buffers[tx_current];
     memcpy(vptr, payload.data(), payload.size());
+    descriptor.addr = m_tx_buffers_physical[tx_current];
     descriptor.length = payload.size();
     descriptor.status = 0;
     descriptor.cmd = CMD_EOP | CMD_IFCS | CMD_RS;
     dbgln_if(E1000_DEBUG, "E1000: Using tx descriptor {} (head is at {})", tx_current, in32(REG_TXDESCHEAD));
-    tx_current = (tx_current + 1) % number_of_tx_descriptors;
+    tx_current = (tx_current + 1) % m_tx_ring_size;
     cli();
     enable_irq();
     out32(REG_TXDESCTAIL, tx_current);
@@ -450,25 +489,84 @@ void E1000NetworkAdapter::send_raw(ReadonlyBytes payload)
     dbgln_if(E1000_DEBUG, "E1000: Sent packet, status is now {:#02x}!", (u8)descriptor.status);
 }
 
+void E1000NetworkAdapter::send_raw_scattered(Span<ScatterGatherFragment const> fragments, ReadonlyBytes frame)
+{
+    disable_irq();
+    VERIFY(frame.size() <= tx_buffer_size);
+    VERIFY(!fragments.is_empty() && fragments.size() < m_tx_ring_size);
+    dbgln_if(E1000_DEBUG, "E1000: Sending packet ({} bytes in {} fragments)", frame.size(), fragments.size());
+    auto* tx_descriptors = (e1000_tx_desc*)m_tx_descriptors_region->vaddr().as_ptr();
+    size_t tx_current = in32(REG_TXDESCTAIL) % m_tx_ring_size;
+    e1000_tx_desc* last_descriptor = nullptr;
+    for (size_t i = 0; i < fragments.size(); ++i) {
+        auto& descriptor = tx_descriptors[tx_current];
+        descriptor.addr = fragments[i].paddr.get();
+        descriptor.length = fragments[i].length;
+        descriptor.status = 0;
+        // The hardware only samples IFCS (and friends) from the final
+        // descriptor of a multi-descriptor packet.
+        descriptor.cmd = (i == fragments.size() - 1) ? (CMD_EOP | CMD_IFCS | CMD_RS) : 0;
+        last_descriptor = &descriptor;
+        tx_current = (tx_current + 1) % m_tx_ring_size;
+    }
+    cli();
+    enable_irq();
+    out32(REG_TXDESCTAIL, tx_current);
+    // This is synchronous just like send_raw(), which also means the caller's
+    // buffer stays put until the hardware is done reading from it.
+    for (;;) {
+        if (last_descriptor->status) {
+            sti();
+            break;
+        }
+        m_wait_queue.wait_forever("E1000NetworkAdapter");
+    }
+    dbgln_if(E1000_DEBUG, "E1000: Sent packet, status is now {:#02x}!", (u8)last_descriptor->status);
+}
+
 void E1000NetworkAdapter::receive()
 {
-    auto* rx_descriptors = (e1000_tx_desc*)m_rx_descriptors_region->vaddr().as_ptr();
+    auto* rx_descriptors = (e1000_rx_desc*)m_rx_descriptors_region->vaddr().as_ptr();
     u32 rx_current;
     for (;;) {
-        rx_current = in32(REG_RXDESCTAIL) % number_of_rx_descriptors;
-        rx_current = (rx_current + 1) % number_of_rx_descriptors;
-        if (!(rx_descriptors[rx_current].status & 1))
+        rx_current = in32(REG_RXDESCTAIL) % m_rx_ring_size;
+        rx_current = (rx_current + 1) % m_rx_ring_size;
+        auto& descriptor = rx_descriptors[rx_current];
+        if (!(descriptor.status & 1))
             break;
         auto* buffer = m_rx_buffers[rx_current];
-        u16 length = rx_descriptors[rx_current].length;
-        VERIFY(length <= 8192);
-        dbgln_if(E1000_DEBUG, "E1000: Received 1 packet @ {:p} ({} bytes)", buffer, length);
-        did_receive({ buffer, length });
-        rx_descriptors[rx_current].status = 0;
+        u16 length = descriptor.length;
+        VERIFY(length <= rx_buffer_size);
+        // The hardware already verified this frame's IP and TCP/UDP
+        // checksums (unless it marked the result as not meaningful), so a
+        // frame it flagged is not worth queueing.
+        if ((descriptor.errors & (RXD_ERROR_IPE | RXD_ERROR_TCPE)) && !(descriptor.status & RXD_STATUS_IXSM)) {
+            dbgln_if(E1000_DEBUG, "E1000: Dropping received packet with bad checksum");
+        } else {
+            dbgln_if(E1000_DEBUG, "E1000: Received 1 packet @ {:p} ({} bytes)", buffer, length);
+            did_receive({ buffer, length });
+        }
+        descriptor.status = 0;
+        descriptor.errors = 0;
         out32(REG_RXDESCTAIL, rx_current);
     }
 }
 
+void E1000NetworkAdapter::did_dequeue_packet_buffer()
+{
+    if (!m_rx_polling)
+        return;
+    // Pick up whatever arrived while the receive interrupt was masked, and
+    // go back to interrupt-driven operation once the queue has drained far
+    // enough that NetworkTask is keeping up again.
+    receive();
+    if (packet_queue_size() <= max_packet_buffers / 4) {
+        m_rx_polling = false;
+        out32(REG_INTERRUPT_MASK_SET, INTERRUPT_LSC | INTERRUPT_RXT0 | INTERRUPT_RXO);
+        in32(REG_INTERRUPT_CAUSE_READ);
+    }
+}
+
 i32 E1000NetworkAdapter::link_speed()
 {
     if (!link_up())
@@ -27,12 +27,20 @@ public:
     virtual ~E1000NetworkAdapter() override;
 
     virtual void send_raw(ReadonlyBytes) override;
+    virtual void send_raw_scattered(Span<ScatterGatherFragment const>, ReadonlyBytes frame) override;
     virtual bool link_up() override;
     virtual i32 link_speed() override;
     virtual bool link_full_duplex() override;
+    virtual bool offloads_rx_checksums() const override { return true; }
 
     virtual StringView purpose() const override { return class_name(); }
 
+    // Ring sizes are configurable on the kernel command line
+    // (e1000_rx_ring_size / e1000_tx_ring_size); the hardware wants a
+    // multiple of eight descriptors.
+    static constexpr size_t minimum_ring_size = 8;
+    static constexpr size_t maximum_ring_size = 256;
+
 protected:
     void setup_interrupts();
     void setup_link();
@@ -79,21 +87,31 @@ protected:
 
     void receive();
 
-    static constexpr size_t number_of_rx_descriptors = 32;
-    static constexpr size_t number_of_tx_descriptors = 8;
+    virtual void did_dequeue_packet_buffer() override;
+
+    static constexpr size_t rx_buffer_size = 2048;
+    static constexpr size_t tx_buffer_size = 8192;
 
     IOAddress m_io_base;
     VirtualAddress m_mmio_base;
+    size_t m_rx_ring_size { 0 };
+    size_t m_tx_ring_size { 0 };
     OwnPtr<Memory::Region> m_rx_descriptors_region;
     OwnPtr<Memory::Region> m_tx_descriptors_region;
     OwnPtr<Memory::Region> m_rx_buffer_region;
     OwnPtr<Memory::Region> m_tx_buffer_region;
-    Array<void*, number_of_rx_descriptors> m_rx_buffers;
-    Array<void*, number_of_tx_descriptors> m_tx_buffers;
+    Vector<void*> m_rx_buffers;
+    Vector<void*> m_tx_buffers;
+    // Scattered sends point descriptors at foreign physical pages, so each
+    // regular send has to point its descriptor back at its own bounce buffer.
+    Vector<u64> m_tx_buffers_physical;
     OwnPtr<Memory::Region> m_mmio_region;
     u8 m_interrupt_line { 0 };
     bool m_has_eeprom { false };
     bool m_use_mmio { false };
+    // True while the receive interrupt is masked because the packet queue
+    // backed up; we then poll the RX ring as the queue drains instead.
+    bool m_rx_polling { false };
     EntropySource m_entropy_source;
 
     WaitQueue m_wait_queue;
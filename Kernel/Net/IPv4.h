@@ -25,6 +25,8 @@ enum class IPv4PacketFlags : u16 {
     MoreFragments = 0x2000,
 };
 
+u64 internet_checksum_step(u64 sum, const void*, size_t);
+NetworkOrdered<u16> internet_checksum_finish(u64 sum);
 NetworkOrdered<u16> internet_checksum(const void*, size_t);
 
 class [[gnu::packed]] IPv4Packet {
@@ -104,19 +106,51 @@ private:
 
 static_assert(AssertSize<IPv4Packet, 20>());
 
-inline NetworkOrdered<u16> internet_checksum(const void* ptr, size_t count)
+// The internet checksum (RFC 1071) is a 16-bit ones-complement sum. Such a
+// sum is endianness-agnostic up to a final byte swap, so instead of folding
+// after every big-endian 16-bit word we accumulate the data in native byte
+// order, 32 bits at a time, into a 64-bit accumulator (which soaks up the
+// carries for free) and only fold and swap once at the end.
+//
+// Multi-range checksums (like TCP's pseudo-header) thread the accumulator
+// through internet_checksum_step() calls and finish once; every range but
+// the last must have an even length, or the words of the following ranges
+// would be summed misaligned.
+inline u64 internet_checksum_step(u64 sum, const void* ptr, size_t count)
 {
-    u32 checksum = 0;
-    auto* w = (const u16*)ptr;
-    while (count > 1) {
-        checksum += AK::convert_between_host_and_network_endian(*w++);
-        if (checksum & 0x80000000)
-            checksum = (checksum & 0xffff) | (checksum >> 16);
-        count -= 2;
+    auto* data = (const u8*)ptr;
+    while (count >= 16) {
+        auto* w = (const u32*)data;
+        sum += (u64)w[0] + w[1] + w[2] + w[3];
+        data += 16;
+        count -= 16;
+    }
+    while (count >= 4) {
+        sum += *(const u32*)data;
+        data += 4;
+        count -= 4;
+    }
+    if (count & 2) {
+        sum += *(const u16*)data;
+        data += 2;
     }
-    while (checksum >> 16)
-        checksum = (checksum & 0xffff) + (checksum >> 16);
-    return ~checksum & 0xffff;
+    if (count & 1)
+        sum += *data;
+    return sum;
+}
+
+inline NetworkOrdered<u16> internet_checksum_finish(u64 sum)
+{
+    while (sum >> 16)
+        sum = (sum & 0xffff) + (sum >> 16);
+    // The accumulator holds a native-order sum; the byte swap (a no-op on
+    // big-endian machines) turns it back into the on-the-wire sum.
+    return ~AK::convert_between_host_and_network_endian((u16)sum) & 0xffff;
+}
+
+inline NetworkOrdered<u16> internet_checksum(const void* ptr, size_t count)
+{
+    return internet_checksum_finish(internet_checksum_step(0, ptr, count));
 }
 
 }
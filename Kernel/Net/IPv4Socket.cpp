@@ -187,6 +187,31 @@ PortAllocationResult IPv4Socket::allocate_local_port_if_needed()
     return { m_local_port, true };
 }
 
+RoutingDecision IPv4Socket::cached_route_to(IPv4Address const& target, IPv4Address const& source)
+{
+    // The routing decision for a connected socket rarely changes, so reuse
+    // the last one until the routing generation ticks (ARP or adapter
+    // configuration changed) or the socket starts talking to someone else.
+    auto generation = routing_table_generation();
+    if (generation == m_cached_route_generation
+        && target == m_cached_route_target
+        && source == m_cached_route_source
+        && bound_interface() == m_cached_route_bound_interface
+        && !m_cached_routing_decision.is_zero()) {
+        return m_cached_routing_decision;
+    }
+
+    auto decision = route_to(target, source, bound_interface());
+    if (!decision.is_zero()) {
+        m_cached_routing_decision = decision;
+        m_cached_route_target = target;
+        m_cached_route_source = source;
+        m_cached_route_bound_interface = bound_interface();
+        m_cached_route_generation = generation;
+    }
+    return decision;
+}
+
 KResultOr<size_t> IPv4Socket::sendto(OpenFileDescription&, const UserOrKernelBuffer& data, size_t data_length, [[maybe_unused]] int flags, Userspace<const sockaddr*> addr, socklen_t addr_length)
 {
     MutexLocker locker(mutex());
@@ -210,7 +235,7 @@ KResultOr<size_t> IPv4Socket::sendto(OpenFileDescription&, const UserOrKernelBuf
     if (!is_connected() && m_peer_address.is_zero())
         return set_so_error(EPIPE);
 
-    auto routing_decision = route_to(m_peer_address, m_local_address, bound_interface());
+    auto routing_decision = cached_route_to(m_peer_address, m_local_address);
     if (routing_decision.is_zero())
         return set_so_error(EHOSTUNREACH);
 
@@ -234,7 +259,7 @@ KResultOr<size_t> IPv4Socket::sendto(OpenFileDescription&, const UserOrKernelBuf
             routing_decision.adapter->release_packet_buffer(*packet);
             return set_so_error(result);
         }
-        routing_decision.adapter->send_packet(packet->bytes());
+        routing_decision.adapter->send_packet_buffer(*packet);
         routing_decision.adapter->release_packet_buffer(*packet);
         return data_length;
     }
@@ -13,6 +13,7 @@
 #include <Kernel/Locking/MutexProtected.h>
 #include <Kernel/Net/IPv4.h>
 #include <Kernel/Net/IPv4SocketTuple.h>
+#include <Kernel/Net/Routing.h>
 #include <Kernel/Net/Socket.h>
 
 namespace Kernel {
@@ -90,6 +91,8 @@ protected:
     void set_local_address(IPv4Address address) { m_local_address = address; }
     void set_peer_address(IPv4Address address) { m_peer_address = address; }
 
+    RoutingDecision cached_route_to(IPv4Address const& target, IPv4Address const& source);
+
     static KResultOr<NonnullOwnPtr<DoubleBuffer>> try_create_receive_buffer();
 
 private:
@@ -103,6 +106,14 @@ private:
     IPv4Address m_local_address;
     IPv4Address m_peer_address;
 
+    // The last result of route_to() for this socket, reused until the global
+    // routing generation ticks or the socket talks to someone else.
+    RoutingDecision m_cached_routing_decision;
+    IPv4Address m_cached_route_target;
+    IPv4Address m_cached_route_source;
+    RefPtr<NetworkAdapter> m_cached_route_bound_interface;
+    u32 m_cached_route_generation { 0 };
+
     Vector<IPv4Address> m_multicast_memberships;
     bool m_multicast_loop { true };
 
@@ -10,6 +10,7 @@
 #include <Kernel/Net/EtherType.h>
 #include <Kernel/Net/NetworkAdapter.h>
 #include <Kernel/Net/NetworkingManagement.h>
+#include <Kernel/Net/Routing.h>
 #include <Kernel/Process.h>
 #include <Kernel/StdLib.h>
 
@@ -30,6 +31,41 @@ void NetworkAdapter::send_packet(ReadonlyBytes packet)
     send_raw(packet);
 }
 
+void NetworkAdapter::send_packet_buffer(PacketWithTimestamp& packet)
+{
+    auto frame = packet.bytes();
+    m_packets_out++;
+    m_bytes_out += frame.size();
+
+    // Local traffic never touches a device: hand the finished packet
+    // straight to our own receive queue, without fragmenting or copying.
+    if (is_loopback()) {
+        did_receive_packet_buffer(packet);
+        return;
+    }
+
+    // Chop the frame up at the physical page boundaries of its backing
+    // buffer so adapters with scatter-gather descriptor rings can DMA it
+    // in place. The buffer starts page-aligned and a frame is at most an
+    // MTU, so this is no more than a handful of fragments.
+    auto& region = packet.buffer->region();
+    Vector<ScatterGatherFragment, 4> fragments;
+    size_t remaining = frame.size();
+    for (size_t page_index = 0; remaining > 0; ++page_index) {
+        size_t fragment_length = min(remaining, (size_t)PAGE_SIZE);
+        fragments.append({ region.physical_page(page_index)->paddr(), fragment_length });
+        remaining -= fragment_length;
+    }
+    send_raw_scattered(fragments.span(), frame);
+}
+
+void NetworkAdapter::send_raw_scattered(Span<ScatterGatherFragment const>, ReadonlyBytes frame)
+{
+    // Adapters without scatter-gather support just transmit the (already
+    // contiguous in virtual memory) frame through their bounce buffer path.
+    send_raw(frame);
+}
+
 void NetworkAdapter::send(const MACAddress& destination, const ARPPacket& packet)
 {
     size_t size_in_bytes = sizeof(EthernetFrameHeader) + sizeof(ARPPacket);
@@ -96,6 +132,30 @@ void NetworkAdapter::did_receive(ReadonlyBytes payload)
         on_receive();
 }
 
+void NetworkAdapter::did_receive_packet_buffer(PacketWithTimestamp& packet)
+{
+    InterruptDisabler disabler;
+    m_packets_in++;
+    m_bytes_in += packet.buffer->size();
+
+    // A retransmitted segment can still be sitting in the queue from its
+    // first transmission; delivering it once is enough.
+    if (packet.packet_node.is_in_list())
+        return;
+
+    if (m_packet_queue_size == max_packet_buffers) {
+        // FIXME: Keep track of the number of dropped packets
+        return;
+    }
+
+    packet.timestamp = kgettimeofday();
+    m_packet_queue.append(packet);
+    m_packet_queue_size++;
+
+    if (on_receive)
+        on_receive();
+}
+
 size_t NetworkAdapter::dequeue_packet(u8* buffer, size_t buffer_size, Time& packet_timestamp)
 {
     InterruptDisabler disabler;
@@ -103,6 +163,7 @@ size_t NetworkAdapter::dequeue_packet(u8* buffer, size_t buffer_size, Time& pack
         return 0;
     auto packet_with_timestamp = m_packet_queue.take_first();
     m_packet_queue_size--;
+    did_dequeue_packet_buffer();
     packet_timestamp = packet_with_timestamp->timestamp;
     auto& packet_buffer = packet_with_timestamp->buffer;
     size_t packet_size = packet_buffer->size();
@@ -112,6 +173,17 @@ size_t NetworkAdapter::dequeue_packet(u8* buffer, size_t buffer_size, Time& pack
     return packet_size;
 }
 
+RefPtr<PacketWithTimestamp> NetworkAdapter::dequeue_packet_buffer()
+{
+    InterruptDisabler disabler;
+    if (m_packet_queue.is_empty())
+        return {};
+    auto packet = m_packet_queue.take_first();
+    m_packet_queue_size--;
+    did_dequeue_packet_buffer();
+    return packet;
+}
+
 RefPtr<PacketWithTimestamp> NetworkAdapter::acquire_packet_buffer(size_t size)
 {
     InterruptDisabler disabler;
@@ -147,22 +219,29 @@ RefPtr<PacketWithTimestamp> NetworkAdapter::acquire_packet_buffer(size_t size)
 void NetworkAdapter::release_packet_buffer(PacketWithTimestamp& packet)
 {
     InterruptDisabler disabler;
+    // Loopback shares one buffer between the sending socket and the receive
+    // queue, so only the last reference may hand it back for reuse.
+    if (packet.ref_count() > 1)
+        return;
     m_unused_packets.append(packet);
 }
 
 void NetworkAdapter::set_ipv4_address(const IPv4Address& address)
 {
     m_ipv4_address = address;
+    bump_routing_table_generation();
 }
 
 void NetworkAdapter::set_ipv4_netmask(const IPv4Address& netmask)
 {
     m_ipv4_netmask = netmask;
+    bump_routing_table_generation();
 }
 
 void NetworkAdapter::set_ipv4_gateway(const IPv4Address& gateway)
 {
     m_ipv4_gateway = gateway;
+    bump_routing_table_generation();
 }
 
 void NetworkAdapter::set_interface_name(const PCI::Address& pci_address)
@@ -38,9 +38,21 @@ struct PacketWithTimestamp : public RefCounted<PacketWithTimestamp> {
 
     NonnullOwnPtr<KBuffer> buffer;
     Time timestamp;
+    // While a packet is in flight between the NetworkTask dispatcher and a
+    // protocol worker, this holds (and keeps alive) the adapter it came
+    // from. It's cleared before the buffer goes back to the adapter's pool.
+    RefPtr<NetworkAdapter> adapter;
     IntrusiveListNode<PacketWithTimestamp, RefPtr<PacketWithTimestamp>> packet_node;
 };
 
+// One physically contiguous piece of an outgoing frame. Adapters with
+// scatter-gather descriptor rings can DMA each fragment in place instead
+// of copying the frame into a bounce buffer first.
+struct ScatterGatherFragment {
+    PhysicalAddress paddr;
+    size_t length { 0 };
+};
+
 class NetworkAdapter : public RefCounted<NetworkAdapter>
     , public Weakable<NetworkAdapter> {
 public:
@@ -63,6 +75,13 @@ public:
         return LINKSPEED_INVALID;
     }
     virtual bool link_full_duplex() { return false; }
+    virtual bool is_loopback() const { return false; }
+
+    // Whether the hardware verifies IP/TCP checksums on receive (and the
+    // driver drops frames that fail), and whether it can insert them on
+    // transmit. Protocol code consults these to skip software checksumming.
+    virtual bool offloads_rx_checksums() const { return false; }
+    virtual bool offloads_tx_checksums() const { return false; }
 
     void set_ipv4_address(const IPv4Address&);
     void set_ipv4_netmask(const IPv4Address&);
@@ -72,6 +91,7 @@ public:
     void fill_in_ipv4_header(PacketWithTimestamp&, IPv4Address const&, MACAddress const&, IPv4Address const&, IPv4Protocol, size_t, u8);
 
     size_t dequeue_packet(u8* buffer, size_t buffer_size, Time& packet_timestamp);
+    RefPtr<PacketWithTimestamp> dequeue_packet_buffer();
 
     bool has_queued_packets() const { return !m_packet_queue.is_empty(); }
 
@@ -92,13 +112,26 @@ public:
     Function<void()> on_receive;
 
     void send_packet(ReadonlyBytes);
+    void send_packet_buffer(PacketWithTimestamp&);
 
 protected:
     NetworkAdapter();
     void set_interface_name(const PCI::Address&);
     void set_mac_address(const MACAddress& mac_address) { m_mac_address = mac_address; }
     void did_receive(ReadonlyBytes);
+    void did_receive_packet_buffer(PacketWithTimestamp&);
     virtual void send_raw(ReadonlyBytes) = 0;
+    virtual void send_raw_scattered(Span<ScatterGatherFragment const>, ReadonlyBytes frame);
+
+    // Called (with interrupts disabled) every time a packet buffer is taken
+    // off the receive queue. Adapters that mask their receive interrupt
+    // under load use this to poll their rings and to decide when to go back
+    // to interrupt-driven operation.
+    virtual void did_dequeue_packet_buffer() { }
+    size_t packet_queue_size() const { return m_packet_queue_size; }
+
+    // FIXME: Make this configurable
+    static constexpr size_t max_packet_buffers = 1024;
 
     void set_loopback_name();
 
@@ -108,9 +141,6 @@ private:
     IPv4Address m_ipv4_netmask;
     IPv4Address m_ipv4_gateway;
 
-    // FIXME: Make this configurable
-    static constexpr size_t max_packet_buffers = 1024;
-
     using PacketList = IntrusiveList<PacketWithTimestamp, RefPtr<PacketWithTimestamp>, &PacketWithTimestamp::packet_node>;
 
     PacketList m_packet_queue;
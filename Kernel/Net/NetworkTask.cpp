@@ -34,14 +34,43 @@ static void send_delayed_tcp_ack(RefPtr<TCPSocket> socket);
 static void send_tcp_rst(IPv4Packet const& ipv4_packet, TCPPacket const& tcp_packet, RefPtr<NetworkAdapter> adapter);
 static void flush_delayed_tcp_acks();
 static void retransmit_tcp_packets();
+static void process_packet(ReadonlyBytes frame, Time const& packet_timestamp);
+static u32 flow_hash_for_frame(ReadonlyBytes frame);
 
 static Thread* network_task = nullptr;
-static HashTable<RefPtr<TCPSocket>>* delayed_ack_sockets;
+static MutexProtected<HashTable<RefPtr<TCPSocket>>>* delayed_ack_sockets;
+
+// The NetworkTask dispatcher hashes each received packet's flow tuple onto
+// one of these workers. Packets of the same connection always end up on the
+// same worker, so per-socket ordering holds while different connections can
+// be processed on different cores.
+struct NetworkWorkerState {
+    Thread* thread { nullptr };
+    Spinlock lock;
+    IntrusiveList<PacketWithTimestamp, RefPtr<PacketWithTimestamp>, &PacketWithTimestamp::packet_node> queue;
+    WaitQueue wait_queue;
+};
+static NetworkWorkerState* s_workers;
+static size_t s_worker_count;
 
 [[noreturn]] static void NetworkTask_main(void*);
+[[noreturn]] static void NetworkWorker_main(void*);
 
 void NetworkTask::spawn()
 {
+    delayed_ack_sockets = new MutexProtected<HashTable<RefPtr<TCPSocket>>>;
+
+    s_worker_count = Processor::count();
+    s_workers = new NetworkWorkerState[s_worker_count];
+    for (size_t i = 0; i < s_worker_count; ++i) {
+        RefPtr<Thread> worker_thread;
+        auto worker_name = KString::try_create(String::formatted("NetworkWorker{}", i));
+        if (worker_name.is_error())
+            TODO();
+        Process::create_kernel_process(worker_thread, worker_name.release_value(), NetworkWorker_main, reinterpret_cast<void*>(i));
+        s_workers[i].thread = worker_thread;
+    }
+
     RefPtr<Thread> thread;
     auto name = KString::try_create("NetworkTask");
     if (name.is_error())
@@ -52,13 +81,18 @@ void NetworkTask::spawn()
 
 bool NetworkTask::is_current()
 {
-    return Thread::current() == network_task;
+    auto* current_thread = Thread::current();
+    if (current_thread == network_task)
+        return true;
+    for (size_t i = 0; i < s_worker_count; ++i) {
+        if (s_workers[i].thread == current_thread)
+            return true;
+    }
+    return false;
 }
 
 void NetworkTask_main(void*)
 {
-    delayed_ack_sockets = new HashTable<RefPtr<TCPSocket>>;
-
     WaitQueue packet_wait_queue;
     int pending_packets = 0;
     NetworkingManagement::the().for_each([&](auto& adapter) {
@@ -76,61 +110,112 @@ void NetworkTask_main(void*)
         };
     });
 
-    auto dequeue_packet = [&pending_packets](u8* buffer, size_t buffer_size, Time& packet_timestamp) -> size_t {
+    // Hand each queued packet buffer to the worker its flow hashes to.
+    // The buffer itself travels along, so there's no copy on this path;
+    // the worker releases it back to the adapter's pool when it's done.
+    auto dispatch_one_packet = [&pending_packets]() -> bool {
         if (pending_packets == 0)
-            return 0;
-        size_t packet_size = 0;
+            return false;
+        RefPtr<PacketWithTimestamp> packet;
         NetworkingManagement::the().for_each([&](auto& adapter) {
-            if (packet_size || !adapter.has_queued_packets())
+            if (packet || !adapter.has_queued_packets())
                 return;
-            packet_size = adapter.dequeue_packet(buffer, buffer_size, packet_timestamp);
-            pending_packets--;
-            dbgln_if(NETWORK_TASK_DEBUG, "NetworkTask: Dequeued packet from {} ({} bytes)", adapter.name(), packet_size);
+            packet = adapter.dequeue_packet_buffer();
+            if (packet) {
+                packet->adapter = &adapter;
+                pending_packets--;
+                dbgln_if(NETWORK_TASK_DEBUG, "NetworkTask: Dequeued packet from {} ({} bytes)", adapter.name(), packet->buffer->size());
+            }
         });
-        return packet_size;
+        if (!packet)
+            return false;
+        auto& worker = s_workers[flow_hash_for_frame(packet->bytes()) % s_worker_count];
+        {
+            SpinlockLocker locker(worker.lock);
+            worker.queue.append(*packet);
+        }
+        worker.wait_queue.wake_all();
+        return true;
     };
 
-    size_t buffer_size = 64 * KiB;
-    auto region_or_error = MM.allocate_kernel_region(buffer_size, "Kernel Packet Buffer", Memory::Region::Access::ReadWrite);
-    if (region_or_error.is_error())
-        TODO();
-    auto buffer_region = region_or_error.release_value();
-    auto buffer = (u8*)buffer_region->vaddr().get();
-    Time packet_timestamp;
-
     for (;;) {
         flush_delayed_tcp_acks();
         retransmit_tcp_packets();
-        size_t packet_size = dequeue_packet(buffer, buffer_size, packet_timestamp);
-        if (!packet_size) {
+        if (!dispatch_one_packet()) {
             auto timeout_time = Time::from_milliseconds(500);
             auto timeout = Thread::BlockTimeout { false, &timeout_time };
             [[maybe_unused]] auto result = packet_wait_queue.wait_on(timeout, "NetworkTask");
-            continue;
         }
-        if (packet_size < sizeof(EthernetFrameHeader)) {
-            dbgln("NetworkTask: Packet is too small to be an Ethernet packet! ({})", packet_size);
-            continue;
+    }
+}
+
+void NetworkWorker_main(void* data)
+{
+    auto& state = s_workers[reinterpret_cast<FlatPtr>(data)];
+    for (;;) {
+        RefPtr<PacketWithTimestamp> packet;
+        {
+            SpinlockLocker locker(state.lock);
+            if (!state.queue.is_empty())
+                packet = state.queue.take_first();
         }
-        auto& eth = *(EthernetFrameHeader const*)buffer;
-        dbgln_if(ETHERNET_DEBUG, "NetworkTask: From {} to {}, ether_type={:#04x}, packet_size={}", eth.source().to_string(), eth.destination().to_string(), eth.ether_type(), packet_size);
-
-        switch (eth.ether_type()) {
-        case EtherType::ARP:
-            handle_arp(eth, packet_size);
-            break;
-        case EtherType::IPv4:
-            handle_ipv4(eth, packet_size, packet_timestamp);
-            break;
-        case EtherType::IPv6:
-            // ignore
-            break;
-        default:
-            dbgln_if(ETHERNET_DEBUG, "NetworkTask: Unknown ethernet type {:#04x}", eth.ether_type());
+        if (!packet) {
+            [[maybe_unused]] auto result = state.wait_queue.wait_on({}, "NetworkWorker");
+            continue;
         }
+        process_packet(packet->bytes(), packet->timestamp);
+        auto adapter = move(packet->adapter);
+        adapter->release_packet_buffer(*packet);
     }
 }
 
+void process_packet(ReadonlyBytes frame, Time const& packet_timestamp)
+{
+    if (frame.size() < sizeof(EthernetFrameHeader)) {
+        dbgln("NetworkTask: Packet is too small to be an Ethernet packet! ({})", frame.size());
+        return;
+    }
+    auto& eth = *(EthernetFrameHeader const*)frame.data();
+    dbgln_if(ETHERNET_DEBUG, "NetworkTask: From {} to {}, ether_type={:#04x}, packet_size={}", eth.source().to_string(), eth.destination().to_string(), eth.ether_type(), frame.size());
+
+    switch (eth.ether_type()) {
+    case EtherType::ARP:
+        handle_arp(eth, frame.size());
+        break;
+    case EtherType::IPv4:
+        handle_ipv4(eth, frame.size(), packet_timestamp);
+        break;
+    case EtherType::IPv6:
+        // ignore
+        break;
+    default:
+        dbgln_if(ETHERNET_DEBUG, "NetworkTask: Unknown ethernet type {:#04x}", eth.ether_type());
+    }
+}
+
+u32 flow_hash_for_frame(ReadonlyBytes frame)
+{
+    // Everything that isn't a well-formed IPv4 frame (ARP and friends) goes
+    // to worker 0; there's so little of it that spreading it out isn't worth
+    // giving up the simplicity.
+    if (frame.size() < sizeof(EthernetFrameHeader) + sizeof(IPv4Packet))
+        return 0;
+    auto& eth = *(EthernetFrameHeader const*)frame.data();
+    if (eth.ether_type() != EtherType::IPv4)
+        return 0;
+    auto& ipv4_packet = *static_cast<IPv4Packet const*>(eth.payload());
+    u32 hash = ipv4_packet.source().to_u32() ^ ipv4_packet.destination().to_u32();
+    auto protocol = (IPv4Protocol)ipv4_packet.protocol();
+    if ((protocol == IPv4Protocol::TCP || protocol == IPv4Protocol::UDP) && ipv4_packet.payload_size() >= 2 * sizeof(u16)) {
+        // Both the TCP and UDP headers start with the source and destination
+        // ports, so we can mix them in without parsing further.
+        u16 ports[2];
+        memcpy(ports, ipv4_packet.payload(), sizeof(ports));
+        hash ^= (u32)ports[0] << 16 | ports[1];
+    }
+    return hash;
+}
+
 void handle_arp(EthernetFrameHeader const& eth, size_t frame_size)
 {
     constexpr size_t minimum_arp_frame_size = sizeof(EthernetFrameHeader) + sizeof(ARPPacket);
@@ -269,7 +354,7 @@ void handle_icmp(EthernetFrameHeader const& eth, IPv4Packet const& ipv4_packet,
             memcpy(response.payload(), request.payload(), icmp_payload_size);
         response.header.set_checksum(internet_checksum(&response, icmp_packet_size));
         // FIXME: What is the right TTL value here? Is 64 ok? Should we use the same TTL as the echo request?
-        adapter->send_packet(packet->bytes());
+        adapter->send_packet_buffer(*packet);
         adapter->release_packet_buffer(*packet);
     }
 }
@@ -287,7 +372,7 @@ void handle_udp(IPv4Packet const& ipv4_packet, Time const& packet_timestamp)
         ipv4_packet.destination(), udp_packet.destination_port(),
         udp_packet.length());
 
-    auto socket = UDPSocket::from_port(udp_packet.destination_port());
+    auto socket = UDPSocket::from_port(udp_packet.destination_port(), ipv4_packet.source(), udp_packet.source_port());
     if (!socket) {
         dbgln_if(UDP_DEBUG, "handle_udp: No local UDP socket for {}:{}", ipv4_packet.destination(), udp_packet.destination_port());
         return;
@@ -310,28 +395,39 @@ void send_delayed_tcp_ack(RefPtr<TCPSocket> socket)
         return;
     }
 
-    delayed_ack_sockets->set(move(socket));
+    // NOTE: Always take the socket mutex before the delayed-ack table,
+    // matching the order here (the socket mutex is held by our caller).
+    delayed_ack_sockets->with_exclusive([&](auto& sockets) {
+        sockets.set(move(socket));
+    });
 }
 
 void flush_delayed_tcp_acks()
 {
-    Vector<RefPtr<TCPSocket>, 32> remaining_sockets;
-    for (auto& socket : *delayed_ack_sockets) {
+    // Snapshot and clear the table first so we never hold its lock while
+    // taking a socket mutex; that would invert the order used on the
+    // receive path in send_delayed_tcp_ack().
+    Vector<RefPtr<TCPSocket>, 32> pending_sockets;
+    delayed_ack_sockets->with_exclusive([&](auto& sockets) {
+        for (auto& socket : sockets)
+            pending_sockets.append(socket);
+        sockets.clear();
+    });
+
+    size_t remaining_sockets = 0;
+    for (auto& socket : pending_sockets) {
         MutexLocker locker(socket->mutex());
         if (socket->should_delay_next_ack()) {
-            remaining_sockets.append(socket);
+            ++remaining_sockets;
+            delayed_ack_sockets->with_exclusive([&](auto& sockets) {
+                sockets.set(socket);
+            });
             continue;
         }
         [[maybe_unused]] auto result = socket->send_ack();
     }
-
-    if (remaining_sockets.size() != delayed_ack_sockets->size()) {
-        delayed_ack_sockets->clear();
-        if (remaining_sockets.size() > 0)
-            dbgln("flush_delayed_tcp_acks: {} sockets remaining", remaining_sockets.size());
-        for (auto&& socket : remaining_sockets)
-            delayed_ack_sockets->set(move(socket));
-    }
+    if (remaining_sockets > 0)
+        dbgln("flush_delayed_tcp_acks: {} sockets remaining", remaining_sockets);
 }
 
 void send_tcp_rst(IPv4Packet const& ipv4_packet, TCPPacket const& tcp_packet, RefPtr<NetworkAdapter> adapter)
@@ -364,7 +460,7 @@ void send_tcp_rst(IPv4Packet const& ipv4_packet, TCPPacket const& tcp_packet, Re
     rst_packet.set_flags(TCPFlags::RST | TCPFlags::ACK);
     rst_packet.set_checksum(TCPSocket::compute_tcp_checksum(ipv4_packet.source(), ipv4_packet.destination(), rst_packet, 0));
 
-    routing_decision.adapter->send_packet(packet->bytes());
+    routing_decision.adapter->send_packet_buffer(*packet);
     routing_decision.adapter->release_packet_buffer(*packet);
 }
 
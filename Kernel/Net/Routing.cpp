@@ -17,6 +17,17 @@
 namespace Kernel {
 
 static Singleton<MutexProtected<HashMap<IPv4Address, MACAddress>>> s_arp_table;
+static Atomic<u32> s_routing_table_generation;
+
+u32 routing_table_generation()
+{
+    return s_routing_table_generation.load(AK::MemoryOrder::memory_order_acquire);
+}
+
+void bump_routing_table_generation()
+{
+    s_routing_table_generation.fetch_add(1, AK::MemoryOrder::memory_order_acq_rel);
+}
 
 class ARPTableBlocker final : public Thread::Blocker {
 public:
@@ -119,6 +130,7 @@ void update_arp_table(IPv4Address const& ip_addr, MACAddress const& addr, Update
             table.remove(ip_addr);
     });
     s_arp_table_blocker_set->unblock_blockers_waiting_for_ipv4_address(ip_addr, addr);
+    bump_routing_table_generation();
 
     if constexpr (ARP_DEBUG) {
         arp_table().with_shared([&](auto const& table) {
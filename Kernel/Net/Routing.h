@@ -27,6 +27,12 @@ enum class UpdateArp {
 void update_arp_table(IPv4Address const&, MACAddress const&, UpdateArp update);
 RoutingDecision route_to(IPv4Address const& target, IPv4Address const& source, RefPtr<NetworkAdapter> const through = nullptr);
 
+// Bumped whenever anything that can affect the result of route_to() changes
+// (ARP table updates, adapter address/netmask/gateway reconfiguration), so
+// cached RoutingDecisions can be invalidated cheaply.
+u32 routing_table_generation();
+void bump_routing_table_generation();
+
 MutexProtected<HashMap<IPv4Address, MACAddress>>& arp_table();
 
 }
@@ -107,6 +107,15 @@ KResult Socket::setsockopt(int level, int option, Userspace<const void*> user_va
     case SO_KEEPALIVE:
         // FIXME: Obviously, this is not a real keepalive.
         return KSuccess;
+    case SO_REUSEPORT:
+        if (user_value_size != sizeof(int))
+            return EINVAL;
+        {
+            int reuse;
+            TRY(copy_from_user(&reuse, static_ptr_cast<const int*>(user_value)));
+            m_reuse_port = reuse != 0;
+        }
+        return KSuccess;
     case SO_TIMESTAMP:
         if (user_value_size != sizeof(int))
             return EINVAL;
@@ -187,6 +196,14 @@ KResult Socket::getsockopt(OpenFileDescription&, int level, int option, Userspac
         TRY(copy_to_user(static_ptr_cast<int*>(value), &m_timestamp));
         size = sizeof(int);
         return copy_to_user(value_size, &size);
+    case SO_REUSEPORT: {
+        if (size < sizeof(int))
+            return EINVAL;
+        int reuse = m_reuse_port;
+        TRY(copy_to_user(static_ptr_cast<int*>(value), &reuse));
+        size = sizeof(int);
+        return copy_to_user(value_size, &size);
+    }
     default:
         dbgln("setsockopt({}) at SOL_SOCKET not implemented.", option);
         return ENOPROTOOPT;
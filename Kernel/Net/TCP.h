@@ -22,6 +22,17 @@ struct TCPFlags {
     };
 };
 
+struct TCPOptionKind {
+    enum : u8 {
+        End = 0x00,
+        Nop = 0x01,
+        MSS = 0x02,
+        WindowScale = 0x03,
+        SACKPermitted = 0x04,
+        SACK = 0x05,
+    };
+};
+
 class [[gnu::packed]] TCPOptionMSS {
 public:
     TCPOptionMSS(u16 value)
@@ -32,13 +43,41 @@ public:
     u16 value() const { return m_value; }
 
 private:
-    u8 m_option_kind { 0x02 };
+    u8 m_option_kind { TCPOptionKind::MSS };
     u8 m_option_length { sizeof(TCPOptionMSS) };
     NetworkOrdered<u16> m_value;
 };
 
 static_assert(AssertSize<TCPOptionMSS, 4>());
 
+class [[gnu::packed]] TCPOptionWindowScale {
+public:
+    TCPOptionWindowScale(u8 shift)
+        : m_shift(shift)
+    {
+    }
+
+    u8 shift() const { return m_shift; }
+
+private:
+    u8 m_option_kind { TCPOptionKind::WindowScale };
+    u8 m_option_length { sizeof(TCPOptionWindowScale) };
+    u8 m_shift { 0 };
+};
+
+static_assert(AssertSize<TCPOptionWindowScale, 3>());
+
+class [[gnu::packed]] TCPOptionSACKPermitted {
+public:
+    TCPOptionSACKPermitted() = default;
+
+private:
+    u8 m_option_kind { TCPOptionKind::SACKPermitted };
+    u8 m_option_length { sizeof(TCPOptionSACKPermitted) };
+};
+
+static_assert(AssertSize<TCPOptionSACKPermitted, 2>());
+
 class [[gnu::packed]] TCPPacket {
 public:
     TCPPacket() = default;
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/Singleton.h>
 #include <AK/Time.h>
 #include <Kernel/Debug.h>
@@ -22,11 +23,16 @@
 
 namespace Kernel {
 
+static Singleton<Array<MutexProtected<HashMap<IPv4SocketTuple, Vector<TCPSocket*>>>, TCPSocket::num_socket_table_shards>> s_socket_tuples;
+
 void TCPSocket::for_each(Function<void(const TCPSocket&)> callback)
 {
-    sockets_by_tuple().for_each_shared([&](const auto& it) {
-        callback(*it.value);
-    });
+    for (auto& shard : *s_socket_tuples) {
+        shard.for_each_shared([&](const auto& it) {
+            for (auto* socket : it.value)
+                callback(*socket);
+        });
+    }
 }
 
 void TCPSocket::set_state(State new_state)
@@ -63,29 +69,37 @@ MutexProtected<HashMap<IPv4SocketTuple, RefPtr<TCPSocket>>>& TCPSocket::closing_
     return *s_socket_closing;
 }
 
-static Singleton<MutexProtected<HashMap<IPv4SocketTuple, TCPSocket*>>> s_socket_tuples;
-
-MutexProtected<HashMap<IPv4SocketTuple, TCPSocket*>>& TCPSocket::sockets_by_tuple()
+MutexProtected<HashMap<IPv4SocketTuple, Vector<TCPSocket*>>>& TCPSocket::sockets_by_tuple(u16 local_port)
 {
-    return *s_socket_tuples;
+    return (*s_socket_tuples)[local_port % num_socket_table_shards];
 }
 
 RefPtr<TCPSocket> TCPSocket::from_tuple(const IPv4SocketTuple& tuple)
 {
-    return sockets_by_tuple().with_shared([&](const auto& table) -> RefPtr<TCPSocket> {
-        auto exact_match = table.get(tuple);
-        if (exact_match.has_value())
-            return { *exact_match.value() };
+    return sockets_by_tuple(tuple.local_port()).with_shared([&](const auto& table) -> RefPtr<TCPSocket> {
+        // With SO_REUSEPORT a listen tuple maps to several sockets; hashing
+        // the initiating peer spreads connections across them while keeping
+        // any one peer's retransmitted SYNs on the same socket.
+        auto pick = [&](Vector<TCPSocket*> const& sockets) -> RefPtr<TCPSocket> {
+            size_t index = 0;
+            if (sockets.size() > 1)
+                index = pair_int_hash(tuple.peer_address().to_u32(), tuple.peer_port()) % sockets.size();
+            return { *sockets[index] };
+        };
+
+        auto exact_match = table.find(tuple);
+        if (exact_match != table.end() && !exact_match->value.is_empty())
+            return pick(exact_match->value);
 
         auto address_tuple = IPv4SocketTuple(tuple.local_address(), tuple.local_port(), IPv4Address(), 0);
-        auto address_match = table.get(address_tuple);
-        if (address_match.has_value())
-            return { *address_match.value() };
+        auto address_match = table.find(address_tuple);
+        if (address_match != table.end() && !address_match->value.is_empty())
+            return pick(address_match->value);
 
         auto wildcard_tuple = IPv4SocketTuple(IPv4Address(), tuple.local_port(), IPv4Address(), 0);
-        auto wildcard_match = table.get(wildcard_tuple);
-        if (wildcard_match.has_value())
-            return { *wildcard_match.value() };
+        auto wildcard_match = table.find(wildcard_tuple);
+        if (wildcard_match != table.end() && !wildcard_match->value.is_empty())
+            return pick(wildcard_match->value);
 
         return {};
     });
@@ -93,8 +107,8 @@ RefPtr<TCPSocket> TCPSocket::from_tuple(const IPv4SocketTuple& tuple)
 KResultOr<NonnullRefPtr<TCPSocket>> TCPSocket::try_create_client(const IPv4Address& new_local_address, u16 new_local_port, const IPv4Address& new_peer_address, u16 new_peer_port)
 {
     auto tuple = IPv4SocketTuple(new_local_address, new_local_port, new_peer_address, new_peer_port);
-    return sockets_by_tuple().with_exclusive([&](auto& table) -> KResultOr<NonnullRefPtr<TCPSocket>> {
-        if (table.contains(tuple))
+    return sockets_by_tuple(new_local_port).with_exclusive([&](auto& table) -> KResultOr<NonnullRefPtr<TCPSocket>> {
+        if (auto it = table.find(tuple); it != table.end() && !it->value.is_empty())
             return EEXIST;
 
         auto receive_buffer = TRY(try_create_receive_buffer());
@@ -108,8 +122,15 @@ KResultOr<NonnullRefPtr<TCPSocket>> TCPSocket::try_create_client(const IPv4Addre
         client->set_direction(Direction::Incoming);
         client->set_originator(*this);
 
+        // The peer's SYN options were parsed on this listening socket, so
+        // carry the negotiated parameters over to the connection socket.
+        client->m_window_scaling_enabled = m_window_scaling_enabled;
+        client->m_peer_window_scale = m_peer_window_scale;
+        client->m_peer_permits_sack = m_peer_permits_sack;
+        client->m_maximum_segment_size = m_maximum_segment_size;
+
         m_pending_release_for_accept.set(tuple, client);
-        table.set(tuple, client);
+        table.ensure(tuple).append(client);
 
         return { move(client) };
     });
@@ -138,8 +159,13 @@ TCPSocket::TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, N
 
 TCPSocket::~TCPSocket()
 {
-    sockets_by_tuple().with_exclusive([&](auto& table) {
-        table.remove(tuple());
+    sockets_by_tuple(local_port()).with_exclusive([&](auto& table) {
+        auto it = table.find(tuple());
+        if (it == table.end())
+            return;
+        it->value.remove_first_matching([&](auto* socket) { return socket == this; });
+        if (it->value.is_empty())
+            table.remove(tuple());
     });
 
     dequeue_for_retransmit();
@@ -167,7 +193,7 @@ KResultOr<size_t> TCPSocket::protocol_receive(ReadonlyBytes raw_ipv4_packet, Use
 
 KResultOr<size_t> TCPSocket::protocol_send(const UserOrKernelBuffer& data, size_t data_length)
 {
-    RoutingDecision routing_decision = route_to(peer_address(), local_address(), bound_interface());
+    RoutingDecision routing_decision = cached_route_to(peer_address(), local_address());
     if (routing_decision.is_zero())
         return set_so_error(EHOSTUNREACH);
     size_t mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
@@ -185,14 +211,37 @@ KResult TCPSocket::send_ack(bool allow_duplicate)
 
 KResult TCPSocket::send_tcp_packet(u16 flags, const UserOrKernelBuffer* payload, size_t payload_size, RoutingDecision* user_routing_decision)
 {
-    RoutingDecision routing_decision = user_routing_decision ? *user_routing_decision : route_to(peer_address(), local_address(), bound_interface());
+    RoutingDecision routing_decision = user_routing_decision ? *user_routing_decision : cached_route_to(peer_address(), local_address());
     if (routing_decision.is_zero())
         return set_so_error(EHOSTUNREACH);
 
     auto ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
 
-    const bool has_mss_option = flags == TCPFlags::SYN;
-    const size_t options_size = has_mss_option ? sizeof(TCPOptionMSS) : 0;
+    // SYN and SYN|ACK carry our MSS, window scale and SACK-permitted options,
+    // NOP-padded to a multiple of four bytes. On a SYN|ACK we only echo the
+    // options the peer's SYN offered.
+    u8 options[sizeof(TCPOptionMSS) + sizeof(TCPOptionWindowScale) + sizeof(TCPOptionSACKPermitted) + 3];
+    size_t options_size = 0;
+    if (flags & TCPFlags::SYN) {
+        const bool is_syn_ack = (flags & TCPFlags::ACK) != 0;
+        u16 mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
+        m_maximum_segment_size = min(m_maximum_segment_size, (u32)mss);
+        TCPOptionMSS mss_option { mss };
+        memcpy(options + options_size, &mss_option, sizeof(mss_option));
+        options_size += sizeof(mss_option);
+        if (!is_syn_ack || m_window_scaling_enabled) {
+            TCPOptionWindowScale window_scale_option { local_window_scale };
+            memcpy(options + options_size, &window_scale_option, sizeof(window_scale_option));
+            options_size += sizeof(window_scale_option);
+        }
+        if (!is_syn_ack || m_peer_permits_sack) {
+            TCPOptionSACKPermitted sack_permitted_option {};
+            memcpy(options + options_size, &sack_permitted_option, sizeof(sack_permitted_option));
+            options_size += sizeof(sack_permitted_option);
+        }
+        while (options_size % sizeof(u32) != 0)
+            options[options_size++] = TCPOptionKind::Nop;
+    }
     const size_t tcp_header_size = sizeof(TCPPacket) + options_size;
     const size_t buffer_size = ipv4_payload_offset + tcp_header_size + payload_size;
     auto packet = routing_decision.adapter->acquire_packet_buffer(buffer_size);
@@ -230,22 +279,24 @@ KResult TCPSocket::send_tcp_packet(u16 flags, const UserOrKernelBuffer* payload,
         m_sequence_number += payload_size;
     }
 
-    if (has_mss_option) {
-        u16 mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
-        TCPOptionMSS mss_option { mss };
-        VERIFY(packet->buffer->size() >= ipv4_payload_offset + sizeof(TCPPacket) + sizeof(mss_option));
-        memcpy(packet->buffer->data() + ipv4_payload_offset + sizeof(TCPPacket), &mss_option, sizeof(mss_option));
+    if (options_size > 0) {
+        VERIFY(packet->buffer->size() >= ipv4_payload_offset + sizeof(TCPPacket) + options_size);
+        memcpy(packet->buffer->data() + ipv4_payload_offset + sizeof(TCPPacket), options, options_size);
     }
 
-    tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, payload_size));
+    // Nothing verifies checksums for traffic that never leaves the machine,
+    // and hardware with transmit offload inserts its own, so don't walk the
+    // whole payload computing one unless somebody will actually look at it.
+    if (!routing_decision.adapter->is_loopback() && !routing_decision.adapter->offloads_tx_checksums())
+        tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, payload_size));
 
-    routing_decision.adapter->send_packet(packet->bytes());
+    routing_decision.adapter->send_packet_buffer(*packet);
 
     m_packets_out++;
     m_bytes_out += buffer_size;
     if (tcp_packet.has_syn() || payload_size > 0) {
         m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-            unacked_packets.packets.append({ m_sequence_number, move(packet), ipv4_payload_offset, *routing_decision.adapter });
+            unacked_packets.packets.append({ m_sequence_number, move(packet), ipv4_payload_offset, (u32)payload_size, *routing_decision.adapter });
             unacked_packets.size += payload_size;
             enqueue_for_retransmit();
         });
@@ -258,12 +309,19 @@ KResult TCPSocket::send_tcp_packet(u16 flags, const UserOrKernelBuffer* payload,
 
 void TCPSocket::receive_tcp_packet(const TCPPacket& packet, u16 size)
 {
+    parse_options(packet);
+
+    // The window field of a SYN is never scaled (RFC 7323 section 2.2).
+    if (!packet.has_syn())
+        m_send_window_size = (u32)packet.window_size() << (m_window_scaling_enabled ? m_peer_window_scale : 0);
+
     if (packet.has_ack()) {
         u32 ack_number = packet.ack_number();
 
         dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet: {}", ack_number);
 
         int removed = 0;
+        size_t acked_bytes = 0;
         m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
             while (!unacked_packets.packets.is_empty()) {
                 auto& packet = unacked_packets.packets.first();
@@ -277,6 +335,7 @@ void TCPSocket::receive_tcp_packet(const TCPPacket& packet, u16 size)
                     TCPPacket& tcp_packet = *(TCPPacket*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
                     auto payload_size = packet.buffer->buffer->data() + packet.buffer->buffer->size() - (u8*)tcp_packet.payload();
                     unacked_packets.size -= payload_size;
+                    acked_bytes += payload_size;
                     evaluate_block_conditions();
                     unacked_packets.packets.take_first();
                     removed++;
@@ -292,12 +351,181 @@ void TCPSocket::receive_tcp_packet(const TCPPacket& packet, u16 size)
 
             dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet acknowledged {} packets", removed);
         });
+
+        if (removed > 0) {
+            m_consecutive_duplicate_acks = 0;
+            did_ack_new_data(acked_bytes);
+        } else if (size == 0 && ack_number == m_last_seen_ack_number && !packet.has_syn() && !packet.has_fin() && !packet.has_rst()) {
+            // A pure ACK for data we've already had acked means the peer is
+            // missing a segment. Three of those in a row trigger a fast
+            // retransmit of the first hole instead of waiting for the
+            // retransmit timer.
+            if (++m_consecutive_duplicate_acks == 3)
+                fast_retransmit();
+        }
+        m_last_seen_ack_number = ack_number;
     }
 
     m_packets_in++;
     m_bytes_in += packet.header_size() + size;
 }
 
+void TCPSocket::parse_options(TCPPacket const& packet)
+{
+    auto const* options = (u8 const*)&packet + sizeof(TCPPacket);
+    size_t options_size = packet.header_size() - sizeof(TCPPacket);
+
+    if (packet.has_syn()) {
+        // Start negotiation from scratch; this matters for listening sockets,
+        // which parse the SYN of every incoming connection.
+        m_window_scaling_enabled = false;
+        m_peer_window_scale = 0;
+        m_peer_permits_sack = false;
+    }
+
+    size_t offset = 0;
+    while (offset < options_size) {
+        u8 kind = options[offset];
+        if (kind == TCPOptionKind::End)
+            break;
+        if (kind == TCPOptionKind::Nop) {
+            ++offset;
+            continue;
+        }
+        if (offset + 1 >= options_size)
+            break;
+        u8 length = options[offset + 1];
+        if (length < 2 || offset + length > options_size)
+            break;
+
+        switch (kind) {
+        case TCPOptionKind::MSS:
+            if (packet.has_syn() && length == sizeof(TCPOptionMSS)) {
+                u16 peer_mss = (u16)(options[offset + 2] << 8) | options[offset + 3];
+                if (peer_mss >= 536)
+                    m_maximum_segment_size = min(m_maximum_segment_size, (u32)peer_mss);
+            }
+            break;
+        case TCPOptionKind::WindowScale:
+            if (packet.has_syn() && length == sizeof(TCPOptionWindowScale)) {
+                m_window_scaling_enabled = true;
+                // RFC 7323 caps the shift at 14.
+                m_peer_window_scale = min(options[offset + 2], (u8)14);
+            }
+            break;
+        case TCPOptionKind::SACKPermitted:
+            if (packet.has_syn())
+                m_peer_permits_sack = true;
+            break;
+        case TCPOptionKind::SACK:
+            if (m_peer_permits_sack)
+                record_sack_blocks({ options + offset + 2, (size_t)length - 2 });
+            break;
+        default:
+            break;
+        }
+        offset += length;
+    }
+}
+
+void TCPSocket::record_sack_blocks(ReadonlyBytes blocks)
+{
+    m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
+        for (size_t i = 0; i + 2 * sizeof(u32) <= blocks.size(); i += 2 * sizeof(u32)) {
+            NetworkOrdered<u32> edges[2];
+            memcpy(edges, blocks.data() + i, sizeof(edges));
+            u32 left_edge = edges[0];
+            u32 right_edge = edges[1];
+            for (auto& packet : unacked_packets.packets) {
+                if (packet.sacked || packet.payload_size == 0)
+                    continue;
+                u32 end_sequence = packet.ack_number;
+                u32 start_sequence = end_sequence - packet.payload_size;
+                if (left_edge <= start_sequence && end_sequence <= right_edge) {
+                    dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: SACK covers {}..{}", start_sequence, end_sequence);
+                    packet.sacked = true;
+                }
+            }
+        }
+    });
+}
+
+static u32 integer_cube_root(u64 value)
+{
+    u64 result = 0;
+    for (int shift = 63; shift >= 0; shift -= 3) {
+        result <<= 1;
+        u64 delta = 3 * result * (result + 1) + 1;
+        if ((value >> shift) >= delta) {
+            value -= delta << shift;
+            result++;
+        }
+    }
+    return result;
+}
+
+void TCPSocket::did_ack_new_data(size_t acked_bytes)
+{
+    if (m_congestion_window < m_slow_start_threshold) {
+        // Slow start: the window grows by every byte acknowledged.
+        m_congestion_window += acked_bytes;
+        return;
+    }
+
+    // CUBIC congestion avoidance (RFC 8312), computed in whole segments with
+    // millisecond timestamps: W(t) = C * (t - K)^3 + W_max, with C = 0.4 and
+    // beta = 0.7, so K = cbrt(0.75 * W_max) seconds.
+    u64 window_max_segments = m_cubic_window_max / m_maximum_segment_size;
+    i64 elapsed_ms = (i64)(kgettimeofday() - m_last_window_reduction_time).to_milliseconds();
+    i64 k_ms = integer_cube_root(750'000'000uLL * window_max_segments);
+    i64 time_offset_ms = elapsed_ms - k_ms;
+    // Keep the cube from overflowing if the connection sat idle for ages.
+    time_offset_ms = clamp(time_offset_ms, (i64)-100'000, (i64)100'000);
+    i64 target_segments = (i64)window_max_segments + time_offset_ms * time_offset_ms * time_offset_ms / 2'500'000'000LL;
+    if (target_segments < 2)
+        target_segments = 2;
+    u64 target_window = (u64)target_segments * m_maximum_segment_size;
+    // Approach the cubic target, but never grow faster than slow start would.
+    if (target_window > m_congestion_window)
+        m_congestion_window += min((u64)acked_bytes, target_window - m_congestion_window);
+}
+
+void TCPSocket::reduce_congestion_window()
+{
+    // Multiplicative decrease with CUBIC's beta of 0.7.
+    m_cubic_window_max = m_congestion_window;
+    m_congestion_window = max(m_congestion_window * 7 / 10, 2 * m_maximum_segment_size);
+    m_slow_start_threshold = m_congestion_window;
+    m_last_window_reduction_time = kgettimeofday();
+}
+
+void TCPSocket::fast_retransmit()
+{
+    auto routing_decision = cached_route_to(peer_address(), local_address());
+    if (routing_decision.is_zero())
+        return;
+
+    m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
+        // Resend only the first hole; everything the peer selectively
+        // acknowledged is still in flight from its point of view.
+        for (auto& packet : unacked_packets.packets) {
+            if (packet.sacked)
+                continue;
+            packet.tx_counter++;
+            auto packet_buffer = packet.buffer->bytes();
+            routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
+                local_address(), routing_decision.next_hop, peer_address(),
+                IPv4Protocol::TCP, packet_buffer.size() - packet.ipv4_payload_offset, ttl());
+            routing_decision.adapter->send_packet_buffer(*packet.buffer);
+            m_packets_out++;
+            m_bytes_out += packet_buffer.size();
+            break;
+        }
+    });
+
+    reduce_congestion_window();
+}
+
 bool TCPSocket::should_delay_next_ack() const
 {
     // FIXME: We don't know the MSS here so make a reasonable guess.
@@ -326,33 +554,13 @@ NetworkOrdered<u16> TCPSocket::compute_tcp_checksum(const IPv4Address& source, c
 
     PseudoHeader pseudo_header { source, destination, 0, (u8)IPv4Protocol::TCP, packet.header_size() + payload_size };
 
-    u32 checksum = 0;
-    auto raw_pseudo_header = bit_cast<u16*>(&pseudo_header);
-    for (size_t i = 0; i < sizeof(pseudo_header) / sizeof(u16); ++i) {
-        checksum += AK::convert_between_host_and_network_endian(raw_pseudo_header[i]);
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
-    auto raw_packet = bit_cast<u16*>(&packet);
-    for (size_t i = 0; i < packet.header_size() / sizeof(u16); ++i) {
-        checksum += AK::convert_between_host_and_network_endian(raw_packet[i]);
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
+    // The pseudo-header and the TCP header both have even sizes, so the
+    // three ranges can share one ones-complement accumulator.
+    u64 sum = internet_checksum_step(0, &pseudo_header, sizeof(pseudo_header));
+    sum = internet_checksum_step(sum, &packet, packet.header_size());
     VERIFY(packet.data_offset() * 4 == packet.header_size());
-    auto raw_payload = bit_cast<u16*>(packet.payload());
-    for (size_t i = 0; i < payload_size / sizeof(u16); ++i) {
-        checksum += AK::convert_between_host_and_network_endian(raw_payload[i]);
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
-    if (payload_size & 1) {
-        u16 expanded_byte = ((const u8*)packet.payload())[payload_size - 1] << 8;
-        checksum += expanded_byte;
-        if (checksum > 0xffff)
-            checksum = (checksum >> 16) + (checksum & 0xffff);
-    }
-    return ~(checksum & 0xffff);
+    sum = internet_checksum_step(sum, packet.payload(), payload_size);
+    return internet_checksum_finish(sum);
 }
 
 KResult TCPSocket::protocol_bind()
@@ -369,10 +577,18 @@ KResult TCPSocket::protocol_bind()
 KResult TCPSocket::protocol_listen(bool did_allocate_port)
 {
     if (!did_allocate_port) {
-        bool ok = sockets_by_tuple().with_exclusive([&](auto& table) -> bool {
-            if (table.contains(tuple()))
-                return false;
-            table.set(tuple(), this);
+        bool ok = sockets_by_tuple(local_port()).with_exclusive([&](auto& table) -> bool {
+            auto& sockets = table.ensure(tuple());
+            if (!sockets.is_empty()) {
+                // Sharing a listen tuple requires SO_REUSEPORT on every
+                // socket involved.
+                bool all_allow_reuse = allows_port_reuse();
+                for (auto* socket : sockets)
+                    all_allow_reuse &= socket->allows_port_reuse();
+                if (!all_allow_reuse)
+                    return false;
+            }
+            sockets.append(this);
             return true;
         });
         if (!ok)
@@ -436,24 +652,27 @@ KResultOr<u16> TCPSocket::protocol_allocate_local_port()
     constexpr u16 ephemeral_port_range_size = last_ephemeral_port - first_ephemeral_port;
     u16 first_scan_port = first_ephemeral_port + get_good_random<u16>() % ephemeral_port_range_size;
 
-    return sockets_by_tuple().with_exclusive([&](auto& table) -> KResultOr<u16> {
-        for (u16 port = first_scan_port;;) {
-            IPv4SocketTuple proposed_tuple(local_address(), port, peer_address(), peer_port());
+    for (u16 port = first_scan_port;;) {
+        IPv4SocketTuple proposed_tuple(local_address(), port, peer_address(), peer_port());
 
+        bool claimed = sockets_by_tuple(port).with_exclusive([&](auto& table) {
             auto it = table.find(proposed_tuple);
-            if (it == table.end()) {
-                set_local_port(port);
-                table.set(proposed_tuple, this);
-                return port;
-            }
-            ++port;
-            if (port > last_ephemeral_port)
-                port = first_ephemeral_port;
-            if (port == first_scan_port)
-                break;
-        }
-        return set_so_error(EADDRINUSE);
-    });
+            if (it != table.end() && !it->value.is_empty())
+                return false;
+            set_local_port(port);
+            table.ensure(proposed_tuple).append(this);
+            return true;
+        });
+        if (claimed)
+            return port;
+
+        ++port;
+        if (port > last_ephemeral_port)
+            port = first_ephemeral_port;
+        if (port == first_scan_port)
+            break;
+    }
+    return set_so_error(EADDRINUSE);
 }
 
 bool TCPSocket::protocol_is_disconnected() const
@@ -546,12 +765,19 @@ void TCPSocket::retransmit_packets()
         return;
     }
 
-    auto routing_decision = route_to(peer_address(), local_address(), bound_interface());
+    auto routing_decision = cached_route_to(peer_address(), local_address());
     if (routing_decision.is_zero())
         return;
 
+    // A retransmit timeout is a stronger loss signal than duplicate acks,
+    // so fall all the way back into slow start.
+    reduce_congestion_window();
+    m_congestion_window = 2 * m_maximum_segment_size;
+
     m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
         for (auto& packet : unacked_packets.packets) {
+            if (packet.sacked)
+                continue;
             packet.tx_counter++;
 
             if constexpr (TCP_SOCKET_DEBUG) {
@@ -581,7 +807,7 @@ void TCPSocket::retransmit_packets()
             routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
                 local_address(), routing_decision.next_hop, peer_address(),
                 IPv4Protocol::TCP, packet_buffer.size() - ipv4_payload_offset, ttl());
-            routing_decision.adapter->send_packet(packet_buffer);
+            routing_decision.adapter->send_packet_buffer(*packet.buffer);
             m_packets_out++;
             m_bytes_out += packet_buffer.size();
         }
@@ -600,7 +826,7 @@ bool TCPSocket::can_write(const OpenFileDescription& file_description, size_t si
         return true;
 
     return m_unacked_packets.with_shared([&](auto& unacked_packets) {
-        return unacked_packets.size + size <= m_send_window_size;
+        return unacked_packets.size + size <= min(m_send_window_size, m_congestion_window);
     });
 }
 }
@@ -8,6 +8,7 @@
 
 #include <AK/Function.h>
 #include <AK/HashMap.h>
+#include <AK/NumericLimits.h>
 #include <AK/SinglyLinkedList.h>
 #include <AK/WeakPtr.h>
 #include <Kernel/API/KResult.h>
@@ -142,7 +143,12 @@ public:
 
     bool should_delay_next_ack() const;
 
-    static MutexProtected<HashMap<IPv4SocketTuple, TCPSocket*>>& sockets_by_tuple();
+    // The tuple table is sharded by local port so that traffic on unrelated
+    // connections doesn't contend on a single lock. A tuple's wildcard
+    // variants share its local port, so all candidates live in one shard.
+    // With SO_REUSEPORT multiple listeners can share one tuple.
+    static constexpr size_t num_socket_table_shards = 16;
+    static MutexProtected<HashMap<IPv4SocketTuple, Vector<TCPSocket*>>>& sockets_by_tuple(u16 local_port);
     static RefPtr<TCPSocket> from_tuple(const IPv4SocketTuple& tuple);
 
     static MutexProtected<HashMap<IPv4SocketTuple, RefPtr<TCPSocket>>>& closing_sockets();
@@ -181,6 +187,12 @@ private:
     void enqueue_for_retransmit();
     void dequeue_for_retransmit();
 
+    void parse_options(TCPPacket const&);
+    void record_sack_blocks(ReadonlyBytes);
+    void did_ack_new_data(size_t acked_bytes);
+    void reduce_congestion_window();
+    void fast_retransmit();
+
     WeakPtr<TCPSocket> m_originator;
     HashMap<IPv4SocketTuple, NonnullRefPtr<TCPSocket>> m_pending_release_for_accept;
     Direction m_direction { Direction::Unspecified };
@@ -198,8 +210,12 @@ private:
         u32 ack_number { 0 };
         RefPtr<PacketWithTimestamp> buffer;
         size_t ipv4_payload_offset;
+        u32 payload_size { 0 };
         WeakPtr<NetworkAdapter> adapter;
         int tx_counter { 0 };
+        // Set when the peer selectively acknowledged this packet; it's kept
+        // around until cumulatively acked but doesn't get retransmitted.
+        bool sacked { false };
     };
 
     struct UnackedPackets {
@@ -219,9 +235,30 @@ private:
     Time m_last_retransmit_time;
     u32 m_retransmit_attempts { 0 };
 
-    // FIXME: Parse window size TCP option from the peer
+    // Updated from every packet the peer sends us, shifted by the window
+    // scale negotiated during the handshake (RFC 7323).
     u32 m_send_window_size { 64 * KiB };
 
+    // We advertise a shift of 2 so the peer can fill our whole 256 KiB
+    // receive buffer, since the window field itself maxes out at 64 KiB.
+    static constexpr u8 local_window_scale = 2;
+    bool m_window_scaling_enabled { false };
+    u8 m_peer_window_scale { 0 };
+    bool m_peer_permits_sack { false };
+
+    u32 m_last_seen_ack_number { 0 };
+    u32 m_consecutive_duplicate_acks { 0 };
+
+    // CUBIC congestion control state (RFC 8312). The window starts out in
+    // slow start and converges on the cubic growth curve after the first
+    // loss event.
+    static constexpr u32 default_maximum_segment_size = 1460;
+    u32 m_maximum_segment_size { default_maximum_segment_size };
+    u32 m_congestion_window { 10 * default_maximum_segment_size };
+    u32 m_slow_start_threshold { NumericLimits<u32>::max() };
+    u32 m_cubic_window_max { 0 };
+    Time m_last_window_reduction_time {};
+
     IntrusiveListNode<TCPSocket> m_retransmit_list_node;
 
 public:
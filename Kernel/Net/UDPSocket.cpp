@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/HashFunctions.h>
 #include <AK/Singleton.h>
 #include <Kernel/Devices/RandomDevice.h>
 #include <Kernel/Net/NetworkAdapter.h>
@@ -15,30 +17,38 @@
 
 namespace Kernel {
 
+static Singleton<Array<MutexProtected<HashMap<u16, Vector<UDPSocket*>>>, UDPSocket::num_socket_table_shards>> s_map;
+
 void UDPSocket::for_each(Function<void(const UDPSocket&)> callback)
 {
-    sockets_by_port().for_each_shared([&](const auto& socket) {
-        callback(*socket.value);
-    });
+    for (auto& shard : *s_map) {
+        shard.for_each_shared([&](const auto& it) {
+            for (auto* socket : it.value)
+                callback(*socket);
+        });
+    }
 }
 
-static Singleton<MutexProtected<HashMap<u16, UDPSocket*>>> s_map;
-
-MutexProtected<HashMap<u16, UDPSocket*>>& UDPSocket::sockets_by_port()
+MutexProtected<HashMap<u16, Vector<UDPSocket*>>>& UDPSocket::sockets_by_port(u16 port)
 {
-    return *s_map;
+    return (*s_map)[port % num_socket_table_shards];
 }
 
-SocketHandle<UDPSocket> UDPSocket::from_port(u16 port)
+SocketHandle<UDPSocket> UDPSocket::from_port(u16 port, IPv4Address const& peer_address, u16 peer_port)
 {
-    return sockets_by_port().with_shared([&](const auto& table) -> SocketHandle<UDPSocket> {
-        RefPtr<UDPSocket> socket;
+    return sockets_by_port(port).with_shared([&](const auto& table) -> SocketHandle<UDPSocket> {
         auto it = table.find(port);
-        if (it == table.end())
+        if (it == table.end() || it->value.is_empty())
             return {};
-        socket = (*it).value;
+        auto& sockets = it->value;
+        // With SO_REUSEPORT several sockets share the port; hashing the
+        // sender keeps any one remote endpoint on the same socket.
+        size_t index = 0;
+        if (sockets.size() > 1)
+            index = pair_int_hash(peer_address.to_u32(), peer_port) % sockets.size();
+        RefPtr<UDPSocket> socket = sockets[index];
         VERIFY(socket);
-        return { *socket };
+        return { socket.release_nonnull() };
     });
 }
 
@@ -49,8 +59,13 @@ UDPSocket::UDPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer)
 
 UDPSocket::~UDPSocket()
 {
-    sockets_by_port().with_exclusive([&](auto& table) {
-        table.remove(local_port());
+    sockets_by_port(local_port()).with_exclusive([&](auto& table) {
+        auto it = table.find(local_port());
+        if (it == table.end())
+            return;
+        it->value.remove_first_matching([&](auto* socket) { return socket == this; });
+        if (it->value.is_empty())
+            table.remove(local_port());
     });
 }
 
@@ -71,7 +86,7 @@ KResultOr<size_t> UDPSocket::protocol_receive(ReadonlyBytes raw_ipv4_packet, Use
 
 KResultOr<size_t> UDPSocket::protocol_send(const UserOrKernelBuffer& data, size_t data_length)
 {
-    auto routing_decision = route_to(peer_address(), local_address(), bound_interface());
+    auto routing_decision = cached_route_to(peer_address(), local_address());
     if (routing_decision.is_zero())
         return set_so_error(EHOSTUNREACH);
     auto ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
@@ -88,7 +103,7 @@ KResultOr<size_t> UDPSocket::protocol_send(const UserOrKernelBuffer& data, size_
     SOCKET_TRY(data.read(udp_packet.payload(), data_length));
     routing_decision.adapter->fill_in_ipv4_header(*packet, local_address(), routing_decision.next_hop,
         peer_address(), IPv4Protocol::UDP, udp_buffer_size, ttl());
-    routing_decision.adapter->send_packet(packet->bytes());
+    routing_decision.adapter->send_packet_buffer(*packet);
     return data_length;
 }
 
@@ -106,30 +121,39 @@ KResultOr<u16> UDPSocket::protocol_allocate_local_port()
     constexpr u16 ephemeral_port_range_size = last_ephemeral_port - first_ephemeral_port;
     u16 first_scan_port = first_ephemeral_port + get_good_random<u16>() % ephemeral_port_range_size;
 
-    return sockets_by_port().with_exclusive([&](auto& table) -> KResultOr<u16> {
-        for (u16 port = first_scan_port;;) {
+    for (u16 port = first_scan_port;;) {
+        bool claimed = sockets_by_port(port).with_exclusive([&](auto& table) {
             auto it = table.find(port);
-            if (it == table.end()) {
-                set_local_port(port);
-                table.set(port, this);
-                return port;
-            }
-            ++port;
-            if (port > last_ephemeral_port)
-                port = first_ephemeral_port;
-            if (port == first_scan_port)
-                break;
-        }
-        return set_so_error(EADDRINUSE);
-    });
+            if (it != table.end() && !it->value.is_empty())
+                return false;
+            set_local_port(port);
+            table.ensure(port).append(this);
+            return true;
+        });
+        if (claimed)
+            return local_port();
+        ++port;
+        if (port > last_ephemeral_port)
+            port = first_ephemeral_port;
+        if (port == first_scan_port)
+            break;
+    }
+    return set_so_error(EADDRINUSE);
 }
 
 KResult UDPSocket::protocol_bind()
 {
-    return sockets_by_port().with_exclusive([&](auto& table) -> KResult {
-        if (table.contains(local_port()))
-            return set_so_error(EADDRINUSE);
-        table.set(local_port(), this);
+    return sockets_by_port(local_port()).with_exclusive([&](auto& table) -> KResult {
+        auto& sockets = table.ensure(local_port());
+        if (!sockets.is_empty()) {
+            // Sharing a port requires SO_REUSEPORT on every socket involved.
+            bool all_allow_reuse = allows_port_reuse();
+            for (auto* socket : sockets)
+                all_allow_reuse &= socket->allows_port_reuse();
+            if (!all_allow_reuse)
+                return set_so_error(EADDRINUSE);
+        }
+        sockets.append(this);
         return KSuccess;
     });
 }
@@ -17,13 +17,17 @@ public:
     static KResultOr<NonnullRefPtr<UDPSocket>> try_create(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer);
     virtual ~UDPSocket() override;
 
-    static SocketHandle<UDPSocket> from_port(u16);
+    static SocketHandle<UDPSocket> from_port(u16 port, IPv4Address const& peer_address, u16 peer_port);
     static void for_each(Function<void(const UDPSocket&)>);
 
+    // The port table is sharded so that traffic on unrelated ports doesn't
+    // contend on a single lock.
+    static constexpr size_t num_socket_table_shards = 16;
+
 private:
     explicit UDPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer);
     virtual StringView class_name() const override { return "UDPSocket"; }
-    static MutexProtected<HashMap<u16, UDPSocket*>>& sockets_by_port();
+    static MutexProtected<HashMap<u16, Vector<UDPSocket*>>>& sockets_by_port(u16 port);
 
     virtual KResultOr<size_t> protocol_receive(ReadonlyBytes raw_ipv4_packet, UserOrKernelBuffer& buffer, size_t buffer_size, int flags) override;
     virtual KResultOr<size_t> protocol_send(const UserOrKernelBuffer&, size_t) override;
@@ -18,6 +18,13 @@ namespace Kernel {
 PerformanceEventBuffer::PerformanceEventBuffer(NonnullOwnPtr<KBuffer> buffer)
     : m_buffer(move(buffer))
 {
+    auto processor_count = Processor::count();
+    VERIFY(processor_count <= max_processor_count);
+    auto segment_capacity = capacity() / processor_count;
+    for (u32 cpu = 0; cpu < processor_count; ++cpu) {
+        m_segments[cpu].base = cpu * segment_capacity;
+        m_segments[cpu].capacity = segment_capacity;
+    }
 }
 
 NEVER_INLINE KResult PerformanceEventBuffer::append(int type, FlatPtr arg1, FlatPtr arg2, const StringView& arg3, Thread* current_thread)
@@ -57,7 +64,7 @@ static Vector<FlatPtr, PerformanceEvent::max_stack_frame_count> raw_backtrace(Fl
 KResult PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, ThreadID tid,
     FlatPtr ip, FlatPtr bp, int type, u32 lost_samples, FlatPtr arg1, FlatPtr arg2, const StringView& arg3)
 {
-    if (count() >= capacity())
+    if (m_segments[Processor::current_id()].count >= m_segments[Processor::current_id()].capacity)
         return ENOBUFS;
 
     if ((g_profiling_event_mask & type) == 0)
@@ -152,7 +159,16 @@ KResult PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, ThreadID ti
     event.pid = pid.value();
     event.tid = tid.value();
     event.timestamp = TimeManagement::the().uptime_ms();
-    at(m_count++) = event;
+
+    // Stay on this processor while touching its segment. Interrupt handlers
+    // appending on top of us are already rejected by the per-thread profiler
+    // re-entrancy guard above, so the owning processor is the only writer.
+    ScopedCritical critical;
+    auto& segment = m_segments[Processor::current_id()];
+    if (segment.count >= segment.capacity)
+        return ENOBUFS;
+    at(segment.base + segment.count) = event;
+    segment.count++;
     return KSuccess;
 }
 
@@ -175,8 +191,26 @@ KResult PerformanceEventBuffer::to_json_impl(Serializer& object) const
 
     auto array = object.add_array("events");
     bool seen_first_sample = false;
-    for (size_t i = 0; i < m_count; ++i) {
-        auto& event = at(i);
+    // Each per-processor segment is in timestamp order on its own, so a
+    // simple k-way merge gives the viewer one globally ordered stream.
+    size_t segment_indices[max_processor_count] {};
+    for (;;) {
+        const PerformanceEvent* next_event = nullptr;
+        size_t next_segment = 0;
+        for (size_t cpu = 0; cpu < max_processor_count; ++cpu) {
+            auto& segment = m_segments[cpu];
+            if (segment_indices[cpu] >= segment.count)
+                continue;
+            auto& candidate = at(segment.base + segment_indices[cpu]);
+            if (!next_event || candidate.timestamp < next_event->timestamp) {
+                next_event = &candidate;
+                next_segment = cpu;
+            }
+        }
+        if (!next_event)
+            break;
+        segment_indices[next_segment]++;
+        auto& event = *next_event;
         auto event_object = array.add_object();
         switch (event.type) {
         case PERF_EVENT_SAMPLE:
@@ -106,11 +106,18 @@ public:
 
     void clear()
     {
-        m_count = 0;
+        for (auto& segment : m_segments)
+            segment.count = 0;
     }
 
     size_t capacity() const { return m_buffer->size() / sizeof(PerformanceEvent); }
-    size_t count() const { return m_count; }
+    size_t count() const
+    {
+        size_t total = 0;
+        for (auto& segment : m_segments)
+            total += segment.count;
+        return total;
+    }
     const PerformanceEvent& at(size_t index) const
     {
         return const_cast<PerformanceEventBuffer&>(*this).at(index);
@@ -130,7 +137,17 @@ private:
 
     PerformanceEvent& at(size_t index);
 
-    size_t m_count { 0 };
+    // Each processor appends into its own segment of the buffer, so the
+    // sampling path never takes a lock or bounces a shared count between
+    // cores. The segments are merged by timestamp at serialization time.
+    static constexpr size_t max_processor_count = sizeof(u32) * 8;
+    struct Segment {
+        size_t base { 0 };
+        size_t capacity { 0 };
+        size_t count { 0 }; // Only written by the owning processor
+    };
+    Segment m_segments[max_processor_count];
+
     NonnullOwnPtr<KBuffer> m_buffer;
 
     NonnullOwnPtrVector<KString> m_strings;
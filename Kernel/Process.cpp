@@ -667,6 +667,15 @@ void Process::unblock_waiters(Thread::WaitBlocker::UnblockFlags flags, u8 signal
         parent->m_wait_blocker_set.unblock(*this, flags, signal);
 }
 
+void Process::unblock_vfork_parent()
+{
+    auto parent = move(m_vfork_parent);
+    if (!parent)
+        return;
+    m_vfork_completed.store(true, AK::MemoryOrder::memory_order_release);
+    parent->m_vfork_wait_queue.wake_all();
+}
+
 void Process::die()
 {
     auto expected = State::Running;
@@ -678,6 +687,10 @@ void Process::die()
         return;
     }
 
+    // If we were created by vfork() and never exec'ed, the parent is still
+    // blocked waiting for us; let it go before we start tearing things down.
+    unblock_vfork_parent();
+
     // Let go of the TTY, otherwise a slave PTY may keep the master PTY from
     // getting an EOF when the last process using the slave PTY dies.
     // If the master PTY owner relies on an EOF to know when to wait() on a
@@ -33,6 +33,7 @@
 #include <Kernel/StdLib.h>
 #include <Kernel/Thread.h>
 #include <Kernel/UnixTypes.h>
+#include <Kernel/WaitQueue.h>
 #include <LibC/elf.h>
 #include <LibC/signal_numbers.h>
 
@@ -258,6 +259,10 @@ public:
     void die();
     void finalize();
 
+    // If this process was created by vfork(), wake the parent that's blocked
+    // waiting for us to exec or exit. Safe to call more than once.
+    void unblock_vfork_parent();
+
     ThreadTracer* tracer() { return m_tracer.ptr(); }
     bool is_traced() const { return !!m_tracer; }
     KResult start_tracing_from(ProcessID tracer);
@@ -295,6 +300,7 @@ public:
     KResultOr<FlatPtr> sys$close(int fd);
     KResultOr<FlatPtr> sys$read(int fd, Userspace<u8*>, size_t);
     KResultOr<FlatPtr> sys$readv(int fd, Userspace<const struct iovec*> iov, int iov_count);
+    KResultOr<FlatPtr> sys$iobatch(Userspace<const Syscall::SC_iobatch_params*>);
     KResultOr<FlatPtr> sys$write(int fd, Userspace<const u8*>, size_t);
     KResultOr<FlatPtr> sys$writev(int fd, Userspace<const struct iovec*> iov, int iov_count);
     KResultOr<FlatPtr> sys$fstat(int fd, Userspace<stat*>);
@@ -315,6 +321,9 @@ public:
     KResultOr<FlatPtr> sys$purge(int mode);
     KResultOr<FlatPtr> sys$select(Userspace<const Syscall::SC_select_params*>);
     KResultOr<FlatPtr> sys$poll(Userspace<const Syscall::SC_poll_params*>);
+    KResultOr<FlatPtr> sys$event_queue_create(u32 flags);
+    KResultOr<FlatPtr> sys$event_queue_ctl(Userspace<const Syscall::SC_event_queue_ctl_params*>);
+    KResultOr<FlatPtr> sys$event_queue_wait(Userspace<const Syscall::SC_event_queue_wait_params*>);
     KResultOr<FlatPtr> sys$get_dir_entries(int fd, Userspace<void*>, size_t);
     KResultOr<FlatPtr> sys$getcwd(Userspace<char*>, size_t);
     KResultOr<FlatPtr> sys$chdir(Userspace<const char*>, size_t);
@@ -330,6 +339,7 @@ public:
     KResultOr<FlatPtr> sys$ttyname(int fd, Userspace<char*>, size_t);
     KResultOr<FlatPtr> sys$ptsname(int fd, Userspace<char*>, size_t);
     KResultOr<FlatPtr> sys$fork(RegisterState&);
+    KResultOr<FlatPtr> sys$vfork(RegisterState&);
     KResultOr<FlatPtr> sys$execve(Userspace<const Syscall::SC_execve_params*>);
     KResultOr<FlatPtr> sys$dup2(int old_fd, int new_fd);
     KResultOr<FlatPtr> sys$sigaction(int signum, Userspace<const sigaction*> act, Userspace<sigaction*> old_act);
@@ -371,6 +381,8 @@ public:
     KResultOr<FlatPtr> sys$shutdown(int sockfd, int how);
     KResultOr<FlatPtr> sys$sendmsg(int sockfd, Userspace<const struct msghdr*>, int flags);
     KResultOr<FlatPtr> sys$recvmsg(int sockfd, Userspace<struct msghdr*>, int flags);
+    KResultOr<FlatPtr> sys$sendmmsg(Userspace<const Syscall::SC_sendmmsg_params*>);
+    KResultOr<FlatPtr> sys$recvmmsg(Userspace<const Syscall::SC_recvmmsg_params*>);
     KResultOr<FlatPtr> sys$getsockopt(Userspace<const Syscall::SC_getsockopt_params*>);
     KResultOr<FlatPtr> sys$setsockopt(Userspace<const Syscall::SC_setsockopt_params*>);
     KResultOr<FlatPtr> sys$getsockname(Userspace<const Syscall::SC_getsockname_params*>);
@@ -378,6 +390,8 @@ public:
     KResultOr<FlatPtr> sys$socketpair(Userspace<const Syscall::SC_socketpair_params*>);
     KResultOr<FlatPtr> sys$sched_setparam(pid_t pid, Userspace<const struct sched_param*>);
     KResultOr<FlatPtr> sys$sched_getparam(pid_t pid, Userspace<struct sched_param*>);
+    KResultOr<FlatPtr> sys$sched_setscheduler(pid_t pid, int policy, Userspace<const struct sched_param*>);
+    KResultOr<FlatPtr> sys$sched_getscheduler(pid_t pid);
     KResultOr<FlatPtr> sys$create_thread(void* (*)(void*), Userspace<const Syscall::SC_create_thread_params*>);
     [[noreturn]] void sys$exit_thread(Userspace<void*>, Userspace<void*>, size_t);
     KResultOr<FlatPtr> sys$join_thread(pid_t tid, Userspace<void**> exit_value);
@@ -406,6 +420,7 @@ public:
     KResultOr<FlatPtr> sys$get_stack_bounds(Userspace<FlatPtr*> stack_base, Userspace<size_t*> stack_size);
     KResultOr<FlatPtr> sys$ptrace(Userspace<const Syscall::SC_ptrace_params*>);
     KResultOr<FlatPtr> sys$sendfd(int sockfd, int fd);
+    KResultOr<FlatPtr> sys$sendfile(Userspace<const Syscall::SC_sendfile_params*>);
     KResultOr<FlatPtr> sys$recvfd(int sockfd, int options);
     KResultOr<FlatPtr> sys$sysconf(int name);
     KResultOr<FlatPtr> sys$disown(ProcessID);
@@ -420,6 +435,9 @@ public:
     template<bool sockname, typename Params>
     KResult get_sock_or_peer_name(Params const&);
 
+    KResultOr<size_t> do_sendmsg(int sockfd, const struct msghdr&, int flags);
+    KResultOr<size_t> do_recvmsg(int sockfd, Userspace<struct msghdr*>, int flags);
+
     static void initialize();
 
     [[noreturn]] void crash(int signal, FlatPtr ip, bool out_of_memory = false);
@@ -534,6 +552,8 @@ private:
     bool create_perf_events_buffer_if_needed();
     void delete_perf_events_buffer();
 
+    KResultOr<FlatPtr> do_fork(RegisterState&, bool share_memory_with_parent);
+
     KResult do_exec(NonnullRefPtr<OpenFileDescription> main_program_description, Vector<String> arguments, Vector<String> environment, RefPtr<OpenFileDescription> interpreter_description, Thread*& new_main_thread, u32& prev_flags, const ElfW(Ehdr) & main_program_header);
     KResultOr<FlatPtr> do_write(OpenFileDescription&, const UserOrKernelBuffer&, size_t);
 
@@ -775,6 +795,13 @@ private:
     Mutex m_big_lock { "Process" };
     Mutex m_ptrace_lock { "ptrace" };
 
+    // vfork() children borrow the parent's address space until they exec or
+    // exit; the parent blocks on m_vfork_wait_queue until then. These live in
+    // the child (m_vfork_parent, m_vfork_completed) and parent (the queue).
+    RefPtr<Process> m_vfork_parent;
+    Atomic<bool> m_vfork_completed { false };
+    WaitQueue m_vfork_wait_queue;
+
     RefPtr<Timer> m_alarm_timer;
 
     VeilState m_veil_state { VeilState::None };
@@ -782,8 +809,21 @@ private:
 
     OwnPtr<PerformanceEventBuffer> m_perf_event_buffer;
 
-    FutexQueues m_futex_queues;
-    Spinlock m_futex_lock;
+    // Futex queues are sharded by address so heavily threaded processes
+    // don't serialize every wait/wake on a single lock.
+    static constexpr size_t futex_shard_count = 16;
+    struct FutexShard {
+        Spinlock lock;
+        FutexQueues queues;
+    };
+    FutexShard m_futex_shards[futex_shard_count];
+
+    FutexShard& futex_shard_for(FlatPtr user_address)
+    {
+        // Futex words are naturally 4-byte aligned, so drop the low bits
+        // before picking a shard.
+        return m_futex_shards[(user_address >> 2) % futex_shard_count];
+    }
 
     // This member is used in the implementation of ptrace's PT_TRACEME flag.
     // If it is set to true, the process will stop at the next execve syscall
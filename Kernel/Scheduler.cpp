@@ -47,7 +47,23 @@ struct ThreadReadyQueues {
     Array<ThreadReadyQueue, count> queues;
 };
 
-static Singleton<SpinlockProtected<ThreadReadyQueues>> g_ready_queues;
+// Each processor schedules out of its own set of ready queues, so enqueueing
+// and pulling threads only touches the local queues' lock in the common case.
+// A processor whose queues are all empty steals from its neighbors instead of
+// going idle. The number of queue sets is bounded by the width of the thread
+// affinity mask.
+struct PerProcessorReadyQueues {
+    static constexpr size_t max_count = sizeof(u32) * 8;
+    Array<SpinlockProtected<ThreadReadyQueues>, max_count> per_cpu;
+};
+
+static Singleton<PerProcessorReadyQueues> g_ready_queues;
+
+static SpinlockProtected<ThreadReadyQueues>& ready_queues_for_cpu(u32 cpu)
+{
+    VERIFY(cpu < PerProcessorReadyQueues::max_count);
+    return g_ready_queues->per_cpu[cpu];
+}
 
 static SpinlockProtected<TotalTimeScheduled> g_total_time_scheduled;
 
@@ -69,50 +85,84 @@ static inline u32 thread_priority_to_priority_index(u32 thread_priority)
     return priority_bucket;
 }
 
-Thread& Scheduler::pull_next_runnable_thread()
+static inline u32 thread_to_priority_index(Thread& thread)
 {
-    auto affinity_mask = 1u << Processor::current_id();
+    // Bucket 0 is reserved for realtime threads so they always run before
+    // any normal-priority thread on the same processor.
+    if (thread.is_realtime())
+        return 0;
+    return max(1u, thread_priority_to_priority_index(thread.priority()));
+}
 
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread& {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = __builtin_ffsl(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                thread.m_runnable_priority = -1;
-                ready_queue.thread_list.remove(thread);
-                if (ready_queue.thread_list.is_empty())
-                    ready_queues.mask &= ~(1u << priority);
-                // Mark it as active because we are using this thread. This is similar
-                // to comparing it with Processor::current_thread, but when there are
-                // multiple processors there's no easy way to check whether the thread
-                // is actually still needed. This prevents accidental finalization when
-                // a thread is no longer in Running state, but running on another core.
-
-                // We need to mark it active here so that this thread won't be
-                // scheduled on another core if it were to be queued before actually
-                // switching to it.
-                // FIXME: Figure out a better way maybe?
-                thread.set_active(true);
-                return thread;
-            }
-            priority_mask &= ~(1u << priority);
+static Thread* pull_runnable_thread_from(ThreadReadyQueues& ready_queues, u32 affinity_mask)
+{
+    auto priority_mask = ready_queues.mask;
+    while (priority_mask != 0) {
+        auto priority = __builtin_ffsl(priority_mask);
+        VERIFY(priority > 0);
+        auto& ready_queue = ready_queues.queues[--priority];
+        for (auto& thread : ready_queue.thread_list) {
+            VERIFY(thread.m_runnable_priority == (int)priority);
+            if (thread.is_active())
+                continue;
+            if (!(thread.affinity() & affinity_mask))
+                continue;
+            thread.m_runnable_priority = -1;
+            ready_queue.thread_list.remove(thread);
+            if (ready_queue.thread_list.is_empty())
+                ready_queues.mask &= ~(1u << priority);
+            // Mark it as active because we are using this thread. This is similar
+            // to comparing it with Processor::current_thread, but when there are
+            // multiple processors there's no easy way to check whether the thread
+            // is actually still needed. This prevents accidental finalization when
+            // a thread is no longer in Running state, but running on another core.
+
+            // We need to mark it active here so that this thread won't be
+            // scheduled on another core if it were to be queued before actually
+            // switching to it.
+            // FIXME: Figure out a better way maybe?
+            thread.set_active(true);
+            return &thread;
         }
-        return *Processor::idle_thread();
+        priority_mask &= ~(1u << priority);
+    }
+    return nullptr;
+}
+
+Thread& Scheduler::pull_next_runnable_thread()
+{
+    auto current_cpu = Processor::current_id();
+    auto affinity_mask = 1u << current_cpu;
+
+    // Fast path: pull from this processor's own queues.
+    auto* thread = ready_queues_for_cpu(current_cpu).with([&](auto& ready_queues) {
+        return pull_runnable_thread_from(ready_queues, affinity_mask);
     });
+    if (thread)
+        return *thread;
+
+    // Nothing local to run, try to steal work from another processor before
+    // falling back to the idle thread. We only take each victim's lock briefly,
+    // and a busy processor never has to wait on anyone else's queues.
+    auto processor_count = Processor::count();
+    for (u32 i = 1; i < processor_count; ++i) {
+        auto victim_cpu = (current_cpu + i) % processor_count;
+        thread = ready_queues_for_cpu(victim_cpu).with([&](auto& ready_queues) {
+            return pull_runnable_thread_from(ready_queues, affinity_mask);
+        });
+        if (thread)
+            return *thread;
+    }
+
+    return *Processor::idle_thread();
 }
 
 Thread* Scheduler::peek_next_runnable_thread()
 {
-    auto affinity_mask = 1u << Processor::current_id();
+    auto current_cpu = Processor::current_id();
+    auto affinity_mask = 1u << current_cpu;
 
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread* {
+    auto peek_runnable_thread_from = [&](ThreadReadyQueues& ready_queues) -> Thread* {
         auto priority_mask = ready_queues.mask;
         while (priority_mask != 0) {
             auto priority = __builtin_ffsl(priority_mask);
@@ -133,7 +183,20 @@ Thread* Scheduler::peek_next_runnable_thread()
         // the idle thread. We just want to see if we have any other thread ready
         // to be scheduled.
         return nullptr;
-    });
+    };
+
+    auto* thread = ready_queues_for_cpu(current_cpu).with(peek_runnable_thread_from);
+    if (thread)
+        return thread;
+
+    auto processor_count = Processor::count();
+    for (u32 i = 1; i < processor_count; ++i) {
+        auto victim_cpu = (current_cpu + i) % processor_count;
+        thread = ready_queues_for_cpu(victim_cpu).with(peek_runnable_thread_from);
+        if (thread)
+            return thread;
+    }
+    return nullptr;
 }
 
 bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
@@ -141,7 +204,9 @@ bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
     if (thread.is_idle_thread())
         return true;
 
-    return g_ready_queues->with([&](auto& ready_queues) {
+    // m_ready_queue_cpu can only change while the thread is not enqueued, and
+    // we hold the scheduler lock, so this reliably finds the owning queues.
+    return ready_queues_for_cpu(thread.m_ready_queue_cpu).with([&](auto& ready_queues) {
         auto priority = thread.m_runnable_priority;
         if (priority < 0) {
             VERIFY(!thread.m_ready_queue_node.is_in_list());
@@ -166,9 +231,18 @@ void Scheduler::enqueue_runnable_thread(Thread& thread)
     VERIFY(g_scheduler_lock.is_locked_by_current_processor());
     if (thread.is_idle_thread())
         return;
-    auto priority = thread_priority_to_priority_index(thread.priority());
-
-    g_ready_queues->with([&](auto& ready_queues) {
+    auto priority = thread_to_priority_index(thread);
+
+    // Prefer the current processor's queues so a thread that just ran here
+    // keeps its cache footprint, unless its affinity forbids it.
+    auto target_cpu = Processor::current_id();
+    auto affinity = thread.affinity();
+    VERIFY(affinity != 0);
+    if (!(affinity & (1u << target_cpu)))
+        target_cpu = __builtin_ffsl(affinity) - 1;
+
+    thread.m_ready_queue_cpu = target_cpu;
+    ready_queues_for_cpu(target_cpu).with([&](auto& ready_queues) {
         VERIFY(thread.m_runnable_priority < 0);
         thread.m_runnable_priority = (int)priority;
         VERIFY(!thread.m_ready_queue_node.is_in_list());
@@ -178,6 +252,14 @@ void Scheduler::enqueue_runnable_thread(Thread& thread)
         if (was_empty)
             ready_queues.mask |= (1u << priority);
     });
+
+    // If a realtime thread became runnable on this processor while a normal
+    // thread is running, ask for a reschedule as soon as possible.
+    if (thread.is_realtime() && target_cpu == Processor::current_id()) {
+        auto* current_thread = Thread::current();
+        if (current_thread && !current_thread->is_realtime())
+            Processor::current().invoke_scheduler_async();
+    }
 }
 
 UNMAP_AFTER_INIT void Scheduler::start()
@@ -73,10 +73,11 @@ private:
     ALWAYS_INLINE void power_on() const;
 
     void start_request(AsyncBlockDeviceRequest&);
-    void complete_current_request(AsyncDeviceRequest::RequestResult);
-    bool access_device(AsyncBlockDeviceRequest::RequestType, u64 lba, u8 block_count);
+    void complete_request_in_slot(size_t slot, AsyncDeviceRequest::RequestResult);
+    bool access_device(AsyncBlockDeviceRequest::RequestType, u64 lba, u8 block_count, size_t slot);
     size_t calculate_descriptors_count(size_t block_count) const;
-    [[nodiscard]] Optional<AsyncDeviceRequest::RequestResult> prepare_and_set_scatter_list(AsyncBlockDeviceRequest& request);
+    [[nodiscard]] Optional<AsyncDeviceRequest::RequestResult> prepare_and_set_scatter_list(AsyncBlockDeviceRequest& request, size_t slot);
+    Optional<size_t> find_free_command_slot() const;
 
     ALWAYS_INLINE bool is_interrupts_enabled() const;
 
@@ -100,10 +101,18 @@ private:
 
     ALWAYS_INLINE bool is_interface_disabled() const { return (m_port_registers.ssts & 0xf) == 4; };
 
+    size_t max_concurrent_requests() const { return m_has_ncq ? command_slots_count : 1; }
+
     // Data members
 
+    // How many command slots we use per port. The HBA may support up to 32,
+    // but each slot needs its own DMA buffer and command table page.
+    static constexpr size_t command_slots_count = 8;
+
     EntropySource m_entropy_source;
-    RefPtr<AsyncBlockDeviceRequest> m_current_request;
+    RefPtr<AsyncBlockDeviceRequest> m_slot_requests[command_slots_count];
+    RefPtr<Memory::ScatterGatherList> m_slot_scatter_lists[command_slots_count];
+    u32 m_issued_slots_mask { 0 };
     Spinlock m_hard_lock;
     Mutex m_lock { "AHCIPort" };
 
@@ -123,7 +132,7 @@ private:
     AHCI::PortInterruptStatusBitField m_interrupt_status;
     AHCI::PortInterruptEnableBitField m_interrupt_enable;
 
-    RefPtr<Memory::ScatterGatherList> m_current_scatter_list;
+    bool m_has_ncq { false };
     bool m_disabled_by_firmware { false };
 };
 }
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+namespace Kernel::NVMe {
+
+// Controller registers, mapped at the start of BAR0.
+struct [[gnu::packed]] ControllerRegisters {
+    u64 cap;    // Controller Capabilities
+    u32 vs;     // Version
+    u32 intms;  // Interrupt Mask Set
+    u32 intmc;  // Interrupt Mask Clear
+    u32 cc;     // Controller Configuration
+    u32 rsvd1;
+    u32 csts;   // Controller Status
+    u32 nssr;   // NVM Subsystem Reset
+    u32 aqa;    // Admin Queue Attributes
+    u64 asq;    // Admin Submission Queue Base Address
+    u64 acq;    // Admin Completion Queue Base Address
+};
+
+enum ControllerCapabilities : u64 {
+    CAP_DSTRD_MASK = 0xfull << 32,
+};
+
+static inline u32 doorbell_stride(u64 cap)
+{
+    return 4 << ((cap & CAP_DSTRD_MASK) >> 32);
+}
+
+enum ControllerConfiguration : u32 {
+    CC_EN = 1 << 0,
+    CC_IOSQES = 6 << 16, // 2^6 = 64 byte submission queue entries
+    CC_IOCQES = 4 << 20, // 2^4 = 16 byte completion queue entries
+};
+
+enum ControllerStatus : u32 {
+    CSTS_RDY = 1 << 0,
+    CSTS_CFS = 1 << 1,
+};
+
+struct [[gnu::packed]] Submission {
+    u8 op;
+    u8 flags;
+    u16 cmdid;
+    u32 nsid;
+    u64 rsvd;
+    u64 meta_ptr;
+    u64 data_ptr[2]; // PRP1 and PRP2
+    u32 cdw10;
+    u32 cdw11;
+    u32 cdw12;
+    u32 cdw13;
+    u32 cdw14;
+    u32 cdw15;
+};
+
+struct [[gnu::packed]] Completion {
+    u32 command_specific;
+    u32 rsvd;
+    u16 sq_head;
+    u16 sq_ident;
+    u16 command_id;
+    u16 status; // Bit 0 is the phase tag
+};
+
+enum AdminOpcode : u8 {
+    OP_ADMIN_CREATE_SUBMISSION_QUEUE = 0x01,
+    OP_ADMIN_CREATE_COMPLETION_QUEUE = 0x05,
+    OP_ADMIN_IDENTIFY = 0x06,
+};
+
+enum IOOpcode : u8 {
+    OP_IO_WRITE = 0x01,
+    OP_IO_READ = 0x02,
+};
+
+enum IdentifyCNS : u32 {
+    CNS_IDENTIFY_NAMESPACE = 0x00,
+    CNS_IDENTIFY_CONTROLLER = 0x01,
+    CNS_ACTIVE_NAMESPACE_LIST = 0x02,
+};
+
+enum QueueFlags : u32 {
+    QUEUE_PHYSICALLY_CONTIGUOUS = 1 << 0,
+    QUEUE_IRQ_ENABLED = 1 << 1,
+};
+
+}
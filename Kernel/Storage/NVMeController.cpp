@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Types.h>
+#include <Kernel/Bus/PCI/API.h>
+#include <Kernel/IO.h>
+#include <Kernel/Memory/MemoryManager.h>
+#include <Kernel/Sections.h>
+#include <Kernel/Storage/NVMeController.h>
+
+namespace Kernel {
+
+static Atomic<u32> s_controller_id;
+
+UNMAP_AFTER_INIT RefPtr<NVMeController> NVMeController::try_initialize(PCI::Address address)
+{
+    auto controller = adopt_ref(*new NVMeController(address));
+    if (auto result = controller->initialize(); result.is_error()) {
+        dmesgln("{}: NVMe controller initialization failed with error {}", address, result.error());
+        return {};
+    }
+    return controller;
+}
+
+UNMAP_AFTER_INIT NVMeController::NVMeController(PCI::Address address)
+    : StorageController()
+    , PCI::Device(address)
+    , m_controller_id(s_controller_id++)
+{
+}
+
+NVMeController::~NVMeController()
+{
+}
+
+volatile NVMe::ControllerRegisters& NVMeController::controller_registers() const
+{
+    return *reinterpret_cast<volatile NVMe::ControllerRegisters*>(m_registers_region->vaddr().as_ptr());
+}
+
+volatile u32* NVMeController::submission_queue_doorbell(u16 qid) const
+{
+    return reinterpret_cast<volatile u32*>(m_registers_region->vaddr().offset(0x1000 + (2 * qid) * m_doorbell_stride).as_ptr());
+}
+
+volatile u32* NVMeController::completion_queue_doorbell(u16 qid) const
+{
+    return reinterpret_cast<volatile u32*>(m_registers_region->vaddr().offset(0x1000 + (2 * qid + 1) * m_doorbell_stride).as_ptr());
+}
+
+bool NVMeController::wait_for_ready(bool ready)
+{
+    size_t retry = 0;
+    while ((controller_registers().csts & NVMe::CSTS_RDY) != (ready ? NVMe::CSTS_RDY : 0)) {
+        if (retry > 1000)
+            return false;
+        IO::delay(1000);
+        retry++;
+    }
+    return true;
+}
+
+UNMAP_AFTER_INIT KResult NVMeController::initialize()
+{
+    PCI::enable_interrupt_line(pci_address());
+    PCI::enable_bus_mastering(pci_address());
+
+    // BAR0 (together with BAR1 for the upper half on 64-bit BARs) holds the
+    // controller registers followed by the queue doorbells.
+    PhysicalAddress registers_paddr((static_cast<u64>(PCI::get_BAR1(pci_address())) << 32) | (PCI::get_BAR0(pci_address()) & 0xfffffff0));
+    size_t registers_size = Memory::page_round_up(PCI::get_BAR_space_size(pci_address(), 0));
+    m_registers_region = TRY(MM.allocate_kernel_region(registers_paddr, registers_size, "NVMe Registers", Memory::Region::Access::ReadWrite, Memory::Region::Cacheable::No));
+
+    m_doorbell_stride = NVMe::doorbell_stride(controller_registers().cap);
+
+    // Disable the controller before setting up the admin queue.
+    controller_registers().cc = controller_registers().cc & ~NVMe::CC_EN;
+    if (!wait_for_ready(false))
+        return EIO;
+
+    u8 irq = PCI::get_interrupt_line(pci_address());
+    TRY(create_admin_queue(irq));
+    TRY(create_io_queue(irq, 1));
+    TRY(identify_namespaces());
+    return KSuccess;
+}
+
+UNMAP_AFTER_INIT KResult NVMeController::create_admin_queue(u8 irq)
+{
+    m_admin_queue = TRY(NVMeQueue::try_create(0, irq, submission_queue_doorbell(0), completion_queue_doorbell(0)));
+
+    controller_registers().aqa = (NVMeQueue::queue_depth - 1) | ((NVMeQueue::queue_depth - 1) << 16);
+    controller_registers().asq = m_admin_queue->submission_queue_paddr().get();
+    controller_registers().acq = m_admin_queue->completion_queue_paddr().get();
+    full_memory_barrier();
+
+    controller_registers().cc = NVMe::CC_EN | NVMe::CC_IOSQES | NVMe::CC_IOCQES;
+    if (!wait_for_ready(true))
+        return EIO;
+
+    m_admin_queue->enable_irq();
+    return KSuccess;
+}
+
+UNMAP_AFTER_INIT KResult NVMeController::create_io_queue(u8 irq, u16 qid)
+{
+    auto queue = TRY(NVMeQueue::try_create(qid, irq, submission_queue_doorbell(qid), completion_queue_doorbell(qid)));
+
+    {
+        NVMe::Submission submission {};
+        submission.op = NVMe::OP_ADMIN_CREATE_COMPLETION_QUEUE;
+        submission.data_ptr[0] = queue->completion_queue_paddr().get();
+        submission.cdw10 = ((NVMeQueue::queue_depth - 1) << 16) | qid;
+        // Pin-based interrupts always use interrupt vector 0.
+        submission.cdw11 = NVMe::QUEUE_PHYSICALLY_CONTIGUOUS | NVMe::QUEUE_IRQ_ENABLED;
+        TRY(m_admin_queue->submit_sync_sqe(submission));
+    }
+    {
+        NVMe::Submission submission {};
+        submission.op = NVMe::OP_ADMIN_CREATE_SUBMISSION_QUEUE;
+        submission.data_ptr[0] = queue->submission_queue_paddr().get();
+        submission.cdw10 = ((NVMeQueue::queue_depth - 1) << 16) | qid;
+        submission.cdw11 = (qid << 16) | NVMe::QUEUE_PHYSICALLY_CONTIGUOUS;
+        TRY(m_admin_queue->submit_sync_sqe(submission));
+    }
+
+    queue->enable_irq();
+    m_io_queue = move(queue);
+    return KSuccess;
+}
+
+KResult NVMeController::identify(u32 cns, u32 nsid, PhysicalAddress buffer)
+{
+    NVMe::Submission submission {};
+    submission.op = NVMe::OP_ADMIN_IDENTIFY;
+    submission.nsid = nsid;
+    submission.cdw10 = cns;
+    submission.data_ptr[0] = buffer.get();
+    return m_admin_queue->submit_sync_sqe(submission);
+}
+
+UNMAP_AFTER_INIT KResult NVMeController::identify_namespaces()
+{
+    auto identify_page = MM.allocate_supervisor_physical_page();
+    if (!identify_page)
+        return ENOMEM;
+    auto identify_region = TRY(MM.allocate_kernel_region(identify_page->paddr(), PAGE_SIZE, "NVMe Identify", Memory::Region::Access::ReadWrite, Memory::Region::Cacheable::No));
+
+    TRY(identify(NVMe::CNS_ACTIVE_NAMESPACE_LIST, 0, identify_page->paddr()));
+    u32 active_namespaces[PAGE_SIZE / sizeof(u32)];
+    memcpy(active_namespaces, identify_region->vaddr().as_ptr(), PAGE_SIZE);
+
+    for (auto nsid : active_namespaces) {
+        if (nsid == 0)
+            continue;
+        TRY(identify(NVMe::CNS_IDENTIFY_NAMESPACE, nsid, identify_page->paddr()));
+        auto* namespace_data = identify_region->vaddr().as_ptr();
+
+        u64 max_addressable_block = 0;
+        memcpy(&max_addressable_block, namespace_data, sizeof(u64)); // NSZE
+        u8 format_index = namespace_data[26] & 0xf;                  // FLBAS
+        u32 lba_format = 0;
+        memcpy(&lba_format, namespace_data + 128 + 4 * format_index, sizeof(u32)); // LBAF
+        size_t sector_size = 1 << ((lba_format >> 16) & 0xff);                     // LBADS
+
+        dmesgln("{}: NVMe namespace {}: {} blocks of size {}", pci_address(), nsid, max_addressable_block, sector_size);
+        m_namespaces.append(NVMeNameSpace::create(*this, *m_io_queue, m_controller_id, nsid, sector_size, max_addressable_block));
+    }
+    return KSuccess;
+}
+
+RefPtr<StorageDevice> NVMeController::device(u32 index) const
+{
+    if (index >= m_namespaces.size())
+        return nullptr;
+    return m_namespaces[index];
+}
+
+size_t NVMeController::devices_count() const
+{
+    return m_namespaces.size();
+}
+
+bool NVMeController::reset()
+{
+    controller_registers().cc = controller_registers().cc & ~NVMe::CC_EN;
+    if (!wait_for_ready(false))
+        return false;
+    controller_registers().cc = controller_registers().cc | NVMe::CC_EN;
+    return wait_for_ready(true);
+}
+
+bool NVMeController::shutdown()
+{
+    TODO();
+}
+
+void NVMeController::start_request(const StorageDevice&, AsyncBlockDeviceRequest&)
+{
+    VERIFY_NOT_REACHED();
+}
+
+void NVMeController::complete_current_request(AsyncDeviceRequest::RequestResult)
+{
+    VERIFY_NOT_REACHED();
+}
+
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullRefPtrVector.h>
+#include <AK/OwnPtr.h>
+#include <AK/RefPtr.h>
+#include <AK/Types.h>
+#include <Kernel/Storage/NVMe.h>
+#include <Kernel/Storage/NVMeNameSpace.h>
+#include <Kernel/Storage/NVMeQueue.h>
+#include <Kernel/Storage/StorageController.h>
+
+namespace Kernel {
+
+class NVMeController final
+    : public StorageController
+    , public PCI::Device {
+    AK_MAKE_ETERNAL
+public:
+    static RefPtr<NVMeController> try_initialize(PCI::Address address);
+    virtual ~NVMeController() override;
+
+    virtual RefPtr<StorageDevice> device(u32 index) const override;
+    virtual bool reset() override;
+    virtual bool shutdown() override;
+    virtual size_t devices_count() const override;
+    virtual void start_request(const StorageDevice&, AsyncBlockDeviceRequest&) override;
+    virtual void complete_current_request(AsyncDeviceRequest::RequestResult) override;
+
+    NVMeQueue& io_queue() { return *m_io_queue; }
+
+private:
+    explicit NVMeController(PCI::Address address);
+    KResult initialize();
+
+    volatile NVMe::ControllerRegisters& controller_registers() const;
+    volatile u32* submission_queue_doorbell(u16 qid) const;
+    volatile u32* completion_queue_doorbell(u16 qid) const;
+
+    bool wait_for_ready(bool ready);
+    KResult create_admin_queue(u8 irq);
+    KResult create_io_queue(u8 irq, u16 qid);
+    KResult identify_namespaces();
+    KResult identify(u32 cns, u32 nsid, PhysicalAddress buffer);
+
+    OwnPtr<Memory::Region> m_registers_region;
+    u32 m_doorbell_stride { 4 };
+
+    RefPtr<NVMeQueue> m_admin_queue;
+    RefPtr<NVMeQueue> m_io_queue;
+    NonnullRefPtrVector<NVMeNameSpace> m_namespaces;
+    u32 m_controller_id { 0 };
+};
+
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringView.h>
+#include <Kernel/Storage/NVMeController.h>
+#include <Kernel/Storage/NVMeNameSpace.h>
+
+namespace Kernel {
+
+NonnullRefPtr<NVMeNameSpace> NVMeNameSpace::create(const NVMeController& controller, NonnullRefPtr<NVMeQueue> queue, u32 controller_id, u16 nsid, size_t sector_size, u64 max_addressable_block)
+{
+    return adopt_ref(*new NVMeNameSpace(controller, move(queue), controller_id, nsid, sector_size, max_addressable_block));
+}
+
+NVMeNameSpace::NVMeNameSpace(const NVMeController& controller, NonnullRefPtr<NVMeQueue> queue, u32 controller_id, u16 nsid, size_t sector_size, u64 max_addressable_block)
+    : StorageDevice(controller, sector_size, max_addressable_block)
+    , m_queue(move(queue))
+    , m_controller_id(controller_id)
+    , m_nsid(nsid)
+{
+}
+
+NVMeNameSpace::~NVMeNameSpace()
+{
+}
+
+StringView NVMeNameSpace::class_name() const
+{
+    return "NVMeNameSpace";
+}
+
+void NVMeNameSpace::start_request(AsyncBlockDeviceRequest& request)
+{
+    if (request.request_type() == AsyncBlockDeviceRequest::Read)
+        m_queue->read(request, m_nsid, request.block_index(), request.block_count());
+    else
+        m_queue->write(request, m_nsid, request.block_index(), request.block_count());
+}
+
+String NVMeNameSpace::storage_name() const
+{
+    return String::formatted("nvme{}n{}", m_controller_id, m_nsid);
+}
+
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullRefPtr.h>
+#include <Kernel/Storage/NVMeQueue.h>
+#include <Kernel/Storage/StorageDevice.h>
+
+namespace Kernel {
+
+class NVMeController;
+class NVMeNameSpace final : public StorageDevice {
+    friend class NVMeController;
+
+public:
+    static NonnullRefPtr<NVMeNameSpace> create(const NVMeController&, NonnullRefPtr<NVMeQueue>, u32 controller_id, u16 nsid, size_t sector_size, u64 max_addressable_block);
+    virtual ~NVMeNameSpace() override;
+
+    // ^StorageDevice
+    // ^BlockDevice
+    virtual void start_request(AsyncBlockDeviceRequest&) override;
+    virtual String storage_name() const override;
+
+private:
+    NVMeNameSpace(const NVMeController&, NonnullRefPtr<NVMeQueue>, u32 controller_id, u16 nsid, size_t sector_size, u64 max_addressable_block);
+
+    // ^DiskDevice
+    virtual StringView class_name() const override;
+
+    NonnullRefPtr<NVMeQueue> m_queue;
+    u32 m_controller_id { 0 };
+    u16 m_nsid { 0 };
+};
+
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/IO.h>
+#include <Kernel/Memory/MemoryManager.h>
+#include <Kernel/Storage/NVMeQueue.h>
+#include <Kernel/WorkQueue.h>
+
+namespace Kernel {
+
+KResultOr<NonnullRefPtr<NVMeQueue>> NVMeQueue::try_create(u16 qid, u8 irq, volatile u32* sq_doorbell, volatile u32* cq_doorbell)
+{
+    auto sq_page = MM.allocate_supervisor_physical_page();
+    auto cq_page = MM.allocate_supervisor_physical_page();
+    auto rw_dma_page = MM.allocate_supervisor_physical_page();
+    if (!sq_page || !cq_page || !rw_dma_page)
+        return ENOMEM;
+
+    auto sq_region = TRY(MM.allocate_kernel_region(sq_page->paddr(), PAGE_SIZE, "NVMe Submission Queue", Memory::Region::Access::ReadWrite, Memory::Region::Cacheable::No));
+    auto cq_region = TRY(MM.allocate_kernel_region(cq_page->paddr(), PAGE_SIZE, "NVMe Completion Queue", Memory::Region::Access::ReadWrite, Memory::Region::Cacheable::No));
+    auto rw_dma_region = TRY(MM.allocate_kernel_region(rw_dma_page->paddr(), PAGE_SIZE, "NVMe RW DMA", Memory::Region::Access::ReadWrite, Memory::Region::Cacheable::No));
+
+    // A command the controller hasn't consumed yet has its phase bit cleared,
+    // so start out with a fully zeroed completion ring.
+    memset(sq_region->vaddr().as_ptr(), 0, PAGE_SIZE);
+    memset(cq_region->vaddr().as_ptr(), 0, PAGE_SIZE);
+
+    return adopt_ref(*new NVMeQueue(qid, irq, sq_page.release_nonnull(), move(sq_region), cq_page.release_nonnull(), move(cq_region), rw_dma_page.release_nonnull(), move(rw_dma_region), sq_doorbell, cq_doorbell));
+}
+
+NVMeQueue::NVMeQueue(u16 qid, u8 irq, NonnullRefPtr<Memory::PhysicalPage> sq_page, NonnullOwnPtr<Memory::Region> sq_region, NonnullRefPtr<Memory::PhysicalPage> cq_page, NonnullOwnPtr<Memory::Region> cq_region, NonnullRefPtr<Memory::PhysicalPage> rw_dma_page, NonnullOwnPtr<Memory::Region> rw_dma_region, volatile u32* sq_doorbell, volatile u32* cq_doorbell)
+    : IRQHandler(irq)
+    , m_qid(qid)
+    , m_sq_page(move(sq_page))
+    , m_sq_region(move(sq_region))
+    , m_cq_page(move(cq_page))
+    , m_cq_region(move(cq_region))
+    , m_rw_dma_page(move(rw_dma_page))
+    , m_rw_dma_region(move(rw_dma_region))
+    , m_sq_doorbell(sq_doorbell)
+    , m_cq_doorbell(cq_doorbell)
+{
+}
+
+NVMeQueue::~NVMeQueue()
+{
+}
+
+void NVMeQueue::submit_sqe(NVMe::Submission& submission)
+{
+    SpinlockLocker locker(m_sq_lock);
+    submission.cmdid = m_next_command_id++;
+    memcpy(const_cast<NVMe::Submission*>(&submission_queue()[m_sq_tail]), &submission, sizeof(NVMe::Submission));
+    m_sq_tail = (m_sq_tail + 1) % queue_depth;
+    full_memory_barrier();
+    *m_sq_doorbell = m_sq_tail;
+}
+
+KResult NVMeQueue::submit_sync_sqe(NVMe::Submission& submission)
+{
+    VERIFY(!m_admin_request_pending);
+    m_admin_request_pending = true;
+    submit_sqe(submission);
+
+    // Poll for completion instead of sleeping, since this path is only used
+    // for admin commands at boot time. The interrupt handler may consume the
+    // completion before we do; both paths clear m_admin_request_pending.
+    size_t retries = 0;
+    while (m_admin_request_pending) {
+        if (retries++ > 100000) {
+            m_admin_request_pending = false;
+            return EIO;
+        }
+        {
+            SpinlockLocker locker(m_cq_lock);
+            process_completions();
+        }
+        IO::delay(10);
+    }
+    if (m_admin_request_status != 0)
+        return EIO;
+    return KSuccess;
+}
+
+void NVMeQueue::read(AsyncBlockDeviceRequest& request, u16 nsid, u64 lba, u32 count)
+{
+    MutexLocker locker(m_request_lock);
+    VERIFY(!m_current_request);
+    m_current_request = request;
+
+    NVMe::Submission submission {};
+    submission.op = NVMe::OP_IO_READ;
+    submission.nsid = nsid;
+    submission.cdw10 = lba & 0xffffffff;
+    submission.cdw11 = lba >> 32;
+    submission.cdw12 = count - 1; // NLB is zero-based
+    submission.data_ptr[0] = m_rw_dma_page->paddr().get();
+    submit_sqe(submission);
+}
+
+void NVMeQueue::write(AsyncBlockDeviceRequest& request, u16 nsid, u64 lba, u32 count)
+{
+    MutexLocker locker(m_request_lock);
+    VERIFY(!m_current_request);
+    m_current_request = request;
+
+    if (auto result = request.read_from_buffer(request.buffer(), m_rw_dma_region->vaddr().as_ptr(), request.buffer_size()); result.is_error()) {
+        m_current_request.clear();
+        locker.unlock();
+        request.complete(AsyncDeviceRequest::MemoryFault);
+        return;
+    }
+
+    NVMe::Submission submission {};
+    submission.op = NVMe::OP_IO_WRITE;
+    submission.nsid = nsid;
+    submission.cdw10 = lba & 0xffffffff;
+    submission.cdw11 = lba >> 32;
+    submission.cdw12 = count - 1; // NLB is zero-based
+    submission.data_ptr[0] = m_rw_dma_page->paddr().get();
+    submit_sqe(submission);
+}
+
+u32 NVMeQueue::process_completions()
+{
+    u32 completed = 0;
+    while ((completion_queue()[m_cq_head].status & 1) == m_phase) {
+        u16 status = (completion_queue()[m_cq_head].status >> 1) & 0x7fff;
+        completed++;
+
+        if (m_qid == 0) {
+            m_admin_request_status = status;
+            m_admin_request_pending = false;
+        } else {
+            complete_current_request(status);
+        }
+
+        m_cq_head++;
+        if (m_cq_head == queue_depth) {
+            m_cq_head = 0;
+            m_phase ^= 1;
+        }
+    }
+    if (completed > 0) {
+        full_memory_barrier();
+        *m_cq_doorbell = m_cq_head;
+    }
+    return completed;
+}
+
+bool NVMeQueue::handle_irq(const RegisterState&)
+{
+    SpinlockLocker locker(m_cq_lock);
+    return process_completions() > 0;
+}
+
+void NVMeQueue::complete_current_request(u16 status)
+{
+    // Defer touching the request buffer to a kernel thread, since copying to
+    // it could fault just like in the other storage drivers.
+    g_io_work->queue([this, status]() {
+        MutexLocker locker(m_request_lock);
+        VERIFY(m_current_request);
+        auto current_request = m_current_request;
+        m_current_request.clear();
+        if (status != 0) {
+            locker.unlock();
+            current_request->complete(AsyncDeviceRequest::Failure);
+            return;
+        }
+        if (current_request->request_type() == AsyncBlockDeviceRequest::Read) {
+            if (auto result = current_request->write_to_buffer(current_request->buffer(), m_rw_dma_region->vaddr().as_ptr(), current_request->buffer_size()); result.is_error()) {
+                locker.unlock();
+                current_request->complete(AsyncDeviceRequest::MemoryFault);
+                return;
+            }
+        }
+        locker.unlock();
+        current_request->complete(AsyncDeviceRequest::Success);
+    });
+}
+
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/OwnPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
+#include <AK/Types.h>
+#include <Kernel/Devices/BlockDevice.h>
+#include <Kernel/Interrupts/IRQHandler.h>
+#include <Kernel/Locking/Mutex.h>
+#include <Kernel/Locking/Spinlock.h>
+#include <Kernel/Memory/PhysicalPage.h>
+#include <Kernel/Memory/Region.h>
+#include <Kernel/PhysicalAddress.h>
+#include <Kernel/Storage/NVMe.h>
+
+namespace Kernel {
+
+class AsyncBlockDeviceRequest;
+
+class NVMeQueue final
+    : public RefCounted<NVMeQueue>
+    , public IRQHandler {
+public:
+    static KResultOr<NonnullRefPtr<NVMeQueue>> try_create(u16 qid, u8 irq, volatile u32* sq_doorbell, volatile u32* cq_doorbell);
+    virtual ~NVMeQueue() override;
+
+    PhysicalAddress submission_queue_paddr() const { return m_sq_page->paddr(); }
+    PhysicalAddress completion_queue_paddr() const { return m_cq_page->paddr(); }
+
+    // Both rings are one page, so the queue depth is dictated by the
+    // submission entry size (the completion ring is shallower than a page).
+    static constexpr u16 queue_depth = PAGE_SIZE / sizeof(NVMe::Submission);
+
+    void submit_sqe(NVMe::Submission&);
+    KResult submit_sync_sqe(NVMe::Submission&);
+
+    void read(AsyncBlockDeviceRequest&, u16 nsid, u64 lba, u32 count);
+    void write(AsyncBlockDeviceRequest&, u16 nsid, u64 lba, u32 count);
+
+    // ^IRQHandler
+    virtual StringView purpose() const override { return "NVMe Queue"; }
+    virtual bool handle_irq(const RegisterState&) override;
+
+private:
+    NVMeQueue(u16 qid, u8 irq, NonnullRefPtr<Memory::PhysicalPage> sq_page, NonnullOwnPtr<Memory::Region> sq_region, NonnullRefPtr<Memory::PhysicalPage> cq_page, NonnullOwnPtr<Memory::Region> cq_region, NonnullRefPtr<Memory::PhysicalPage> rw_dma_page, NonnullOwnPtr<Memory::Region> rw_dma_region, volatile u32* sq_doorbell, volatile u32* cq_doorbell);
+
+    u32 process_completions();
+    void complete_current_request(u16 status);
+
+    volatile NVMe::Submission* submission_queue() { return reinterpret_cast<volatile NVMe::Submission*>(m_sq_region->vaddr().as_ptr()); }
+    volatile NVMe::Completion* completion_queue() { return reinterpret_cast<volatile NVMe::Completion*>(m_cq_region->vaddr().as_ptr()); }
+
+    u16 m_qid { 0 };
+    u16 m_sq_tail { 0 };
+    u16 m_cq_head { 0 };
+    u8 m_phase { 1 };
+    u16 m_next_command_id { 0 };
+
+    Spinlock m_sq_lock;
+    Spinlock m_cq_lock;
+
+    NonnullRefPtr<Memory::PhysicalPage> m_sq_page;
+    NonnullOwnPtr<Memory::Region> m_sq_region;
+    NonnullRefPtr<Memory::PhysicalPage> m_cq_page;
+    NonnullOwnPtr<Memory::Region> m_cq_region;
+
+    // Bounce buffer for data transfers, one page just like the other
+    // storage drivers (requests are capped to a page by StorageDevice).
+    NonnullRefPtr<Memory::PhysicalPage> m_rw_dma_page;
+    NonnullOwnPtr<Memory::Region> m_rw_dma_region;
+
+    volatile u32* m_sq_doorbell { nullptr };
+    volatile u32* m_cq_doorbell { nullptr };
+
+    // Only one request is in flight per queue for now.
+    Mutex m_request_lock;
+    RefPtr<AsyncBlockDeviceRequest> m_current_request;
+
+    // For synchronous (admin) commands, polled for completion.
+    Atomic<bool> m_admin_request_pending { false };
+    Atomic<u16> m_admin_request_status { 0 };
+};
+
+}
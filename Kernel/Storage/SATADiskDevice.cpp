@@ -37,6 +37,13 @@ void SATADiskDevice::start_request(AsyncBlockDeviceRequest& request)
     m_port.strong_ref()->start_request(request);
 }
 
+size_t SATADiskDevice::max_parallel_requests() const
+{
+    if (auto port = m_port.strong_ref())
+        return port->max_concurrent_requests();
+    return 1;
+}
+
 String SATADiskDevice::storage_name() const
 {
     return String::formatted("hd{:c}", 'a' + minor());
@@ -12,10 +12,12 @@
 #include <Kernel/Devices/BlockDevice.h>
 #include <Kernel/FileSystem/Ext2FileSystem.h>
 #include <Kernel/Panic.h>
+#include <Kernel/Process.h>
 #include <Kernel/Storage/AHCIController.h>
 #include <Kernel/Storage/IDEController.h>
 #include <Kernel/Storage/Partition/EBRPartitionTable.h>
 #include <Kernel/Storage/Partition/GUIDPartitionTable.h>
+#include <Kernel/Storage/NVMeController.h>
 #include <Kernel/Storage/Partition/MBRPartitionTable.h>
 #include <Kernel/Storage/RamdiskController.h>
 #include <Kernel/Storage/StorageManagement.h>
@@ -39,23 +41,99 @@ bool StorageManagement::boot_argument_contains_partition_uuid()
     return m_boot_argument.starts_with("PARTUUID=");
 }
 
-UNMAP_AFTER_INIT void StorageManagement::enumerate_controllers(bool force_pio)
+struct StorageManagement::ControllerProbeJob {
+    enum class Type {
+        IDE,
+        AHCI,
+        NVMe,
+    };
+
+    size_t slot { 0 };
+    Type type { Type::IDE };
+    PCI::Address address;
+    bool force_pio { false };
+};
+
+UNMAP_AFTER_INIT void StorageManagement::controller_probe_worker(void* data)
 {
+    auto* job = reinterpret_cast<ControllerProbeJob*>(data);
+    auto& self = the();
+
+    RefPtr<StorageController> controller;
+    switch (job->type) {
+    case ControllerProbeJob::Type::IDE:
+        controller = IDEController::initialize(job->address, job->force_pio);
+        break;
+    case ControllerProbeJob::Type::AHCI:
+        controller = AHCIController::initialize(job->address);
+        break;
+    case ControllerProbeJob::Type::NVMe:
+        controller = NVMeController::try_initialize(job->address);
+        break;
+    }
+
+    self.m_probed_controllers[job->slot] = move(controller);
+    delete job;
+
+    if (self.m_probe_jobs_remaining.fetch_sub(1, AK::memory_order_acq_rel) == 1)
+        self.m_probe_wait_queue.wake_all();
+
+    Process::current().sys$exit(0);
+    VERIFY_NOT_REACHED();
+}
+
+UNMAP_AFTER_INIT void StorageManagement::begin_controller_probing(bool force_pio)
+{
+    VERIFY(!m_probing_begun);
     VERIFY(m_controllers.is_empty());
-    if (!kernel_command_line().disable_physical_storage()) {
-        if (kernel_command_line().is_ide_enabled()) {
-            PCI::enumerate([&](const PCI::Address& address, PCI::ID) {
-                if (PCI::get_class(address) == PCI_MASS_STORAGE_CLASS_ID && PCI::get_subclass(address) == PCI_IDE_CTRL_SUBCLASS_ID) {
-                    m_controllers.append(IDEController::initialize(address, force_pio));
-                }
-            });
-        }
+    m_probing_begun = true;
+
+    if (kernel_command_line().disable_physical_storage())
+        return;
+
+    Vector<ControllerProbeJob> jobs;
+    if (kernel_command_line().is_ide_enabled()) {
         PCI::enumerate([&](const PCI::Address& address, PCI::ID) {
-            if (PCI::get_class(address) == PCI_MASS_STORAGE_CLASS_ID && PCI::get_subclass(address) == PCI_SATA_CTRL_SUBCLASS_ID && PCI::get_programming_interface(address) == PCI_AHCI_IF_PROGIF) {
-                m_controllers.append(AHCIController::initialize(address));
-            }
+            if (PCI::get_class(address) == PCI_MASS_STORAGE_CLASS_ID && PCI::get_subclass(address) == PCI_IDE_CTRL_SUBCLASS_ID)
+                jobs.append({ jobs.size(), ControllerProbeJob::Type::IDE, address, force_pio });
         });
     }
+    PCI::enumerate([&](const PCI::Address& address, PCI::ID) {
+        if (PCI::get_class(address) == PCI_MASS_STORAGE_CLASS_ID && PCI::get_subclass(address) == PCI_SATA_CTRL_SUBCLASS_ID && PCI::get_programming_interface(address) == PCI_AHCI_IF_PROGIF)
+            jobs.append({ jobs.size(), ControllerProbeJob::Type::AHCI, address, force_pio });
+    });
+    PCI::enumerate([&](const PCI::Address& address, PCI::ID) {
+        if (PCI::get_class(address) == PCI_MASS_STORAGE_CLASS_ID && PCI::get_subclass(address) == PCI_NVME_CTRL_SUBCLASS_ID && PCI::get_programming_interface(address) == PCI_NVME_IF_PROGIF)
+            jobs.append({ jobs.size(), ControllerProbeJob::Type::NVMe, address, force_pio });
+    });
+
+    if (jobs.is_empty())
+        return;
+
+    m_probed_controllers.resize(jobs.size());
+    m_probe_jobs_remaining.store(jobs.size(), AK::memory_order_release);
+
+    // One worker process per controller: each probe mostly waits on hardware
+    // (port spin-up, resets), so total probe time is bounded by the slowest
+    // controller instead of the sum of all of them.
+    for (auto& job : jobs) {
+        auto* heap_job = new ControllerProbeJob(job);
+        RefPtr<Thread> worker_thread;
+        (void)Process::create_kernel_process(worker_thread, KString::must_create(String::formatted("StorageProbe[{}]", heap_job->slot)), controller_probe_worker, heap_job);
+    }
+}
+
+UNMAP_AFTER_INIT void StorageManagement::wait_for_controller_probing()
+{
+    VERIFY(m_probing_begun);
+    while (m_probe_jobs_remaining.load(AK::memory_order_acquire) > 0)
+        m_probe_wait_queue.wait_forever("StorageManagement");
+
+    for (auto& controller : m_probed_controllers) {
+        if (controller)
+            m_controllers.append(controller.release_nonnull());
+    }
+    m_probed_controllers.clear();
     m_controllers.append(RamdiskController::initialize());
 }
 
@@ -190,7 +268,9 @@ UNMAP_AFTER_INIT void StorageManagement::initialize(String root_device, bool for
 {
     VERIFY(s_device_minor_number == 0);
     m_boot_argument = root_device;
-    enumerate_controllers(force_pio);
+    if (!m_probing_begun)
+        begin_controller_probing(force_pio);
+    wait_for_controller_probing();
     enumerate_storage_devices();
     enumerate_disk_partitions();
     if (!boot_argument_contains_partition_uuid()) {
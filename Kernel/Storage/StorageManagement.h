@@ -6,14 +6,17 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/IntrusiveList.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/Types.h>
+#include <AK/Vector.h>
 #include <Kernel/FileSystem/FileSystem.h>
 #include <Kernel/Storage/Partition/DiskPartition.h>
 #include <Kernel/Storage/StorageController.h>
 #include <Kernel/Storage/StorageDevice.h>
+#include <Kernel/WaitQueue.h>
 
 namespace Kernel {
 
@@ -24,6 +27,10 @@ class StorageManagement {
 public:
     StorageManagement();
     static bool initialized();
+    // Kicks off controller probing on worker kernel processes and returns
+    // immediately; initialize() gathers the results. Calling this early lets
+    // the hardware spin-up waits overlap with the rest of kernel init.
+    void begin_controller_probing(bool force_pio);
     void initialize(String boot_argument, bool force_pio);
     static StorageManagement& the();
 
@@ -35,9 +42,12 @@ public:
     void remove_device(StorageDevice&);
 
 private:
+    struct ControllerProbeJob;
+
     bool boot_argument_contains_partition_uuid();
 
-    void enumerate_controllers(bool force_pio);
+    static void controller_probe_worker(void*);
+    void wait_for_controller_probing();
     void enumerate_storage_devices();
     void enumerate_disk_partitions() const;
 
@@ -51,6 +61,12 @@ private:
     String m_boot_argument;
     WeakPtr<BlockDevice> m_boot_block_device;
     NonnullRefPtrVector<StorageController> m_controllers;
+    // Probe results land in fixed slots so device names stay stable no
+    // matter which worker finishes first.
+    Vector<RefPtr<StorageController>> m_probed_controllers;
+    Atomic<size_t> m_probe_jobs_remaining { 0 };
+    WaitQueue m_probe_wait_queue;
+    bool m_probing_begun { false };
     IntrusiveList<StorageDevice, RefPtr<StorageDevice>, &StorageDevice::m_list_node> m_storage_devices;
 };
 
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/EventQueue.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Process.h>
+
+namespace Kernel {
+
+KResultOr<FlatPtr> Process::sys$event_queue_create(u32 flags)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    REQUIRE_PROMISE(stdio);
+
+    if (flags & ~static_cast<u32>(EventQueueFlags::CloseOnExec))
+        return EINVAL;
+
+    auto fd_allocation = TRY(m_fds.allocate());
+    auto queue = TRY(EventQueue::try_create());
+    auto description = TRY(OpenFileDescription::try_create(move(queue)));
+
+    description->set_readable(true);
+
+    m_fds[fd_allocation.fd].set(move(description));
+
+    if (flags & static_cast<u32>(EventQueueFlags::CloseOnExec))
+        m_fds[fd_allocation.fd].set_flags(m_fds[fd_allocation.fd].flags() | FD_CLOEXEC);
+
+    return fd_allocation.fd;
+}
+
+KResultOr<FlatPtr> Process::sys$event_queue_ctl(Userspace<const Syscall::SC_event_queue_ctl_params*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    REQUIRE_PROMISE(stdio);
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    auto description = TRY(fds().open_file_description(params.queue_fd));
+    if (!description->is_event_queue())
+        return EBADF;
+    auto event_queue = description->event_queue();
+
+    switch (static_cast<EventQueueCtlOp>(params.op)) {
+    case EventQueueCtlOp::Add: {
+        auto target = TRY(fds().open_file_description(params.fd));
+        return event_queue->register_description(params.fd, move(target), params.events);
+    }
+    case EventQueueCtlOp::Modify:
+        return event_queue->modify_registration(params.fd, params.events);
+    case EventQueueCtlOp::Remove:
+        // Note: Removal works even after the registered descriptor has been
+        // closed, since the queue keys registrations by descriptor number.
+        return event_queue->unregister_description(params.fd);
+    default:
+        return EINVAL;
+    }
+}
+
+KResultOr<FlatPtr> Process::sys$event_queue_wait(Userspace<const Syscall::SC_event_queue_wait_params*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    REQUIRE_PROMISE(stdio);
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    auto description = TRY(fds().open_file_description(params.queue_fd));
+    if (!description->is_event_queue())
+        return EBADF;
+    auto event_queue = description->event_queue();
+
+    Thread::BlockTimeout timeout;
+    if (params.timeout) {
+        auto timeout_time = TRY(copy_time_from_user(params.timeout));
+        timeout = Thread::BlockTimeout(false, &timeout_time);
+    }
+
+    return TRY(event_queue->wait(Userspace<EventQueueEvent*>((FlatPtr)params.events), params.max_events, timeout));
+}
+
+}
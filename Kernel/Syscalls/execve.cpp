@@ -513,6 +513,10 @@ KResult Process::do_exec(NonnullRefPtr<OpenFileDescription> main_program_descrip
     }
     Memory::MemoryManager::enter_address_space(*m_space);
 
+    // We now have our own address space, so a vfork() parent waiting on us
+    // can safely resume.
+    unblock_vfork_parent();
+
     m_executable = main_program_description->custody();
     m_arguments = arguments;
     m_environment = environment;
@@ -43,6 +43,18 @@ KResultOr<FlatPtr> Process::sys$fcntl(int fd, int cmd, u32 arg)
         return description->get_flock(Userspace<flock*>(arg));
     case F_SETLK:
         return description->apply_flock(Process::current(), Userspace<const flock*>(arg));
+    case F_GETPIPE_SZ: {
+        if (!description->is_fifo())
+            return EBADF;
+        return description->fifo()->buffer_capacity();
+    }
+    case F_SETPIPE_SZ: {
+        if (!description->is_fifo())
+            return EBADF;
+        auto* fifo = description->fifo();
+        TRY(fifo->try_set_buffer_capacity(arg));
+        return fifo->buffer_capacity();
+    }
     default:
         return EINVAL;
     }
@@ -14,6 +14,16 @@
 namespace Kernel {
 
 KResultOr<FlatPtr> Process::sys$fork(RegisterState& regs)
+{
+    return do_fork(regs, false);
+}
+
+KResultOr<FlatPtr> Process::sys$vfork(RegisterState& regs)
+{
+    return do_fork(regs, true);
+}
+
+KResultOr<FlatPtr> Process::do_fork(RegisterState& regs, bool share_memory_with_parent)
 {
     VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
     REQUIRE_PROMISE(proc);
@@ -94,7 +104,10 @@ KResultOr<FlatPtr> Process::sys$fork(RegisterState& regs)
         SpinlockLocker lock(address_space().get_lock());
         for (auto& region : address_space().regions()) {
             dbgln_if(FORK_DEBUG, "fork: cloning Region({}) '{}' @ {}", region, region->name(), region->vaddr());
-            auto region_clone = TRY(region->try_clone());
+            // For vfork(), skip the expensive CoW setup and just map the
+            // parent's VMObjects into the child. This is safe because we'll
+            // keep the parent blocked until the child execs or exits.
+            auto region_clone = share_memory_with_parent ? TRY(region->try_clone_sharing_memory()) : TRY(region->try_clone());
             auto* child_region = TRY(child->address_space().add_region(move(region_clone)));
             TRY(child_region->map(child->address_space().page_directory(), Memory::ShouldFlushTLB::No));
 
@@ -103,18 +116,33 @@ KResultOr<FlatPtr> Process::sys$fork(RegisterState& regs)
         }
     }
 
+    RefPtr<Process> vfork_child;
+    if (share_memory_with_parent) {
+        child->m_vfork_parent = this;
+        vfork_child = child.ptr();
+    }
+
     Process::register_new(*child);
 
     PerformanceManager::add_process_created_event(*child);
 
-    SpinlockLocker lock(g_scheduler_lock);
-    child_first_thread->set_affinity(Thread::current()->affinity());
-    child_first_thread->set_state(Thread::State::Runnable);
-
     auto child_pid = child->pid().value();
 
-    // NOTE: All user processes have a leaked ref on them. It's balanced by Thread::WaitBlockerSet::finalize().
-    (void)child.leak_ref();
+    {
+        SpinlockLocker lock(g_scheduler_lock);
+        child_first_thread->set_affinity(Thread::current()->affinity());
+        child_first_thread->set_state(Thread::State::Runnable);
+
+        // NOTE: All user processes have a leaked ref on them. It's balanced by Thread::WaitBlockerSet::finalize().
+        (void)child.leak_ref();
+    }
+
+    if (share_memory_with_parent) {
+        // Block until the child has stopped borrowing our address space.
+        // The completion flag makes this robust against spurious wakeups.
+        while (!vfork_child->m_vfork_completed.load(AK::MemoryOrder::memory_order_acquire))
+            m_vfork_wait_queue.wait_forever("vfork");
+    }
 
     return child_pid;
 }
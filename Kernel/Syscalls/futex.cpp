@@ -13,13 +13,15 @@ namespace Kernel {
 
 void Process::clear_futex_queues_on_exec()
 {
-    SpinlockLocker lock(m_futex_lock);
-    for (auto& it : m_futex_queues) {
-        bool did_wake_all;
-        it.value->wake_all(did_wake_all);
-        VERIFY(did_wake_all); // No one should be left behind...
+    for (auto& shard : m_futex_shards) {
+        SpinlockLocker lock(shard.lock);
+        for (auto& it : shard.queues) {
+            bool did_wake_all;
+            it.value->wake_all(did_wake_all);
+            VERIFY(did_wake_all); // No one should be left behind...
+        }
+        shard.queues.clear();
     }
-    m_futex_queues.clear();
 }
 
 KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*> user_params)
@@ -56,26 +58,25 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
     }
     }
 
-    auto find_futex_queue = [&](FlatPtr user_address, bool create_if_not_found, bool* did_create = nullptr) -> RefPtr<FutexQueue> {
+    auto find_futex_queue = [&](FutexShard& shard, FlatPtr user_address, bool create_if_not_found, bool* did_create = nullptr) -> RefPtr<FutexQueue> {
         VERIFY(!create_if_not_found || did_create != nullptr);
-        auto* queues = &m_futex_queues;
-        auto it = m_futex_queues.find(user_address);
-        if (it != m_futex_queues.end())
+        auto it = shard.queues.find(user_address);
+        if (it != shard.queues.end())
             return it->value;
         if (create_if_not_found) {
             *did_create = true;
             auto futex_queue = adopt_ref(*new FutexQueue);
-            auto result = queues->set(user_address, futex_queue);
+            auto result = shard.queues.set(user_address, futex_queue);
             VERIFY(result == AK::HashSetResult::InsertedNewEntry);
             return futex_queue;
         }
         return {};
     };
 
-    auto remove_futex_queue = [&](FlatPtr user_address) {
-        if (auto it = m_futex_queues.find(user_address); it != m_futex_queues.end()) {
+    auto remove_futex_queue = [&](FutexShard& shard, FlatPtr user_address) {
+        if (auto it = shard.queues.find(user_address); it != shard.queues.end()) {
             if (it->value->try_remove()) {
-                m_futex_queues.remove(it);
+                shard.queues.remove(it);
             }
         }
     };
@@ -83,15 +84,16 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
     auto do_wake = [&](FlatPtr user_address, u32 count, Optional<u32> bitmask) -> int {
         if (count == 0)
             return 0;
-        SpinlockLocker locker(m_futex_lock);
-        auto futex_queue = find_futex_queue(user_address, false);
+        auto& shard = futex_shard_for(user_address);
+        SpinlockLocker locker(shard.lock);
+        auto futex_queue = find_futex_queue(shard, user_address, false);
         if (!futex_queue)
             return 0;
         bool is_empty;
         u32 woke_count = futex_queue->wake_n(count, bitmask, is_empty);
         if (is_empty) {
             // If there are no more waiters, we want to get rid of the futex!
-            remove_futex_queue(user_address);
+            remove_futex_queue(shard, user_address);
         }
         return (int)woke_count;
     };
@@ -100,6 +102,27 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
     auto user_address2 = FlatPtr(params.userspace_address2);
 
     auto do_wait = [&](u32 bitset) -> int {
+        // Under light contention the futex word is usually released again
+        // within a few hundred cycles by a holder running on another core,
+        // so briefly spin on it before paying for queueing and an eventual
+        // context switch. On a uniprocessor spinning can only waste the
+        // holder's remaining time slice, so don't bother.
+        if (Processor::count() > 1) {
+            constexpr u32 adaptive_spin_count = 128;
+            for (u32 i = 0; i < adaptive_spin_count; ++i) {
+                auto user_value = user_atomic_load_relaxed(params.userspace_address);
+                if (!user_value.has_value())
+                    return EFAULT;
+                if (user_value.value() != params.val) {
+                    atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
+                    dbgln_if(FUTEX_DEBUG, "futex wait: EAGAIN (spin). user value: {:p} @ {:p} != val: {}", user_value.value(), params.userspace_address, params.val);
+                    return EAGAIN;
+                }
+                Processor::wait_check();
+            }
+        }
+
+        auto& shard = futex_shard_for(user_address);
         bool did_create;
         RefPtr<FutexQueue> futex_queue;
         do {
@@ -112,9 +135,9 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
             }
             atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
 
-            SpinlockLocker locker(m_futex_lock);
+            SpinlockLocker locker(shard.lock);
             did_create = false;
-            futex_queue = find_futex_queue(user_address, true, &did_create);
+            futex_queue = find_futex_queue(shard, user_address, true, &did_create);
             VERIFY(futex_queue);
             // We need to try again if we didn't create this queue and the existing queue
             // was removed before we were able to queue an imminent wait.
@@ -125,10 +148,10 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
 
         Thread::BlockResult block_result = futex_queue->wait_on(timeout, bitset);
 
-        SpinlockLocker locker(m_futex_lock);
+        SpinlockLocker locker(shard.lock);
         if (futex_queue->is_empty_and_no_imminent_waits()) {
             // If there are no more waiters, we want to get rid of the futex!
-            remove_futex_queue(user_address);
+            remove_futex_queue(shard, user_address);
         }
         if (block_result == Thread::BlockResult::InterruptedByTimeout) {
             return ETIMEDOUT;
@@ -144,9 +167,22 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
             return EAGAIN;
         atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
 
+        auto& shard = futex_shard_for(user_address);
+        auto& target_shard = futex_shard_for(user_address2);
+
+        // Lock both shards in a stable order so we can't deadlock against a
+        // concurrent requeue going in the opposite direction.
+        auto* first_shard = &shard;
+        auto* second_shard = &target_shard;
+        if (first_shard > second_shard)
+            swap(first_shard, second_shard);
+        SpinlockLocker first_locker(first_shard->lock);
+        Optional<SpinlockLocker<Spinlock>> second_locker;
+        if (second_shard != first_shard)
+            second_locker.emplace(second_shard->lock);
+
         int woken_or_requeued = 0;
-        SpinlockLocker locker(m_futex_lock);
-        if (auto futex_queue = find_futex_queue(user_address, false)) {
+        if (auto futex_queue = find_futex_queue(shard, user_address, false)) {
             RefPtr<FutexQueue> target_futex_queue;
             bool is_empty, is_target_empty;
             woken_or_requeued = futex_queue->wake_n_requeue(
@@ -154,14 +190,14 @@ KResultOr<FlatPtr> Process::sys$futex(Userspace<const Syscall::SC_futex_params*>
                     // NOTE: futex_queue's lock is being held while this callback is called
                     // The reason we're doing this in a callback is that we don't want to always
                     // create a target queue, only if we actually have anything to move to it!
-                    target_futex_queue = find_futex_queue(user_address2, true);
+                    target_futex_queue = find_futex_queue(target_shard, user_address2, true);
                     return target_futex_queue.ptr();
                 },
                 params.val2, is_empty, is_target_empty);
             if (is_empty)
-                remove_futex_queue(user_address);
+                remove_futex_queue(shard, user_address);
             if (is_target_empty && target_futex_queue)
-                remove_futex_queue(user_address2);
+                remove_futex_queue(target_shard, user_address2);
         }
         return woken_or_requeued;
     };
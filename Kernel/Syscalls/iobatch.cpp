@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Process.h>
+
+namespace Kernel {
+
+// Arbitrary pain threshold, matching the spirit of sys$readv.
+static constexpr size_t max_iobatch_ops = 128;
+
+static KResultOr<size_t> perform_iobatch_op(Process& process, iobatch_op const& op)
+{
+    if (op.size > NumericLimits<ssize_t>::max())
+        return EINVAL;
+    auto description = TRY(process.fds().open_file_description(op.fd));
+    switch (op.opcode) {
+    case IOBATCH_OP_READ: {
+        if (!description->is_readable())
+            return EBADF;
+        if (description->is_directory())
+            return EISDIR;
+        // Never block in the middle of a batch; the submitter gets EAGAIN
+        // in the op result and can retry once its event loop says so.
+        if (!description->can_read())
+            return EAGAIN;
+        auto buffer = UserOrKernelBuffer::for_user_buffer((u8*)op.buffer, op.size);
+        if (!buffer.has_value())
+            return EFAULT;
+        return description->read(buffer.value(), op.size);
+    }
+    case IOBATCH_OP_WRITE: {
+        if (!description->is_writable())
+            return EBADF;
+        if (!description->can_write())
+            return EAGAIN;
+        auto buffer = UserOrKernelBuffer::for_user_buffer((u8*)op.buffer, op.size);
+        if (!buffer.has_value())
+            return EFAULT;
+        return description->write(buffer.value(), op.size);
+    }
+    default:
+        return EINVAL;
+    }
+}
+
+KResultOr<FlatPtr> Process::sys$iobatch(Userspace<const Syscall::SC_iobatch_params*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    REQUIRE_PROMISE(stdio);
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.count == 0)
+        return 0;
+    if (params.count > max_iobatch_ops)
+        return EINVAL;
+
+    Vector<iobatch_op, 32> ops;
+    if (!ops.try_resize(params.count))
+        return ENOMEM;
+    TRY(copy_n_from_user(ops.data(), params.ops, params.count));
+
+    for (auto& op : ops) {
+        auto result = perform_iobatch_op(*this, op);
+        if (result.is_error())
+            op.result = result.error().error();
+        else
+            op.result = (ssize_t)result.value();
+    }
+
+    TRY(copy_n_to_user(params.ops, ops.data(), params.count));
+    return params.count;
+}
+
+}
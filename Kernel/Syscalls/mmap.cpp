@@ -174,6 +174,7 @@ KResultOr<FlatPtr> Process::sys$mmap(Userspace<const Syscall::SC_mmap_params*> u
     bool map_fixed = flags & MAP_FIXED;
     bool map_noreserve = flags & MAP_NORESERVE;
     bool map_randomized = flags & MAP_RANDOMIZED;
+    bool map_populate = flags & MAP_POPULATE;
 
     if (map_shared && map_private)
         return EINVAL;
@@ -249,6 +250,12 @@ KResultOr<FlatPtr> Process::sys$mmap(Userspace<const Syscall::SC_mmap_params*> u
         region->set_stack(true);
     region->set_name(move(name));
 
+    if (map_populate) {
+        // Population is only a hint; if we run out of memory here, the pages
+        // simply get faulted in lazily as usual.
+        (void)region->populate_pages();
+    }
+
     PerformanceManager::add_mmap_perf_event(*this, *region);
 
     return region->vaddr().get();
@@ -442,6 +449,10 @@ KResultOr<FlatPtr> Process::sys$madvise(Userspace<void*> address, size_t size, i
         TRY(vmobject.set_volatile(set_volatile, was_purged));
         return was_purged ? 1 : 0;
     }
+    if (advice & MADV_WILLNEED) {
+        TRY(region->populate_pages());
+        return 0;
+    }
     return EINVAL;
 }
 
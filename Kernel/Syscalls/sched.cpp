@@ -41,6 +41,77 @@ KResultOr<FlatPtr> Process::sys$sched_setparam(int pid, Userspace<const struct s
     return 0;
 }
 
+KResultOr<FlatPtr> Process::sys$sched_setscheduler(pid_t pid, int policy, Userspace<const struct sched_param*> user_param)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    REQUIRE_PROMISE(proc);
+
+    bool is_realtime_policy;
+    switch (policy) {
+    case SCHED_FIFO:
+    case SCHED_RR:
+        is_realtime_policy = true;
+        break;
+    case SCHED_OTHER:
+    case SCHED_BATCH:
+        is_realtime_policy = false;
+        break;
+    default:
+        return EINVAL;
+    }
+
+    struct sched_param desired_param;
+    TRY(copy_from_user(&desired_param, user_param));
+
+    if (desired_param.sched_priority < THREAD_PRIORITY_MIN || desired_param.sched_priority > THREAD_PRIORITY_MAX)
+        return EINVAL;
+
+    // Only the superuser may put threads into the realtime band.
+    if (is_realtime_policy && !is_superuser())
+        return EPERM;
+
+    auto* peer = Thread::current();
+    SpinlockLocker lock(g_scheduler_lock);
+    if (pid != 0)
+        peer = Thread::from_tid(pid);
+
+    if (!peer)
+        return ESRCH;
+
+    if (!is_superuser() && euid() != peer->process().uid() && uid() != peer->process().uid())
+        return EPERM;
+
+    peer->set_priority((u32)desired_param.sched_priority);
+    if (peer->is_realtime() != is_realtime_policy) {
+        // If the thread is currently sitting in a ready queue, move it to
+        // the right priority bucket immediately.
+        bool was_enqueued = Scheduler::dequeue_runnable_thread(*peer, false);
+        peer->set_realtime(is_realtime_policy);
+        if (was_enqueued)
+            Scheduler::enqueue_runnable_thread(*peer);
+    }
+    return 0;
+}
+
+KResultOr<FlatPtr> Process::sys$sched_getscheduler(pid_t pid)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    REQUIRE_PROMISE(proc);
+
+    auto* peer = Thread::current();
+    SpinlockLocker lock(g_scheduler_lock);
+    if (pid != 0)
+        peer = Thread::from_tid(pid);
+
+    if (!peer)
+        return ESRCH;
+
+    if (!is_superuser() && euid() != peer->process().uid() && uid() != peer->process().uid())
+        return EPERM;
+
+    return peer->is_realtime() ? SCHED_RR : SCHED_OTHER;
+}
+
 KResultOr<FlatPtr> Process::sys$sched_getparam(pid_t pid, Userspace<struct sched_param*> user_param)
 {
     VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <Kernel/FileSystem/Inode.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/KBuffer.h>
+#include <Kernel/Process.h>
+
+namespace Kernel {
+
+// One chunk at a time through a kernel buffer; big enough to amortize the
+// inode read path, small enough not to pin a large allocation per call.
+static constexpr size_t sendfile_chunk_size = 64 * KiB;
+
+KResultOr<FlatPtr> Process::sys$sendfile(Userspace<const Syscall::SC_sendfile_params*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    REQUIRE_PROMISE(stdio);
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.count == 0)
+        return 0;
+    if (params.count > NumericLimits<ssize_t>::max())
+        return EINVAL;
+
+    auto in_description = TRY(fds().open_file_description(params.in_fd));
+    auto out_description = TRY(fds().open_file_description(params.out_fd));
+    if (!in_description->is_readable() || !out_description->is_writable())
+        return EBADF;
+    if (in_description->is_directory())
+        return EISDIR;
+    // The source must be inode-backed so we can read at a stable offset
+    // straight out of the inode (and through its cache) without involving
+    // the description's cursor or a userspace buffer.
+    auto* inode = in_description->inode();
+    if (!inode)
+        return EINVAL;
+
+    i64 offset = 0;
+    if (params.offset) {
+        TRY(copy_from_user(&offset, params.offset));
+        if (offset < 0)
+            return EINVAL;
+    } else {
+        offset = in_description->offset();
+    }
+
+    auto chunk = TRY(KBuffer::try_create_with_size(min(params.count, sendfile_chunk_size)));
+    auto chunk_buffer = UserOrKernelBuffer::for_kernel_buffer(chunk->data());
+
+    size_t total_sent = 0;
+    while (total_sent < params.count) {
+        auto to_read = min(params.count - total_sent, chunk->size());
+        auto nread = TRY(inode->read_bytes(offset + (i64)total_sent, to_read, chunk_buffer, in_description.ptr()));
+        if (nread == 0)
+            break;
+        auto nwritten_or_error = do_write(*out_description, chunk_buffer, nread);
+        if (nwritten_or_error.is_error()) {
+            // Bytes already shipped trump the error; the caller will see the
+            // short count and come back for the rest.
+            if (total_sent > 0)
+                break;
+            return nwritten_or_error.error();
+        }
+        total_sent += nwritten_or_error.value();
+        if (nwritten_or_error.value() < nread) {
+            // Short write (non-blocking peer backed up); let the caller retry.
+            break;
+        }
+        if (nread < to_read)
+            break; // Hit EOF on the source.
+    }
+
+    i64 new_offset = offset + (i64)total_sent;
+    if (params.offset)
+        TRY(copy_to_user(params.offset, &new_offset));
+    else
+        TRY(in_description->seek(new_offset, SEEK_SET));
+
+    return total_sent;
+}
+
+}
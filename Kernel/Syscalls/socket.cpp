@@ -7,6 +7,7 @@
 #include <Kernel/FileSystem/OpenFileDescription.h>
 #include <Kernel/Net/LocalSocket.h>
 #include <Kernel/Process.h>
+#include <Kernel/Time/TimeManagement.h>
 #include <Kernel/UnixTypes.h>
 
 namespace Kernel {
@@ -19,6 +20,9 @@ namespace Kernel {
             REQUIRE_PROMISE(unix);                \
     } while (0)
 
+// Arbitrary pain threshold, matching the spirit of sys$readv.
+static constexpr size_t max_messages_per_batch = 128;
+
 void Process::setup_socket_fd(int fd, NonnullRefPtr<OpenFileDescription> description, int type)
 {
     description->set_readable(true);
@@ -154,13 +158,8 @@ KResultOr<FlatPtr> Process::sys$shutdown(int sockfd, int how)
     return socket.shutdown(how);
 }
 
-KResultOr<FlatPtr> Process::sys$sendmsg(int sockfd, Userspace<const struct msghdr*> user_msg, int flags)
+KResultOr<size_t> Process::do_sendmsg(int sockfd, const struct msghdr& msg, int flags)
 {
-    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
-    REQUIRE_PROMISE(stdio);
-    struct msghdr msg = {};
-    TRY(copy_from_user(&msg, user_msg));
-
     if (msg.msg_iovlen != 1)
         return ENOTSUP; // FIXME: Support this :)
     Vector<iovec, 1> iovs;
@@ -182,18 +181,51 @@ KResultOr<FlatPtr> Process::sys$sendmsg(int sockfd, Userspace<const struct msghd
     auto data_buffer = UserOrKernelBuffer::for_user_buffer((u8*)iovs[0].iov_base, iovs[0].iov_len);
     if (!data_buffer.has_value())
         return EFAULT;
-    auto result = socket.sendto(*description, data_buffer.value(), iovs[0].iov_len, flags, user_addr, addr_length);
-    if (result.is_error())
-        return result.error();
-    else
-        return result.release_value();
+    return socket.sendto(*description, data_buffer.value(), iovs[0].iov_len, flags, user_addr, addr_length);
 }
 
-KResultOr<FlatPtr> Process::sys$recvmsg(int sockfd, Userspace<struct msghdr*> user_msg, int flags)
+KResultOr<FlatPtr> Process::sys$sendmsg(int sockfd, Userspace<const struct msghdr*> user_msg, int flags)
 {
     VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
     REQUIRE_PROMISE(stdio);
+    struct msghdr msg = {};
+    TRY(copy_from_user(&msg, user_msg));
+    return TRY(do_sendmsg(sockfd, msg, flags));
+}
+
+KResultOr<FlatPtr> Process::sys$sendmmsg(Userspace<const Syscall::SC_sendmmsg_params*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    REQUIRE_PROMISE(stdio);
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.vlen > max_messages_per_batch)
+        return EINVAL;
 
+    size_t sent_count = 0;
+    for (size_t i = 0; i < params.vlen; ++i) {
+        auto* user_mmsg = params.msgvec + i;
+        mmsghdr mmsg = {};
+        TRY(copy_from_user(&mmsg, user_mmsg));
+
+        auto result = do_sendmsg(params.sockfd, mmsg.msg_hdr, params.flags);
+        if (result.is_error()) {
+            // Like Linux, an error only aborts the batch; messages already
+            // sent are reported and the error surfaces on the next call.
+            if (sent_count == 0)
+                return result.error();
+            break;
+        }
+
+        unsigned transmitted = (unsigned)result.value();
+        TRY(copy_to_user(&user_mmsg->msg_len, &transmitted));
+        ++sent_count;
+    }
+    return sent_count;
+}
+
+KResultOr<size_t> Process::do_recvmsg(int sockfd, Userspace<struct msghdr*> user_msg, int flags)
+{
     struct msghdr msg;
     TRY(copy_from_user(&msg, user_msg));
 
@@ -256,6 +288,59 @@ KResultOr<FlatPtr> Process::sys$recvmsg(int sockfd, Userspace<struct msghdr*> us
     return result.value();
 }
 
+KResultOr<FlatPtr> Process::sys$recvmsg(int sockfd, Userspace<struct msghdr*> user_msg, int flags)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    REQUIRE_PROMISE(stdio);
+    return TRY(do_recvmsg(sockfd, user_msg, flags));
+}
+
+KResultOr<FlatPtr> Process::sys$recvmmsg(Userspace<const Syscall::SC_recvmmsg_params*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this)
+    REQUIRE_PROMISE(stdio);
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.vlen > max_messages_per_batch)
+        return EINVAL;
+
+    bool has_deadline = false;
+    Time deadline {};
+    if (params.timeout) {
+        auto timeout = TRY(copy_time_from_user(Userspace<const timespec*>((FlatPtr)params.timeout)));
+        deadline = TimeManagement::the().monotonic_time() + timeout;
+        has_deadline = true;
+    }
+
+    size_t received_count = 0;
+    for (size_t i = 0; i < params.vlen; ++i) {
+        auto* user_mmsg = params.msgvec + i;
+
+        // Only ever block for the first datagram; once something has been
+        // received we take whatever else is already queued and return.
+        int message_flags = params.flags;
+        if (received_count > 0)
+            message_flags |= MSG_DONTWAIT;
+
+        // msg_hdr is the first member of mmsghdr, so it shares its address.
+        auto result = do_recvmsg(params.sockfd, Userspace<struct msghdr*>((FlatPtr)user_mmsg), message_flags);
+        if (result.is_error()) {
+            if (received_count == 0)
+                return result.error();
+            break;
+        }
+
+        unsigned received = (unsigned)result.value();
+        TRY(copy_to_user(&user_mmsg->msg_len, &received));
+        ++received_count;
+
+        // Like Linux, the timeout is only checked between datagrams.
+        if (has_deadline && TimeManagement::the().monotonic_time() >= deadline)
+            break;
+    }
+    return received_count;
+}
+
 template<bool sockname, typename Params>
 KResult Process::get_sock_or_peer_name(const Params& params)
 {
@@ -4,14 +4,23 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Singleton.h>
 #include <Kernel/FileSystem/VirtualFileSystem.h>
 #include <Kernel/Process.h>
 #include <Kernel/Sections.h>
 #include <Kernel/Tasks/SyncTask.h>
 #include <Kernel/Time/TimeManagement.h>
+#include <Kernel/WaitQueue.h>
 
 namespace Kernel {
 
+static Singleton<WaitQueue> s_sync_task_wait_queue;
+
+void SyncTask::request_sync()
+{
+    s_sync_task_wait_queue->wake_one();
+}
+
 UNMAP_AFTER_INIT void SyncTask::spawn()
 {
     RefPtr<Thread> syncd_thread;
@@ -19,7 +28,8 @@ UNMAP_AFTER_INIT void SyncTask::spawn()
         dbgln("SyncTask is running");
         for (;;) {
             VirtualFileSystem::sync();
-            (void)Thread::current()->sleep(Time::from_seconds(1));
+            auto deadline = TimeManagement::the().monotonic_time(TimePrecision::Coarse) + Time::from_seconds(1);
+            (void)s_sync_task_wait_queue->wait_on(Thread::BlockTimeout(true, &deadline), "SyncTask");
         }
     });
 }
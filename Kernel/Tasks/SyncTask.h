@@ -10,5 +10,9 @@ namespace Kernel {
 class SyncTask {
 public:
     static void spawn();
+
+    // Wakes the sync task immediately instead of waiting for the next
+    // periodic flush, e.g. when a disk cache is filling up with dirty blocks.
+    static void request_sync();
 };
 }
@@ -175,6 +175,11 @@ public:
     void set_priority(u32 p) { m_priority = p; }
     u32 priority() const { return m_priority; }
 
+    // Realtime threads (SCHED_RR) run in a strict band above all normal
+    // threads and round-robin among themselves.
+    bool is_realtime() const { return m_is_realtime; }
+    void set_realtime(bool realtime) { m_is_realtime = realtime; }
+
     void detach()
     {
         SpinlockLocker lock(m_lock);
@@ -1213,6 +1218,7 @@ private:
 
     IntrusiveListNode<Thread> m_process_thread_list_node;
     int m_runnable_priority { -1 };
+    u32 m_ready_queue_cpu { 0 };
 
     friend class WaitQueue;
 
@@ -1351,6 +1357,7 @@ private:
     bool m_initialized { false };
     bool m_in_block { false };
     bool m_is_idle_thread { false };
+    bool m_is_realtime { false };
     bool m_is_crashing { false };
     Atomic<bool> m_have_any_unmasked_pending_signals { false };
     Atomic<u32> m_nested_profiler_calls { 0 };
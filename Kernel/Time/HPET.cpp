@@ -227,6 +227,12 @@ void HPET::update_non_periodic_comparator_value(const HPETComparator& comparator
     auto& regs = registers();
     auto& timer = regs.timers[comparator.comparator_number()];
     u64 value = frequency() / comparator.ticks_per_second();
+    // When this comparator drives the system timer and the processor is idle,
+    // program the next interrupt for the next actual deadline instead of the
+    // next nominal tick. Timekeeping is unaffected: update_time() reads main
+    // counter deltas rather than counting interrupts.
+    if (TimeManagement::is_initialized() && TimeManagement::the().is_system_timer(comparator))
+        value *= TimeManagement::the().idle_ticks_to_skip();
     // NOTE: If the main counter passes this new value before we finish writing it, we will never receive an interrupt!
     u64 new_counter_value = read_main_counter() + value;
     timer.comparator_value.high = (u32)(new_counter_value >> 32);
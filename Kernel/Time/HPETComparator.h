@@ -32,6 +32,7 @@ public:
     virtual void set_periodic() override;
     virtual void set_non_periodic() override;
     virtual void disable() override;
+    virtual void rearm() override { set_new_countdown(); }
     virtual bool can_query_raw() const override { return true; }
     virtual u64 current_raw() const override;
     virtual u64 raw_to_ns(u64) const override;
@@ -44,6 +44,12 @@ public:
     virtual void set_periodic() = 0;
     virtual void set_non_periodic() = 0;
     virtual void disable() = 0;
+
+    // One-shot timers reprogram their comparator on every interrupt; this
+    // forces that reprogramming to happen right away, e.g. because an
+    // earlier deadline appeared while the last programmed interrupt was
+    // stretched out for an idle processor.
+    virtual void rearm() { }
     virtual u32 frequency() const = 0;
     virtual bool can_query_raw() const { return false; }
     virtual u64 current_raw() const { return 0; }
@@ -14,6 +14,7 @@
 #include <Kernel/PerformanceManager.h>
 #include <Kernel/Scheduler.h>
 #include <Kernel/Sections.h>
+#include <Kernel/Thread.h>
 #include <Kernel/Time/APICTimer.h>
 #include <Kernel/Time/HPET.h>
 #include <Kernel/Time/HPETComparator.h>
@@ -32,6 +33,48 @@ TimeManagement& TimeManagement::the()
     return *s_the;
 }
 
+bool TimeManagement::is_initialized()
+{
+    return s_the.is_initialized();
+}
+
+u64 TimeManagement::idle_ticks_to_skip() const
+{
+    VERIFY_INTERRUPTS_DISABLED();
+
+    // Time slicing relies on full-rate ticking while anything is runnable,
+    // so the tick is only stretched when the idle thread would just be
+    // woken up to go right back to sleep.
+    auto* current_thread = Thread::current();
+    if (!current_thread || !current_thread->is_idle_thread())
+        return 1;
+    if (Scheduler::peek_next_runnable_thread())
+        return 1;
+
+    // Cap the stretch at a second's worth of ticks so coarse timestamps
+    // and the epoch time adjustment keep making progress.
+    u64 max_ticks_to_skip = ticks_per_second();
+
+    auto time_to_next_timer = TimerQueue::the().time_to_next_timer_expiry();
+    if (!time_to_next_timer.has_value())
+        return max_ticks_to_skip;
+
+    u64 nanoseconds_per_tick = 1'000'000'000 / ticks_per_second();
+    u64 ticks_to_skip = (u64)time_to_next_timer.value().to_nanoseconds() / nanoseconds_per_tick;
+    if (ticks_to_skip <= 1)
+        return 1;
+    return min(ticks_to_skip, max_ticks_to_skip);
+}
+
+void TimeManagement::system_timer_did_gain_earlier_deadline()
+{
+    // A one-shot system timer might have been programmed past the new
+    // deadline while the processor was idle; reprogram it. (Periodic
+    // timers always fire at full rate, so there is nothing to do.)
+    if (m_system_timer && !m_system_timer->is_periodic())
+        m_system_timer->rearm();
+}
+
 bool TimeManagement::is_valid_clock_id(clockid_t clock_id)
 {
     switch (clock_id) {
@@ -35,6 +35,7 @@ public:
     TimeManagement();
     static void initialize(u32 cpu);
     static TimeManagement& the();
+    static bool is_initialized();
 
     static bool is_valid_clock_id(clockid_t);
     Time current_time(clockid_t) const;
@@ -61,6 +62,16 @@ public:
     bool enable_profile_timer();
     bool disable_profile_timer();
 
+    // How many system timer ticks a one-shot system timer may coalesce
+    // into its next interrupt. This is 1 (full-rate ticking) unless the
+    // current processor is idle with nothing runnable, in which case the
+    // tick is stretched out towards the next timer queue deadline.
+    u64 idle_ticks_to_skip() const;
+
+    // Called when a timer with a deadline earlier than anything queued is
+    // added, in case the system timer was programmed past it while idle.
+    void system_timer_did_gain_earlier_deadline();
+
     u64 uptime_ms() const;
     static Time now();
 
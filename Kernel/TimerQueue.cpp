@@ -14,7 +14,7 @@
 namespace Kernel {
 
 static Singleton<TimerQueue> s_the;
-static Spinlock g_timerqueue_lock;
+static RecursiveSpinlock g_timerqueue_lock;
 
 Time Timer::remaining() const
 {
@@ -105,6 +105,19 @@ void TimerQueue::add_timer_locked(NonnullRefPtr<Timer> timer)
             }
         }
         if (following_timer) {
+            // If the timer that would expire right after us does so within
+            // our slack window, snap to its deadline so both share a single
+            // wakeup. Timers may therefore fire slightly late (bounded by
+            // the slack), but never early.
+            auto now = TimeManagement::the().current_time(timer->m_clock_id);
+            if (timer_expiration > now) {
+                u64 slack_in_nanoseconds = min<u64>((timer_expiration - now).to_nanoseconds() / 32, 100'000'000);
+                auto latest_acceptable_expiration = timer_expiration + Time::from_nanoseconds(slack_in_nanoseconds);
+                if (following_timer->m_expires <= latest_acceptable_expiration) {
+                    timer->m_expires = following_timer->m_expires;
+                    timer_expiration = timer->m_expires;
+                }
+            }
             bool next_timer_needs_update = queue.list.first() == following_timer;
             queue.list.insert_before(*following_timer, timer.leak_ref());
             if (next_timer_needs_update)
@@ -113,6 +126,28 @@ void TimerQueue::add_timer_locked(NonnullRefPtr<Timer> timer)
             queue.list.append(timer.leak_ref());
         }
     }
+
+    // If this timer became the new earliest deadline, the system timer may
+    // have been programmed too far out while the processor was idle.
+    if (queue.next_timer_due == timer_expiration)
+        TimeManagement::the().system_timer_did_gain_earlier_deadline();
+}
+
+Optional<Time> TimerQueue::time_to_next_timer_expiry() const
+{
+    SpinlockLocker lock(g_timerqueue_lock);
+    Optional<Time> soonest;
+    auto consider_queue = [&](Queue const& queue, clockid_t clock_id) {
+        if (queue.list.is_empty())
+            return;
+        auto now = TimeManagement::the().current_time(clock_id);
+        auto delta = queue.next_timer_due <= now ? Time::zero() : queue.next_timer_due - now;
+        if (!soonest.has_value() || delta < soonest.value())
+            soonest = delta;
+    };
+    consider_queue(m_timer_queue_monotonic, CLOCK_MONOTONIC_COARSE);
+    consider_queue(m_timer_queue_realtime, CLOCK_REALTIME_COARSE);
+    return soonest;
 }
 
 bool TimerQueue::cancel_timer(Timer& timer, bool* was_in_use)
@@ -92,6 +92,11 @@ public:
     bool cancel_timer(Timer& timer, bool* was_in_use = nullptr);
     void fire();
 
+    // How long until the earliest queued timer (of either clock) expires,
+    // or nothing if no timers are queued. Used to stretch the system timer
+    // tick while a processor is idle.
+    Optional<Time> time_to_next_timer_expiry() const;
+
 private:
     struct Queue {
         Timer::List list;
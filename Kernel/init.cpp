@@ -297,6 +297,12 @@ void init_stage2(void*)
     SyncTask::spawn();
     FinalizerTask::spawn();
 
+    // Storage probing mostly waits on hardware (AHCI port spin-up and the
+    // like), so kick it off on worker processes right away and let the rest
+    // of init_stage2 run in the meantime. StorageManagement::initialize()
+    // gathers the results just before we mount the root filesystem below.
+    StorageManagement::the().begin_controller_probing(kernel_command_line().is_force_pio());
+
     auto boot_profiling = kernel_command_line().is_boot_profiling_enabled();
 
     USB::USBManagement::initialize();
@@ -140,6 +140,7 @@ set(PTHREAD_DEBUG ON)
 set(PTMX_DEBUG ON)
 set(REACHABLE_DEBUG ON)
 set(REGEX_DEBUG ON)
+set(REQUESTSERVER_DEBUG ON)
 set(RESIZE_DEBUG ON)
 set(RESOURCE_DEBUG ON)
 set(ROUTING_DEBUG ON)
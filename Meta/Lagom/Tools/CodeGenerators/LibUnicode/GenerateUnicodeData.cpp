@@ -750,46 +750,32 @@ static constexpr Array<Span<CodePointRange const>, @size@> @name@ { {)~~~");
     append_prop_list("s_scripts"sv, "s_script_{}"sv, unicode_data.script_list);
     append_prop_list("s_script_extensions"sv, "s_script_extension_{}"sv, unicode_data.script_extensions);
 
-    generator.append(R"~~~(
-static HashMap<u32, UnicodeData const*> const& ensure_code_point_map()
-{
-    static HashMap<u32, UnicodeData const*> code_point_to_data_map;
-    code_point_to_data_map.ensure_capacity(s_unicode_data.size());
-
-    for (auto const& unicode_data : s_unicode_data)
-        code_point_to_data_map.set(unicode_data.code_point, &unicode_data);
-
-    return code_point_to_data_map;
-}
-
-static Optional<u32> index_of_code_point_in_range(u32 code_point)
-{)~~~");
-
-    for (auto const& range : unicode_data.code_point_ranges) {
-        generator.set("first", String::formatted("{:#x}", range.first));
-        generator.set("last", String::formatted("{:#x}", range.last));
-
-        generator.append(R"~~~(
-    if ((code_point > @first@) && (code_point < @last@))
-        return @first@;)~~~");
-    }
+    append_code_point_range_list("s_code_point_ranges", unicode_data.code_point_ranges);
 
     generator.append(R"~~~(
-    return {};
-}
+struct UnicodeDataComparator {
+    constexpr int operator()(u32 code_point, UnicodeData const& data)
+    {
+        return (code_point > data.code_point) - (code_point < data.code_point);
+    }
+};
 
 namespace Detail {
 
 Optional<UnicodeData> unicode_data_for_code_point(u32 code_point)
 {
-    static auto const& code_point_to_data_map = ensure_code_point_map();
     VERIFY(is_unicode(code_point));
 
-    if (auto data = code_point_to_data_map.get(code_point); data.has_value())
-        return *(data.value());
+    // Note: Every table consulted here is constexpr data in the read-only
+    // segment of the shared library, which the loader maps read-only and
+    // shares between all processes; nothing is allocated or built at runtime.
+    if (auto const* data = binary_search(s_unicode_data, code_point, nullptr, UnicodeDataComparator {}))
+        return *data;
 
-    if (auto index = index_of_code_point_in_range(code_point); index.has_value()) {
-        auto data_for_range = *(code_point_to_data_map.get(*index).value());
+    // Code points inside a First/Last range share the data of the first code
+    // point in that range, except that they map to themselves when cased.
+    if (auto const* range = binary_search(s_code_point_ranges, code_point, nullptr, CodePointRangeComparator {})) {
+        auto data_for_range = *binary_search(s_unicode_data, range->first, nullptr, UnicodeDataComparator {});
         data_for_range.simple_uppercase_mapping = code_point;
         data_for_range.simple_lowercase_mapping = code_point;
         return data_for_range;
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+
+static constexpr int iteration_count = 100'000;
+
+BENCHMARK_CASE(vector_append)
+{
+    Vector<int> ints;
+    for (int i = 0; i < iteration_count; ++i)
+        ints.append(i);
+    EXPECT_EQ(ints.size(), (size_t)iteration_count);
+}
+
+BENCHMARK_CASE(vector_append_with_capacity)
+{
+    Vector<int> ints;
+    ints.ensure_capacity(iteration_count);
+    for (int i = 0; i < iteration_count; ++i)
+        ints.unchecked_append(i);
+    EXPECT_EQ(ints.size(), (size_t)iteration_count);
+}
+
+BENCHMARK_CASE(hash_table_set)
+{
+    HashTable<int> table;
+    for (int i = 0; i < iteration_count; ++i)
+        table.set(i);
+    EXPECT_EQ(table.size(), (size_t)iteration_count);
+}
+
+BENCHMARK_CASE(hash_map_set_and_get)
+{
+    HashMap<int, int> map;
+    for (int i = 0; i < iteration_count; ++i)
+        map.set(i, i * 2);
+
+    int matches = 0;
+    for (int i = 0; i < iteration_count; ++i) {
+        if (map.get(i).value_or(-1) == i * 2)
+            ++matches;
+    }
+    EXPECT_EQ(matches, iteration_count);
+}
+
+BENCHMARK_CASE(string_keyed_hash_map_get)
+{
+    HashMap<String, int> map;
+    for (int i = 0; i < 1000; ++i)
+        map.set(String::formatted("key-{}", i), i);
+
+    int found = 0;
+    for (int repeat = 0; repeat < 100; ++repeat) {
+        for (int i = 0; i < 1000; ++i) {
+            if (map.get(String::formatted("key-{}", i)).has_value())
+                ++found;
+        }
+    }
+    EXPECT_EQ(found, 100'000);
+}
@@ -43,3 +43,23 @@ TEST_CASE(test_encode)
     encode_equal("fooba", "Zm9vYmE=");
     encode_equal("foobar", "Zm9vYmFy");
 }
+
+TEST_CASE(long_roundtrip)
+{
+    // Exercise the vectorized bulk paths with sizes around the 12/16-byte
+    // block boundaries.
+    for (size_t size : { 11, 12, 13, 15, 16, 17, 47, 48, 49, 1000, 4096, 4097 }) {
+        ByteBuffer buffer = ByteBuffer::create_uninitialized(size).release_value();
+        for (size_t i = 0; i < size; ++i)
+            buffer[i] = i * 131 + 7;
+        auto encoded = encode_base64(buffer);
+        auto decoded = decode_base64(encoded);
+        EXPECT_EQ(decoded, buffer);
+    }
+}
+
+TEST_CASE(decode_is_whitespace_tolerant)
+{
+    auto decoded = decode_base64("Zm9v\nYmFy\r\n  YmF6\n"sv);
+    EXPECT_EQ(StringView(decoded.bytes()), "foobarbaz");
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/JsonPullParser.h>
+
+using Event = JsonPullParser::Event;
+
+TEST_CASE(empty_containers)
+{
+    {
+        JsonPullParser parser("{}"sv);
+        EXPECT_EQ(parser.next(), Event::StartObject);
+        EXPECT_EQ(parser.next(), Event::EndObject);
+        EXPECT_EQ(parser.next(), Event::Done);
+    }
+    {
+        JsonPullParser parser("[]"sv);
+        EXPECT_EQ(parser.next(), Event::StartArray);
+        EXPECT_EQ(parser.next(), Event::EndArray);
+        EXPECT_EQ(parser.next(), Event::Done);
+    }
+}
+
+TEST_CASE(scalar_values)
+{
+    JsonPullParser parser("[1, -2.5, \"three\", true, false, null]"sv);
+    EXPECT_EQ(parser.next(), Event::StartArray);
+    EXPECT_EQ(parser.next(), Event::NumberValue);
+    EXPECT_EQ(parser.last_number(), "1");
+    EXPECT_EQ(parser.next(), Event::NumberValue);
+    EXPECT_EQ(parser.last_number(), "-2.5");
+    EXPECT_EQ(parser.next(), Event::StringValue);
+    EXPECT_EQ(parser.last_string(), "three");
+    EXPECT_EQ(parser.next(), Event::TrueValue);
+    EXPECT_EQ(parser.next(), Event::FalseValue);
+    EXPECT_EQ(parser.next(), Event::NullValue);
+    EXPECT_EQ(parser.next(), Event::EndArray);
+    EXPECT_EQ(parser.next(), Event::Done);
+}
+
+TEST_CASE(nested_objects)
+{
+    JsonPullParser parser("{ \"pid\": 42, \"threads\": [ { \"tid\": 42 } ] }"sv);
+    EXPECT_EQ(parser.next(), Event::StartObject);
+    EXPECT_EQ(parser.next(), Event::Key);
+    EXPECT_EQ(parser.last_string(), "pid");
+    EXPECT_EQ(parser.next(), Event::NumberValue);
+    EXPECT_EQ(parser.next(), Event::Key);
+    EXPECT_EQ(parser.last_string(), "threads");
+    EXPECT_EQ(parser.next(), Event::StartArray);
+    EXPECT_EQ(parser.next(), Event::StartObject);
+    EXPECT_EQ(parser.next(), Event::Key);
+    EXPECT_EQ(parser.last_string(), "tid");
+    EXPECT_EQ(parser.next(), Event::NumberValue);
+    EXPECT_EQ(parser.last_number(), "42");
+    EXPECT_EQ(parser.next(), Event::EndObject);
+    EXPECT_EQ(parser.next(), Event::EndArray);
+    EXPECT_EQ(parser.next(), Event::EndObject);
+    EXPECT_EQ(parser.next(), Event::Done);
+}
+
+TEST_CASE(string_views_are_zero_copy)
+{
+    String input = "{ \"name\": \"Serenity\" }";
+    JsonPullParser parser(input.view());
+    EXPECT_EQ(parser.next(), Event::StartObject);
+    EXPECT_EQ(parser.next(), Event::Key);
+    EXPECT_EQ(parser.next(), Event::StringValue);
+    EXPECT(parser.last_string().characters_without_null_termination() >= input.characters());
+    EXPECT(parser.last_string().characters_without_null_termination() < input.characters() + input.length());
+}
+
+TEST_CASE(escaped_strings)
+{
+    JsonPullParser parser("\"a\\n\\\"b\\\"\\u0041\""sv);
+    EXPECT_EQ(parser.next(), Event::StringValue);
+    EXPECT_EQ(parser.last_string(), "a\\n\\\"b\\\"\\u0041");
+    EXPECT_EQ(parser.decode_last_string().value(), "a\n\"b\"A");
+    EXPECT_EQ(parser.next(), Event::Done);
+}
+
+TEST_CASE(parse_errors)
+{
+    {
+        JsonPullParser parser("{ \"key\" 42 }"sv);
+        EXPECT_EQ(parser.next(), Event::StartObject);
+        EXPECT_EQ(parser.next(), Event::ParseError);
+        EXPECT_EQ(parser.next(), Event::ParseError);
+    }
+    {
+        JsonPullParser parser("[1, 2"sv);
+        EXPECT_EQ(parser.next(), Event::StartArray);
+        EXPECT_EQ(parser.next(), Event::NumberValue);
+        EXPECT_EQ(parser.next(), Event::NumberValue);
+        EXPECT_EQ(parser.next(), Event::ParseError);
+    }
+    {
+        JsonPullParser parser("[] trailing"sv);
+        EXPECT_EQ(parser.next(), Event::StartArray);
+        EXPECT_EQ(parser.next(), Event::EndArray);
+        EXPECT_EQ(parser.next(), Event::ParseError);
+    }
+}
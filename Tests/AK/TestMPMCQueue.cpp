@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/MPMCQueue.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/SPSCQueue.h>
+#include <AK/String.h>
+
+TEST_CASE(basic)
+{
+    MPMCQueue<int, 4> ints;
+    EXPECT(!ints.try_dequeue().has_value());
+
+    EXPECT(ints.try_enqueue(1));
+    EXPECT(ints.try_enqueue(2));
+    EXPECT(ints.try_enqueue(3));
+    EXPECT(ints.try_enqueue(4));
+
+    // Unlike CircularQueue, enqueuing into a full queue fails instead of
+    // overwriting the oldest element.
+    EXPECT(!ints.try_enqueue(5));
+
+    EXPECT_EQ(ints.try_dequeue().value(), 1);
+    EXPECT_EQ(ints.try_dequeue().value(), 2);
+
+    EXPECT(ints.try_enqueue(5));
+
+    EXPECT_EQ(ints.try_dequeue().value(), 3);
+    EXPECT_EQ(ints.try_dequeue().value(), 4);
+    EXPECT_EQ(ints.try_dequeue().value(), 5);
+    EXPECT(!ints.try_dequeue().has_value());
+}
+
+TEST_CASE(wrap_around_many_times)
+{
+    MPMCQueue<int, 2> ints;
+    for (int i = 0; i < 10'000; ++i) {
+        EXPECT(ints.try_enqueue(i));
+        EXPECT(ints.try_enqueue(i + 1));
+        EXPECT_EQ(ints.try_dequeue().value(), i);
+        EXPECT_EQ(ints.try_dequeue().value(), i + 1);
+    }
+}
+
+TEST_CASE(complex_type)
+{
+    MPMCQueue<String, 2> strings;
+
+    EXPECT(strings.try_enqueue("ABC"));
+    EXPECT(strings.try_enqueue("DEF"));
+    EXPECT(!strings.try_enqueue("GHI"));
+
+    EXPECT_EQ(strings.try_dequeue().value(), "ABC");
+    EXPECT_EQ(strings.try_dequeue().value(), "DEF");
+}
+
+TEST_CASE(move_only_type)
+{
+    MPMCQueue<NonnullOwnPtr<int>, 2> ptrs;
+
+    EXPECT(ptrs.try_enqueue(make<int>(42)));
+    auto ptr = ptrs.try_dequeue().release_value();
+    EXPECT_EQ(*ptr, 42);
+}
+
+TEST_CASE(spsc_basic)
+{
+    SPSCQueue<int, 4> ints;
+    EXPECT(!ints.try_dequeue().has_value());
+
+    EXPECT(ints.try_enqueue(1));
+    EXPECT(ints.try_enqueue(2));
+    EXPECT(ints.try_enqueue(3));
+    EXPECT(ints.try_enqueue(4));
+    EXPECT(!ints.try_enqueue(5));
+
+    EXPECT_EQ(ints.try_dequeue().value(), 1);
+    EXPECT(ints.try_enqueue(5));
+
+    EXPECT_EQ(ints.try_dequeue().value(), 2);
+    EXPECT_EQ(ints.try_dequeue().value(), 3);
+    EXPECT_EQ(ints.try_dequeue().value(), 4);
+    EXPECT_EQ(ints.try_dequeue().value(), 5);
+    EXPECT(!ints.try_dequeue().has_value());
+}
+
+TEST_CASE(spsc_wrap_around_many_times)
+{
+    SPSCQueue<String, 2> strings;
+    for (int i = 0; i < 10'000; ++i) {
+        auto string = String::number(i);
+        EXPECT(strings.try_enqueue(string));
+        EXPECT_EQ(strings.try_dequeue().value(), string);
+    }
+}
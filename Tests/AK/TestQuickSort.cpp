@@ -97,3 +97,30 @@ TEST_CASE(maximum_stack_depth)
 
     delete[] data;
 }
+
+TEST_CASE(sorts_adversarial_inputs)
+{
+    // Already sorted, reverse sorted, and all-equal inputs should all be
+    // handled by the insertion-sort and heapsort fallbacks without blowing
+    // the stack or going quadratic.
+    Vector<int> sorted;
+    for (int i = 0; i < 10000; ++i)
+        sorted.append(i);
+    quick_sort(sorted);
+    for (int i = 0; i < 10000; ++i)
+        EXPECT_EQ(sorted[i], i);
+
+    Vector<int> reversed;
+    for (int i = 0; i < 10000; ++i)
+        reversed.append(10000 - i);
+    quick_sort(reversed);
+    for (size_t i = 1; i < reversed.size(); ++i)
+        EXPECT(reversed[i - 1] <= reversed[i]);
+
+    Vector<int> equal;
+    for (int i = 0; i < 10000; ++i)
+        equal.append(42);
+    quick_sort(equal);
+    EXPECT_EQ(equal.first(), 42);
+    EXPECT_EQ(equal.last(), 42);
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ScopedArena.h>
+#include <AK/String.h>
+
+TEST_CASE(creates_many_trivial_objects)
+{
+    ScopedArena arena;
+    for (int i = 0; i < 100000; ++i) {
+        auto& value = arena.create<int>(i);
+        EXPECT_EQ(value, i);
+    }
+}
+
+TEST_CASE(runs_destructors_on_scope_exit)
+{
+    static int s_destroyed = 0;
+    struct Counter {
+        ~Counter() { ++s_destroyed; }
+        int value { 0 };
+    };
+
+    {
+        ScopedArena arena;
+        for (int i = 0; i < 1000; ++i)
+            arena.create<Counter>();
+        EXPECT_EQ(s_destroyed, 0);
+    }
+    EXPECT_EQ(s_destroyed, 1000);
+}
+
+TEST_CASE(respects_alignment)
+{
+    ScopedArena arena;
+    arena.create<char>('x');
+    auto& value = arena.create<u64>(0x1234567812345678ull);
+    EXPECT_EQ(reinterpret_cast<FlatPtr>(&value) % alignof(u64), 0u);
+    EXPECT_EQ(value, 0x1234567812345678ull);
+}
+
+TEST_CASE(non_trivial_members)
+{
+    ScopedArena arena;
+    auto& string = arena.create<String>("allocated inside the arena, long enough for the heap");
+    EXPECT(string.contains("arena"));
+}
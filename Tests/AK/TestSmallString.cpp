@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/HashMap.h>
+#include <AK/SmallString.h>
+
+TEST_CASE(construct_empty)
+{
+    SmallString string;
+    EXPECT(string.is_empty());
+    EXPECT(string.is_inline());
+    EXPECT_EQ(string.length(), 0u);
+}
+
+TEST_CASE(short_strings_are_stored_inline)
+{
+    SmallString string("hello");
+    EXPECT(string.is_inline());
+    EXPECT_EQ(string.length(), 5u);
+    EXPECT_EQ(string, "hello");
+
+    SmallString at_capacity("abcdefghijklmnopqrstuvw");
+    EXPECT_EQ(at_capacity.length(), SmallString::inline_capacity);
+    EXPECT(at_capacity.is_inline());
+}
+
+TEST_CASE(long_strings_fall_back_to_stringimpl)
+{
+    SmallString string("this string is definitely longer than twenty-three bytes");
+    EXPECT(!string.is_inline());
+    EXPECT_EQ(string.view(), "this string is definitely longer than twenty-three bytes");
+}
+
+TEST_CASE(copy_and_move)
+{
+    SmallString original("a rather long string that lives on the heap, promise");
+    SmallString copy = original;
+    EXPECT_EQ(copy, original);
+
+    SmallString moved = move(copy);
+    EXPECT_EQ(moved, original);
+
+    SmallString shorty("hi");
+    shorty = moved;
+    EXPECT_EQ(shorty, original);
+}
+
+TEST_CASE(conversion_to_and_from_string)
+{
+    String string("key");
+    SmallString small(string);
+    EXPECT(small.is_inline());
+    EXPECT_EQ(small, string);
+    EXPECT_EQ(small.to_string(), string);
+}
+
+TEST_CASE(usable_as_hash_key)
+{
+    HashMap<SmallString, int> map;
+    map.set("one", 1);
+    map.set("a key that is far too long to be stored inline here", 2);
+    EXPECT_EQ(map.get(SmallString("one")).value(), 1);
+    EXPECT_EQ(map.get(SmallString("a key that is far too long to be stored inline here")).value(), 2);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/StableSort.h>
+#include <AK/Vector.h>
+
+TEST_CASE(sorts)
+{
+    Vector<int> ints;
+    for (int i = 0; i < 1000; ++i)
+        ints.append((i * 171) % 1000);
+    stable_sort(ints);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(ints[i], i);
+}
+
+TEST_CASE(equal_elements_keep_their_order)
+{
+    struct Row {
+        int key { 0 };
+        int original_index { 0 };
+    };
+
+    Vector<Row> rows;
+    for (int i = 0; i < 500; ++i)
+        rows.append({ i % 7, i });
+
+    stable_sort(rows, [](auto& a, auto& b) { return a.key < b.key; });
+
+    for (size_t i = 1; i < rows.size(); ++i) {
+        EXPECT(rows[i - 1].key <= rows[i].key);
+        if (rows[i - 1].key == rows[i].key)
+            EXPECT(rows[i - 1].original_index < rows[i].original_index);
+    }
+}
+
+TEST_CASE(sorts_without_copy)
+{
+    struct NoCopy {
+        AK_MAKE_NONCOPYABLE(NoCopy);
+
+    public:
+        NoCopy() = default;
+        NoCopy(NoCopy&&) = default;
+        NoCopy& operator=(NoCopy&&) = default;
+
+        int value { 0 };
+    };
+
+    Vector<NoCopy> values;
+    for (int i = 0; i < 100; ++i) {
+        values.append({});
+        values.last().value = 100 - i;
+    }
+    stable_sort(values, [](auto& a, auto& b) { return a.value < b.value; });
+    for (size_t i = 1; i < values.size(); ++i)
+        EXPECT(values[i - 1].value <= values[i].value);
+}
@@ -510,3 +510,21 @@ TEST_CASE(reference_deletion_should_not_affect_object)
     }
     EXPECT_EQ(times_deleted, 1u);
 }
+
+TEST_CASE(resize_uninitialized)
+{
+    Vector<u8> bytes;
+    bytes.resize_uninitialized(4096);
+    EXPECT_EQ(bytes.size(), 4096u);
+    for (size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = 0x55;
+
+    bytes.resize_uninitialized(16);
+    EXPECT_EQ(bytes.size(), 16u);
+    EXPECT_EQ(bytes[15], 0x55);
+
+    Vector<int> ints;
+    ints.resize(4);
+    for (auto value : ints)
+        EXPECT_EQ(value, 0);
+}
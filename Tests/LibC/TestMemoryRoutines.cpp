@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Types.h>
+#include <LibTest/TestCase.h>
+#include <string.h>
+
+// Exercises the optimized memcpy/memset/memcmp/strlen across every small
+// size and misalignment combination, since that's where the fixed-width
+// and SSE2 fast paths do overlapping accesses that are easy to get wrong.
+
+static constexpr size_t max_tested_size = 96;
+static constexpr size_t max_tested_alignment = 8;
+static constexpr size_t buffer_size = max_tested_size + 2 * max_tested_alignment;
+
+TEST_CASE(memcpy_sizes_and_alignments)
+{
+    u8 src_buffer[buffer_size];
+    u8 dest_buffer[buffer_size];
+    for (size_t i = 0; i < buffer_size; ++i)
+        src_buffer[i] = 1 + (i % 251);
+
+    for (size_t size = 0; size <= max_tested_size; ++size) {
+        for (size_t src_alignment = 0; src_alignment < max_tested_alignment; ++src_alignment) {
+            for (size_t dest_alignment = 0; dest_alignment < max_tested_alignment; ++dest_alignment) {
+                for (size_t i = 0; i < buffer_size; ++i)
+                    dest_buffer[i] = 0;
+                memcpy(dest_buffer + dest_alignment, src_buffer + src_alignment, size);
+
+                bool ok = true;
+                for (size_t i = 0; i < dest_alignment; ++i)
+                    ok &= dest_buffer[i] == 0;
+                for (size_t i = 0; i < size; ++i)
+                    ok &= dest_buffer[dest_alignment + i] == src_buffer[src_alignment + i];
+                for (size_t i = dest_alignment + size; i < buffer_size; ++i)
+                    ok &= dest_buffer[i] == 0;
+                EXPECT(ok);
+            }
+        }
+    }
+}
+
+TEST_CASE(memset_sizes_and_alignments)
+{
+    u8 buffer[buffer_size];
+    for (size_t size = 0; size <= max_tested_size; ++size) {
+        for (size_t alignment = 0; alignment < max_tested_alignment; ++alignment) {
+            for (size_t i = 0; i < buffer_size; ++i)
+                buffer[i] = 0;
+            memset(buffer + alignment, 0x5a, size);
+
+            bool ok = true;
+            for (size_t i = 0; i < alignment; ++i)
+                ok &= buffer[i] == 0;
+            for (size_t i = 0; i < size; ++i)
+                ok &= buffer[alignment + i] == 0x5a;
+            for (size_t i = alignment + size; i < buffer_size; ++i)
+                ok &= buffer[i] == 0;
+            EXPECT(ok);
+        }
+    }
+}
+
+TEST_CASE(memcmp_difference_positions)
+{
+    u8 a[buffer_size];
+    u8 b[buffer_size];
+    for (size_t i = 0; i < buffer_size; ++i)
+        a[i] = b[i] = (u8)i;
+
+    EXPECT_EQ(memcmp(a, b, buffer_size), 0);
+
+    for (size_t position = 0; position < max_tested_size; ++position) {
+        b[position] = a[position] + 1;
+        EXPECT(memcmp(a, b, buffer_size) < 0);
+        EXPECT(memcmp(b, a, buffer_size) > 0);
+        EXPECT_EQ(memcmp(a, b, position), 0);
+        b[position] = a[position];
+    }
+}
+
+TEST_CASE(strlen_sizes_and_alignments)
+{
+    char buffer[buffer_size];
+    for (size_t length = 0; length < max_tested_size; ++length) {
+        for (size_t alignment = 0; alignment < max_tested_alignment; ++alignment) {
+            for (size_t i = 0; i < buffer_size; ++i)
+                buffer[i] = 'x';
+            buffer[alignment + length] = '\0';
+            EXPECT_EQ(strlen(buffer + alignment), length);
+        }
+    }
+}
+
+// Most copies in the system are under 128 bytes, so that's what the
+// benchmarks hammer on; one large case sanity-checks bulk throughput.
+
+BENCHMARK_CASE(small_memcpy)
+{
+    static u8 src[4096];
+    static u8 dest[4096];
+    for (size_t iteration = 0; iteration < 10'000'000; ++iteration) {
+        size_t size = 1 + (iteration * 7) % 127;
+        memcpy(dest + (iteration % 61), src + (iteration % 53), size);
+    }
+}
+
+BENCHMARK_CASE(small_memset)
+{
+    static u8 buffer[4096];
+    for (size_t iteration = 0; iteration < 10'000'000; ++iteration) {
+        size_t size = 1 + (iteration * 7) % 127;
+        memset(buffer + (iteration % 61), (int)iteration, size);
+    }
+}
+
+BENCHMARK_CASE(large_memcpy)
+{
+    static u8 src[1 * MiB];
+    static u8 dest[1 * MiB];
+    for (size_t iteration = 0; iteration < 1'000; ++iteration)
+        memcpy(dest, src, sizeof(src));
+}
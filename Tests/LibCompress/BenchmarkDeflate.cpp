@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteBuffer.h>
+#include <LibCompress/Deflate.h>
+
+// Deterministic, mildly compressible input so runs are comparable between builds.
+static ByteBuffer make_benchmark_input()
+{
+    auto buffer = ByteBuffer::create_uninitialized(512 * KiB).value();
+    u32 state = 42;
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        state = state * 1664525 + 1013904223;
+        buffer[i] = "ABCDEFGHIJKLMNOP"[(state >> 28) & 0xF];
+    }
+    return buffer;
+}
+
+BENCHMARK_CASE(deflate_compress)
+{
+    const auto input = make_benchmark_input();
+    const auto compressed = Compress::DeflateCompressor::compress_all(input);
+    EXPECT(compressed.has_value());
+    EXPECT(compressed.value().size() < input.size());
+}
+
+BENCHMARK_CASE(deflate_decompress)
+{
+    const auto input = make_benchmark_input();
+    const auto compressed = Compress::DeflateCompressor::compress_all(input);
+    EXPECT(compressed.has_value());
+
+    for (int i = 0; i < 10; ++i) {
+        const auto decompressed = Compress::DeflateDecompressor::decompress_all(compressed.value());
+        EXPECT(decompressed.has_value());
+        EXPECT(decompressed.value() == input);
+    }
+}
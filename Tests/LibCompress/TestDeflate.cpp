@@ -28,7 +28,7 @@ TEST_CASE(canonical_code_simple)
 
     const auto huffman = Compress::CanonicalCode::from_bytes(code).value();
     auto memory_stream = InputMemoryStream { input };
-    auto bit_stream = InputBitStream { memory_stream };
+    auto bit_stream = LittleEndianInputBitStream { memory_stream };
 
     for (size_t idx = 0; idx < 9; ++idx)
         EXPECT_EQ(huffman.read_symbol(bit_stream), output[idx]);
@@ -48,7 +48,7 @@ TEST_CASE(canonical_code_complex)
 
     const auto huffman = Compress::CanonicalCode::from_bytes(code).value();
     auto memory_stream = InputMemoryStream { input };
-    auto bit_stream = InputBitStream { memory_stream };
+    auto bit_stream = LittleEndianInputBitStream { memory_stream };
 
     for (size_t idx = 0; idx < 12; ++idx)
         EXPECT_EQ(huffman.read_symbol(bit_stream), output[idx]);
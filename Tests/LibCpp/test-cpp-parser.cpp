@@ -24,6 +24,35 @@ static String read_all(const String& path)
     return { reinterpret_cast<const char*>(content.data()), content.size() };
 }
 
+TEST_CASE(test_incremental_reparse)
+{
+    constexpr auto original_source =
+        "int first() { return 1; }\n"
+        "int second() { return 2; }\n"
+        "int third() { return 3; }\n"sv;
+    constexpr auto edited_source =
+        "int first() { return 1; }\n"
+        "int second() { return 42; }\n"
+        "int third() { return 3; }\n"sv;
+
+    Cpp::Preprocessor preprocessor("test.cpp", original_source);
+    Cpp::Parser parser(preprocessor.process_and_lex(), "test.cpp");
+    auto root = parser.parse();
+    EXPECT(parser.errors().is_empty());
+    EXPECT_EQ(root->declarations().size(), 3u);
+
+    Cpp::Preprocessor edited_preprocessor("test.cpp", edited_source);
+    Cpp::Parser edited_parser(edited_preprocessor.process_and_lex(), "test.cpp");
+    auto edited_root = edited_parser.parse_incremental(parser);
+    EXPECT(edited_parser.errors().is_empty());
+    EXPECT_EQ(edited_root->declarations().size(), 3u);
+
+    // The declarations around the edit are reused, the edited one is reparsed.
+    EXPECT_EQ(&edited_root->declarations()[0], &root->declarations()[0]);
+    EXPECT(&edited_root->declarations()[1] != &root->declarations()[1]);
+    EXPECT_EQ(&edited_root->declarations()[2], &root->declarations()[2]);
+}
+
 TEST_CASE(test_regression)
 {
     Core::DirIterator directory_iterator(TESTS_ROOT_DIR, Core::DirIterator::Flags::SkipDots);
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibJS/Interpreter.h>
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibJS/Runtime/GlobalObject.h>
+
+static constexpr auto fibonacci_source = R"~~~(
+    function fibonacci(n) {
+        if (n < 2)
+            return n;
+        return fibonacci(n - 1) + fibonacci(n - 2);
+    }
+    fibonacci(16);
+)~~~";
+
+BENCHMARK_CASE(parse_program)
+{
+    for (int i = 0; i < 100; ++i) {
+        auto parser = JS::Parser(JS::Lexer(fibonacci_source));
+        (void)parser.parse_program();
+        EXPECT(!parser.has_errors());
+    }
+}
+
+BENCHMARK_CASE(parse_and_run_program)
+{
+    auto vm = JS::VM::create();
+    auto interpreter = JS::Interpreter::create<JS::GlobalObject>(*vm);
+
+    for (int i = 0; i < 10; ++i) {
+        auto parser = JS::Parser(JS::Lexer(fibonacci_source));
+        auto program = parser.parse_program();
+        EXPECT(!parser.has_errors());
+
+        interpreter->run(interpreter->global_object(), *program);
+        EXPECT(!interpreter->exception());
+    }
+}
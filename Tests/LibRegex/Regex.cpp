@@ -691,6 +691,109 @@ TEST_CASE(ECMA262_match)
     }
 }
 
+TEST_CASE(dfa_tier)
+{
+    // These patterns have no captures or backreferences, so they run on the
+    // lazy-DFA tier (see RegexDfa.h); the results must be exactly what the
+    // backtracker would produce.
+    {
+        // Exponential for a backtracker, linear for the DFA.
+        Regex<ECMA262> re("(?:a|a)*b");
+        EXPECT_EQ(re.search("aaaaaaaaaaaaaaaaaaaaaaaaaaaax"sv).success, false);
+        EXPECT_EQ(re.search("aaaaaaaaaaaaaaaaaaaaaaaaaaaab"sv).success, true);
+    }
+    {
+        // Leftmost-first: the first alternative wins even though the second
+        // one could match more.
+        Regex<ECMA262> re("ab|abc");
+        auto result = re.search("xxabc"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.first().view.length(), 2u);
+    }
+    {
+        // Greedy and lazy quantifiers keep their meaning.
+        Regex<ECMA262> greedy("a.*c");
+        auto result = greedy.search("xacyc"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.first().view.length(), 4u);
+
+        Regex<ECMA262> lazy("a.*?c");
+        result = lazy.search("xacyc"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.first().view.length(), 2u);
+    }
+    {
+        // Anchors, including a $ that only resolves at the very end.
+        Regex<ECMA262> re("^ab|cd$");
+        auto result = re.search("abxxcd"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.count, 2u);
+        EXPECT_EQ(result.matches.at(0).global_offset, 0u);
+        EXPECT_EQ(result.matches.at(1).global_offset, 4u);
+    }
+}
+
+TEST_CASE(prefilter)
+{
+    // These exercise the candidate prefilter (see RegexPrefilter.h), which
+    // must only ever skip positions that cannot start a match.
+    {
+        // Literal prefix, found via memmem().
+        Regex<ECMA262> re("needle[0-9]");
+        auto result = re.search("haystack needle7 and needle8 but not needle!"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.count, 2u);
+        EXPECT_EQ(result.matches.at(0).global_offset, 9u);
+        EXPECT_EQ(result.matches.at(1).global_offset, 21u);
+    }
+    {
+        // Alternatives only pin down a set of first bytes.
+        Regex<ECMA262> re("(cat|dog)s");
+        auto result = re.search("catfish, dogs, cats"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.count, 2u);
+        EXPECT_EQ(result.matches.at(0).global_offset, 9u);
+        EXPECT_EQ(result.matches.at(1).global_offset, 15u);
+    }
+    {
+        // Case-insensitivity falls back to the byte set.
+        Regex<ECMA262> re("needle", ECMAScriptFlags::Insensitive);
+        auto result = re.search("hay NeEdLe hay"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.first().global_offset, 4u);
+    }
+    {
+        // Patterns that can match the empty string get no prefilter and
+        // still produce all their matches.
+        Regex<ECMA262> re("x*");
+        auto result = re.search("axa"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.count, 3u);
+    }
+}
+
+TEST_CASE(pattern_cache_reuse)
+{
+    // Recompiling the same (pattern, flags) pair comes out of the pattern
+    // cache; the copies must behave exactly like a fresh compile.
+    for (int i = 0; i < 3; ++i) {
+        Regex<ECMA262> re("a(b+)c");
+        auto result = re.match("abbc"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.capture_group_matches.first().first().view.to_string(), "bb");
+    }
+    // Same pattern text, different flags: separate cache entries.
+    Regex<ECMA262> sensitive("abc");
+    Regex<ECMA262> insensitive("abc", ECMAScriptFlags::Insensitive);
+    EXPECT_EQ(sensitive.match("ABC"sv).success, false);
+    EXPECT_EQ(insensitive.match("ABC"sv).success, true);
+    // Failed parses are not cached and keep reporting their error.
+    for (int i = 0; i < 2; ++i) {
+        Regex<ECMA262> broken("(a");
+        EXPECT_NE(broken.parser_result.error, regex::Error::NoError);
+    }
+}
+
 TEST_CASE(ECMA262_unicode_match)
 {
     struct _test {
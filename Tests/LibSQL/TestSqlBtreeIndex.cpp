@@ -314,3 +314,92 @@ TEST_CASE(btree_scan_50_keys)
 {
     insert_into_and_scan_btree(50);
 }
+
+TEST_CASE(btree_bulk_load)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        SQL::Serializer serializer(heap);
+        auto btree = setup_btree(serializer);
+
+        Vector<SQL::Key> batch;
+        for (auto ix = 0u; ix < sizeof(keys) / sizeof(int); ix++) {
+            SQL::Key k(btree->descriptor());
+            k[0] = keys[ix];
+            k.set_pointer(pointers[ix]);
+            batch.append(k);
+        }
+        EXPECT(btree->bulk_load(move(batch)));
+    }
+
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        SQL::Serializer serializer(heap);
+        auto btree = setup_btree(serializer);
+
+        for (auto ix = 0u; ix < sizeof(keys) / sizeof(int); ix++) {
+            SQL::Key k(btree->descriptor());
+            k[0] = keys[ix];
+            auto pointer_opt = btree->get(k);
+            VERIFY(pointer_opt.has_value());
+            EXPECT_EQ(pointer_opt.value(), pointers[ix]);
+        }
+    }
+}
+
+TEST_CASE(btree_bulk_load_multiple_levels)
+{
+    constexpr int num_keys = 2000;
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        SQL::Serializer serializer(heap);
+        auto btree = setup_btree(serializer);
+
+        Vector<SQL::Key> batch;
+        for (auto ix = 0; ix < num_keys; ix++) {
+            SQL::Key k(btree->descriptor());
+            // Hand the keys over in a scrambled order:
+            k[0] = (ix * 521) % num_keys;
+            k.set_pointer(ix);
+            batch.append(k);
+        }
+        EXPECT(btree->bulk_load(move(batch)));
+    }
+
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        SQL::Serializer serializer(heap);
+        auto btree = setup_btree(serializer);
+
+        int count = 0;
+        SQL::Tuple prev;
+        for (auto iter = btree->begin(); !iter.is_end(); iter++, count++) {
+            auto key = (*iter);
+            if (prev.size()) {
+                EXPECT(prev < key);
+            }
+            EXPECT_EQ((int)key[0], (int)((key.pointer() * 521) % num_keys));
+            prev = key;
+        }
+        EXPECT_EQ(count, num_keys);
+    }
+}
+
+TEST_CASE(btree_bulk_load_rejects_duplicates)
+{
+    ScopeGuard guard([]() { unlink("/tmp/test.db"); });
+    auto heap = SQL::Heap::construct("/tmp/test.db");
+    SQL::Serializer serializer(heap);
+    auto btree = setup_btree(serializer);
+
+    Vector<SQL::Key> batch;
+    for (auto ix = 0; ix < 3; ix++) {
+        SQL::Key k(btree->descriptor());
+        k[0] = 42;
+        k.set_pointer(ix);
+        batch.append(k);
+    }
+    EXPECT(!btree->bulk_load(move(batch)));
+}
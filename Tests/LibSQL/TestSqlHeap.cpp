@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <unistd.h>
+
+#include <AK/ScopeGuard.h>
+#include <LibSQL/Heap.h>
+#include <LibTest/TestCase.h>
+
+static ByteBuffer make_block(u8 fill)
+{
+    auto buffer = ByteBuffer::create_zeroed(SQL::BLOCKSIZE).release_value();
+    memset(buffer.data(), fill, buffer.size());
+    return buffer;
+}
+
+static void remove_heap_files()
+{
+    unlink("/tmp/test.db");
+    unlink("/tmp/test.db.wal");
+}
+
+static void copy_file(char const* from, char const* to)
+{
+    auto source = fopen(from, "rb");
+    VERIFY(source);
+    auto destination = fopen(to, "wb");
+    VERIFY(destination);
+    char buffer[4096];
+    size_t nread;
+    while ((nread = fread(buffer, 1, sizeof(buffer), source)) > 0)
+        VERIFY(fwrite(buffer, 1, nread, destination) == nread);
+    fclose(source);
+    fclose(destination);
+}
+
+TEST_CASE(heap_write_flush_read)
+{
+    ScopeGuard guard([]() { remove_heap_files(); });
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        for (u32 ix = 0; ix < 4; ix++) {
+            auto pointer = heap->new_record_pointer();
+            auto buffer = make_block(ix + 1);
+            heap->add_to_wal(pointer, buffer);
+        }
+        heap->flush();
+    }
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        for (u32 ix = 0; ix < 4; ix++) {
+            auto block_or_error = heap->read_block(ix + 1);
+            EXPECT(!block_or_error.is_error());
+            EXPECT_EQ(*block_or_error.value().offset_pointer(0), ix + 1);
+        }
+    }
+}
+
+TEST_CASE(heap_reads_dirty_blocks_from_cache)
+{
+    ScopeGuard guard([]() { remove_heap_files(); });
+    auto heap = SQL::Heap::construct("/tmp/test.db");
+    auto pointer = heap->new_record_pointer();
+    auto buffer = make_block(0x42);
+    heap->add_to_wal(pointer, buffer);
+
+    // The block was never flushed, so this can only be served by the pool.
+    auto block_or_error = heap->read_block(pointer);
+    EXPECT(!block_or_error.is_error());
+    EXPECT_EQ(*block_or_error.value().offset_pointer(0), 0x42u);
+}
+
+TEST_CASE(heap_eviction_keeps_blocks_readable)
+{
+    ScopeGuard guard([]() { remove_heap_files(); });
+    auto heap = SQL::Heap::construct("/tmp/test.db");
+    heap->set_cache_block_limit(4);
+
+    constexpr u32 num_blocks = 32;
+    Vector<u32> pointers;
+    for (u32 ix = 0; ix < num_blocks; ix++) {
+        auto pointer = heap->new_record_pointer();
+        auto buffer = make_block(ix + 1);
+        heap->add_to_wal(pointer, buffer);
+        pointers.append(pointer);
+    }
+    heap->flush();
+
+    // Way more blocks than the pool will hold; every one must still come
+    // back intact, whether it's served from the cache or re-read from disk.
+    for (u32 ix = 0; ix < num_blocks; ix++) {
+        auto block_or_error = heap->read_block(pointers[ix]);
+        EXPECT(!block_or_error.is_error());
+        EXPECT_EQ(*block_or_error.value().offset_pointer(0), ix + 1);
+    }
+}
+
+TEST_CASE(heap_pinned_blocks_survive_eviction_pressure)
+{
+    ScopeGuard guard([]() { remove_heap_files(); });
+    auto heap = SQL::Heap::construct("/tmp/test.db");
+    heap->set_cache_block_limit(4);
+
+    constexpr u32 num_blocks = 32;
+    Vector<u32> pointers;
+    for (u32 ix = 0; ix < num_blocks; ix++) {
+        auto pointer = heap->new_record_pointer();
+        auto buffer = make_block(ix + 1);
+        heap->add_to_wal(pointer, buffer);
+        pointers.append(pointer);
+    }
+    heap->flush();
+    heap->checkpoint();
+
+    // A pinned page must keep pointing at valid data while everything
+    // around it gets evicted.
+    auto pinned = heap->pin_block(pointers[0]);
+    EXPECT_EQ(*pinned.offset_pointer(0), 1u);
+    for (u32 ix = 1; ix < num_blocks; ix++) {
+        auto block_or_error = heap->read_block(pointers[ix]);
+        EXPECT(!block_or_error.is_error());
+    }
+    EXPECT_EQ(*pinned.offset_pointer(0), 1u);
+    heap->unpin_block(pointers[0]);
+
+    // Once unpinned the page is evictable again, but still readable.
+    for (u32 ix = 1; ix < num_blocks; ix++)
+        (void)heap->read_block(pointers[ix]);
+    auto block_or_error = heap->read_block(pointers[0]);
+    EXPECT(!block_or_error.is_error());
+    EXPECT_EQ(*block_or_error.value().offset_pointer(0), 1u);
+}
+
+TEST_CASE(heap_replays_wal_after_crash)
+{
+    ScopeGuard guard([]() {
+        remove_heap_files();
+        unlink("/tmp/crashed.db");
+        unlink("/tmp/crashed.db.wal");
+    });
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        for (u32 ix = 0; ix < 4; ix++) {
+            auto pointer = heap->new_record_pointer();
+            auto buffer = make_block(ix + 1);
+            heap->add_to_wal(pointer, buffer);
+        }
+        heap->flush();
+
+        // Simulate a crash between commit and checkpoint: snapshot the heap
+        // file and the log as they are right now, before the destructor gets
+        // a chance to checkpoint.
+        copy_file("/tmp/test.db", "/tmp/crashed.db");
+        copy_file("/tmp/test.db.wal", "/tmp/crashed.db.wal");
+    }
+    {
+        auto heap = SQL::Heap::construct("/tmp/crashed.db");
+        for (u32 ix = 0; ix < 4; ix++) {
+            auto block_or_error = heap->read_block(ix + 1);
+            EXPECT(!block_or_error.is_error());
+            EXPECT_EQ(*block_or_error.value().offset_pointer(0), ix + 1);
+        }
+    }
+}
+
+TEST_CASE(heap_discards_torn_wal_tail)
+{
+    ScopeGuard guard([]() { remove_heap_files(); });
+    u32 pointer = 0;
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        pointer = heap->new_record_pointer();
+        auto buffer = make_block(0x17);
+        heap->add_to_wal(pointer, buffer);
+        heap->flush();
+        heap->checkpoint();
+    }
+    {
+        // Append half a page record to the log, as a crash in the middle of
+        // a commit would.
+        auto wal = fopen("/tmp/test.db.wal", "ab");
+        VERIFY(wal);
+        u32 block = pointer;
+        VERIFY(fwrite(&block, 1, sizeof(u32), wal) == sizeof(u32));
+        char garbage[17] = {};
+        VERIFY(fwrite(garbage, 1, sizeof(garbage), wal) == sizeof(garbage));
+        fclose(wal);
+    }
+    {
+        auto heap = SQL::Heap::construct("/tmp/test.db");
+        auto block_or_error = heap->read_block(pointer);
+        EXPECT(!block_or_error.is_error());
+        EXPECT_EQ(*block_or_error.value().offset_pointer(0), 0x17u);
+    }
+}
@@ -18,7 +18,7 @@ namespace {
 
 constexpr const char* db_name = "/tmp/test.db";
 
-RefPtr<SQL::SQLResult> execute(NonnullRefPtr<SQL::Database> database, String const& sql)
+RefPtr<SQL::SQLResult> execute(NonnullRefPtr<SQL::Database> database, String const& sql, Vector<SQL::Value> placeholder_values = {})
 {
     auto parser = SQL::AST::Parser(SQL::AST::Lexer(sql));
     auto statement = parser.next_statement();
@@ -27,6 +27,7 @@ RefPtr<SQL::SQLResult> execute(NonnullRefPtr<SQL::Database> database, String con
         outln(parser.errors()[0].to_string());
     }
     SQL::AST::ExecutionContext context { database };
+    context.placeholder_values = move(placeholder_values);
     auto result = statement->execute(context);
     EXPECT(result->error().code == SQL::SQLErrorCode::NoError);
     return result;
@@ -98,4 +99,74 @@ TEST_CASE(select_from_table)
     EXPECT_EQ(result->results().size(), 5u);
 }
 
+TEST_CASE(select_with_where_clause)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    create_table(database);
+    auto result = execute(database, "INSERT INTO TestSchema.TestTable ( TextColumn, IntColumn ) VALUES ( 'Test_1', 42 ), ( 'Test_2', 43 ), ( 'Test_3', 44 ), ( 'Test_4', 45 ), ( 'Test_5', 46 );");
+    EXPECT(result->inserted() == 5);
+
+    result = execute(database, "SELECT * FROM TestSchema.TestTable WHERE IntColumn = 44;");
+    EXPECT(result->has_results());
+    EXPECT_EQ(result->results().size(), 1u);
+    EXPECT_EQ(result->results()[0][0].to_string(), "Test_3");
+
+    result = execute(database, "SELECT * FROM TestSchema.TestTable WHERE IntColumn > 44;");
+    EXPECT(result->has_results());
+    EXPECT_EQ(result->results().size(), 2u);
+
+    result = execute(database, "SELECT * FROM TestSchema.TestTable WHERE IntColumn >= 43 AND IntColumn < 46;");
+    EXPECT(result->has_results());
+    EXPECT_EQ(result->results().size(), 3u);
+
+    result = execute(database, "SELECT * FROM TestSchema.TestTable WHERE TextColumn = 'Test_1' OR IntColumn = 46;");
+    EXPECT(result->has_results());
+    EXPECT_EQ(result->results().size(), 2u);
+
+    result = execute(database, "SELECT * FROM TestSchema.TestTable WHERE IntColumn = 123;");
+    EXPECT_EQ(result->results().size(), 0u);
+}
+
+TEST_CASE(select_with_invalid_where_clause)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    create_table(database);
+    auto result = execute(database, "INSERT INTO TestSchema.TestTable ( TextColumn, IntColumn ) VALUES ( 'Test_1', 42 );");
+    EXPECT(result->inserted() == 1);
+
+    auto execute_expecting_error = [&](String const& sql, SQL::SQLErrorCode expected_code) {
+        auto parser = SQL::AST::Parser(SQL::AST::Lexer(sql));
+        auto statement = parser.next_statement();
+        EXPECT(!parser.has_errors());
+        SQL::AST::ExecutionContext context { database };
+        auto error_result = statement->execute(context);
+        EXPECT(error_result->error().code == expected_code);
+    };
+
+    // A bad WHERE clause is client-supplied SQL, so it must come back as an
+    // SQL error rather than crash the server.
+    execute_expecting_error("SELECT * FROM TestSchema.TestTable WHERE NoSuchColumn = 1;", SQL::SQLErrorCode::ColumnDoesNotExist);
+    execute_expecting_error("SELECT * FROM TestSchema.TestTable WHERE TextColumn AND IntColumn;", SQL::SQLErrorCode::BooleanOperatorTypeMismatch);
+    execute_expecting_error("SELECT * FROM TestSchema.TestTable WHERE IntColumn + 1 = 43;", SQL::SQLErrorCode::NotYetImplemented);
+}
+
+TEST_CASE(insert_and_select_with_placeholders)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = SQL::Database::construct(db_name);
+    create_table(database);
+
+    auto insert = "INSERT INTO TestSchema.TestTable ( TextColumn, IntColumn ) VALUES ( ?, ? );";
+    auto result = execute(database, insert, { SQL::Value("Test_1"), SQL::Value(42) });
+    EXPECT(result->inserted() == 1);
+    result = execute(database, insert, { SQL::Value("Test_2"), SQL::Value(43) });
+    EXPECT(result->inserted() == 1);
+
+    result = execute(database, "SELECT * FROM TestSchema.TestTable WHERE IntColumn = ?;", { SQL::Value(43) });
+    EXPECT_EQ(result->results().size(), 1u);
+    EXPECT_EQ(result->results()[0][0].to_string(), "Test_2");
+}
+
 }
@@ -26,6 +26,7 @@ void PDFViewer::set_document(RefPtr<PDF::Document> document)
     m_current_page_index = document->get_first_page_index();
     m_zoom_level = initial_zoom_level;
     m_rendered_page_list.clear();
+    m_rendered_page_lru.clear();
 
     m_rendered_page_list.ensure_capacity(document->get_page_count());
     for (u32 i = 0; i < document->get_page_count(); i++)
@@ -36,6 +37,13 @@ void PDFViewer::set_document(RefPtr<PDF::Document> document)
 
 RefPtr<Gfx::Bitmap> PDFViewer::get_rendered_page(u32 index)
 {
+    // Rendered pages are kept in LRU order, so flipping back and forth
+    // between nearby pages doesn't re-render them every time
+    m_rendered_page_lru.remove_first_matching([index](u32 page_index) { return page_index == index; });
+    m_rendered_page_lru.append(index);
+    if (m_rendered_page_lru.size() > maximum_rendered_pages_to_keep)
+        m_rendered_page_list[m_rendered_page_lru.take_first()].clear();
+
     auto& rendered_page_map = m_rendered_page_list[index];
     auto existing_rendered_page = rendered_page_map.get(m_zoom_level);
     if (existing_rendered_page.has_value())
@@ -121,6 +129,7 @@ void PDFViewer::timer_event(Core::TimerEvent&)
         if (i != m_current_page_index)
             m_rendered_page_list[i].clear();
     }
+    m_rendered_page_lru.remove_all_matching([this](u32 page_index) { return page_index != m_current_page_index; });
 }
 
 void PDFViewer::zoom_in()
@@ -35,6 +35,8 @@ static constexpr size_t number_of_zoom_levels = sizeof(zoom_levels) / sizeof(zoo
 
 static constexpr size_t initial_zoom_level = 8;
 
+static constexpr size_t maximum_rendered_pages_to_keep = 5;
+
 class PDFViewer : public GUI::AbstractScrollableWidget {
     C_OBJECT(PDFViewer)
 
@@ -66,6 +68,7 @@ private:
     RefPtr<PDF::Document> m_document;
     u32 m_current_page_index { 0 };
     Vector<HashMap<u32, RefPtr<Gfx::Bitmap>>> m_rendered_page_list;
+    Vector<u32> m_rendered_page_lru;
 
     u8 m_zoom_level { initial_zoom_level };
 };
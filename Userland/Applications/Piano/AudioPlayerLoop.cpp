@@ -31,7 +31,7 @@ AudioPlayerLoop::AudioPlayerLoop(TrackManager& track_manager, bool& need_to_writ
         (void)buffer_id;
         enqueue_audio();
     };
-    m_resampler = Audio::ResampleHelper<double>(Music::sample_rate, m_audio_client->get_sample_rate());
+    m_resampler = Audio::PolyphaseResampler(Music::sample_rate, m_audio_client->get_sample_rate());
 }
 
 void AudioPlayerLoop::enqueue_audio()
@@ -31,7 +31,7 @@ void PlaybackManager::set_loader(NonnullRefPtr<Audio::Loader>&& loader)
         m_device_samples_per_buffer = PlaybackManager::buffer_size_ms / 1000.0f * m_device_sample_rate;
         u32 source_samples_per_buffer = PlaybackManager::buffer_size_ms / 1000.0f * m_loader->sample_rate();
         m_source_buffer_size_bytes = source_samples_per_buffer * m_loader->num_channels() * m_loader->bits_per_sample() / 8;
-        m_resampler = Audio::ResampleHelper<double>(m_loader->sample_rate(), m_device_sample_rate);
+        m_resampler = Audio::PolyphaseResampler(m_loader->sample_rate(), m_device_sample_rate);
         m_timer->start();
     } else {
         m_timer->stop();
@@ -44,6 +44,8 @@ void PlaybackManager::stop()
     m_connection->clear_buffer(true);
     m_last_seek = 0;
     m_current_buffer = nullptr;
+    if (m_resampler.has_value())
+        m_resampler->reset();
 
     if (m_loader)
         m_loader->reset();
@@ -70,6 +72,8 @@ void PlaybackManager::seek(const int position)
 
     m_connection->clear_buffer(true);
     m_current_buffer = nullptr;
+    if (m_resampler.has_value())
+        m_resampler->reset();
     m_loader->seek(position);
 
     if (!paused_state)
@@ -120,7 +124,6 @@ void PlaybackManager::next_buffer()
         m_current_buffer = m_loader->get_more_samples(m_source_buffer_size_bytes);
         if (m_current_buffer) {
             VERIFY(m_resampler.has_value());
-            m_resampler->reset();
             m_current_buffer = Audio::resample_buffer(m_resampler.value(), *m_current_buffer);
             m_connection->enqueue(*m_current_buffer);
         }
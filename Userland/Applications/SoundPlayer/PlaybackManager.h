@@ -10,6 +10,7 @@
 #include <LibAudio/Buffer.h>
 #include <LibAudio/ClientConnection.h>
 #include <LibAudio/Loader.h>
+#include <LibAudio/Resampler.h>
 #include <LibCore/Timer.h>
 
 class PlaybackManager final {
@@ -52,7 +53,7 @@ private:
     RefPtr<Audio::Loader> m_loader { nullptr };
     NonnullRefPtr<Audio::ClientConnection> m_connection;
     RefPtr<Audio::Buffer> m_current_buffer;
-    Optional<Audio::ResampleHelper<double>> m_resampler;
+    Optional<Audio::PolyphaseResampler> m_resampler;
     RefPtr<Core::Timer> m_timer;
 
     // Controls the GUI update rate. A smaller value makes the visualizations nicer.
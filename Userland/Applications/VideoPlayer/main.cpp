@@ -9,6 +9,7 @@
 #include <LibGUI/BoxLayout.h>
 #include <LibGUI/ImageWidget.h>
 #include <LibGUI/Window.h>
+#include <AK/MappedFile.h>
 #include <LibGfx/Bitmap.h>
 #include <LibVideo/MatroskaReader.h>
 #include <LibVideo/VP9/Decoder.h>
@@ -18,7 +19,17 @@ int main(int argc, char** argv)
     auto app = GUI::Application::construct(argc, argv);
     auto window = GUI::Window::construct();
 
-    auto document = Video::MatroskaReader::parse_matroska_from_file("/home/anon/Videos/test-webm.webm");
+    auto mapped_file_result = MappedFile::map("/home/anon/Videos/test-webm.webm");
+    if (mapped_file_result.is_error())
+        return 1;
+    auto mapped_file = mapped_file_result.release_value();
+
+    // Demux the file cluster-at-a-time instead of parsing the whole thing
+    // up front, so decoding can start as soon as the headers are in.
+    Video::MatroskaReader reader((u8 const*)mapped_file->data(), mapped_file->size());
+    auto document = reader.parse_header();
+    if (!document)
+        return 1;
     auto const& optional_track = document->track_for_track_type(Video::TrackEntry::TrackType::Video);
     if (!optional_track.has_value())
         return 1;
@@ -35,8 +46,8 @@ int main(int argc, char** argv)
     main_widget.add_child(image_widget);
 
     Video::VP9::Decoder vp9_decoder;
-    for (auto const& cluster : document->clusters()) {
-        for (auto const& block : cluster.blocks()) {
+    while (auto cluster = reader.next_cluster()) {
+        for (auto const& block : cluster->blocks()) {
             if (block.track_number() != track.track_number())
                 continue;
 
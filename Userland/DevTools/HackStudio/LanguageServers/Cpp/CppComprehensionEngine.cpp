@@ -43,7 +43,7 @@ const CppComprehensionEngine::DocumentData* CppComprehensionEngine::get_document
     return document_data.value();
 }
 
-OwnPtr<CppComprehensionEngine::DocumentData> CppComprehensionEngine::create_document_data_for(const String& file)
+OwnPtr<CppComprehensionEngine::DocumentData> CppComprehensionEngine::create_document_data_for(const String& file, OwnPtr<DocumentData> previous_document)
 {
     if (m_unfinished_documents.contains(file)) {
         return {};
@@ -53,7 +53,7 @@ OwnPtr<CppComprehensionEngine::DocumentData> CppComprehensionEngine::create_docu
     auto document = filedb().get_or_create_from_filesystem(file);
     if (!document)
         return {};
-    return create_document_data(document->text(), file);
+    return create_document_data(document->text(), file, move(previous_document));
 }
 
 void CppComprehensionEngine::set_document_data(const String& file, OwnPtr<DocumentData>&& data)
@@ -386,7 +386,16 @@ String CppComprehensionEngine::document_path_from_include_path(const StringView&
 
 void CppComprehensionEngine::on_edit(const String& file)
 {
-    set_document_data(file, create_document_data_for(file));
+    // Hand the previous generation of the document over so the new parse
+    // can reuse the token stream and AST outside the edited range.
+    auto absolute_path = filedb().to_absolute_path(file);
+    OwnPtr<DocumentData> previous_document;
+    auto it = m_documents.find(absolute_path);
+    if (it != m_documents.end()) {
+        previous_document = move(it->value);
+        m_documents.remove(it);
+    }
+    set_document_data(file, create_document_data_for(file, move(previous_document)));
 }
 
 void CppComprehensionEngine::file_opened([[maybe_unused]] const String& file)
@@ -567,7 +576,7 @@ GUI::AutocompleteProvider::DeclarationType CppComprehensionEngine::type_of_decla
     return GUI::AutocompleteProvider::DeclarationType::Variable;
 }
 
-OwnPtr<CppComprehensionEngine::DocumentData> CppComprehensionEngine::create_document_data(String&& text, const String& filename)
+OwnPtr<CppComprehensionEngine::DocumentData> CppComprehensionEngine::create_document_data(String&& text, const String& filename, OwnPtr<DocumentData> previous_document)
 {
     auto document_data = make<DocumentData>();
     document_data->m_filename = filename;
@@ -600,7 +609,21 @@ OwnPtr<CppComprehensionEngine::DocumentData> CppComprehensionEngine::create_docu
 
     document_data->m_parser = make<Parser>(move(tokens), filename);
 
-    auto root = document_data->parser().parse();
+    // Reparse incrementally against the previous generation when we have
+    // one, reusing unchanged declarations. Since reused nodes reference the
+    // text of the parse that created them, previous generations have to be
+    // retained; a full reparse every so often rebuilds everything against
+    // the current text so the retained chain stays bounded.
+    constexpr size_t maximum_incremental_generations = 32;
+    RefPtr<TranslationUnit> root;
+    if (previous_document && previous_document->m_incremental_generation < maximum_incremental_generations) {
+        auto& previous_parser = previous_document->parser();
+        document_data->m_incremental_generation = previous_document->m_incremental_generation + 1;
+        document_data->m_previous_document = move(previous_document);
+        root = document_data->parser().parse_incremental(previous_parser);
+    } else {
+        root = document_data->parser().parse();
+    }
 
     if constexpr (CPP_LANGUAGE_SERVER_DEBUG)
         root->dump();
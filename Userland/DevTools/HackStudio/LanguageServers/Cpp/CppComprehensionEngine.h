@@ -92,6 +92,12 @@ private:
 
         HashMap<SymbolName, Symbol> m_symbols;
         HashTable<String> m_available_headers;
+
+        // AST nodes reused by an incremental reparse keep referencing the
+        // text (and preprocessor storage) of the parse that created them,
+        // so earlier generations of this document are kept alive here.
+        OwnPtr<DocumentData> m_previous_document;
+        size_t m_incremental_generation { 0 };
     };
 
     Vector<GUI::AutocompleteProvider::Entry> autocomplete_property(const DocumentData&, const MemberExpression&, const String partial_text) const;
@@ -116,7 +122,7 @@ private:
     const DocumentData* get_or_create_document_data(const String& file);
     void set_document_data(const String& file, OwnPtr<DocumentData>&& data);
 
-    OwnPtr<DocumentData> create_document_data_for(const String& file);
+    OwnPtr<DocumentData> create_document_data_for(const String& file, OwnPtr<DocumentData> previous_document = {});
     String document_path_from_include_path(const StringView& include_path) const;
     void update_declared_symbols(DocumentData&);
     void update_todo_entries(DocumentData&);
@@ -126,7 +132,7 @@ private:
 
     Optional<GUI::AutocompleteProvider::ProjectLocation> find_preprocessor_definition(const DocumentData&, const GUI::TextPosition&);
 
-    OwnPtr<DocumentData> create_document_data(String&& text, const String& filename);
+    OwnPtr<DocumentData> create_document_data(String&& text, const String& filename, OwnPtr<DocumentData> previous_document = {});
     Optional<Vector<GUI::AutocompleteProvider::Entry>> try_autocomplete_property(const DocumentData&, const ASTNode&, Optional<Token> containing_token) const;
     Optional<Vector<GUI::AutocompleteProvider::Entry>> try_autocomplete_name(const DocumentData&, const ASTNode&, Optional<Token> containing_token) const;
     Optional<Vector<GUI::AutocompleteProvider::Entry>> try_autocomplete_include(const DocumentData&, Token include_path_token);
@@ -404,7 +404,7 @@ MmapRegion const* Emulator::load_library_from_address(FlatPtr address)
             return {};
 
         auto image = make<ELF::Image>(file_or_error.value()->bytes());
-        auto debug_info = make<Debug::DebugInfo>(*image);
+        auto debug_info = make<Debug::DebugInfo>(*image, String {}, 0, lib_path);
         m_dynamic_library_cache.set(lib_path, CachedELF { file_or_error.release_value(), move(debug_info), move(image) });
     }
     return region;
@@ -210,6 +210,9 @@ u32 Emulator::virt_syscall(u32 function, u32 arg1, u32 arg2, u32 arg3)
     case SC_getrandom:
         return virt$getrandom(arg1, arg2, arg3);
     case SC_fork:
+    case SC_vfork:
+        // Emulated vfork degrades to fork; the emulated parent just doesn't
+        // get the memory-sharing fast path.
         return virt$fork();
     case SC_emuctl:
         return virt$emuctl(arg1, arg2, arg3);
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/ByteBuffer.h>
+#include <AK/Debug.h>
+#include <AK/Vector.h>
+#include <LibArchive/Extract.h>
+#include <LibCompress/Deflate.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/WorkerPool.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Archive {
+
+// Returns 0 on success and an errno otherwise. Safe to call off the main
+// thread, which is the whole point of this file.
+static int write_whole_file(const String& path, ReadonlyBytes data, mode_t mode)
+{
+    int fd = open(path.characters(), O_CREAT | O_WRONLY | O_TRUNC, mode);
+    if (fd < 0)
+        return errno;
+
+    size_t offset = 0;
+    while (offset < data.size()) {
+        auto nwritten = write(fd, data.data() + offset, data.size() - offset);
+        if (nwritten < 0) {
+            int saved_errno = errno;
+            close(fd);
+            return saved_errno;
+        }
+        offset += nwritten;
+    }
+
+    if (close(fd) < 0)
+        return errno;
+    return 0;
+}
+
+bool extract_zip_archive(Zip& zip, const ExtractionOptions& options)
+{
+    bool ok = true;
+
+    // First pass, in archive order: announce everything, create the
+    // directories, and collect the files. With the directories already in
+    // place the files can be extracted in any order (and concurrently).
+    Vector<ZipMember> files;
+    zip.for_each_member([&](const auto& member) {
+        if (options.on_entry)
+            options.on_entry(member.name);
+
+        if (member.is_directory) {
+            if (mkdir(member.name.characters(), 0755) < 0) {
+                if (options.on_error)
+                    options.on_error(member.name, strerror(errno));
+                ok = false;
+            }
+        } else {
+            files.append(member);
+        }
+        return IterationDecision::Continue;
+    });
+
+    // Second pass: decompress and write the files across the worker pool.
+    // Errors are collected and reported from this thread once everyone is
+    // done, so the callbacks never run concurrently.
+    Threading::Mutex error_lock;
+    Vector<size_t> failed_files;
+    Vector<String> failure_messages;
+
+    auto extract_one = [&](size_t i) -> Optional<String> {
+        auto& member = files[i];
+        switch (member.compression_method) {
+        case ZipCompressionMethod::Store: {
+            if (auto error = write_whole_file(member.name, member.compressed_data, 0644))
+                return String { strerror(error) };
+            return {};
+        }
+        case ZipCompressionMethod::Deflate: {
+            auto decompressed_data = Compress::DeflateDecompressor::decompress_all(member.compressed_data);
+            if (!decompressed_data.has_value())
+                return String { "failed to decompress" };
+            if (decompressed_data.value().size() != member.uncompressed_size)
+                return String { "decompressed size does not match the archive" };
+            if (auto error = write_whole_file(member.name, decompressed_data.value(), 0644))
+                return String { strerror(error) };
+            return {};
+        }
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    };
+
+    Threading::WorkerPool::the().parallel_for(files.size(), [&](size_t i) {
+        auto error = extract_one(i);
+        if (error.has_value()) {
+            Threading::MutexLocker locker(error_lock);
+            failed_files.append(i);
+            failure_messages.append(error.release_value());
+        }
+    });
+
+    for (size_t i = 0; i < failed_files.size(); ++i) {
+        if (options.on_error)
+            options.on_error(files[failed_files[i]].name, failure_messages[i]);
+        ok = false;
+    }
+
+    return ok;
+}
+
+bool extract_tar_archive(TarInputStream& tar_stream, const ExtractionOptions& options)
+{
+    auto& pool = Threading::WorkerPool::the();
+    bool ok = true;
+
+    // In-flight file writes; bounded so a huge archive full of large files
+    // doesn't buffer itself entirely into memory.
+    struct PendingWrite {
+        NonnullRefPtr<Threading::Future<int>> result;
+        String path;
+        size_t size { 0 };
+    };
+    Vector<PendingWrite> pending_writes;
+    size_t pending_bytes = 0;
+    constexpr size_t max_pending_bytes = 16 * MiB;
+
+    auto wait_for_oldest = [&] {
+        auto pending = pending_writes.take_first();
+        pending_bytes -= pending.size;
+        if (auto error = pending.result->wait()) {
+            if (options.on_error)
+                options.on_error(pending.path, strerror(error));
+            ok = false;
+        }
+    };
+
+    for (; !tar_stream.finished(); tar_stream.advance()) {
+        const TarFileHeader& header = tar_stream.header();
+        String path = header.filename();
+
+        if (options.on_entry)
+            options.on_entry(path);
+
+        switch (header.type_flag()) {
+        case TarFileType::NormalFile:
+        case TarFileType::AlternateNormalFile: {
+            auto file_stream = tar_stream.file_contents();
+
+            ByteBuffer buffer;
+            Array<u8, 64 * KiB> chunk;
+            size_t nread;
+            while ((nread = file_stream.read(chunk)) > 0)
+                buffer.append(chunk.data(), nread);
+
+            while (!pending_writes.is_empty() && pending_bytes + buffer.size() > max_pending_bytes)
+                wait_for_oldest();
+
+            auto size = buffer.size();
+            auto mode = header.mode();
+            // Deep-copy the path for the worker; String's reference count
+            // isn't atomic, so the two threads must not share an impl.
+            String path_for_worker { path.characters() };
+            auto future = pool.submit<int>([path_for_worker = move(path_for_worker), buffer = move(buffer), mode]() -> int {
+                return write_whole_file(path_for_worker, buffer, mode);
+            });
+            pending_bytes += size;
+            pending_writes.append({ move(future), move(path), size });
+            break;
+        }
+        case TarFileType::Directory: {
+            if (mkdir(path.characters(), header.mode()) < 0) {
+                if (options.on_error)
+                    options.on_error(path, strerror(errno));
+                ok = false;
+            }
+            break;
+        }
+        case TarFileType::GlobalExtendedHeader: {
+            dbgln("ignoring global extended header: {}", path);
+            break;
+        }
+        case TarFileType::ExtendedHeader: {
+            dbgln("ignoring extended header: {}", path);
+            break;
+        }
+        default:
+            if (options.on_error)
+                options.on_error(path, String::formatted("file type '{}' is not yet supported", (char)header.type_flag()));
+            ok = false;
+            break;
+        }
+    }
+
+    while (!pending_writes.is_empty())
+        wait_for_oldest();
+
+    return ok;
+}
+
+}
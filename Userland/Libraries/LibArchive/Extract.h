@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/String.h>
+#include <LibArchive/TarStream.h>
+#include <LibArchive/Zip.h>
+
+namespace Archive {
+
+struct ExtractionOptions {
+    // Invoked as each entry is encountered, before it is extracted.
+    Function<void(const String& path)> on_entry;
+    // Invoked when extracting an entry fails. The remaining entries are
+    // still extracted, but the extract call returns false.
+    Function<void(const String& path, const String& message)> on_error;
+};
+
+// Both of these extract into the current working directory and only ever
+// invoke the callbacks on the calling thread.
+
+// Extracts all members of a zip archive. Directories are created up front in
+// archive order; the files (which are independently compressed) are then
+// decompressed and written out in parallel on the worker pool.
+bool extract_zip_archive(Zip&, const ExtractionOptions& = {});
+
+// Extracts a ustar stream. The input (possibly coming through a gzip
+// decompressor) has to be consumed sequentially, but file writes are handed
+// off to the worker pool so disk I/O overlaps with decompression.
+bool extract_tar_archive(TarInputStream&, const ExtractionOptions& = {});
+
+}
@@ -9,6 +9,18 @@
 
 namespace Audio {
 
+SampleRing& ClientConnection::ensure_sample_ring()
+{
+    if (!m_ring) {
+        m_ring_buffer = Core::AnonymousBuffer::create_with_size(sizeof(SampleRing));
+        VERIFY(m_ring_buffer.is_valid());
+        // Anonymous memory is zero-filled, which is a valid empty ring.
+        m_ring = reinterpret_cast<SampleRing*>(m_ring_buffer.data<u8>());
+        set_sample_ring(m_ring_buffer);
+    }
+    return *m_ring;
+}
+
 ClientConnection::ClientConnection()
     : IPC::ServerConnection<AudioClientEndpoint, AudioServerEndpoint>(*this, "/tmp/portal/audio")
 {
@@ -16,24 +28,45 @@ ClientConnection::ClientConnection()
 
 void ClientConnection::enqueue(Buffer const& buffer)
 {
-    for (;;) {
-        auto success = enqueue_buffer(buffer.anonymous_buffer(), buffer.id(), buffer.sample_count());
-        if (success)
-            break;
-        // FIXME: We don't know what is a good value for this.
-        // For now, decrease it to enable better real-time audio.
+    auto& ring = ensure_sample_ring();
+    while (!ring.try_write_chunk(buffer.id(), buffer.sample_count())) {
+        // The ring holds hundreds of milliseconds of audio, so being
+        // full just means we are far ahead of the mixer.
         usleep(10000);
     }
+
+    auto const* frames = buffer.samples();
+    size_t count = buffer.sample_count();
+    size_t written = 0;
+    while (written < count) {
+        written += ring.write_frames(frames + written, count - written);
+        if (written < count)
+            usleep(3000);
+    }
 }
 
 void ClientConnection::async_enqueue(Buffer const& buffer)
 {
-    async_enqueue_buffer(buffer.anonymous_buffer(), buffer.id(), buffer.sample_count());
+    // Like the old fire-and-forget IPC enqueue, this silently drops the
+    // buffer when the queue is full.
+    (void)try_enqueue(buffer);
 }
 
 bool ClientConnection::try_enqueue(Buffer const& buffer)
 {
-    return enqueue_buffer(buffer.anonymous_buffer(), buffer.id(), buffer.sample_count());
+    auto& ring = ensure_sample_ring();
+    if (!ring.try_write_chunk(buffer.id(), buffer.sample_count()))
+        return false;
+
+    auto const* frames = buffer.samples();
+    size_t count = buffer.sample_count();
+    size_t written = 0;
+    while (written < count) {
+        written += ring.write_frames(frames + written, count - written);
+        if (written < count)
+            usleep(3000);
+    }
+    return true;
 }
 
 void ClientConnection::finished_playing_buffer(i32 buffer_id)
@@ -8,6 +8,8 @@
 
 #include <AudioServer/AudioClientEndpoint.h>
 #include <AudioServer/AudioServerEndpoint.h>
+#include <LibAudio/SampleRing.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibIPC/ServerConnection.h>
 
 namespace Audio {
@@ -30,9 +32,14 @@ public:
     Function<void(int volume)> on_main_mix_volume_change;
 
 private:
+    SampleRing& ensure_sample_ring();
+
     virtual void finished_playing_buffer(i32) override;
     virtual void muted_state_changed(bool) override;
     virtual void main_mix_volume_changed(i32) override;
+
+    Core::AnonymousBuffer m_ring_buffer;
+    SampleRing* m_ring { nullptr };
 };
 
 }
@@ -226,7 +226,17 @@ void FlacLoaderPlugin::seek(const int position)
     if (!m_stream->seek(position)) {
         m_error_string = String::formatted("Invalid seek position {}", position);
         m_valid = false;
+        return;
     }
+    // The bit stream may have buffered bytes past the old position.
+    m_bit_stream.clear();
+}
+
+FlacBitStream& FlacLoaderPlugin::ensure_bit_stream()
+{
+    if (!m_bit_stream)
+        m_bit_stream = make<FlacBitStream>(*m_stream);
+    return *m_bit_stream;
 }
 
 RefPtr<Buffer> FlacLoaderPlugin::get_more_samples(size_t max_bytes_to_read_from_input)
@@ -260,7 +270,7 @@ RefPtr<Buffer> FlacLoaderPlugin::get_more_samples(size_t max_bytes_to_read_from_
 void FlacLoaderPlugin::next_frame()
 {
     bool ok = true;
-    InputBitStream bit_stream = m_stream->bit_stream();
+    auto& bit_stream = ensure_bit_stream();
 #define CHECK_OK(msg)                                                                                                      \
     do {                                                                                                                   \
         if (!ok) {                                                                                                         \
@@ -512,7 +522,7 @@ u8 frame_channel_type_to_channel_count(FlacFrameChannelType channel_type)
     return 2;
 }
 
-FlacSubframeHeader FlacLoaderPlugin::next_subframe_header(InputBitStream& bit_stream, u8 channel_index)
+FlacSubframeHeader FlacLoaderPlugin::next_subframe_header(FlacBitStream& bit_stream, u8 channel_index)
 {
     u8 bits_per_sample = pcm_bits_per_sample(m_current_frame->bit_depth);
 
@@ -580,7 +590,7 @@ FlacSubframeHeader FlacLoaderPlugin::next_subframe_header(InputBitStream& bit_st
     };
 }
 
-Vector<i32> FlacLoaderPlugin::parse_subframe(FlacSubframeHeader& subframe_header, InputBitStream& bit_input)
+Vector<i32> FlacLoaderPlugin::parse_subframe(FlacSubframeHeader& subframe_header, FlacBitStream& bit_input)
 {
     Vector<i32> samples;
 
@@ -627,7 +637,7 @@ Vector<i32> FlacLoaderPlugin::parse_subframe(FlacSubframeHeader& subframe_header
 }
 
 // Decode a subframe that isn't actually encoded, usually seen in random data
-Vector<i32> FlacLoaderPlugin::decode_verbatim(FlacSubframeHeader& subframe, InputBitStream& bit_input)
+Vector<i32> FlacLoaderPlugin::decode_verbatim(FlacSubframeHeader& subframe, FlacBitStream& bit_input)
 {
     Vector<i32> decoded;
     decoded.ensure_capacity(m_current_frame->sample_count);
@@ -640,7 +650,7 @@ Vector<i32> FlacLoaderPlugin::decode_verbatim(FlacSubframeHeader& subframe, Inpu
 }
 
 // Decode a subframe encoded with a custom linear predictor coding, i.e. the subframe provides the polynomial order and coefficients
-Vector<i32> FlacLoaderPlugin::decode_custom_lpc(FlacSubframeHeader& subframe, InputBitStream& bit_input)
+Vector<i32> FlacLoaderPlugin::decode_custom_lpc(FlacSubframeHeader& subframe, FlacBitStream& bit_input)
 {
     Vector<i32> decoded;
     decoded.ensure_capacity(m_current_frame->sample_count);
@@ -689,7 +699,7 @@ Vector<i32> FlacLoaderPlugin::decode_custom_lpc(FlacSubframeHeader& subframe, In
 }
 
 // Decode a subframe encoded with one of the fixed linear predictor codings
-Vector<i32> FlacLoaderPlugin::decode_fixed_lpc(FlacSubframeHeader& subframe, InputBitStream& bit_input)
+Vector<i32> FlacLoaderPlugin::decode_fixed_lpc(FlacSubframeHeader& subframe, FlacBitStream& bit_input)
 {
     Vector<i32> decoded;
     decoded.ensure_capacity(m_current_frame->sample_count);
@@ -738,7 +748,7 @@ Vector<i32> FlacLoaderPlugin::decode_fixed_lpc(FlacSubframeHeader& subframe, Inp
 }
 
 // Decode the residual, the "error" between the function approximation and the actual audio data
-Vector<i32> FlacLoaderPlugin::decode_residual(Vector<i32>& decoded, FlacSubframeHeader& subframe, InputBitStream& bit_input)
+Vector<i32> FlacLoaderPlugin::decode_residual(Vector<i32>& decoded, FlacSubframeHeader& subframe, FlacBitStream& bit_input)
 {
     u8 residual_mode = bit_input.read_bits_big_endian(2);
     u8 partition_order = bit_input.read_bits_big_endian(4);
@@ -765,7 +775,7 @@ Vector<i32> FlacLoaderPlugin::decode_residual(Vector<i32>& decoded, FlacSubframe
 }
 
 // Decode a single Rice partition as part of the residual, every partition can have its own Rice parameter k
-ALWAYS_INLINE Vector<i32> FlacLoaderPlugin::decode_rice_partition(u8 partition_type, u32 partitions, u32 partition_index, FlacSubframeHeader& subframe, InputBitStream& bit_input)
+ALWAYS_INLINE Vector<i32> FlacLoaderPlugin::decode_rice_partition(u8 partition_type, u32 partitions, u32 partition_index, FlacSubframeHeader& subframe, FlacBitStream& bit_input)
 {
     // Rice parameter / Exp-Golomb order
     u8 k = bit_input.read_bits_big_endian(partition_type);
@@ -797,26 +807,21 @@ ALWAYS_INLINE Vector<i32> FlacLoaderPlugin::decode_rice_partition(u8 partition_t
 }
 
 // Decode a single number encoded with Rice/Exponential-Golomb encoding (the unsigned variant)
-ALWAYS_INLINE i32 decode_unsigned_exp_golomb(u8 k, InputBitStream& bit_input)
+ALWAYS_INLINE i32 decode_unsigned_exp_golomb(u8 k, FlacBitStream& bit_input)
 {
-    u8 q = 0;
-    while (bit_input.read_bit_big_endian() == 0)
-        ++q;
+    u32 q = bit_input.read_unary_zeroes_big_endian();
 
     // least significant bits (remainder)
     u32 rem = bit_input.read_bits_big_endian(k);
-    u32 value = (u32)(q << k | rem);
 
-    return rice_to_signed(value);
+    return rice_to_signed((q << k) | rem);
 }
 
-u64 read_utf8_char(InputStream& input)
+u64 read_utf8_char(FlacBitStream& input)
 {
     u64 character;
-    u8 buffer = 0;
-    Bytes buffer_bytes { &buffer, 1 };
-    input.read(buffer_bytes);
-    u8 start_byte = buffer_bytes[0];
+    // The frame header is byte-aligned here, so whole bytes can be read.
+    u8 start_byte = input.read_bits_big_endian(8);
     // Signal byte is zero: ASCII character
     if ((start_byte & 0b10000000) == 0) {
         return start_byte;
@@ -832,8 +837,7 @@ u64 read_utf8_char(InputStream& input)
     u8 start_byte_bitmask = AK::exp2(bits_from_start_byte) - 1;
     character = start_byte_bitmask & start_byte;
     for (u8 i = length - 1; i > 0; --i) {
-        input.read(buffer_bytes);
-        u8 current_byte = buffer_bytes[0];
+        u8 current_byte = input.read_bits_big_endian(8);
         character = (character << 6) | (current_byte & 0b00111111);
     }
     return character;
@@ -54,6 +54,107 @@ public:
     }
 };
 
+// A 64-bit-word-buffered big-endian bit stream used for decoding frames.
+// AK::InputBitStream pulls single bytes out of the underlying stream and
+// extracts them bit by bit on every call, which is much too slow for
+// residual decoding; this one keeps up to 64 bits buffered so most reads
+// are a couple of shifts, and a whole run of unary zeroes can be counted
+// in one step. Reading ahead is fine because one of these stays attached
+// to the stream across frames; it just has to be thrown away whenever the
+// underlying stream seeks.
+class FlacBitStream {
+public:
+    explicit FlacBitStream(FlacInputStream& stream)
+        : m_stream(stream.visit([](auto& underlying) -> InputStream& { return underlying; }))
+    {
+    }
+
+    ALWAYS_INLINE u64 read_bits_big_endian(size_t count)
+    {
+        VERIFY(count < 64);
+        u64 result = 0;
+        while (count > 0) {
+            if (m_bit_count == 0 && !refill())
+                break;
+            size_t taken = min(count, m_bit_count);
+            result = (result << taken) | (m_buffer >> (64 - taken));
+            m_buffer <<= taken;
+            m_bit_count -= taken;
+            count -= taken;
+        }
+        return result;
+    }
+
+    ALWAYS_INLINE bool read_bit_big_endian() { return read_bits_big_endian(1) != 0; }
+
+    // Only used to skip over values nobody looks at (the header checksum),
+    // so the bit order within the value doesn't matter here.
+    ALWAYS_INLINE u64 read_bits(size_t count) { return read_bits_big_endian(count); }
+
+    // Reads a run of zero bits and its terminating one bit, returning the
+    // length of the run; this is the quotient part of a Rice-coded number.
+    ALWAYS_INLINE u32 read_unary_zeroes_big_endian()
+    {
+        u32 zeroes = 0;
+        for (;;) {
+            if (m_bit_count == 0 && !refill())
+                return zeroes;
+            if (m_buffer == 0) {
+                // Nothing but zeroes buffered; count them all and refill.
+                zeroes += m_bit_count;
+                m_bit_count = 0;
+                continue;
+            }
+            // The terminating one bit is somewhere in the buffer, and
+            // everything below the valid bits is zero, so the leading-zero
+            // count can't overshoot m_bit_count here.
+            size_t leading = __builtin_clzll(m_buffer);
+            zeroes += leading;
+            m_buffer <<= leading + 1;
+            m_bit_count -= leading + 1;
+            return zeroes;
+        }
+    }
+
+    void align_to_byte_boundary()
+    {
+        if (auto remainder = m_bit_count % 8; remainder != 0) {
+            m_buffer <<= remainder;
+            m_bit_count -= remainder;
+        }
+    }
+
+    bool handle_any_error()
+    {
+        auto had_error = m_has_error;
+        m_has_error = false;
+        return had_error;
+    }
+
+private:
+    bool refill()
+    {
+        u8 bytes[sizeof(u64)];
+        auto wanted = (64 - m_bit_count) / 8;
+        auto nread = m_stream.read({ bytes, wanted });
+        if (nread == 0) {
+            m_has_error = true;
+            return false;
+        }
+        for (size_t i = 0; i < nread; ++i) {
+            m_buffer |= static_cast<u64>(bytes[i]) << (64 - m_bit_count - 8);
+            m_bit_count += 8;
+        }
+        return true;
+    }
+
+    InputStream& m_stream;
+    // The upper m_bit_count bits of m_buffer are valid; everything below is zero.
+    u64 m_buffer { 0 };
+    size_t m_bit_count { 0 };
+    bool m_has_error { false };
+};
+
 ALWAYS_INLINE u8 frame_channel_type_to_channel_count(FlacFrameChannelType channel_type);
 // Sign-extend an arbitrary-size signed number to 64 bit signed
 ALWAYS_INLINE i64 sign_extend(u32 n, u8 size);
@@ -63,9 +164,9 @@ ALWAYS_INLINE i32 rice_to_signed(u32 x);
 
 // decoders
 // read a UTF-8 encoded number, even if it is not a valid codepoint
-ALWAYS_INLINE u64 read_utf8_char(InputStream& input);
+ALWAYS_INLINE u64 read_utf8_char(FlacBitStream& input);
 // decode a single number encoded with exponential golomb encoding of the specified order
-ALWAYS_INLINE i32 decode_unsigned_exp_golomb(u8 order, InputBitStream& bit_input);
+ALWAYS_INLINE i32 decode_unsigned_exp_golomb(u8 order, FlacBitStream& bit_input);
 
 class FlacLoaderPlugin : public LoaderPlugin {
 public:
@@ -105,16 +206,20 @@ private:
     // Fetches and sets the next FLAC frame
     void next_frame();
     // Helper of next_frame that fetches a sub frame's header
-    FlacSubframeHeader next_subframe_header(InputBitStream& bit_input, u8 channel_index);
+    FlacSubframeHeader next_subframe_header(FlacBitStream& bit_input, u8 channel_index);
     // Helper of next_frame that decompresses a subframe
-    Vector<i32> parse_subframe(FlacSubframeHeader& subframe_header, InputBitStream& bit_input);
+    Vector<i32> parse_subframe(FlacSubframeHeader& subframe_header, FlacBitStream& bit_input);
     // Subframe-internal data decoders (heavy lifting)
-    Vector<i32> decode_fixed_lpc(FlacSubframeHeader& subframe, InputBitStream& bit_input);
-    Vector<i32> decode_verbatim(FlacSubframeHeader& subframe, InputBitStream& bit_input);
-    Vector<i32> decode_custom_lpc(FlacSubframeHeader& subframe, InputBitStream& bit_input);
-    Vector<i32> decode_residual(Vector<i32>& decoded, FlacSubframeHeader& subframe, InputBitStream& bit_input);
+    Vector<i32> decode_fixed_lpc(FlacSubframeHeader& subframe, FlacBitStream& bit_input);
+    Vector<i32> decode_verbatim(FlacSubframeHeader& subframe, FlacBitStream& bit_input);
+    Vector<i32> decode_custom_lpc(FlacSubframeHeader& subframe, FlacBitStream& bit_input);
+    Vector<i32> decode_residual(Vector<i32>& decoded, FlacSubframeHeader& subframe, FlacBitStream& bit_input);
     // decode a single rice partition that has its own rice parameter
-    ALWAYS_INLINE Vector<i32> decode_rice_partition(u8 partition_type, u32 partitions, u32 partition_index, FlacSubframeHeader& subframe, InputBitStream& bit_input);
+    ALWAYS_INLINE Vector<i32> decode_rice_partition(u8 partition_type, u32 partitions, u32 partition_index, FlacSubframeHeader& subframe, FlacBitStream& bit_input);
+
+    // Lazily creates the frame bit stream; it buffers read-ahead, so it
+    // stays alive across frames and is reset whenever the stream seeks.
+    FlacBitStream& ensure_bit_stream();
 
     // Converters for special coding used in frame headers
     ALWAYS_INLINE u32 convert_sample_count_code(u8 sample_count_code);
@@ -142,6 +247,7 @@ private:
     // keep track of the start of the data in the FLAC stream to seek back more easily
     u64 m_data_start_location { 0 };
     OwnPtr<FlacInputStream> m_stream;
+    OwnPtr<FlacBitStream> m_bit_stream;
     Optional<FlacFrameHeader> m_current_frame;
     Vector<Frame> m_current_frame_data;
     u64 m_current_sample_or_frame { 0 };
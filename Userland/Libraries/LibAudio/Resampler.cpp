@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "Resampler.h"
+#include <AK/Math.h>
+
+namespace Audio {
+
+static u32 greatest_common_divisor(u32 a, u32 b)
+{
+    while (b != 0) {
+        u32 temp = a % b;
+        a = b;
+        b = temp;
+    }
+    return a;
+}
+
+static double sinc(double x)
+{
+    if (x == 0.0)
+        return 1.0;
+    return AK::sin(AK::Pi<double> * x) / (AK::Pi<double> * x);
+}
+
+PolyphaseResampler::PolyphaseResampler(u32 source, u32 target)
+    : m_source(source)
+    , m_target(target)
+{
+    u32 divisor = greatest_common_divisor(source, target);
+    m_up = target / divisor;
+    m_down = source / divisor;
+    // Same rate: pass samples through untouched instead of filtering
+    if (m_up == m_down) {
+        m_up = m_down = 1;
+        return;
+    }
+
+    // The prototype low-pass lives in the upsampled domain and cuts off
+    // at the lower of the two Nyquist frequencies.
+    size_t length = m_up * m_taps;
+    double cutoff = min(1.0, static_cast<double>(m_up) / m_down);
+    double center = (length - 1) / 2.0;
+
+    m_filter_bank.resize(length);
+    for (size_t phase = 0; phase < m_up; ++phase) {
+        double* coefficients = m_filter_bank.data() + phase * m_taps;
+        double sum = 0;
+        for (size_t tap = 0; tap < m_taps; ++tap) {
+            // Polyphase decomposition: phase p of the bank collects every
+            // m_up'th coefficient of the prototype, starting at p.
+            size_t index = phase + tap * m_up;
+            double window = 0.5 - 0.5 * AK::cos(2.0 * AK::Pi<double> * index / (length - 1));
+            coefficients[tap] = window * sinc(cutoff * (index - center) / m_up);
+            sum += coefficients[tap];
+        }
+        // Normalize each phase to unit DC gain so constant signals come
+        // out at exactly their input amplitude.
+        for (size_t tap = 0; tap < m_taps; ++tap)
+            coefficients[tap] /= sum;
+    }
+}
+
+Vector<Frame> PolyphaseResampler::process(Span<Frame const> input)
+{
+    Vector<Frame> output;
+    if (m_up == m_down) {
+        output.append(input.data(), input.size());
+        return output;
+    }
+
+    m_window.append(input.data(), input.size());
+    size_t total_samples = m_dropped + m_window.size();
+    output.ensure_capacity(input.size() * m_up / m_down + 1);
+
+    for (;;) {
+        size_t base = m_position / m_up;
+        if (base >= total_samples)
+            break;
+        size_t phase = m_position % m_up;
+        double const* coefficients = m_filter_bank.data() + phase * m_taps;
+
+        double left = 0;
+        double right = 0;
+        for (size_t tap = 0; tap < m_taps; ++tap) {
+            // Samples from before the start of the stream are silence
+            if (base < tap)
+                break;
+            auto const& sample = m_window[base - tap - m_dropped];
+            left += coefficients[tap] * sample.left;
+            right += coefficients[tap] * sample.right;
+        }
+        output.append({ left, right });
+        m_position += m_down;
+    }
+
+    // Drop every input sample that no future output can reach; the next
+    // output needs m_taps - 1 samples of history before its base.
+    size_t next_base = m_position / m_up;
+    size_t needed_from = next_base >= m_taps - 1 ? next_base - (m_taps - 1) : 0;
+    if (needed_from > m_dropped) {
+        size_t drop_count = min(needed_from - m_dropped, m_window.size());
+        Vector<Frame> remaining;
+        remaining.append(m_window.data() + drop_count, m_window.size() - drop_count);
+        m_window = move(remaining);
+        m_dropped += drop_count;
+    }
+
+    return output;
+}
+
+void PolyphaseResampler::reset()
+{
+    m_window.clear();
+    m_dropped = 0;
+    m_position = 0;
+}
+
+NonnullRefPtr<Buffer> resample_buffer(PolyphaseResampler& resampler, Buffer const& to_resample)
+{
+    auto resampled = resampler.process({ to_resample.samples(), static_cast<size_t>(to_resample.sample_count()) });
+    return Buffer::create_with_samples(move(resampled));
+}
+
+}
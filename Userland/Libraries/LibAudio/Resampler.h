@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "Buffer.h"
+#include <AK/NonnullRefPtr.h>
+#include <AK/Span.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace Audio {
+
+// A streaming polyphase resampler with a precomputed windowed-sinc filter
+// bank. Unlike ResampleHelper, which repeats or drops samples, this
+// low-pass filters the signal at the narrower of the two Nyquist limits,
+// so upsampled audio doesn't get imaging artifacts and downsampled audio
+// doesn't alias.
+//
+// The rate ratio is reduced to up/down: conceptually the input is
+// upsampled by "up", filtered, and decimated by "down", but only the
+// filter taps that land on actual input samples are ever computed. One
+// filter phase per upsampling step is precomputed in the constructor.
+//
+// Filter state persists across process() calls so that consecutive
+// buffers of one stream stay continuous; call reset() when switching to
+// an unrelated stream.
+class PolyphaseResampler {
+public:
+    PolyphaseResampler(u32 source, u32 target);
+
+    // Feeds more input samples and returns every output sample that can
+    // be produced so far.
+    Vector<Frame> process(Span<Frame const> input);
+
+    void reset();
+
+    u32 source() const { return m_source; }
+    u32 target() const { return m_target; }
+
+private:
+    // Enough for ~80dB stopband attenuation with a Hann window; every
+    // output sample costs this many multiply-adds per channel.
+    static constexpr size_t m_taps = 32;
+
+    u32 const m_source;
+    u32 const m_target;
+    size_t m_up { 1 };
+    size_t m_down { 1 };
+    // m_up phases of m_taps coefficients each
+    Vector<double> m_filter_bank;
+
+    // Input samples not yet old enough to be discarded, starting at
+    // absolute input index m_dropped
+    Vector<Frame> m_window;
+    size_t m_dropped { 0 };
+    // Position of the next output sample, in upsampled (input * m_up) ticks
+    size_t m_position { 0 };
+};
+
+NonnullRefPtr<Buffer> resample_buffer(PolyphaseResampler&, Buffer const& to_resample);
+
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "Buffer.h"
+#include <AK/Atomic.h>
+#include <AK/Types.h>
+
+namespace Audio {
+
+// Shared-memory sample transport between an audio client and the
+// AudioServer mixer. The client maps one of these into an anonymous
+// buffer, hands it to the server once, and from then on every enqueued
+// Audio::Buffer travels as plain memory writes instead of a per-buffer
+// anonymous file plus IPC round trip.
+//
+// The client is the only writer and the mixer thread the only reader,
+// so both rings inside are single-producer single-consumer and lock-free.
+// Each enqueued buffer becomes one chunk descriptor; its frames stream
+// through the frame ring separately, so a chunk larger than the frame
+// ring plays fine (the server consumes frames while the client is still
+// writing the rest). The buffer-id protocol is preserved: the server
+// still reports each finished chunk's id back over IPC.
+//
+// This kernel's futexes are process-private, so there is no cross-
+// process wakeup primitive to sleep on; the client briefly sleeps and
+// repolls on the rare occasions the ring is full (it holds several
+// hundred milliseconds of audio), and the mixer never waits at all.
+class SampleRing {
+public:
+    // ~0.37s of samples at 44.1kHz; both capacities are powers of two.
+    static constexpr size_t frame_capacity = 16384;
+    static constexpr size_t chunk_capacity = 64;
+
+    struct Chunk {
+        i32 buffer_id;
+        u32 sample_count;
+        // Absolute frame ring position of the chunk's first sample, so
+        // the reader can skip frames orphaned by a clear.
+        u32 first_frame;
+    };
+
+    // --- writer (client) side ---
+
+    bool is_chunk_ring_full() const
+    {
+        return m_chunk_write.load(AK::MemoryOrder::memory_order_relaxed) - m_chunk_read.load(AK::MemoryOrder::memory_order_relaxed) >= chunk_capacity - 1;
+    }
+
+    bool try_write_chunk(i32 buffer_id, u32 sample_count)
+    {
+        u32 head = m_chunk_write.load(AK::MemoryOrder::memory_order_relaxed);
+        if (head - m_chunk_read.load(AK::MemoryOrder::memory_order_acquire) >= chunk_capacity - 1)
+            return false;
+        auto& chunk = m_chunks[head % chunk_capacity];
+        chunk.buffer_id = buffer_id;
+        chunk.sample_count = sample_count;
+        chunk.first_frame = m_frame_write.load(AK::MemoryOrder::memory_order_relaxed);
+        m_remaining_samples.fetch_add(sample_count, AK::MemoryOrder::memory_order_relaxed);
+        m_chunk_write.store(head + 1, AK::MemoryOrder::memory_order_release);
+        return true;
+    }
+
+    // Copies as many frames as there is room for and returns how many
+    // that was; the caller retries with the rest once the reader has
+    // caught up.
+    size_t write_frames(Frame const* frames, size_t count)
+    {
+        u32 head = m_frame_write.load(AK::MemoryOrder::memory_order_relaxed);
+        u32 tail = m_frame_read.load(AK::MemoryOrder::memory_order_acquire);
+        size_t writable = min(count, frame_capacity - static_cast<size_t>(head - tail));
+        for (size_t i = 0; i < writable; ++i)
+            m_frames[(head + i) % frame_capacity] = frames[i];
+        m_frame_write.store(head + writable, AK::MemoryOrder::memory_order_release);
+        return writable;
+    }
+
+    // --- reader (mixer thread) side ---
+
+    bool peek_chunk(Chunk& chunk) const
+    {
+        u32 tail = m_chunk_read.load(AK::MemoryOrder::memory_order_relaxed);
+        if (tail == m_chunk_write.load(AK::MemoryOrder::memory_order_acquire))
+            return false;
+        chunk = m_chunks[tail % chunk_capacity];
+        return true;
+    }
+
+    // Chunks are popped only once fully played, so the in-flight chunk
+    // still counts against the writer's capacity check.
+    void pop_chunk()
+    {
+        m_chunk_read.store(m_chunk_read.load(AK::MemoryOrder::memory_order_relaxed) + 1, AK::MemoryOrder::memory_order_release);
+    }
+
+    bool read_frame(Frame& frame)
+    {
+        u32 tail = m_frame_read.load(AK::MemoryOrder::memory_order_relaxed);
+        if (tail == m_frame_write.load(AK::MemoryOrder::memory_order_acquire))
+            return false;
+        frame = m_frames[tail % frame_capacity];
+        m_frame_read.store(tail + 1, AK::MemoryOrder::memory_order_release);
+        return true;
+    }
+
+    // Frames written before first_frame belong to chunks that were
+    // cleared away; skip them so the next chunk starts aligned.
+    void skip_frames_before(u32 first_frame)
+    {
+        u32 tail = m_frame_read.load(AK::MemoryOrder::memory_order_relaxed);
+        if (static_cast<i32>(first_frame - tail) > 0)
+            m_frame_read.store(first_frame, AK::MemoryOrder::memory_order_release);
+    }
+
+    // Consumes every frame currently in the ring; frames of a chunk the
+    // writer is still producing get skipped later via first_frame.
+    void discard_written_frames()
+    {
+        m_frame_read.store(m_frame_write.load(AK::MemoryOrder::memory_order_acquire), AK::MemoryOrder::memory_order_release);
+    }
+
+    // --- counters (either side) ---
+
+    Atomic<u32>& remaining_samples() { return m_remaining_samples; }
+    Atomic<u32>& played_samples() { return m_played_samples; }
+
+private:
+    Atomic<u32> m_frame_write { 0 };
+    Atomic<u32> m_frame_read { 0 };
+    Atomic<u32> m_chunk_write { 0 };
+    Atomic<u32> m_chunk_read { 0 };
+    Atomic<u32> m_remaining_samples { 0 };
+    Atomic<u32> m_played_samples { 0 };
+    Chunk m_chunks[chunk_capacity];
+    Frame m_frames[frame_capacity];
+};
+
+}
@@ -422,6 +422,10 @@ typedef struct {
     Elf64_Sxword r_addend; /* adjustment value */
 } Elf64_Rela;
 
+/* Compact relative relocations (even: offset, odd: bitmap) */
+typedef Elf32_Word Elf32_Relr;
+typedef Elf64_Xword Elf64_Relr;
+
 #define ELF64_R_SYM(info) ((info) >> 32)
 #define ELF64_R_TYPE(info) ((info)&0xFFFFFFFF)
 #define ELF64_R_INFO(s, t) (((s) << 32) + (uint32_t)(t))
@@ -545,6 +549,9 @@ typedef struct {
 #define DT_ENCODING 31        /* further DT_* follow encoding rules */
 #define DT_PREINIT_ARRAY 32   /* address of array of preinit func */
 #define DT_PREINIT_ARRAYSZ 33 /* size of array of preinit func */
+#define DT_RELRSZ 35          /* size of DT_RELR relocation table */
+#define DT_RELR 36            /* address of relative relocation table */
+#define DT_RELRENT 37         /* size of DT_RELR relocation entry */
 #define DT_LOOS 0x6000000d    /* reserved range for OS */
 #define DT_HIOS 0x6ffff000    /*  specific dynamic array tags */
 #define DT_LOPROC 0x70000000  /* reserved range for processor */
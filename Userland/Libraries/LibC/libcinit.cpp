@@ -6,6 +6,7 @@
 
 #include <AK/Types.h>
 #include <assert.h>
+#include <serenity.h>
 #include <sys/internals.h>
 #include <unistd.h>
 
@@ -24,5 +25,15 @@ void __libc_init()
 {
     __malloc_init();
     __stdio_init();
+
+#ifndef _DYNAMIC_LOADER
+    // Mark the end of LibC initialization in the performance event stream.
+    // The loader's statically linked copy keeps quiet; it initializes long
+    // before the program's own libc.so and would only add noise.
+    static char const phase[] = "LibC: __libc_init done";
+    int string_id = perf_register_string(phase, sizeof(phase) - 1);
+    if (string_id >= 0)
+        perf_event(PERF_EVENT_SIGNPOST, string_id, 0);
+#endif
 }
 }
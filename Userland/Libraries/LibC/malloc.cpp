@@ -6,7 +6,6 @@
 
 #include <AK/Debug.h>
 #include <AK/ScopedValueRollback.h>
-#include <AK/Vector.h>
 #include <LibELF/AuxiliaryVector.h>
 #include <assert.h>
 #include <errno.h>
@@ -41,7 +40,8 @@ static pthread_mutex_t s_malloc_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 constexpr size_t number_of_hot_chunked_blocks_to_keep_around = 16;
 constexpr size_t number_of_cold_chunked_blocks_to_keep_around = 16;
-constexpr size_t number_of_big_blocks_to_keep_around_per_size_class = 8;
+constexpr size_t number_of_big_blocks_to_keep_around = 8;
+constexpr size_t maximum_big_block_size_to_cache = 64 * MiB;
 
 static bool s_log_malloc = false;
 static bool s_scrub_malloc = true;
@@ -89,6 +89,9 @@ struct MemoryAuditingSuppressor {
 struct MallocStats {
     size_t number_of_malloc_calls;
 
+    size_t number_of_tcache_allocation_hits;
+    size_t number_of_depot_refill_hits;
+
     size_t number_of_big_allocator_hits;
     size_t number_of_big_allocator_purge_hits;
     size_t number_of_big_allocs;
@@ -101,6 +104,9 @@ struct MallocStats {
 
     size_t number_of_free_calls;
 
+    size_t number_of_tcache_free_hits;
+    size_t number_of_depot_keeps;
+
     size_t number_of_big_allocator_keeps;
     size_t number_of_big_allocator_frees;
 
@@ -123,10 +129,88 @@ struct Allocator {
     ChunkedBlock::List full_blocks;
 };
 
-struct BigAllocator {
-    Vector<BigAllocationBlock*, number_of_big_blocks_to_keep_around_per_size_class> blocks;
+// A small cache of recently freed BigAllocationBlocks of any size. Cached
+// blocks are made volatile, so the kernel decommits them lazily when it
+// needs the memory, but a repeated large allocation of the same size gets
+// its block (and, if it wasn't purged, its page mappings) back for free.
+struct BigBlockCache {
+    struct Entry {
+        BigAllocationBlock* block;
+        size_t size;
+    };
+
+    BigAllocationBlock* take_block_with_size(size_t size)
+    {
+        for (size_t i = 0; i < count; ++i) {
+            if (entries[i].size == size) {
+                auto* block = entries[i].block;
+                for (size_t j = i + 1; j < count; ++j)
+                    entries[j - 1] = entries[j];
+                --count;
+                return block;
+            }
+        }
+        return nullptr;
+    }
+
+    // Inserts a block, evicting the oldest entry if the cache is full.
+    // The caller is responsible for unmapping the returned eviction victim.
+    Entry insert(BigAllocationBlock* block, size_t size)
+    {
+        Entry evicted { nullptr, 0 };
+        if (count == number_of_big_blocks_to_keep_around) {
+            evicted = entries[0];
+            for (size_t j = 1; j < count; ++j)
+                entries[j - 1] = entries[j];
+            --count;
+        }
+        entries[count++] = { block, size };
+        return evicted;
+    }
+
+    size_t count;
+    Entry entries[number_of_big_blocks_to_keep_around];
+};
+
+static BigBlockCache s_big_block_cache; // Guarded by s_malloc_mutex.
+
+// Thread-local allocation caches (tcache): each thread keeps a small bin of
+// free chunks per cached size class, so the common malloc/free pair is a
+// handful of instructions and never takes s_malloc_mutex. Bins refill and
+// flush in batches. A flushed batch gets chained through the chunks' first
+// words and parked in a global depot, where a refill on any thread can adopt
+// the whole batch with one pointer swap; that's what keeps cross-thread
+// producer/consumer free patterns off the slow path too.
+constexpr size_t number_of_tcache_size_classes = 7; // 16..1008; bigger chunks aren't worth caching.
+constexpr size_t tcache_bin_capacity = 32;
+constexpr size_t tcache_batch_size = tcache_bin_capacity / 2;
+constexpr size_t number_of_batches_to_keep_in_depot = 4;
+static_assert(number_of_tcache_size_classes <= num_size_classes);
+
+struct TCacheBin {
+    size_t count;
+    void* chunks[tcache_bin_capacity];
 };
 
+struct DepotBin {
+    size_t count;
+    FreelistEntry* batches[number_of_batches_to_keep_in_depot];
+};
+
+static bool s_tcache_enabled = true;
+static __thread bool t_tcache_dead = false;
+static __thread TCacheBin t_tcache_bins[number_of_tcache_size_classes];
+static DepotBin s_depot_bins[number_of_tcache_size_classes]; // Guarded by s_malloc_mutex.
+
+static ssize_t tcache_class_for_chunk_size(size_t chunk_size)
+{
+    for (size_t i = 0; i < number_of_tcache_size_classes; ++i) {
+        if (size_classes[i] == chunk_size)
+            return i;
+    }
+    return -1;
+}
+
 // Allocators will be initialized in __malloc_init.
 // We can not rely on global constructors to initialize them,
 // because they must be initialized before other global constructors
@@ -134,18 +218,12 @@ struct BigAllocator {
 // them. We could have used AK::NeverDestoyed to prevent the latter,
 // but it would have not helped with the former.
 alignas(Allocator) static u8 g_allocators_storage[sizeof(Allocator) * num_size_classes];
-alignas(BigAllocator) static u8 g_big_allocators_storage[sizeof(BigAllocator)];
 
 static inline Allocator (&allocators())[num_size_classes]
 {
     return reinterpret_cast<Allocator(&)[num_size_classes]>(g_allocators_storage);
 }
 
-static inline BigAllocator (&big_allocators())[1]
-{
-    return reinterpret_cast<BigAllocator(&)[1]>(g_big_allocators_storage);
-}
-
 static Allocator* allocator_for_size(size_t size, size_t& good_size)
 {
     for (size_t i = 0; size_classes[i]; ++i) {
@@ -158,15 +236,6 @@ static Allocator* allocator_for_size(size_t size, size_t& good_size)
     return nullptr;
 }
 
-#ifdef RECYCLE_BIG_ALLOCATIONS
-static BigAllocator* big_allocator_for_size(size_t size)
-{
-    if (size == 65536)
-        return &big_allocators()[0];
-    return nullptr;
-}
-#endif
-
 extern "C" {
 
 static void* os_alloc(size_t size, const char* name)
@@ -191,58 +260,9 @@ enum class CallerWillInitializeMemory {
     Yes,
 };
 
-static void* malloc_impl(size_t size, CallerWillInitializeMemory caller_will_initialize_memory)
+// Called with s_malloc_mutex held.
+static void* allocate_chunk(Allocator* allocator, size_t good_size)
 {
-    if (s_log_malloc)
-        dbgln("LibC: malloc({})", size);
-
-    if (!size) {
-        // Legally we could just return a null pointer here, but this is more
-        // compatible with existing software.
-        size = 1;
-    }
-
-    g_malloc_stats.number_of_malloc_calls++;
-
-    size_t good_size;
-    auto* allocator = allocator_for_size(size, good_size);
-
-    PthreadMutexLocker locker(s_malloc_mutex);
-
-    if (!allocator) {
-        size_t real_size = round_up_to_power_of_two(sizeof(BigAllocationBlock) + size, ChunkedBlock::block_size);
-#ifdef RECYCLE_BIG_ALLOCATIONS
-        if (auto* allocator = big_allocator_for_size(real_size)) {
-            if (!allocator->blocks.is_empty()) {
-                g_malloc_stats.number_of_big_allocator_hits++;
-                auto* block = allocator->blocks.take_last();
-                int rc = madvise(block, real_size, MADV_SET_NONVOLATILE);
-                bool this_block_was_purged = rc == 1;
-                if (rc < 0) {
-                    perror("madvise");
-                    VERIFY_NOT_REACHED();
-                }
-                if (mprotect(block, real_size, PROT_READ | PROT_WRITE) < 0) {
-                    perror("mprotect");
-                    VERIFY_NOT_REACHED();
-                }
-                if (this_block_was_purged) {
-                    g_malloc_stats.number_of_big_allocator_purge_hits++;
-                    new (block) BigAllocationBlock(real_size);
-                }
-
-                ue_notify_malloc(&block->m_slot[0], size);
-                return &block->m_slot[0];
-            }
-        }
-#endif
-        g_malloc_stats.number_of_big_allocs++;
-        auto* block = (BigAllocationBlock*)os_alloc(real_size, "malloc: BigAllocationBlock");
-        new (block) BigAllocationBlock(real_size);
-        ue_notify_malloc(&block->m_slot[0], size);
-        return &block->m_slot[0];
-    }
-
     ChunkedBlock* block = nullptr;
     for (auto& current : allocator->usable_blocks) {
         if (current.free_chunks()) {
@@ -313,61 +333,108 @@ static void* malloc_impl(size_t size, CallerWillInitializeMemory caller_will_ini
         allocator->full_blocks.append(*block);
     }
     dbgln_if(MALLOC_DEBUG, "LibC: allocated {:p} (chunk in block {:p}, size {})", ptr, block, block->bytes_per_chunk());
+    return ptr;
+}
 
-    if (s_scrub_malloc && caller_will_initialize_memory == CallerWillInitializeMemory::No)
-        memset(ptr, MALLOC_SCRUB_BYTE, block->m_size);
+static void* tcache_allocate(Allocator* allocator, size_t good_size)
+{
+    if (!s_tcache_enabled || t_tcache_dead)
+        return nullptr;
+    ssize_t class_index = tcache_class_for_chunk_size(good_size);
+    if (class_index < 0)
+        return nullptr;
 
-    ue_notify_malloc(ptr, size);
-    return ptr;
+    auto& bin = t_tcache_bins[class_index];
+    if (bin.count == 0) {
+        PthreadMutexLocker locker(s_malloc_mutex);
+        auto& depot = s_depot_bins[class_index];
+        if (depot.count > 0) {
+            g_malloc_stats.number_of_depot_refill_hits++;
+            auto* entry = depot.batches[--depot.count];
+            while (entry) {
+                bin.chunks[bin.count++] = entry;
+                entry = entry->next;
+            }
+        } else {
+            for (size_t i = 0; i < tcache_batch_size; ++i)
+                bin.chunks[bin.count++] = allocate_chunk(allocator, good_size);
+        }
+    } else {
+        g_malloc_stats.number_of_tcache_allocation_hits++;
+    }
+    return bin.chunks[--bin.count];
 }
 
-static void free_impl(void* ptr)
+static void* malloc_impl(size_t size, CallerWillInitializeMemory caller_will_initialize_memory)
 {
-    ScopedValueRollback rollback(errno);
+    if (s_log_malloc)
+        dbgln("LibC: malloc({})", size);
 
-    if (!ptr)
-        return;
+    if (!size) {
+        // Legally we could just return a null pointer here, but this is more
+        // compatible with existing software.
+        size = 1;
+    }
 
-    g_malloc_stats.number_of_free_calls++;
+    g_malloc_stats.number_of_malloc_calls++;
 
-    void* block_base = (void*)((FlatPtr)ptr & ChunkedBlock::ChunkedBlock::block_mask);
-    size_t magic = *(size_t*)block_base;
+    size_t good_size;
+    auto* allocator = allocator_for_size(size, good_size);
+
+    if (allocator) {
+        if (void* ptr = tcache_allocate(allocator, good_size)) {
+            if (s_scrub_malloc && caller_will_initialize_memory == CallerWillInitializeMemory::No)
+                memset(ptr, MALLOC_SCRUB_BYTE, good_size);
+            ue_notify_malloc(ptr, size);
+            return ptr;
+        }
+    }
 
     PthreadMutexLocker locker(s_malloc_mutex);
 
-    if (magic == MAGIC_BIGALLOC_HEADER) {
-        auto* block = (BigAllocationBlock*)block_base;
+    if (!allocator) {
+        size_t real_size = round_up_to_power_of_two(sizeof(BigAllocationBlock) + size, ChunkedBlock::block_size);
 #ifdef RECYCLE_BIG_ALLOCATIONS
-        if (auto* allocator = big_allocator_for_size(block->m_size)) {
-            if (allocator->blocks.size() < number_of_big_blocks_to_keep_around_per_size_class) {
-                g_malloc_stats.number_of_big_allocator_keeps++;
-                allocator->blocks.append(block);
-                size_t this_block_size = block->m_size;
-                if (mprotect(block, this_block_size, PROT_NONE) < 0) {
-                    perror("mprotect");
-                    VERIFY_NOT_REACHED();
-                }
-                if (madvise(block, this_block_size, MADV_SET_VOLATILE) != 0) {
-                    perror("madvise");
-                    VERIFY_NOT_REACHED();
-                }
-                return;
+        if (auto* block = s_big_block_cache.take_block_with_size(real_size)) {
+            g_malloc_stats.number_of_big_allocator_hits++;
+            int rc = madvise(block, real_size, MADV_SET_NONVOLATILE);
+            bool this_block_was_purged = rc == 1;
+            if (rc < 0) {
+                perror("madvise");
+                VERIFY_NOT_REACHED();
+            }
+            if (mprotect(block, real_size, PROT_READ | PROT_WRITE) < 0) {
+                perror("mprotect");
+                VERIFY_NOT_REACHED();
             }
+            if (this_block_was_purged) {
+                g_malloc_stats.number_of_big_allocator_purge_hits++;
+                new (block) BigAllocationBlock(real_size);
+            }
+
+            ue_notify_malloc(&block->m_slot[0], size);
+            return &block->m_slot[0];
         }
 #endif
-        g_malloc_stats.number_of_big_allocator_frees++;
-        os_free(block, block->m_size);
-        return;
+        g_malloc_stats.number_of_big_allocs++;
+        auto* block = (BigAllocationBlock*)os_alloc(real_size, "malloc: BigAllocationBlock");
+        new (block) BigAllocationBlock(real_size);
+        ue_notify_malloc(&block->m_slot[0], size);
+        return &block->m_slot[0];
     }
 
-    assert(magic == MAGIC_PAGE_HEADER);
-    auto* block = (ChunkedBlock*)block_base;
+    void* ptr = allocate_chunk(allocator, good_size);
 
-    dbgln_if(MALLOC_DEBUG, "LibC: freeing {:p} in allocator {:p} (size={}, used={})", ptr, block, block->bytes_per_chunk(), block->used_chunks());
+    if (s_scrub_malloc && caller_will_initialize_memory == CallerWillInitializeMemory::No)
+        memset(ptr, MALLOC_SCRUB_BYTE, good_size);
 
-    if (s_scrub_free)
-        memset(ptr, FREE_SCRUB_BYTE, block->bytes_per_chunk());
+    ue_notify_malloc(ptr, size);
+    return ptr;
+}
 
+// Called with s_malloc_mutex held.
+static void free_chunk(ChunkedBlock* block, void* ptr)
+{
     auto* entry = (FreelistEntry*)ptr;
     entry->next = block->m_freelist;
     block->m_freelist = entry;
@@ -410,6 +477,97 @@ static void free_impl(void* ptr)
     }
 }
 
+static void tcache_flush_batch(TCacheBin& bin, DepotBin& depot)
+{
+    PthreadMutexLocker locker(s_malloc_mutex);
+    if (depot.count < number_of_batches_to_keep_in_depot) {
+        g_malloc_stats.number_of_depot_keeps++;
+        FreelistEntry* head = nullptr;
+        for (size_t i = 0; i < tcache_batch_size; ++i) {
+            auto* entry = (FreelistEntry*)bin.chunks[--bin.count];
+            entry->next = head;
+            head = entry;
+        }
+        depot.batches[depot.count++] = head;
+        return;
+    }
+    for (size_t i = 0; i < tcache_batch_size; ++i) {
+        void* chunk = bin.chunks[--bin.count];
+        free_chunk((ChunkedBlock*)((FlatPtr)chunk & ChunkedBlock::block_mask), chunk);
+    }
+}
+
+static void free_impl(void* ptr)
+{
+    ScopedValueRollback rollback(errno);
+
+    if (!ptr)
+        return;
+
+    g_malloc_stats.number_of_free_calls++;
+
+    void* block_base = (void*)((FlatPtr)ptr & ChunkedBlock::ChunkedBlock::block_mask);
+    size_t magic = *(size_t*)block_base;
+
+    if (magic == MAGIC_PAGE_HEADER && s_tcache_enabled && !t_tcache_dead) {
+        // NOTE: m_size is stable without the lock; a block with an
+        // outstanding chunk can't be recycled or released.
+        auto* block = (ChunkedBlock*)block_base;
+        ssize_t class_index = tcache_class_for_chunk_size(block->m_size);
+        if (class_index >= 0) {
+            g_malloc_stats.number_of_tcache_free_hits++;
+            if (s_scrub_free)
+                memset(ptr, FREE_SCRUB_BYTE, block->m_size);
+            auto& bin = t_tcache_bins[class_index];
+            if (bin.count == tcache_bin_capacity)
+                tcache_flush_batch(bin, s_depot_bins[class_index]);
+            bin.chunks[bin.count++] = ptr;
+            return;
+        }
+    }
+
+    PthreadMutexLocker locker(s_malloc_mutex);
+
+    if (magic == MAGIC_BIGALLOC_HEADER) {
+        auto* block = (BigAllocationBlock*)block_base;
+        size_t this_block_size = block->m_size;
+#ifdef RECYCLE_BIG_ALLOCATIONS
+        if (this_block_size <= maximum_big_block_size_to_cache) {
+            g_malloc_stats.number_of_big_allocator_keeps++;
+            // Make the block volatile so the kernel decommits it whenever it
+            // wants the memory back; our RSS doesn't hold on to cached blocks.
+            if (mprotect(block, this_block_size, PROT_NONE) < 0) {
+                perror("mprotect");
+                VERIFY_NOT_REACHED();
+            }
+            if (madvise(block, this_block_size, MADV_SET_VOLATILE) != 0) {
+                perror("madvise");
+                VERIFY_NOT_REACHED();
+            }
+            auto evicted = s_big_block_cache.insert(block, this_block_size);
+            if (evicted.block) {
+                g_malloc_stats.number_of_big_allocator_frees++;
+                os_free(evicted.block, evicted.size);
+            }
+            return;
+        }
+#endif
+        g_malloc_stats.number_of_big_allocator_frees++;
+        os_free(block, this_block_size);
+        return;
+    }
+
+    assert(magic == MAGIC_PAGE_HEADER);
+    auto* block = (ChunkedBlock*)block_base;
+
+    dbgln_if(MALLOC_DEBUG, "LibC: freeing {:p} in allocator {:p} (size={}, used={})", ptr, block, block->bytes_per_chunk(), block->used_chunks());
+
+    if (s_scrub_free)
+        memset(ptr, FREE_SCRUB_BYTE, block->bytes_per_chunk());
+
+    free_chunk(block, ptr);
+}
+
 void* malloc(size_t size)
 {
     MemoryAuditingSuppressor suppressor;
@@ -493,15 +651,19 @@ void __malloc_init()
     s_in_userspace_emulator = (int)syscall(SC_emuctl, 0) != -ENOSYS;
     if (s_in_userspace_emulator) {
         // Don't bother scrubbing memory if we're running in UE since it
-        // keeps track of heap memory anyway.
+        // keeps track of heap memory anyway. Also don't cache chunks, so
+        // UE sees every allocation the moment it happens.
         s_scrub_malloc = false;
         s_scrub_free = false;
+        s_tcache_enabled = false;
     }
 
     if (secure_getenv("LIBC_NOSCRUB_MALLOC"))
         s_scrub_malloc = false;
     if (secure_getenv("LIBC_NOSCRUB_FREE"))
         s_scrub_free = false;
+    if (secure_getenv("LIBC_NOTCACHE_MALLOC"))
+        s_tcache_enabled = false;
     if (secure_getenv("LIBC_LOG_MALLOC"))
         s_log_malloc = true;
     if (secure_getenv("LIBC_PROFILE_MALLOC"))
@@ -511,14 +673,31 @@ void __malloc_init()
         new (&allocators()[i]) Allocator();
         allocators()[i].size = size_classes[i];
     }
+}
 
-    new (&big_allocators()[0])(BigAllocator);
+void __malloc_thread_cleanup()
+{
+    if (!s_tcache_enabled)
+        return;
+    // Return the dying thread's cached chunks; nobody would ever reuse them.
+    t_tcache_dead = true;
+    PthreadMutexLocker locker(s_malloc_mutex);
+    for (size_t class_index = 0; class_index < number_of_tcache_size_classes; ++class_index) {
+        auto& bin = t_tcache_bins[class_index];
+        while (bin.count) {
+            void* chunk = bin.chunks[--bin.count];
+            free_chunk((ChunkedBlock*)((FlatPtr)chunk & ChunkedBlock::block_mask), chunk);
+        }
+    }
 }
 
 void serenity_dump_malloc_stats()
 {
     dbgln("# malloc() calls: {}", g_malloc_stats.number_of_malloc_calls);
     dbgln();
+    dbgln("tcache hits: {}", g_malloc_stats.number_of_tcache_allocation_hits);
+    dbgln("depot refill hits: {}", g_malloc_stats.number_of_depot_refill_hits);
+    dbgln();
     dbgln("big alloc hits: {}", g_malloc_stats.number_of_big_allocator_hits);
     dbgln("big alloc hits that were purged: {}", g_malloc_stats.number_of_big_allocator_purge_hits);
     dbgln("big allocs: {}", g_malloc_stats.number_of_big_allocs);
@@ -531,6 +710,9 @@ void serenity_dump_malloc_stats()
     dbgln();
     dbgln("# free() calls: {}", g_malloc_stats.number_of_free_calls);
     dbgln();
+    dbgln("tcache free hits: {}", g_malloc_stats.number_of_tcache_free_hits);
+    dbgln("depot keeps: {}", g_malloc_stats.number_of_depot_keeps);
+    dbgln();
     dbgln("big alloc keeps: {}", g_malloc_stats.number_of_big_allocator_keeps);
     dbgln("big alloc frees: {}", g_malloc_stats.number_of_big_allocator_frees);
     dbgln();
@@ -37,4 +37,16 @@ int sched_getparam(pid_t pid, struct sched_param* param)
     int rc = syscall(SC_sched_getparam, pid, param);
     __RETURN_WITH_ERRNO(rc, rc, -1);
 }
+
+int sched_setscheduler(pid_t pid, int policy, const struct sched_param* param)
+{
+    int rc = syscall(SC_sched_setscheduler, pid, policy, param);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
+int sched_getscheduler(pid_t pid)
+{
+    int rc = syscall(SC_sched_getscheduler, pid);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <Kernel/API/EventQueue.h>
 #include <Kernel/API/POSIX/futex.h>
 #include <Kernel/API/POSIX/serenity.h>
 #include <stdio.h>
@@ -54,6 +55,19 @@ int get_stack_bounds(uintptr_t* user_stack_base, size_t* user_stack_size);
 
 int anon_create(size_t size, int options);
 
+// Submits a batch of read/write operations in one kernel entry. Each op's
+// result field receives the number of bytes transferred or a negative errno;
+// ops that would block fail with -EAGAIN instead of blocking the batch.
+int iobatch(struct iobatch_op* ops, size_t count);
+
+// A persistent kernel-side interest set for event loops; registrations made
+// with event_queue_ctl() stick around, and event_queue_wait() hands back
+// whatever is ready as a compact list. See <Kernel/API/EventQueue.h> for the
+// event and op definitions.
+int event_queue_create(unsigned flags);
+int event_queue_ctl(int queue_fd, int op, int fd, uint32_t events);
+int event_queue_wait(int queue_fd, struct EventQueueEvent* events, size_t max_events, const struct timespec* timeout);
+
 int serenity_readlink(const char* path, size_t path_length, char* buffer, size_t buffer_size);
 
 int getkeymap(char* name_buffer, size_t name_buffer_size, uint32_t* map, uint32_t* shift_map, uint32_t* alt_map, uint32_t* altgr_map, uint32_t* shift_altgr_map);
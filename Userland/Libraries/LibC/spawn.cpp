@@ -101,7 +101,10 @@ extern "C" {
 
 int posix_spawn(pid_t* out_pid, const char* path, const posix_spawn_file_actions_t* file_actions, const posix_spawnattr_t* attr, char* const argv[], char* const envp[])
 {
-    pid_t child_pid = fork();
+    // vfork() skips duplicating the parent's address space since we're about
+    // to exec anyway. This is safe because the child path below (attribute
+    // handling, file actions, execve) doesn't allocate on the heap.
+    pid_t child_pid = vfork();
     if (child_pid < 0)
         return errno;
 
@@ -115,6 +118,8 @@ int posix_spawn(pid_t* out_pid, const char* path, const posix_spawn_file_actions
 
 int posix_spawnp(pid_t* out_pid, const char* path, const posix_spawn_file_actions_t* file_actions, const posix_spawnattr_t* attr, char* const argv[], char* const envp[])
 {
+    // NOTE: We can't use vfork() here: execvpe() allocates while searching
+    // $PATH, which a vfork child must not do.
     pid_t child_pid = fork();
     if (child_pid < 0)
         return errno;
@@ -54,6 +54,11 @@ public:
     size_t read(u8*, size_t);
     size_t write(const u8*, size_t);
 
+    // Single-byte fast paths that hit the buffer directly, for the
+    // *_unlocked() APIs and for the locked getc()/putc() family.
+    int getc_unlocked();
+    int putc_unlocked(u8 byte);
+
     bool gets(u8*, size_t);
     bool ungetc(u8 byte) { return m_buffer.enqueue_front(byte); }
 
@@ -78,6 +83,7 @@ private:
         ~Buffer();
 
         int mode() const { return m_mode; }
+        size_t capacity() const { return m_capacity; }
         void setbuf(u8* data, int mode, size_t size);
         // Make sure to call realize() before enqueuing any data.
         // Dequeuing can be attempted without it.
@@ -96,6 +102,13 @@ private:
 
         bool enqueue_front(u8 byte);
 
+        // Streams that repeatedly fill or drain the entire buffer in one go
+        // are sequential; grow the buffer for them so fewer syscalls move the
+        // same amount of data.
+        void record_whole_buffer_use();
+        void record_partial_buffer_use() { m_consecutive_whole_buffer_uses = 0; }
+        void try_grow_if_sequential();
+
     private:
         // Note: the fields here are arranged this way
         // to make sizeof(Buffer) smaller.
@@ -105,6 +118,7 @@ private:
         size_t m_end { 0 };
 
         int m_mode { -1 };
+        u8 m_consecutive_whole_buffer_uses { 0 };
         u8 m_unget_buffer { 0 };
         bool m_ungotten : 1 { false };
         bool m_data_is_malloced : 1 { false };
@@ -222,6 +236,9 @@ ssize_t FILE::do_write(const u8* data, size_t size)
 bool FILE::read_into_buffer()
 {
     m_buffer.realize(m_fd);
+    // We only refill once the buffer has run dry, which is exactly the moment
+    // a sequential stream's buffer can be grown without moving any data.
+    m_buffer.try_grow_if_sequential();
 
     size_t available_size;
     u8* data = m_buffer.begin_enqueue(available_size);
@@ -233,6 +250,11 @@ bool FILE::read_into_buffer()
     if (nread <= 0)
         return false;
 
+    if (static_cast<size_t>(nread) == available_size)
+        m_buffer.record_whole_buffer_use();
+    else
+        m_buffer.record_partial_buffer_use();
+
     m_buffer.did_enqueue(nread);
     return true;
 }
@@ -268,7 +290,19 @@ size_t FILE::read(u8* data, size_t size)
             size_t queued_size;
             const u8* queued_data = m_buffer.begin_dequeue(queued_size);
             if (queued_size == 0) {
-                // Nothing buffered; we're going to have to read some.
+                // Nothing buffered. If the caller wants at least a bufferful
+                // anyway, skip the staging buffer and read straight into the
+                // caller's buffer.
+                if (size >= m_buffer.capacity()) {
+                    ssize_t nread = do_read(data, size);
+                    if (nread <= 0)
+                        return total_read;
+                    total_read += nread;
+                    data += nread;
+                    size -= nread;
+                    continue;
+                }
+                // We're going to have to read some.
                 bool read_some_more = read_into_buffer();
                 if (read_some_more) {
                     // Great, now try this again.
@@ -307,11 +341,24 @@ size_t FILE::write(const u8* data, size_t size)
 
         if (m_buffer.may_use()) {
             m_buffer.realize(m_fd);
+            m_buffer.try_grow_if_sequential();
+            // If nothing is staged and the caller is writing at least a
+            // bufferful, don't bounce it through the buffer at all.
+            if (!m_buffer.is_not_empty() && size >= m_buffer.capacity()) {
+                ssize_t nwritten = do_write(data, size);
+                if (nwritten < 0)
+                    return total_written;
+                total_written += nwritten;
+                data += nwritten;
+                size -= nwritten;
+                continue;
+            }
             // Try writing into the buffer.
             size_t available_size;
             u8* buffer_data = m_buffer.begin_enqueue(available_size);
             if (available_size == 0) {
                 // There's no space in the buffer; we're going to free some.
+                m_buffer.record_whole_buffer_use();
                 bool freed_some_space = write_from_buffer();
                 if (freed_some_space) {
                     // Great, now try this again.
@@ -344,6 +391,47 @@ size_t FILE::write(const u8* data, size_t size)
     return total_written;
 }
 
+int FILE::getc_unlocked()
+{
+    // Fast path: take the next byte straight out of the buffer.
+    size_t queued_size;
+    const u8* queued_data = m_buffer.begin_dequeue(queued_size);
+    if (queued_size > 0) {
+        m_flags |= Flags::LastRead;
+        m_flags &= ~Flags::LastWrite;
+        u8 byte = queued_data[0];
+        m_buffer.did_dequeue(1);
+        return byte;
+    }
+
+    u8 byte;
+    size_t nread = read(&byte, 1);
+    return nread == 1 ? byte : EOF;
+}
+
+int FILE::putc_unlocked(u8 byte)
+{
+    // Fast path: stash the byte straight into the buffer, unless it might
+    // have to trigger a flush.
+    if (m_buffer.may_use()) {
+        m_buffer.realize(m_fd);
+        if (m_buffer.mode() == _IOFBF || (m_buffer.mode() == _IOLBF && byte != '\n')) {
+            size_t available_size;
+            u8* buffer_data = m_buffer.begin_enqueue(available_size);
+            if (available_size > 0) {
+                m_flags &= ~Flags::LastRead;
+                m_flags |= Flags::LastWrite;
+                buffer_data[0] = byte;
+                m_buffer.did_enqueue(1);
+                return byte;
+            }
+        }
+    }
+
+    size_t nwritten = write(&byte, 1);
+    return nwritten == 1 ? byte : EOF;
+}
+
 bool FILE::gets(u8* data, size_t size)
 {
     // gets() is a lot like read(), but it is different enough in how it
@@ -585,6 +673,35 @@ bool FILE::Buffer::enqueue_front(u8 byte)
     return true;
 }
 
+void FILE::Buffer::record_whole_buffer_use()
+{
+    if (m_consecutive_whole_buffer_uses < NumericLimits<u8>::max())
+        ++m_consecutive_whole_buffer_uses;
+}
+
+void FILE::Buffer::try_grow_if_sequential()
+{
+    static constexpr size_t maximum_adaptive_capacity = 32 * KiB;
+    static constexpr u8 whole_buffer_uses_before_growing = 4;
+
+    if (m_consecutive_whole_buffer_uses < whole_buffer_uses_before_growing)
+        return;
+    if (!m_data_is_malloced || m_mode != _IOFBF || m_capacity >= maximum_adaptive_capacity)
+        return;
+    // Only grow in the quiescent state, so no buffered data has to move.
+    if (!m_empty || m_ungotten || m_begin != 0 || m_end != 0)
+        return;
+
+    size_t new_capacity = min(m_capacity * 2, maximum_adaptive_capacity);
+    u8* new_data = reinterpret_cast<u8*>(malloc(new_capacity));
+    if (!new_data)
+        return;
+    free(m_data);
+    m_data = new_data;
+    m_capacity = new_capacity;
+    m_consecutive_whole_buffer_uses = 0;
+}
+
 void FILE::lock()
 {
     __pthread_mutex_lock(&m_mutex);
@@ -685,21 +802,14 @@ char* fgets(char* buffer, int size, FILE* stream)
 int fgetc(FILE* stream)
 {
     VERIFY(stream);
-    char ch;
-    size_t nread = fread(&ch, sizeof(char), 1, stream);
-    if (nread == 1)
-        return ch;
-    return EOF;
+    ScopedFileLock lock(stream);
+    return stream->getc_unlocked();
 }
 
 int fgetc_unlocked(FILE* stream)
 {
     VERIFY(stream);
-    char ch;
-    size_t nread = fread_unlocked(&ch, sizeof(char), 1, stream);
-    if (nread == 1)
-        return ch;
-    return EOF;
+    return stream->getc_unlocked();
 }
 
 int getc(FILE* stream)
@@ -717,6 +827,11 @@ int getchar()
     return getc(stdin);
 }
 
+int getchar_unlocked()
+{
+    return getc_unlocked(stdin);
+}
+
 ssize_t getdelim(char** lineptr, size_t* n, int delim, FILE* stream)
 {
     if (!lineptr || !n) {
@@ -779,13 +894,14 @@ int ungetc(int c, FILE* stream)
 int fputc(int ch, FILE* stream)
 {
     VERIFY(stream);
-    u8 byte = ch;
     ScopedFileLock lock(stream);
-    size_t nwritten = stream->write(&byte, 1);
-    if (nwritten == 0)
-        return EOF;
-    VERIFY(nwritten == 1);
-    return byte;
+    return stream->putc_unlocked(ch);
+}
+
+int fputc_unlocked(int ch, FILE* stream)
+{
+    VERIFY(stream);
+    return stream->putc_unlocked(ch);
 }
 
 int putc(int ch, FILE* stream)
@@ -793,11 +909,21 @@ int putc(int ch, FILE* stream)
     return fputc(ch, stream);
 }
 
+int putc_unlocked(int ch, FILE* stream)
+{
+    return fputc_unlocked(ch, stream);
+}
+
 int putchar(int ch)
 {
     return putc(ch, stdout);
 }
 
+int putchar_unlocked(int ch)
+{
+    return putc_unlocked(ch, stdout);
+}
+
 int fputs(const char* s, FILE* stream)
 {
     VERIFY(stream);
@@ -849,18 +975,24 @@ size_t fread(void* ptr, size_t size, size_t nmemb, FILE* stream)
     return fread_unlocked(ptr, size, nmemb, stream);
 }
 
-size_t fwrite(const void* ptr, size_t size, size_t nmemb, FILE* stream)
+size_t fwrite_unlocked(const void* ptr, size_t size, size_t nmemb, FILE* stream)
 {
     VERIFY(stream);
     VERIFY(!Checked<size_t>::multiplication_would_overflow(size, nmemb));
 
-    ScopedFileLock lock(stream);
     size_t nwritten = stream->write(reinterpret_cast<const u8*>(ptr), size * nmemb);
     if (!nwritten)
         return 0;
     return nwritten / size;
 }
 
+size_t fwrite(const void* ptr, size_t size, size_t nmemb, FILE* stream)
+{
+    VERIFY(stream);
+    ScopedFileLock lock(stream);
+    return fwrite_unlocked(ptr, size, nmemb, stream);
+}
+
 int fseek(FILE* stream, long offset, int whence)
 {
     VERIFY(stream);
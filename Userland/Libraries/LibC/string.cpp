@@ -19,6 +19,51 @@
 
 extern "C" {
 
+// Everything in the system funnels through memcpy/memset/memcmp/strlen,
+// and the sizes we see are mostly small (copies under 128 bytes), with the
+// occasional huge buffer. The routines below are tuned for that: small
+// sizes use a few (possibly overlapping) fixed-width accesses, medium
+// sizes use unaligned 16-byte SSE2 accesses, and only large sizes fall
+// back to rep movsb/stosb, which wins once its startup cost is amortized.
+
+static constexpr size_t large_copy_threshold = 1 * KiB;
+
+ALWAYS_INLINE static u16 load_unaligned_u16(const u8* p)
+{
+    u16 value;
+    __builtin_memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+ALWAYS_INLINE static u32 load_unaligned_u32(const u8* p)
+{
+    u32 value;
+    __builtin_memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+ALWAYS_INLINE static u64 load_unaligned_u64(const u8* p)
+{
+    u64 value;
+    __builtin_memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+ALWAYS_INLINE static void store_unaligned_u16(u8* p, u16 value)
+{
+    __builtin_memcpy(p, &value, sizeof(value));
+}
+
+ALWAYS_INLINE static void store_unaligned_u32(u8* p, u32 value)
+{
+    __builtin_memcpy(p, &value, sizeof(value));
+}
+
+ALWAYS_INLINE static void store_unaligned_u64(u8* p, u64 value)
+{
+    __builtin_memcpy(p, &value, sizeof(value));
+}
+
 size_t strspn(const char* s, const char* accept)
 {
     const char* p = s;
@@ -47,10 +92,26 @@ size_t strcspn(const char* s, const char* reject)
 
 size_t strlen(const char* str)
 {
-    size_t len = 0;
-    while (*(str++))
-        ++len;
-    return len;
+    const char* start = str;
+
+    // Scan bytes until we reach a word boundary; an aligned word read can
+    // never cross into a page the string doesn't touch.
+    while ((FlatPtr)str & (sizeof(size_t) - 1)) {
+        if (!*str)
+            return str - start;
+        ++str;
+    }
+
+    constexpr size_t low_bits = explode_byte(0x01);
+    constexpr size_t high_bits = explode_byte(0x80);
+    auto* word = (const size_t*)str;
+    while (!((*word - low_bits) & ~*word & high_bits))
+        ++word;
+
+    str = (const char*)word;
+    while (*str)
+        ++str;
+    return str - start;
 }
 
 size_t strnlen(const char* str, size_t maxlen)
@@ -104,6 +165,20 @@ int memcmp(const void* v1, const void* v2, size_t n)
 {
     auto* s1 = (const uint8_t*)v1;
     auto* s2 = (const uint8_t*)v2;
+
+    while (n >= 8) {
+        u64 a = load_unaligned_u64(s1);
+        u64 b = load_unaligned_u64(s2);
+        if (a != b) {
+            // The lowest differing byte (we're little-endian) decides.
+            size_t i = __builtin_ctzll(a ^ b) / 8;
+            return s1[i] < s2[i] ? -1 : 1;
+        }
+        s1 += 8;
+        s2 += 8;
+        n -= 8;
+    }
+
     while (n-- > 0) {
         if (*s1++ != *s2++)
             return s1[-1] < s2[-1] ? -1 : 1;
@@ -113,41 +188,110 @@ int memcmp(const void* v1, const void* v2, size_t n)
 
 void* memcpy(void* dest_ptr, const void* src_ptr, size_t n)
 {
-    void* original_dest = dest_ptr;
+    auto* dest = (u8*)dest_ptr;
+    auto* src = (const u8*)src_ptr;
+
+    if (n < 16) {
+        // A pair of possibly-overlapping fixed-width copies covers any size.
+        if (n & 8) {
+            store_unaligned_u64(dest, load_unaligned_u64(src));
+            store_unaligned_u64(dest + n - 8, load_unaligned_u64(src + n - 8));
+        } else if (n & 4) {
+            store_unaligned_u32(dest, load_unaligned_u32(src));
+            store_unaligned_u32(dest + n - 4, load_unaligned_u32(src + n - 4));
+        } else if (n & 2) {
+            store_unaligned_u16(dest, load_unaligned_u16(src));
+            store_unaligned_u16(dest + n - 2, load_unaligned_u16(src + n - 2));
+        } else if (n & 1) {
+            *dest = *src;
+        }
+        return dest_ptr;
+    }
+
+#if ARCH(X86_64)
+    if (n < large_copy_threshold) {
+        // Unaligned 16-byte SSE2 copies; a final overlapping copy takes
+        // care of the tail.
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            asm volatile(
+                "movups (%0), %%xmm0\n"
+                "movups %%xmm0, (%1)\n" ::"r"(src + i),
+                "r"(dest + i)
+                : "xmm0", "memory");
+        }
+        if (i < n) {
+            asm volatile(
+                "movups (%0), %%xmm0\n"
+                "movups %%xmm0, (%1)\n" ::"r"(src + n - 16),
+                "r"(dest + n - 16)
+                : "xmm0", "memory");
+        }
+        return dest_ptr;
+    }
+#endif
+
     asm volatile(
         "rep movsb"
-        : "+D"(dest_ptr), "+S"(src_ptr), "+c"(n)::"memory");
-    return original_dest;
+        : "+D"(dest), "+S"(src), "+c"(n)::"memory");
+    return dest_ptr;
 }
 
 void* memset(void* dest_ptr, int c, size_t n)
 {
-    size_t dest = (size_t)dest_ptr;
-    // FIXME: Support starting at an unaligned address.
-    if (!(dest & 0x3) && n >= 12) {
-        size_t size_ts = n / sizeof(size_t);
-        size_t expanded_c = explode_byte((u8)c);
+    auto* dest = (u8*)dest_ptr;
+    u64 expanded_c = (u8)c * 0x0101010101010101ull;
+
+    if (n < 16) {
+        // A pair of possibly-overlapping fixed-width stores covers any size.
+        if (n & 8) {
+            store_unaligned_u64(dest, expanded_c);
+            store_unaligned_u64(dest + n - 8, expanded_c);
+        } else if (n & 4) {
+            store_unaligned_u32(dest, (u32)expanded_c);
+            store_unaligned_u32(dest + n - 4, (u32)expanded_c);
+        } else if (n & 2) {
+            store_unaligned_u16(dest, (u16)expanded_c);
+            store_unaligned_u16(dest + n - 2, (u16)expanded_c);
+        } else if (n & 1) {
+            *dest = (u8)c;
+        }
+        return dest_ptr;
+    }
+
+    // Fix up an unaligned start with one overlapping 8-byte store, then let
+    // rep stosl/stosq fill the bulk and rep stosb the tail.
+    size_t misalignment = (size_t)dest & (sizeof(size_t) - 1);
+    if (misalignment) {
+        store_unaligned_u64(dest, expanded_c);
+        size_t head = sizeof(size_t) - misalignment;
+        dest += head;
+        n -= head;
+    }
+
+    size_t size_ts = n / sizeof(size_t);
+    size_t count = size_ts;
 #if ARCH(I386)
-        asm volatile(
-            "rep stosl\n"
-            : "=D"(dest)
-            : "D"(dest), "c"(size_ts), "a"(expanded_c)
-            : "memory");
+    asm volatile(
+        "rep stosl\n"
+        : "+D"(dest), "+c"(count)
+        : "a"((size_t)expanded_c)
+        : "memory");
 #else
-        asm volatile(
-            "rep stosq\n"
-            : "=D"(dest)
-            : "D"(dest), "c"(size_ts), "a"(expanded_c)
-            : "memory");
+    asm volatile(
+        "rep stosq\n"
+        : "+D"(dest), "+c"(count)
+        : "a"(expanded_c)
+        : "memory");
 #endif
-        n -= size_ts * sizeof(size_t);
-        if (n == 0)
-            return dest_ptr;
-    }
+    n -= size_ts * sizeof(size_t);
+    if (n == 0)
+        return dest_ptr;
+
     asm volatile(
         "rep stosb\n"
-        : "=D"(dest), "=c"(n)
-        : "0"(dest), "1"(n), "a"(c)
+        : "+D"(dest), "+c"(n)
+        : "a"(c)
         : "memory");
     return dest_ptr;
 }
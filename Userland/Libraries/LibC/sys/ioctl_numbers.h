@@ -42,6 +42,19 @@ struct FBFlushRects {
     struct FBRect const* rects;
 };
 
+struct FBCursorImage {
+    unsigned width;
+    unsigned height;
+    unsigned hot_x;
+    unsigned hot_y;
+    unsigned const* pixels;
+};
+
+struct FBCursorPosition {
+    int x;
+    int y;
+};
+
 __END_DECLS
 
 enum IOCtlNumber {
@@ -64,6 +77,8 @@ enum IOCtlNumber {
     FB_IOCTL_GET_BUFFER_OFFSET,
     FB_IOCTL_SET_BUFFER,
     FB_IOCTL_FLUSH_BUFFERS,
+    FB_IOCTL_SET_CURSOR,
+    FB_IOCTL_MOVE_CURSOR,
     KEYBOARD_IOCTL_GET_NUM_LOCK,
     KEYBOARD_IOCTL_SET_NUM_LOCK,
     KEYBOARD_IOCTL_GET_CAPS_LOCK,
@@ -110,6 +125,8 @@ enum IOCtlNumber {
 #define FB_IOCTL_GET_BUFFER_OFFSET FB_IOCTL_GET_BUFFER_OFFSET
 #define FB_IOCTL_SET_BUFFER FB_IOCTL_SET_BUFFER
 #define FB_IOCTL_FLUSH_BUFFERS FB_IOCTL_FLUSH_BUFFERS
+#define FB_IOCTL_SET_CURSOR FB_IOCTL_SET_CURSOR
+#define FB_IOCTL_MOVE_CURSOR FB_IOCTL_MOVE_CURSOR
 #define KEYBOARD_IOCTL_GET_NUM_LOCK KEYBOARD_IOCTL_GET_NUM_LOCK
 #define KEYBOARD_IOCTL_SET_NUM_LOCK KEYBOARD_IOCTL_SET_NUM_LOCK
 #define KEYBOARD_IOCTL_GET_CAPS_LOCK KEYBOARD_IOCTL_GET_CAPS_LOCK
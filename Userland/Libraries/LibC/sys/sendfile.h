@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <sys/cdefs.h>
+#include <sys/types.h>
+
+__BEGIN_DECLS
+
+// Copies up to count bytes from the inode-backed in_fd to out_fd inside the
+// kernel, without a userspace buffer in between. If offset is non-null it is
+// the file position to read from and is advanced past the bytes sent;
+// otherwise in_fd's own cursor is used and advanced. Returns the number of
+// bytes sent, which may be short if out_fd is non-blocking and backed up.
+ssize_t sendfile(int out_fd, int in_fd, off_t* offset, size_t count);
+
+__END_DECLS
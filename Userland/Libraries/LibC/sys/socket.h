@@ -9,6 +9,8 @@
 #include <Kernel/API/POSIX/sys/socket.h>
 #include <sys/un.h>
 
+struct timespec;
+
 __BEGIN_DECLS
 
 int socket(int domain, int type, int protocol);
@@ -20,9 +22,11 @@ int connect(int sockfd, const struct sockaddr*, socklen_t);
 int shutdown(int sockfd, int how);
 ssize_t send(int sockfd, const void*, size_t, int flags);
 ssize_t sendmsg(int sockfd, const struct msghdr*, int flags);
+int sendmmsg(int sockfd, struct mmsghdr*, unsigned int vlen, int flags);
 ssize_t sendto(int sockfd, const void*, size_t, int flags, const struct sockaddr*, socklen_t);
 ssize_t recv(int sockfd, void*, size_t, int flags);
 ssize_t recvmsg(int sockfd, struct msghdr*, int flags);
+int recvmmsg(int sockfd, struct mmsghdr*, unsigned int vlen, int flags, const struct timespec* timeout);
 ssize_t recvfrom(int sockfd, void*, size_t, int flags, struct sockaddr*, socklen_t*);
 int getsockopt(int sockfd, int level, int option, void*, socklen_t*);
 int setsockopt(int sockfd, int level, int option, const void*, socklen_t);
@@ -72,7 +72,11 @@ pid_t fork()
 
 pid_t vfork()
 {
-    return fork();
+    // Unlike fork(), we deliberately don't run the pthread atfork handlers or
+    // reset s_cached_pid here: until the child execs or exits, its writes land
+    // in the parent's memory, so the child must not touch libc state.
+    int rc = syscall(SC_vfork);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
 }
 
 int execv(const char* path, char* const argv[])
@@ -58,11 +58,21 @@ Optional<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
             last_non_zero = i;
         }
     }
+    // Fills every prefix table slot whose low bits match the given
+    // stream-order code with the symbol and its code length.
+    auto fill_prefix_table = [&code](u16 stream_order_code, size_t code_length, u16 symbol) {
+        if (code_length > CanonicalCode::prefix_table_bits)
+            return;
+        for (size_t i = stream_order_code; i < code.m_prefix_table.size(); i += 1u << code_length)
+            code.m_prefix_table[i] = (symbol << 4) | code_length;
+    };
+
     if (non_zero_symbols == 1) { // special case - only 1 symbol
         code.m_symbol_codes.append(0b10);
         code.m_symbol_values.append(last_non_zero);
         code.m_bit_codes[last_non_zero] = 0;
         code.m_bit_code_lengths[last_non_zero] = 1;
+        fill_prefix_table(0, 1, last_non_zero);
         return code;
     }
 
@@ -82,6 +92,7 @@ Optional<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
             code.m_symbol_values.append(symbol);
             code.m_bit_codes[symbol] = fast_reverse16(start_bit | next_code, code_length); // DEFLATE writes huffman encoded symbols as lsb-first
             code.m_bit_code_lengths[symbol] = code_length;
+            fill_prefix_table(code.m_bit_codes[symbol], code_length, symbol);
 
             next_code++;
         }
@@ -94,8 +105,18 @@ Optional<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
     return code;
 }
 
-u32 CanonicalCode::read_symbol(InputBitStream& stream) const
+u32 CanonicalCode::read_symbol(LittleEndianInputBitStream& stream) const
 {
+    if (stream.has_any_error())
+        return UINT32_MAX;
+
+    // Fast path: the next prefix_table_bits bits identify most codes directly.
+    if (auto entry = m_prefix_table[stream.peek_bits(prefix_table_bits)]; entry != 0) {
+        stream.discard_bits(entry & 0xf);
+        return entry >> 4;
+    }
+
+    // Slow path for the rare codes longer than prefix_table_bits bits.
     u32 code_bits = 1;
 
     for (;;) {
@@ -103,8 +124,6 @@ u32 CanonicalCode::read_symbol(InputBitStream& stream) const
         if (code_bits >= (1 << 16))
             return UINT32_MAX; // the maximum symbol in deflate is 288, so we use UINT32_MAX (an impossible value) to indicate an error
 
-        // FIXME: This is very inefficient and could greatly be improved by implementing this
-        //        algorithm: https://www.hanshq.net/zip.html#huffdec
         size_t index;
         if (binary_search(m_symbol_codes.span(), code_bits, &index))
             return m_symbol_values[index];
@@ -155,14 +174,22 @@ bool DeflateDecompressor::CompressedBlock::try_read_more()
         }
         const auto distance = m_decompressor.decode_distance(distance_symbol);
 
-        for (size_t idx = 0; idx < length; ++idx) {
-            u8 byte = 0;
-            m_decompressor.m_output_stream.read({ &byte, sizeof(byte) }, distance);
+        // The output stream is always drained before we're asked to produce
+        // more, so the window has room for a maximum-length match. Copy it in
+        // chunks no larger than the distance, which both resolves overlapping
+        // matches correctly (each chunk picks up bytes written by the last
+        // one) and avoids going through the stream once per byte.
+        u8 buffer[DeflateCompressor::max_match_length];
+        size_t remaining = length;
+        while (remaining > 0) {
+            const auto chunk = min(remaining, min(static_cast<size_t>(distance), sizeof(buffer)));
+            m_decompressor.m_output_stream.read({ buffer, chunk }, distance);
             if (m_decompressor.m_output_stream.handle_any_error()) {
                 m_decompressor.set_fatal_error();
                 return false; // a back reference was requested that was too far back (outside our current sliding window)
             }
-            m_decompressor.m_output_stream << byte;
+            m_decompressor.m_output_stream.write_or_error({ buffer, chunk });
+            remaining -= chunk;
         }
 
         return true;
@@ -189,6 +216,12 @@ bool DeflateDecompressor::UncompressedBlock::try_read_more()
 }
 
 DeflateDecompressor::DeflateDecompressor(InputStream& stream)
+    : m_owned_input_stream(make<LittleEndianInputBitStream>(stream))
+    , m_input_stream(*m_owned_input_stream)
+{
+}
+
+DeflateDecompressor::DeflateDecompressor(LittleEndianInputBitStream& stream)
     : m_input_stream(stream)
 {
 }
@@ -510,6 +543,11 @@ DeflateCompressor::DeflateCompressor(OutputStream& stream, CompressionLevel comp
 {
     m_symbol_frequencies.fill(0);
     m_distance_frequencies.fill(0);
+
+    for (auto& slot : m_hash_head)
+        slot = empty_slot;
+    for (auto& slot : m_hash_prev)
+        slot = empty_slot;
 }
 
 DeflateCompressor::~DeflateCompressor()
@@ -590,8 +628,8 @@ size_t DeflateCompressor::find_back_match(size_t start, u16 hash, size_t previou
             break; // no remaining candidates
 
         VERIFY(candidate < start);
-        if (start - candidate > window_size)
-            break; // outside the window
+        if (start - candidate > max_back_reference_distance)
+            break; // too far away to encode (the chain only gets older from here)
 
         auto match_length = compare_match_candidate(start, candidate, previous_match_length, maximum_match_length);
 
@@ -688,12 +726,26 @@ void DeflateCompressor::generate_huffman_lengths(Array<u8, Size>& lengths, const
     }
 }
 
-void DeflateCompressor::lz77_compress_block()
+// The window slides by block_size whenever a block is flushed, so every chained
+// position moves down by block_size. Rebase all entries, dropping those that
+// refer to the block that just slid out of the window. This keeps matches into
+// the previous block reachable instead of starting every block from scratch.
+void DeflateCompressor::slide_hash_chains()
 {
-    for (auto& slot : m_hash_head) { // initialize chained hash table
-        slot = empty_slot;
-    }
+    auto rebase = [](u16 position) -> u16 {
+        if (position == empty_slot || position < block_size)
+            return empty_slot;
+        return position - block_size;
+    };
+
+    for (auto& head : m_hash_head)
+        head = rebase(head);
+    for (size_t i = 0; i < block_size; i++)
+        m_hash_prev[i] = rebase(m_hash_prev[i + block_size]);
+}
 
+void DeflateCompressor::lz77_compress_block()
+{
     auto insert_hash = [&](auto pos, auto hash) {
         auto window_pos = pos % window_size;
         m_hash_prev[window_pos] = m_hash_head[hash];
@@ -1043,6 +1095,7 @@ void DeflateCompressor::flush()
     m_distance_frequencies.fill(0);
     // On the final block this copy will potentially produce an invalid search window, but since its the final block we dont care
     pending_block().copy_trimmed_to({ m_rolling_window, block_size });
+    slide_hash_chains();
 }
 
 void DeflateCompressor::final_flush()
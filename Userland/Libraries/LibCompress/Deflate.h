@@ -11,6 +11,7 @@
 #include <AK/ByteBuffer.h>
 #include <AK/CircularDuplexStream.h>
 #include <AK/Endian.h>
+#include <AK/OwnPtr.h>
 #include <AK/Vector.h>
 #include <LibCompress/DeflateTables.h>
 
@@ -19,7 +20,7 @@ namespace Compress {
 class CanonicalCode {
 public:
     CanonicalCode() = default;
-    u32 read_symbol(InputBitStream&) const;
+    u32 read_symbol(LittleEndianInputBitStream&) const;
     void write_symbol(OutputBitStream&, u32) const;
 
     static const CanonicalCode& fixed_literal_codes();
@@ -27,11 +28,19 @@ public:
 
     static Optional<CanonicalCode> from_bytes(ReadonlyBytes);
 
+    static constexpr size_t prefix_table_bits = 8;
+
 private:
     // Decompression - indexed by code
     Vector<u16> m_symbol_codes;
     Vector<u16> m_symbol_values;
 
+    // Decompression fast path - indexed by the next prefix_table_bits bits of
+    // input (in stream order). A non-zero entry encodes (symbol << 4) | code
+    // length for every code no longer than prefix_table_bits, so most symbols
+    // decode with a single table lookup instead of a bit-by-bit walk.
+    Array<u16, 1 << prefix_table_bits> m_prefix_table {};
+
     // Compression - indexed by symbol
     Array<u16, 288> m_bit_codes {}; // deflate uses a maximum of 288 symbols (maximum of 32 for distances)
     Array<u16, 288> m_bit_code_lengths {};
@@ -75,6 +84,11 @@ public:
     friend UncompressedBlock;
 
     DeflateDecompressor(InputStream&);
+    // Decompresses from a bit stream shared with the caller. The bit reader
+    // buffers input ahead, so callers that expect data after the compressed
+    // stream (e.g. the gzip trailer) have to keep reading through the same
+    // bit stream instead of the underlying stream.
+    explicit DeflateDecompressor(LittleEndianInputBitStream&);
     ~DeflateDecompressor();
 
     size_t read(Bytes) override;
@@ -99,7 +113,8 @@ private:
         UncompressedBlock m_uncompressed_block;
     };
 
-    InputBitStream m_input_stream;
+    OwnPtr<LittleEndianInputBitStream> m_owned_input_stream;
+    LittleEndianInputBitStream& m_input_stream;
     CircularDuplexStream<32 * KiB> m_output_stream;
 };
 
@@ -118,6 +133,7 @@ public:
     static constexpr size_t max_huffman_distances = 32;
     static constexpr size_t min_match_length = 4;   // matches smaller than these are not worth the size of the back reference
     static constexpr size_t max_match_length = 258; // matches longer than these cannot be encoded using huffman codes
+    static constexpr size_t max_back_reference_distance = 32 * KiB; // deflate does not allow back references further than this
     static constexpr u16 empty_slot = UINT16_MAX;
 
     struct CompressionConstants {
@@ -161,6 +177,7 @@ private:
     size_t compare_match_candidate(size_t start, size_t candidate, size_t prev_match_length, size_t max_match_length);
     size_t find_back_match(size_t start, u16 hash, size_t previous_match_length, size_t max_match_length, size_t& match_position);
     void lz77_compress_block();
+    void slide_hash_chains();
 
     // Huffman Coding
     struct code_length_symbol {
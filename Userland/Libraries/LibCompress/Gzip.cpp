@@ -69,6 +69,8 @@ size_t GzipDecompressor::read(Bytes bytes)
             }
 
             if (nread < slice.size()) {
+                m_input_stream.align_to_byte_boundary();
+
                 LittleEndian<u32> crc32, input_size;
                 m_input_stream >> crc32 >> input_size;
 
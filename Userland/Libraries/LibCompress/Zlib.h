@@ -18,6 +18,11 @@ public:
     Optional<ByteBuffer> decompress();
     u32 checksum();
 
+    // The raw deflate stream between the zlib header and the adler32 footer,
+    // for callers that want to stream the payload through DeflateDecompressor
+    // themselves instead of inflating everything up front.
+    ReadonlyBytes payload() const { return m_data_bytes; }
+
     static Optional<Zlib> try_create(ReadonlyBytes data);
     static Optional<ByteBuffer> decompress_all(ReadonlyBytes);
 
@@ -72,36 +72,45 @@ void ConfigFile::reparse()
 {
     m_groups.clear();
 
+    // Map the whole file and parse it in place instead of paying a read()
+    // syscall per line. An empty or unreadable file parses as no groups.
+    auto mapped_file_or_error = m_file->map();
+    if (mapped_file_or_error.is_error())
+        return;
+    auto mapped_file = mapped_file_or_error.release_value();
+
     HashMap<String, String>* current_group = nullptr;
 
-    while (m_file->can_read_line()) {
-        auto line = m_file->read_line();
-        auto* cp = line.characters();
+    StringView contents { mapped_file->bytes() };
+    for (auto line : contents.split_view('\n')) {
+        size_t i = 0;
 
-        while (*cp && (*cp == ' ' || *cp == '\t' || *cp == '\n'))
-            ++cp;
+        while (i < line.length() && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r'))
+            ++i;
+
+        if (i >= line.length()) // EOL...
+            continue;
 
-        switch (*cp) {
-        case '\0': // EOL...
-        case '#':  // Comment, skip entire line.
-        case ';':  // -||-
+        switch (line[i]) {
+        case '#': // Comment, skip entire line.
+        case ';': // -||-
             continue;
         case '[': { // Start of new group.
             StringBuilder builder;
-            ++cp; // Skip the '['
-            while (*cp && (*cp != ']'))
-                builder.append(*(cp++));
+            ++i; // Skip the '['
+            while (i < line.length() && line[i] != ']')
+                builder.append(line[i++]);
             current_group = &m_groups.ensure(builder.to_string());
             break;
         }
         default: { // Start of key{
             StringBuilder key_builder;
             StringBuilder value_builder;
-            while (*cp && (*cp != '='))
-                key_builder.append(*(cp++));
-            ++cp; // Skip the '='
-            while (*cp && (*cp != '\n'))
-                value_builder.append(*(cp++));
+            while (i < line.length() && line[i] != '=')
+                key_builder.append(line[i++]);
+            ++i; // Skip the '='
+            while (i < line.length() && line[i] != '\r')
+                value_builder.append(line[i++]);
             if (!current_group) {
                 // We're not in a group yet, create one with the name ""...
                 current_group = &m_groups.ensure("");
@@ -11,6 +11,7 @@
 #include <AK/JsonObject.h>
 #include <AK/JsonValue.h>
 #include <AK/NeverDestroyed.h>
+#include <AK/RedBlackTree.h>
 #include <AK/Singleton.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Time.h>
@@ -32,6 +33,10 @@
 #include <time.h>
 #include <unistd.h>
 
+#ifdef __serenity__
+#    include <serenity.h>
+#endif
+
 namespace Core {
 
 class InspectorServerConnection;
@@ -58,10 +63,76 @@ static EventLoop* s_main_event_loop;
 static Vector<EventLoop&>* s_event_loop_stack;
 static NeverDestroyed<IDAllocator> s_id_allocator;
 static HashMap<int, NonnullOwnPtr<EventLoopTimer>>* s_timers;
+// Timers that are waiting to fire, ordered by their deadline in milliseconds
+// on the monotonic clock. Several timers may share a deadline, hence the
+// bucket vector. Keeping them sorted makes finding the next expiration and
+// collecting what's due proportional to the number of timers actually firing,
+// instead of a scan over every registered timer on each wakeup.
+static RedBlackTree<u64, Vector<EventLoopTimer*, 1>>* s_timer_queue;
+// Expired timers whose owner is currently not visible for timer purposes.
+// They sit outside the queue (so they don't force zero-length timeouts) and
+// get another chance on each wakeup until the owner becomes visible again.
+static Vector<EventLoopTimer*>* s_suspended_timers;
 static HashTable<Notifier*>* s_notifiers;
 int EventLoop::s_wake_pipe_fds[2];
 static RefPtr<InspectorServerConnection> s_inspector_server_connection;
 
+#ifdef __serenity__
+// A persistent kernel-side copy of the interest set, so wait_for_event()
+// doesn't have to hand the kernel every watched fd all over again on each
+// iteration. Created lazily by the first wait; -1 until then (and again
+// after fork, since the child must not share the parent's registrations).
+static int s_event_queue_fd = -1;
+
+static void update_event_queue_registration(int fd)
+{
+    if (s_event_queue_fd < 0 || fd < 0)
+        return;
+    // Multiple notifiers can watch the same fd (say, one for reading and
+    // one for writing), so recompute the combined interest mask for it.
+    uint32_t events = 0;
+    for (auto& notifier : *s_notifiers) {
+        if (notifier->fd() != fd)
+            continue;
+        if (notifier->event_mask() & Notifier::Read)
+            events |= EventQueueEvent::Read;
+        if (notifier->event_mask() & Notifier::Write)
+            events |= EventQueueEvent::Write;
+    }
+    if (!events) {
+        event_queue_ctl(s_event_queue_fd, (int)EventQueueCtlOp::Remove, fd, 0);
+        return;
+    }
+    if (event_queue_ctl(s_event_queue_fd, (int)EventQueueCtlOp::Add, fd, events) < 0 && errno == EEXIST)
+        event_queue_ctl(s_event_queue_fd, (int)EventQueueCtlOp::Modify, fd, events);
+}
+#endif
+
+static void enqueue_timer(EventLoopTimer& timer)
+{
+    u64 deadline = static_cast<u64>(timer.fire_time.to_milliseconds());
+    if (auto* bucket = s_timer_queue->find(deadline)) {
+        bucket->append(&timer);
+        return;
+    }
+    Vector<EventLoopTimer*, 1> bucket;
+    bucket.append(&timer);
+    s_timer_queue->insert(deadline, move(bucket));
+}
+
+static void dequeue_timer(EventLoopTimer& timer)
+{
+    u64 deadline = static_cast<u64>(timer.fire_time.to_milliseconds());
+    if (auto* bucket = s_timer_queue->find(deadline)) {
+        if (bucket->remove_first_matching([&](auto* entry) { return entry == &timer; })) {
+            if (bucket->is_empty())
+                s_timer_queue->remove(deadline);
+            return;
+        }
+    }
+    s_suspended_timers->remove_first_matching([&](auto* entry) { return entry == &timer; });
+}
+
 bool EventLoop::has_been_instantiated()
 {
     return s_main_event_loop;
@@ -261,6 +332,8 @@ EventLoop::EventLoop([[maybe_unused]] MakeInspectable make_inspectable)
     if (!s_event_loop_stack) {
         s_event_loop_stack = new Vector<EventLoop&>;
         s_timers = new HashMap<int, NonnullOwnPtr<EventLoopTimer>>;
+        s_timer_queue = new RedBlackTree<u64, Vector<EventLoopTimer*, 1>>;
+        s_suspended_timers = new Vector<EventLoopTimer*>;
         s_notifiers = new HashTable<Notifier*>;
     }
 
@@ -556,6 +629,8 @@ void EventLoop::notify_forked(ForkEvent event)
         s_main_event_loop = nullptr;
         s_event_loop_stack->clear();
         s_timers->clear();
+        s_timer_queue->clear();
+        s_suspended_timers->clear();
         s_notifiers->clear();
         if (auto* info = signals_info<false>()) {
             info->signal_handlers.clear();
@@ -564,6 +639,12 @@ void EventLoop::notify_forked(ForkEvent event)
         s_pid = 0;
 #ifdef __serenity__
         s_inspector_server_connection = nullptr;
+        if (s_event_queue_fd >= 0) {
+            // The forked child shares the parent's queue until we close it;
+            // the next wait_for_event() creates a fresh one.
+            close(s_event_queue_fd);
+            s_event_queue_fd = -1;
+        }
 #endif
         return;
     }
@@ -579,6 +660,19 @@ retry:
     FD_ZERO(&rfds);
     FD_ZERO(&wfds);
 
+#ifdef __serenity__
+    // The kernel keeps our interest set between iterations (see
+    // event_queue_create()); all we do here is make sure the queue exists
+    // and knows about the wake pipe.
+    if (s_event_queue_fd < 0) {
+        s_event_queue_fd = event_queue_create(static_cast<unsigned>(EventQueueFlags::CloseOnExec));
+        VERIFY(s_event_queue_fd >= 0);
+        int rc = event_queue_ctl(s_event_queue_fd, (int)EventQueueCtlOp::Add, s_wake_pipe_fds[0], EventQueueEvent::Read);
+        VERIFY(rc == 0);
+        for (auto& notifier : *s_notifiers)
+            update_event_queue_registration(notifier->fd());
+    }
+#else
     int max_fd = 0;
     auto add_fd_to_set = [&max_fd](int fd, fd_set& set) {
         FD_SET(fd, &set);
@@ -597,6 +691,7 @@ retry:
         if (notifier->event_mask() & Notifier::Exceptional)
             VERIFY_NOT_REACHED();
     }
+#endif
 
     bool queued_events_is_empty;
     {
@@ -621,7 +716,24 @@ retry:
     }
 
 try_select_again:
+#ifdef __serenity__
+    // Collect whatever is ready as a compact list, and scatter it into the
+    // fd sets the rest of this function works with. Readiness is
+    // level-triggered, so anything that doesn't fit in the buffer is
+    // simply reported again on the next iteration.
+    EventQueueEvent events[64];
+    struct timespec timeout_ts = { timeout.tv_sec, timeout.tv_usec * 1000 };
+    int marked_fd_count = event_queue_wait(s_event_queue_fd, events, array_size(events), should_wait_forever ? nullptr : &timeout_ts);
+    for (int i = 0; i < marked_fd_count; ++i) {
+        VERIFY(events[i].fd < FD_SETSIZE);
+        if (events[i].events & (EventQueueEvent::Read | EventQueueEvent::Error | EventQueueEvent::HangUp))
+            FD_SET(events[i].fd, &rfds);
+        if (events[i].events & EventQueueEvent::Write)
+            FD_SET(events[i].fd, &wfds);
+    }
+#else
     int marked_fd_count = select(max_fd + 1, &rfds, &wfds, nullptr, should_wait_forever ? nullptr : &timeout);
+#endif
     if (marked_fd_count < 0) {
         int saved_errno = errno;
         if (saved_errno == EINTR) {
@@ -653,29 +765,54 @@ try_select_again:
             goto retry;
     }
 
-    if (!s_timers->is_empty()) {
+    if (!s_timer_queue->is_empty() || !s_suspended_timers->is_empty()) {
         now = Time::now_monotonic_coarse();
-    }
 
-    for (auto& it : *s_timers) {
-        auto& timer = *it.value;
-        if (!timer.has_expired(now))
-            continue;
-        auto owner = timer.owner.strong_ref();
-        if (timer.fire_when_not_visible == TimerShouldFireWhenNotVisible::No
-            && owner && !owner->is_visible_for_timer_purposes()) {
-            continue;
-        }
+        auto fire_timer = [&](EventLoopTimer& timer, RefPtr<Object> owner) {
+            dbgln_if(EVENTLOOP_DEBUG, "Core::EventLoop: Timer {} has expired, sending Core::TimerEvent to {}", timer.timer_id, *owner);
+
+            if (owner)
+                post_event(*owner, make<TimerEvent>(timer.timer_id));
+            if (timer.should_reload) {
+                timer.reload(now);
+                enqueue_timer(timer);
+            } else {
+                // FIXME: Support removing expired timers that don't want to reload.
+                VERIFY_NOT_REACHED();
+            }
+        };
 
-        dbgln_if(EVENTLOOP_DEBUG, "Core::EventLoop: Timer {} has expired, sending Core::TimerEvent to {}", timer.timer_id, *owner);
+        // Give suspended timers whose owner became visible again a chance to fire.
+        s_suspended_timers->remove_all_matching([&](EventLoopTimer* timer) {
+            auto owner = timer->owner.strong_ref();
+            if (owner && !owner->is_visible_for_timer_purposes())
+                return false;
+            fire_timer(*timer, move(owner));
+            return true;
+        });
+
+        // Collect the due timers first: a zero-interval timer reloads to a
+        // deadline that is due again right away, and must not starve the loop
+        // by being popped over and over in the same pass.
+        u64 now_ms = static_cast<u64>(now.to_milliseconds());
+        Vector<EventLoopTimer*, 16> expired_timers;
+        while (!s_timer_queue->is_empty()) {
+            auto it = s_timer_queue->begin();
+            if (it.key() > now_ms)
+                break;
+            auto bucket = s_timer_queue->unsafe_remove(it.key());
+            for (auto* timer : bucket)
+                expired_timers.append(timer);
+        }
 
-        if (owner)
-            post_event(*owner, make<TimerEvent>(timer.timer_id));
-        if (timer.should_reload) {
-            timer.reload(now);
-        } else {
-            // FIXME: Support removing expired timers that don't want to reload.
-            VERIFY_NOT_REACHED();
+        for (auto* timer : expired_timers) {
+            auto owner = timer->owner.strong_ref();
+            if (timer->fire_when_not_visible == TimerShouldFireWhenNotVisible::No
+                && owner && !owner->is_visible_for_timer_purposes()) {
+                s_suspended_timers->append(timer);
+                continue;
+            }
+            fire_timer(*timer, move(owner));
         }
     }
 
@@ -706,18 +843,12 @@ void EventLoopTimer::reload(const Time& now)
 
 Optional<Time> EventLoop::get_next_timer_expiration()
 {
-    Optional<Time> soonest {};
-    for (auto& it : *s_timers) {
-        auto& fire_time = it.value->fire_time;
-        auto owner = it.value->owner.strong_ref();
-        if (it.value->fire_when_not_visible == TimerShouldFireWhenNotVisible::No
-            && owner && !owner->is_visible_for_timer_purposes()) {
-            continue;
-        }
-        if (!soonest.has_value() || fire_time < soonest.value())
-            soonest = fire_time;
-    }
-    return soonest;
+    // Note: Expired timers with an invisible owner live on the suspended list
+    // and deliberately don't contribute a deadline here; they're re-examined
+    // whenever something else wakes the loop up.
+    if (s_timer_queue->is_empty())
+        return {};
+    return Time::from_milliseconds(static_cast<i64>(s_timer_queue->begin().key()));
 }
 
 int EventLoop::register_timer(Object& object, int milliseconds, bool should_reload, TimerShouldFireWhenNotVisible fire_when_not_visible)
@@ -731,6 +862,7 @@ int EventLoop::register_timer(Object& object, int milliseconds, bool should_relo
     timer->fire_when_not_visible = fire_when_not_visible;
     int timer_id = s_id_allocator->allocate();
     timer->timer_id = timer_id;
+    enqueue_timer(*timer);
     s_timers->set(timer_id, move(timer));
     return timer_id;
 }
@@ -741,6 +873,7 @@ bool EventLoop::unregister_timer(int timer_id)
     auto it = s_timers->find(timer_id);
     if (it == s_timers->end())
         return false;
+    dequeue_timer(*it->value);
     s_timers->remove(it);
     return true;
 }
@@ -748,11 +881,17 @@ bool EventLoop::unregister_timer(int timer_id)
 void EventLoop::register_notifier(Badge<Notifier>, Notifier& notifier)
 {
     s_notifiers->set(&notifier);
+#ifdef __serenity__
+    update_event_queue_registration(notifier.fd());
+#endif
 }
 
 void EventLoop::unregister_notifier(Badge<Notifier>, Notifier& notifier)
 {
     s_notifiers->remove(&notifier);
+#ifdef __serenity__
+    update_event_queue_registration(notifier.fd());
+#endif
 }
 
 void EventLoop::wake()
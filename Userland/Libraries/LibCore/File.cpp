@@ -8,6 +8,7 @@
 #    include <serenity.h>
 #endif
 #include <AK/LexicalPath.h>
+#include <AK/MappedFile.h>
 #include <AK/ScopeGuard.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/File.h>
@@ -35,6 +36,14 @@ Result<NonnullRefPtr<File>, OSError> File::open(String filename, OpenMode mode,
     return file;
 }
 
+Result<NonnullRefPtr<MappedFile>, OSError> File::map() const
+{
+    int duped_fd = dup(fd());
+    if (duped_fd < 0)
+        return OSError(errno);
+    return MappedFile::map_from_fd_and_close(duped_fd, m_filename);
+}
+
 File::File(String filename, Object* parent)
     : IODevice(parent)
     , m_filename(move(filename))
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/MappedFile.h>
 #include <AK/OSError.h>
 #include <AK/Result.h>
 #include <AK/String.h>
@@ -21,6 +22,10 @@ public:
 
     static Result<NonnullRefPtr<File>, OSError> open(String filename, OpenMode, mode_t = 0644);
 
+    // Maps the open file read-only; the returned MappedFile keeps the
+    // mapping alive independently of this File.
+    Result<NonnullRefPtr<MappedFile>, OSError> map() const;
+
     String filename() const { return m_filename; }
     void set_filename(const String filename) { m_filename = move(filename); }
 
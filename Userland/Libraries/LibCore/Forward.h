@@ -30,6 +30,8 @@ class Notifier;
 class Object;
 class ObjectClassRegistration;
 class ProcessStatisticsReader;
+template<typename Result>
+class Promise;
 class Socket;
 class SocketAddress;
 class TCPServer;
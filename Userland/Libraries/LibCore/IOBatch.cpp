@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/IOBatch.h>
+#include <errno.h>
+#include <unistd.h>
+
+namespace Core {
+
+bool IOBatch::enqueue(int fd, u16 opcode, void* buffer, size_t size)
+{
+    if (m_ops.size() >= max_operations)
+        return false;
+    m_ops.append({ fd, opcode, 0, buffer, size, 0 });
+    return true;
+}
+
+bool IOBatch::enqueue_read(int fd, void* buffer, size_t size)
+{
+    return enqueue(fd, IOBATCH_OP_READ, buffer, size);
+}
+
+bool IOBatch::enqueue_write(int fd, void const* buffer, size_t size)
+{
+    return enqueue(fd, IOBATCH_OP_WRITE, const_cast<void*>(buffer), size);
+}
+
+int IOBatch::submit()
+{
+    if (m_ops.is_empty())
+        return 0;
+#ifdef __serenity__
+    return iobatch(m_ops.data(), m_ops.size());
+#else
+    // No batching syscall to submit to; perform the operations sequentially
+    // so callers behave the same on both kinds of host.
+    for (auto& op : m_ops) {
+        ssize_t rc = op.opcode == IOBATCH_OP_WRITE
+            ? write(op.fd, op.buffer, op.size)
+            : read(op.fd, op.buffer, op.size);
+        op.result = rc < 0 ? -errno : rc;
+    }
+    return static_cast<int>(m_ops.size());
+#endif
+}
+
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Vector.h>
+
+#ifdef __serenity__
+#    include <serenity.h>
+#else
+#    include <sys/types.h>
+
+// Non-Serenity systems have no sys$iobatch, so mirror the kernel's API here
+// and let submit() fall back to performing the operations one at a time.
+enum IOBatchOpcode {
+    IOBATCH_OP_READ = 0,
+    IOBATCH_OP_WRITE = 1,
+};
+
+struct iobatch_op {
+    int fd;
+    uint16_t opcode;
+    uint16_t padding;
+    void* buffer;
+    size_t size;
+    ssize_t result;
+};
+#endif
+
+namespace Core {
+
+// Collects read/write operations and submits them all with a single
+// sys$iobatch kernel entry. Operations that would block complete with
+// -EAGAIN and can be re-enqueued once the event loop reports readiness.
+class IOBatch {
+public:
+    static constexpr size_t max_operations = 128;
+
+    bool enqueue_read(int fd, void* buffer, size_t size);
+    bool enqueue_write(int fd, void const* buffer, size_t size);
+
+    size_t size() const { return m_ops.size(); }
+    bool is_empty() const { return m_ops.is_empty(); }
+    void clear() { m_ops.clear(); }
+
+    // Returns the number of operations processed, or -1 with errno set.
+    // Per-operation outcomes are available via result() afterwards.
+    int submit();
+
+    // Bytes transferred for the given operation, or a negative errno code.
+    ssize_t result(size_t index) const { return m_ops[index].result; }
+
+private:
+    bool enqueue(int fd, u16 opcode, void* buffer, size_t size);
+
+    Vector<iobatch_op> m_ops;
+};
+
+}
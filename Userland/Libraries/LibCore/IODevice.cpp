@@ -6,6 +6,8 @@
 
 #include <AK/ByteBuffer.h>
 #include <LibCore/IODevice.h>
+#include <LibCore/Notifier.h>
+#include <LibCore/Promise.h>
 #include <errno.h>
 #include <stdio.h>
 #include <string.h>
@@ -299,6 +301,65 @@ bool IODevice::write(const u8* data, int size)
     return rc == size;
 }
 
+NonnullRefPtr<Promise<ByteBuffer>> IODevice::async_read_exactly(size_t size)
+{
+    auto promise = Promise<ByteBuffer>::construct();
+    auto maybe_buffer = ByteBuffer::create_uninitialized(size);
+    if (size == 0 || !maybe_buffer.has_value()) {
+        promise->resolve({});
+        return promise;
+    }
+    auto notifier = Notifier::construct(fd(), Notifier::Event::Read, this);
+    promise->on_canceled = [notifier = notifier.ptr()] {
+        notifier->remove_from_parent();
+    };
+    notifier->on_ready_to_read = [this, promise, notifier = notifier.ptr(), buffer = maybe_buffer.release_value(), bytes_read = (size_t)0]() mutable {
+        int nread = read(buffer.data() + bytes_read, (int)(buffer.size() - bytes_read));
+        if (nread > 0)
+            bytes_read += (size_t)nread;
+        if (nread > 0 && bytes_read < buffer.size())
+            return;
+        // Done, or EOF / error: deliver what we have. Grab the captures we
+        // still need before tearing down the notifier that owns us.
+        if (bytes_read < buffer.size())
+            buffer.resize(bytes_read);
+        auto result = move(buffer);
+        auto strong_promise = promise;
+        notifier->remove_from_parent();
+        strong_promise->resolve(move(result));
+    };
+    return promise;
+}
+
+NonnullRefPtr<Promise<bool>> IODevice::async_write_all(ByteBuffer data)
+{
+    auto promise = Promise<bool>::construct();
+    if (data.is_empty()) {
+        promise->resolve(true);
+        return promise;
+    }
+    auto notifier = Notifier::construct(fd(), Notifier::Event::Write, this);
+    promise->on_canceled = [notifier = notifier.ptr()] {
+        notifier->remove_from_parent();
+    };
+    notifier->on_ready_to_write = [this, promise, notifier = notifier.ptr(), data = move(data), bytes_written = (size_t)0]() mutable {
+        ssize_t nwritten = ::write(fd(), data.data() + bytes_written, data.size() - bytes_written);
+        if (nwritten < 0 && (errno == EAGAIN || errno == EINTR))
+            return;
+        if (nwritten > 0)
+            bytes_written += (size_t)nwritten;
+        if (nwritten >= 0 && bytes_written < data.size())
+            return;
+        if (nwritten < 0)
+            set_error(errno);
+        bool success = bytes_written == data.size();
+        auto strong_promise = promise;
+        notifier->remove_from_parent();
+        strong_promise->resolve(move(success));
+    };
+    return promise;
+}
+
 void IODevice::set_fd(int fd)
 {
     if (m_fd == fd)
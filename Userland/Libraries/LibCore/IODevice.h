@@ -79,6 +79,12 @@ public:
 
     bool truncate(off_t);
 
+    // Asynchronous I/O. Each call returns a promise that resolves on the
+    // event loop; cancel() the promise to abandon the operation. A read
+    // that hits EOF or an error resolves with the bytes gathered so far.
+    NonnullRefPtr<Promise<ByteBuffer>> async_read_exactly(size_t);
+    NonnullRefPtr<Promise<bool>> async_write_all(ByteBuffer);
+
     bool can_read_line() const;
 
     bool can_read() const;
@@ -93,8 +93,13 @@ void LocalSocket::parse_sockets_from_system_server()
     }
 
     for (auto& socket : StringView(sockets).split_view(' ')) {
-        auto params = socket.split_view(':');
-        s_overtaken_sockets.set(params[0].to_string(), strtol(params[1].to_string().characters(), nullptr, 10));
+        // The fd is after the last colon; socket names themselves may
+        // contain colons (e.g. the "tcp:23" pseudo-path).
+        auto last_colon = socket.find_last(':');
+        VERIFY(last_colon.has_value());
+        auto socket_name = socket.substring_view(0, *last_colon).to_string();
+        auto fd = strtol(socket.substring_view(*last_colon + 1).to_string().characters(), nullptr, 10);
+        s_overtaken_sockets.set(move(socket_name), fd);
     }
 
     s_overtaken_sockets_parsed = true;
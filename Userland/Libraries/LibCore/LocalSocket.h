@@ -25,6 +25,7 @@ private:
     // FIXME: better place to put this so both LocalSocket and LocalServer can
     // enjoy it?
     friend class LocalServer;
+    friend class TCPServer;
 
     static void parse_sockets_from_system_server();
 
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/PerformanceCounters.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <new>
+#include <pthread.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Core {
+
+AK::Atomic<u64> PerfCounter::s_dummy_value;
+AK::Atomic<u64> DurationHistogram::s_dummy_value;
+AK::Atomic<u64> DurationHistogram::s_dummy_buckets[DurationHistogram::bucket_count];
+
+static pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
+static PerformanceCounters::SharedData* s_shared_data;
+static bool s_tried_to_map;
+
+String PerformanceCounters::path_for_pid(pid_t pid)
+{
+    return String::formatted("/tmp/perfcounters/{}", pid);
+}
+
+static PerformanceCounters::SharedData* ensure_shared_data()
+{
+    // Called with s_mutex held.
+    if (s_shared_data || s_tried_to_map)
+        return s_shared_data;
+    s_tried_to_map = true;
+
+    if (mkdir("/tmp/perfcounters", 0755) < 0 && errno != EEXIST)
+        return nullptr;
+
+    auto path = PerformanceCounters::path_for_pid(getpid());
+    int fd = open(path.characters(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+        return nullptr;
+    if (ftruncate(fd, sizeof(PerformanceCounters::SharedData)) < 0) {
+        close(fd);
+        return nullptr;
+    }
+    auto* ptr = mmap(nullptr, sizeof(PerformanceCounters::SharedData), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED)
+        return nullptr;
+
+    // Construct (and thereby zero) the struct in place; a memset over the
+    // Atomic members would be a -Wclass-memaccess error.
+    auto* data = new (ptr) PerformanceCounters::SharedData {};
+    data->version = PerformanceCounters::shared_data_version;
+    // Write the magic last so a reader that races with us rejects the page.
+    data->magic = PerformanceCounters::shared_data_magic;
+    s_shared_data = data;
+    return s_shared_data;
+}
+
+static void copy_name(char* destination, StringView name, size_t capacity)
+{
+    size_t length = min(name.length(), capacity - 1);
+    memcpy(destination, name.characters_without_null_termination(), length);
+    destination[length] = '\0';
+}
+
+PerfCounter PerformanceCounters::register_counter(StringView name)
+{
+    pthread_mutex_lock(&s_mutex);
+    auto* data = ensure_shared_data();
+    if (!data) {
+        pthread_mutex_unlock(&s_mutex);
+        return {};
+    }
+
+    u32 count = data->counter_count.load(AK::memory_order_relaxed);
+    for (u32 i = 0; i < count; ++i) {
+        if (name == StringView { data->counters[i].name }) {
+            pthread_mutex_unlock(&s_mutex);
+            return PerfCounter { &data->counters[i].value };
+        }
+    }
+    if (count == max_counters) {
+        pthread_mutex_unlock(&s_mutex);
+        return {};
+    }
+
+    auto& slot = data->counters[count];
+    copy_name(slot.name, name, name_length);
+    // Publish the new count after the name is in place.
+    data->counter_count.store(count + 1, AK::memory_order_release);
+    pthread_mutex_unlock(&s_mutex);
+    return PerfCounter { &slot.value };
+}
+
+DurationHistogram PerformanceCounters::register_histogram(StringView name)
+{
+    pthread_mutex_lock(&s_mutex);
+    auto* data = ensure_shared_data();
+    if (!data) {
+        pthread_mutex_unlock(&s_mutex);
+        return {};
+    }
+
+    u32 count = data->histogram_count.load(AK::memory_order_relaxed);
+    for (u32 i = 0; i < count; ++i) {
+        if (name == StringView { data->histograms[i].name }) {
+            auto& slot = data->histograms[i];
+            pthread_mutex_unlock(&s_mutex);
+            return DurationHistogram { slot.buckets, &slot.count, &slot.total_us };
+        }
+    }
+    if (count == max_histograms) {
+        pthread_mutex_unlock(&s_mutex);
+        return {};
+    }
+
+    auto& slot = data->histograms[count];
+    copy_name(slot.name, name, name_length);
+    data->histogram_count.store(count + 1, AK::memory_order_release);
+    pthread_mutex_unlock(&s_mutex);
+    return DurationHistogram { slot.buckets, &slot.count, &slot.total_us };
+}
+
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/String.h>
+#include <AK/StringView.h>
+#include <AK/Types.h>
+#include <time.h>
+
+namespace Core {
+
+// Lightweight always-on instrumentation: named monotonic counters and
+// duration histograms that live in a shared file-backed page under
+// /tmp/perfcounters/<pid>, so tools can read them from outside the
+// process without attaching the profiler. Incrementing a counter is a
+// single relaxed atomic add.
+
+class PerfCounter {
+public:
+    PerfCounter() = default;
+
+    void add(u64 delta = 1)
+    {
+        m_value->fetch_add(delta, AK::memory_order_relaxed);
+    }
+    u64 value() const { return m_value->load(AK::memory_order_relaxed); }
+
+private:
+    friend class PerformanceCounters;
+    explicit PerfCounter(AK::Atomic<u64>* value)
+        : m_value(value)
+    {
+    }
+
+    // Registration never fails; a counter that could not be published
+    // points at a process-local dummy slot instead.
+    AK::Atomic<u64>* m_value { &s_dummy_value };
+    static AK::Atomic<u64> s_dummy_value;
+};
+
+class DurationHistogram {
+public:
+    static constexpr size_t bucket_count = 32;
+
+    DurationHistogram() = default;
+
+    // Bucket i counts durations in [2^i, 2^(i+1)) microseconds.
+    void record_us(u64 microseconds)
+    {
+        size_t bucket = 0;
+        while (bucket < bucket_count - 1 && (1ull << (bucket + 1)) <= microseconds)
+            ++bucket;
+        m_buckets[bucket].fetch_add(1, AK::memory_order_relaxed);
+        m_count->fetch_add(1, AK::memory_order_relaxed);
+        m_total_us->fetch_add(microseconds, AK::memory_order_relaxed);
+    }
+
+private:
+    friend class PerformanceCounters;
+    DurationHistogram(AK::Atomic<u64>* buckets, AK::Atomic<u64>* count, AK::Atomic<u64>* total_us)
+        : m_buckets(buckets)
+        , m_count(count)
+        , m_total_us(total_us)
+    {
+    }
+
+    AK::Atomic<u64>* m_buckets { s_dummy_buckets };
+    AK::Atomic<u64>* m_count { &s_dummy_value };
+    AK::Atomic<u64>* m_total_us { &s_dummy_value };
+    static AK::Atomic<u64> s_dummy_value;
+    static AK::Atomic<u64> s_dummy_buckets[bucket_count];
+};
+
+// Measures wall-clock time from construction to destruction and records
+// it into a histogram.
+class ScopedDurationTimer {
+public:
+    explicit ScopedDurationTimer(DurationHistogram& histogram)
+        : m_histogram(histogram)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &m_start);
+    }
+    ~ScopedDurationTimer()
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        u64 microseconds = (u64)(now.tv_sec - m_start.tv_sec) * 1'000'000 + (u64)(now.tv_nsec - m_start.tv_nsec) / 1000;
+        m_histogram.record_us(microseconds);
+    }
+
+private:
+    DurationHistogram& m_histogram;
+    struct timespec m_start;
+};
+
+class PerformanceCounters {
+public:
+    static constexpr u32 shared_data_magic = 0x504e4354; // "PCNT"
+    static constexpr u32 shared_data_version = 1;
+    static constexpr size_t max_counters = 64;
+    static constexpr size_t max_histograms = 16;
+    static constexpr size_t name_length = 56;
+
+    // One cache line per counter so concurrent increments don't false-share.
+    struct CounterSlot {
+        char name[name_length];
+        AK::Atomic<u64> value;
+    };
+    static_assert(sizeof(CounterSlot) == 64);
+
+    struct HistogramSlot {
+        char name[name_length];
+        AK::Atomic<u64> count;
+        AK::Atomic<u64> total_us;
+        AK::Atomic<u64> buckets[DurationHistogram::bucket_count];
+    };
+
+    struct SharedData {
+        u32 magic;
+        u32 version;
+        AK::Atomic<u32> counter_count;
+        AK::Atomic<u32> histogram_count;
+        char padding[48];
+        CounterSlot counters[max_counters];
+        HistogramSlot histograms[max_histograms];
+    };
+
+    // Returns a handle for the named counter/histogram, publishing it in
+    // the shared page on first use. Re-registering a name returns a
+    // handle to the same slot.
+    static PerfCounter register_counter(StringView name);
+    static DurationHistogram register_histogram(StringView name);
+
+    static String path_for_pid(pid_t);
+};
+
+}
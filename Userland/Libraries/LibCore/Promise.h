@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Vector.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Object.h>
 
@@ -16,17 +17,35 @@ class Promise : public Object {
 
 private:
     Optional<Result> m_pending;
+    bool m_canceled { false };
 
 public:
     Function<void(Result&)> on_resolved;
+    Function<void()> on_canceled;
 
     void resolve(Result&& result)
     {
+        if (m_canceled)
+            return;
         m_pending = move(result);
         if (on_resolved)
             on_resolved(m_pending.value());
     }
 
+    // Detaches any continuation and makes later resolve() calls a no-op.
+    // Asynchronous operations install on_canceled to tear themselves down.
+    void cancel()
+    {
+        if (m_canceled || is_resolved())
+            return;
+        m_canceled = true;
+        on_resolved = nullptr;
+        if (on_canceled)
+            on_canceled();
+    }
+
+    bool is_canceled() const { return m_canceled; }
+
     bool is_resolved()
     {
         return m_pending.has_value();
@@ -35,6 +54,7 @@ public:
     Result await()
     {
         while (!is_resolved()) {
+            VERIFY(!m_canceled);
             Core::EventLoop::current().pump();
         }
         return m_pending.release_value();
@@ -51,5 +71,79 @@ public:
         };
         return new_promise;
     }
+
+    // Chains a continuation; unlike map(), the continuation may capture
+    // state, and a promise that has already resolved fires it immediately.
+    template<typename T>
+    NonnullRefPtr<Promise<T>> then(Function<T(Result&)> func)
+    {
+        auto new_promise = Promise<T>::construct();
+        if (is_resolved()) {
+            new_promise->resolve(func(m_pending.value()));
+            return new_promise;
+        }
+        on_resolved = [new_promise, func = move(func)](Result& result) mutable {
+            new_promise->resolve(func(result));
+        };
+        return new_promise;
+    }
+
+    // Resolves once every input promise has resolved, with the results in
+    // input order.
+    static NonnullRefPtr<Promise<Vector<Result>>> all(Vector<NonnullRefPtr<Promise>> promises)
+    {
+        auto combined = Promise<Vector<Result>>::construct();
+        if (promises.is_empty()) {
+            combined->resolve({});
+            return combined;
+        }
+
+        struct State : public RefCounted<State> {
+            Vector<Optional<Result>> results;
+            size_t remaining { 0 };
+        };
+        auto state = adopt_ref(*new State);
+        state->results.resize(promises.size());
+        state->remaining = promises.size();
+
+        auto got_result = [combined, state](size_t index, Result result) mutable {
+            state->results[index] = move(result);
+            if (--state->remaining > 0)
+                return;
+            Vector<Result> results;
+            results.ensure_capacity(state->results.size());
+            for (auto& entry : state->results)
+                results.unchecked_append(entry.release_value());
+            combined->resolve(move(results));
+        };
+
+        for (size_t i = 0; i < promises.size(); ++i) {
+            if (promises[i]->is_resolved()) {
+                got_result(i, promises[i]->m_pending.value());
+                continue;
+            }
+            promises[i]->on_resolved = [got_result, i](Result& result) mutable {
+                got_result(i, move(result));
+            };
+        }
+        return combined;
+    }
+
+    // Resolves with the result of whichever input promise resolves first.
+    static NonnullRefPtr<Promise> any(Vector<NonnullRefPtr<Promise>> promises)
+    {
+        auto first = Promise::construct();
+        for (auto& promise : promises) {
+            if (promise->is_resolved()) {
+                first->resolve(Result(promise->m_pending.value()));
+                break;
+            }
+            promise->on_resolved = [first](Result& result) mutable {
+                if (!first->is_resolved())
+                    first->resolve(move(result));
+            };
+        }
+        return first;
+    }
 };
 }
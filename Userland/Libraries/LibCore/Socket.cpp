@@ -8,6 +8,7 @@
 #include <AK/ByteReader.h>
 #include <AK/Debug.h>
 #include <LibCore/Notifier.h>
+#include <LibCore/Promise.h>
 #include <LibCore/Socket.h>
 #include <arpa/inet.h>
 #include <errno.h>
@@ -165,6 +166,41 @@ bool Socket::common_connect(const struct sockaddr* addr, socklen_t addrlen)
     return true;
 }
 
+NonnullRefPtr<Promise<bool>> Socket::setup_async_connect(Function<bool()> do_connect)
+{
+    auto promise = Promise<bool>::construct();
+    on_connected = [promise]() mutable {
+        promise->resolve(true);
+    };
+    on_error = [promise]() mutable {
+        promise->resolve(false);
+    };
+    if (!do_connect() && !promise->is_resolved())
+        promise->resolve(false);
+    return promise;
+}
+
+NonnullRefPtr<Promise<bool>> Socket::async_connect(const String& hostname, int port)
+{
+    return setup_async_connect([this, hostname, port] {
+        return connect(hostname, port);
+    });
+}
+
+NonnullRefPtr<Promise<bool>> Socket::async_connect(const SocketAddress& address, int port)
+{
+    return setup_async_connect([this, address, port] {
+        return connect(address, port);
+    });
+}
+
+NonnullRefPtr<Promise<bool>> Socket::async_connect(const SocketAddress& address)
+{
+    return setup_async_connect([this, address] {
+        return connect(address);
+    });
+}
+
 ByteBuffer Socket::receive(int max_size)
 {
     auto buffer = read(max_size);
@@ -30,6 +30,12 @@ public:
     bool connect(const SocketAddress&, int port);
     bool connect(const SocketAddress&);
 
+    // Asynchronous variants of connect(). These take over the on_connected
+    // and on_error hooks to resolve the returned promise with the outcome.
+    NonnullRefPtr<Promise<bool>> async_connect(const String& hostname, int port);
+    NonnullRefPtr<Promise<bool>> async_connect(const SocketAddress&, int port);
+    NonnullRefPtr<Promise<bool>> async_connect(const SocketAddress&);
+
     ByteBuffer receive(int max_size);
     bool send(ReadonlyBytes);
 
@@ -61,6 +67,7 @@ protected:
 private:
     virtual bool open(OpenMode) override { VERIFY_NOT_REACHED(); }
     void ensure_read_notifier();
+    NonnullRefPtr<Promise<bool>> setup_async_connect(Function<bool()> do_connect);
 
     Type m_type { Type::Invalid };
     RefPtr<Notifier> m_notifier;
@@ -6,12 +6,14 @@
 
 #include <AK/IPv4Address.h>
 #include <AK/Types.h>
+#include <LibCore/LocalSocket.h>
 #include <LibCore/Notifier.h>
 #include <LibCore/TCPServer.h>
 #include <LibCore/TCPSocket.h>
 #include <fcntl.h>
 #include <stdio.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 #ifndef SOCK_NONBLOCK
@@ -56,12 +58,65 @@ bool TCPServer::listen(const IPv4Address& address, u16 port)
     }
     m_listening = true;
 
+    setup_notifier();
+    return true;
+}
+
+bool TCPServer::take_over_from_system_server(String const& socket_path)
+{
+    if (m_listening)
+        return false;
+
+    if (!LocalSocket::s_overtaken_sockets_parsed)
+        LocalSocket::parse_sockets_from_system_server();
+
+    int fd = -1;
+    if (socket_path.is_null()) {
+        // We want the first (and only) socket.
+        if (LocalSocket::s_overtaken_sockets.size() == 1)
+            fd = LocalSocket::s_overtaken_sockets.begin()->value;
+    } else {
+        auto it = LocalSocket::s_overtaken_sockets.find(socket_path);
+        if (it != LocalSocket::s_overtaken_sockets.end())
+            fd = it->value;
+    }
+
+    if (fd >= 0) {
+        // Sanity check: it has to be a socket.
+        struct stat stat;
+        int rc = fstat(fd, &stat);
+        if (rc == 0 && S_ISSOCK(stat.st_mode)) {
+            // The SystemServer has passed us an already-listening socket, so
+            // use that instead of the one the constructor made.
+            ::close(m_fd);
+            m_fd = fd;
+            // It had to be !CLOEXEC for obvious reasons, but we
+            // don't need it to be !CLOEXEC anymore, so set the
+            // CLOEXEC flag now.
+            fcntl(m_fd, F_SETFD, FD_CLOEXEC);
+
+            m_listening = true;
+            setup_notifier();
+            return true;
+        } else {
+            if (rc != 0)
+                perror("fstat");
+            dbgln("It's not a socket, what the heck??");
+        }
+    }
+
+    dbgln("Failed to take the socket over from SystemServer");
+
+    return false;
+}
+
+void TCPServer::setup_notifier()
+{
     m_notifier = Notifier::construct(m_fd, Notifier::Event::Read, this);
     m_notifier->on_ready_to_read = [this] {
         if (on_ready_to_accept)
             on_ready_to_accept();
     };
-    return true;
 }
 
 void TCPServer::set_blocking(bool blocking)
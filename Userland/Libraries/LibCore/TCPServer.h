@@ -19,6 +19,7 @@ public:
 
     bool is_listening() const { return m_listening; }
     bool listen(const IPv4Address& address, u16 port);
+    bool take_over_from_system_server(String const& socket_path = String());
     void set_blocking(bool blocking);
 
     RefPtr<TCPSocket> accept();
@@ -31,6 +32,8 @@ public:
 private:
     explicit TCPServer(Object* parent = nullptr);
 
+    void setup_notifier();
+
     int m_fd { -1 };
     bool m_listening { false };
     RefPtr<Notifier> m_notifier;
@@ -37,6 +37,125 @@ NonnullRefPtr<TranslationUnit> Parser::parse()
     return unit;
 }
 
+static bool tokens_are_identical(Token const& a, Token const& b)
+{
+    return a.type() == b.type() && a.start() == b.start() && a.end() == b.end() && a.text() == b.text();
+}
+
+NonnullRefPtr<TranslationUnit> Parser::parse_incremental(Parser& previous)
+{
+    LOG_SCOPE();
+
+    auto previous_root = previous.root_node();
+    if (!previous_root || m_tokens.is_empty() || previous.m_tokens.is_empty())
+        return parse();
+
+    // Find the longest common token prefix and suffix around the edit.
+    // Tokens only compare equal when their positions are unchanged too, so
+    // an edit that shifts every following line simply ends up with an empty
+    // reusable suffix and we reparse everything after the edit.
+    size_t common_prefix = 0;
+    while (common_prefix < m_tokens.size() && common_prefix < previous.m_tokens.size()
+        && tokens_are_identical(m_tokens[common_prefix], previous.m_tokens[common_prefix]))
+        ++common_prefix;
+
+    size_t common_suffix = 0;
+    while (common_suffix < m_tokens.size() - common_prefix
+        && common_suffix < previous.m_tokens.size() - common_prefix
+        && tokens_are_identical(m_tokens[m_tokens.size() - 1 - common_suffix], previous.m_tokens[previous.m_tokens.size() - 1 - common_suffix]))
+        ++common_suffix;
+
+    // The first position at which the two token streams disagree, in either
+    // of them. Declarations that end before it can be reused as-is.
+    Optional<Position> first_changed_position;
+    if (common_prefix < m_tokens.size())
+        first_changed_position = m_tokens[common_prefix].start();
+    if (common_prefix < previous.m_tokens.size()) {
+        auto previous_position = previous.m_tokens[common_prefix].start();
+        if (!first_changed_position.has_value() || previous_position < *first_changed_position)
+            first_changed_position = previous_position;
+    }
+
+    auto unit = create_root_ast_node(m_tokens.first().start(), m_tokens.last().end());
+    NonnullRefPtrVector<Declaration> declarations;
+    NonnullRefPtrVector<Declaration> reused_declarations;
+
+    auto old_declarations = previous_root->declarations();
+    size_t old_index = 0;
+    for (; old_index < old_declarations.size(); ++old_index) {
+        auto& declaration = old_declarations[old_index];
+        if (first_changed_position.has_value() && !(declaration.end() < *first_changed_position))
+            break;
+        declaration.set_parent(*unit);
+        declarations.append(declaration);
+        reused_declarations.append(declaration);
+    }
+
+    // Declarations that begin inside the common suffix are reusable too.
+    size_t first_trailing = old_declarations.size();
+    if (common_suffix > 0) {
+        auto suffix_first_position = m_tokens[m_tokens.size() - common_suffix].start();
+        while (first_trailing > old_index && !(old_declarations[first_trailing - 1].start() < suffix_first_position))
+            --first_trailing;
+    }
+
+    // Reparse everything in between.
+    m_state.token_index = 0;
+    if (!declarations.is_empty()) {
+        auto last_reused_end = declarations.last().end();
+        while (m_state.token_index < m_tokens.size() && !(m_tokens[m_state.token_index].start() > last_reused_end))
+            ++m_state.token_index;
+    }
+
+    Optional<Position> stop_position;
+    if (first_trailing < old_declarations.size())
+        stop_position = old_declarations[first_trailing].start();
+
+    while (!eof()) {
+        if (stop_position.has_value() && !(peek().start() < *stop_position))
+            break;
+        auto declaration = parse_single_declaration_in_translation_unit(*unit);
+        if (declaration) {
+            declarations.append(declaration.release_nonnull());
+        } else if (!eof()) {
+            error("unexpected token");
+            consume();
+        }
+    }
+
+    // If the reparse ran past the trailing boundary (for example because
+    // the edit removed a closing brace), skip any trailing declaration it
+    // already covered.
+    Optional<Position> last_consumed_end;
+    if (m_state.token_index > 0)
+        last_consumed_end = m_tokens[m_state.token_index - 1].end();
+
+    for (size_t i = first_trailing; i < old_declarations.size(); ++i) {
+        auto& declaration = old_declarations[i];
+        if (last_consumed_end.has_value() && declaration.start() < *last_consumed_end)
+            continue;
+        declaration.set_parent(*unit);
+        declarations.append(declaration);
+        reused_declarations.append(declaration);
+    }
+
+    unit->set_declarations(move(declarations));
+
+    // node_at() searches the flat list of nodes this parser created, so
+    // adopt everything that lives inside a reused declaration.
+    for (size_t i = 0; i < previous.m_nodes.size(); ++i) {
+        auto& node = previous.m_nodes[i];
+        for (auto& declaration : reused_declarations) {
+            if (!(node.start() < declaration.start()) && !(node.end() > declaration.end())) {
+                m_nodes.append(previous.m_nodes.ptr_at(i));
+                break;
+            }
+        }
+    }
+
+    return unit;
+}
+
 NonnullRefPtrVector<Declaration> Parser::parse_declarations_in_translation_unit(ASTNode& parent)
 {
     NonnullRefPtrVector<Declaration> declarations;
@@ -22,6 +22,15 @@ public:
     ~Parser() = default;
 
     NonnullRefPtr<TranslationUnit> parse();
+
+    // Like parse(), but reuses top-level declarations from a previous parse
+    // of the same file when their tokens (and positions) are unchanged, so
+    // the cost of a reparse is bounded by the edited declarations rather
+    // than the whole translation unit. Reused nodes keep referencing the
+    // text the previous parser's tokens were lexed from, so that text has
+    // to outlive this parser.
+    NonnullRefPtr<TranslationUnit> parse_incremental(Parser& previous);
+
     bool eof() const;
 
     RefPtr<ASTNode> node_at(Position) const;
@@ -6,11 +6,13 @@
 
 #include <AK/ByteReader.h>
 #include <AK/Debug.h>
-#include <AK/MemoryStream.h>
 #include <AK/Types.h>
-#include <AK/Vector.h>
 #include <LibCrypto/Authentication/GHash.h>
-#include <LibCrypto/BigInt/UnsignedBigInteger.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#    include <cpuid.h>
+#    include <immintrin.h>
+#endif
 
 namespace {
 
@@ -31,32 +33,201 @@ static void to_u8s(u8* b, const u32* w)
 namespace Crypto {
 namespace Authentication {
 
+#if defined(__x86_64__) || defined(__i386__)
+
+static bool detect_pclmul()
+{
+    u32 eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    return (ecx & bit_PCLMUL) && (ecx & bit_SSE4_1);
+}
+
+static bool const s_has_pclmul = detect_pclmul();
+
+// Carry-less 128x128->256 bit multiplication via PCLMULQDQ, with the
+// reduction split out so several products can share one (see below).
+// Operands are byte-reversed GCM blocks, i.e. plain little-endian integers.
+[[gnu::target("pclmul,sse4.1")]] ALWAYS_INLINE static void clmul_multiply(__m128i a, __m128i b, __m128i& low, __m128i& high)
+{
+    __m128i t0 = _mm_clmulepi64_si128(a, b, 0x00);
+    __m128i t1 = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10), _mm_clmulepi64_si128(a, b, 0x01));
+    __m128i t2 = _mm_clmulepi64_si128(a, b, 0x11);
+    low = _mm_xor_si128(t0, _mm_slli_si128(t1, 8));
+    high = _mm_xor_si128(t2, _mm_srli_si128(t1, 8));
+}
+
+// Shifts the 256-bit product left by one (to make up for GCM's reflected bit
+// order) and reduces it modulo x^128 + x^7 + x^2 + x + 1.
+// This is the tail end of the gfmul() routine from Intel's whitepaper on
+// carry-less multiplication for GCM.
+[[gnu::target("pclmul,sse4.1")]] ALWAYS_INLINE static __m128i clmul_reduce(__m128i low, __m128i high)
+{
+    __m128i low_carries = _mm_srli_epi32(low, 31);
+    __m128i high_carries = _mm_srli_epi32(high, 31);
+    low = _mm_slli_epi32(low, 1);
+    high = _mm_slli_epi32(high, 1);
+    __m128i top_carry = _mm_srli_si128(low_carries, 12);
+    high_carries = _mm_slli_si128(high_carries, 4);
+    low_carries = _mm_slli_si128(low_carries, 4);
+    low = _mm_or_si128(low, low_carries);
+    high = _mm_or_si128(high, _mm_or_si128(high_carries, top_carry));
+
+    __m128i tmp = _mm_xor_si128(_mm_slli_epi32(low, 31), _mm_xor_si128(_mm_slli_epi32(low, 30), _mm_slli_epi32(low, 25)));
+    __m128i folded = _mm_srli_si128(tmp, 4);
+    low = _mm_xor_si128(low, _mm_slli_si128(tmp, 12));
+
+    __m128i reduced = _mm_xor_si128(_mm_srli_epi32(low, 1), _mm_xor_si128(_mm_srli_epi32(low, 2), _mm_xor_si128(_mm_srli_epi32(low, 7), folded)));
+    return _mm_xor_si128(high, _mm_xor_si128(low, reduced));
+}
+
+[[gnu::target("pclmul,sse4.1")]] static void process_blocks_clmul(u32 (&tag)[4], const u8* data, size_t block_count, const u32 (*key_powers)[4])
+{
+    const __m128i byte_reverse = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    __m128i h1 = _mm_set_epi32(key_powers[0][0], key_powers[0][1], key_powers[0][2], key_powers[0][3]);
+    __m128i h2 = _mm_set_epi32(key_powers[1][0], key_powers[1][1], key_powers[1][2], key_powers[1][3]);
+    __m128i h3 = _mm_set_epi32(key_powers[2][0], key_powers[2][1], key_powers[2][2], key_powers[2][3]);
+    __m128i h4 = _mm_set_epi32(key_powers[3][0], key_powers[3][1], key_powers[3][2], key_powers[3][3]);
+
+    __m128i x = _mm_set_epi32(tag[0], tag[1], tag[2], tag[3]);
+
+    // Aggregated reduction: since reduction is linear, the tag after four
+    // blocks, (((((X^C0)H ^ C1)H ^ C2)H ^ C3)H, can be computed as
+    // (X^C0)H^4 ^ C1.H^3 ^ C2.H^2 ^ C3.H with a single reduction at the end.
+    while (block_count >= 4) {
+        __m128i block0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 0)), byte_reverse);
+        __m128i block1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 16)), byte_reverse);
+        __m128i block2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 32)), byte_reverse);
+        __m128i block3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 48)), byte_reverse);
+
+        __m128i low, high, product_low, product_high;
+        clmul_multiply(_mm_xor_si128(block0, x), h4, low, high);
+        clmul_multiply(block1, h3, product_low, product_high);
+        low = _mm_xor_si128(low, product_low);
+        high = _mm_xor_si128(high, product_high);
+        clmul_multiply(block2, h2, product_low, product_high);
+        low = _mm_xor_si128(low, product_low);
+        high = _mm_xor_si128(high, product_high);
+        clmul_multiply(block3, h1, product_low, product_high);
+        low = _mm_xor_si128(low, product_low);
+        high = _mm_xor_si128(high, product_high);
+        x = clmul_reduce(low, high);
+
+        data += 64;
+        block_count -= 4;
+    }
+
+    while (block_count) {
+        __m128i block = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data), byte_reverse);
+        __m128i low, high;
+        clmul_multiply(_mm_xor_si128(block, x), h1, low, high);
+        x = clmul_reduce(low, high);
+
+        data += 16;
+        --block_count;
+    }
+
+    tag[0] = _mm_extract_epi32(x, 3);
+    tag[1] = _mm_extract_epi32(x, 2);
+    tag[2] = _mm_extract_epi32(x, 1);
+    tag[3] = _mm_extract_epi32(x, 0);
+}
+
+#endif
+
+// Reduction constants for shifting a product right by four bits; entry n is
+// (n . x^128) mod <x^128 + x^7 + x^2 + x + 1>, expressed in the top 16 bits.
+static constexpr u16 shoup_reduction_table[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+void GHash::precompute_tables()
+{
+    // H^1..H^4 for the carry-less multiplication path.
+    __builtin_memcpy(m_key_powers[0], m_key, sizeof(m_key));
+    for (size_t i = 1; i < 4; ++i)
+        galois_multiply(m_key_powers[i], m_key_powers[i - 1], m_key);
+
+    // Shoup's 4-bit tables: entries for 8, 4, 2 and 1 are H shifted right by
+    // 0..3 bits (with reduction), everything else is built up by XOR.
+    u64 hi = ((u64)m_key[0] << 32) | m_key[1];
+    u64 lo = ((u64)m_key[2] << 32) | m_key[3];
+
+    m_table_hi[0] = 0;
+    m_table_lo[0] = 0;
+    m_table_hi[8] = hi;
+    m_table_lo[8] = lo;
+    for (size_t i = 4; i > 0; i >>= 1) {
+        u64 carry = (lo & 1) ? 0xe100000000000000ull : 0;
+        lo = (hi << 63) | (lo >> 1);
+        hi = (hi >> 1) ^ carry;
+        m_table_hi[i] = hi;
+        m_table_lo[i] = lo;
+    }
+    for (size_t i = 2; i <= 8; i <<= 1) {
+        for (size_t j = 1; j < i; ++j) {
+            m_table_hi[i + j] = m_table_hi[i] ^ m_table_hi[j];
+            m_table_lo[i + j] = m_table_lo[i] ^ m_table_lo[j];
+        }
+    }
+}
+
+void GHash::process_blocks(u32 (&tag)[4], const u8* data, size_t block_count) const
+{
+#if defined(__x86_64__) || defined(__i386__)
+    if (s_has_pclmul) {
+        process_blocks_clmul(tag, data, block_count, m_key_powers);
+        return;
+    }
+#endif
+
+    for (size_t block = 0; block < block_count; ++block, data += 16) {
+        for (size_t j = 0; j < 4; ++j)
+            tag[j] ^= to_u32(data + j * 4);
+
+        // Multiply the tag by H one nibble at a time, highest-degree
+        // coefficients first. With GCM's reflected bit order those live in the
+        // *low* nibble of the *last* byte, and "times x^4" is a right shift.
+        u64 zh = 0;
+        u64 zl = 0;
+        auto shift_right_by_four = [&] {
+            u8 rem = zl & 0xf;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ ((u64)shoup_reduction_table[rem] << 48);
+        };
+        for (ssize_t i = 15; i >= 0; --i) {
+            u8 byte = (tag[i / 4] >> (24 - 8 * (i % 4))) & 0xff;
+            if (i != 15)
+                shift_right_by_four();
+            zh ^= m_table_hi[byte & 0xf];
+            zl ^= m_table_lo[byte & 0xf];
+            shift_right_by_four();
+            zh ^= m_table_hi[byte >> 4];
+            zl ^= m_table_lo[byte >> 4];
+        }
+
+        tag[0] = zh >> 32;
+        tag[1] = zh & 0xffffffff;
+        tag[2] = zl >> 32;
+        tag[3] = zl & 0xffffffff;
+    }
+}
+
 GHash::TagType GHash::process(ReadonlyBytes aad, ReadonlyBytes cipher)
 {
     u32 tag[4] { 0, 0, 0, 0 };
 
     auto transform_one = [&](auto& buf) {
-        size_t i = 0;
-        for (; i < buf.size(); i += 16) {
-            if (i + 16 <= buf.size()) {
-                for (auto j = 0; j < 4; ++j) {
-                    tag[j] ^= to_u32(buf.offset(i + j * 4));
-                }
-                galois_multiply(tag, m_key, tag);
-            }
-        }
+        auto full_blocks = buf.size() / 16;
+        if (full_blocks)
+            process_blocks(tag, buf.data(), full_blocks);
 
-        if (i > buf.size()) {
-            static u8 buffer[16];
-            Bytes buffer_bytes { buffer, 16 };
-            OutputMemoryStream stream { buffer_bytes };
-            stream.write(buf.slice(i - 16));
-            stream.fill_to_end(0);
-
-            for (auto j = 0; j < 4; ++j) {
-                tag[j] ^= to_u32(buffer_bytes.offset(j * 4));
-            }
-            galois_multiply(tag, m_key, tag);
+        if (auto remaining = buf.size() % 16) {
+            u8 buffer[16] = {};
+            __builtin_memcpy(buffer, buf.offset(full_blocks * 16), remaining);
+            process_blocks(tag, buffer, 1);
         }
     };
 
@@ -66,24 +237,19 @@ GHash::TagType GHash::process(ReadonlyBytes aad, ReadonlyBytes cipher)
     auto aad_bits = 8 * (u64)aad.size();
     auto cipher_bits = 8 * (u64)cipher.size();
 
-    auto high = [](u64 value) -> u32 { return value >> 32; };
-    auto low = [](u64 value) -> u32 { return value & 0xffffffff; };
-
     if constexpr (GHASH_PROCESS_DEBUG) {
-        dbgln("AAD bits: {} : {}", high(aad_bits), low(aad_bits));
-        dbgln("Cipher bits: {} : {}", high(cipher_bits), low(cipher_bits));
+        dbgln("AAD bits: {} : {}", (u32)(aad_bits >> 32), (u32)aad_bits);
+        dbgln("Cipher bits: {} : {}", (u32)(cipher_bits >> 32), (u32)cipher_bits);
         dbgln("Tag bits: {} : {} : {} : {}", tag[0], tag[1], tag[2], tag[3]);
     }
 
-    tag[0] ^= high(aad_bits);
-    tag[1] ^= low(aad_bits);
-    tag[2] ^= high(cipher_bits);
-    tag[3] ^= low(cipher_bits);
+    u8 length_block[16];
+    ByteReader::store(length_block, AK::convert_between_host_and_big_endian(aad_bits));
+    ByteReader::store(length_block + 8, AK::convert_between_host_and_big_endian(cipher_bits));
+    process_blocks(tag, length_block, 1);
 
     dbgln_if(GHASH_PROCESS_DEBUG, "Tag bits: {} : {} : {} : {}", tag[0], tag[1], tag[2], tag[3]);
 
-    galois_multiply(tag, m_key, tag);
-
     TagType digest;
     to_u8s(digest.data, tag);
 
@@ -40,6 +40,7 @@ public:
         for (size_t i = 0; i < 16; i += 4) {
             m_key[i / 4] = AK::convert_between_host_and_big_endian(ByteReader::load32(key.offset(i)));
         }
+        precompute_tables();
     }
 
     constexpr static size_t digest_size() { return TagType::Size; }
@@ -49,9 +50,18 @@ public:
     TagType process(ReadonlyBytes aad, ReadonlyBytes cipher);
 
 private:
-    inline void transform(ReadonlyBytes, ReadonlyBytes);
+    void precompute_tables();
+    void process_blocks(u32 (&tag)[4], const u8* blocks, size_t block_count) const;
 
     u32 m_key[4];
+    // Shoup's 4-bit multiplication tables for the table-driven path:
+    // m_table_{hi,lo}[n] are the two halves of (n . H), n interpreted as a
+    // degree-3 polynomial in the low coefficients.
+    u64 m_table_hi[16];
+    u64 m_table_lo[16];
+    // H^1..H^4, used by the carry-less multiplication path to aggregate four
+    // blocks into a single reduction.
+    u32 m_key_powers[4][4];
 };
 
 }
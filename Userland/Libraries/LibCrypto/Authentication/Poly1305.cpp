@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteReader.h>
+#include <AK/Endian.h>
+#include <LibCrypto/Authentication/Poly1305.h>
+
+namespace Crypto {
+namespace Authentication {
+
+static u32 load32_le(const u8* data)
+{
+    return AK::convert_between_host_and_little_endian(ByteReader::load32(data));
+}
+
+static void store32_le(u8* data, u32 value)
+{
+    ByteReader::store(data, AK::convert_between_host_and_little_endian(value));
+}
+
+Poly1305::Poly1305(ReadonlyBytes key)
+{
+    VERIFY(key.size() >= 32);
+
+    // r is "clamped": some bits are forced to zero so the schoolbook
+    // multiply below can never overflow its 64-bit accumulators.
+    m_r[0] = load32_le(key.offset(0)) & 0x3ffffff;
+    m_r[1] = (load32_le(key.offset(3)) >> 2) & 0x3ffff03;
+    m_r[2] = (load32_le(key.offset(6)) >> 4) & 0x3ffc0ff;
+    m_r[3] = (load32_le(key.offset(9)) >> 6) & 0x3f03fff;
+    m_r[4] = (load32_le(key.offset(12)) >> 8) & 0x00fffff;
+
+    for (size_t i = 0; i < 4; ++i)
+        m_pad[i] = load32_le(key.offset(16 + 4 * i));
+}
+
+void Poly1305::process_block(const u8* block, u32 high_bit)
+{
+    u32 r0 = m_r[0];
+    u32 r1 = m_r[1];
+    u32 r2 = m_r[2];
+    u32 r3 = m_r[3];
+    u32 r4 = m_r[4];
+
+    // Multiplying the limbs that "wrap around" 2^130 picks up a factor of 5,
+    // since 2^130 = 5 (mod 2^130 - 5).
+    u32 s1 = r1 * 5;
+    u32 s2 = r2 * 5;
+    u32 s3 = r3 * 5;
+    u32 s4 = r4 * 5;
+
+    u32 h0 = m_h[0] + (load32_le(block) & 0x3ffffff);
+    u32 h1 = m_h[1] + ((load32_le(block + 3) >> 2) & 0x3ffffff);
+    u32 h2 = m_h[2] + ((load32_le(block + 6) >> 4) & 0x3ffffff);
+    u32 h3 = m_h[3] + ((load32_le(block + 9) >> 6) & 0x3ffffff);
+    u32 h4 = m_h[4] + ((load32_le(block + 12) >> 8) | high_bit);
+
+    u64 d0 = (u64)h0 * r0 + (u64)h1 * s4 + (u64)h2 * s3 + (u64)h3 * s2 + (u64)h4 * s1;
+    u64 d1 = (u64)h0 * r1 + (u64)h1 * r0 + (u64)h2 * s4 + (u64)h3 * s3 + (u64)h4 * s2;
+    u64 d2 = (u64)h0 * r2 + (u64)h1 * r1 + (u64)h2 * r0 + (u64)h3 * s4 + (u64)h4 * s3;
+    u64 d3 = (u64)h0 * r3 + (u64)h1 * r2 + (u64)h2 * r1 + (u64)h3 * r0 + (u64)h4 * s4;
+    u64 d4 = (u64)h0 * r4 + (u64)h1 * r3 + (u64)h2 * r2 + (u64)h3 * r1 + (u64)h4 * r0;
+
+    u32 carry;
+    carry = (u32)(d0 >> 26), h0 = (u32)d0 & 0x3ffffff;
+    d1 += carry, carry = (u32)(d1 >> 26), h1 = (u32)d1 & 0x3ffffff;
+    d2 += carry, carry = (u32)(d2 >> 26), h2 = (u32)d2 & 0x3ffffff;
+    d3 += carry, carry = (u32)(d3 >> 26), h3 = (u32)d3 & 0x3ffffff;
+    d4 += carry, carry = (u32)(d4 >> 26), h4 = (u32)d4 & 0x3ffffff;
+    h0 += carry * 5, carry = h0 >> 26, h0 &= 0x3ffffff;
+    h1 += carry;
+
+    m_h[0] = h0;
+    m_h[1] = h1;
+    m_h[2] = h2;
+    m_h[3] = h3;
+    m_h[4] = h4;
+}
+
+void Poly1305::update(ReadonlyBytes message)
+{
+    size_t offset = 0;
+
+    if (m_buffer_length) {
+        auto chunk = min(message.size(), sizeof(m_buffer) - m_buffer_length);
+        __builtin_memcpy(&m_buffer[m_buffer_length], message.data(), chunk);
+        m_buffer_length += chunk;
+        offset += chunk;
+        if (m_buffer_length < sizeof(m_buffer))
+            return;
+        process_block(m_buffer, 1 << 24);
+        m_buffer_length = 0;
+    }
+
+    while (message.size() - offset >= sizeof(m_buffer)) {
+        process_block(message.offset(offset), 1 << 24);
+        offset += sizeof(m_buffer);
+    }
+
+    if (offset < message.size()) {
+        m_buffer_length = message.size() - offset;
+        __builtin_memcpy(m_buffer, message.offset(offset), m_buffer_length);
+    }
+}
+
+Poly1305::TagType Poly1305::digest()
+{
+    if (m_buffer_length) {
+        // The final partial block is padded with a single one bit and zeros,
+        // and does not get the usual 2^128 bit added on top.
+        m_buffer[m_buffer_length++] = 1;
+        while (m_buffer_length < sizeof(m_buffer))
+            m_buffer[m_buffer_length++] = 0;
+        process_block(m_buffer, 0);
+        m_buffer_length = 0;
+    }
+
+    // Fully propagate the carries.
+    u32 carry;
+    carry = m_h[1] >> 26, m_h[1] &= 0x3ffffff;
+    m_h[2] += carry, carry = m_h[2] >> 26, m_h[2] &= 0x3ffffff;
+    m_h[3] += carry, carry = m_h[3] >> 26, m_h[3] &= 0x3ffffff;
+    m_h[4] += carry, carry = m_h[4] >> 26, m_h[4] &= 0x3ffffff;
+    m_h[0] += carry * 5, carry = m_h[0] >> 26, m_h[0] &= 0x3ffffff;
+    m_h[1] += carry;
+
+    // Compute h + -p, and select it over h iff h >= p.
+    u32 g0 = m_h[0] + 5;
+    carry = g0 >> 26, g0 &= 0x3ffffff;
+    u32 g1 = m_h[1] + carry;
+    carry = g1 >> 26, g1 &= 0x3ffffff;
+    u32 g2 = m_h[2] + carry;
+    carry = g2 >> 26, g2 &= 0x3ffffff;
+    u32 g3 = m_h[3] + carry;
+    carry = g3 >> 26, g3 &= 0x3ffffff;
+    u32 g4 = m_h[4] + carry - (1 << 26);
+
+    u32 mask = (g4 >> 31) - 1;
+    g0 &= mask;
+    g1 &= mask;
+    g2 &= mask;
+    g3 &= mask;
+    g4 &= mask;
+    mask = ~mask;
+    m_h[0] = (m_h[0] & mask) | g0;
+    m_h[1] = (m_h[1] & mask) | g1;
+    m_h[2] = (m_h[2] & mask) | g2;
+    m_h[3] = (m_h[3] & mask) | g3;
+    m_h[4] = (m_h[4] & mask) | g4;
+
+    // Repack the 26-bit limbs into 32-bit words and add the pad.
+    u32 word0 = m_h[0] | (m_h[1] << 26);
+    u32 word1 = (m_h[1] >> 6) | (m_h[2] << 20);
+    u32 word2 = (m_h[2] >> 12) | (m_h[3] << 14);
+    u32 word3 = (m_h[3] >> 18) | (m_h[4] << 8);
+
+    TagType tag;
+    u64 f = (u64)word0 + m_pad[0];
+    store32_le(&tag.data[0], (u32)f);
+    f = (u64)word1 + m_pad[1] + (f >> 32);
+    store32_le(&tag.data[4], (u32)f);
+    f = (u64)word2 + m_pad[2] + (f >> 32);
+    store32_le(&tag.data[8], (u32)f);
+    f = (u64)word3 + m_pad[3] + (f >> 32);
+    store32_le(&tag.data[12], (u32)f);
+
+    return tag;
+}
+
+}
+
+}
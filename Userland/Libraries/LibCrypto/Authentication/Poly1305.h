@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+#include <AK/String.h>
+#include <AK/Types.h>
+
+namespace Crypto {
+namespace Authentication {
+
+struct Poly1305Digest {
+    constexpr static size_t Size = 16;
+    u8 data[Size];
+
+    const u8* immutable_data() const { return data; }
+    size_t data_length() { return Size; }
+};
+
+// The Poly1305 one-time authenticator from RFC 8439. The key MUST NOT be
+// reused for two different messages; the AEAD construction derives a fresh
+// key for every record from the ChaCha20 key stream.
+// Implemented with 26-bit limbs so all the arithmetic fits u32xu32->u64
+// multiplications, which works out fine on 32-bit targets.
+class Poly1305 final {
+public:
+    using TagType = Poly1305Digest;
+
+    explicit Poly1305(ReadonlyBytes key);
+
+    constexpr static size_t digest_size() { return TagType::Size; }
+
+    String class_name() const { return "Poly1305"; }
+
+    void update(ReadonlyBytes);
+    TagType digest();
+
+private:
+    void process_block(const u8* block, u32 high_bit);
+
+    u32 m_r[5];
+    u32 m_pad[4];
+    u32 m_h[5] {};
+    u8 m_buffer[16];
+    size_t m_buffer_length { 0 };
+};
+
+}
+
+}
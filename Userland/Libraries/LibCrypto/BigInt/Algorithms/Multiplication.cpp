@@ -9,38 +9,99 @@
 
 namespace Crypto {
 
+// Below this size (in words) the quadratic schoolbook algorithm wins; above it
+// Karatsuba's better asymptotic complexity pays for its extra additions.
+constexpr size_t karatsuba_threshold_in_words = 32;
+
 /**
- * Complexity: O(N^2) where N is the number of words in the larger number
- * Multiplication method:
- * An integer is equal to the sum of the powers of two
- * according to the indices of its 'on' bits.
- * So to multiple x*y, we go over each '1' bit in x (say the i'th bit),
- * and add y<<i to the result.
+ * Complexity: O(N^2) where N is the number of words in the larger number.
+ * Computes the product one word of `left` at a time: for each word of `left`,
+ * "output += left_word * right" is accumulated at the corresponding offset,
+ * which is the same multiply-accumulate primitive the montgomery code uses.
  */
-FLATTEN void UnsignedBigIntegerAlgorithms::multiply_without_allocation(
+void UnsignedBigIntegerAlgorithms::multiply_schoolbook_without_allocation(
     UnsignedBigInteger const& left,
     UnsignedBigInteger const& right,
-    UnsignedBigInteger& temp_shift_result,
-    UnsignedBigInteger& temp_shift_plus,
-    UnsignedBigInteger& temp_shift,
     UnsignedBigInteger& output)
 {
+    size_t left_length = left.trimmed_length();
+    size_t right_length = right.trimmed_length();
+
     output.set_to_0();
+    if (left_length == 0 || right_length == 0)
+        return;
+    output.resize_with_leading_zeros(left_length + right_length);
+
+    for (size_t i = 0; i < left_length; ++i)
+        output.m_words[i + right_length] = montgomery_fragment(output, i, right, left.m_words[i], right_length);
+
+    output.clamp_to_trimmed_length();
+}
+
+/**
+ * Complexity: O(N^log2(3)) where N is the number of words in the larger number.
+ * Karatsuba multiplication: with both numbers split at m words into
+ * (x1 * 2^m + x0) and (y1 * 2^m + y0), the product only needs three
+ * sub-products instead of four:
+ *   z0 = x0 * y0
+ *   z2 = x1 * y1
+ *   z1 = (x0 + x1) * (y0 + y1) - z0 - z2
+ *   output = z2 * 2^2m + z1 * 2^m + z0
+ * Note: Unlike the schoolbook path this allocates the sub-products and
+ * scratch space, so it is only used above the size threshold where the
+ * reduced work dwarfs the allocation cost.
+ */
+void UnsignedBigIntegerAlgorithms::multiply_karatsuba(
+    UnsignedBigInteger const& left,
+    UnsignedBigInteger const& right,
+    UnsignedBigInteger& output)
+{
+    size_t split_at = min(left.trimmed_length(), right.trimmed_length()) / 2;
+
+    auto lower_words = [split_at](UnsignedBigInteger const& number) {
+        UnsignedBigInteger result;
+        result.m_words.append(number.m_words.data(), min(split_at, number.length()));
+        return result;
+    };
+    auto upper_words = [split_at](UnsignedBigInteger const& number) {
+        UnsignedBigInteger result;
+        if (number.length() > split_at)
+            result.m_words.append(number.m_words.data() + split_at, number.length() - split_at);
+        return result;
+    };
+
+    auto x0 = lower_words(left);
+    auto x1 = upper_words(left);
+    auto y0 = lower_words(right);
+    auto y1 = upper_words(right);
+
+    UnsignedBigInteger z0;
+    UnsignedBigInteger z2;
+    UnsignedBigInteger z1_full;
+    multiply_without_allocation(x0, y0, z0);
+    multiply_without_allocation(x1, y1, z2);
+    multiply_without_allocation(x0.plus(x1), y0.plus(y1), z1_full);
 
-    // iterate all bits
-    for (size_t word_index = 0; word_index < left.length(); ++word_index) {
-        for (size_t bit_index = 0; bit_index < UnsignedBigInteger::BITS_IN_WORD; ++bit_index) {
-            // If the bit is off - skip over it
-            if (!(left.m_words[word_index] & (1 << bit_index)))
-                continue;
+    // (x0 + x1) * (y0 + y1) >= x0 * y0 + x1 * y1, so these can't underflow.
+    auto z1 = z1_full.minus(z0).minus(z2);
 
-            size_t shift_amount = word_index * UnsignedBigInteger::BITS_IN_WORD + bit_index;
+    output.set_to(z0);
+    UnsignedBigInteger shifted;
+    shift_left_by_n_words(z1, split_at, shifted);
+    add_into_accumulator_without_allocation(output, shifted);
+    shift_left_by_n_words(z2, 2 * split_at, shifted);
+    add_into_accumulator_without_allocation(output, shifted);
+}
 
-            // output += (right << shift_amount);
-            shift_left_without_allocation(right, shift_amount, temp_shift_result, temp_shift_plus, temp_shift);
-            add_into_accumulator_without_allocation(output, temp_shift);
-        }
-    }
+void UnsignedBigIntegerAlgorithms::multiply_without_allocation(
+    UnsignedBigInteger const& left,
+    UnsignedBigInteger const& right,
+    UnsignedBigInteger& output)
+{
+    if (min(left.trimmed_length(), right.trimmed_length()) < karatsuba_threshold_in_words)
+        multiply_schoolbook_without_allocation(left, right, output);
+    else
+        multiply_karatsuba(left, right, output);
 }
 
 }
@@ -12,9 +12,20 @@ namespace Crypto::Checksum {
 
 void Adler32::update(ReadonlyBytes data)
 {
-    for (size_t i = 0; i < data.size(); i++) {
-        m_state_a = (m_state_a + data.at(i)) % 65521;
-        m_state_b = (m_state_b + m_state_a) % 65521;
+    // Both sums fit in a u32 for up to 5552 input bytes (this bound is
+    // borrowed from zlib), so the expensive modulo only has to be taken once
+    // per chunk instead of twice per byte.
+    constexpr size_t maximum_chunk_size = 5552;
+
+    size_t i = 0;
+    while (i < data.size()) {
+        const auto chunk_end = min(data.size(), i + maximum_chunk_size);
+        for (; i < chunk_end; i++) {
+            m_state_a += data.at(i);
+            m_state_b += m_state_a;
+        }
+        m_state_a %= 65521;
+        m_state_b %= 65521;
     }
 };
 
@@ -12,7 +12,30 @@ namespace Crypto::Checksum {
 
 void CRC32::update(ReadonlyBytes data)
 {
-    for (size_t i = 0; i < data.size(); i++) {
+    size_t i = 0;
+
+    // Slicing-by-8: fold eight bytes at a time into the state with eight
+    // independent table lookups, which breaks the lookup->shift->lookup
+    // dependency chain of the byte-at-a-time loop.
+    // Note: The SSE4.2 crc32 instruction computes CRC-32C (a different
+    //       polynomial), so it's of no use for the zlib/gzip CRC-32 here.
+    while (data.size() - i >= 8) {
+        const u32 low = m_state ^ (data.at(i) | data.at(i + 1) << 8 | data.at(i + 2) << 16 | data.at(i + 3) << 24);
+        const u32 high = data.at(i + 4) | data.at(i + 5) << 8 | data.at(i + 6) << 16 | data.at(i + 7) << 24;
+
+        m_state = table.data[7][low & 0xFF]
+            ^ table.data[6][(low >> 8) & 0xFF]
+            ^ table.data[5][(low >> 16) & 0xFF]
+            ^ table.data[4][low >> 24]
+            ^ table.data[3][high & 0xFF]
+            ^ table.data[2][(high >> 8) & 0xFF]
+            ^ table.data[1][(high >> 16) & 0xFF]
+            ^ table.data[0][high >> 24];
+
+        i += 8;
+    }
+
+    for (; i < data.size(); i++) {
         m_state = table[(m_state ^ data.at(i)) & 0xFF] ^ (m_state >> 8);
     }
 };
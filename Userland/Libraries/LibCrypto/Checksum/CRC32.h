@@ -12,8 +12,11 @@
 
 namespace Crypto::Checksum {
 
+// Tables for "slicing-by-8": table 0 is the classic byte-at-a-time table, and
+// table k advances a byte's contribution by k more zero bytes, so eight input
+// bytes can be folded into the state with eight independent table lookups.
 struct Table {
-    u32 data[256];
+    u32 data[8][256];
 
     constexpr Table()
         : data()
@@ -29,13 +32,18 @@ struct Table {
                 }
             }
 
-            data[i] = value;
+            data[0][i] = value;
+        }
+
+        for (auto k = 1; k < 8; k++) {
+            for (auto i = 0; i < 256; i++)
+                data[k][i] = (data[k - 1][i] >> 8) ^ data[0][data[k - 1][i] & 0xFF];
         }
     }
 
     constexpr u32 operator[](int index) const
     {
-        return data[index];
+        return data[0][index];
     }
 };
 
@@ -7,9 +7,66 @@
 #include <AK/StringBuilder.h>
 #include <LibCrypto/Cipher/AES.h>
 
+#if defined(__x86_64__) || defined(__i386__)
+#    include <cpuid.h>
+#    include <immintrin.h>
+#endif
+
 namespace Crypto {
 namespace Cipher {
 
+#if defined(__x86_64__) || defined(__i386__)
+
+static bool detect_aesni()
+{
+    u32 eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    return (ecx & bit_AES) && (ecx & bit_SSSE3);
+}
+
+static bool const s_has_aesni = detect_aesni();
+
+// The software key schedule stores each round key word big-endian (see
+// get_key()), so the bytes within each word have to be reversed into the
+// order the AES-NI instructions expect.
+[[gnu::target("aes,ssse3")]] static __m128i aesni_load_round_key(const u32* round_key)
+{
+    const __m128i byte_swap_each_word = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    return _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)round_key), byte_swap_each_word);
+}
+
+[[gnu::target("aes,ssse3")]] static void aesni_encrypt_block(const AESCipherKey& key, const u8* in, u8* out)
+{
+    const auto* round_keys = key.round_keys();
+
+    auto state = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in), aesni_load_round_key(round_keys));
+    size_t i = 1;
+    for (; i < key.rounds(); ++i)
+        state = _mm_aesenc_si128(state, aesni_load_round_key(round_keys + 4 * i));
+    state = _mm_aesenclast_si128(state, aesni_load_round_key(round_keys + 4 * i));
+
+    _mm_storeu_si128((__m128i*)out, state);
+}
+
+// Note: This relies on expand_decrypt_key() producing keys for the equivalent
+//       inverse cipher (reversed round order, InvMixColumns applied to the
+//       middle round keys), which is exactly the form AESDEC consumes.
+[[gnu::target("aes,ssse3")]] static void aesni_decrypt_block(const AESCipherKey& key, const u8* in, u8* out)
+{
+    const auto* round_keys = key.round_keys();
+
+    auto state = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in), aesni_load_round_key(round_keys));
+    size_t i = 1;
+    for (; i < key.rounds(); ++i)
+        state = _mm_aesdec_si128(state, aesni_load_round_key(round_keys + 4 * i));
+    state = _mm_aesdeclast_si128(state, aesni_load_round_key(round_keys + 4 * i));
+
+    _mm_storeu_si128((__m128i*)out, state);
+}
+
+#endif
+
 template<typename T>
 constexpr u32 get_key(T pt)
 {
@@ -196,6 +253,13 @@ void AESCipherKey::expand_decrypt_key(ReadonlyBytes user_key, size_t bits)
 
 void AESCipher::encrypt_block(const AESCipherBlock& in, AESCipherBlock& out)
 {
+#if defined(__x86_64__) || defined(__i386__)
+    if (s_has_aesni) {
+        aesni_encrypt_block(key(), in.bytes().data(), out.bytes().data());
+        return;
+    }
+#endif
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
@@ -288,6 +352,13 @@ void AESCipher::encrypt_block(const AESCipherBlock& in, AESCipherBlock& out)
 
 void AESCipher::decrypt_block(const AESCipherBlock& in, AESCipherBlock& out)
 {
+#if defined(__x86_64__) || defined(__i386__)
+    if (s_has_aesni) {
+        aesni_decrypt_block(key(), in.bytes().data(), out.bytes().data());
+        return;
+    }
+#endif
+
     u32 s0, s1, s2, s3, t0, t1, t2, t3;
     size_t r { 0 };
 
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteReader.h>
+#include <AK/Endian.h>
+#include <LibCrypto/Cipher/ChaCha20.h>
+
+namespace Crypto {
+namespace Cipher {
+
+static u32 load32_le(const u8* data)
+{
+    return AK::convert_between_host_and_little_endian(ByteReader::load32(data));
+}
+
+static void store32_le(u8* data, u32 value)
+{
+    ByteReader::store(data, AK::convert_between_host_and_little_endian(value));
+}
+
+ChaCha20::ChaCha20(ReadonlyBytes key, ReadonlyBytes nonce, u32 initial_counter)
+{
+    VERIFY(key.size() == 16 || key.size() == 32);
+    VERIFY(nonce.size() == 12);
+
+    // The constant words spell out "expand 16-byte k" or "expand 32-byte k",
+    // and a 16-byte key is simply used twice.
+    const char* constants = key.size() == 32 ? "expand 32-byte k" : "expand 16-byte k";
+    for (size_t i = 0; i < 4; ++i)
+        m_state[i] = load32_le((const u8*)constants + 4 * i);
+
+    for (size_t i = 0; i < 8; ++i)
+        m_state[4 + i] = load32_le(key.offset((4 * i) % key.size()));
+
+    m_state[12] = initial_counter;
+
+    for (size_t i = 0; i < 3; ++i)
+        m_state[13 + i] = load32_le(nonce.offset(4 * i));
+}
+
+ALWAYS_INLINE static void quarter_round(u32& a, u32& b, u32& c, u32& d)
+{
+    a += b;
+    d ^= a;
+    d = (d << 16) | (d >> 16);
+    c += d;
+    b ^= c;
+    b = (b << 12) | (b >> 20);
+    a += b;
+    d ^= a;
+    d = (d << 8) | (d >> 24);
+    c += d;
+    b ^= c;
+    b = (b << 7) | (b >> 25);
+}
+
+void ChaCha20::generate_block()
+{
+    u32 working[16];
+    for (size_t i = 0; i < 16; ++i)
+        working[i] = m_state[i];
+
+    for (size_t i = 0; i < 10; ++i) {
+        quarter_round(working[0], working[4], working[8], working[12]);
+        quarter_round(working[1], working[5], working[9], working[13]);
+        quarter_round(working[2], working[6], working[10], working[14]);
+        quarter_round(working[3], working[7], working[11], working[15]);
+        quarter_round(working[0], working[5], working[10], working[15]);
+        quarter_round(working[1], working[6], working[11], working[12]);
+        quarter_round(working[2], working[7], working[8], working[13]);
+        quarter_round(working[3], working[4], working[9], working[14]);
+    }
+
+    for (size_t i = 0; i < 16; ++i)
+        store32_le(&m_block[4 * i], working[i] + m_state[i]);
+
+    ++m_state[12]; // block counter
+    m_position = 0;
+}
+
+void ChaCha20::run_cipher(ReadonlyBytes in, Bytes out)
+{
+    VERIFY(out.size() >= in.size());
+
+    size_t offset = 0;
+    while (offset < in.size()) {
+        if (m_position == sizeof(m_block))
+            generate_block();
+        auto chunk = min(in.size() - offset, sizeof(m_block) - m_position);
+        for (size_t i = 0; i < chunk; ++i)
+            out[offset + i] = in[offset + i] ^ m_block[m_position + i];
+        m_position += chunk;
+        offset += chunk;
+    }
+}
+
+void ChaCha20::encrypt(ReadonlyBytes in, Bytes out)
+{
+    run_cipher(in, out);
+}
+
+void ChaCha20::decrypt(ReadonlyBytes in, Bytes out)
+{
+    // XOR with the key stream, same as encryption.
+    run_cipher(in, out);
+}
+
+void ChaCha20::generate_block(Bytes out)
+{
+    size_t offset = 0;
+    while (offset < out.size()) {
+        if (m_position == sizeof(m_block))
+            generate_block();
+        auto chunk = min(out.size() - offset, sizeof(m_block) - m_position);
+        __builtin_memcpy(out.offset(offset), &m_block[m_position], chunk);
+        m_position += chunk;
+        offset += chunk;
+    }
+}
+
+}
+
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+#include <AK/Types.h>
+
+namespace Crypto {
+namespace Cipher {
+
+// The ChaCha20 stream cipher from RFC 8439: a 256-bit (or 128-bit) key, a
+// 96-bit nonce and a 32-bit block counter. Encryption and decryption are the
+// same operation (XOR with the key stream), and the whole thing is plain
+// 32-bit integer math, so it's fast even without any hardware AES support.
+class ChaCha20 {
+public:
+    ChaCha20(ReadonlyBytes key, ReadonlyBytes nonce, u32 initial_counter = 0);
+
+    void encrypt(ReadonlyBytes in, Bytes out);
+    void decrypt(ReadonlyBytes in, Bytes out);
+
+    // Produces key stream bytes without any input (used to derive the
+    // Poly1305 one-time key in the AEAD construction).
+    void generate_block(Bytes out);
+
+private:
+    void run_cipher(ReadonlyBytes in, Bytes out);
+    void generate_block();
+
+    u32 m_state[16] {};
+    u8 m_block[64] {};
+    size_t m_position { 64 }; // offset of the first unused key stream byte
+};
+
+}
+
+}
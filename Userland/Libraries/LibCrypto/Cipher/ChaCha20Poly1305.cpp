@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Endian.h>
+#include <LibCrypto/Authentication/Poly1305.h>
+#include <LibCrypto/Cipher/ChaCha20.h>
+#include <LibCrypto/Cipher/ChaCha20Poly1305.h>
+
+namespace Crypto {
+namespace Cipher {
+
+ChaCha20Poly1305::ChaCha20Poly1305(ReadonlyBytes key)
+{
+    VERIFY(key.size() == key_size);
+    __builtin_memcpy(m_key, key.data(), key_size);
+}
+
+void ChaCha20Poly1305::compute_tag(ReadonlyBytes one_time_key, ReadonlyBytes aad, ReadonlyBytes ciphertext, Bytes tag) const
+{
+    VERIFY(tag.size() == tag_size);
+
+    Authentication::Poly1305 mac { one_time_key };
+
+    constexpr u8 zero_padding[16] {};
+    mac.update(aad);
+    if (aad.size() % 16)
+        mac.update({ zero_padding, 16 - aad.size() % 16 });
+    mac.update(ciphertext);
+    if (ciphertext.size() % 16)
+        mac.update({ zero_padding, 16 - ciphertext.size() % 16 });
+
+    LittleEndian<u64> lengths[2] { aad.size(), ciphertext.size() };
+    mac.update({ lengths, sizeof(lengths) });
+
+    auto digest = mac.digest();
+    __builtin_memcpy(tag.data(), digest.data, tag_size);
+}
+
+void ChaCha20Poly1305::encrypt(ReadonlyBytes in, Bytes out, ReadonlyBytes nonce, ReadonlyBytes aad, Bytes tag)
+{
+    ChaCha20 cipher { { m_key, key_size }, nonce };
+
+    // The Poly1305 key is the first half of key stream block 0; the rest of
+    // that block is discarded and the payload starts at block 1.
+    u8 first_block[64];
+    cipher.generate_block({ first_block, sizeof(first_block) });
+
+    cipher.encrypt(in, out);
+    compute_tag({ first_block, 32 }, aad, { out.data(), in.size() }, tag);
+}
+
+VerificationConsistency ChaCha20Poly1305::decrypt(ReadonlyBytes in, Bytes out, ReadonlyBytes nonce, ReadonlyBytes aad, ReadonlyBytes tag)
+{
+    VERIFY(tag.size() == tag_size);
+
+    ChaCha20 cipher { { m_key, key_size }, nonce };
+
+    u8 first_block[64];
+    cipher.generate_block({ first_block, sizeof(first_block) });
+
+    u8 expected_tag[tag_size];
+    compute_tag({ first_block, 32 }, aad, in, { expected_tag, tag_size });
+
+    // FIXME: This needs a constant-time comparison.
+    if (__builtin_memcmp(expected_tag, tag.data(), tag_size) != 0)
+        return VerificationConsistency::Inconsistent;
+
+    cipher.decrypt(in, out);
+    return VerificationConsistency::Consistent;
+}
+
+}
+
+}
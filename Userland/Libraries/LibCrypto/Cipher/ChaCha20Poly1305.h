@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+#include <AK/Types.h>
+#include <LibCrypto/Verification.h>
+
+namespace Crypto {
+namespace Cipher {
+
+// The AEAD_CHACHA20_POLY1305 construction from RFC 8439 section 2.8:
+// the first ChaCha20 key stream block keys a one-time Poly1305 authenticator
+// over the additional data and the ciphertext, and the remaining key stream
+// encrypts the payload.
+class ChaCha20Poly1305 {
+public:
+    constexpr static size_t key_size = 32;
+    constexpr static size_t nonce_size = 12;
+    constexpr static size_t tag_size = 16;
+
+    explicit ChaCha20Poly1305(ReadonlyBytes key);
+
+    void encrypt(ReadonlyBytes in, Bytes out, ReadonlyBytes nonce, ReadonlyBytes aad, Bytes tag);
+
+    // Note: The tag is verified over the ciphertext *before* anything is
+    //       decrypted, so `out' may alias `in' for in-place decryption.
+    VerificationConsistency decrypt(ReadonlyBytes in, Bytes out, ReadonlyBytes nonce, ReadonlyBytes aad, ReadonlyBytes tag);
+
+private:
+    void compute_tag(ReadonlyBytes one_time_key, ReadonlyBytes aad, ReadonlyBytes ciphertext, Bytes tag) const;
+
+    u8 m_key[key_size];
+};
+
+}
+
+}
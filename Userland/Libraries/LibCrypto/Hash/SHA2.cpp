@@ -7,8 +7,81 @@
 #include <AK/Types.h>
 #include <LibCrypto/Hash/SHA2.h>
 
+#if defined(__x86_64__) || defined(__i386__)
+#    include <cpuid.h>
+#    include <immintrin.h>
+#endif
+
 namespace Crypto {
 namespace Hash {
+
+#if defined(__x86_64__) || defined(__i386__)
+
+static bool detect_sha_ni()
+{
+    u32 eax, ebx, ecx, edx;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return false;
+    if (!(ebx & bit_SHA))
+        return false;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    return (ecx & bit_SSE4_1) != 0;
+}
+
+static bool const s_has_sha_ni = detect_sha_ni();
+
+// SHA256RNDS2 performs two rounds at a time, but wants the working variables
+// packed as {a,b,e,f} and {c,d,g,h} instead of the FIPS {a..d}/{e..h} order,
+// hence the shuffling on entry and exit.
+[[gnu::target("sha,sse4.1")]] static void sha256_transform_sha_ni(u32* state, const u8* data, size_t block_count)
+{
+    const __m128i byte_swap_mask = _mm_set_epi64x(0x0c0d0e0f08090a0b, 0x0405060700010203);
+
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[0]), 0xB1); // CDAB
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[4]), 0x1B); // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8); // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);      // CDGH
+
+    for (size_t block = 0; block < block_count; ++block, data += 64) {
+        auto previous_state0 = state0;
+        auto previous_state1 = state1;
+
+        __m128i message[4];
+        for (size_t i = 0; i < 4; ++i)
+            message[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 16 * i)), byte_swap_mask);
+
+        for (size_t i = 0; i < 16; ++i) {
+            auto k = _mm_loadu_si128((const __m128i*)&SHA256Constants::RoundConstants[4 * i]);
+            auto wk = _mm_add_epi32(message[i % 4], k);
+            state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(wk, 0x0E));
+
+            // Schedule the message words for rounds 16..63 as we go:
+            // W[t] = sigma1(W[t-2]) + W[t-7] + sigma0(W[t-15]) + W[t-16].
+            if (i < 12) {
+                auto w_minus_7 = _mm_alignr_epi8(message[(i + 3) % 4], message[(i + 2) % 4], 4);
+                message[i % 4] = _mm_sha256msg2_epu32(
+                    _mm_add_epi32(_mm_sha256msg1_epu32(message[i % 4], message[(i + 1) % 4]), w_minus_7),
+                    message[(i + 3) % 4]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, previous_state0);
+        state1 = _mm_add_epi32(state1, previous_state1);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);     // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);  // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0); // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);  // HGFE
+
+    _mm_storeu_si128((__m128i*)&state[0], state0);
+    _mm_storeu_si128((__m128i*)&state[4], state1);
+}
+
+#endif
+
 constexpr static auto ROTRIGHT(u32 a, size_t b) { return (a >> b) | (a << (32 - b)); }
 constexpr static auto CH(u32 x, u32 y, u32 z) { return (x & y) ^ (z & ~x); }
 constexpr static auto MAJ(u32 x, u32 y, u32 z) { return (x & y) ^ (x & z) ^ (y & z); }
@@ -25,56 +98,84 @@ constexpr static auto EP1(u64 x) { return ROTRIGHT(x, 14) ^ ROTRIGHT(x, 18) ^ RO
 constexpr static auto SIGN0(u64 x) { return ROTRIGHT(x, 1) ^ ROTRIGHT(x, 8) ^ (x >> 7); }
 constexpr static auto SIGN1(u64 x) { return ROTRIGHT(x, 19) ^ ROTRIGHT(x, 61) ^ (x >> 6); }
 
-inline void SHA256::transform(const u8* data)
+inline void SHA256::transform(const u8* data, size_t block_count)
 {
-    u32 m[64];
-
-    size_t i = 0;
-    for (size_t j = 0; i < 16; ++i, j += 4) {
-        m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | data[j + 3];
+#if defined(__x86_64__) || defined(__i386__)
+    if (s_has_sha_ni) {
+        sha256_transform_sha_ni(m_state, data, block_count);
+        return;
     }
+#endif
 
-    for (; i < BlockSize; ++i) {
-        m[i] = SIGN1(m[i - 2]) + m[i - 7] + SIGN0(m[i - 15]) + m[i - 16];
-    }
+    for (size_t block = 0; block < block_count; ++block, data += BlockSize) {
+        u32 m[64];
 
-    auto a = m_state[0], b = m_state[1],
-         c = m_state[2], d = m_state[3],
-         e = m_state[4], f = m_state[5],
-         g = m_state[6], h = m_state[7];
+        size_t i = 0;
+        for (size_t j = 0; i < 16; ++i, j += 4) {
+            m[i] = (data[j] << 24) | (data[j + 1] << 16) | (data[j + 2] << 8) | data[j + 3];
+        }
 
-    for (size_t i = 0; i < Rounds; ++i) {
-        auto temp0 = h + EP1(e) + CH(e, f, g) + SHA256Constants::RoundConstants[i] + m[i];
-        auto temp1 = EP0(a) + MAJ(a, b, c);
-        h = g;
-        g = f;
-        f = e;
-        e = d + temp0;
-        d = c;
-        c = b;
-        b = a;
-        a = temp0 + temp1;
-    }
+        for (; i < BlockSize; ++i) {
+            m[i] = SIGN1(m[i - 2]) + m[i - 7] + SIGN0(m[i - 15]) + m[i - 16];
+        }
 
-    m_state[0] += a;
-    m_state[1] += b;
-    m_state[2] += c;
-    m_state[3] += d;
-    m_state[4] += e;
-    m_state[5] += f;
-    m_state[6] += g;
-    m_state[7] += h;
+        auto a = m_state[0], b = m_state[1],
+             c = m_state[2], d = m_state[3],
+             e = m_state[4], f = m_state[5],
+             g = m_state[6], h = m_state[7];
+
+        for (size_t i = 0; i < Rounds; ++i) {
+            auto temp0 = h + EP1(e) + CH(e, f, g) + SHA256Constants::RoundConstants[i] + m[i];
+            auto temp1 = EP0(a) + MAJ(a, b, c);
+            h = g;
+            g = f;
+            f = e;
+            e = d + temp0;
+            d = c;
+            c = b;
+            b = a;
+            a = temp0 + temp1;
+        }
+
+        m_state[0] += a;
+        m_state[1] += b;
+        m_state[2] += c;
+        m_state[3] += d;
+        m_state[4] += e;
+        m_state[5] += f;
+        m_state[6] += g;
+        m_state[7] += h;
+    }
 }
 
 void SHA256::update(const u8* message, size_t length)
 {
-    for (size_t i = 0; i < length; ++i) {
-        if (m_data_length == BlockSize) {
-            transform(m_data_buffer);
+    // Top up (and possibly flush) a previously buffered partial block first.
+    if (m_data_length) {
+        auto chunk = min(length, BlockSize - m_data_length);
+        __builtin_memcpy(&m_data_buffer[m_data_length], message, chunk);
+        m_data_length += chunk;
+        message += chunk;
+        length -= chunk;
+        if (m_data_length == BlockSize && length) {
+            transform(m_data_buffer, 1);
             m_bit_length += 512;
             m_data_length = 0;
         }
-        m_data_buffer[m_data_length++] = message[i];
+    }
+
+    // Hash whole blocks straight out of the caller's buffer, all in one go.
+    auto block_count = length / BlockSize;
+    if (block_count) {
+        transform(message, block_count);
+        m_bit_length += block_count * 512;
+        message += block_count * BlockSize;
+        length -= block_count * BlockSize;
+    }
+
+    if (length) {
+        __builtin_memcpy(m_data_buffer, message, length);
+        m_data_length = length;
     }
 }
 
@@ -91,7 +192,7 @@ SHA256::DigestType SHA256::peek()
     size_t i = m_data_length;
 
     if (BlockSize == m_data_length) {
-        transform(m_data_buffer);
+        transform(m_data_buffer, 1);
         m_bit_length += BlockSize * 8;
         m_data_length = 0;
         i = 0;
@@ -107,7 +208,7 @@ SHA256::DigestType SHA256::peek()
         m_data_buffer[i++] = 0x80;
         while (i < BlockSize)
             m_data_buffer[i++] = 0x00;
-        transform(m_data_buffer);
+        transform(m_data_buffer, 1);
 
         // Then start another block with BlockSize - 8 bytes of zeros
         __builtin_memset(m_data_buffer, 0, FinalBlockDataSize);
@@ -124,7 +225,7 @@ SHA256::DigestType SHA256::peek()
     m_data_buffer[BlockSize - 7] = m_bit_length >> 48;
     m_data_buffer[BlockSize - 8] = m_bit_length >> 56;
 
-    transform(m_data_buffer);
+    transform(m_data_buffer, 1);
 
     // SHA uses big-endian and we assume little-endian
     // FIXME: looks like a thing for AK::NetworkOrdered,
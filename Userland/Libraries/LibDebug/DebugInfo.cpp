@@ -5,6 +5,7 @@
  */
 
 #include "DebugInfo.h"
+#include "DebugInfoCache.h"
 #include <AK/Debug.h>
 #include <AK/LexicalPath.h>
 #include <AK/MemoryStream.h>
@@ -15,12 +16,25 @@
 
 namespace Debug {
 
-DebugInfo::DebugInfo(ELF::Image const& elf, String source_root, FlatPtr base_address)
+DebugInfo::DebugInfo(ELF::Image const& elf, String source_root, FlatPtr base_address, String elf_path)
     : m_elf(elf)
     , m_source_root(move(source_root))
     , m_base_address(base_address)
+    , m_elf_path(move(elf_path))
     , m_dwarf_info(m_elf)
 {
+    if (!m_elf_path.is_empty()) {
+        // If we've indexed this binary before, load the index from disk and
+        // skip the DWARF parse entirely.
+        auto cache_path = DebugInfoCache::path_for_binary(m_elf_path);
+        if (DebugInfoCache::load(cache_path, m_elf_path, m_source_root, m_sorted_lines, m_scopes))
+            return;
+        prepare_variable_scopes();
+        prepare_lines();
+        DebugInfoCache::save(cache_path, m_elf_path, m_source_root, m_sorted_lines, m_scopes);
+        return;
+    }
+
     prepare_variable_scopes();
     prepare_lines();
 }
@@ -68,7 +82,7 @@ void DebugInfo::parse_scopes_impl(Dwarf::DIE const& die)
             if (!(variable_entry.tag() == Dwarf::EntryTag::Variable
                     || variable_entry.tag() == Dwarf::EntryTag::FormalParameter))
                 return;
-            scope.dies_of_variables.append(variable_entry);
+            scope.die_offsets_of_variables.append(variable_entry.offset());
         });
         m_scopes.append(scope);
 
@@ -117,13 +131,20 @@ Optional<DebugInfo::SourcePosition> DebugInfo::get_source_position(FlatPtr targe
     if (target_address < m_sorted_lines[0].address)
         return {};
 
-    // TODO: We can do a binary search here
-    for (size_t i = 0; i < m_sorted_lines.size() - 1; ++i) {
-        if (m_sorted_lines[i + 1].address > target_address) {
-            return SourcePosition::from_line_info(m_sorted_lines[i]);
-        }
+    // Binary search for the first entry whose address is above the target;
+    // the entry just before it covers the target address.
+    size_t low = 0;
+    size_t high = m_sorted_lines.size();
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (m_sorted_lines[mid].address > target_address)
+            high = mid;
+        else
+            low = mid + 1;
     }
-    return {};
+    if (low == 0 || low == m_sorted_lines.size())
+        return {};
+    return SourcePosition::from_line_info(m_sorted_lines[low - 1]);
 }
 
 Optional<DebugInfo::SourcePositionAndAddress> DebugInfo::get_address_from_source_position(String const& file, size_t line) const
@@ -171,8 +192,11 @@ NonnullOwnPtrVector<DebugInfo::VariableInfo> DebugInfo::get_variables_in_current
         if (ip - m_base_address < scope.address_low || ip - m_base_address >= scope.address_high)
             continue;
 
-        for (const auto& die_entry : scope.dies_of_variables) {
-            auto variable_info = create_variable_info(die_entry, regs);
+        for (auto die_offset : scope.die_offsets_of_variables) {
+            auto die_entry = m_dwarf_info.get_die_at_offset(die_offset);
+            if (!die_entry.has_value())
+                continue;
+            auto variable_info = create_variable_info(die_entry.value(), regs);
             if (!variable_info)
                 continue;
             variables.append(variable_info.release_nonnull());
@@ -24,7 +24,10 @@ class DebugInfo {
     AK_MAKE_NONMOVABLE(DebugInfo);
 
 public:
-    explicit DebugInfo(ELF::Image const&, String source_root = {}, FlatPtr base_address = 0);
+    // If elf_path is given, the line table and variable scope index are
+    // cached on disk and reloaded on subsequent runs, skipping the DWARF
+    // parse entirely.
+    explicit DebugInfo(ELF::Image const&, String source_root = {}, FlatPtr base_address = 0, String elf_path = {});
 
     ELF::Image const& elf() const { return m_elf; }
 
@@ -88,7 +91,10 @@ public:
         String name;
         FlatPtr address_low { 0 };
         FlatPtr address_high { 0 }; // Non-inclusive - the lowest address after address_low that's not in this scope
-        Vector<Dwarf::DIE> dies_of_variables;
+        // Offsets into .debug_info rather than DIE objects, so scopes can be
+        // serialized to the on-disk index. The DIEs are only materialized if
+        // variables are actually inspected.
+        Vector<FlatPtr> die_offsets_of_variables;
     };
 
     NonnullOwnPtrVector<VariableInfo> get_variables_in_current_scope(PtraceRegisters const&) const;
@@ -127,6 +133,7 @@ private:
     ELF::Image const& m_elf;
     String m_source_root;
     FlatPtr m_base_address { 0 };
+    String m_elf_path;
     Dwarf::DwarfInfo m_dwarf_info;
 
     Vector<VariablesScope> m_scopes;
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/LexicalPath.h>
+#include <AK/ScopeGuard.h>
+#include <AK/StringHash.h>
+#include <LibDebug/DebugInfoCache.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Debug {
+
+static constexpr u32 cache_magic = 0x44424743; // "DBGC"
+static constexpr u32 cache_version = 1;
+static constexpr const char* cache_directory = "/tmp/.debug-info-cache";
+
+String DebugInfoCache::path_for_binary(String const& binary_path)
+{
+    // Keyed by the full binary path; the hash keeps same-named binaries apart.
+    return String::formatted("{}/{}-{:08x}", cache_directory, LexicalPath::basename(binary_path), string_hash(binary_path.characters(), binary_path.length()));
+}
+
+static u32 hash_of_source_root(String const& source_root)
+{
+    if (source_root.is_null())
+        return 0;
+    return string_hash(source_root.characters(), source_root.length());
+}
+
+bool DebugInfoCache::load(String const& cache_path, String const& binary_path, String const& source_root,
+    Vector<Dwarf::LineProgram::LineInfo>& sorted_lines, Vector<DebugInfo::VariablesScope>& scopes)
+{
+    struct stat binary_st;
+    if (stat(binary_path.characters(), &binary_st) < 0)
+        return false;
+
+    int fd = ::open(cache_path.characters(), O_RDONLY | O_NOFOLLOW);
+    if (fd < 0)
+        return false;
+    ScopeGuard close_guard = [fd] { close(fd); };
+
+    struct stat st;
+    if (fstat(fd, &st) < 0)
+        return false;
+
+    // Anyone can create files in /tmp, so only trust a cache we would have
+    // written ourselves: a regular file that we own and nobody else can write.
+    if (!S_ISREG(st.st_mode) || st.st_uid != geteuid() || (st.st_mode & 022) != 0)
+        return false;
+
+    if (static_cast<size_t>(st.st_size) < sizeof(Header))
+        return false;
+    auto size = static_cast<size_t>(st.st_size);
+
+    auto* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+        return false;
+    ScopeGuard unmap_guard = [data, size] { munmap(data, size); };
+
+    auto const& header = *reinterpret_cast<const Header*>(data);
+    if (header.magic != cache_magic || header.version != cache_version)
+        return false;
+
+    // The index is only valid for the exact binary it was built from.
+    if (header.binary_device != static_cast<u64>(binary_st.st_dev) || header.binary_inode != static_cast<u64>(binary_st.st_ino))
+        return false;
+    if (header.binary_mtime_seconds != static_cast<u64>(binary_st.st_mtime) || header.binary_size != static_cast<u64>(binary_st.st_size))
+        return false;
+    if (header.source_root_hash != hash_of_source_root(source_root))
+        return false;
+
+    size_t expected_size = sizeof(Header)
+        + header.line_count * sizeof(LineRecord)
+        + header.scope_count * sizeof(ScopeRecord)
+        + header.variable_offset_count * sizeof(u64)
+        + header.string_table_size;
+    if (expected_size != size)
+        return false;
+
+    auto* line_records = reinterpret_cast<const LineRecord*>(static_cast<const u8*>(data) + sizeof(Header));
+    auto* scope_records = reinterpret_cast<const ScopeRecord*>(line_records + header.line_count);
+    auto* variable_offsets = reinterpret_cast<const u64*>(scope_records + header.scope_count);
+    auto* string_table = reinterpret_cast<const char*>(variable_offsets + header.variable_offset_count);
+    if (header.string_table_size == 0 || string_table[header.string_table_size - 1] != '\0')
+        return false;
+
+    auto string_at = [&](u32 offset) -> const char* {
+        if (offset >= header.string_table_size)
+            return nullptr;
+        return string_table + offset;
+    };
+
+    Vector<Dwarf::LineProgram::LineInfo> lines;
+    lines.ensure_capacity(header.line_count);
+    for (u32 i = 0; i < header.line_count; ++i) {
+        auto const& record = line_records[i];
+        auto* file = string_at(record.file_index);
+        if (!file)
+            return false;
+        if (i > 0 && line_records[i - 1].address > record.address)
+            return false;
+        lines.unchecked_append({ static_cast<FlatPtr>(record.address), file, record.line });
+    }
+
+    Vector<DebugInfo::VariablesScope> loaded_scopes;
+    loaded_scopes.ensure_capacity(header.scope_count);
+    for (u32 i = 0; i < header.scope_count; ++i) {
+        auto const& record = scope_records[i];
+        DebugInfo::VariablesScope scope {};
+        scope.is_function = record.is_function != 0;
+        if (record.name_index != invalid_string_index) {
+            auto* name = string_at(record.name_index);
+            if (!name)
+                return false;
+            scope.name = name;
+        }
+        scope.address_low = record.address_low;
+        scope.address_high = record.address_high;
+        if (record.first_variable_index + record.variable_count > header.variable_offset_count)
+            return false;
+        for (u32 variable_index = 0; variable_index < record.variable_count; ++variable_index)
+            scope.die_offsets_of_variables.append(variable_offsets[record.first_variable_index + variable_index]);
+        loaded_scopes.unchecked_append(move(scope));
+    }
+
+    sorted_lines = move(lines);
+    scopes = move(loaded_scopes);
+    return true;
+}
+
+static bool write_fully(int fd, const void* data, size_t size)
+{
+    auto* bytes = static_cast<const u8*>(data);
+    while (size > 0) {
+        ssize_t nwritten = write(fd, bytes, size);
+        if (nwritten < 0)
+            return false;
+        bytes += nwritten;
+        size -= nwritten;
+    }
+    return true;
+}
+
+bool DebugInfoCache::save(String const& cache_path, String const& binary_path, String const& source_root,
+    Vector<Dwarf::LineProgram::LineInfo> const& sorted_lines, Vector<DebugInfo::VariablesScope> const& scopes)
+{
+    struct stat binary_st;
+    if (stat(binary_path.characters(), &binary_st) < 0)
+        return false;
+
+    Vector<char> string_table;
+    HashMap<String, u32> string_offsets;
+    auto add_string = [&](String const& string) -> u32 {
+        if (auto existing = string_offsets.get(string); existing.has_value())
+            return existing.value();
+        u32 offset = string_table.size();
+        string_table.append(string.characters(), string.length() + 1);
+        string_offsets.set(string, offset);
+        return offset;
+    };
+
+    Vector<LineRecord> line_records;
+    line_records.ensure_capacity(sorted_lines.size());
+    for (auto const& line : sorted_lines)
+        line_records.unchecked_append({ line.address, add_string(line.file), static_cast<u32>(line.line) });
+
+    Vector<ScopeRecord> scope_records;
+    Vector<u64> variable_offsets;
+    scope_records.ensure_capacity(scopes.size());
+    for (auto const& scope : scopes) {
+        u32 first_variable_index = variable_offsets.size();
+        for (auto die_offset : scope.die_offsets_of_variables)
+            variable_offsets.append(die_offset);
+        u32 name_index = scope.name.is_null() ? invalid_string_index : add_string(scope.name);
+        scope_records.unchecked_append({ scope.address_low, scope.address_high, name_index, first_variable_index, static_cast<u32>(scope.die_offsets_of_variables.size()), scope.is_function ? 1u : 0u });
+    }
+
+    Header header {
+        cache_magic,
+        cache_version,
+        static_cast<u64>(binary_st.st_dev),
+        static_cast<u64>(binary_st.st_ino),
+        static_cast<u64>(binary_st.st_mtime),
+        static_cast<u64>(binary_st.st_size),
+        hash_of_source_root(source_root),
+        static_cast<u32>(line_records.size()),
+        static_cast<u32>(scope_records.size()),
+        static_cast<u32>(variable_offsets.size()),
+        static_cast<u32>(string_table.size()),
+    };
+
+    if (mkdir(cache_directory, 0755) < 0 && errno != EEXIST)
+        return false;
+
+    // Write to a private temporary file and rename() it into place, so
+    // concurrent launches only ever see complete cache files.
+    auto temporary_path = String::formatted("{}.{}", cache_path, getpid());
+    int fd = ::open(temporary_path.characters(), O_WRONLY | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+        return false;
+
+    bool success = write_fully(fd, &header, sizeof(header))
+        && write_fully(fd, line_records.data(), line_records.size() * sizeof(LineRecord))
+        && write_fully(fd, scope_records.data(), scope_records.size() * sizeof(ScopeRecord))
+        && write_fully(fd, variable_offsets.data(), variable_offsets.size() * sizeof(u64))
+        && write_fully(fd, string_table.data(), string_table.size());
+    close(fd);
+
+    if (success && rename(temporary_path.characters(), cache_path.characters()) == 0)
+        return true;
+
+    unlink(temporary_path.characters());
+    return false;
+}
+
+}
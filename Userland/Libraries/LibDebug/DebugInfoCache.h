@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibDebug/DebugInfo.h>
+
+namespace Debug {
+
+// A persistent, per-binary index of the parsed DWARF data DebugInfo needs
+// for its common queries: the sorted line table (address -> source position)
+// and the variable scopes (address range -> scope name and variable DIE
+// offsets). Extracting these from .debug_info/.debug_line takes seconds on a
+// large binary; loading the index back is a handful of reads. Scopes store
+// DIE offsets rather than materialized DIEs, so the full DWARF walk only
+// happens if variables are actually inspected.
+class DebugInfoCache {
+public:
+    static String path_for_binary(String const& binary_path);
+
+    // Returns false if the cache is missing or was recorded against a
+    // different binary (identity is device/inode/mtime/size) or source root.
+    // On failure the output vectors are left empty.
+    static bool load(String const& cache_path, String const& binary_path, String const& source_root,
+        Vector<Dwarf::LineProgram::LineInfo>& sorted_lines, Vector<DebugInfo::VariablesScope>& scopes);
+
+    static bool save(String const& cache_path, String const& binary_path, String const& source_root,
+        Vector<Dwarf::LineProgram::LineInfo> const& sorted_lines, Vector<DebugInfo::VariablesScope> const& scopes);
+
+private:
+    // On-disk layout: Header, then line_count LineRecords sorted by address,
+    // then scope_count ScopeRecords, then variable_offset_count u64 DIE
+    // offsets, then the string table. String indices are byte offsets into
+    // the string table; invalid_string_index means "no string".
+    struct Header {
+        u32 magic;
+        u32 version;
+        u64 binary_device;
+        u64 binary_inode;
+        u64 binary_mtime_seconds;
+        u64 binary_size;
+        u32 source_root_hash;
+        u32 line_count;
+        u32 scope_count;
+        u32 variable_offset_count;
+        u32 string_table_size;
+    };
+
+    struct LineRecord {
+        u64 address;
+        u32 file_index;
+        u32 line;
+    };
+
+    struct ScopeRecord {
+        u64 address_low;
+        u64 address_high;
+        u32 name_index;
+        u32 first_variable_index;
+        u32 variable_count;
+        u32 is_function;
+    };
+
+    static constexpr u32 invalid_string_index = 0xffffffff;
+};
+
+}
@@ -449,7 +449,7 @@ void DebugSession::update_loaded_libs()
 
         FlatPtr base_address = entry.as_object().get("address").to_addr();
         auto image = make<ELF::Image>(file_or_error.value()->bytes());
-        auto debug_info = make<DebugInfo>(*image, m_source_root, base_address);
+        auto debug_info = make<DebugInfo>(*image, m_source_root, base_address, object_path.value());
         auto lib = make<LoadedLibrary>(lib_name, file_or_error.release_value(), move(image), move(debug_info), base_address);
         m_loaded_libraries.set(lib_name, move(lib));
 
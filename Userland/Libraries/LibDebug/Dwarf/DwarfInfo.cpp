@@ -21,8 +21,6 @@ DwarfInfo::DwarfInfo(ELF::Image const& elf)
     m_debug_strings_data = section_data(".debug_str"sv);
     m_debug_line_data = section_data(".debug_line"sv);
     m_debug_line_strings_data = section_data(".debug_line_str"sv);
-
-    populate_compilation_units();
 }
 
 ReadonlyBytes DwarfInfo::section_data(StringView const& section_name) const
@@ -33,7 +31,15 @@ ReadonlyBytes DwarfInfo::section_data(StringView const& section_name) const
     return section->bytes();
 }
 
-void DwarfInfo::populate_compilation_units()
+void DwarfInfo::ensure_compilation_units() const
+{
+    if (m_populated_compilation_units)
+        return;
+    m_populated_compilation_units = true;
+    populate_compilation_units();
+}
+
+void DwarfInfo::populate_compilation_units() const
 {
     if (!m_debug_info_data.data())
         return;
@@ -307,6 +313,16 @@ Optional<DIE> DwarfInfo::get_die_at_address(FlatPtr address) const
     return iter->die;
 }
 
+Optional<DIE> DwarfInfo::get_die_at_offset(FlatPtr offset) const
+{
+    ensure_compilation_units();
+    for (auto const& unit : m_compilation_units) {
+        if (offset >= unit.offset() && offset < unit.offset() + unit.size())
+            return unit.get_die_at_offset(offset);
+    }
+    return {};
+}
+
 Optional<DIE> DwarfInfo::get_cached_die_at_offset(FlatPtr offset) const
 {
     if (!m_built_cached_dies)
@@ -46,8 +46,15 @@ public:
     // use CompilationUnit::get_die_at_offset.
     Optional<DIE> get_cached_die_at_offset(FlatPtr) const;
 
+    // Returns the DIE at the given offset in .debug_info, regardless of
+    // whether it has an address range. Unlike get_cached_die_at_offset, this
+    // does not build the DIE cache - it only locates the containing
+    // compilation unit.
+    Optional<DIE> get_die_at_offset(FlatPtr) const;
+
 private:
-    void populate_compilation_units();
+    void ensure_compilation_units() const;
+    void populate_compilation_units() const;
     void build_cached_dies() const;
 
     ReadonlyBytes section_data(StringView const& section_name) const;
@@ -59,7 +66,10 @@ private:
     ReadonlyBytes m_debug_line_data;
     ReadonlyBytes m_debug_line_strings_data;
 
-    NonnullOwnPtrVector<Dwarf::CompilationUnit> m_compilation_units;
+    // Compilation units (and their line programs) are parsed lazily, so that
+    // consumers with an on-disk index never pay for walking .debug_info.
+    mutable NonnullOwnPtrVector<Dwarf::CompilationUnit> m_compilation_units;
+    mutable bool m_populated_compilation_units { false };
 
     struct DIERange {
         FlatPtr start_address { 0 };
@@ -81,6 +91,7 @@ private:
 template<typename Callback>
 void DwarfInfo::for_each_compilation_unit(Callback callback) const
 {
+    ensure_compilation_units();
     for (const auto& unit : m_compilation_units) {
         callback(unit);
     }
@@ -12,7 +12,7 @@
 
 namespace Debug::Dwarf {
 
-LineProgram::LineProgram(DwarfInfo& dwarf_info, InputMemoryStream& stream)
+LineProgram::LineProgram(DwarfInfo const& dwarf_info, InputMemoryStream& stream)
     : m_dwarf_info(dwarf_info)
     , m_stream(stream)
 {
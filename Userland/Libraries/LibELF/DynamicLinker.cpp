@@ -16,6 +16,7 @@
 #include <AK/Vector.h>
 #include <LibC/bits/pthread_integration.h>
 #include <LibC/link.h>
+#include <LibC/serenity.h>
 #include <LibC/sys/mman.h>
 #include <LibC/unistd.h>
 #include <LibDl/dlfcn.h>
@@ -25,8 +26,10 @@
 #include <LibELF/DynamicLoader.h>
 #include <LibELF/DynamicObject.h>
 #include <LibELF/Hashes.h>
+#include <LibELF/SymbolResolutionCache.h>
 #include <fcntl.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <syscall.h>
 
@@ -53,14 +56,73 @@ static __pthread_mutex_t s_loader_lock = __PTHREAD_MUTEX_INITIALIZER;
 static bool s_allowed_to_check_environment_variables { false };
 static bool s_do_breakpoint_trap_before_entry { false };
 
+static SymbolResolutionCache s_symbol_cache;
+static String s_symbol_cache_path;
+static bool s_symbol_cache_disabled { false };
+
+static void emit_startup_signpost(StringView phase)
+{
+    // These phase markers end up in the process's performance event stream,
+    // where Profiler and `startup-time` can correlate them with the exec
+    // timestamp. sys$perf_event only records anything while the process is
+    // being profiled, so they are practically free otherwise.
+    auto string_id = perf_register_string(phase.characters_without_null_termination(), phase.length());
+    if (string_id >= 0)
+        perf_event(PERF_EVENT_SIGNPOST, string_id, 0);
+}
+static Vector<SymbolResolutionCache::LibraryIdentity> s_library_inventory;
+static Vector<const DynamicObject*> s_symbol_cache_objects;
+
 static Result<void, DlErrorMessage> __dlclose(void* handle);
 static Result<void*, DlErrorMessage> __dlopen(const char* filename, int flags);
 static Result<void*, DlErrorMessage> __dlsym(void* handle, const char* symbol_name);
 static Result<void, DlErrorMessage> __dladdr(void* addr, Dl_info* info);
+static String get_library_name(String path);
+
+static const DynamicObject* object_for_cached_library(u32 index)
+{
+    if (s_symbol_cache_objects.is_empty())
+        s_symbol_cache_objects.resize(s_library_inventory.size());
+
+    auto const*& object = s_symbol_cache_objects[index];
+    if (!object) {
+        auto entry = s_global_objects.get(get_library_name(s_symbol_cache.library_name(index)));
+        if (entry.has_value())
+            object = entry.value();
+    }
+    return object;
+}
+
+static void record_symbol_resolution(const StringView& name, const Optional<DynamicObject::SymbolLookupResult>& result)
+{
+    if (!result.has_value()) {
+        s_symbol_cache.record(name, SymbolResolutionCache::invalid_library_index, 0, 0, 0);
+        return;
+    }
+    auto const& res = result.value();
+    for (size_t i = 0; i < s_library_inventory.size(); ++i) {
+        if (s_library_inventory[i].name == res.dynamic_object->filename()) {
+            s_symbol_cache.record(name, i, res.value, res.size, res.bind);
+            return;
+        }
+    }
+    // Defined by an object that isn't part of the startup library set
+    // (e.g. brought in via dlopen()) - not cacheable.
+}
 
 Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol(const StringView& name)
 {
+    if (auto cached = s_symbol_cache.lookup(name); cached.has_value()) {
+        if (cached->library_index == SymbolResolutionCache::invalid_library_index)
+            return {};
+        if (auto const* object = object_for_cached_library(cached->library_index)) {
+            auto address = object->elf_is_dynamic() ? object->base_address().offset(cached->value) : VirtualAddress { cached->value };
+            return DynamicObject::SymbolLookupResult { cached->value, cached->size, address, cached->bind, object };
+        }
+    }
+
     Optional<DynamicObject::SymbolLookupResult> weak_result;
+    Optional<DynamicObject::SymbolLookupResult> result;
 
     auto symbol = DynamicObject::HashSymbol { name };
 
@@ -68,13 +130,21 @@ Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol(
         auto res = lib.value->lookup_symbol(symbol);
         if (!res.has_value())
             continue;
-        if (res.value().bind == STB_GLOBAL)
-            return res;
+        if (res.value().bind == STB_GLOBAL) {
+            result = res;
+            break;
+        }
         if (res.value().bind == STB_WEAK && !weak_result.has_value())
             weak_result = res;
         // We don't want to allow local symbols to be pulled in to other modules
     }
-    return weak_result;
+    if (!result.has_value())
+        result = weak_result;
+
+    if (s_symbol_cache.is_recording())
+        record_symbol_resolution(name, result);
+
+    return result;
 }
 
 static String get_library_name(String path)
@@ -93,6 +163,15 @@ static Result<NonnullRefPtr<DynamicLoader>, DlErrorMessage> map_library(const St
 
     s_loaders.set(get_library_name(filename), *loader);
 
+    struct stat st;
+    if (fstat(fd, &st) == 0) {
+        s_library_inventory.append({ filename, (u64)st.st_dev, (u64)st.st_ino, (u64)st.st_mtime, (u32)st.st_size });
+    } else {
+        // Without a trustworthy identity for every library we can neither
+        // validate nor write a symbol resolution cache.
+        s_symbol_cache_disabled = true;
+    }
+
     s_current_tls_offset -= loader->tls_size_of_current_object();
     loader->set_tls_offset(s_current_tls_offset);
 
@@ -375,8 +454,7 @@ static Optional<DlErrorMessage> verify_tls_for_dlopen(const DynamicLoader& loade
 
 static Result<void*, DlErrorMessage> __dlopen(const char* filename, int flags)
 {
-    // FIXME: RTLD_NOW and RTLD_LOCAL are not supported
-    flags &= ~RTLD_NOW;
+    // FIXME: RTLD_LOCAL is not supported
     flags |= RTLD_LAZY;
     flags &= ~RTLD_LOCAL;
     flags |= RTLD_GLOBAL;
@@ -421,6 +499,10 @@ static Result<void*, DlErrorMessage> __dlopen(const char* filename, int flags)
     if (!object.has_value())
         return DlErrorMessage { "Could not load ELF object." };
 
+    // A symbol the cache recorded as unresolvable may now be defined by the
+    // newly loaded object (or its dependencies).
+    s_symbol_cache.invalidate_negative_entries();
+
     // It's up to the caller to release the ref with dlclose().
     object.value()->ref();
     return *object;
@@ -494,6 +576,14 @@ static void read_environment_variables()
         if (StringView { *env } == "_LOADER_BREAKPOINT=1"sv) {
             s_do_breakpoint_trap_before_entry = true;
         }
+        if (StringView { *env } == "LD_BIND_NOW=1"sv) {
+            // Hardening opt-out from lazy binding: resolve all PLT entries
+            // up front so the GOT can't be used as a write target later.
+            DynamicLoader::set_bind_now(true);
+        }
+        if (StringView { *env } == "LOADER_DISABLE_SYMBOL_CACHE=1"sv) {
+            s_symbol_cache_disabled = true;
+        }
     }
 }
 
@@ -501,6 +591,8 @@ void ELF::DynamicLinker::linker_main(String&& main_program_name, int main_progra
 {
     s_envp = envp;
 
+    emit_startup_signpost("Loader: entered linker_main"sv);
+
     s_allowed_to_check_environment_variables = !is_secure;
     if (s_allowed_to_check_environment_variables)
         read_environment_variables();
@@ -533,6 +625,25 @@ void ELF::DynamicLinker::linker_main(String&& main_program_name, int main_progra
 
     allocate_tls();
 
+    emit_startup_signpost("Loader: all dependencies mapped"sv);
+
+    if (s_allowed_to_check_environment_variables && !s_symbol_cache_disabled) {
+        s_symbol_cache_path = SymbolResolutionCache::path_for_program(main_program_name);
+        if (!s_symbol_cache.open(s_symbol_cache_path, s_library_inventory)) {
+            // No usable cache for this program and library set yet: record
+            // this run's resolutions, and bind eagerly so PLT symbols get
+            // resolved (and recorded) now instead of lazily after the cache
+            // has already been written out.
+            s_symbol_cache.start_recording();
+            DynamicLoader::set_bind_now(true);
+        }
+        dbgln_if(DYNAMIC_LOAD_DEBUG, "symbol resolution cache {} is {}", s_symbol_cache_path, s_symbol_cache.is_usable() ? "usable" : "being recorded");
+    }
+
+    // If a global constructor dlopen()s, the library set grows past this
+    // point, and a cache recorded against it would never validate again.
+    auto library_count_before_initializers = s_library_inventory.size();
+
     auto entry_point_function = [&main_program_name] {
         auto library_name = get_library_name(main_program_name);
         auto result = load_main_library(library_name, RTLD_GLOBAL | RTLD_LAZY);
@@ -547,6 +658,11 @@ void ELF::DynamicLinker::linker_main(String&& main_program_name, int main_progra
         return (EntryPointFunction)(entry_point.as_ptr());
     }();
 
+    emit_startup_signpost("Loader: relocations and initializers done"sv);
+
+    if (s_symbol_cache.is_recording() && s_library_inventory.size() == library_count_before_initializers)
+        s_symbol_cache.save(s_symbol_cache_path, s_library_inventory);
+
     s_loaders.clear();
 
     int rc = syscall(SC_msyscall, nullptr);
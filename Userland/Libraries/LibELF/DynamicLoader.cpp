@@ -155,10 +155,19 @@ bool DynamicLoader::link(unsigned flags)
     return load_stage_2(flags);
 }
 
+static bool s_always_bind_now { false };
+
+void DynamicLoader::set_bind_now(bool bind_now)
+{
+    s_always_bind_now = bind_now;
+}
+
 bool DynamicLoader::load_stage_2(unsigned flags)
 {
     VERIFY(flags & RTLD_GLOBAL);
 
+    m_bind_now = s_always_bind_now || (flags & RTLD_NOW) || m_dynamic_object->must_bind_now();
+
     if (m_dynamic_object->has_text_relocations()) {
         for (auto& text_segment : m_text_segments) {
             VERIFY(text_segment.address().get() != 0);
@@ -183,6 +192,8 @@ bool DynamicLoader::load_stage_2(unsigned flags)
 
 void DynamicLoader::do_main_relocations()
 {
+    do_relr_relocations();
+
     auto do_single_relocation = [&](const ELF::DynamicObject::Relocation& relocation) {
         switch (do_relocation(relocation, ShouldInitializeWeak::No)) {
         case RelocationResult::Failed:
@@ -195,14 +206,41 @@ void DynamicLoader::do_main_relocations()
             break;
         }
     };
-    m_dynamic_object->relocation_section().for_each_relocation(do_single_relocation);
+
+    // Relative relocations are ~90% of the table, and applying one is just
+    // an add of the load base, so patch them in this tight loop instead of
+    // sending each through the general do_relocation() switch.
+    auto base_address = m_dynamic_object->base_address().get();
+    m_dynamic_object->relocation_section().for_each_relocation([&](const ELF::DynamicObject::Relocation& relocation) {
+#if ARCH(I386)
+        if (relocation.type() == R_386_RELATIVE) {
+#else
+        if (relocation.type() == R_X86_64_RELATIVE) {
+#endif
+            auto* patch_ptr = is_dynamic() ? (FlatPtr*)(base_address + relocation.offset()) : (FlatPtr*)(FlatPtr)relocation.offset();
+            if (relocation.addend_used())
+                *patch_ptr = base_address + relocation.addend();
+            else
+                *patch_ptr += base_address;
+            return;
+        }
+        do_single_relocation(relocation);
+    });
     m_dynamic_object->plt_relocation_section().for_each_relocation(do_single_relocation);
 }
 
+void DynamicLoader::do_relr_relocations()
+{
+    auto base_address = m_dynamic_object->base_address().get();
+    m_dynamic_object->for_each_relr_relocation([base_address](FlatPtr offset) {
+        *(FlatPtr*)(base_address + offset) += base_address;
+    });
+}
+
 Result<NonnullRefPtr<DynamicObject>, DlErrorMessage> DynamicLoader::load_stage_3(unsigned flags)
 {
     do_lazy_relocations();
-    if (flags & RTLD_LAZY) {
+    if ((flags & RTLD_LAZY) && !m_bind_now) {
         if (m_dynamic_object->has_plt())
             setup_plt_trampoline();
     }
@@ -509,8 +547,7 @@ DynamicLoader::RelocationResult DynamicLoader::do_relocation(const ELF::DynamicO
 #else
     case R_X86_64_JUMP_SLOT: {
 #endif
-        // FIXME: Or BIND_NOW flag passed in?
-        if (m_dynamic_object->must_bind_now()) {
+        if (m_bind_now) {
             // Eagerly BIND_NOW the PLT entries, doing all the symbol looking goodness
             // The patch method returns the address for the LAZY fixup path, but we don't need it here
             m_dynamic_object->patch_plt_entry(relocation.offset_in_section());
@@ -65,6 +65,10 @@ public:
     // Stage 4 of loading: initializers
     void load_stage_4();
 
+    // LD_BIND_NOW-style hardening: resolve every PLT entry eagerly instead of
+    // lazily binding on first call. Applies to all objects loaded afterwards.
+    static void set_bind_now(bool);
+
     void set_tls_offset(size_t offset) { m_tls_offset = offset; };
     size_t tls_size_of_current_object() const { return m_tls_size_of_current_object; }
     size_t tls_offset() const { return m_tls_offset; }
@@ -114,6 +118,7 @@ private:
 
     // Stage 2
     void do_main_relocations();
+    void do_relr_relocations();
 
     // Stage 3
     void do_lazy_relocations();
@@ -140,6 +145,7 @@ private:
     void* m_file_data { nullptr };
     ELF::Image m_elf_image;
     bool m_valid { true };
+    bool m_bind_now { false };
 
     RefPtr<DynamicObject> m_dynamic_object;
 
@@ -137,6 +137,15 @@ void DynamicObject::parse()
         case DT_RELCOUNT:
             m_number_of_relocations = entry.val();
             break;
+        case DT_RELR:
+            m_relr_relocation_table_offset = entry.ptr() - (FlatPtr)m_elf_base_address.as_ptr();
+            break;
+        case DT_RELRSZ:
+            m_size_of_relr_relocation_table = entry.val();
+            break;
+        case DT_RELRENT:
+            VERIFY(entry.val() == sizeof(ElfW(Relr)));
+            break;
         case DT_FLAGS:
             m_dt_flags = entry.val();
             break;
@@ -234,6 +243,11 @@ DynamicObject::RelocationSection DynamicObject::relocation_section() const
     return RelocationSection(Section(*this, m_relocation_table_offset, m_size_of_relocation_table, m_size_of_relocation_entry, "DT_REL"sv), m_addend_used);
 }
 
+DynamicObject::Section DynamicObject::relr_relocation_section() const
+{
+    return Section(*this, m_relr_relocation_table_offset, m_size_of_relr_relocation_table, sizeof(ElfW(Relr)), "DT_RELR"sv);
+}
+
 DynamicObject::RelocationSection DynamicObject::plt_relocation_section() const
 {
     return RelocationSection(Section(*this, m_plt_relocation_offset_location, m_size_of_plt_relocation_entry_list, m_size_of_relocation_entry, "DT_JMPREL"sv), false);
@@ -408,6 +422,12 @@ static const char* name_for_dtag(ElfW(Sword) d_tag)
         return "PREINIT_ARRAY"; /* address of array of preinit func */
     case DT_PREINIT_ARRAYSZ:
         return "PREINIT_ARRAYSZ"; /* size of array of preinit func */
+    case DT_RELRSZ:
+        return "RELRSZ"; /* size of DT_RELR relocation table */
+    case DT_RELR:
+        return "RELR"; /* address of relative relocation table */
+    case DT_RELRENT:
+        return "RELRENT"; /* size of DT_RELR relocation entry */
     case DT_LOOS:
         return "LOOS"; /* reserved range for OS */
     case DT_HIOS:
@@ -271,6 +271,13 @@ public:
 
     RelocationSection relocation_section() const;
     RelocationSection plt_relocation_section() const;
+    Section relr_relocation_section() const;
+
+    // Walks the compact DT_RELR table and calls the callback with the offset
+    // (relative to the base address) of every word that needs the load base
+    // added to it.
+    template<VoidFunction<FlatPtr> F>
+    void for_each_relr_relocation(F) const;
 
     bool should_process_origin() const { return m_dt_flags & DF_ORIGIN; }
     bool requires_symbolic_symbol_resolution() const { return m_dt_flags & DF_SYMBOLIC; }
@@ -373,6 +380,8 @@ private:
     size_t m_size_of_relocation_table { 0 };
     bool m_addend_used { false };
     FlatPtr m_relocation_table_offset { 0 };
+    FlatPtr m_relr_relocation_table_offset { 0 };
+    size_t m_size_of_relr_relocation_table { 0 };
     bool m_is_elf_dynamic { false };
 
     // DT_FLAGS
@@ -411,6 +420,29 @@ inline void DynamicObject::RelocationSection::for_each_relocation(F func) const
     });
 }
 
+template<VoidFunction<FlatPtr> F>
+inline void DynamicObject::for_each_relr_relocation(F func) const
+{
+    auto section = relr_relocation_section();
+    auto* entries = reinterpret_cast<const ElfW(Relr)*>(section.address().as_ptr());
+    FlatPtr current_offset = 0;
+    for (unsigned i = 0; i < section.entry_count(); ++i) {
+        auto entry = entries[i];
+        if ((entry & 1) == 0) {
+            // Even entry: the offset of the next word to patch.
+            func(entry);
+            current_offset = entry + sizeof(FlatPtr);
+        } else {
+            // Odd entry: a bitmap of which of the following words to patch.
+            for (unsigned bit = 0; (entry >>= 1) != 0; ++bit) {
+                if (entry & 1)
+                    func(current_offset + bit * sizeof(FlatPtr));
+            }
+            current_offset += (8 * sizeof(FlatPtr) - 1) * sizeof(FlatPtr);
+        }
+    }
+}
+
 template<VoidFunction<DynamicObject::Symbol&> F>
 inline void DynamicObject::for_each_symbol(F func) const
 {
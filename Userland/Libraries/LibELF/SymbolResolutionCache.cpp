@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
+#include <AK/ScopeGuard.h>
+#include <AK/StringHash.h>
+#include <LibC/sys/mman.h>
+#include <LibC/unistd.h>
+#include <LibELF/SymbolResolutionCache.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+namespace ELF {
+
+static constexpr u32 cache_magic = 0x53594d43; // "SYMC"
+static constexpr u32 cache_version = 1;
+static constexpr const char* cache_directory = "/tmp/.symbol-cache";
+
+String SymbolResolutionCache::path_for_program(const String& main_program_path)
+{
+    // Keyed by the full program path, so each program's symbol working set
+    // gets its own file; the hash keeps same-named programs apart.
+    return String::formatted("{}/{}-{:08x}", cache_directory, LexicalPath::basename(main_program_path), string_hash(main_program_path.characters(), main_program_path.length()));
+}
+
+bool SymbolResolutionCache::open(const String& path, const Vector<LibraryIdentity>& libraries)
+{
+    int fd = ::open(path.characters(), O_RDONLY | O_NOFOLLOW);
+    if (fd < 0)
+        return false;
+    ScopeGuard close_guard = [fd] { close(fd); };
+
+    struct stat st;
+    if (fstat(fd, &st) < 0)
+        return false;
+
+    // Anyone can create files in /tmp, so only trust a cache we would have
+    // written ourselves: a regular file that we own and nobody else can write.
+    if (!S_ISREG(st.st_mode) || st.st_uid != geteuid() || (st.st_mode & 022) != 0)
+        return false;
+
+    if (static_cast<size_t>(st.st_size) < sizeof(Header))
+        return false;
+    auto size = static_cast<size_t>(st.st_size);
+
+    auto* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+        return false;
+    ArmedScopeGuard unmap_guard = [data, size] { munmap(data, size); };
+
+    auto const& header = *reinterpret_cast<const Header*>(data);
+    if (header.magic != cache_magic || header.version != cache_version)
+        return false;
+    if (header.library_count != libraries.size())
+        return false;
+    size_t expected_size = sizeof(Header)
+        + header.library_count * sizeof(LibraryRecord)
+        + header.symbol_count * sizeof(SymbolRecord)
+        + header.string_table_size;
+    if (expected_size != size)
+        return false;
+
+    auto* library_records = reinterpret_cast<const LibraryRecord*>(static_cast<const u8*>(data) + sizeof(Header));
+    auto* symbol_records = reinterpret_cast<const SymbolRecord*>(library_records + header.library_count);
+    auto* string_table = reinterpret_cast<const char*>(symbol_records + header.symbol_count);
+    if (header.string_table_size == 0 || string_table[header.string_table_size - 1] != '\0')
+        return false;
+
+    auto string_at = [&](u32 offset) -> const char* {
+        if (offset >= header.string_table_size)
+            return nullptr;
+        return string_table + offset;
+    };
+
+    Vector<String> library_names;
+    for (size_t i = 0; i < libraries.size(); ++i) {
+        auto const& record = library_records[i];
+        auto const& library = libraries[i];
+        auto* name = string_at(record.name_offset);
+        if (!name || library.name != name)
+            return false;
+        if (record.device != library.device || record.inode != library.inode)
+            return false;
+        if (record.mtime_seconds != library.mtime_seconds || record.file_size != library.file_size)
+            return false;
+        library_names.append(library.name);
+    }
+
+    for (u32 i = 0; i < header.symbol_count; ++i) {
+        auto const& record = symbol_records[i];
+        if (!string_at(record.name_offset))
+            return false;
+        if (record.library_index != invalid_library_index && record.library_index >= header.library_count)
+            return false;
+        if (i > 0 && symbol_records[i - 1].name_hash > record.name_hash)
+            return false;
+    }
+
+    unmap_guard.disarm();
+    m_mapped_file = data;
+    m_mapped_size = size;
+    m_symbols = symbol_records;
+    m_symbol_count = header.symbol_count;
+    m_string_table = string_table;
+    m_library_names = move(library_names);
+    return true;
+}
+
+Optional<SymbolResolutionCache::CachedSymbol> SymbolResolutionCache::lookup(const StringView& name) const
+{
+    if (!is_usable())
+        return {};
+
+    u32 name_hash = string_hash(name.characters_without_null_termination(), name.length());
+
+    size_t low = 0;
+    size_t high = m_symbol_count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (m_symbols[middle].name_hash < name_hash)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    for (size_t i = low; i < m_symbol_count && m_symbols[i].name_hash == name_hash; ++i) {
+        auto const& record = m_symbols[i];
+        if (name != m_string_table + record.name_offset)
+            continue;
+        if (record.library_index == invalid_library_index && !m_negative_entries_usable)
+            return {};
+        return CachedSymbol { record.library_index, record.bind, record.value, record.size };
+    }
+    return {};
+}
+
+void SymbolResolutionCache::record(const StringView& name, u32 library_index, FlatPtr value, FlatPtr size, u32 bind)
+{
+    if (!m_recording)
+        return;
+
+    String name_string { name };
+    if (m_recorded_names.contains(name_string))
+        return;
+    m_recorded_names.set(name_string);
+
+    u32 name_hash = string_hash(name.characters_without_null_termination(), name.length());
+    m_recorded_symbols.append({ move(name_string), name_hash, { library_index, bind, value, size } });
+}
+
+static bool write_fully(int fd, const void* data, size_t size)
+{
+    auto* bytes = static_cast<const u8*>(data);
+    while (size > 0) {
+        ssize_t nwritten = write(fd, bytes, size);
+        if (nwritten < 0)
+            return false;
+        bytes += nwritten;
+        size -= nwritten;
+    }
+    return true;
+}
+
+bool SymbolResolutionCache::save(const String& path, const Vector<LibraryIdentity>& libraries)
+{
+    m_recording = false;
+
+    quick_sort(m_recorded_symbols, [](auto const& a, auto const& b) {
+        if (a.name_hash != b.name_hash)
+            return a.name_hash < b.name_hash;
+        return a.name < b.name;
+    });
+
+    Vector<char> string_table;
+    auto add_string = [&string_table](const String& string) -> u32 {
+        u32 offset = string_table.size();
+        string_table.append(string.characters(), string.length() + 1);
+        return offset;
+    };
+
+    Vector<LibraryRecord> library_records;
+    for (auto const& library : libraries)
+        library_records.append({ add_string(library.name), library.file_size, library.device, library.inode, library.mtime_seconds });
+
+    Vector<SymbolRecord> symbol_records;
+    for (auto const& recorded : m_recorded_symbols)
+        symbol_records.append({ recorded.name_hash, add_string(recorded.name), recorded.symbol.library_index, recorded.symbol.bind, recorded.symbol.value, recorded.symbol.size });
+
+    Header header {
+        cache_magic,
+        cache_version,
+        static_cast<u32>(library_records.size()),
+        static_cast<u32>(symbol_records.size()),
+        static_cast<u32>(string_table.size()),
+    };
+
+    if (mkdir(cache_directory, 0755) < 0 && errno != EEXIST)
+        return false;
+
+    // Write to a private temporary file and rename() it into place, so
+    // concurrent launches only ever see complete cache files.
+    auto temporary_path = String::formatted("{}.{}", path, getpid());
+    int fd = ::open(temporary_path.characters(), O_WRONLY | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+        return false;
+
+    bool success = write_fully(fd, &header, sizeof(header))
+        && write_fully(fd, library_records.data(), library_records.size() * sizeof(LibraryRecord))
+        && write_fully(fd, symbol_records.data(), symbol_records.size() * sizeof(SymbolRecord))
+        && write_fully(fd, string_table.data(), string_table.size());
+    close(fd);
+
+    if (success && rename(temporary_path.characters(), path.characters()) == 0)
+        return true;
+
+    unlink(temporary_path.characters());
+    return false;
+}
+
+} // end namespace ELF
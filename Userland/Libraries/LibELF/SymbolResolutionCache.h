@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashTable.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace ELF {
+
+// A persistent, per-program cache of global symbol resolution results.
+//
+// Every launch of a program redoes the exact same hash section walks against
+// the exact same set of libraries, which dominates exec time for short-lived
+// utilities. On the first launch we record the outcome of every global lookup
+// and persist it to a small file; subsequent launches mmap() that file
+// read-only and answer lookups with a binary search over pre-resolved entries
+// instead of probing every loaded object.
+//
+// Cached values are stored as st_value-style offsets into the defining object,
+// so they remain correct under ASLR. A cache is only used if the identity
+// (device, inode, mtime and size) of every library, in load order, matches
+// what the cache was recorded against.
+class SymbolResolutionCache {
+public:
+    struct LibraryIdentity {
+        String name;
+        u64 device { 0 };
+        u64 inode { 0 };
+        u64 mtime_seconds { 0 };
+        u32 file_size { 0 };
+    };
+
+    // library_index is invalid_library_index for recorded lookup failures.
+    struct CachedSymbol {
+        u32 library_index { 0 };
+        u32 bind { 0 };
+        FlatPtr value { 0 };
+        FlatPtr size { 0 };
+    };
+
+    static constexpr u32 invalid_library_index = 0xffffffff;
+
+    static String path_for_program(const String& main_program_path);
+
+    // Maps the cache file at the given path and validates it against the given
+    // library set. On any mismatch the cache simply stays unusable.
+    bool open(const String& path, const Vector<LibraryIdentity>& libraries);
+    bool is_usable() const { return m_mapped_file != nullptr; }
+
+    Optional<CachedSymbol> lookup(const StringView& name) const;
+    const String& library_name(u32 index) const { return m_library_names[index]; }
+
+    // Once dlopen() has brought in additional objects, a recorded lookup
+    // failure may no longer be one, so stop serving those entries.
+    void invalidate_negative_entries() { m_negative_entries_usable = false; }
+
+    void start_recording() { m_recording = true; }
+    bool is_recording() const { return m_recording; }
+    void record(const StringView& name, u32 library_index, FlatPtr value, FlatPtr size, u32 bind);
+    bool save(const String& path, const Vector<LibraryIdentity>& libraries);
+
+private:
+    // On-disk layout: Header, then library_count LibraryRecords, then
+    // symbol_count SymbolRecords sorted by name_hash, then the string table.
+    struct Header {
+        u32 magic;
+        u32 version;
+        u32 library_count;
+        u32 symbol_count;
+        u32 string_table_size;
+    };
+
+    struct LibraryRecord {
+        u32 name_offset;
+        u32 file_size;
+        u64 device;
+        u64 inode;
+        u64 mtime_seconds;
+    };
+
+    struct SymbolRecord {
+        u32 name_hash;
+        u32 name_offset;
+        u32 library_index;
+        u32 bind;
+        FlatPtr value;
+        FlatPtr size;
+    };
+
+    struct RecordedSymbol {
+        String name;
+        u32 name_hash { 0 };
+        CachedSymbol symbol;
+    };
+
+    const void* m_mapped_file { nullptr };
+    size_t m_mapped_size { 0 };
+    const SymbolRecord* m_symbols { nullptr };
+    u32 m_symbol_count { 0 };
+    const char* m_string_table { nullptr };
+    Vector<String> m_library_names;
+    bool m_negative_entries_usable { true };
+
+    bool m_recording { false };
+    Vector<RecordedSymbol> m_recorded_symbols;
+    HashTable<String> m_recorded_names;
+};
+
+} // end namespace ELF
@@ -74,6 +74,10 @@ public:
     virtual void gl_tex_coord_pointer(GLint size, GLenum type, GLsizei stride, const void* pointer) = 0;
     virtual void gl_draw_arrays(GLenum mode, GLint first, GLsizei count) = 0;
     virtual void gl_draw_elements(GLenum mode, GLsizei count, GLenum type, const void* indices) = 0;
+    virtual void gl_gen_buffers(GLsizei n, GLuint* buffers) = 0;
+    virtual void gl_delete_buffers(GLsizei n, const GLuint* buffers) = 0;
+    virtual void gl_bind_buffer(GLenum target, GLuint buffer) = 0;
+    virtual void gl_buffer_data(GLenum target, GLsizeiptr size, const void* data, GLenum usage) = 0;
     virtual void gl_color_mask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) = 0;
     virtual void gl_get_booleanv(GLenum pname, GLboolean* data) = 0;
     virtual void gl_get_integerv(GLenum pname, GLint* data) = 0;
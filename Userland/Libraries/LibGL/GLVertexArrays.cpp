@@ -33,3 +33,23 @@ void glDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices
 {
     g_gl_context->gl_draw_elements(mode, count, type, indices);
 }
+
+void glGenBuffers(GLsizei n, GLuint* buffers)
+{
+    g_gl_context->gl_gen_buffers(n, buffers);
+}
+
+void glDeleteBuffers(GLsizei n, const GLuint* buffers)
+{
+    g_gl_context->gl_delete_buffers(n, buffers);
+}
+
+void glBindBuffer(GLenum target, GLuint buffer)
+{
+    g_gl_context->gl_bind_buffer(target, buffer);
+}
+
+void glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+    g_gl_context->gl_buffer_data(target, size, data, usage);
+}
@@ -12,6 +12,7 @@
 #include <AK/Debug.h>
 #include <AK/Format.h>
 #include <AK/QuickSort.h>
+#include <AK/SIMD.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Variant.h>
 #include <AK/Vector.h>
@@ -23,6 +24,8 @@ using AK::dbgln;
 
 namespace GL {
 
+using AK::SIMD::f32x4;
+
 // FIXME: We should set this up when we create the context!
 static constexpr size_t MATRIX_STACK_LIMIT = 1024;
 
@@ -126,6 +129,23 @@ void SoftwareGLContext::gl_end()
     triangle_list.clear_with_capacity();
     processed_triangles.clear_with_capacity();
 
+    // Transform the entire vertex list in one batched pass before assembling
+    // triangles: vertices shared between triangles (strips, fans, quads) are
+    // transformed only once, and the 4x4 multiply runs on SIMD lanes.
+    auto mvp = m_projection_matrix * m_model_view_matrix;
+    auto const* mvp_elements = mvp.elements();
+    const f32x4 mvp_column_0 = { mvp_elements[0][0], mvp_elements[1][0], mvp_elements[2][0], mvp_elements[3][0] };
+    const f32x4 mvp_column_1 = { mvp_elements[0][1], mvp_elements[1][1], mvp_elements[2][1], mvp_elements[3][1] };
+    const f32x4 mvp_column_2 = { mvp_elements[0][2], mvp_elements[1][2], mvp_elements[2][2], mvp_elements[3][2] };
+    const f32x4 mvp_column_3 = { mvp_elements[0][3], mvp_elements[1][3], mvp_elements[2][3], mvp_elements[3][3] };
+    for (auto& vertex : vertex_list) {
+        f32x4 position = mvp_column_0 * vertex.position.x()
+            + mvp_column_1 * vertex.position.y()
+            + mvp_column_2 * vertex.position.z()
+            + mvp_column_3 * vertex.position.w();
+        vertex.position = { position[0], position[1], position[2], position[3] };
+    }
+
     // Let's construct some triangles
     if (m_current_draw_mode == GL_TRIANGLES) {
         GLTriangle triangle;
@@ -178,17 +198,10 @@ void SoftwareGLContext::gl_end()
 
     vertex_list.clear_with_capacity();
 
-    auto mvp = m_projection_matrix * m_model_view_matrix;
-
-    // Now let's transform each triangle and send that to the GPU
+    // Now let's clip each (already transformed) triangle and send that to the GPU
     for (size_t i = 0; i < triangle_list.size(); i++) {
         GLTriangle& triangle = triangle_list.at(i);
 
-        // First multiply the vertex by the MODELVIEW matrix and then the PROJECTION matrix
-        triangle.vertices[0].position = mvp * triangle.vertices[0].position;
-        triangle.vertices[1].position = mvp * triangle.vertices[1].position;
-        triangle.vertices[2].position = mvp * triangle.vertices[2].position;
-
         // At this point, we're in clip space
         // Here's where we do the clipping. This is a really crude implementation of the
         // https://learnopengl.com/Getting-started/Coordinate-Systems
@@ -1612,25 +1625,42 @@ void SoftwareGLContext::gl_draw_arrays(GLenum mode, GLint first, GLsizei count)
         return;
 
     auto last = first + count;
-    glBegin(mode);
-    for (int i = first; i < last; i++) {
-        if (m_client_side_texture_coord_array_enabled) {
-            float tex_coords[4] { 0, 0, 0, 0 };
-            read_from_vertex_attribute_pointer(m_client_tex_coord_pointer, i, tex_coords, false);
-            glTexCoord4fv(tex_coords);
+    gl_begin(mode);
+
+    // When the attributes are sourced from a retained buffer object, the
+    // assembled vertices are cached on the buffer; redrawing unchanged
+    // geometry skips attribute decoding and conversion entirely.
+    if (!m_array_buffer.is_null()) {
+        VertexBuffer::AssemblyCacheKey key;
+        key.vertex_pointer = m_client_vertex_pointer;
+        key.color_pointer = m_client_color_pointer;
+        key.tex_coord_pointer = m_client_tex_coord_pointer;
+        key.color_array_enabled = m_client_side_color_array_enabled;
+        key.tex_coord_array_enabled = m_client_side_texture_coord_array_enabled;
+        key.default_color = m_current_vertex_color;
+        key.default_tex_coord = m_current_vertex_tex_coord;
+        key.first = first;
+        key.count = count;
+
+        if (m_array_buffer->assembly_cache_key.has_value() && m_array_buffer->assembly_cache_key->matches(key)) {
+            vertex_list.append(m_array_buffer->assembled_vertices.data(), m_array_buffer->assembled_vertices.size());
+            gl_end();
+            return;
         }
 
-        if (m_client_side_color_array_enabled) {
-            float color[4] { 0, 0, 0, 1 };
-            read_from_vertex_attribute_pointer(m_client_color_pointer, i, color, true);
-            glColor4fv(color);
-        }
+        for (int i = first; i < last; i++)
+            vertex_list.append(assemble_client_vertex(i));
 
-        float vertex[4] { 0, 0, 0, 1 };
-        read_from_vertex_attribute_pointer(m_client_vertex_pointer, i, vertex, false);
-        glVertex4fv(vertex);
+        m_array_buffer->assembly_cache_key = key;
+        m_array_buffer->assembled_vertices.clear_with_capacity();
+        m_array_buffer->assembled_vertices.append(vertex_list.data(), vertex_list.size());
+        gl_end();
+        return;
     }
-    glEnd();
+
+    for (int i = first; i < last; i++)
+        vertex_list.append(assemble_client_vertex(i));
+    gl_end();
 }
 
 void SoftwareGLContext::gl_draw_elements(GLenum mode, GLsizei count, GLenum type, const void* indices)
@@ -1657,38 +1687,211 @@ void SoftwareGLContext::gl_draw_elements(GLenum mode, GLsizei count, GLenum type
     if (!m_client_side_vertex_array_enabled)
         return;
 
-    glBegin(mode);
+    gl_begin(mode);
+
+    // While an element array buffer is bound, the indices pointer is an
+    // offset into its retained data.
+    const void* index_data = indices;
+    if (!m_element_array_buffer.is_null())
+        index_data = m_element_array_buffer->data.data() + reinterpret_cast<FlatPtr>(indices);
+
+    // Indexed draws are only cacheable when the indices are retained too;
+    // client-memory indices can change without us noticing.
+    bool cacheable = !m_array_buffer.is_null() && !m_element_array_buffer.is_null();
+    VertexBuffer::AssemblyCacheKey key;
+    if (cacheable) {
+        key.vertex_pointer = m_client_vertex_pointer;
+        key.color_pointer = m_client_color_pointer;
+        key.tex_coord_pointer = m_client_tex_coord_pointer;
+        key.color_array_enabled = m_client_side_color_array_enabled;
+        key.tex_coord_array_enabled = m_client_side_texture_coord_array_enabled;
+        key.default_color = m_current_vertex_color;
+        key.default_tex_coord = m_current_vertex_tex_coord;
+        key.count = count;
+        key.used_elements = true;
+        key.index_type = type;
+        key.indices = indices;
+        key.element_buffer_name = m_element_array_buffer_name;
+        key.element_buffer_generation = m_element_array_buffer->generation;
+
+        if (m_array_buffer->assembly_cache_key.has_value() && m_array_buffer->assembly_cache_key->matches(key)) {
+            vertex_list.append(m_array_buffer->assembled_vertices.data(), m_array_buffer->assembled_vertices.size());
+            gl_end();
+            return;
+        }
+    }
+
     for (int index = 0; index < count; index++) {
         int i = 0;
         switch (type) {
         case GL_UNSIGNED_BYTE:
-            i = reinterpret_cast<const GLubyte*>(indices)[index];
+            i = reinterpret_cast<const GLubyte*>(index_data)[index];
             break;
         case GL_UNSIGNED_SHORT:
-            i = reinterpret_cast<const GLushort*>(indices)[index];
+            i = reinterpret_cast<const GLushort*>(index_data)[index];
             break;
         case GL_UNSIGNED_INT:
-            i = reinterpret_cast<const GLuint*>(indices)[index];
+            i = reinterpret_cast<const GLuint*>(index_data)[index];
             break;
         }
 
-        if (m_client_side_texture_coord_array_enabled) {
-            float tex_coords[4] { 0, 0, 0, 0 };
-            read_from_vertex_attribute_pointer(m_client_tex_coord_pointer, i, tex_coords, false);
-            glTexCoord4fv(tex_coords);
+        vertex_list.append(assemble_client_vertex(i));
+    }
+
+    if (cacheable) {
+        m_array_buffer->assembly_cache_key = key;
+        m_array_buffer->assembled_vertices.clear_with_capacity();
+        m_array_buffer->assembled_vertices.append(vertex_list.data(), vertex_list.size());
+    }
+
+    gl_end();
+}
+
+void SoftwareGLContext::gl_gen_buffers(GLsizei n, GLuint* buffers)
+{
+    RETURN_WITH_ERROR_IF(n < 0, GL_INVALID_VALUE);
+    RETURN_WITH_ERROR_IF(m_in_draw_state, GL_INVALID_OPERATION);
+
+    m_buffer_name_allocator.allocate(n, buffers);
+
+    // Initialize all buffer names with a nullptr; storage is created on first bind
+    for (auto i = 0; i < n; i++)
+        m_allocated_buffers.set(buffers[i], nullptr);
+}
+
+void SoftwareGLContext::gl_delete_buffers(GLsizei n, const GLuint* buffers)
+{
+    RETURN_WITH_ERROR_IF(n < 0, GL_INVALID_VALUE);
+    RETURN_WITH_ERROR_IF(m_in_draw_state, GL_INVALID_OPERATION);
+
+    m_buffer_name_allocator.free(n, buffers);
+
+    for (auto i = 0; i < n; i++) {
+        GLuint name = buffers[i];
+        if (name == 0)
+            continue;
+
+        if (m_array_buffer_name == name) {
+            m_array_buffer = nullptr;
+            m_array_buffer_name = 0;
+        }
+        if (m_element_array_buffer_name == name) {
+            m_element_array_buffer = nullptr;
+            m_element_array_buffer_name = 0;
         }
 
-        if (m_client_side_color_array_enabled) {
-            float color[4] { 0, 0, 0, 1 };
-            read_from_vertex_attribute_pointer(m_client_color_pointer, i, color, true);
-            glColor4fv(color);
+        m_allocated_buffers.remove(name);
+    }
+}
+
+void SoftwareGLContext::gl_bind_buffer(GLenum target, GLuint buffer)
+{
+    RETURN_WITH_ERROR_IF(m_in_draw_state, GL_INVALID_OPERATION);
+    RETURN_WITH_ERROR_IF(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER, GL_INVALID_ENUM);
+
+    RefPtr<VertexBuffer> buffer_object;
+    if (buffer != 0) {
+        // Binding a fresh name creates the buffer object, matching GL 1.5
+        // semantics where glGenBuffers is optional.
+        auto it = m_allocated_buffers.find(buffer);
+        if (it == m_allocated_buffers.end() || it->value.is_null()) {
+            buffer_object = adopt_ref(*new VertexBuffer());
+            m_allocated_buffers.set(buffer, buffer_object);
+        } else {
+            buffer_object = it->value;
         }
+    }
 
-        float vertex[4] { 0, 0, 0, 1 };
-        read_from_vertex_attribute_pointer(m_client_vertex_pointer, i, vertex, false);
-        glVertex4fv(vertex);
+    if (target == GL_ARRAY_BUFFER) {
+        m_array_buffer = buffer_object;
+        m_array_buffer_name = buffer;
+    } else {
+        m_element_array_buffer = buffer_object;
+        m_element_array_buffer_name = buffer;
     }
-    glEnd();
+}
+
+void SoftwareGLContext::gl_buffer_data(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+    RETURN_WITH_ERROR_IF(m_in_draw_state, GL_INVALID_OPERATION);
+    RETURN_WITH_ERROR_IF(target != GL_ARRAY_BUFFER && target != GL_ELEMENT_ARRAY_BUFFER, GL_INVALID_ENUM);
+    RETURN_WITH_ERROR_IF(size < 0, GL_INVALID_VALUE);
+    RETURN_WITH_ERROR_IF(!(usage == GL_STREAM_DRAW || usage == GL_STREAM_READ || usage == GL_STREAM_COPY
+                             || usage == GL_STATIC_DRAW || usage == GL_STATIC_READ || usage == GL_STATIC_COPY
+                             || usage == GL_DYNAMIC_DRAW || usage == GL_DYNAMIC_READ || usage == GL_DYNAMIC_COPY),
+        GL_INVALID_ENUM);
+
+    auto& buffer = (target == GL_ARRAY_BUFFER) ? m_array_buffer : m_element_array_buffer;
+    RETURN_WITH_ERROR_IF(buffer.is_null(), GL_INVALID_OPERATION);
+
+    // The usage hint is accepted but otherwise ignored; everything is
+    // retained in plain memory anyway.
+    auto new_data = data ? ByteBuffer::copy(data, size) : ByteBuffer::create_zeroed(size);
+    RETURN_WITH_ERROR_IF(!new_data.has_value(), GL_OUT_OF_MEMORY);
+
+    buffer->data = new_data.release_value();
+    buffer->generation++;
+    buffer->assembly_cache_key.clear();
+    buffer->assembled_vertices.clear();
+}
+
+bool SoftwareGLContext::VertexBuffer::AssemblyCacheKey::matches(AssemblyCacheKey const& other) const
+{
+    auto vector4_equals = [](FloatVector4 const& a, FloatVector4 const& b) {
+        return a.x() == b.x() && a.y() == b.y() && a.z() == b.z() && a.w() == b.w();
+    };
+
+    return vertex_pointer == other.vertex_pointer
+        && color_pointer == other.color_pointer
+        && tex_coord_pointer == other.tex_coord_pointer
+        && color_array_enabled == other.color_array_enabled
+        && tex_coord_array_enabled == other.tex_coord_array_enabled
+        && (color_array_enabled || vector4_equals(default_color, other.default_color))
+        && (tex_coord_array_enabled || vector4_equals(default_tex_coord, other.default_tex_coord))
+        && first == other.first
+        && count == other.count
+        && used_elements == other.used_elements
+        && index_type == other.index_type
+        && indices == other.indices
+        && element_buffer_name == other.element_buffer_name
+        && element_buffer_generation == other.element_buffer_generation;
+}
+
+SoftwareGLContext::VertexAttribPointer SoftwareGLContext::resolve_attribute_pointer(VertexAttribPointer const& attrib) const
+{
+    if (m_array_buffer.is_null())
+        return attrib;
+
+    auto resolved = attrib;
+    resolved.pointer = m_array_buffer->data.data() + reinterpret_cast<FlatPtr>(attrib.pointer);
+    return resolved;
+}
+
+GLVertex SoftwareGLContext::assemble_client_vertex(int index)
+{
+    GLVertex vertex;
+
+    if (m_client_side_texture_coord_array_enabled) {
+        float tex_coords[4] { 0, 0, 0, 0 };
+        read_from_vertex_attribute_pointer(resolve_attribute_pointer(m_client_tex_coord_pointer), index, tex_coords, false);
+        vertex.tex_coord = { tex_coords[0], tex_coords[1] };
+    } else {
+        vertex.tex_coord = { m_current_vertex_tex_coord.x(), m_current_vertex_tex_coord.y() };
+    }
+
+    if (m_client_side_color_array_enabled) {
+        float color[4] { 0, 0, 0, 1 };
+        read_from_vertex_attribute_pointer(resolve_attribute_pointer(m_client_color_pointer), index, color, true);
+        vertex.color = { color[0], color[1], color[2], color[3] };
+    } else {
+        vertex.color = m_current_vertex_color;
+    }
+
+    float position[4] { 0, 0, 0, 1 };
+    read_from_vertex_attribute_pointer(resolve_attribute_pointer(m_client_vertex_pointer), index, position, false);
+    vertex.position = { position[0], position[1], position[2], position[3] };
+
+    return vertex;
 }
 
 void SoftwareGLContext::gl_depth_range(GLdouble min, GLdouble max)
@@ -13,7 +13,9 @@
 #include "Tex/NameAllocator.h"
 #include "Tex/Texture.h"
 #include "Tex/TextureUnit.h"
+#include <AK/ByteBuffer.h>
 #include <AK/HashMap.h>
+#include <AK/RefCounted.h>
 #include <AK/RefPtr.h>
 #include <AK/Tuple.h>
 #include <AK/Variant.h>
@@ -84,6 +86,10 @@ public:
     virtual void gl_tex_coord_pointer(GLint size, GLenum type, GLsizei stride, const void* pointer) override;
     virtual void gl_draw_arrays(GLenum mode, GLint first, GLsizei count) override;
     virtual void gl_draw_elements(GLenum mode, GLsizei count, GLenum type, const void* indices) override;
+    virtual void gl_gen_buffers(GLsizei n, GLuint* buffers) override;
+    virtual void gl_delete_buffers(GLsizei n, const GLuint* buffers) override;
+    virtual void gl_bind_buffer(GLenum target, GLuint buffer) override;
+    virtual void gl_buffer_data(GLenum target, GLsizeiptr size, const void* data, GLenum usage) override;
     virtual void gl_color_mask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) override;
     virtual void gl_get_booleanv(GLenum pname, GLboolean* data) override;
     virtual void gl_get_integerv(GLenum pname, GLint* data) override;
@@ -254,14 +260,63 @@ private:
         GLenum type { GL_FLOAT };
         GLsizei stride { 0 };
         const void* pointer { 0 };
+
+        bool operator==(VertexAttribPointer const& other) const
+        {
+            return size == other.size && type == other.type && stride == other.stride && pointer == other.pointer;
+        }
     };
 
     static void read_from_vertex_attribute_pointer(VertexAttribPointer const&, int index, float* elements, bool normalize);
 
+    VertexAttribPointer resolve_attribute_pointer(VertexAttribPointer const&) const;
+    GLVertex assemble_client_vertex(int index);
+
     VertexAttribPointer m_client_vertex_pointer;
     VertexAttribPointer m_client_color_pointer;
     VertexAttribPointer m_client_tex_coord_pointer;
 
+    // Buffer objects (VBOs). Attribute pointers are interpreted as offsets
+    // into the bound buffer's retained data while one is bound.
+    struct VertexBuffer : public RefCounted<VertexBuffer> {
+        ByteBuffer data;
+        // Bumped whenever the contents change, so caches that reference this
+        // buffer indirectly (e.g. as an element array) detect staleness.
+        u32 generation { 0 };
+
+        // Cached vertex assembly for the most recent draw configuration.
+        // Re-drawing unchanged geometry with unchanged attribute layout
+        // skips attribute decoding and conversion entirely.
+        struct AssemblyCacheKey {
+            VertexAttribPointer vertex_pointer;
+            VertexAttribPointer color_pointer;
+            VertexAttribPointer tex_coord_pointer;
+            bool color_array_enabled { false };
+            bool tex_coord_array_enabled { false };
+            FloatVector4 default_color {};
+            FloatVector4 default_tex_coord {};
+            GLint first { 0 };
+            GLsizei count { 0 };
+            bool used_elements { false };
+            GLenum index_type { 0 };
+            const void* indices { nullptr };
+            GLuint element_buffer_name { 0 };
+            u32 element_buffer_generation { 0 };
+
+            bool matches(AssemblyCacheKey const&) const;
+        };
+        Optional<AssemblyCacheKey> assembly_cache_key;
+        Vector<GLVertex> assembled_vertices;
+    };
+
+    // The name allocator is generic despite its name; buffers reuse it.
+    TextureNameAllocator m_buffer_name_allocator;
+    HashMap<GLuint, RefPtr<VertexBuffer>> m_allocated_buffers;
+    RefPtr<VertexBuffer> m_array_buffer;
+    GLuint m_array_buffer_name { 0 };
+    RefPtr<VertexBuffer> m_element_array_buffer;
+    GLuint m_element_array_buffer_name { 0 };
+
     size_t m_unpack_row_length { 0 };
 };
 
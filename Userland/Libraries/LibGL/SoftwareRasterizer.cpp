@@ -6,12 +6,17 @@
 
 #include "SoftwareRasterizer.h"
 #include <AK/Function.h>
+#include <AK/SIMD.h>
 #include <LibGfx/Painter.h>
 #include <LibGfx/Vector2.h>
 #include <LibGfx/Vector3.h>
+#include <LibThreading/WorkerPool.h>
 
 namespace GL {
 
+using AK::SIMD::f32x4;
+using AK::SIMD::i32x4;
+
 using IntVector2 = Gfx::Vector2<int>;
 using IntVector3 = Gfx::Vector3<int>;
 
@@ -191,12 +196,24 @@ static void rasterize_triangle(const RasterizerOptions& options, Gfx::Bitmap& re
     // clang-format on
 
     static_assert(RASTERIZER_BLOCK_SIZE < sizeof(int) * 8, "RASTERIZER_BLOCK_SIZE must be smaller than the pixel_mask's width in bits");
-    int pixel_mask[RASTERIZER_BLOCK_SIZE];
+    static_assert((RASTERIZER_BLOCK_SIZE % 4) == 0, "RASTERIZER_BLOCK_SIZE must be a multiple of the SIMD lane count");
+
+    // Pixels within a block are processed 4 at a time: each SIMD lane
+    // evaluates the edge functions and interpolants for one pixel.
+    const i32x4 lane_offsets = { 0, 1, 2, 3 };
+    const i32x4 zero_x = { zero.x(), zero.x(), zero.x(), zero.x() };
+    const i32x4 zero_y = { zero.y(), zero.y(), zero.y(), zero.y() };
+    const i32x4 zero_z = { zero.z(), zero.z(), zero.z(), zero.z() };
+
+    // Rasterizes one horizontal row of blocks. Each row covers a disjoint
+    // set of scanlines in the render target and depth buffer, so rows can be
+    // rasterized in parallel without any synchronization; the pixel shader
+    // only reads shared state (options, texture samplers).
+    auto rasterize_block_row = [&](int by) {
+        int pixel_mask[RASTERIZER_BLOCK_SIZE];
 
-    FloatVector4 pixel_buffer[RASTERIZER_BLOCK_SIZE][RASTERIZER_BLOCK_SIZE];
+        FloatVector4 pixel_buffer[RASTERIZER_BLOCK_SIZE][RASTERIZER_BLOCK_SIZE];
 
-    // Iterate over all blocks within the bounds of the triangle
-    for (int by = by0; by < by1; by++) {
         for (int bx = bx0; bx < bx1; bx++) {
 
             // Edge values of the 4 block corners
@@ -241,9 +258,15 @@ static void rasterize_triangle(const RasterizerOptions& options, Gfx::Bitmap& re
                 for (int y = 0; y < RASTERIZER_BLOCK_SIZE; y++, coords += step_y) {
                     pixel_mask[y] = 0;
 
-                    for (int x = 0; x < RASTERIZER_BLOCK_SIZE; x++, coords += dbdx) {
-                        if (test_point(coords))
-                            pixel_mask[y] |= 1 << x;
+                    for (int x = 0; x < RASTERIZER_BLOCK_SIZE; x += 4, coords += dbdx * 4) {
+                        i32x4 edge_a = coords.x() + dbdx.x() * lane_offsets;
+                        i32x4 edge_b = coords.y() + dbdx.y() * lane_offsets;
+                        i32x4 edge_c = coords.z() + dbdx.z() * lane_offsets;
+                        i32x4 inside = (edge_a >= zero_x) & (edge_b >= zero_y) & (edge_c >= zero_z);
+                        for (int lane = 0; lane < 4; lane++) {
+                            if (inside[lane])
+                                pixel_mask[y] |= 1 << (x + lane);
+                        }
                     }
                 }
             }
@@ -260,74 +283,86 @@ static void rasterize_triangle(const RasterizerOptions& options, Gfx::Bitmap& re
                     }
 
                     auto* depth = &depth_buffer.scanline(y0 + y)[x0];
-                    for (int x = 0; x < RASTERIZER_BLOCK_SIZE; x++, coords += dbdx, depth++) {
-                        if (~pixel_mask[y] & (1 << x))
+                    for (int x = 0; x < RASTERIZER_BLOCK_SIZE; x += 4, coords += dbdx * 4, depth += 4) {
+                        if (((pixel_mask[y] >> x) & 0xf) == 0)
                             continue;
 
-                        auto barycentric = FloatVector3(coords.x(), coords.y(), coords.z()) * one_over_area;
-                        float z = interpolate(triangle.vertices[0].position.z(), triangle.vertices[1].position.z(), triangle.vertices[2].position.z(), barycentric);
+                        // Interpolate the 4 depth values in one go
+                        f32x4 alpha = __builtin_convertvector(coords.x() + dbdx.x() * lane_offsets, f32x4) * one_over_area;
+                        f32x4 beta = __builtin_convertvector(coords.y() + dbdx.y() * lane_offsets, f32x4) * one_over_area;
+                        f32x4 gamma = __builtin_convertvector(coords.z() + dbdx.z() * lane_offsets, f32x4) * one_over_area;
+                        f32x4 z_values = triangle.vertices[0].position.z() * alpha
+                            + triangle.vertices[1].position.z() * beta
+                            + triangle.vertices[2].position.z() * gamma;
 
-                        z = options.depth_min + (options.depth_max - options.depth_min) * (z + 1) / 2;
+                        z_values = options.depth_min + (options.depth_max - options.depth_min) * (z_values + 1) / 2;
 
                         // FIXME: Also apply depth_offset_factor which depends on the depth gradient
-                        z += options.depth_offset_constant * NumericLimits<float>::epsilon();
-
-                        bool pass = false;
-                        switch (options.depth_func) {
-                        case GL_ALWAYS:
-                            pass = true;
-                            break;
-                        case GL_NEVER:
-                            pass = false;
-                            break;
-                        case GL_GREATER:
-                            pass = z > *depth;
-                            break;
-                        case GL_GEQUAL:
-                            pass = z >= *depth;
-                            break;
-                        case GL_NOTEQUAL:
+                        z_values += options.depth_offset_constant * NumericLimits<float>::epsilon();
+
+                        for (int lane = 0; lane < 4; lane++) {
+                            if (~pixel_mask[y] & (1 << (x + lane)))
+                                continue;
+
+                            float z = z_values[lane];
+
+                            bool pass = false;
+                            switch (options.depth_func) {
+                            case GL_ALWAYS:
+                                pass = true;
+                                break;
+                            case GL_NEVER:
+                                pass = false;
+                                break;
+                            case GL_GREATER:
+                                pass = z > depth[lane];
+                                break;
+                            case GL_GEQUAL:
+                                pass = z >= depth[lane];
+                                break;
+                            case GL_NOTEQUAL:
 #ifdef __SSE__
-                            pass = z != *depth;
+                                pass = z != depth[lane];
 #else
-                            pass = bit_cast<u32>(z) != bit_cast<u32>(*depth);
+                                pass = bit_cast<u32>(z) != bit_cast<u32>(depth[lane]);
 #endif
-                            break;
-                        case GL_EQUAL:
+                                break;
+                            case GL_EQUAL:
 #ifdef __SSE__
-                            pass = z == *depth;
+                                pass = z == depth[lane];
 #else
-                            //
-                            // This is an interesting quirk that occurs due to us using the x87 FPU when Serenity is
-                            // compiled for the i386 target. When we calculate our depth value to be stored in the buffer,
-                            // it is an 80-bit x87 floating point number, however, when stored into the DepthBuffer, this is
-                            // truncated to 32 bits. This 38 bit loss of precision means that when x87 `FCOMP` is eventually
-                            // used here the comparison fails.
-                            // This could be solved by using a `long double` for the depth buffer, however this would take
-                            // up significantly more space and is completely overkill for a depth buffer. As such, comparing
-                            // the first 32-bits of this depth value is "good enough" that if we get a hit on it being
-                            // equal, we can pretty much guarantee that it's actually equal.
-                            //
-                            pass = bit_cast<u32>(z) == bit_cast<u32>(*depth);
+                                //
+                                // This is an interesting quirk that occurs due to us using the x87 FPU when Serenity is
+                                // compiled for the i386 target. When we calculate our depth value to be stored in the buffer,
+                                // it is an 80-bit x87 floating point number, however, when stored into the DepthBuffer, this is
+                                // truncated to 32 bits. This 38 bit loss of precision means that when x87 `FCOMP` is eventually
+                                // used here the comparison fails.
+                                // This could be solved by using a `long double` for the depth buffer, however this would take
+                                // up significantly more space and is completely overkill for a depth buffer. As such, comparing
+                                // the first 32-bits of this depth value is "good enough" that if we get a hit on it being
+                                // equal, we can pretty much guarantee that it's actually equal.
+                                //
+                                pass = bit_cast<u32>(z) == bit_cast<u32>(depth[lane]);
 #endif
-                            break;
-                        case GL_LEQUAL:
-                            pass = z <= *depth;
-                            break;
-                        case GL_LESS:
-                            pass = z < *depth;
-                            break;
-                        }
-
-                        if (!pass) {
-                            pixel_mask[y] ^= 1 << x;
-                            continue;
+                                break;
+                            case GL_LEQUAL:
+                                pass = z <= depth[lane];
+                                break;
+                            case GL_LESS:
+                                pass = z < depth[lane];
+                                break;
+                            }
+
+                            if (!pass) {
+                                pixel_mask[y] ^= 1 << (x + lane);
+                                continue;
+                            }
+
+                            if (options.enable_depth_write)
+                                depth[lane] = z;
+
+                            z_pass_count++;
                         }
-
-                        if (options.enable_depth_write)
-                            *depth = z;
-
-                        z_pass_count++;
                     }
                 }
 
@@ -349,39 +384,53 @@ static void rasterize_triangle(const RasterizerOptions& options, Gfx::Bitmap& re
                 }
 
                 auto* pixel = pixel_buffer[y];
-                for (int x = 0; x < RASTERIZER_BLOCK_SIZE; x++, coords += dbdx, pixel++) {
-                    if (~pixel_mask[y] & (1 << x))
+                for (int x = 0; x < RASTERIZER_BLOCK_SIZE; x += 4, coords += dbdx * 4, pixel += 4) {
+                    if (((pixel_mask[y] >> x) & 0xf) == 0)
                         continue;
 
-                    // Perspective correct barycentric coordinates
-                    auto barycentric = FloatVector3(coords.x(), coords.y(), coords.z()) * one_over_area;
-                    float interpolated_reciprocal_w = interpolate(triangle.vertices[0].position.w(), triangle.vertices[1].position.w(), triangle.vertices[2].position.w(), barycentric);
-                    float interpolated_w = 1 / interpolated_reciprocal_w;
-                    barycentric = barycentric * FloatVector3(triangle.vertices[0].position.w(), triangle.vertices[1].position.w(), triangle.vertices[2].position.w()) * interpolated_w;
-
-                    // FIXME: make this more generic. We want to interpolate more than just color and uv
-                    FloatVector4 vertex_color;
-                    if (options.shade_smooth) {
-                        vertex_color = interpolate(
-                            triangle.vertices[0].color,
-                            triangle.vertices[1].color,
-                            triangle.vertices[2].color,
-                            barycentric);
-                    } else {
-                        vertex_color = triangle.vertices[0].color;
-                    }
+                    // Interpolate the 4 barycentric coordinates and reciprocal
+                    // w values in one go; the shader itself runs per pixel
+                    // since texture sampling is scalar.
+                    f32x4 alpha = __builtin_convertvector(coords.x() + dbdx.x() * lane_offsets, f32x4) * one_over_area;
+                    f32x4 beta = __builtin_convertvector(coords.y() + dbdx.y() * lane_offsets, f32x4) * one_over_area;
+                    f32x4 gamma = __builtin_convertvector(coords.z() + dbdx.z() * lane_offsets, f32x4) * one_over_area;
+                    f32x4 reciprocal_w_values = triangle.vertices[0].position.w() * alpha
+                        + triangle.vertices[1].position.w() * beta
+                        + triangle.vertices[2].position.w() * gamma;
+
+                    for (int lane = 0; lane < 4; lane++) {
+                        if (~pixel_mask[y] & (1 << (x + lane)))
+                            continue;
 
-                    auto uv = interpolate(
-                        triangle.vertices[0].tex_coord,
-                        triangle.vertices[1].tex_coord,
-                        triangle.vertices[2].tex_coord,
-                        barycentric);
+                        // Perspective correct barycentric coordinates
+                        auto barycentric = FloatVector3(alpha[lane], beta[lane], gamma[lane]);
+                        float interpolated_w = 1 / reciprocal_w_values[lane];
+                        barycentric = barycentric * FloatVector3(triangle.vertices[0].position.w(), triangle.vertices[1].position.w(), triangle.vertices[2].position.w()) * interpolated_w;
+
+                        // FIXME: make this more generic. We want to interpolate more than just color and uv
+                        FloatVector4 vertex_color;
+                        if (options.shade_smooth) {
+                            vertex_color = interpolate(
+                                triangle.vertices[0].color,
+                                triangle.vertices[1].color,
+                                triangle.vertices[2].color,
+                                barycentric);
+                        } else {
+                            vertex_color = triangle.vertices[0].color;
+                        }
+
+                        auto uv = interpolate(
+                            triangle.vertices[0].tex_coord,
+                            triangle.vertices[1].tex_coord,
+                            triangle.vertices[2].tex_coord,
+                            barycentric);
 
-                    // Calculate depth of fragment for fog
-                    float z = interpolate(triangle.vertices[0].position.z(), triangle.vertices[1].position.z(), triangle.vertices[2].position.z(), barycentric);
-                    z = options.depth_min + (options.depth_max - options.depth_min) * (z + 1) / 2;
+                        // Calculate depth of fragment for fog
+                        float z = interpolate(triangle.vertices[0].position.z(), triangle.vertices[1].position.z(), triangle.vertices[2].position.z(), barycentric);
+                        z = options.depth_min + (options.depth_max - options.depth_min) * (z + 1) / 2;
 
-                    *pixel = pixel_shader(uv, vertex_color, z);
+                        pixel[lane] = pixel_shader(uv, vertex_color, z);
+                    }
                 }
             }
 
@@ -467,6 +516,18 @@ static void rasterize_triangle(const RasterizerOptions& options, Gfx::Bitmap& re
                 }
             }
         }
+    };
+
+    // Distribute the block rows across the worker pool. parallel_for() only
+    // returns once every row has been rasterized, so the caller still
+    // observes a fully rendered triangle.
+    int block_row_count = by1 - by0;
+    if (block_row_count > 1) {
+        Threading::WorkerPool::the().parallel_for(block_row_count, [&](size_t i) {
+            rasterize_block_row(by0 + static_cast<int>(i));
+        });
+    } else if (block_row_count == 1) {
+        rasterize_block_row(by0);
     }
 }
 
@@ -580,7 +641,8 @@ void SoftwareRasterizer::blit_to(Gfx::Bitmap& target)
 
 void SoftwareRasterizer::wait_for_all_threads() const
 {
-    // FIXME: Wait for all render threads to finish when multithreading is being implemented
+    // Block row rasterization joins the worker pool before
+    // rasterize_triangle() returns, so nothing is outstanding here.
 }
 
 void SoftwareRasterizer::set_options(const RasterizerOptions& options)
@@ -588,8 +650,6 @@ void SoftwareRasterizer::set_options(const RasterizerOptions& options)
     wait_for_all_threads();
 
     m_options = options;
-
-    // FIXME: Recreate or reinitialize render threads here when multithreading is being implemented
 }
 
 Gfx::RGBA32 SoftwareRasterizer::get_backbuffer_pixel(int x, int y)
@@ -340,12 +340,52 @@ Gfx::IntPoint AbstractTableView::adjusted_position(const Gfx::IntPoint& position
 void AbstractTableView::model_did_update(unsigned flags)
 {
     AbstractView::model_did_update(flags);
+    invalidate_cached_range();
     update_row_sizes();
     update_column_sizes();
     update_content_size();
     update();
 }
 
+void AbstractTableView::cache_visible_range(int first_row, int last_row)
+{
+    if (!model()) {
+        invalidate_cached_range();
+        return;
+    }
+    auto& model = *this->model();
+    int column_count = model.column_count();
+    if (column_count < 1 || last_row < first_row) {
+        invalidate_cached_range();
+        return;
+    }
+    if (m_cached_range.column_count == column_count
+        && first_row >= m_cached_range.first_row
+        && last_row < m_cached_range.first_row + m_cached_range.row_count)
+        return;
+    // Over-fetch by a screenful in both directions so that scrolling can
+    // be serviced from the cache most of the time.
+    int visible_row_count = last_row - first_row + 1;
+    int cache_first_row = max(first_row - visible_row_count, 0);
+    int cache_last_row = min(last_row + visible_row_count, model.row_count() - 1);
+    m_cached_range.first_row = cache_first_row;
+    m_cached_range.row_count = cache_last_row - cache_first_row + 1;
+    m_cached_range.column_count = column_count;
+    m_cached_range.data = model.range_data({}, cache_first_row, cache_last_row, 0, column_count - 1);
+}
+
+Variant const* AbstractTableView::cached_cell_data(const ModelIndex& index) const
+{
+    if (index.parent().is_valid())
+        return nullptr;
+    int relative_row = index.row() - m_cached_range.first_row;
+    if (relative_row < 0 || relative_row >= m_cached_range.row_count)
+        return nullptr;
+    if (index.column() < 0 || index.column() >= m_cached_range.column_count)
+        return nullptr;
+    return &m_cached_range.data[relative_row * m_cached_range.column_count + index.column()];
+}
+
 void AbstractTableView::resize_event(ResizeEvent& event)
 {
     AbstractView::resize_event(event);
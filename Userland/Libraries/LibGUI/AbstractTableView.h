@@ -100,6 +100,14 @@ protected:
 
     void move_cursor_relative(int vertical_steps, int horizontal_steps, SelectionUpdate);
 
+    // Batched access to Display-role data: cache_visible_range() fetches a
+    // window of rows around the given range through Model::range_data() and
+    // cached_cell_data() serves individual cells from that window, so a
+    // paint pass doesn't have to make one virtual call per cell.
+    void cache_visible_range(int first_row, int last_row);
+    Variant const* cached_cell_data(const ModelIndex&) const;
+    void invalidate_cached_range() { m_cached_range.row_count = 0; }
+
 private:
     void layout_headers();
     bool is_navigation(GUI::KeyEvent&);
@@ -110,6 +118,14 @@ private:
 
     HashMap<int, OwnPtr<TableCellPaintingDelegate>> m_column_painting_delegate;
 
+    struct CachedRange {
+        int first_row { 0 };
+        int row_count { 0 };
+        int column_count { 0 };
+        Vector<Variant> data;
+    };
+    CachedRange m_cached_range;
+
     bool m_alternating_row_colors { true };
     bool m_highlight_selected_rows { true };
 
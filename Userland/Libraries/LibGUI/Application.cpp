@@ -17,6 +17,7 @@
 #include <LibGUI/WindowServerConnection.h>
 #include <LibGfx/Font.h>
 #include <LibGfx/Palette.h>
+#include <serenity.h>
 
 namespace GUI {
 
@@ -99,6 +100,14 @@ Application::Application(int argc, char** argv, Core::EventLoop::MakeInspectable
     m_tooltip_hide_timer = Core::Timer::create_single_shot(50, [this] {
         tooltip_hide_timer_did_fire();
     });
+
+    // By this point we've connected to WindowServer and Clipboard and loaded
+    // the system theme and fonts, which is the bulk of GUI process startup.
+    // Record it in the performance event stream (no-op unless profiling.)
+    constexpr auto phase = "LibGUI: Application constructed"sv;
+    auto string_id = perf_register_string(phase.characters_without_null_termination(), phase.length());
+    if (string_id >= 0)
+        perf_event(PERF_EVENT_SIGNPOST, string_id, 0);
 }
 
 Application::~Application()
@@ -14,6 +14,7 @@
 #include <LibGUI/Forward.h>
 #include <LibGUI/WindowType.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/Forward.h>
 #include <LibGfx/Point.h>
 #include <LibGfx/Rect.h>
 
@@ -257,9 +258,16 @@ public:
     const Gfx::IntRect& rect() const { return m_rect; }
     const Gfx::IntSize& window_size() const { return m_window_size; }
 
+    // An optional damage region in window coordinates. When present, rect()
+    // is merely its bounding rect and widgets outside the individual damage
+    // rects may skip painting entirely.
+    Gfx::DisjointRectSet const* window_damage_rects() const { return m_window_damage_rects; }
+    void set_window_damage_rects(Gfx::DisjointRectSet const& rects) { m_window_damage_rects = &rects; }
+
 private:
     Gfx::IntRect m_rect;
     Gfx::IntSize m_window_size;
+    Gfx::DisjointRectSet const* m_window_damage_rects { nullptr };
 };
 
 class ResizeEvent final : public Event {
@@ -16,7 +16,9 @@
 #include <LibGUI/FileSystemModel.h>
 #include <LibGUI/Painter.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/PNGWriter.h>
 #include <LibThreading/BackgroundAction.h>
+#include <errno.h>
 #include <grp.h>
 #include <pwd.h>
 #include <stdio.h>
@@ -103,25 +105,38 @@ void FileSystemModel::Node::traverse_if_needed()
     }
     quick_sort(child_names);
 
-    NonnullOwnPtrVector<Node> directory_children;
-    NonnullOwnPtrVector<Node> file_children;
-
-    for (auto& child_name : child_names) {
-        auto maybe_child = create_child(child_name);
-        if (!maybe_child)
-            continue;
+    if (m_model.m_mode == FilesAndDirectories) {
+        // Stat()ing every entry up front can block the UI for seconds in a
+        // large directory, so create name-only stub children right away and
+        // let a background thread fill the metadata in, a batch at a time.
+        for (auto& child_name : child_names) {
+            auto child = adopt_own(*new Node(m_model));
+            child->name = child_name;
+            child->m_parent = this;
+            m_children.append(move(child));
+        }
+        m_model.fetch_children_metadata(*this, move(child_names));
+    } else {
+        NonnullOwnPtrVector<Node> directory_children;
+        NonnullOwnPtrVector<Node> file_children;
+
+        for (auto& child_name : child_names) {
+            auto maybe_child = create_child(child_name);
+            if (!maybe_child)
+                continue;
+
+            auto child = maybe_child.release_nonnull();
+            total_size += child->size;
+            if (S_ISDIR(child->mode))
+                directory_children.append(move(child));
+            else
+                file_children.append(move(child));
+        }
 
-        auto child = maybe_child.release_nonnull();
-        total_size += child->size;
-        if (S_ISDIR(child->mode))
-            directory_children.append(move(child));
-        else
-            file_children.append(move(child));
+        m_children.extend(move(directory_children));
+        m_children.extend(move(file_children));
     }
 
-    m_children.extend(move(directory_children));
-    m_children.extend(move(file_children));
-
     if (!m_model.m_file_watcher->is_watching(full_path)) {
         // We are not already watching this file, watch it
         auto result = m_model.m_file_watcher->add_watch(full_path,
@@ -138,6 +153,115 @@ void FileSystemModel::Node::traverse_if_needed()
     }
 }
 
+struct ChildMetadata {
+    String name;
+    String symlink_target;
+    struct stat st { };
+    bool is_accessible_directory { false };
+    int error { 0 };
+};
+
+void FileSystemModel::fetch_children_metadata(Node& parent, Vector<String> child_names)
+{
+    auto parent_path = parent.full_path();
+    auto weak_this = make_weak_ptr();
+    auto fetch_generation = m_fetch_generation;
+
+    constexpr size_t batch_size = 256;
+    size_t offset = 0;
+    while (offset < child_names.size()) {
+        auto count = min(batch_size, child_names.size() - offset);
+        Vector<String> batch;
+        batch.ensure_capacity(count);
+        for (size_t i = 0; i < count; ++i)
+            batch.unchecked_append(child_names[offset + i]);
+        offset += count;
+        bool is_last_batch = offset == child_names.size();
+
+        Threading::BackgroundAction<Vector<ChildMetadata>>::create(
+            [parent_path, batch = move(batch)](auto&) {
+                Vector<ChildMetadata> results;
+                results.ensure_capacity(batch.size());
+                for (auto& child_name : batch) {
+                    ChildMetadata metadata;
+                    metadata.name = child_name;
+                    auto child_path = LexicalPath::join(parent_path, child_name).string();
+                    if (lstat(child_path.characters(), &metadata.st) < 0) {
+                        metadata.error = errno;
+                    } else {
+                        if (S_ISLNK(metadata.st.st_mode))
+                            metadata.symlink_target = Core::File::read_link(child_path);
+                        if (S_ISDIR(metadata.st.st_mode))
+                            metadata.is_accessible_directory = access(child_path.characters(), R_OK | X_OK) == 0;
+                    }
+                    results.unchecked_append(move(metadata));
+                }
+                return results;
+            },
+
+            [this, weak_this, parent_path, fetch_generation, is_last_batch](Vector<ChildMetadata> results) {
+                // The model may have been destroyed or invalidated while we
+                // were stat()ing; the nodes these results were meant for are
+                // gone in that case.
+                if (weak_this.is_null() || fetch_generation != m_fetch_generation)
+                    return;
+
+                auto* parent = const_cast<Node*>(node_for_path(parent_path));
+                if (parent == nullptr)
+                    return;
+
+                HashMap<String, ChildMetadata*> metadata_for_name;
+                for (auto& metadata : results)
+                    metadata_for_name.set(metadata.name, &metadata);
+
+                for (auto& child : parent->m_children) {
+                    auto it = metadata_for_name.find(child.name);
+                    if (it == metadata_for_name.end())
+                        continue;
+                    auto& metadata = *(*it).value;
+                    if (metadata.error != 0) {
+                        child.m_error = metadata.error;
+                        continue;
+                    }
+                    child.size = metadata.st.st_size;
+                    child.mode = metadata.st.st_mode;
+                    child.uid = metadata.st.st_uid;
+                    child.gid = metadata.st.st_gid;
+                    child.inode = metadata.st.st_ino;
+                    child.mtime = metadata.st.st_mtime;
+                    child.symlink_target = metadata.symlink_target;
+                    child.is_accessible_directory = metadata.is_accessible_directory;
+                    parent->total_size += child.size;
+                }
+
+                if (!is_last_batch) {
+                    did_update(UpdateFlag::DontInvalidateIndices);
+                    return;
+                }
+
+                // All metadata has arrived: drop entries we failed to stat and
+                // restore the directories-then-files grouping the synchronous
+                // path produces.
+                parent->m_children.remove_all_matching([](auto& child) { return child->has_error(); });
+
+                NonnullOwnPtrVector<Node> directory_children;
+                NonnullOwnPtrVector<Node> file_children;
+                for (size_t i = 0; i < parent->m_children.size(); ++i) {
+                    auto child = move(parent->m_children.ptr_at(i));
+                    if (S_ISDIR(child->mode))
+                        directory_children.append(move(child));
+                    else
+                        file_children.append(move(child));
+                }
+                parent->m_children.clear();
+                parent->m_children.extend(move(directory_children));
+                parent->m_children.extend(move(file_children));
+
+                did_update();
+            });
+    }
+}
+
 OwnPtr<FileSystemModel::Node> FileSystemModel::Node::create_child(String const& child_name)
 {
     String child_path = LexicalPath::join(full_path(), child_name).string();
@@ -357,6 +481,7 @@ void FileSystemModel::set_root_path(String root_path)
 
 void FileSystemModel::invalidate()
 {
+    ++m_fetch_generation;
     m_root = adopt_own(*new Node(*this));
 
     if (m_root_path.is_null())
@@ -604,19 +729,45 @@ Icon FileSystemModel::icon_for(const Node& node) const
 
 static HashMap<String, RefPtr<Gfx::Bitmap>> s_thumbnail_cache;
 
-static RefPtr<Gfx::Bitmap> render_thumbnail(const StringView& path)
+static String thumbnail_cache_directory()
+{
+    return String::formatted("{}/thumbnails", Core::StandardPaths::config_directory());
+}
+
+static String thumbnail_cache_path_for(String const& path, time_t mtime)
+{
+    // Keying on both path and mtime means an updated image simply renders
+    // to a new cache entry, and stale ones are never referenced again.
+    return String::formatted("{}/{:08x}{:08x}.png", thumbnail_cache_directory(), path.hash(), (u64)mtime);
+}
+
+static RefPtr<Gfx::Bitmap> render_thumbnail(String const& path, time_t mtime)
 {
+    auto cache_path = thumbnail_cache_path_for(path, mtime);
+    if (auto cached_thumbnail = Gfx::Bitmap::try_load_from_file(cache_path))
+        return cached_thumbnail;
+
     auto png_bitmap = Gfx::Bitmap::try_load_from_file(path);
     if (!png_bitmap)
         return nullptr;
 
-    double scale = min(32 / (double)png_bitmap->width(), 32 / (double)png_bitmap->height());
+    auto scaled_bitmap = png_bitmap->scaled_to_fit({ 32, 32 });
+    if (!scaled_bitmap)
+        return nullptr;
 
     auto thumbnail = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, { 32, 32 });
-    auto destination = Gfx::IntRect(0, 0, (int)(png_bitmap->width() * scale), (int)(png_bitmap->height() * scale)).centered_within(thumbnail->rect());
+    auto destination = scaled_bitmap->rect().centered_within(thumbnail->rect());
 
     Painter painter(*thumbnail);
-    painter.draw_scaled_bitmap(destination, *png_bitmap, png_bitmap->rect());
+    painter.blit(destination.location(), *scaled_bitmap, scaled_bitmap->rect());
+
+    if (mkdir(thumbnail_cache_directory().characters(), 0755) == 0 || errno == EEXIST) {
+        auto encoded = Gfx::PNGWriter::encode(*thumbnail);
+        auto file_or_error = Core::File::open(cache_path, Core::OpenMode::WriteOnly | Core::OpenMode::Truncate);
+        if (!file_or_error.is_error())
+            file_or_error.value()->write(encoded);
+    }
+
     return thumbnail;
 }
 
@@ -640,10 +791,11 @@ bool FileSystemModel::fetch_thumbnail_for(const Node& node)
     m_thumbnail_progress_total++;
 
     auto weak_this = make_weak_ptr();
+    auto mtime = node.mtime;
 
     Threading::BackgroundAction<RefPtr<Gfx::Bitmap>>::create(
-        [path](auto&) {
-            return render_thumbnail(path);
+        [path, mtime](auto&) {
+            return render_thumbnail(path, mtime);
         },
 
         [this, path, weak_this](auto thumbnail) {
@@ -151,6 +151,8 @@ private:
 
     Node const* node_for_path(String const&) const;
 
+    void fetch_children_metadata(Node& parent, Vector<String> child_names);
+
     HashMap<uid_t, String> m_user_names;
     HashMap<gid_t, String> m_group_names;
 
@@ -166,6 +168,10 @@ private:
     unsigned m_thumbnail_progress { 0 };
     unsigned m_thumbnail_progress_total { 0 };
 
+    // Bumped by invalidate() so in-flight background metadata fetches for a
+    // discarded tree can tell their results are no longer wanted.
+    unsigned m_fetch_generation { 0 };
+
     bool m_should_show_dotfiles { false };
 
     RefPtr<Core::FileWatcher> m_file_watcher;
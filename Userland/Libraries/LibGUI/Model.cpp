@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/EventLoop.h>
 #include <LibGUI/AbstractView.h>
 #include <LibGUI/Model.h>
 #include <LibGUI/PersistentModelIndex.h>
@@ -51,11 +52,40 @@ void Model::for_each_client(Function<void(ModelClient&)> callback)
 
 void Model::did_update(unsigned flags)
 {
+    if (m_batch_update_depth > 0) {
+        m_pending_update_flags |= flags;
+        m_has_pending_update = true;
+        return;
+    }
     for_each_client([flags](ModelClient& client) {
         client.model_did_update(flags);
     });
 }
 
+void Model::begin_batch_update()
+{
+    ++m_batch_update_depth;
+}
+
+void Model::end_batch_update()
+{
+    VERIFY(m_batch_update_depth > 0);
+    if (--m_batch_update_depth > 0)
+        return;
+    if (!m_has_pending_update || m_has_scheduled_update)
+        return;
+    m_has_scheduled_update = true;
+    Core::deferred_invoke([strong_this = NonnullRefPtr(*this)]() mutable {
+        strong_this->m_has_scheduled_update = false;
+        if (!strong_this->m_has_pending_update)
+            return;
+        auto flags = strong_this->m_pending_update_flags;
+        strong_this->m_pending_update_flags = 0;
+        strong_this->m_has_pending_update = false;
+        strong_this->did_update(flags);
+    });
+}
+
 ModelIndex Model::create_index(int row, int column, const void* data) const
 {
     return ModelIndex(*this, row, column, const_cast<void*>(data));
@@ -66,6 +96,18 @@ ModelIndex Model::index(int row, int column, const ModelIndex&) const
     return create_index(row, column);
 }
 
+Vector<Variant> Model::range_data(ModelIndex const& parent, int first_row, int last_row, int first_column, int last_column, ModelRole role) const
+{
+    VERIFY(first_row >= 0 && first_column >= 0 && last_row >= first_row && last_column >= first_column);
+    Vector<Variant> range_data;
+    range_data.ensure_capacity((last_row - first_row + 1) * (last_column - first_column + 1));
+    for (int row = first_row; row <= last_row; ++row) {
+        for (int column = first_column; column <= last_column; ++column)
+            range_data.unchecked_append(data(index(row, column, parent), role));
+    }
+    return range_data;
+}
+
 bool Model::accepts_drag(const ModelIndex&, const Vector<String>&) const
 {
     return false;
@@ -66,6 +66,11 @@ public:
     virtual int column_count(const ModelIndex& = ModelIndex()) const = 0;
     virtual String column_name(int) const { return {}; }
     virtual Variant data(const ModelIndex&, ModelRole = ModelRole::Display) const = 0;
+    // Returns a rectangular block of data in row-major order. The default
+    // implementation just loops over data(); models backed by expensive
+    // storage (e.g. files or databases) can override this to service the
+    // whole block in one round trip.
+    virtual Vector<Variant> range_data(ModelIndex const& parent, int first_row, int last_row, int first_column, int last_column, ModelRole = ModelRole::Display) const;
     virtual TriState data_matches(const ModelIndex&, const Variant&) const { return TriState::Unknown; }
     virtual void invalidate();
     virtual ModelIndex parent_index(const ModelIndex&) const { return {}; }
@@ -89,6 +94,27 @@ public:
     virtual StringView drag_data_type() const { return {}; }
     virtual RefPtr<Core::MimeData> mime_data(const ModelSelection&) const;
 
+    // Between begin_batch_update() and the close of the outermost
+    // end_batch_update(), did_update() only accumulates its flags; one
+    // coalesced notification is delivered from the event loop at the end
+    // of the current turn. Bulk inserts should wrap themselves in a scope
+    // so views do their layout work once instead of once per row.
+    void begin_batch_update();
+    void end_batch_update();
+
+    class [[nodiscard]] BatchUpdate {
+    public:
+        explicit BatchUpdate(Model& model)
+            : m_model(model)
+        {
+            m_model.begin_batch_update();
+        }
+        ~BatchUpdate() { m_model.end_batch_update(); }
+
+    private:
+        Model& m_model;
+    };
+
     void register_view(Badge<AbstractView>, AbstractView&);
     void unregister_view(Badge<AbstractView>, AbstractView&);
 
@@ -197,6 +223,11 @@ private:
 
     HashTable<AbstractView*> m_views;
     HashTable<ModelClient*> m_clients;
+
+    unsigned m_batch_update_depth { 0 };
+    unsigned m_pending_update_flags { 0 };
+    bool m_has_pending_update { false };
+    bool m_has_scheduled_update { false };
 };
 
 inline ModelIndex ModelIndex::parent() const
@@ -61,6 +61,8 @@ void TableView::paint_event(PaintEvent& event)
     if (last_visible_row == -1)
         last_visible_row = model()->row_count() - 1;
 
+    cache_visible_range(first_visible_row, last_visible_row);
+
     int painted_item_index = first_visible_row;
 
     for (int row_index = first_visible_row; row_index <= last_visible_row; ++row_index) {
@@ -100,7 +102,11 @@ void TableView::paint_event(PaintEvent& event)
             if (auto* delegate = column_painting_delegate(column_index)) {
                 delegate->paint(painter, cell_rect, palette(), cell_index);
             } else {
-                auto data = cell_index.data();
+                Variant data;
+                if (auto* cached_data = cached_cell_data(cell_index))
+                    data = *cached_data;
+                else
+                    data = cell_index.data();
                 if (data.is_bitmap()) {
                     auto cell_constrained_bitmap_rect = data.as_bitmap().rect();
                     if (data.as_bitmap().rect().width() > column_width)
@@ -310,6 +310,12 @@ void TextDocument::update_views(Badge<TextDocumentLine>)
 
 void TextDocument::notify_did_change()
 {
+    // If nothing recorded which lines this change touched, be conservative
+    // and mark the tracker as untracked so consumers do a full update.
+    if (!m_change_was_tracked)
+        m_line_change_tracker.tracked = false;
+    m_change_was_tracked = false;
+
     if (m_client_notifications_enabled) {
         for (auto* client : m_clients)
             client->document_did_change();
@@ -318,6 +324,27 @@ void TextDocument::notify_did_change()
     m_regex_needs_update = true;
 }
 
+void TextDocument::did_change_lines(size_t first_line, size_t last_line, int line_delta)
+{
+    m_change_was_tracked = true;
+    auto& tracker = m_line_change_tracker;
+    if (!tracker.any_changes) {
+        tracker.any_changes = true;
+        tracker.first_changed_line = first_line;
+        tracker.last_changed_line = last_line;
+        tracker.line_delta = line_delta;
+        return;
+    }
+    tracker.first_changed_line = min(tracker.first_changed_line, first_line);
+    // If this change is above the previously recorded range, that range
+    // shifted by line_delta.
+    auto shifted_last = tracker.last_changed_line;
+    if (first_line <= tracker.last_changed_line)
+        shifted_last = (int)tracker.last_changed_line + line_delta > 0 ? tracker.last_changed_line + line_delta : 0;
+    tracker.last_changed_line = max(shifted_last, last_line);
+    tracker.line_delta += line_delta;
+}
+
 void TextDocument::set_all_cursors(const TextPosition& position)
 {
     if (m_client_notifications_enabled) {
@@ -897,10 +924,12 @@ TextPosition TextDocument::insert_at(const TextPosition& position, u32 code_poin
         new_line->append(*this, line(position.line()).code_points() + position.column(), line(position.line()).length() - position.column());
         line(position.line()).truncate(*this, position.column());
         insert_line(position.line() + 1, move(new_line));
+        did_change_lines(position.line(), position.line() + 1, 1);
         notify_did_change();
         return { position.line() + 1, 0 };
     } else {
         line(position.line()).insert(*this, position.column(), code_point);
+        did_change_lines(position.line(), position.line(), 0);
         notify_did_change();
         return { position.line(), position.column() + 1 };
     }
@@ -912,6 +941,7 @@ void TextDocument::remove(const TextRange& unnormalized_range)
         return;
 
     auto range = unnormalized_range.normalized();
+    int removed_line_count = (int)(range.end().line() - range.start().line());
 
     // First delete all the lines in between the first and last one.
     for (size_t i = range.start().line() + 1; i < range.end().line();) {
@@ -952,6 +982,7 @@ void TextDocument::remove(const TextRange& unnormalized_range)
         append_line(make<TextDocumentLine>(*this));
     }
 
+    did_change_lines(range.start().line(), range.start().line(), -removed_line_count);
     notify_did_change();
 }
 
@@ -120,6 +120,21 @@ public:
     void notify_did_change();
     void set_all_cursors(const TextPosition&);
 
+    // Accumulates the line range touched since the last reset, so that a
+    // syntax highlighter can re-highlight incrementally instead of
+    // re-tokenizing the whole document. Changes that don't go through the
+    // usual insert_at()/remove() paths mark the tracker as untracked,
+    // which means "fall back to a full rehighlight".
+    struct LineChangeTracker {
+        bool tracked { true };
+        bool any_changes { false };
+        size_t first_changed_line { 0 };
+        size_t last_changed_line { 0 }; // In post-change coordinates
+        int line_delta { 0 };
+    };
+    LineChangeTracker const& line_change_tracker() const { return m_line_change_tracker; }
+    void reset_line_change_tracker() { m_line_change_tracker = {}; }
+
     TextPosition insert_at(const TextPosition&, u32, const Client* = nullptr);
     TextPosition insert_at(const TextPosition&, const StringView&, const Client* = nullptr);
     void remove(const TextRange&);
@@ -134,6 +149,8 @@ protected:
     explicit TextDocument(Client* client);
 
 private:
+    void did_change_lines(size_t first_line, size_t last_line, int line_delta);
+
     NonnullOwnPtrVector<TextDocumentLine> m_lines;
     Vector<TextDocumentSpan> m_spans;
 
@@ -148,6 +165,9 @@ private:
 
     bool m_regex_needs_update { true };
     String m_regex_needle;
+
+    LineChangeTracker m_line_change_tracker;
+    bool m_change_was_tracked { false };
 };
 
 class TextDocumentLine {
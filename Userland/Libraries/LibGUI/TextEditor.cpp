@@ -1816,6 +1816,7 @@ void TextEditor::set_document(TextDocument& document)
     if (m_document)
         m_document->unregister_client(*this);
     m_document = document;
+    m_has_done_full_rehighlight = false;
     m_line_visual_data.clear();
     for (size_t i = 0; i < m_document->line_count(); ++i) {
         m_line_visual_data.append(make<LineVisualData>());
@@ -1832,8 +1833,17 @@ void TextEditor::rehighlight_if_needed()
 {
     if (!m_needs_rehighlight)
         return;
-    if (m_highlighter)
-        m_highlighter->rehighlight(palette());
+    if (m_highlighter) {
+        auto& tracker = document().line_change_tracker();
+        if (m_has_done_full_rehighlight && tracker.tracked && tracker.any_changes
+            && tracker.first_changed_line < document().line_count() && tracker.last_changed_line < document().line_count()) {
+            m_highlighter->rehighlight_incrementally(palette(), tracker.first_changed_line, tracker.last_changed_line, tracker.line_delta);
+        } else {
+            m_highlighter->rehighlight(palette());
+            m_has_done_full_rehighlight = true;
+        }
+    }
+    document().reset_line_change_tracker();
     m_needs_rehighlight = false;
 }
 
@@ -1847,6 +1857,7 @@ void TextEditor::set_syntax_highlighter(OwnPtr<Syntax::Highlighter> highlighter)
     if (m_highlighter)
         m_highlighter->detach();
     m_highlighter = move(highlighter);
+    m_has_done_full_rehighlight = false;
     if (m_highlighter) {
         m_highlighter->attach(*this);
         m_needs_rehighlight = true;
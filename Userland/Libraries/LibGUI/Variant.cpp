@@ -266,6 +266,11 @@ Variant::Variant(const Variant& other)
     copy_from(other);
 }
 
+Variant::Variant(Variant&& other)
+{
+    move_from(move(other));
+}
+
 void Variant::move_from(Variant&& other)
 {
     m_type = other.m_type;
@@ -18,6 +18,7 @@
 #include <LibGUI/Window.h>
 #include <LibGUI/WindowServerConnection.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/DisjointRectSet.h>
 #include <LibGfx/Font.h>
 #include <LibGfx/FontDatabase.h>
 #include <LibGfx/Palette.h>
@@ -331,9 +332,27 @@ void Widget::handle_paint_event(PaintEvent& event)
         return;
     }
 
+    auto* window_damage_rects = event.window_damage_rects();
+    if (window_damage_rects) {
+        // The damage region is finer-grained than its bounding rect, so a
+        // widget in between two disjoint dirty rects can skip painting
+        // entirely (and with it, its whole subtree).
+        if (!window_damage_rects->intersects(rect().translated(window_relative_rect().location())))
+            return;
+    }
+
     if (fill_with_background_color()) {
         Painter painter(*this);
-        painter.fill_rect(event.rect(), palette().color(background_role()));
+        auto background_color = palette().color(background_role());
+        if (window_damage_rects) {
+            auto window_relative_offset = window_relative_rect().location();
+            window_damage_rects->for_each_intersected(event.rect().translated(window_relative_offset), [&](auto& rect) {
+                painter.fill_rect(rect.translated(-window_relative_offset), background_color);
+                return IterationDecision::Continue;
+            });
+        } else {
+            painter.fill_rect(event.rect(), background_color);
+        }
     }
     paint_event(event);
     auto children_clip_rect = this->children_clip_rect();
@@ -342,6 +361,8 @@ void Widget::handle_paint_event(PaintEvent& event)
             return IterationDecision::Continue;
         if (child.relative_rect().intersects(event.rect())) {
             PaintEvent local_event(event.rect().intersected(children_clip_rect).intersected(child.relative_rect()).translated(-child.relative_position()));
+            if (window_damage_rects)
+                local_event.set_window_damage_rects(*window_damage_rects);
             child.dispatch_event(local_event, this);
         }
         return IterationDecision::Continue;
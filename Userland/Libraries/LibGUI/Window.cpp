@@ -23,6 +23,7 @@
 #include <LibGUI/WindowManagerServerConnection.h>
 #include <LibGUI/WindowServerConnection.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/DisjointRectSet.h>
 #include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -33,6 +34,43 @@ namespace GUI {
 static i32 s_next_backing_store_serial;
 static IDAllocator s_window_id_allocator;
 
+// An interactive resize churns through a backing store per resize step, and
+// allocating each one fresh is an anon_create + mmap + page-zeroing storm.
+// Instead, recycle the anonymous buffers of discarded backing stores,
+// bucketing sizes up to the next power of two so that consecutive resize
+// steps land in the same bucket and keep reusing the same pages. The contents
+// are recycled as-is, which is fine because a brand-new backing store always
+// gets a full repaint before it is shown.
+static constexpr size_t backing_store_pool_max_buffers = 4;
+static Vector<Core::AnonymousBuffer, backing_store_pool_max_buffers> s_recycled_backing_buffers;
+
+static size_t backing_buffer_bucket_size(size_t size_in_bytes)
+{
+    size_t bucket_size = PAGE_SIZE;
+    while (bucket_size < size_in_bytes)
+        bucket_size <<= 1;
+    return bucket_size;
+}
+
+static Core::AnonymousBuffer allocate_backing_buffer(size_t size_in_bytes)
+{
+    auto bucket_size = backing_buffer_bucket_size(size_in_bytes);
+    for (size_t i = 0; i < s_recycled_backing_buffers.size(); ++i) {
+        if (s_recycled_backing_buffers[i].size() == bucket_size)
+            return s_recycled_backing_buffers.unstable_take(i);
+    }
+    return Core::AnonymousBuffer::create_with_size(bucket_size);
+}
+
+static void recycle_backing_buffer(Core::AnonymousBuffer buffer)
+{
+    if (!buffer.is_valid())
+        return;
+    if (s_recycled_backing_buffers.size() >= backing_store_pool_max_buffers)
+        s_recycled_backing_buffers.take_first();
+    s_recycled_backing_buffers.append(move(buffer));
+}
+
 class WindowBackingStore {
 public:
     explicit WindowBackingStore(NonnullRefPtr<Gfx::Bitmap> bitmap)
@@ -41,6 +79,12 @@ public:
     {
     }
 
+    ~WindowBackingStore()
+    {
+        // Keep the buffer (and WindowServer's mapping of it) alive for reuse.
+        recycle_backing_buffer(m_bitmap->anonymous_buffer());
+    }
+
     Gfx::Bitmap& bitmap() { return *m_bitmap; }
     const Gfx::Bitmap& bitmap() const { return *m_bitmap; }
 
@@ -159,6 +203,9 @@ void Window::show()
         launch_origin_rect);
     m_visible = true;
 
+    if (m_unbuffered_mouse_events)
+        WindowServerConnection::the().async_set_unbuffered_mouse_events(m_window_id, true);
+
     apply_icon();
 
     m_menubar->for_each_menu([&](Menu& menu) {
@@ -422,10 +469,19 @@ void Window::handle_multi_paint_event(MultiPaintEvent& event)
         rects.append({ {}, event.window_size() });
     }
 
-    for (auto& rect : rects) {
-        PaintEvent paint_event(rect);
-        m_main_widget->dispatch_event(paint_event, this);
-    }
+    // Coalesce the damage into a disjoint region and deliver it as a single
+    // paint pass over the widget tree. Overlapping rects collapse into one,
+    // and the region lets widgets in between disjoint dirty rects skip
+    // painting entirely.
+    Gfx::DisjointRectSet damage_rects;
+    for (auto& rect : rects)
+        damage_rects.add(rect);
+    Gfx::IntRect bounding_rect;
+    for (auto& rect : damage_rects.rects())
+        bounding_rect = bounding_rect.united(rect);
+    PaintEvent paint_event(bounding_rect, event.window_size());
+    paint_event.set_window_damage_rects(damage_rects);
+    m_main_widget->dispatch_event(paint_event, this);
 
     if (m_double_buffering_enabled)
         flip(rects);
@@ -852,7 +908,7 @@ OwnPtr<WindowBackingStore> Window::create_backing_store(const Gfx::IntSize& size
     size_t pitch = Gfx::Bitmap::minimum_pitch(size.width(), format);
     size_t size_in_bytes = size.height() * pitch;
 
-    auto buffer = Core::AnonymousBuffer::create_with_size(round_up_to_power_of_two(size_in_bytes, PAGE_SIZE));
+    auto buffer = allocate_backing_buffer(size_in_bytes);
     if (!buffer.is_valid()) {
         perror("anon_create");
         return {};
@@ -985,6 +1041,16 @@ void Window::set_frameless(bool frameless)
         apply_icon();
 }
 
+void Window::set_unbuffered_mouse_events(bool unbuffered)
+{
+    if (m_unbuffered_mouse_events == unbuffered)
+        return;
+    m_unbuffered_mouse_events = unbuffered;
+    if (!is_visible())
+        return;
+    WindowServerConnection::the().async_set_unbuffered_mouse_events(m_window_id, unbuffered);
+}
+
 void Window::set_forced_shadow(bool shadow)
 {
     if (m_forced_shadow == shadow)
@@ -45,6 +45,12 @@ public:
     bool is_frameless() const { return m_frameless; }
     void set_frameless(bool);
 
+    // By default WindowServer coalesces mouse moves to one per event loop
+    // pump; windows that want the raw motion stream (e.g. drawing canvases)
+    // can opt out of that here.
+    bool is_using_unbuffered_mouse_events() const { return m_unbuffered_mouse_events; }
+    void set_unbuffered_mouse_events(bool);
+
     void set_forced_shadow(bool);
 
     bool is_resizable() const { return m_resizable; }
@@ -271,6 +277,7 @@ private:
     bool m_minimizable { true };
     bool m_fullscreen { false };
     bool m_frameless { false };
+    bool m_unbuffered_mouse_events { false };
     bool m_forced_shadow { false };
     bool m_layout_pending { false };
     bool m_visible_for_timer_purposes { true };
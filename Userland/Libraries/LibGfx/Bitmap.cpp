@@ -22,6 +22,7 @@
 #include <LibGfx/PNGLoader.h>
 #include <LibGfx/PPMLoader.h>
 #include <LibGfx/ShareableBitmap.h>
+#include <LibThreading/Mutex.h>
 #include <errno.h>
 #include <stdio.h>
 #include <sys/mman.h>
@@ -34,6 +35,44 @@ struct BackingStore {
     size_t size_in_bytes { 0 };
 };
 
+// A small cache of recently released backing stores, so surfaces that get
+// recreated at the same size over and over (compositor back buffers, window
+// frame scratch bitmaps during interactive resizes) skip the mmap and the
+// kernel's page zeroing. Only bitmaps made through try_create_pooled()
+// participate, and their pixel contents are recycled as-is -- callers promise
+// to overwrite every pixel before reading any.
+static constexpr size_t max_pooled_backing_stores = 8;
+
+struct PooledBackingStore {
+    void* data { nullptr };
+    size_t size_in_bytes { 0 };
+};
+
+static Threading::Mutex s_backing_store_pool_lock;
+static Vector<PooledBackingStore, max_pooled_backing_stores> s_backing_store_pool;
+
+static void* take_pooled_backing_store(size_t size_in_bytes)
+{
+    Threading::MutexLocker locker(s_backing_store_pool_lock);
+    for (size_t i = 0; i < s_backing_store_pool.size(); ++i) {
+        if (s_backing_store_pool[i].size_in_bytes == size_in_bytes) {
+            auto* data = s_backing_store_pool[i].data;
+            s_backing_store_pool.unstable_take(i);
+            return data;
+        }
+    }
+    return nullptr;
+}
+
+static bool return_backing_store_to_pool(void* data, size_t size_in_bytes)
+{
+    Threading::MutexLocker locker(s_backing_store_pool_lock);
+    if (s_backing_store_pool.size() >= max_pooled_backing_stores)
+        return false;
+    s_backing_store_pool.unchecked_append({ data, size_in_bytes });
+    return true;
+}
+
 size_t Bitmap::minimum_pitch(size_t physical_width, BitmapFormat format)
 {
     size_t element_size;
@@ -73,6 +112,28 @@ RefPtr<Bitmap> Bitmap::try_create(BitmapFormat format, const IntSize& size, int
     return adopt_ref(*new Bitmap(format, size, scale_factor, backing_store.value()));
 }
 
+RefPtr<Bitmap> Bitmap::try_create_pooled(BitmapFormat format, const IntSize& size, int scale_factor)
+{
+    if (size_would_overflow(format, size, scale_factor))
+        return nullptr;
+
+    const auto pitch = minimum_pitch(size.width() * scale_factor, format);
+    const auto data_size_in_bytes = size_in_bytes(pitch, size.height() * scale_factor);
+
+    BackingStore backing_store;
+    if (auto* data = take_pooled_backing_store(data_size_in_bytes)) {
+        backing_store = { data, pitch, data_size_in_bytes };
+    } else {
+        auto new_backing_store = Bitmap::try_allocate_backing_store(format, size, scale_factor);
+        if (!new_backing_store.has_value())
+            return nullptr;
+        backing_store = new_backing_store.value();
+    }
+    auto bitmap = adopt_ref(*new Bitmap(format, size, scale_factor, backing_store));
+    bitmap->m_returns_to_pool = true;
+    return bitmap;
+}
+
 RefPtr<Bitmap> Bitmap::try_create_shareable(BitmapFormat format, const IntSize& size, int scale_factor)
 {
     if (size_would_overflow(format, size, scale_factor))
@@ -459,6 +520,70 @@ RefPtr<Gfx::Bitmap> Bitmap::scaled(float sx, float sy) const
     return new_bitmap;
 }
 
+RefPtr<Gfx::Bitmap> Bitmap::mipmap(size_t level) const
+{
+    if (level == 0)
+        return this;
+
+    while (m_mipmaps.size() < level) {
+        const Bitmap& previous = m_mipmaps.is_empty() ? *this : *m_mipmaps.last();
+        if (previous.physical_width() <= 1 && previous.physical_height() <= 1)
+            return nullptr;
+        IntSize size { max(previous.physical_width() / 2, 1), max(previous.physical_height() / 2, 1) };
+        auto next = Bitmap::try_create(BitmapFormat::BGRA8888, size, 1);
+        if (!next)
+            return nullptr;
+        for (int y = 0; y < size.height(); ++y) {
+            int y0 = min(2 * y, previous.physical_height() - 1);
+            int y1 = min(2 * y + 1, previous.physical_height() - 1);
+            for (int x = 0; x < size.width(); ++x) {
+                int x0 = min(2 * x, previous.physical_width() - 1);
+                int x1 = min(2 * x + 1, previous.physical_width() - 1);
+                auto a = previous.get_pixel(x0, y0);
+                auto b = previous.get_pixel(x1, y0);
+                auto c = previous.get_pixel(x0, y1);
+                auto d = previous.get_pixel(x1, y1);
+                Color average(
+                    (a.red() + b.red() + c.red() + d.red() + 2) >> 2,
+                    (a.green() + b.green() + c.green() + d.green() + 2) >> 2,
+                    (a.blue() + b.blue() + c.blue() + d.blue() + 2) >> 2,
+                    (a.alpha() + b.alpha() + c.alpha() + d.alpha() + 2) >> 2);
+                next->set_pixel(x, y, average);
+            }
+        }
+        m_mipmaps.append(move(next));
+    }
+    return m_mipmaps[level - 1];
+}
+
+RefPtr<Gfx::Bitmap> Bitmap::scaled_to_fit(IntSize const& max_size) const
+{
+    if (max_size.is_empty() || width() <= 0 || height() <= 0)
+        return nullptr;
+
+    float scale = min((float)max_size.width() / (float)width(), (float)max_size.height() / (float)height());
+    if (scale >= 1.0f)
+        return this;
+
+    int target_width = max((int)(width() * scale), 1);
+    int target_height = max((int)(height() * scale), 1);
+
+    // Walk down the mipmap chain until the next level would undershoot the
+    // target, then let the bilinear scaler cover the remaining (< 2x) step.
+    RefPtr<Gfx::Bitmap> current = this;
+    size_t level = 0;
+    while (current->physical_width() / 2 >= target_width && current->physical_height() / 2 >= target_height) {
+        auto next = mipmap(++level);
+        if (!next)
+            break;
+        current = move(next);
+    }
+
+    if (current->physical_width() == target_width && current->physical_height() == target_height)
+        return current;
+    return current->scaled((float)target_width / (float)current->physical_width(), (float)target_height / (float)current->physical_height());
+}
+
 RefPtr<Gfx::Bitmap> Bitmap::cropped(Gfx::IntRect crop) const
 {
     auto new_bitmap = Gfx::Bitmap::try_create(format(), { crop.width(), crop.height() }, 1);
@@ -496,8 +621,10 @@ RefPtr<Bitmap> Bitmap::to_bitmap_backed_by_anonymous_buffer() const
 Bitmap::~Bitmap()
 {
     if (m_needs_munmap) {
-        int rc = munmap(m_data, size_in_bytes());
-        VERIFY(rc == 0);
+        if (!m_returns_to_pool || !return_backing_store_to_pool(m_data, size_in_bytes())) {
+            int rc = munmap(m_data, size_in_bytes());
+            VERIFY(rc == 0);
+        }
     }
     m_data = nullptr;
     delete[] m_palette;
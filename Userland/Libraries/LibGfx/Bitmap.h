@@ -91,6 +91,11 @@ enum RotationDirection {
 class Bitmap : public RefCounted<Bitmap> {
 public:
     [[nodiscard]] static RefPtr<Bitmap> try_create(BitmapFormat, const IntSize&, int intrinsic_scale = 1);
+    // Like try_create, but the backing store may be recycled from a recently
+    // destroyed pooled bitmap and the pixel contents are NOT zeroed. Only use
+    // this for transient surfaces that are fully overwritten before any pixel
+    // is read back.
+    [[nodiscard]] static RefPtr<Bitmap> try_create_pooled(BitmapFormat, const IntSize&, int intrinsic_scale = 1);
     [[nodiscard]] static RefPtr<Bitmap> try_create_shareable(BitmapFormat, const IntSize&, int intrinsic_scale = 1);
     [[nodiscard]] static RefPtr<Bitmap> try_create_wrapper(BitmapFormat, const IntSize&, int intrinsic_scale, size_t pitch, void*);
     [[nodiscard]] static RefPtr<Bitmap> try_load_from_file(String const& path, int scale_factor = 1);
@@ -114,6 +119,17 @@ public:
     [[nodiscard]] RefPtr<Gfx::Bitmap> flipped(Gfx::Orientation) const;
     [[nodiscard]] RefPtr<Gfx::Bitmap> scaled(int sx, int sy) const;
     [[nodiscard]] RefPtr<Gfx::Bitmap> scaled(float sx, float sy) const;
+    // Returns the n'th level of the lazily built mipmap chain, where each
+    // level is a 2x2 box average of the previous one and level 0 is the
+    // bitmap itself. The chain snapshots the pixels at the time of the first
+    // call and is not invalidated by later painting; it's meant for decoded
+    // images that won't change anymore.
+    [[nodiscard]] RefPtr<Gfx::Bitmap> mipmap(size_t level) const;
+    // High-quality minification for thumbnails: walks down the mipmap chain
+    // to within 2x of the requested size and bilinearly interpolates the
+    // rest of the way, so every source pixel contributes to the result
+    // instead of most being skipped over.
+    [[nodiscard]] RefPtr<Gfx::Bitmap> scaled_to_fit(IntSize const&) const;
     [[nodiscard]] RefPtr<Gfx::Bitmap> cropped(Gfx::IntRect) const;
     [[nodiscard]] RefPtr<Bitmap> to_bitmap_backed_by_anonymous_buffer() const;
     [[nodiscard]] ByteBuffer serialize_to_byte_buffer() const;
@@ -251,8 +267,10 @@ private:
     size_t m_pitch { 0 };
     BitmapFormat m_format { BitmapFormat::Invalid };
     bool m_needs_munmap { false };
+    bool m_returns_to_pool { false };
     bool m_volatile { false };
     Core::AnonymousBuffer m_buffer;
+    mutable Vector<RefPtr<Gfx::Bitmap>> m_mipmaps;
 };
 
 inline u8* Bitmap::scanline_u8(int y)
@@ -75,16 +75,31 @@ BitmapFont::BitmapFont(String name, String family, unsigned* rows, u8* widths, b
 
     m_glyph_count = glyph_count_by_type(m_type);
 
-    if (!m_fixed_width) {
-        u8 maximum = 0;
-        u8 minimum = 255;
-        for (size_t i = 0; i < m_glyph_count; ++i) {
-            minimum = min(minimum, m_glyph_widths[i]);
-            maximum = max(maximum, m_glyph_widths[i]);
-        }
-        m_min_glyph_width = minimum;
-        m_max_glyph_width = max(maximum, m_glyph_width);
+    // NOTE: The width metrics of variable-width fonts are computed lazily in
+    //       ensure_glyph_width_metrics(), so constructing a font doesn't have
+    //       to touch the (possibly not-yet-paged-in) width table at all.
+}
+
+void BitmapFont::ensure_glyph_width_metrics() const
+{
+    if (m_glyph_width_metrics_computed)
+        return;
+    m_glyph_width_metrics_computed = true;
+
+    if (m_fixed_width) {
+        m_min_glyph_width = m_glyph_width;
+        m_max_glyph_width = m_glyph_width;
+        return;
+    }
+
+    u8 maximum = 0;
+    u8 minimum = 255;
+    for (size_t i = 0; i < m_glyph_count; ++i) {
+        minimum = min(minimum, m_glyph_widths[i]);
+        maximum = max(maximum, m_glyph_widths[i]);
     }
+    m_min_glyph_width = minimum;
+    m_max_glyph_width = max(maximum, m_glyph_width);
 }
 
 BitmapFont::~BitmapFont()
@@ -286,6 +301,7 @@ void BitmapFont::set_type(FontTypes type)
     size_t new_glyph_count = glyph_count_by_type(type);
     if (new_glyph_count <= m_glyph_count) {
         m_glyph_count = new_glyph_count;
+        m_glyph_width_metrics_computed = false;
         return;
     }
 
@@ -306,6 +322,7 @@ void BitmapFont::set_type(FontTypes type)
     m_glyph_count = new_glyph_count;
     m_rows = new_rows;
     m_glyph_widths = new_widths;
+    m_glyph_width_metrics_computed = false;
 }
 
 String BitmapFont::qualified_name() const
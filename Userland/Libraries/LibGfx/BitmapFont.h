@@ -64,8 +64,16 @@ public:
 
     u8 raw_glyph_width(size_t ch) const { return m_glyph_widths[ch]; }
 
-    u8 min_glyph_width() const override { return m_min_glyph_width; }
-    u8 max_glyph_width() const override { return m_max_glyph_width; }
+    u8 min_glyph_width() const override
+    {
+        ensure_glyph_width_metrics();
+        return m_min_glyph_width;
+    }
+    u8 max_glyph_width() const override
+    {
+        ensure_glyph_width_metrics();
+        return m_max_glyph_width;
+    }
     u8 glyph_fixed_width() const override { return m_glyph_width; }
 
     u8 baseline() const override { return m_baseline; }
@@ -99,6 +107,7 @@ public:
     {
         VERIFY(m_glyph_widths);
         m_glyph_widths[ch] = width;
+        m_glyph_width_metrics_computed = false;
     }
 
     size_t glyph_count() const override { return m_glyph_count; }
@@ -126,6 +135,11 @@ private:
     void update_x_height() { m_x_height = m_baseline - m_mean_line; };
     int glyph_or_emoji_width_for_variable_width_font(u32 code_point) const;
 
+    // Scanning the width table pages the font file in from disk, so it's
+    // deferred until somebody actually asks for these metrics. This keeps
+    // loading a font as cheap as reading its header.
+    void ensure_glyph_width_metrics() const;
+
     String m_name;
     String m_family;
     FontTypes m_type;
@@ -138,8 +152,8 @@ private:
     u8 m_glyph_width { 0 };
     u8 m_glyph_height { 0 };
     u8 m_x_height { 0 };
-    u8 m_min_glyph_width { 0 };
-    u8 m_max_glyph_width { 0 };
+    mutable u8 m_min_glyph_width { 0 };
+    mutable u8 m_max_glyph_width { 0 };
     u8 m_glyph_spacing { 0 };
     u8 m_baseline { 0 };
     u8 m_mean_line { 0 };
@@ -148,6 +162,7 @@ private:
 
     bool m_fixed_width { false };
     bool m_owns_arrays { false };
+    mutable bool m_glyph_width_metrics_computed { false };
 };
 
 }
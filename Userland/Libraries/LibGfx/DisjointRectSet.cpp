@@ -8,49 +8,290 @@
 
 namespace Gfx {
 
-bool DisjointRectSet::add_no_shatter(const IntRect& new_rect)
+// The merge machinery below works on one band at a time. A band is a maximal
+// run of rects sharing the same top y (and, by the class invariant, the same
+// height); bottoms are exclusive while merging so "touching" means equal.
+
+static size_t band_end(Span<const IntRect> rects, size_t start)
 {
-    if (new_rect.is_empty())
-        return false;
-    for (auto& rect : m_rects) {
-        if (rect.contains(new_rect))
-            return false;
+    size_t end = start;
+    while (end < rects.size() && rects[end].y() == rects[start].y())
+        ++end;
+    return end;
+}
+
+// Appends one band worth of output rects for the y range [top, bottom) and
+// coalesces it with the previous band if both cover identical x spans and
+// touch vertically, keeping the representation canonical.
+class BandWriter {
+public:
+    explicit BandWriter(Vector<IntRect, 32>& output)
+        : m_output(output)
+    {
+    }
+
+    void append(int x, int right, int top, int bottom)
+    {
+        m_output.append({ x, top, right - x, bottom - top });
+    }
+
+    void begin_band() { m_band_start = m_output.size(); }
+
+    void end_band()
+    {
+        size_t band_size = m_output.size() - m_band_start;
+        if (band_size == 0)
+            return;
+        size_t previous_size = m_band_start - m_previous_start;
+        if (previous_size == band_size && m_previous_start != m_band_start) {
+            auto& first_previous = m_output[m_previous_start];
+            auto& first_current = m_output[m_band_start];
+            if (first_previous.y() + first_previous.height() == first_current.y()) {
+                bool same_spans = true;
+                for (size_t i = 0; i < band_size; ++i) {
+                    auto& previous = m_output[m_previous_start + i];
+                    auto& current = m_output[m_band_start + i];
+                    if (previous.x() != current.x() || previous.width() != current.width()) {
+                        same_spans = false;
+                        break;
+                    }
+                }
+                if (same_spans) {
+                    int new_bottom = first_current.y() + first_current.height();
+                    for (size_t i = 0; i < band_size; ++i) {
+                        auto& previous = m_output[m_previous_start + i];
+                        previous.set_height(new_bottom - previous.y());
+                    }
+                    m_output.resize(m_band_start);
+                    return;
+                }
+            }
+        }
+        m_previous_start = m_band_start;
+    }
+
+private:
+    Vector<IntRect, 32>& m_output;
+    size_t m_previous_start { 0 };
+    size_t m_band_start { 0 };
+};
+
+static void emit_band(BandWriter& writer, Span<const IntRect> band, int top, int bottom)
+{
+    writer.begin_band();
+    for (auto& rect : band)
+        writer.append(rect.x(), rect.x() + rect.width(), top, bottom);
+    writer.end_band();
+}
+
+static void emit_union_band(BandWriter& writer, Span<const IntRect> a, Span<const IntRect> b, int top, int bottom)
+{
+    writer.begin_band();
+    size_t i = 0, j = 0;
+    int x = 0, right = 0;
+    bool have_span = false;
+    while (i < a.size() || j < b.size()) {
+        const IntRect* next;
+        if (j >= b.size() || (i < a.size() && a[i].x() <= b[j].x()))
+            next = &a[i++];
+        else
+            next = &b[j++];
+        int next_right = next->x() + next->width();
+        if (have_span && next->x() <= right) {
+            right = max(right, next_right);
+        } else {
+            if (have_span)
+                writer.append(x, right, top, bottom);
+            x = next->x();
+            right = next_right;
+            have_span = true;
+        }
     }
+    if (have_span)
+        writer.append(x, right, top, bottom);
+    writer.end_band();
+}
+
+static void emit_intersection_band(BandWriter& writer, Span<const IntRect> a, Span<const IntRect> b, int top, int bottom)
+{
+    writer.begin_band();
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        int left = max(a[i].x(), b[j].x());
+        int a_right = a[i].x() + a[i].width();
+        int b_right = b[j].x() + b[j].width();
+        int right = min(a_right, b_right);
+        if (left < right)
+            writer.append(left, right, top, bottom);
+        if (a_right <= b_right)
+            ++i;
+        else
+            ++j;
+    }
+    writer.end_band();
+}
 
-    m_rects.append(new_rect);
-    return true;
+static void emit_subtraction_band(BandWriter& writer, Span<const IntRect> a, Span<const IntRect> b, int top, int bottom)
+{
+    writer.begin_band();
+    size_t j = 0;
+    for (auto& rect : a) {
+        int x = rect.x();
+        int right = rect.x() + rect.width();
+        while (j < b.size() && b[j].x() + b[j].width() <= x)
+            ++j;
+        for (size_t k = j; k < b.size() && b[k].x() < right; ++k) {
+            if (b[k].x() > x)
+                writer.append(x, b[k].x(), top, bottom);
+            x = max(x, b[k].x() + b[k].width());
+            if (x >= right)
+                break;
+        }
+        if (x < right)
+            writer.append(x, right, top, bottom);
+    }
+    writer.end_band();
 }
 
-void DisjointRectSet::shatter()
+Vector<IntRect, 32> DisjointRectSet::apply(Op op, Span<const IntRect> a, Span<const IntRect> b)
 {
+    if (a.is_empty()) {
+        Vector<IntRect, 32> result;
+        if (op == Op::Union)
+            result.append(b.data(), b.size());
+        return result;
+    }
+    if (b.is_empty()) {
+        Vector<IntRect, 32> result;
+        if (op != Op::Intersection)
+            result.append(a.data(), a.size());
+        return result;
+    }
+
     Vector<IntRect, 32> output;
-    output.ensure_capacity(m_rects.size());
-    bool pass_had_intersections = false;
-    do {
-        pass_had_intersections = false;
-        output.clear_with_capacity();
-        for (size_t i = 0; i < m_rects.size(); ++i) {
-            auto& r1 = m_rects[i];
-            for (size_t j = 0; j < m_rects.size(); ++j) {
-                if (i == j)
-                    continue;
-                auto& r2 = m_rects[j];
-                if (!r1.intersects(r2))
-                    continue;
-                pass_had_intersections = true;
-                auto pieces = r1.shatter(r2);
-                for (auto& piece : pieces)
-                    output.append(piece);
-                m_rects.remove(i);
-                for (; i < m_rects.size(); ++i)
-                    output.append(m_rects[i]);
-                goto next_pass;
-            }
-            output.append(r1);
+    BandWriter writer(output);
+
+    size_t ai = 0, bi = 0;
+    int a_top = a[0].y();
+    int b_top = b[0].y();
+
+    while (ai < a.size() && bi < b.size()) {
+        size_t a_end = band_end(a, ai);
+        size_t b_end = band_end(b, bi);
+        auto a_band = a.slice(ai, a_end - ai);
+        auto b_band = b.slice(bi, b_end - bi);
+        int a_bottom = a[ai].y() + a[ai].height();
+        int b_bottom = b[bi].y() + b[bi].height();
+
+        if (a_bottom <= b_top) {
+            if (op != Op::Intersection)
+                emit_band(writer, a_band, a_top, a_bottom);
+            ai = a_end;
+            if (ai < a.size())
+                a_top = a[ai].y();
+            continue;
+        }
+        if (b_bottom <= a_top) {
+            if (op == Op::Union)
+                emit_band(writer, b_band, b_top, b_bottom);
+            bi = b_end;
+            if (bi < b.size())
+                b_top = b[bi].y();
+            continue;
+        }
+
+        // The bands overlap vertically; emit the non-overlapping top part,
+        // then the combined overlap.
+        if (a_top < b_top) {
+            if (op != Op::Intersection)
+                emit_band(writer, a_band, a_top, b_top);
+            a_top = b_top;
+        } else if (b_top < a_top) {
+            if (op == Op::Union)
+                emit_band(writer, b_band, b_top, a_top);
+            b_top = a_top;
+        }
+        int bottom = min(a_bottom, b_bottom);
+        switch (op) {
+        case Op::Union:
+            emit_union_band(writer, a_band, b_band, a_top, bottom);
+            break;
+        case Op::Intersection:
+            emit_intersection_band(writer, a_band, b_band, a_top, bottom);
+            break;
+        case Op::Subtraction:
+            emit_subtraction_band(writer, a_band, b_band, a_top, bottom);
+            break;
         }
-    next_pass:
-        swap(output, m_rects);
-    } while (pass_had_intersections);
+        a_top = b_top = bottom;
+        if (a_bottom == bottom) {
+            ai = a_end;
+            if (ai < a.size())
+                a_top = a[ai].y();
+        }
+        if (b_bottom == bottom) {
+            bi = b_end;
+            if (bi < b.size())
+                b_top = b[bi].y();
+        }
+    }
+
+    if (op != Op::Intersection) {
+        while (ai < a.size()) {
+            size_t a_end = band_end(a, ai);
+            emit_band(writer, a.slice(ai, a_end - ai), a_top, a[ai].y() + a[ai].height());
+            ai = a_end;
+            if (ai < a.size())
+                a_top = a[ai].y();
+        }
+    }
+    if (op == Op::Union) {
+        while (bi < b.size()) {
+            size_t b_end = band_end(b, bi);
+            emit_band(writer, b.slice(bi, b_end - bi), b_top, b[bi].y() + b[bi].height());
+            bi = b_end;
+            if (bi < b.size())
+                b_top = b[bi].y();
+        }
+    }
+
+    return output;
+}
+
+// Turns an arbitrary pile of (possibly overlapping) rects into a banded set
+// by merging halves recursively, so n rects cost O(n log n) instead of the
+// O(n^2) of adding them to the set one by one.
+Vector<IntRect, 32> DisjointRectSet::union_all(Span<const IntRect> rects)
+{
+    if (rects.size() <= 1) {
+        Vector<IntRect, 32> result;
+        result.append(rects.data(), rects.size());
+        return result;
+    }
+    auto left = union_all(rects.slice(0, rects.size() / 2));
+    auto right = union_all(rects.slice(rects.size() / 2));
+    return apply(Op::Union, left.span(), right.span());
+}
+
+void DisjointRectSet::add(const IntRect& rect)
+{
+    if (rect.is_empty())
+        return;
+    if (m_rects.is_empty()) {
+        m_rects.append(rect);
+        return;
+    }
+    IntRect rects[] = { rect };
+    m_rects = apply(Op::Union, m_rects.span(), { rects, 1 });
+}
+
+void DisjointRectSet::add_many_internal(Vector<IntRect, 32>&& new_rects)
+{
+    auto banded = union_all(new_rects.span());
+    if (m_rects.is_empty())
+        m_rects = move(banded);
+    else
+        m_rects = apply(Op::Union, m_rects.span(), banded.span());
 }
 
 void DisjointRectSet::move_by(int dx, int dy)
@@ -64,20 +305,15 @@ bool DisjointRectSet::contains(const IntRect& rect) const
     if (is_empty() || rect.is_empty())
         return false;
 
-    // TODO: This could use some optimization
-    DisjointRectSet remainder(rect);
-    for (auto& r : m_rects) {
-        auto shards = remainder.shatter(r);
-        if (shards.is_empty())
-            return true;
-        remainder = move(shards);
-    }
-    return false;
+    IntRect rects[] = { rect };
+    return apply(Op::Subtraction, { rects, 1 }, m_rects.span()).is_empty();
 }
 
 bool DisjointRectSet::intersects(const IntRect& rect) const
 {
     for (auto& r : m_rects) {
+        if (r.top() > rect.bottom())
+            break;
         if (r.intersects(rect))
             return true;
     }
@@ -91,6 +327,8 @@ bool DisjointRectSet::intersects(const DisjointRectSet& rects) const
 
     for (auto& r : m_rects) {
         for (auto& r2 : rects.m_rects) {
+            if (r2.top() > r.bottom())
+                break;
             if (r.intersects(r2))
                 return true;
         }
@@ -100,14 +338,12 @@ bool DisjointRectSet::intersects(const DisjointRectSet& rects) const
 
 DisjointRectSet DisjointRectSet::intersected(const IntRect& rect) const
 {
+    if (is_empty() || rect.is_empty())
+        return {};
+
+    IntRect rects[] = { rect };
     DisjointRectSet intersected_rects;
-    intersected_rects.m_rects.ensure_capacity(m_rects.capacity());
-    for (auto& r : m_rects) {
-        auto intersected_rect = r.intersected(rect);
-        if (!intersected_rect.is_empty())
-            intersected_rects.m_rects.append(intersected_rect);
-    }
-    // Since there should be no overlaps, we don't need to call shatter()
+    intersected_rects.m_rects = apply(Op::Intersection, m_rects.span(), { rects, 1 });
     return intersected_rects;
 }
 
@@ -119,15 +355,7 @@ DisjointRectSet DisjointRectSet::intersected(const DisjointRectSet& rects) const
         return {};
 
     DisjointRectSet intersected_rects;
-    intersected_rects.m_rects.ensure_capacity(m_rects.capacity());
-    for (auto& r : m_rects) {
-        for (auto& r2 : rects.m_rects) {
-            auto intersected_rect = r.intersected(r2);
-            if (!intersected_rect.is_empty())
-                intersected_rects.m_rects.append(intersected_rect);
-        }
-    }
-    // Since there should be no overlaps, we don't need to call shatter()
+    intersected_rects.m_rects = apply(Op::Intersection, m_rects.span(), rects.m_rects.span());
     return intersected_rects;
 }
 
@@ -136,12 +364,9 @@ DisjointRectSet DisjointRectSet::shatter(const IntRect& hammer) const
     if (hammer.is_empty())
         return clone();
 
+    IntRect rects[] = { hammer };
     DisjointRectSet shards;
-    for (auto& rect : m_rects) {
-        for (auto& shard : rect.shatter(hammer))
-            shards.add_no_shatter(shard);
-    }
-    // Since there should be no overlaps, we don't need to call shatter()
+    shards.m_rects = apply(Op::Subtraction, m_rects.span(), { rects, 1 });
     return shards;
 }
 
@@ -149,19 +374,11 @@ DisjointRectSet DisjointRectSet::shatter(const DisjointRectSet& hammer) const
 {
     if (this == &hammer)
         return {};
-    if (hammer.is_empty() || !intersects(hammer))
+    if (hammer.is_empty())
         return clone();
 
-    // TODO: This could use some optimization
-    DisjointRectSet shards = shatter(hammer.m_rects[0]);
-    auto rects_count = hammer.m_rects.size();
-    for (size_t i = 1; i < rects_count && !shards.is_empty(); i++) {
-        if (hammer.m_rects[i].intersects(shards.m_rects)) {
-            auto shattered = shards.shatter(hammer.m_rects[i]);
-            shards = move(shattered);
-        }
-    }
-    // Since there should be no overlaps, we don't need to call shatter()
+    DisjointRectSet shards;
+    shards.m_rects = apply(Op::Subtraction, m_rects.span(), hammer.m_rects.span());
     return shards;
 }
 
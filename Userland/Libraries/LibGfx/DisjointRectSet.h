@@ -6,12 +6,19 @@
 
 #pragma once
 
+#include <AK/Span.h>
 #include <AK/Vector.h>
 #include <LibGfx/Point.h>
 #include <LibGfx/Rect.h>
 
 namespace Gfx {
 
+// A set of non-overlapping rectangles, stored as horizontal bands in the
+// classic region-algebra representation: rects are sorted by top y, rects
+// with the same top y also share the same height (one band), and within a
+// band they are sorted by x and never touch. This makes union, intersection
+// and subtraction single merge passes over two sets instead of the quadratic
+// shattering the old implementation did.
 class DisjointRectSet {
 public:
     DisjointRectSet(const DisjointRectSet&) = delete;
@@ -22,7 +29,8 @@ public:
 
     DisjointRectSet(const IntRect& rect)
     {
-        m_rects.append(rect);
+        if (!rect.is_empty())
+            m_rects.append(rect);
     }
 
     DisjointRectSet(DisjointRectSet&&) = default;
@@ -41,33 +49,28 @@ public:
         move_by(delta.x(), delta.y());
     }
 
-    void add(const IntRect& rect)
-    {
-        if (add_no_shatter(rect) && m_rects.size() > 1)
-            shatter();
-    }
+    void add(const IntRect& rect);
 
     template<typename Container>
     void add_many(const Container& rects)
     {
-        bool added = false;
+        Vector<IntRect, 32> new_rects;
         for (const auto& rect : rects) {
-            if (add_no_shatter(rect))
-                added = true;
+            if (!rect.is_empty())
+                new_rects.append(rect);
         }
-        if (added && m_rects.size() > 1)
-            shatter();
+        if (!new_rects.is_empty())
+            add_many_internal(move(new_rects));
     }
 
     void add(const DisjointRectSet& rect_set)
     {
         if (this == &rect_set)
             return;
-        if (m_rects.is_empty()) {
+        if (m_rects.is_empty())
             m_rects = rect_set.m_rects;
-        } else {
-            add_many(rect_set.rects());
-        }
+        else
+            m_rects = apply(Op::Union, m_rects.span(), rect_set.m_rects.span());
     }
 
     DisjointRectSet shatter(const IntRect&) const;
@@ -85,6 +88,8 @@ public:
         if (is_empty() || rect.is_empty())
             return IterationDecision::Continue;
         for (auto& r : m_rects) {
+            if (r.top() > rect.bottom())
+                break;
             auto intersected_rect = r.intersected(rect);
             if (intersected_rect.is_empty())
                 continue;
@@ -109,6 +114,8 @@ public:
         } else {
             for (auto& r : m_rects) {
                 for (auto& r2 : rects.m_rects) {
+                    if (r2.top() > r.bottom())
+                        break;
                     auto intersected_rect = r.intersected(r2);
                     if (intersected_rect.is_empty())
                         continue;
@@ -141,8 +148,15 @@ public:
     }
 
 private:
-    bool add_no_shatter(const IntRect&);
-    void shatter();
+    enum class Op {
+        Union,
+        Intersection,
+        Subtraction,
+    };
+
+    static Vector<IntRect, 32> apply(Op, Span<const IntRect> a, Span<const IntRect> b);
+    static Vector<IntRect, 32> union_all(Span<const IntRect>);
+    void add_many_internal(Vector<IntRect, 32>&&);
 
     Vector<IntRect, 32> m_rects;
 };
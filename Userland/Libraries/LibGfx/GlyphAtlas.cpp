@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
+#include <AK/String.h>
+#include <LibGfx/Font.h>
+#include <LibGfx/GlyphAtlas.h>
+
+namespace Gfx {
+
+// Covers Latin-1 and Latin Extended-A, which is practically all of the
+// traffic from terminals and editors. Anything above falls back to the
+// per-glyph paint path.
+static constexpr u32 atlas_code_point_limit = 0x180;
+
+GlyphAtlas const* GlyphAtlas::for_font(Font const& font)
+{
+    // Keyed by qualified name rather than by address, so clones of the same
+    // font share an atlas and a recycled Font address can't pick up stale
+    // glyphs. An entry holding a null atlas remembers that a font could not
+    // be represented.
+    static HashMap<String, OwnPtr<GlyphAtlas>>* s_atlases;
+    if (!s_atlases)
+        s_atlases = new HashMap<String, OwnPtr<GlyphAtlas>>;
+
+    auto name = font.qualified_name();
+    auto it = s_atlases->find(name);
+    if (it == s_atlases->end()) {
+        s_atlases->set(name, try_create(font));
+        it = s_atlases->find(name);
+    }
+    return it->value.ptr();
+}
+
+OwnPtr<GlyphAtlas> GlyphAtlas::try_create(Font const& font)
+{
+    u32 code_point_count = min(atlas_code_point_limit, (u32)font.glyph_count());
+    if (code_point_count == 0)
+        return {};
+
+    Vector<GlyphInfo> glyphs;
+    glyphs.resize(code_point_count);
+
+    // Glyphs are laid out in a single strip; they all share the font's
+    // glyph height.
+    int total_width = 0;
+    for (u32 code_point = 0; code_point < code_point_count; ++code_point) {
+        if (!font.contains_glyph(code_point))
+            continue;
+        auto glyph = font.glyph(code_point);
+        // Only fonts whose glyphs are coverage bitmasks are atlased;
+        // per-glyph blending for vector fonts stays on the regular path.
+        if (!glyph.is_glyph_bitmap())
+            return {};
+        auto& info = glyphs[code_point];
+        info.rect = { total_width, 0, glyph.glyph_bitmap().width(), glyph.glyph_bitmap().height() };
+        info.left_bearing = glyph.left_bearing();
+        total_width += info.rect.width();
+    }
+    if (total_width == 0)
+        return {};
+
+    auto bitmap = Bitmap::try_create(BitmapFormat::BGRA8888, { total_width, font.glyph_height() });
+    if (!bitmap)
+        return {};
+
+    for (u32 code_point = 0; code_point < code_point_count; ++code_point) {
+        auto& info = glyphs[code_point];
+        if (info.rect.is_empty())
+            continue;
+        auto glyph_bitmap = font.glyph(code_point).glyph_bitmap();
+        for (int y = 0; y < info.rect.height(); ++y) {
+            auto* scanline = bitmap->scanline(y);
+            for (int x = 0; x < info.rect.width(); ++x) {
+                if (glyph_bitmap.bit_at(x, y))
+                    scanline[info.rect.x() + x] = Color(Color::White).value();
+            }
+        }
+    }
+
+    return adopt_own(*new GlyphAtlas(bitmap.release_nonnull(), move(glyphs)));
+}
+
+}
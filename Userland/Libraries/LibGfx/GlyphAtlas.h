@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Forward.h>
+#include <LibGfx/Rect.h>
+
+namespace Gfx {
+
+// A per-font cache that renders the glyphs a font is likely to draw once
+// into a single bitmap, premultiplied as opaque white on transparent. Text
+// runs can then be blitted with plain row loops instead of setting up a
+// clipped per-glyph draw and testing individual bits for every character.
+class GlyphAtlas {
+public:
+    struct GlyphInfo {
+        IntRect rect; // Location of the glyph in the atlas bitmap.
+        int left_bearing { 0 };
+    };
+
+    // Returns nullptr for fonts the atlas cannot represent. Vector fonts
+    // already cache their rasterized glyphs per size and keep going through
+    // the regular per-glyph paint path.
+    static GlyphAtlas const* for_font(Font const&);
+
+    Bitmap const& bitmap() const { return *m_bitmap; }
+
+    // Returns nullptr if the code point is outside the atlas (or the font);
+    // the caller is expected to fall back to the per-glyph path.
+    GlyphInfo const* glyph_info(u32 code_point) const
+    {
+        if (code_point >= m_glyphs.size())
+            return nullptr;
+        auto& info = m_glyphs[code_point];
+        if (info.rect.is_empty())
+            return nullptr;
+        return &info;
+    }
+
+private:
+    GlyphAtlas(NonnullRefPtr<Bitmap> bitmap, Vector<GlyphInfo> glyphs)
+        : m_bitmap(move(bitmap))
+        , m_glyphs(move(glyphs))
+    {
+    }
+
+    static OwnPtr<GlyphAtlas> try_create(Font const&);
+
+    NonnullRefPtr<Bitmap> m_bitmap;
+    Vector<GlyphInfo> m_glyphs; // Indexed by code point.
+};
+
+}
@@ -12,10 +12,13 @@
 #include <AK/MappedFile.h>
 #include <AK/Math.h>
 #include <AK/MemoryStream.h>
+#include <AK/SIMD.h>
+#include <AK/StdLibExtras.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/JPGLoader.h>
+#include <LibGfx/ParallelPainting.h>
 
 #define JPG_INVALID 0X0000
 
@@ -841,29 +844,60 @@ static bool skip_marker_with_length(InputMemoryStream& stream)
     return !stream.handle_any_error();
 }
 
-static void dequantize(JPGLoadingContext& context, Vector<Macroblock>& macroblocks)
+static void dequantize_mcu_row(const JPGLoadingContext& context, Vector<Macroblock>& macroblocks, u32 vcursor)
 {
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
-        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
-            for (u32 i = 0; i < context.component_count; i++) {
-                auto& component = context.components[i];
-                const u32* table = component.qtable_id == 0 ? context.luma_table : context.chroma_table;
-                for (u32 vfactor_i = 0; vfactor_i < component.vsample_factor; vfactor_i++) {
-                    for (u32 hfactor_i = 0; hfactor_i < component.hsample_factor; hfactor_i++) {
-                        u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
-                        Macroblock& block = macroblocks[mb_index];
-                        int* block_component = get_component(block, i);
-                        for (u32 k = 0; k < 64; k++)
-                            block_component[k] *= table[k];
-                    }
+    for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
+        for (u32 i = 0; i < context.component_count; i++) {
+            auto& component = context.components[i];
+            const u32* table = component.qtable_id == 0 ? context.luma_table : context.chroma_table;
+            for (u32 vfactor_i = 0; vfactor_i < component.vsample_factor; vfactor_i++) {
+                for (u32 hfactor_i = 0; hfactor_i < component.hsample_factor; hfactor_i++) {
+                    u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
+                    Macroblock& block = macroblocks[mb_index];
+                    int* block_component = get_component(block, i);
+                    for (u32 k = 0; k < 64; k++)
+                        block_component[k] *= table[k];
                 }
             }
         }
     }
 }
 
-static void inverse_dct(const JPGLoadingContext& context, Vector<Macroblock>& macroblocks)
+// The 256-bit vectors are passed by reference so that no function signature
+// involves a vector type wider than the baseline target supports; GCC warns
+// (-Wpsabi) about the ABI of such signatures even when they are always inlined.
+ALWAYS_INLINE static void load_row_as_floats(const i32* row, AK::SIMD::f32x8& values)
+{
+    AK::SIMD::i32x8 coefficients;
+    __builtin_memcpy(&coefficients, row, sizeof(coefficients));
+    values = __builtin_convertvector(coefficients, AK::SIMD::f32x8);
+}
+
+ALWAYS_INLINE static void store_row_truncated(i32* row, AK::SIMD::f32x8 const& values)
 {
+    auto truncated = __builtin_convertvector(values, AK::SIMD::i32x8);
+    __builtin_memcpy(row, &truncated, sizeof(truncated));
+}
+
+ALWAYS_INLINE static void transpose_block(i32* block_component)
+{
+    for (u32 i = 0; i < 8; ++i) {
+        for (u32 j = i + 1; j < 8; ++j)
+            swap(block_component[i * 8 + j], block_component[j * 8 + i]);
+    }
+}
+
+// One 1D pass of the scaled AAN IDCT, applied down the columns of an 8x8
+// coefficient block. Every column runs the same butterfly network, so the
+// eight columns are processed together as eight-wide vector lanes: each row
+// of the block is one vector. The full 2D transform is this pass, then the
+// same pass on the transposed block for the rows. The block stores i32
+// coefficients, so the result is truncated back to integers after each pass,
+// exactly as it was when the lanes were computed one at a time.
+static void idct_vector_pass(i32* block_component)
+{
+    using AK::SIMD::f32x8;
+
     static const float m0 = 2.0 * AK::cos(1.0 / 16.0 * 2.0 * AK::Pi<double>);
     static const float m1 = 2.0 * AK::cos(2.0 / 16.0 * 2.0 * AK::Pi<double>);
     static const float m3 = 2.0 * AK::cos(2.0 / 16.0 * 2.0 * AK::Pi<double>);
@@ -879,183 +913,156 @@ static void inverse_dct(const JPGLoadingContext& context, Vector<Macroblock>& ma
     static const float s6 = AK::cos(6.0 / 16.0 * AK::Pi<double>) / 2.0;
     static const float s7 = AK::cos(7.0 / 16.0 * AK::Pi<double>) / 2.0;
 
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
-        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
-            for (u32 component_i = 0; component_i < context.component_count; component_i++) {
-                auto& component = context.components[component_i];
-                for (u8 vfactor_i = 0; vfactor_i < component.vsample_factor; vfactor_i++) {
-                    for (u8 hfactor_i = 0; hfactor_i < component.hsample_factor; hfactor_i++) {
-                        u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
-                        Macroblock& block = macroblocks[mb_index];
-                        i32* block_component = get_component(block, component_i);
-                        for (u32 k = 0; k < 8; ++k) {
-                            const float g0 = block_component[0 * 8 + k] * s0;
-                            const float g1 = block_component[4 * 8 + k] * s4;
-                            const float g2 = block_component[2 * 8 + k] * s2;
-                            const float g3 = block_component[6 * 8 + k] * s6;
-                            const float g4 = block_component[5 * 8 + k] * s5;
-                            const float g5 = block_component[1 * 8 + k] * s1;
-                            const float g6 = block_component[7 * 8 + k] * s7;
-                            const float g7 = block_component[3 * 8 + k] * s3;
-
-                            const float f0 = g0;
-                            const float f1 = g1;
-                            const float f2 = g2;
-                            const float f3 = g3;
-                            const float f4 = g4 - g7;
-                            const float f5 = g5 + g6;
-                            const float f6 = g5 - g6;
-                            const float f7 = g4 + g7;
-
-                            const float e0 = f0;
-                            const float e1 = f1;
-                            const float e2 = f2 - f3;
-                            const float e3 = f2 + f3;
-                            const float e4 = f4;
-                            const float e5 = f5 - f7;
-                            const float e6 = f6;
-                            const float e7 = f5 + f7;
-                            const float e8 = f4 + f6;
-
-                            const float d0 = e0;
-                            const float d1 = e1;
-                            const float d2 = e2 * m1;
-                            const float d3 = e3;
-                            const float d4 = e4 * m2;
-                            const float d5 = e5 * m3;
-                            const float d6 = e6 * m4;
-                            const float d7 = e7;
-                            const float d8 = e8 * m5;
-
-                            const float c0 = d0 + d1;
-                            const float c1 = d0 - d1;
-                            const float c2 = d2 - d3;
-                            const float c3 = d3;
-                            const float c4 = d4 + d8;
-                            const float c5 = d5 + d7;
-                            const float c6 = d6 - d8;
-                            const float c7 = d7;
-                            const float c8 = c5 - c6;
-
-                            const float b0 = c0 + c3;
-                            const float b1 = c1 + c2;
-                            const float b2 = c1 - c2;
-                            const float b3 = c0 - c3;
-                            const float b4 = c4 - c8;
-                            const float b5 = c8;
-                            const float b6 = c6 - c7;
-                            const float b7 = c7;
-
-                            block_component[0 * 8 + k] = b0 + b7;
-                            block_component[1 * 8 + k] = b1 + b6;
-                            block_component[2 * 8 + k] = b2 + b5;
-                            block_component[3 * 8 + k] = b3 + b4;
-                            block_component[4 * 8 + k] = b3 - b4;
-                            block_component[5 * 8 + k] = b2 - b5;
-                            block_component[6 * 8 + k] = b1 - b6;
-                            block_component[7 * 8 + k] = b0 - b7;
-                        }
-                        for (u32 l = 0; l < 8; ++l) {
-                            const float g0 = block_component[l * 8 + 0] * s0;
-                            const float g1 = block_component[l * 8 + 4] * s4;
-                            const float g2 = block_component[l * 8 + 2] * s2;
-                            const float g3 = block_component[l * 8 + 6] * s6;
-                            const float g4 = block_component[l * 8 + 5] * s5;
-                            const float g5 = block_component[l * 8 + 1] * s1;
-                            const float g6 = block_component[l * 8 + 7] * s7;
-                            const float g7 = block_component[l * 8 + 3] * s3;
-
-                            const float f0 = g0;
-                            const float f1 = g1;
-                            const float f2 = g2;
-                            const float f3 = g3;
-                            const float f4 = g4 - g7;
-                            const float f5 = g5 + g6;
-                            const float f6 = g5 - g6;
-                            const float f7 = g4 + g7;
-
-                            const float e0 = f0;
-                            const float e1 = f1;
-                            const float e2 = f2 - f3;
-                            const float e3 = f2 + f3;
-                            const float e4 = f4;
-                            const float e5 = f5 - f7;
-                            const float e6 = f6;
-                            const float e7 = f5 + f7;
-                            const float e8 = f4 + f6;
-
-                            const float d0 = e0;
-                            const float d1 = e1;
-                            const float d2 = e2 * m1;
-                            const float d3 = e3;
-                            const float d4 = e4 * m2;
-                            const float d5 = e5 * m3;
-                            const float d6 = e6 * m4;
-                            const float d7 = e7;
-                            const float d8 = e8 * m5;
-
-                            const float c0 = d0 + d1;
-                            const float c1 = d0 - d1;
-                            const float c2 = d2 - d3;
-                            const float c3 = d3;
-                            const float c4 = d4 + d8;
-                            const float c5 = d5 + d7;
-                            const float c6 = d6 - d8;
-                            const float c7 = d7;
-                            const float c8 = c5 - c6;
-
-                            const float b0 = c0 + c3;
-                            const float b1 = c1 + c2;
-                            const float b2 = c1 - c2;
-                            const float b3 = c0 - c3;
-                            const float b4 = c4 - c8;
-                            const float b5 = c8;
-                            const float b6 = c6 - c7;
-                            const float b7 = c7;
-
-                            block_component[l * 8 + 0] = b0 + b7;
-                            block_component[l * 8 + 1] = b1 + b6;
-                            block_component[l * 8 + 2] = b2 + b5;
-                            block_component[l * 8 + 3] = b3 + b4;
-                            block_component[l * 8 + 4] = b3 - b4;
-                            block_component[l * 8 + 5] = b2 - b5;
-                            block_component[l * 8 + 6] = b1 - b6;
-                            block_component[l * 8 + 7] = b0 - b7;
-                        }
-                    }
+    f32x8 rows[8];
+    load_row_as_floats(block_component + 0 * 8, rows[0]);
+    load_row_as_floats(block_component + 4 * 8, rows[1]);
+    load_row_as_floats(block_component + 2 * 8, rows[2]);
+    load_row_as_floats(block_component + 6 * 8, rows[3]);
+    load_row_as_floats(block_component + 5 * 8, rows[4]);
+    load_row_as_floats(block_component + 1 * 8, rows[5]);
+    load_row_as_floats(block_component + 7 * 8, rows[6]);
+    load_row_as_floats(block_component + 3 * 8, rows[7]);
+
+    const f32x8 g0 = rows[0] * s0;
+    const f32x8 g1 = rows[1] * s4;
+    const f32x8 g2 = rows[2] * s2;
+    const f32x8 g3 = rows[3] * s6;
+    const f32x8 g4 = rows[4] * s5;
+    const f32x8 g5 = rows[5] * s1;
+    const f32x8 g6 = rows[6] * s7;
+    const f32x8 g7 = rows[7] * s3;
+
+    const f32x8 f0 = g0;
+    const f32x8 f1 = g1;
+    const f32x8 f2 = g2;
+    const f32x8 f3 = g3;
+    const f32x8 f4 = g4 - g7;
+    const f32x8 f5 = g5 + g6;
+    const f32x8 f6 = g5 - g6;
+    const f32x8 f7 = g4 + g7;
+
+    const f32x8 e0 = f0;
+    const f32x8 e1 = f1;
+    const f32x8 e2 = f2 - f3;
+    const f32x8 e3 = f2 + f3;
+    const f32x8 e4 = f4;
+    const f32x8 e5 = f5 - f7;
+    const f32x8 e6 = f6;
+    const f32x8 e7 = f5 + f7;
+    const f32x8 e8 = f4 + f6;
+
+    const f32x8 d0 = e0;
+    const f32x8 d1 = e1;
+    const f32x8 d2 = e2 * m1;
+    const f32x8 d3 = e3;
+    const f32x8 d4 = e4 * m2;
+    const f32x8 d5 = e5 * m3;
+    const f32x8 d6 = e6 * m4;
+    const f32x8 d7 = e7;
+    const f32x8 d8 = e8 * m5;
+
+    const f32x8 c0 = d0 + d1;
+    const f32x8 c1 = d0 - d1;
+    const f32x8 c2 = d2 - d3;
+    const f32x8 c3 = d3;
+    const f32x8 c4 = d4 + d8;
+    const f32x8 c5 = d5 + d7;
+    const f32x8 c6 = d6 - d8;
+    const f32x8 c7 = d7;
+    const f32x8 c8 = c5 - c6;
+
+    const f32x8 b0 = c0 + c3;
+    const f32x8 b1 = c1 + c2;
+    const f32x8 b2 = c1 - c2;
+    const f32x8 b3 = c0 - c3;
+    const f32x8 b4 = c4 - c8;
+    const f32x8 b5 = c8;
+    const f32x8 b6 = c6 - c7;
+    const f32x8 b7 = c7;
+
+    store_row_truncated(block_component + 0 * 8, b0 + b7);
+    store_row_truncated(block_component + 1 * 8, b1 + b6);
+    store_row_truncated(block_component + 2 * 8, b2 + b5);
+    store_row_truncated(block_component + 3 * 8, b3 + b4);
+    store_row_truncated(block_component + 4 * 8, b3 - b4);
+    store_row_truncated(block_component + 5 * 8, b2 - b5);
+    store_row_truncated(block_component + 6 * 8, b1 - b6);
+    store_row_truncated(block_component + 7 * 8, b0 - b7);
+}
+
+static void inverse_dct_mcu_row(const JPGLoadingContext& context, Vector<Macroblock>& macroblocks, u32 vcursor)
+{
+    for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
+        for (u32 component_i = 0; component_i < context.component_count; component_i++) {
+            auto& component = context.components[component_i];
+            for (u8 vfactor_i = 0; vfactor_i < component.vsample_factor; vfactor_i++) {
+                for (u8 hfactor_i = 0; hfactor_i < component.hsample_factor; hfactor_i++) {
+                    u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
+                    Macroblock& block = macroblocks[mb_index];
+                    i32* block_component = get_component(block, component_i);
+                    idct_vector_pass(block_component);
+                    transpose_block(block_component);
+                    idct_vector_pass(block_component);
+                    transpose_block(block_component);
                 }
             }
         }
     }
 }
 
-static void ycbcr_to_rgb(const JPGLoadingContext& context, Vector<Macroblock>& macroblocks)
+ALWAYS_INLINE static void clamp_to_color_channel(AK::SIMD::i32x8& values)
 {
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.vsample_factor) {
-        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
-            const u32 chroma_block_index = vcursor * context.mblock_meta.hpadded_count + hcursor;
-            const Macroblock& chroma = macroblocks[chroma_block_index];
-            // Overflows are intentional.
-            for (u8 vfactor_i = context.vsample_factor - 1; vfactor_i < context.vsample_factor; --vfactor_i) {
-                for (u8 hfactor_i = context.hsample_factor - 1; hfactor_i < context.hsample_factor; --hfactor_i) {
-                    u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hcursor + hfactor_i);
-                    i32* y = macroblocks[mb_index].y;
-                    i32* cb = macroblocks[mb_index].cb;
-                    i32* cr = macroblocks[mb_index].cr;
-                    for (u8 i = 7; i < 8; --i) {
-                        for (u8 j = 7; j < 8; --j) {
-                            const u8 pixel = i * 8 + j;
-                            const u32 chroma_pxrow = (i / context.vsample_factor) + 4 * vfactor_i;
-                            const u32 chroma_pxcol = (j / context.hsample_factor) + 4 * hfactor_i;
-                            const u32 chroma_pixel = chroma_pxrow * 8 + chroma_pxcol;
-                            int r = y[pixel] + 1.402f * chroma.cr[chroma_pixel] + 128;
-                            int g = y[pixel] - 0.344f * chroma.cb[chroma_pixel] - 0.714f * chroma.cr[chroma_pixel] + 128;
-                            int b = y[pixel] + 1.772f * chroma.cb[chroma_pixel] + 128;
-                            y[pixel] = r < 0 ? 0 : (r > 255 ? 255 : r);
-                            cb[pixel] = g < 0 ? 0 : (g > 255 ? 255 : g);
-                            cr[pixel] = b < 0 ? 0 : (b > 255 ? 255 : b);
-                        }
+    const auto below = values < 0;
+    values &= ~below;
+    const auto above = values > 255;
+    values = (values & ~above) | (above & 255);
+}
+
+static void ycbcr_to_rgb_mcu_row(const JPGLoadingContext& context, Vector<Macroblock>& macroblocks, u32 vcursor)
+{
+    using AK::SIMD::f32x8;
+    using AK::SIMD::i32x8;
+
+    for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.hsample_factor) {
+        const u32 chroma_block_index = vcursor * context.mblock_meta.hpadded_count + hcursor;
+        const Macroblock& chroma = macroblocks[chroma_block_index];
+        // Overflows are intentional.
+        for (u8 vfactor_i = context.vsample_factor - 1; vfactor_i < context.vsample_factor; --vfactor_i) {
+            for (u8 hfactor_i = context.hsample_factor - 1; hfactor_i < context.hsample_factor; --hfactor_i) {
+                u32 mb_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hcursor + hfactor_i);
+                i32* y = macroblocks[mb_index].y;
+                i32* cb = macroblocks[mb_index].cb;
+                i32* cr = macroblocks[mb_index].cr;
+                for (u8 i = 7; i < 8; --i) {
+                    // A subsampled chroma block covers several luma blocks, so the
+                    // chroma samples for one luma row have to be gathered one by one.
+                    // This block may itself be the chroma source block, which is why
+                    // rows are still visited bottom to top and the gather happens
+                    // before the row is overwritten.
+                    const u32 chroma_pxrow = (i / context.vsample_factor) + 4 * vfactor_i;
+                    float cb_samples[8];
+                    float cr_samples[8];
+                    for (u8 j = 0; j < 8; ++j) {
+                        const u32 chroma_pixel = chroma_pxrow * 8 + (j / context.hsample_factor) + 4 * hfactor_i;
+                        cb_samples[j] = chroma.cb[chroma_pixel];
+                        cr_samples[j] = chroma.cr[chroma_pixel];
                     }
+                    f32x8 cb_vector;
+                    f32x8 cr_vector;
+                    __builtin_memcpy(&cb_vector, cb_samples, sizeof(cb_vector));
+                    __builtin_memcpy(&cr_vector, cr_samples, sizeof(cr_vector));
+                    f32x8 y_vector;
+                    load_row_as_floats(y + i * 8, y_vector);
+
+                    auto r = __builtin_convertvector(y_vector + 1.402f * cr_vector + 128.0f, i32x8);
+                    auto g = __builtin_convertvector(y_vector - 0.344f * cb_vector - 0.714f * cr_vector + 128.0f, i32x8);
+                    auto b = __builtin_convertvector(y_vector + 1.772f * cb_vector + 128.0f, i32x8);
+                    clamp_to_color_channel(r);
+                    clamp_to_color_channel(g);
+                    clamp_to_color_channel(b);
+                    __builtin_memcpy(y + i * 8, &r, sizeof(r));
+                    __builtin_memcpy(cb + i * 8, &g, sizeof(g));
+                    __builtin_memcpy(cr + i * 8, &b, sizeof(b));
                 }
             }
         }
@@ -1213,9 +1220,20 @@ static bool decode_jpg(JPGLoadingContext& context)
     }
 
     auto macroblocks = result.release_value();
-    dequantize(context, macroblocks);
-    inverse_dct(context, macroblocks);
-    ycbcr_to_rgb(context, macroblocks);
+    // Everything after the (inherently serial) Huffman pass operates on
+    // independent macroblocks, so the MCU rows can be dequantized, transformed
+    // and color-converted on all processors at once. The band rect is measured
+    // in MCU rows here; the bands only have to be rows of independent work,
+    // they don't have to be pixels.
+    const int mcu_row_count = ceil_div(context.mblock_meta.vcount, (u32)context.vsample_factor);
+    for_each_band_in_parallel({ 0, 0, 1, mcu_row_count }, [&](IntRect const& band) {
+        for (int row = band.y(); row <= band.bottom(); ++row) {
+            const u32 vcursor = row * context.vsample_factor;
+            dequantize_mcu_row(context, macroblocks, vcursor);
+            inverse_dct_mcu_row(context, macroblocks, vcursor);
+            ycbcr_to_rgb_mcu_row(context, macroblocks, vcursor);
+        }
+    });
     if (!compose_bitmap(context, macroblocks))
         return false;
     return true;
@@ -8,6 +8,9 @@
 #include <AK/Endian.h>
 #include <AK/LexicalPath.h>
 #include <AK/MappedFile.h>
+#include <AK/MemoryStream.h>
+#include <AK/SIMD.h>
+#include <LibCompress/Deflate.h>
 #include <LibCompress/Zlib.h>
 #include <LibGfx/PNGLoader.h>
 #include <fcntl.h>
@@ -18,7 +21,6 @@
 #include <unistd.h>
 
 #ifdef __serenity__
-#    include <LibCompress/Deflate.h>
 #    include <serenity.h>
 #endif
 
@@ -213,45 +215,75 @@ union [[gnu::packed]] Pixel {
 };
 static_assert(AssertSize<Pixel, 4>());
 
+// Unfilters one scanline. The PNG filters are defined on raw scanline bytes,
+// but this decoder unpacks to RGBA first and filters in pixel space, and the
+// R/B swap for our BGRA bitmap layout happens in the same pass. The channel
+// math runs on SIMD vectors: Up has no horizontal dependency and handles four
+// pixels per step, while Sub, Average and Paeth each need the previous output
+// pixel and handle the four channels of one pixel at a time.
+
+ALWAYS_INLINE static AK::SIMD::u8x4 load_pixel_vector(const Pixel* pixel)
+{
+    AK::SIMD::u8x4 vector;
+    __builtin_memcpy(&vector, pixel, sizeof(vector));
+    return vector;
+}
+
+ALWAYS_INLINE static void store_pixel_vector(Pixel* pixel, AK::SIMD::u8x4 vector)
+{
+    __builtin_memcpy(pixel, &vector, sizeof(vector));
+}
+
+ALWAYS_INLINE static AK::SIMD::u8x4 swap_red_and_blue(AK::SIMD::u8x4 pixel)
+{
+    return __builtin_shuffle(pixel, AK::SIMD::u8x4 { 2, 1, 0, 3 });
+}
+
 template<bool has_alpha, u8 filter_type>
 ALWAYS_INLINE static void unfilter_impl(Gfx::Bitmap& bitmap, int y, const void* dummy_scanline_data)
 {
+    using namespace AK::SIMD;
+
+    // Keeps the alpha channel of the destination pixel untouched for
+    // formats that don't carry one (unpacking already set it to 0xff).
+    constexpr u8x4 filter_mask = has_alpha ? u8x4 { 0xff, 0xff, 0xff, 0xff } : u8x4 { 0xff, 0xff, 0xff, 0 };
+
     auto* dummy_scanline = (const Pixel*)dummy_scanline_data;
     if constexpr (filter_type == 0) {
         auto* pixels = (Pixel*)bitmap.scanline(y);
-        for (int i = 0; i < bitmap.width(); ++i) {
-            auto& x = pixels[i];
-            swap(x.r, x.b);
-        }
+        for (int i = 0; i < bitmap.width(); ++i)
+            store_pixel_vector(&pixels[i], swap_red_and_blue(load_pixel_vector(&pixels[i])));
     }
 
     if constexpr (filter_type == 1) {
         auto* pixels = (Pixel*)bitmap.scanline(y);
         swap(pixels[0].r, pixels[0].b);
         for (int i = 1; i < bitmap.width(); ++i) {
-            auto& x = pixels[i];
-            swap(x.r, x.b);
-            auto& a = (const Pixel&)pixels[i - 1];
-            x.v[0] += a.v[0];
-            x.v[1] += a.v[1];
-            x.v[2] += a.v[2];
-            if constexpr (has_alpha)
-                x.v[3] += a.v[3];
+            auto x = swap_red_and_blue(load_pixel_vector(&pixels[i]));
+            auto a = load_pixel_vector(&pixels[i - 1]);
+            store_pixel_vector(&pixels[i], x + (a & filter_mask));
         }
         return;
     }
     if constexpr (filter_type == 2) {
         auto* pixels = (Pixel*)bitmap.scanline(y);
         auto* pixels_y_minus_1 = y == 0 ? dummy_scanline : (const Pixel*)bitmap.scanline(y - 1);
-        for (int i = 0; i < bitmap.width(); ++i) {
-            auto& x = pixels[i];
-            swap(x.r, x.b);
-            const Pixel& b = pixels_y_minus_1[i];
-            x.v[0] += b.v[0];
-            x.v[1] += b.v[1];
-            x.v[2] += b.v[2];
-            if constexpr (has_alpha)
-                x.v[3] += b.v[3];
+        int i = 0;
+        constexpr u8x16 row_filter_mask = has_alpha
+            ? u8x16 { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff }
+            : u8x16 { 0xff, 0xff, 0xff, 0, 0xff, 0xff, 0xff, 0, 0xff, 0xff, 0xff, 0, 0xff, 0xff, 0xff, 0 };
+        for (; i + 4 <= bitmap.width(); i += 4) {
+            u8x16 x, b;
+            __builtin_memcpy(&x, &pixels[i], sizeof(x));
+            __builtin_memcpy(&b, &pixels_y_minus_1[i], sizeof(b));
+            x = __builtin_shuffle(x, u8x16 { 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15 });
+            x += b & row_filter_mask;
+            __builtin_memcpy(&pixels[i], &x, sizeof(x));
+        }
+        for (; i < bitmap.width(); ++i) {
+            auto x = swap_red_and_blue(load_pixel_vector(&pixels[i]));
+            auto b = load_pixel_vector(const_cast<Pixel*>(&pixels_y_minus_1[i]));
+            store_pixel_vector(&pixels[i], x + (b & filter_mask));
         }
         return;
     }
@@ -259,111 +291,104 @@ ALWAYS_INLINE static void unfilter_impl(Gfx::Bitmap& bitmap, int y, const void*
         auto* pixels = (Pixel*)bitmap.scanline(y);
         auto* pixels_y_minus_1 = y == 0 ? dummy_scanline : (const Pixel*)bitmap.scanline(y - 1);
         for (int i = 0; i < bitmap.width(); ++i) {
-            auto& x = pixels[i];
-            swap(x.r, x.b);
-            Pixel a;
-            if (i != 0)
-                a = pixels[i - 1];
-            const Pixel& b = pixels_y_minus_1[i];
-            x.v[0] = x.v[0] + ((a.v[0] + b.v[0]) / 2);
-            x.v[1] = x.v[1] + ((a.v[1] + b.v[1]) / 2);
-            x.v[2] = x.v[2] + ((a.v[2] + b.v[2]) / 2);
-            if constexpr (has_alpha)
-                x.v[3] = x.v[3] + ((a.v[3] + b.v[3]) / 2);
+            auto x = swap_red_and_blue(load_pixel_vector(&pixels[i]));
+            u16x4 a = i == 0 ? u16x4 { 0, 0, 0, 0 } : __builtin_convertvector(load_pixel_vector(&pixels[i - 1]), u16x4);
+            u16x4 b = __builtin_convertvector(load_pixel_vector(const_cast<Pixel*>(&pixels_y_minus_1[i])), u16x4);
+            auto average = __builtin_convertvector((a + b) >> 1, u8x4);
+            store_pixel_vector(&pixels[i], x + (average & filter_mask));
         }
         return;
     }
     if constexpr (filter_type == 4) {
         auto* pixels = (Pixel*)bitmap.scanline(y);
-        auto* pixels_y_minus_1 = y == 0 ? dummy_scanline : (Pixel*)bitmap.scanline(y - 1);
+        auto* pixels_y_minus_1 = y == 0 ? dummy_scanline : (const Pixel*)bitmap.scanline(y - 1);
         for (int i = 0; i < bitmap.width(); ++i) {
-            auto& x = pixels[i];
-            swap(x.r, x.b);
-            Pixel a;
-            const Pixel& b = pixels_y_minus_1[i];
-            Pixel c;
+            auto x = swap_red_and_blue(load_pixel_vector(&pixels[i]));
+            i16x4 a { 0, 0, 0, 0 };
+            i16x4 c { 0, 0, 0, 0 };
             if (i != 0) {
-                a = pixels[i - 1];
-                c = pixels_y_minus_1[i - 1];
+                a = __builtin_convertvector(load_pixel_vector(&pixels[i - 1]), i16x4);
+                c = __builtin_convertvector(load_pixel_vector(const_cast<Pixel*>(&pixels_y_minus_1[i - 1])), i16x4);
             }
-            x.v[0] += paeth_predictor(a.v[0], b.v[0], c.v[0]);
-            x.v[1] += paeth_predictor(a.v[1], b.v[1], c.v[1]);
-            x.v[2] += paeth_predictor(a.v[2], b.v[2], c.v[2]);
-            if constexpr (has_alpha)
-                x.v[3] += paeth_predictor(a.v[3], b.v[3], c.v[3]);
+            i16x4 b = __builtin_convertvector(load_pixel_vector(const_cast<Pixel*>(&pixels_y_minus_1[i])), i16x4);
+            // The branchy paeth_predictor(), but on all four channels at once:
+            // comparisons yield all-ones/all-zeroes lane masks to select with.
+            i16x4 p = a + b - c;
+            i16x4 pa_signed = p - a;
+            i16x4 pb_signed = p - b;
+            i16x4 pc_signed = p - c;
+            i16x4 pa = (pa_signed ^ (pa_signed < 0)) - (pa_signed < 0);
+            i16x4 pb = (pb_signed ^ (pb_signed < 0)) - (pb_signed < 0);
+            i16x4 pc = (pc_signed ^ (pc_signed < 0)) - (pc_signed < 0);
+            i16x4 use_a = (pa <= pb) & (pa <= pc);
+            i16x4 use_b = pb <= pc;
+            i16x4 predictor = (use_a & a) | (~use_a & ((use_b & b) | (~use_b & c)));
+            store_pixel_vector(&pixels[i], x + (__builtin_convertvector(predictor, u8x4) & filter_mask));
         }
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_without_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_grayscale_without_alpha_row(PNGLoadingContext& context, int y, ReadonlyBytes data)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* gray_values = reinterpret_cast<const T*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = gray_values[i];
-            pixel.g = gray_values[i];
-            pixel.b = gray_values[i];
-            pixel.a = 0xff;
-        }
+    auto* gray_values = reinterpret_cast<const T*>(data.data());
+    for (int i = 0; i < context.width; ++i) {
+        auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
+        pixel.r = gray_values[i];
+        pixel.g = gray_values[i];
+        pixel.b = gray_values[i];
+        pixel.a = 0xff;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_with_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_grayscale_with_alpha_row(PNGLoadingContext& context, int y, ReadonlyBytes data)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* tuples = reinterpret_cast<const Tuple<T>*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = tuples[i].gray;
-            pixel.g = tuples[i].gray;
-            pixel.b = tuples[i].gray;
-            pixel.a = tuples[i].a;
-        }
+    auto* tuples = reinterpret_cast<const Tuple<T>*>(data.data());
+    for (int i = 0; i < context.width; ++i) {
+        auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
+        pixel.r = tuples[i].gray;
+        pixel.g = tuples[i].gray;
+        pixel.b = tuples[i].gray;
+        pixel.a = tuples[i].a;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_triplets_without_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_triplets_without_alpha_row(PNGLoadingContext& context, int y, ReadonlyBytes data)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* triplets = reinterpret_cast<const Triplet<T>*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = triplets[i].r;
-            pixel.g = triplets[i].g;
-            pixel.b = triplets[i].b;
-            pixel.a = 0xff;
-        }
+    auto* triplets = reinterpret_cast<const Triplet<T>*>(data.data());
+    for (int i = 0; i < context.width; ++i) {
+        auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
+        pixel.r = triplets[i].r;
+        pixel.g = triplets[i].g;
+        pixel.b = triplets[i].b;
+        pixel.a = 0xff;
     }
 }
 
-NEVER_INLINE FLATTEN static bool unfilter(PNGLoadingContext& context)
+// Unpacks one raw scanline into RGBA pixels in the bitmap.
+NEVER_INLINE FLATTEN static bool unpack_row(PNGLoadingContext& context, int y, ReadonlyBytes data)
 {
-    // First unpack the scanlines to RGBA:
     switch (context.color_type) {
     case 0:
         if (context.bit_depth == 8) {
-            unpack_grayscale_without_alpha<u8>(context);
+            unpack_grayscale_without_alpha_row<u8>(context, y, data);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_without_alpha<u16>(context);
+            unpack_grayscale_without_alpha_row<u16>(context, y, data);
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto bit_depth_squared = context.bit_depth * context.bit_depth;
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* gray_values = context.scanlines[y].data.data();
-                for (int x = 0; x < context.width; ++x) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
-                    auto value = (gray_values[x / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[x];
-                    pixel.r = value * (0xff / bit_depth_squared);
-                    pixel.g = value * (0xff / bit_depth_squared);
-                    pixel.b = value * (0xff / bit_depth_squared);
-                    pixel.a = 0xff;
-                }
+            auto* gray_values = data.data();
+            for (int x = 0; x < context.width; ++x) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
+                auto value = (gray_values[x / pixels_per_byte] >> bit_offset) & mask;
+                auto& pixel = (Pixel&)context.bitmap->scanline(y)[x];
+                pixel.r = value * (0xff / bit_depth_squared);
+                pixel.g = value * (0xff / bit_depth_squared);
+                pixel.b = value * (0xff / bit_depth_squared);
+                pixel.a = 0xff;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -371,37 +396,33 @@ NEVER_INLINE FLATTEN static bool unfilter(PNGLoadingContext& context)
         break;
     case 4:
         if (context.bit_depth == 8) {
-            unpack_grayscale_with_alpha<u8>(context);
+            unpack_grayscale_with_alpha_row<u8>(context, y, data);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_with_alpha<u16>(context);
+            unpack_grayscale_with_alpha_row<u16>(context, y, data);
         } else {
             VERIFY_NOT_REACHED();
         }
         break;
     case 2:
         if (context.bit_depth == 8) {
-            unpack_triplets_without_alpha<u8>(context);
+            unpack_triplets_without_alpha_row<u8>(context, y, data);
         } else if (context.bit_depth == 16) {
-            unpack_triplets_without_alpha<u16>(context);
+            unpack_triplets_without_alpha_row<u16>(context, y, data);
         } else {
             VERIFY_NOT_REACHED();
         }
         break;
     case 6:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                memcpy(context.bitmap->scanline(y), context.scanlines[y].data.data(), context.scanlines[y].data.size());
-            }
+            memcpy(context.bitmap->scanline(y), data.data(), data.size());
         } else if (context.bit_depth == 16) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* triplets = reinterpret_cast<const Quad<u16>*>(context.scanlines[y].data.data());
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    pixel.r = triplets[i].r & 0xFF;
-                    pixel.g = triplets[i].g & 0xFF;
-                    pixel.b = triplets[i].b & 0xFF;
-                    pixel.a = triplets[i].a & 0xFF;
-                }
+            auto* triplets = reinterpret_cast<const Quad<u16>*>(data.data());
+            for (int i = 0; i < context.width; ++i) {
+                auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
+                pixel.r = triplets[i].r & 0xFF;
+                pixel.g = triplets[i].g & 0xFF;
+                pixel.b = triplets[i].b & 0xFF;
+                pixel.a = triplets[i].a & 0xFF;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -409,42 +430,38 @@ NEVER_INLINE FLATTEN static bool unfilter(PNGLoadingContext& context)
         break;
     case 3:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_index = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if (palette_index[i] >= context.palette_data.size())
-                        return false;
-                    auto& color = context.palette_data.at((int)palette_index[i]);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index[i] + 1u
-                        ? context.palette_transparency_data.data()[palette_index[i]]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
+            auto* palette_index = data.data();
+            for (int i = 0; i < context.width; ++i) {
+                auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
+                if (palette_index[i] >= context.palette_data.size())
+                    return false;
+                auto& color = context.palette_data.at((int)palette_index[i]);
+                auto transparency = context.palette_transparency_data.size() >= palette_index[i] + 1u
+                    ? context.palette_transparency_data.data()[palette_index[i]]
+                    : 0xff;
+                pixel.r = color.r;
+                pixel.g = color.g;
+                pixel.b = color.b;
+                pixel.a = transparency;
             }
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_indices = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
-                    auto palette_index = (palette_indices[i / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if ((size_t)palette_index >= context.palette_data.size())
-                        return false;
-                    auto& color = context.palette_data.at(palette_index);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
-                        ? context.palette_transparency_data.data()[palette_index]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
+            auto* palette_indices = data.data();
+            for (int i = 0; i < context.width; ++i) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
+                auto palette_index = (palette_indices[i / pixels_per_byte] >> bit_offset) & mask;
+                auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
+                if ((size_t)palette_index >= context.palette_data.size())
+                    return false;
+                auto& color = context.palette_data.at(palette_index);
+                auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
+                    ? context.palette_transparency_data.data()[palette_index]
+                    : 0xff;
+                pixel.r = color.r;
+                pixel.g = color.g;
+                pixel.b = color.b;
+                pixel.a = transparency;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -454,47 +471,56 @@ NEVER_INLINE FLATTEN static bool unfilter(PNGLoadingContext& context)
         VERIFY_NOT_REACHED();
         break;
     }
+    return true;
+}
+
+ALWAYS_INLINE static void unfilter_row(PNGLoadingContext& context, int y, u8 filter, const void* dummy_scanline)
+{
+    switch (filter) {
+    case 0:
+        if (context.has_alpha())
+            unfilter_impl<true, 0>(*context.bitmap, y, dummy_scanline);
+        else
+            unfilter_impl<false, 0>(*context.bitmap, y, dummy_scanline);
+        break;
+    case 1:
+        if (context.has_alpha())
+            unfilter_impl<true, 1>(*context.bitmap, y, dummy_scanline);
+        else
+            unfilter_impl<false, 1>(*context.bitmap, y, dummy_scanline);
+        break;
+    case 2:
+        if (context.has_alpha())
+            unfilter_impl<true, 2>(*context.bitmap, y, dummy_scanline);
+        else
+            unfilter_impl<false, 2>(*context.bitmap, y, dummy_scanline);
+        break;
+    case 3:
+        if (context.has_alpha())
+            unfilter_impl<true, 3>(*context.bitmap, y, dummy_scanline);
+        else
+            unfilter_impl<false, 3>(*context.bitmap, y, dummy_scanline);
+        break;
+    case 4:
+        if (context.has_alpha())
+            unfilter_impl<true, 4>(*context.bitmap, y, dummy_scanline);
+        else
+            unfilter_impl<false, 4>(*context.bitmap, y, dummy_scanline);
+        break;
+    }
+}
 
+NEVER_INLINE FLATTEN static bool unfilter(PNGLoadingContext& context)
+{
     u8 dummy_scanline[context.width * sizeof(RGBA32)];
     memset(dummy_scanline, 0, sizeof(dummy_scanline));
 
+    // Unfiltering row y only needs row y - 1, which is already done, so each
+    // scanline can be unpacked and unfiltered in one pass.
     for (int y = 0; y < context.height; ++y) {
-        auto filter = context.scanlines[y].filter;
-        if (filter == 0) {
-            if (context.has_alpha())
-                unfilter_impl<true, 0>(*context.bitmap, y, dummy_scanline);
-            else
-                unfilter_impl<false, 0>(*context.bitmap, y, dummy_scanline);
-            continue;
-        }
-        if (filter == 1) {
-            if (context.has_alpha())
-                unfilter_impl<true, 1>(*context.bitmap, y, dummy_scanline);
-            else
-                unfilter_impl<false, 1>(*context.bitmap, y, dummy_scanline);
-            continue;
-        }
-        if (filter == 2) {
-            if (context.has_alpha())
-                unfilter_impl<true, 2>(*context.bitmap, y, dummy_scanline);
-            else
-                unfilter_impl<false, 2>(*context.bitmap, y, dummy_scanline);
-            continue;
-        }
-        if (filter == 3) {
-            if (context.has_alpha())
-                unfilter_impl<true, 3>(*context.bitmap, y, dummy_scanline);
-            else
-                unfilter_impl<false, 3>(*context.bitmap, y, dummy_scanline);
-            continue;
-        }
-        if (filter == 4) {
-            if (context.has_alpha())
-                unfilter_impl<true, 4>(*context.bitmap, y, dummy_scanline);
-            else
-                unfilter_impl<false, 4>(*context.bitmap, y, dummy_scanline);
-            continue;
-        }
+        if (!unpack_row(context, y, context.scanlines[y].data))
+            return false;
+        unfilter_row(context, y, context.scanlines[y].filter, dummy_scanline);
     }
 
     return true;
@@ -579,41 +605,58 @@ static bool decode_png_chunks(PNGLoadingContext& context)
 
 static bool decode_png_bitmap_simple(PNGLoadingContext& context)
 {
-    Streamer streamer(context.decompression_buffer->data(), context.decompression_buffer->size());
+    // The IDAT payload is a zlib stream. Instead of inflating the whole
+    // image into an intermediate buffer and filtering afterwards, scanlines
+    // are pulled out of the deflate decompressor one row at a time and
+    // unpacked + unfiltered on the spot, so the peak memory for raw image
+    // data is a single scanline.
+    auto zlib = Compress::Zlib::try_create(context.compressed_data.span());
+    if (!zlib.has_value()) {
+        context.state = PNGLoadingContext::State::Error;
+        return false;
+    }
+    InputMemoryStream payload_stream { zlib->payload() };
+    Compress::DeflateDecompressor deflate_stream { payload_stream };
+
+    auto row_size = context.compute_row_size_for_width(context.width);
+    if (row_size.has_overflow())
+        return false;
+
+    auto row_buffer = ByteBuffer::create_uninitialized(1 + (size_t)row_size.value());
+    if (!row_buffer.has_value()) {
+        context.state = PNGLoadingContext::State::Error;
+        return false;
+    }
+
+    context.bitmap = Bitmap::try_create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height });
+    if (!context.bitmap) {
+        context.state = PNGLoadingContext::State::Error;
+        return false;
+    }
+
+    u8 dummy_scanline[context.width * sizeof(RGBA32)];
+    memset(dummy_scanline, 0, sizeof(dummy_scanline));
 
     for (int y = 0; y < context.height; ++y) {
-        u8 filter;
-        if (!streamer.read(filter)) {
+        if (!deflate_stream.read_or_error(row_buffer->bytes())) {
+            deflate_stream.handle_any_error();
             context.state = PNGLoadingContext::State::Error;
             return false;
         }
 
+        u8 filter = row_buffer->data()[0];
         if (filter > 4) {
             dbgln_if(PNG_DEBUG, "Invalid PNG filter: {}", filter);
             context.state = PNGLoadingContext::State::Error;
             return false;
         }
 
-        context.scanlines.append({ filter });
-        auto& scanline_buffer = context.scanlines.last().data;
-        auto row_size = context.compute_row_size_for_width(context.width);
-        if (row_size.has_overflow())
-            return false;
-
-        if (!streamer.wrap_bytes(scanline_buffer, row_size.value())) {
-            context.state = PNGLoadingContext::State::Error;
+        if (!unpack_row(context, y, row_buffer->bytes().slice(1)))
             return false;
-        }
-    }
-
-    context.bitmap = Bitmap::try_create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height });
-
-    if (!context.bitmap) {
-        context.state = PNGLoadingContext::State::Error;
-        return false;
+        unfilter_row(context, y, filter, dummy_scanline);
     }
-
-    return unfilter(context);
+    deflate_stream.handle_any_error();
+    return true;
 }
 
 static int adam7_height(PNGLoadingContext& context, int pass)
@@ -753,30 +796,33 @@ static bool decode_png_bitmap(PNGLoadingContext& context)
     if (context.color_type == 3 && context.palette_data.is_empty())
         return false; // Didn't see a PLTE chunk for a palettized image, or it was empty.
 
-    auto result = Compress::Zlib::decompress_all(context.compressed_data.span());
-    if (!result.has_value()) {
-        context.state = PNGLoadingContext::State::Error;
-        return false;
-    }
-    context.decompression_buffer = &result.value();
-    context.compressed_data.clear();
-
-    context.scanlines.ensure_capacity(context.height);
     switch (context.interlace_method) {
     case PngInterlaceMethod::Null:
         if (!decode_png_bitmap_simple(context))
             return false;
         break;
-    case PngInterlaceMethod::Adam7:
-        if (!decode_png_adam7(context))
+    case PngInterlaceMethod::Adam7: {
+        // Interlaced images interleave the passes in the stream, so decoding
+        // them still goes through a fully inflated buffer.
+        auto result = Compress::Zlib::decompress_all(context.compressed_data.span());
+        if (!result.has_value()) {
+            context.state = PNGLoadingContext::State::Error;
+            return false;
+        }
+        context.decompression_buffer = &result.value();
+        if (!decode_png_adam7(context)) {
+            context.decompression_buffer = nullptr;
             return false;
+        }
+        context.decompression_buffer = nullptr;
         break;
+    }
     default:
         context.state = PNGLoadingContext::State::Error;
         return false;
     }
 
-    context.decompression_buffer = nullptr;
+    context.compressed_data.clear();
 
     context.state = PNGLoadingContext::State::BitmapDecoded;
     return true;
@@ -19,11 +19,13 @@
 #include <AK/Memory.h>
 #include <AK/Queue.h>
 #include <AK/QuickSort.h>
+#include <AK/SIMD.h>
 #include <AK/StdLibExtras.h>
 #include <AK/StringBuilder.h>
 #include <AK/Utf32View.h>
 #include <AK/Utf8View.h>
 #include <LibGfx/CharacterBitmap.h>
+#include <LibGfx/GlyphAtlas.h>
 #include <LibGfx/Palette.h>
 #include <LibGfx/Path.h>
 #include <LibGfx/TextDirection.h>
@@ -54,6 +56,47 @@ ALWAYS_INLINE Color get_pixel(const Gfx::Bitmap& bitmap, int x, int y)
     return bitmap.get_pixel(x, y);
 }
 
+// The per-pixel Color::blend() calls in the fill and blit loops dominate
+// compositing profiles, so rows are blended four pixels at a time with the
+// portable SIMD vector types. The vector kernel only handles blending onto
+// opaque destination pixels — by far the common case, since window back
+// buffers are BGRx8888 — and pixel groups with a translucent destination
+// fall back to the scalar path, which also takes care of the row tail.
+
+ALWAYS_INLINE static AK::SIMD::u8x16 load_4_pixels(const RGBA32* pixels)
+{
+    AK::SIMD::u8x16 vector;
+    __builtin_memcpy(&vector, pixels, sizeof(vector));
+    return vector;
+}
+
+ALWAYS_INLINE static void store_4_pixels(RGBA32* pixels, AK::SIMD::u8x16 vector)
+{
+    __builtin_memcpy(pixels, &vector, sizeof(vector));
+}
+
+ALWAYS_INLINE static bool all_4_pixels_opaque(const RGBA32* pixels)
+{
+    return ((pixels[0] & pixels[1] & pixels[2] & pixels[3]) >> 24) == 0xff;
+}
+
+// Blends four source pixels onto four opaque destination pixels at once.
+// With an opaque destination, Color::blend() reduces to the classic lerp
+// out = (dest * (255 - alpha) + source * alpha) / 255 with a result alpha
+// of 255, which vectorizes without per-pixel division: x / 255 is computed
+// exactly as (x + 1 + (x >> 8)) >> 8 for any x this can produce.
+ALWAYS_INLINE static AK::SIMD::u8x16 blend_4_pixels(AK::SIMD::u8x16 dest, AK::SIMD::u8x16 source, AK::SIMD::u16x16 source_alpha)
+{
+    using AK::SIMD::u8x16;
+    using AK::SIMD::u16x16;
+
+    u16x16 mixed = __builtin_convertvector(dest, u16x16) * (255 - source_alpha)
+        + __builtin_convertvector(source, u16x16) * source_alpha;
+    u16x16 quotient = (mixed + 1 + (mixed >> 8)) >> 8;
+    u8x16 out = __builtin_convertvector(quotient, u8x16);
+    return out | u8x16 { 0, 0, 0, 0xff, 0, 0, 0, 0xff, 0, 0, 0, 0xff, 0, 0, 0, 0xff };
+}
+
 Painter::Painter(Gfx::Bitmap& bitmap)
     : m_target(bitmap)
 {
@@ -114,8 +157,21 @@ void Painter::fill_physical_rect(const IntRect& physical_rect, Color color)
     RGBA32* dst = m_target->scanline(physical_rect.top()) + physical_rect.left();
     const size_t dst_skip = m_target->pitch() / sizeof(RGBA32);
 
+    const RGBA32 source_pixels[4] = { color.value(), color.value(), color.value(), color.value() };
+    const auto source_vector = load_4_pixels(source_pixels);
+    const AK::SIMD::u16x16 source_alpha = AK::SIMD::u16x16 {} + color.alpha();
+
     for (int i = physical_rect.height() - 1; i >= 0; --i) {
-        for (int j = 0; j < physical_rect.width(); ++j)
+        int j = 0;
+        for (; j + 4 <= physical_rect.width(); j += 4) {
+            if (all_4_pixels_opaque(&dst[j])) {
+                store_4_pixels(&dst[j], blend_4_pixels(load_4_pixels(&dst[j]), source_vector, source_alpha));
+            } else {
+                for (int k = j; k < j + 4; ++k)
+                    dst[k] = Color::from_rgba(dst[k]).blend(color).value();
+            }
+        }
+        for (; j < physical_rect.width(); ++j)
             dst[j] = Color::from_rgba(dst[j]).blend(color).value();
         dst += dst_skip;
     }
@@ -763,23 +819,58 @@ struct BlitState {
     float opacity;
 };
 
+template<BlitState::AlphaState has_alpha>
+ALWAYS_INLINE static void blend_pixel_with_opacity(BlitState& state, int x)
+{
+    Color dest_color = (has_alpha & BlitState::DstAlpha) ? Color::from_rgba(state.dst[x]) : Color::from_rgb(state.dst[x]);
+    if constexpr (has_alpha & BlitState::SrcAlpha) {
+        Color src_color_with_alpha = Color::from_rgba(state.src[x]);
+        float pixel_opacity = src_color_with_alpha.alpha() / 255.0;
+        src_color_with_alpha.set_alpha(255 * (state.opacity * pixel_opacity));
+        state.dst[x] = dest_color.blend(src_color_with_alpha).value();
+    } else {
+        Color src_color_with_alpha = Color::from_rgb(state.src[x]);
+        src_color_with_alpha.set_alpha(state.opacity * 255);
+        state.dst[x] = dest_color.blend(src_color_with_alpha).value();
+    }
+}
+
 template<BlitState::AlphaState has_alpha>
 static void do_blit_with_opacity(BlitState& state)
 {
+    const u8 constant_alpha = state.opacity * 255;
+    const AK::SIMD::u16x16 constant_alpha_vector = AK::SIMD::u16x16 {} + constant_alpha;
+
     for (int row = 0; row < state.row_count; ++row) {
-        for (int x = 0; x < state.column_count; ++x) {
-            Color dest_color = (has_alpha & BlitState::DstAlpha) ? Color::from_rgba(state.dst[x]) : Color::from_rgb(state.dst[x]);
+        int x = 0;
+        for (; x + 4 <= state.column_count; x += 4) {
+            // Without an alpha channel the destination counts as opaque no
+            // matter what its alpha bytes hold, just like Color::from_rgb().
+            if ((has_alpha & BlitState::DstAlpha) && !all_4_pixels_opaque(&state.dst[x])) {
+                for (int i = x; i < x + 4; ++i)
+                    blend_pixel_with_opacity<has_alpha>(state, i);
+                continue;
+            }
+            AK::SIMD::u16x16 source_alpha;
             if constexpr (has_alpha & BlitState::SrcAlpha) {
-                Color src_color_with_alpha = Color::from_rgba(state.src[x]);
-                float pixel_opacity = src_color_with_alpha.alpha() / 255.0;
-                src_color_with_alpha.set_alpha(255 * (state.opacity * pixel_opacity));
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
+                u8 alphas[4];
+                for (int i = 0; i < 4; ++i) {
+                    float pixel_opacity = Color::from_rgba(state.src[x + i]).alpha() / 255.0;
+                    alphas[i] = 255 * (state.opacity * pixel_opacity);
+                }
+                source_alpha = AK::SIMD::u16x16 {
+                    alphas[0], alphas[0], alphas[0], alphas[0],
+                    alphas[1], alphas[1], alphas[1], alphas[1],
+                    alphas[2], alphas[2], alphas[2], alphas[2],
+                    alphas[3], alphas[3], alphas[3], alphas[3]
+                };
             } else {
-                Color src_color_with_alpha = Color::from_rgb(state.src[x]);
-                src_color_with_alpha.set_alpha(state.opacity * 255);
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
+                source_alpha = constant_alpha_vector;
             }
+            store_4_pixels(&state.dst[x], blend_4_pixels(load_4_pixels(&state.dst[x]), load_4_pixels(&state.src[x]), source_alpha));
         }
+        for (; x < state.column_count; ++x)
+            blend_pixel_with_opacity<has_alpha>(state, x);
         state.dst += state.dst_pitch;
         state.src += state.src_pitch;
     }
@@ -1071,11 +1162,36 @@ ALWAYS_INLINE static void do_draw_integer_scaled_bitmap(Gfx::Bitmap& target, con
     }
 }
 
+// Fetches the four texels around the (16.16 fixed-point) sample position and
+// blends them with the fractional weights, doing all four channels at once as
+// u32x4 lanes. 8 bits of the fraction are enough weight precision for 8-bit
+// channels.
+template<typename GetPixel>
+ALWAYS_INLINE static Color bilinear_sample(const Gfx::Bitmap& source, GetPixel get_pixel, int src_x, int src_y)
+{
+    using AK::SIMD::u32x4;
+
+    int x0 = src_x >> 16;
+    int y0 = src_y >> 16;
+    int x1 = min(x0 + 1, source.physical_width() - 1);
+    int y1 = min(y0 + 1, source.physical_height() - 1);
+    u32 ux = (src_x >> 8) & 0xff;
+    u32 vy = (src_y >> 8) & 0xff;
+
+    auto to_vector = [](Color color) {
+        return u32x4 { color.red(), color.green(), color.blue(), color.alpha() };
+    };
+    u32x4 top = to_vector(get_pixel(source, x0, y0)) * (256 - ux) + to_vector(get_pixel(source, x1, y0)) * ux;
+    u32x4 bottom = to_vector(get_pixel(source, x0, y1)) * (256 - ux) + to_vector(get_pixel(source, x1, y1)) * ux;
+    u32x4 value = (top * (256 - vy) + bottom * vy) >> 16;
+    return Color(value[0], value[1], value[2], value[3]);
+}
+
 template<bool has_alpha_channel, typename GetPixel>
-ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, const IntRect& dst_rect, const IntRect& clipped_rect, const Gfx::Bitmap& source, const FloatRect& src_rect, GetPixel get_pixel, float opacity)
+ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, const IntRect& dst_rect, const IntRect& clipped_rect, const Gfx::Bitmap& source, const FloatRect& src_rect, GetPixel get_pixel, float opacity, Painter::ScalingMode scaling_mode)
 {
     IntRect int_src_rect = enclosing_int_rect(src_rect);
-    if (dst_rect == clipped_rect && int_src_rect == src_rect && !(dst_rect.width() % int_src_rect.width()) && !(dst_rect.height() % int_src_rect.height())) {
+    if (scaling_mode == Painter::ScalingMode::NearestNeighbor && dst_rect == clipped_rect && int_src_rect == src_rect && !(dst_rect.width() % int_src_rect.width()) && !(dst_rect.height() % int_src_rect.height())) {
         int hfactor = dst_rect.width() / int_src_rect.width();
         int vfactor = dst_rect.height() / int_src_rect.height();
         if (hfactor == 2 && vfactor == 2)
@@ -1096,9 +1212,13 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, const IntRe
     for (int y = clipped_rect.top(); y <= clipped_rect.bottom(); ++y) {
         auto* scanline = (Color*)target.scanline(y);
         for (int x = clipped_rect.left(); x <= clipped_rect.right(); ++x) {
-            auto scaled_x = ((x - dst_rect.x()) * hscale + src_left) >> 16;
-            auto scaled_y = ((y - dst_rect.y()) * vscale + src_top) >> 16;
-            auto src_pixel = get_pixel(source, scaled_x, scaled_y);
+            auto scaled_x = (x - dst_rect.x()) * hscale + src_left;
+            auto scaled_y = (y - dst_rect.y()) * vscale + src_top;
+            Color src_pixel;
+            if (scaling_mode == Painter::ScalingMode::BilinearBlend)
+                src_pixel = bilinear_sample(source, get_pixel, scaled_x, scaled_y);
+            else
+                src_pixel = get_pixel(source, scaled_x >> 16, scaled_y >> 16);
             if (has_opacity)
                 src_pixel.set_alpha(src_pixel.alpha() * opacity);
             if constexpr (has_alpha_channel) {
@@ -1109,12 +1229,12 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, const IntRe
     }
 }
 
-void Painter::draw_scaled_bitmap(const IntRect& a_dst_rect, const Gfx::Bitmap& source, const IntRect& a_src_rect, float opacity)
+void Painter::draw_scaled_bitmap(const IntRect& a_dst_rect, const Gfx::Bitmap& source, const IntRect& a_src_rect, float opacity, ScalingMode scaling_mode)
 {
-    draw_scaled_bitmap(a_dst_rect, source, FloatRect { a_src_rect }, opacity);
+    draw_scaled_bitmap(a_dst_rect, source, FloatRect { a_src_rect }, opacity, scaling_mode);
 }
 
-void Painter::draw_scaled_bitmap(const IntRect& a_dst_rect, const Gfx::Bitmap& source, const FloatRect& a_src_rect, float opacity)
+void Painter::draw_scaled_bitmap(const IntRect& a_dst_rect, const Gfx::Bitmap& source, const FloatRect& a_src_rect, float opacity, ScalingMode scaling_mode)
 {
     IntRect int_src_rect = enclosing_int_rect(a_src_rect);
     if (scale() == source.scale() && a_src_rect == int_src_rect && a_dst_rect.size() == int_src_rect.size())
@@ -1129,37 +1249,37 @@ void Painter::draw_scaled_bitmap(const IntRect& a_dst_rect, const Gfx::Bitmap& s
     if (source.has_alpha_channel() || opacity != 1.0f) {
         switch (source.format()) {
         case BitmapFormat::BGRx8888:
-            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::BGRx8888>, opacity);
+            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::BGRx8888>, opacity, scaling_mode);
             break;
         case BitmapFormat::BGRA8888:
-            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::BGRA8888>, opacity);
+            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::BGRA8888>, opacity, scaling_mode);
             break;
         case BitmapFormat::Indexed8:
-            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::Indexed8>, opacity);
+            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::Indexed8>, opacity, scaling_mode);
             break;
         case BitmapFormat::Indexed4:
-            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::Indexed4>, opacity);
+            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::Indexed4>, opacity, scaling_mode);
             break;
         case BitmapFormat::Indexed2:
-            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::Indexed2>, opacity);
+            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::Indexed2>, opacity, scaling_mode);
             break;
         case BitmapFormat::Indexed1:
-            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::Indexed1>, opacity);
+            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::Indexed1>, opacity, scaling_mode);
             break;
         default:
-            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::Invalid>, opacity);
+            do_draw_scaled_bitmap<true>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::Invalid>, opacity, scaling_mode);
             break;
         }
     } else {
         switch (source.format()) {
         case BitmapFormat::BGRx8888:
-            do_draw_scaled_bitmap<false>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::BGRx8888>, opacity);
+            do_draw_scaled_bitmap<false>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::BGRx8888>, opacity, scaling_mode);
             break;
         case BitmapFormat::Indexed8:
-            do_draw_scaled_bitmap<false>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::Indexed8>, opacity);
+            do_draw_scaled_bitmap<false>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::Indexed8>, opacity, scaling_mode);
             break;
         default:
-            do_draw_scaled_bitmap<false>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::Invalid>, opacity);
+            do_draw_scaled_bitmap<false>(*m_target, dst_rect, clipped_rect, source, src_rect, get_pixel<BitmapFormat::Invalid>, opacity, scaling_mode);
             break;
         }
     }
@@ -1217,6 +1337,51 @@ void Painter::draw_glyph_or_emoji(const IntPoint& point, u32 code_point, const F
     draw_emoji(point, *emoji, font);
 }
 
+void Painter::draw_glyph_run(Span<const GlyphPosition> run, const Font& font, Color color)
+{
+    // The atlas path only handles unscaled painting; for everything else
+    // (and for fonts without an atlas) each glyph goes through the regular
+    // clipped per-glyph draw.
+    auto* atlas = scale() == 1 ? GlyphAtlas::for_font(font) : nullptr;
+    if (!atlas) {
+        for (auto& glyph : run)
+            draw_glyph_or_emoji(glyph.position, glyph.code_point, font, color);
+        return;
+    }
+
+    auto& atlas_bitmap = atlas->bitmap();
+    const size_t src_skip = atlas_bitmap.pitch() / sizeof(RGBA32);
+    const size_t dst_skip = m_target->pitch() / sizeof(RGBA32);
+    const RGBA32 color_value = color.value();
+
+    for (auto& glyph : run) {
+        auto* info = atlas->glyph_info(glyph.code_point);
+        if (!info) {
+            // Emoji, or a code point outside the atlas.
+            draw_glyph_or_emoji(glyph.position, glyph.code_point, font, color);
+            continue;
+        }
+        auto dst_rect = IntRect(glyph.position.translated(info->left_bearing, 0), info->rect.size()).translated(translation());
+        auto clipped_rect = dst_rect.intersected(clip_rect());
+        if (clipped_rect.is_empty())
+            continue;
+        const int first_row = clipped_rect.top() - dst_rect.top();
+        const int last_row = clipped_rect.bottom() - dst_rect.top();
+        const int first_column = clipped_rect.left() - dst_rect.left();
+        const int last_column = clipped_rect.right() - dst_rect.left();
+        const RGBA32* src = atlas_bitmap.scanline(info->rect.y() + first_row) + info->rect.x() + first_column;
+        RGBA32* dst = m_target->scanline(clipped_rect.y()) + clipped_rect.x();
+        for (int row = first_row; row <= last_row; ++row) {
+            for (int j = 0; j <= (last_column - first_column); ++j) {
+                if (src[j] >> 24)
+                    dst[j] = color_value;
+            }
+            src += src_skip;
+            dst += dst_skip;
+        }
+    }
+}
+
 template<typename DrawGlyphFunction>
 void draw_text_line(IntRect const& a_rect, Utf8View const& text, Font const& font, TextAlignment alignment, TextDirection direction, DrawGlyphFunction draw_glyph)
 {
@@ -1519,9 +1684,13 @@ void Painter::draw_text(const IntRect& rect, const Utf32View& text, TextAlignmen
 void Painter::draw_text(const IntRect& rect, const StringView& raw_text, const Font& font, TextAlignment alignment, Color color, TextElision elision, TextWrapping wrapping)
 {
     Utf8View text { raw_text };
+    // Collecting the glyphs and blitting them as one run amortizes the
+    // per-glyph setup over the whole string.
+    Vector<GlyphPosition, 128> run;
     do_draw_text(rect, text, font, alignment, elision, wrapping, [&](const IntRect& r, u32 code_point) {
-        draw_glyph_or_emoji(r.location(), code_point, font, color);
+        run.append({ code_point, r.location() });
     });
+    draw_glyph_run(run.span(), font, color);
 }
 
 void Painter::draw_text(const IntRect& rect, const Utf32View& raw_text, const Font& font, TextAlignment alignment, Color color, TextElision elision, TextWrapping wrapping)
@@ -1531,9 +1700,11 @@ void Painter::draw_text(const IntRect& rect, const Utf32View& raw_text, const Fo
     StringBuilder builder;
     builder.append(raw_text);
     auto text = Utf8View { builder.string_view() };
+    Vector<GlyphPosition, 128> run;
     do_draw_text(rect, text, font, alignment, elision, wrapping, [&](const IntRect& r, u32 code_point) {
-        draw_glyph_or_emoji(r.location(), code_point, font, color);
+        run.append({ code_point, r.location() });
     });
+    draw_glyph_run(run.span(), font, color);
 }
 
 void Painter::draw_text(Function<void(const IntRect&, u32)> draw_one_glyph, const IntRect& rect, const Utf8View& text, const Font& font, TextAlignment alignment, TextElision elision, TextWrapping wrapping)
@@ -1963,164 +2134,143 @@ void Painter::stroke_path(const Path& path, Color color, int thickness)
     }
 }
 
-[[maybe_unused]] static void approximately_place_on_int_grid(FloatPoint ffrom, FloatPoint fto, IntPoint& from, IntPoint& to, Optional<IntPoint> previous_to)
-{
-    auto diffs = fto - ffrom;
-    // Truncate all first (round down).
-    from = ffrom.to_type<int>();
-    to = fto.to_type<int>();
-    // There are 16 possible configurations, by deciding to round each
-    // coord up or down (and there are four coords, from.x from.y to.x to.y)
-    // we will simply choose one which most closely matches the correct slope
-    // with the following heuristic:
-    // - if the x diff is positive or zero (that is, a right-to-left slant), round 'from.x' up and 'to.x' down.
-    // - if the x diff is negative         (that is, a left-to-right slant), round 'from.x' down and 'to.x' up.
-    // Note that we do not need to touch the 'y' attribute, as that is our scanline.
-    if (diffs.x() >= 0) {
-        from.set_x(from.x() + 1);
-    } else {
-        to.set_x(to.x() + 1);
-    }
-    if (previous_to.has_value() && from.x() != previous_to.value().x()) // The points have to line up, since we're using these lines to fill a shape.
-        from.set_x(previous_to.value().x());
-}
-
 void Painter::fill_path(Path& path, Color color, WindingRule winding_rule)
 {
     VERIFY(scale() == 1); // FIXME: Add scaling support.
 
-    const auto& segments = path.split_lines();
-
-    if (segments.size() == 0)
+    auto const& lines = path.split_lines();
+    if (lines.is_empty())
         return;
 
-    Vector<Path::SplitLineSegment> active_list;
-    active_list.ensure_capacity(segments.size());
-
-    // first, grab the segments for the very first scanline
-    int first_y = path.bounding_box().bottom_right().y() + 1;
-    int last_y = path.bounding_box().top_left().y() - 1;
-    float scanline = first_y;
+    // An active-edge-table rasterizer: every scanline is visited once, edges
+    // enter and leave the table as y advances, and coverage is accumulated
+    // at four vertical subsamples per scanline with exact horizontal span
+    // fractions, so edges come out antialiased.
+    struct Edge {
+        float top_y;
+        float bottom_y;
+        float x_at_top;
+        float dxdy;
+        int direction;
+    };
 
-    size_t last_active_segment { 0 };
+    auto float_translation = FloatPoint(translation().x(), translation().y());
 
-    for (auto& segment : segments) {
-        if (segment.maximum_y != scanline)
-            break;
-        active_list.append(segment);
-        ++last_active_segment;
+    Vector<Edge, 32> edges;
+    edges.ensure_capacity(lines.size());
+    for (auto& line : lines) {
+        auto from = line.from.translated(float_translation);
+        auto to = line.to.translated(float_translation);
+        if (from.y() == to.y())
+            continue;
+        int direction = 1;
+        if (from.y() > to.y()) {
+            swap(from, to);
+            direction = -1;
+        }
+        edges.append({ from.y(), to.y(), from.x(), (to.x() - from.x()) / (to.y() - from.y()), direction });
     }
+    if (edges.is_empty())
+        return;
 
-    auto is_inside_shape = [winding_rule](int winding_number) {
-        if (winding_rule == WindingRule::Nonzero)
-            return winding_number != 0;
+    quick_sort(edges, [](auto& a, auto& b) { return a.top_y < b.top_y; });
 
-        if (winding_rule == WindingRule::EvenOdd)
-            return winding_number % 2 == 0;
+    auto clip = clip_rect();
+    if (clip.is_empty())
+        return;
 
-        VERIFY_NOT_REACHED();
-    };
+    float top_y = edges.first().top_y;
+    float bottom_y = top_y;
+    for (auto& edge : edges)
+        bottom_y = max(bottom_y, edge.bottom_y);
 
-    auto increment_winding = [winding_rule](int& winding_number, const IntPoint& from, const IntPoint& to) {
-        if (winding_rule == WindingRule::EvenOdd) {
-            ++winding_number;
-            return;
-        }
+    int first_row = max((int)floorf(top_y), clip.top());
+    int last_row = min((int)ceilf(bottom_y), clip.bottom());
+    int buffer_left = clip.left();
+    int buffer_width = clip.width();
 
-        if (winding_rule == WindingRule::Nonzero) {
-            if (from.dy_relative_to(to) < 0)
-                ++winding_number;
-            else
-                --winding_number;
-            return;
-        }
+    Vector<float> coverage;
+    coverage.resize(buffer_width);
 
-        VERIFY_NOT_REACHED();
+    auto is_inside = [winding_rule](int winding_number) {
+        if (winding_rule == WindingRule::Nonzero)
+            return winding_number != 0;
+        return (winding_number & 1) != 0;
     };
 
-    while (scanline >= last_y) {
-        Optional<IntPoint> previous_to;
-        if (active_list.size()) {
-            // sort the active list by 'x' from right to left
-            quick_sort(active_list, [](const auto& line0, const auto& line1) {
-                return line1.x < line0.x;
-            });
-            if constexpr (FILL_PATH_DEBUG) {
-                if ((int)scanline % 10 == 0) {
-                    draw_text(IntRect(active_list.last().x - 20, scanline, 20, 10), String::number((int)scanline));
-                }
+    constexpr int subsample_count = 4;
+    constexpr float subsample_weight = 1.0f / subsample_count;
+
+    Vector<Edge*, 32> active_edges;
+    size_t next_edge_index = 0;
+
+    for (int y = first_row; y <= last_row; ++y) {
+        int row_min_x = buffer_width;
+        int row_max_x = -1;
+
+        auto accumulate_span = [&](float x0, float x1) {
+            x0 = max(x0, (float)buffer_left);
+            x1 = min(x1, (float)(buffer_left + buffer_width));
+            if (x0 >= x1)
+                return;
+            int first_pixel = (int)x0 - buffer_left;
+            int last_pixel = (int)ceilf(x1) - 1 - buffer_left;
+            row_min_x = min(row_min_x, first_pixel);
+            row_max_x = max(row_max_x, last_pixel);
+            if (first_pixel == last_pixel) {
+                coverage[first_pixel] += (x1 - x0) * subsample_weight;
+                return;
             }
+            coverage[first_pixel] += (1.0f - (x0 - floorf(x0))) * subsample_weight;
+            for (int x = first_pixel + 1; x < last_pixel; ++x)
+                coverage[x] += subsample_weight;
+            coverage[last_pixel] += (x1 - floorf(x1) == 0 ? 1.0f : x1 - floorf(x1)) * subsample_weight;
+        };
 
-            if (active_list.size() > 1) {
-                auto winding_number { winding_rule == WindingRule::Nonzero ? 1 : 0 };
-                for (size_t i = 1; i < active_list.size(); ++i) {
-                    auto& previous = active_list[i - 1];
-                    auto& current = active_list[i];
-
-                    IntPoint from, to;
-                    IntPoint truncated_from { previous.x, scanline };
-                    IntPoint truncated_to { current.x, scanline };
-                    approximately_place_on_int_grid({ previous.x, scanline }, { current.x, scanline }, from, to, previous_to);
-
-                    if (is_inside_shape(winding_number)) {
-                        // The points between this segment and the previous are
-                        // inside the shape
-
-                        dbgln_if(FILL_PATH_DEBUG, "y={}: {} at {}: {} -- {}", scanline, winding_number, i, from, to);
-                        draw_line(from, to, color, 1);
-                    }
-
-                    auto is_passing_through_maxima = scanline == previous.maximum_y
-                        || scanline == previous.minimum_y
-                        || scanline == current.maximum_y
-                        || scanline == current.minimum_y;
-
-                    auto is_passing_through_vertex = false;
-
-                    if (is_passing_through_maxima) {
-                        is_passing_through_vertex = previous.x == current.x;
-                    }
-
-                    if (!is_passing_through_vertex || previous.inverse_slope * current.inverse_slope < 0)
-                        increment_winding(winding_number, truncated_from, truncated_to);
-
-                    // update the x coord
-                    active_list[i - 1].x -= active_list[i - 1].inverse_slope;
-                }
-                active_list.last().x -= active_list.last().inverse_slope;
-            } else {
-                auto point = IntPoint(active_list[0].x, scanline);
-                draw_line(point, point, color);
+        for (int subsample = 0; subsample < subsample_count; ++subsample) {
+            float sample_y = y + (subsample + 0.5f) * subsample_weight;
 
-                // update the x coord
-                active_list.first().x -= active_list.first().inverse_slope;
+            while (next_edge_index < edges.size() && edges[next_edge_index].top_y <= sample_y) {
+                auto& edge = edges[next_edge_index++];
+                if (edge.bottom_y > sample_y)
+                    active_edges.append(&edge);
             }
-        }
+            active_edges.remove_all_matching([&](auto* edge) { return edge->bottom_y <= sample_y; });
+            if (active_edges.is_empty())
+                continue;
 
-        --scanline;
-        // remove any edge that goes out of bound from the active list
-        for (size_t i = 0, count = active_list.size(); i < count; ++i) {
-            if (scanline <= active_list[i].minimum_y) {
-                active_list.remove(i);
-                --count;
-                --i;
+            auto x_at = [sample_y](Edge const& edge) {
+                return edge.x_at_top + (sample_y - edge.top_y) * edge.dxdy;
+            };
+            quick_sort(active_edges, [&](auto* a, auto* b) { return x_at(*a) < x_at(*b); });
+
+            int winding_number = 0;
+            float span_start_x = 0;
+            for (auto* edge : active_edges) {
+                bool was_inside = is_inside(winding_number);
+                winding_number += winding_rule == WindingRule::Nonzero ? edge->direction : 1;
+                bool now_inside = is_inside(winding_number);
+                if (!was_inside && now_inside)
+                    span_start_x = x_at(*edge);
+                else if (was_inside && !now_inside)
+                    accumulate_span(span_start_x, x_at(*edge));
             }
         }
-        for (size_t j = last_active_segment; j < segments.size(); ++j, ++last_active_segment) {
-            auto& segment = segments[j];
-            if (segment.maximum_y < scanline)
-                break;
-            if (segment.minimum_y >= scanline)
-                continue;
 
-            active_list.append(segment);
-        }
-    }
+        if (row_max_x < row_min_x)
+            continue;
 
-    if constexpr (FILL_PATH_DEBUG) {
-        size_t i { 0 };
-        for (auto& segment : segments) {
-            draw_line(Point<int>(segment.from), Point<int>(segment.to), Color::from_hsv(i++ * 360.0 / segments.size(), 1.0, 1.0), 1);
+        RGBA32* scanline = m_target->scanline(y);
+        for (int x = row_min_x; x <= row_max_x; ++x) {
+            float pixel_coverage = coverage[x];
+            if (pixel_coverage > 0) {
+                coverage[x] = 0;
+                u8 alpha = (u8)(min(pixel_coverage, 1.0f) * color.alpha());
+                if (alpha == 0xff)
+                    scanline[buffer_left + x] = color.value();
+                else if (alpha)
+                    scanline[buffer_left + x] = Color::from_rgba(scanline[buffer_left + x]).blend(color.with_alpha(alpha)).value();
+            }
         }
     }
 }
@@ -8,6 +8,7 @@
 
 #include <AK/Forward.h>
 #include <AK/NonnullRefPtr.h>
+#include <AK/Span.h>
 #include <AK/Vector.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/Forward.h>
@@ -21,6 +22,13 @@
 
 namespace Gfx {
 
+// One glyph of a shaped text run: the code point and the top-left corner it
+// should be painted at, as computed by the text layout machinery.
+struct GlyphPosition {
+    u32 code_point { 0 };
+    IntPoint position;
+};
+
 class Painter {
 public:
     explicit Painter(Gfx::Bitmap&);
@@ -32,6 +40,11 @@ public:
         Dashed,
     };
 
+    enum class ScalingMode {
+        NearestNeighbor,
+        BilinearBlend,
+    };
+
     void clear_rect(const IntRect&, Color);
     void fill_rect(const IntRect&, Color);
     void fill_rect_with_dither_pattern(const IntRect&, Color, Color);
@@ -46,8 +59,8 @@ public:
     void draw_focus_rect(const IntRect&, Color);
     void draw_bitmap(const IntPoint&, const CharacterBitmap&, Color = Color());
     void draw_bitmap(const IntPoint&, const GlyphBitmap&, Color = Color());
-    void draw_scaled_bitmap(const IntRect& dst_rect, const Gfx::Bitmap&, const IntRect& src_rect, float opacity = 1.0f);
-    void draw_scaled_bitmap(const IntRect& dst_rect, const Gfx::Bitmap&, const FloatRect& src_rect, float opacity = 1.0f);
+    void draw_scaled_bitmap(const IntRect& dst_rect, const Gfx::Bitmap&, const IntRect& src_rect, float opacity = 1.0f, ScalingMode = ScalingMode::NearestNeighbor);
+    void draw_scaled_bitmap(const IntRect& dst_rect, const Gfx::Bitmap&, const FloatRect& src_rect, float opacity = 1.0f, ScalingMode = ScalingMode::NearestNeighbor);
     void draw_triangle(const IntPoint&, const IntPoint&, const IntPoint&, Color);
     void draw_ellipse_intersecting(const IntRect&, Color, int thickness = 1);
     void set_pixel(const IntPoint&, Color);
@@ -75,6 +88,7 @@ public:
     void draw_glyph(const IntPoint&, u32, const Font&, Color);
     void draw_emoji(const IntPoint&, const Gfx::Bitmap&, const Font&);
     void draw_glyph_or_emoji(const IntPoint&, u32 code_point, const Font&, Color);
+    void draw_glyph_run(Span<const GlyphPosition>, const Font&, Color);
     void draw_circle_arc_intersecting(const IntRect&, const IntPoint&, int radius, Color, int thickness);
 
     enum class CornerOrientation {
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Painter.h>
+#include <LibGfx/ParallelPainting.h>
+#include <LibThreading/Thread.h>
+#include <pthread.h>
+#include <unistd.h>
+
+namespace Gfx {
+
+static pthread_mutex_t s_submission_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t s_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t s_wake_condition = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t s_done_condition = PTHREAD_COND_INITIALIZER;
+static Function<void(IntRect const&)> const* s_paint_band;
+static Vector<IntRect>* s_pending_bands;
+static int s_bands_in_flight = 0;
+
+static int thread_count()
+{
+    static int count = 0;
+    if (count == 0) {
+        long result = sysconf(_SC_NPROCESSORS_ONLN);
+        count = result < 1 ? 1 : (int)result;
+    }
+    return count;
+}
+
+static intptr_t worker_thread_func()
+{
+    while (true) {
+        pthread_mutex_lock(&s_mutex);
+        while (s_pending_bands->is_empty())
+            pthread_cond_wait(&s_wake_condition, &s_mutex);
+        auto band = s_pending_bands->take_last();
+        pthread_mutex_unlock(&s_mutex);
+
+        (*s_paint_band)(band);
+
+        pthread_mutex_lock(&s_mutex);
+        if (--s_bands_in_flight == 0)
+            pthread_cond_signal(&s_done_condition);
+        pthread_mutex_unlock(&s_mutex);
+    }
+}
+
+static void spawn_workers_if_needed()
+{
+    if (s_pending_bands)
+        return;
+    s_pending_bands = new Vector<IntRect>;
+    // The calling thread always paints a band too, so one worker per
+    // remaining processor keeps every core busy without oversubscribing.
+    for (int i = 0; i < thread_count() - 1; ++i) {
+        auto& thread = Threading::Thread::construct(worker_thread_func, "Band painter").leak_ref();
+        thread.start();
+    }
+}
+
+void for_each_band_in_parallel(IntRect const& rect, Function<void(IntRect const&)> const& paint_band)
+{
+    if (rect.is_empty())
+        return;
+
+    // Waking up workers for a handful of rows costs more than it saves, and
+    // a single-processor machine may as well paint in place.
+    constexpr int minimum_rows_per_band = 16;
+    int band_count = min(thread_count(), ceil_div(rect.height(), minimum_rows_per_band));
+    if (band_count <= 1) {
+        paint_band(rect);
+        return;
+    }
+
+    // One job at a time; nested calls from a band callback would deadlock.
+    pthread_mutex_lock(&s_submission_mutex);
+    spawn_workers_if_needed();
+
+    int rows_per_band = ceil_div(rect.height(), band_count);
+    Vector<IntRect, 16> bands;
+    for (int y = rect.y(); y <= rect.bottom(); y += rows_per_band)
+        bands.append({ rect.x(), y, rect.width(), min(rows_per_band, rect.bottom() - y + 1) });
+    auto own_band = bands.take_first();
+
+    pthread_mutex_lock(&s_mutex);
+    s_paint_band = &paint_band;
+    s_bands_in_flight = (int)bands.size();
+    s_pending_bands->extend(move(bands));
+    pthread_cond_broadcast(&s_wake_condition);
+    pthread_mutex_unlock(&s_mutex);
+
+    paint_band(own_band);
+
+    pthread_mutex_lock(&s_mutex);
+    while (s_bands_in_flight > 0)
+        pthread_cond_wait(&s_done_condition, &s_mutex);
+    s_paint_band = nullptr;
+    pthread_mutex_unlock(&s_mutex);
+
+    pthread_mutex_unlock(&s_submission_mutex);
+}
+
+void paint_bands_in_parallel(Bitmap& target, IntRect const& rect, Function<void(Painter&, IntRect const&)> const& paint_band)
+{
+    for_each_band_in_parallel(rect.intersected(target.rect()), [&](IntRect const& band_rect) {
+        Painter painter(target);
+        painter.add_clip_rect(band_rect);
+        paint_band(painter, band_rect);
+    });
+}
+
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <LibGfx/Forward.h>
+#include <LibGfx/Rect.h>
+
+namespace Gfx {
+
+// Opt-in band-parallel painting. The given rect is split into horizontal
+// bands which are handed to a pool of worker threads (the calling thread
+// paints one band itself), and the call returns once every band is done.
+// The callback must confine its writes to the band it was given and must
+// not paint recursively through this facility.
+void for_each_band_in_parallel(IntRect const&, Function<void(IntRect const& band_rect)> const&);
+
+// Like above, but hands each band a fresh Painter for the target bitmap,
+// pre-clipped to the band, so concurrent bands write disjoint scanlines.
+void paint_bands_in_parallel(Bitmap& target, IntRect const&, Function<void(Painter&, IntRect const& band_rect)> const&);
+
+}
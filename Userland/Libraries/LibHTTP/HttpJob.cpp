@@ -13,20 +13,33 @@
 
 namespace HTTP {
 void HttpJob::start()
+{
+    start(Core::TCPSocket::construct(this));
+}
+
+void HttpJob::start(NonnullRefPtr<Core::TCPSocket> socket)
 {
     VERIFY(!m_socket);
-    m_socket = Core::TCPSocket::construct(this);
-    m_socket->on_connected = [this] {
-        dbgln_if(CHTTPJOB_DEBUG, "HttpJob: on_connected callback");
-        on_socket_connected();
-    };
+    m_socket = move(socket);
     m_socket->on_error = [this] {
         dbgln_if(CHTTPJOB_DEBUG, "HttpJob: on_error callback");
         deferred_invoke([this] {
             did_fail(Core::NetworkJob::Error::ConnectionFailed);
         });
     };
-    bool success = m_socket->connect(m_request.url().host(), m_request.url().port());
+    if (m_socket->is_connected()) {
+        // This is a keep-alive connection; the request can go out right away.
+        dbgln_if(CHTTPJOB_DEBUG, "HttpJob: taking over an already-connected socket");
+        deferred_invoke([this] {
+            on_socket_connected();
+        });
+        return;
+    }
+    m_socket->on_connected = [this] {
+        dbgln_if(CHTTPJOB_DEBUG, "HttpJob: on_connected callback");
+        on_socket_connected();
+    };
+    bool success = static_cast<Core::TCPSocket&>(*m_socket).connect(m_request.url().host(), m_request.url().port());
     if (!success) {
         deferred_invoke([this] {
             return did_fail(Core::NetworkJob::Error::ConnectionFailed);
@@ -28,6 +28,7 @@ public:
     }
 
     virtual void start() override;
+    void start(NonnullRefPtr<Core::TCPSocket>);
     virtual void shutdown() override;
 
 protected:
@@ -15,14 +15,14 @@
 namespace HTTP {
 
 void HttpsJob::start()
+{
+    start(TLS::TLSv12::construct(this));
+}
+
+void HttpsJob::start(NonnullRefPtr<TLS::TLSv12> socket)
 {
     VERIFY(!m_socket);
-    m_socket = TLS::TLSv12::construct(this);
-    m_socket->set_root_certificates(m_override_ca_certificates ? *m_override_ca_certificates : DefaultRootCACertificates::the().certificates());
-    m_socket->on_tls_connected = [this] {
-        dbgln_if(HTTPSJOB_DEBUG, "HttpsJob: on_connected callback");
-        on_socket_connected();
-    };
+    m_socket = move(socket);
     m_socket->on_tls_error = [&](TLS::AlertDescription error) {
         if (error == TLS::AlertDescription::HandshakeFailure) {
             deferred_invoke([this] {
@@ -46,6 +46,19 @@ void HttpsJob::start()
         if (on_certificate_requested)
             on_certificate_requested(*this);
     };
+    if (m_socket->is_established()) {
+        // This is a keep-alive session; the handshake is long done.
+        dbgln_if(HTTPSJOB_DEBUG, "HttpsJob: taking over an established TLS session");
+        deferred_invoke([this] {
+            on_socket_connected();
+        });
+        return;
+    }
+    m_socket->set_root_certificates(m_override_ca_certificates ? *m_override_ca_certificates : DefaultRootCACertificates::the().certificates());
+    m_socket->on_tls_connected = [this] {
+        dbgln_if(HTTPSJOB_DEBUG, "HttpsJob: on_connected callback");
+        on_socket_connected();
+    };
     bool success = ((TLS::TLSv12&)*m_socket).connect(m_request.url().host(), m_request.url().port());
     if (!success) {
         deferred_invoke([this] {
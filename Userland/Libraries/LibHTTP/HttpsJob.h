@@ -29,6 +29,7 @@ public:
     }
 
     virtual void start() override;
+    void start(NonnullRefPtr<TLS::TLSv12>);
     virtual void shutdown() override;
     void set_certificate(String certificate, String key);
 
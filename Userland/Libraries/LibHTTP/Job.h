@@ -27,10 +27,13 @@ public:
     HttpResponse* response() { return static_cast<HttpResponse*>(Core::NetworkJob::response()); }
     const HttpResponse* response() const { return static_cast<const HttpResponse*>(Core::NetworkJob::response()); }
 
+    // Retries writing buffered-up payload into the output stream; harmless
+    // to call when there's nothing pending.
+    void flush_received_buffers();
+
 protected:
     void finish_up();
     void on_socket_connected();
-    void flush_received_buffers();
     virtual void register_on_ready_to_read(Function<void()>) = 0;
     virtual void register_on_ready_to_write(Function<void()>) = 0;
     virtual bool can_read_line() const = 0;
@@ -8,6 +8,7 @@
 
 #include <AK/ByteBuffer.h>
 #include <AK/NonnullOwnPtrVector.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/Event.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/LocalSocket.h>
@@ -15,6 +16,7 @@
 #include <LibCore/Timer.h>
 #include <LibIPC/Message.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -25,6 +27,12 @@
 
 namespace IPC {
 
+// A message size of ~4 GiB never occurs in practice, so this value in the
+// size field of the wire framing marks a message whose serialized payload
+// was spilled into an anonymous buffer; only the payload size follows on
+// the socket, the contents arrive as a passed descriptor.
+constexpr u32 spilled_message_size_marker = 0xffffffff;
+
 template<typename LocalEndpoint, typename PeerEndpoint>
 class Connection : public Core::Object {
 public:
@@ -43,6 +51,12 @@ public:
         };
     }
 
+    virtual ~Connection() override
+    {
+        // Don't let messages posted during the final event loop turn get lost.
+        flush_pending_messages();
+    }
+
     template<typename MessageType>
     OwnPtr<MessageType> wait_for_specific_message()
     {
@@ -64,10 +78,64 @@ public:
 
         // Prepend the message size.
         uint32_t message_size = buffer.data.size();
+
+#ifdef __serenity__
+        if (message_size > m_large_message_threshold) {
+            // Spill the payload into an anonymous buffer and pass only its
+            // descriptor, so large serialized messages (clipboard contents,
+            // decoded files) don't get copied through the socket buffers.
+            auto anon_buffer = Core::AnonymousBuffer::create_with_size(message_size);
+            if (anon_buffer.is_valid()) {
+                memcpy(anon_buffer.data<u8>(), buffer.data.data(), message_size);
+                u32 payload_size = message_size;
+                buffer.data.clear();
+                buffer.data.append(reinterpret_cast<const u8*>(&payload_size), sizeof(payload_size));
+                // The buffer fd must be the first one the peer receives, ahead
+                // of any descriptors belonging to the message itself.
+                buffer.fds.prepend(adopt_ref(*new AutoCloseFileDescriptor(dup(anon_buffer.fd()))));
+                message_size = spilled_message_size_marker;
+            }
+        }
+#endif
+
         buffer.data.prepend(reinterpret_cast<const u8*>(&message_size), sizeof(message_size));
 
+        // Queue the message instead of writing it out right away; everything
+        // posted during one event loop turn goes to the peer as a single
+        // write, so a burst of small messages costs one syscall, not one per
+        // message.
+        m_pending_bytes.append(buffer.data.data(), buffer.data.size());
+        m_pending_fds.extend(move(buffer.fds));
+
+        if (m_corked)
+            return;
+        schedule_flush();
+    }
+
+    // While corked, posted messages accumulate without even scheduling a
+    // flush; uncork() sends them all at once. Useful for bulk senders that
+    // post many messages from a single code path.
+    void cork() { m_corked = true; }
+
+    void uncork()
+    {
+        m_corked = false;
+        flush_pending_messages();
+    }
+
+    void flush_pending_messages()
+    {
+        if (m_pending_bytes.is_empty() && m_pending_fds.is_empty())
+            return;
+
+        if (!m_socket->is_open()) {
+            m_pending_bytes.clear();
+            m_pending_fds.clear();
+            return;
+        }
+
 #ifdef __serenity__
-        for (auto& fd : buffer.fds) {
+        for (auto& fd : m_pending_fds) {
             auto rc = sendfd(m_socket->fd(), fd->value());
             if (rc < 0) {
                 perror("sendfd");
@@ -75,31 +143,33 @@ public:
             }
         }
 #else
-        if (!buffer.fds.is_empty())
+        if (!m_pending_fds.is_empty())
             warnln("fd passing is not supported on this platform, sorry :(");
 #endif
+        m_pending_fds.clear();
 
         size_t total_nwritten = 0;
-        while (total_nwritten < buffer.data.size()) {
-            auto nwritten = write(m_socket->fd(), buffer.data.data() + total_nwritten, buffer.data.size() - total_nwritten);
+        while (total_nwritten < m_pending_bytes.size()) {
+            auto nwritten = write(m_socket->fd(), m_pending_bytes.data() + total_nwritten, m_pending_bytes.size() - total_nwritten);
             if (nwritten < 0) {
                 switch (errno) {
                 case EPIPE:
-                    dbgln("{}::post_message: Disconnected from peer", *this);
+                    dbgln("{}::flush_pending_messages: Disconnected from peer", *this);
                     shutdown();
                     return;
                 case EAGAIN:
-                    dbgln("{}::post_message: Peer buffer overflowed", *this);
+                    dbgln("{}::flush_pending_messages: Peer buffer overflowed", *this);
                     shutdown();
                     return;
                 default:
-                    perror("Connection::post_message write");
+                    perror("Connection::flush_pending_messages write");
                     shutdown();
                     return;
                 }
             }
             total_nwritten += nwritten;
         }
+        m_pending_bytes.clear();
 
         m_responsiveness_timer->start();
     }
@@ -134,12 +204,32 @@ public:
 
     bool is_open() const { return m_socket->is_open(); }
 
+    // Messages whose serialized size exceeds this are passed as an anonymous
+    // buffer descriptor instead of being streamed through the socket.
+    void set_large_message_threshold(size_t threshold) { m_large_message_threshold = threshold; }
+
 protected:
     Core::LocalSocket& socket() { return *m_socket; }
 
+    void schedule_flush()
+    {
+        if (m_flush_pending)
+            return;
+        m_flush_pending = true;
+        deferred_invoke([this] {
+            m_flush_pending = false;
+            flush_pending_messages();
+        });
+    }
+
     template<typename MessageType, typename Endpoint>
     OwnPtr<MessageType> wait_for_specific_endpoint_message()
     {
+        // We're going to block without returning to the event loop, so any
+        // queued messages (including the request we're waiting on a response
+        // for) have to go out now.
+        flush_pending_messages();
+
         for (;;) {
             // Double check we don't already have the event waiting for us.
             // Otherwise we might end up blocked for a while for no reason.
@@ -209,22 +299,56 @@ protected:
             did_become_responsive();
         }
 
+        auto decode_message_bytes = [&](ReadonlyBytes message_bytes) {
+            if (auto message = LocalEndpoint::decode_message(message_bytes, m_socket->fd())) {
+                m_unprocessed_messages.append(message.release_nonnull());
+                return true;
+            }
+            if (auto message = PeerEndpoint::decode_message(message_bytes, m_socket->fd())) {
+                m_unprocessed_messages.append(message.release_nonnull());
+                return true;
+            }
+            dbgln("Failed to parse a message");
+            return false;
+        };
+
         size_t index = 0;
         u32 message_size = 0;
         for (; index + sizeof(message_size) < bytes.size(); index += message_size) {
             memcpy(&message_size, bytes.data() + index, sizeof(message_size));
+#ifdef __serenity__
+            if (message_size == spilled_message_size_marker) {
+                // The wire only carries the payload size; the payload itself
+                // arrives as an anonymous buffer descriptor, which must be
+                // taken off the socket before any descriptors belonging to
+                // the message itself.
+                u32 payload_size = 0;
+                if (bytes.size() - index - sizeof(message_size) < sizeof(payload_size))
+                    break;
+                memcpy(&payload_size, bytes.data() + index + sizeof(message_size), sizeof(payload_size));
+                index += sizeof(message_size);
+                message_size = sizeof(payload_size);
+                int anon_fd = recvfd(m_socket->fd(), O_CLOEXEC);
+                if (anon_fd < 0) {
+                    dbgln("{}::drain_messages_from_peer: Failed to receive large message buffer", *this);
+                    shutdown();
+                    return false;
+                }
+                auto anon_buffer = Core::AnonymousBuffer::create_from_anon_fd(anon_fd, payload_size);
+                if (!anon_buffer.is_valid()) {
+                    shutdown();
+                    return false;
+                }
+                if (!decode_message_bytes({ anon_buffer.data<u8>(), payload_size }))
+                    break;
+                continue;
+            }
+#endif
             if (message_size == 0 || bytes.size() - index - sizeof(uint32_t) < message_size)
                 break;
             index += sizeof(message_size);
-            auto remaining_bytes = ReadonlyBytes { bytes.data() + index, message_size };
-            if (auto message = LocalEndpoint::decode_message(remaining_bytes, m_socket->fd())) {
-                m_unprocessed_messages.append(message.release_nonnull());
-            } else if (auto message = PeerEndpoint::decode_message(remaining_bytes, m_socket->fd())) {
-                m_unprocessed_messages.append(message.release_nonnull());
-            } else {
-                dbgln("Failed to parse a message");
+            if (!decode_message_bytes({ bytes.data() + index, message_size }))
                 break;
-            }
         }
 
         if (index < bytes.size()) {
@@ -270,6 +394,11 @@ protected:
     RefPtr<Core::Notifier> m_notifier;
     NonnullOwnPtrVector<Message> m_unprocessed_messages;
     ByteBuffer m_unprocessed_bytes;
+    Vector<u8> m_pending_bytes;
+    Vector<RefPtr<AutoCloseFileDescriptor>> m_pending_fds;
+    size_t m_large_message_threshold { 64 * KiB };
+    bool m_corked { false };
+    bool m_flush_pending { false };
 };
 
 }
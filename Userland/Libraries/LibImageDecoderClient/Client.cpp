@@ -5,6 +5,7 @@
  */
 
 #include <LibCore/AnonymousBuffer.h>
+#include <LibCore/EventLoop.h>
 #include <LibImageDecoderClient/Client.h>
 
 namespace ImageDecoderClient {
@@ -16,44 +17,88 @@ Client::Client()
 
 void Client::die()
 {
+    // Fail everything in flight so blocked callers wake up instead of
+    // waiting for a reply that's never coming.
+    auto pending = move(m_pending_requests);
+    for (auto& it : pending)
+        it.value({});
+
     if (on_death)
         on_death();
 }
 
-Optional<DecodedImage> Client::decode_image(const ReadonlyBytes& encoded_data)
+i64 Client::start_decoding(const ReadonlyBytes& encoded_data, Priority priority, Function<void(Optional<DecodedImage>)> on_complete)
 {
     if (encoded_data.is_empty())
-        return {};
+        return -1;
 
     auto encoded_buffer = Core::AnonymousBuffer::create_with_size(encoded_data.size());
     if (!encoded_buffer.is_valid()) {
         dbgln("Could not allocate encoded buffer");
-        return {};
+        return -1;
     }
 
     memcpy(encoded_buffer.data<void>(), encoded_data.data(), encoded_data.size());
-    auto response_or_error = try_decode_image(move(encoded_buffer));
 
-    if (response_or_error.is_error()) {
-        dbgln("ImageDecoder died heroically");
-        return {};
-    }
+    auto image_id = m_next_image_id++;
+    m_pending_requests.set(image_id, move(on_complete));
+    async_decode_image(image_id, move(encoded_buffer), static_cast<i32>(priority));
+    return image_id;
+}
 
-    auto& response = response_or_error.value();
+void Client::cancel_decoding(i64 image_id)
+{
+    if (m_pending_requests.remove(image_id))
+        async_cancel_decoding(image_id);
+}
 
-    if (response.bitmaps().is_empty())
+Optional<DecodedImage> Client::decode_image(const ReadonlyBytes& encoded_data)
+{
+    Optional<DecodedImage> result;
+    Core::EventLoop loop;
+    auto image_id = start_decoding(encoded_data, Priority::Normal, [&](auto image) {
+        result = move(image);
+        loop.quit(0);
+    });
+    if (image_id < 0)
         return {};
+    loop.exec();
+    return result;
+}
+
+void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations)
+{
+    auto it = m_pending_requests.find(image_id);
+    if (it == m_pending_requests.end())
+        return;
+    auto on_complete = move(it->value);
+    m_pending_requests.remove(it);
+
+    if (bitmaps.is_empty()) {
+        on_complete({});
+        return;
+    }
 
     DecodedImage image;
-    image.is_animated = response.is_animated();
-    image.loop_count = response.loop_count();
-    image.frames.resize(response.bitmaps().size());
+    image.is_animated = is_animated;
+    image.loop_count = loop_count;
+    image.frames.resize(bitmaps.size());
     for (size_t i = 0; i < image.frames.size(); ++i) {
         auto& frame = image.frames[i];
-        frame.bitmap = response.bitmaps()[i].bitmap();
-        frame.duration = response.durations()[i];
+        frame.bitmap = bitmaps[i].bitmap();
+        frame.duration = durations[i];
     }
-    return image;
+    on_complete(move(image));
+}
+
+void Client::did_fail_decoding(i64 image_id)
+{
+    auto it = m_pending_requests.find(image_id);
+    if (it == m_pending_requests.end())
+        return;
+    auto on_complete = move(it->value);
+    m_pending_requests.remove(it);
+    on_complete({});
 }
 
 }
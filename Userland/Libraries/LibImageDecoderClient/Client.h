@@ -24,6 +24,14 @@ struct DecodedImage {
     Vector<Frame> frames;
 };
 
+// A hint for how soon the decoded image is going to be needed. The service
+// schedules Visible work ahead of Normal, and Prefetch behind everything else.
+enum class Priority {
+    Visible = 0,
+    Normal,
+    Prefetch,
+};
+
 class Client final
     : public IPC::ServerConnection<ImageDecoderClientEndpoint, ImageDecoderServerEndpoint>
     , public ImageDecoderClientEndpoint {
@@ -32,12 +40,25 @@ class Client final
 public:
     Optional<DecodedImage> decode_image(const ReadonlyBytes&);
 
+    // Hands the encoded data to the service and returns immediately;
+    // on_complete is invoked on this event loop once the image has been
+    // decoded (or has failed, with an empty Optional). Returns the image id
+    // to pass to cancel_decoding(), or -1 if the data was rejected up front.
+    i64 start_decoding(const ReadonlyBytes&, Priority, Function<void(Optional<DecodedImage>)> on_complete);
+    void cancel_decoding(i64 image_id);
+
     Function<void()> on_death;
 
 private:
     Client();
 
     virtual void die() override;
+
+    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Vector<Gfx::ShareableBitmap> const& bitmaps, Vector<u32> const& durations) override;
+    virtual void did_fail_decoding(i64 image_id) override;
+
+    HashMap<i64, Function<void(Optional<DecodedImage>)>> m_pending_requests;
+    i64 m_next_image_id { 0 };
 };
 
 }
@@ -14,6 +14,7 @@
 #include <LibCrypto/BigInt/SignedBigInteger.h>
 #include <LibJS/AST.h>
 #include <LibJS/Interpreter.h>
+#include <LibJS/Parser.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -1388,6 +1389,33 @@ void FunctionNode::dump(int indent, String const& class_name) const
     body().dump(indent + 2);
 }
 
+RefPtr<Statement> LazyFunctionBody::parsed_body() const
+{
+    if (m_parsed_body)
+        return m_parsed_body;
+    if (!m_error_message.is_null())
+        return nullptr;
+
+    Parser parser { Lexer { m_source_text, m_filename, m_start_line, m_start_column } };
+    auto body = parser.parse_function_body_for_lazy_function(m_in_strict_mode, m_in_generator_context);
+    if (parser.has_errors()) {
+        m_error_message = parser.errors()[0].to_string();
+        return nullptr;
+    }
+    m_parsed_body = move(body);
+    return m_parsed_body;
+}
+
+void LazyFunctionBody::dump(int indent) const
+{
+    if (m_parsed_body) {
+        m_parsed_body->dump(indent);
+        return;
+    }
+    print_indent(indent);
+    outln("LazyFunctionBody (not yet parsed, {} bytes of source)", m_source_text.length());
+}
+
 void FunctionDeclaration::dump(int indent) const
 {
     FunctionNode::dump(indent, class_name());
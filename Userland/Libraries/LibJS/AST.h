@@ -61,6 +61,7 @@ public:
     virtual bool is_identifier() const { return false; }
     virtual bool is_scope_node() const { return false; }
     virtual bool is_program() const { return false; }
+    virtual bool is_lazy_function_body() const { return false; }
 
 protected:
     explicit ASTNode(SourceRange source_range)
@@ -438,6 +439,48 @@ private:
     bool m_is_auto_renamed { false };
 };
 
+// A LazyFunctionBody stands in for a function body whose parsing the parser deferred.
+// It owns the body's source text along with enough of the surrounding parser state to
+// parse it for real once the function is actually called.
+class LazyFunctionBody final : public Statement {
+public:
+    LazyFunctionBody(SourceRange source_range, String source_text, String filename, size_t start_line, size_t start_column, bool in_strict_mode, bool in_generator_context)
+        : Statement(source_range)
+        , m_source_text(move(source_text))
+        , m_filename(move(filename))
+        , m_start_line(start_line)
+        , m_start_column(start_column)
+        , m_in_strict_mode(in_strict_mode)
+        , m_in_generator_context(in_generator_context)
+    {
+    }
+
+    // Parses the deferred body, caching the result for subsequent callers. Returns
+    // nullptr if the body turns out to contain a syntax error, in which case
+    // error_message() describes the first one.
+    //
+    // NOTE: Source ranges in the parsed body reference this node's source text, so
+    // anyone holding on to the result must keep this node alive as well.
+    RefPtr<Statement> parsed_body() const;
+    String const& error_message() const { return m_error_message; }
+
+    virtual Value execute(Interpreter&, GlobalObject&) const override { VERIFY_NOT_REACHED(); }
+    virtual void dump(int indent) const override;
+
+private:
+    virtual bool is_lazy_function_body() const override { return true; }
+
+    String m_source_text;
+    String m_filename;
+    size_t m_start_line { 0 };
+    size_t m_start_column { 0 };
+    bool m_in_strict_mode { false };
+    bool m_in_generator_context { false };
+
+    mutable RefPtr<Statement> m_parsed_body;
+    mutable String m_error_message;
+};
+
 class ErrorExpression final : public Expression {
 public:
     explicit ErrorExpression(SourceRange source_range)
@@ -1614,4 +1657,7 @@ inline bool ASTNode::fast_is<ScopeNode>() const { return is_scope_node(); }
 template<>
 inline bool ASTNode::fast_is<Program>() const { return is_program(); }
 
+template<>
+inline bool ASTNode::fast_is<LazyFunctionBody>() const { return is_lazy_function_body(); }
+
 }
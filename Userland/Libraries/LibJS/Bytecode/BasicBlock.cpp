@@ -6,6 +6,7 @@
 
 #include <AK/String.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/NativeCode.h>
 #include <LibJS/Bytecode/Op.h>
 #include <sys/mman.h>
 
@@ -64,6 +65,13 @@ void BasicBlock::grow(size_t additional_size)
     VERIFY(m_buffer_size <= m_buffer_capacity);
 }
 
+NativeCode const* BasicBlock::native_code_for_execution() const
+{
+    if (!m_native_code && ++m_execution_count == native_compilation_threshold)
+        m_native_code = NativeCode::compile(*this);
+    return m_native_code.ptr();
+}
+
 void InstructionStreamIterator::operator++()
 {
     VERIFY(!at_end());
@@ -8,6 +8,7 @@
 
 #include <AK/Badge.h>
 #include <AK/NonnullOwnPtrVector.h>
+#include <AK/OwnPtr.h>
 #include <AK/String.h>
 #include <LibJS/Forward.h>
 
@@ -38,6 +39,8 @@ private:
     size_t m_offset { 0 };
 };
 
+class NativeCode;
+
 struct UnwindInfo {
     BasicBlock const* handler;
     BasicBlock const* finalizer;
@@ -65,14 +68,23 @@ public:
 
     String const& name() const { return m_name; }
 
+    // Bumps the block's execution counter and, once the block has proven
+    // itself hot, hands it to the baseline JIT. Returns null until (and
+    // unless) compilation has happened.
+    NativeCode const* native_code_for_execution() const;
+
 private:
     BasicBlock(String name, size_t size);
 
+    static constexpr size_t native_compilation_threshold = 64;
+
     u8* m_buffer { nullptr };
     size_t m_buffer_capacity { 0 };
     size_t m_buffer_size { 0 };
     bool m_is_terminated { false };
     String m_name;
+    mutable size_t m_execution_count { 0 };
+    mutable OwnPtr<NativeCode> m_native_code;
 };
 
 }
@@ -77,6 +77,8 @@
 
 namespace JS::Bytecode {
 
+class Register;
+
 class Instruction {
 public:
     constexpr static bool IsTerminator = false;
@@ -94,6 +96,7 @@ public:
     String to_string(Bytecode::Executable const&) const;
     void execute(Bytecode::Interpreter&) const;
     void replace_references(BasicBlock const&, BasicBlock const&);
+    void visit_register_references(Function<void(Register&)>);
     static void destroy(Instruction&);
 
 protected:
@@ -9,6 +9,7 @@
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/NativeCode.h>
 #include <LibJS/Bytecode/Op.h>
 #include <LibJS/Runtime/GlobalEnvironment.h>
 #include <LibJS/Runtime/GlobalObject.h>
@@ -68,47 +69,37 @@ Value Interpreter::run(Executable const& executable, BasicBlock const* entry_poi
     }
 
     for (;;) {
-        Bytecode::InstructionStreamIterator pc(block->instruction_stream());
         bool will_jump = false;
         bool will_return = false;
-        while (!pc.at_end()) {
-            auto& instruction = *pc;
-            instruction.execute(*this);
-            if (vm().exception()) {
-                m_saved_exception = {};
-                if (m_unwind_contexts.is_empty())
-                    break;
-                auto& unwind_context = m_unwind_contexts.last();
-                if (unwind_context.handler) {
-                    block = unwind_context.handler;
-                    unwind_context.handler = nullptr;
-                    accumulator() = vm().exception()->value();
-                    vm().clear_exception();
-                    will_jump = true;
-                } else if (unwind_context.finalizer) {
-                    block = unwind_context.finalizer;
-                    m_unwind_contexts.take_last();
-                    will_jump = true;
-                    m_saved_exception = Handle<Exception>::create(vm().exception());
-                    vm().clear_exception();
-                }
-            }
-            if (m_pending_jump.has_value()) {
-                block = m_pending_jump.release_value();
-                will_jump = true;
-                break;
-            }
-            if (!m_return_value.is_empty()) {
+        bool reached_end_of_block = false;
+
+        if (auto* native_code = block->native_code_for_execution()) {
+            NativeExecutionState state { *this, block };
+            auto result = static_cast<InstructionResult>(native_code->run(state));
+            block = state.block;
+            will_jump = state.will_jump;
+            if (result == InstructionResult::Return)
                 will_return = true;
+            reached_end_of_block = result == InstructionResult::Continue;
+        } else {
+            Bytecode::InstructionStreamIterator pc(block->instruction_stream());
+            while (!pc.at_end()) {
+                auto result = execute_one_instruction(*pc, block, will_jump);
+                if (result == InstructionResult::Continue) {
+                    ++pc;
+                    continue;
+                }
+                if (result == InstructionResult::Return)
+                    will_return = true;
                 break;
             }
-            ++pc;
+            reached_end_of_block = pc.at_end();
         }
 
         if (will_return)
             break;
 
-        if (pc.at_end() && !will_jump)
+        if (reached_end_of_block && !will_jump)
             break;
 
         if (vm().exception())
@@ -148,6 +139,38 @@ Value Interpreter::run(Executable const& executable, BasicBlock const* entry_poi
     return return_value;
 }
 
+Interpreter::InstructionResult Interpreter::execute_one_instruction(Instruction const& instruction, BasicBlock const*& block, bool& will_jump)
+{
+    instruction.execute(*this);
+    if (vm().exception()) {
+        m_saved_exception = {};
+        if (m_unwind_contexts.is_empty())
+            return InstructionResult::Exception;
+        auto& unwind_context = m_unwind_contexts.last();
+        if (unwind_context.handler) {
+            block = unwind_context.handler;
+            unwind_context.handler = nullptr;
+            accumulator() = vm().exception()->value();
+            vm().clear_exception();
+            will_jump = true;
+        } else if (unwind_context.finalizer) {
+            block = unwind_context.finalizer;
+            m_unwind_contexts.take_last();
+            will_jump = true;
+            m_saved_exception = Handle<Exception>::create(vm().exception());
+            vm().clear_exception();
+        }
+    }
+    if (m_pending_jump.has_value()) {
+        block = m_pending_jump.release_value();
+        will_jump = true;
+        return InstructionResult::Jump;
+    }
+    if (!m_return_value.is_empty())
+        return InstructionResult::Return;
+    return InstructionResult::Continue;
+}
+
 void Interpreter::enter_unwind_context(Optional<Label> handler_target, Optional<Label> finalizer_target)
 {
     m_unwind_contexts.empend(handler_target.has_value() ? &handler_target->block() : nullptr, finalizer_target.has_value() ? &finalizer_target->block() : nullptr);
@@ -158,6 +181,18 @@ void Interpreter::leave_unwind_context()
     m_unwind_contexts.take_last();
 }
 
+void Interpreter::gather_roots(HashTable<Cell*>& roots)
+{
+    for (auto& window : m_register_windows) {
+        for (auto value : window) {
+            if (value.is_cell())
+                roots.set(&value.as_cell());
+        }
+    }
+    if (m_return_value.is_cell())
+        roots.set(&m_return_value.as_cell());
+}
+
 void Interpreter::continue_pending_unwind(Label const& resume_label)
 {
     if (!m_saved_exception.is_null()) {
@@ -190,6 +225,10 @@ Bytecode::PassManager& Interpreter::optimization_pipeline(Interpreter::Optimizat
         pm->add<Passes::GenerateCFG>();
         pm->add<Passes::MergeBlocks>();
         pm->add<Passes::GenerateCFG>();
+        pm->add<Passes::Peephole>();
+        pm->add<Passes::GenerateCFG>();
+        pm->add<Passes::ReuseRegisters>();
+        pm->add<Passes::GenerateCFG>();
         pm->add<Passes::PlaceBlocks>();
     } else {
         VERIFY_NOT_REACHED();
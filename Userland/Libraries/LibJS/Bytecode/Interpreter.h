@@ -18,6 +18,8 @@
 
 namespace JS::Bytecode {
 
+class Instruction;
+
 using RegisterWindow = Vector<Value>;
 
 class Interpreter {
@@ -33,6 +35,22 @@ public:
 
     Value run(Bytecode::Executable const&, Bytecode::BasicBlock const* entry_point = nullptr);
 
+    // Why execution of an instruction stopped (or didn't.) Continue must be
+    // zero: JIT-compiled code tests the result against zero to decide
+    // whether to keep going.
+    enum class InstructionResult : u32 {
+        Continue = 0,
+        Jump,
+        Return,
+        Exception,
+    };
+
+    // Executes a single instruction, including unwind handling. Shared
+    // between the interpreter loop and the baseline JIT so both tiers
+    // behave identically. `block` and `will_jump` are updated when the
+    // instruction transfers control to another block.
+    InstructionResult execute_one_instruction(Instruction const&, BasicBlock const*& block, bool& will_jump);
+
     ALWAYS_INLINE Value& accumulator() { return reg(Register::accumulator()); }
     Value& reg(Register const& r) { return registers()[r.index()]; }
     [[nodiscard]] RegisterWindow snapshot_frame() const { return m_register_windows.last(); }
@@ -61,6 +79,10 @@ public:
 
     Executable const& current_executable() { return *m_current_executable; }
 
+    // The register windows hold live Values that aren't reachable through the
+    // VM or the machine stack, so the GC has to treat them as roots.
+    void gather_roots(HashTable<Cell*>&);
+
     enum class OptimizationLevel {
         Default,
         __Count,
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Vector.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/NativeCode.h>
+#include <string.h>
+#include <sys/mman.h>
+
+namespace JS::Bytecode {
+
+#if ARCH(X86_64)
+
+// The single runtime entry point shared by all compiled instructions.
+// It runs the instruction through the exact same path as the interpreter
+// loop, so compiled and interpreted execution can never disagree.
+extern "C" u32 bytecode_jit_execute_instruction(NativeExecutionState*, Instruction const*);
+extern "C" u32 bytecode_jit_execute_instruction(NativeExecutionState* state, Instruction const* instruction)
+{
+    return to_underlying(state->interpreter.execute_one_instruction(*instruction, state->block, state->will_jump));
+}
+
+OwnPtr<NativeCode> NativeCode::compile(BasicBlock const& block)
+{
+    // We emit, for each instruction in the block:
+    //
+    //     mov rdi, rbx                        ; NativeExecutionState*
+    //     mov rsi, <instruction address>
+    //     mov rax, <bytecode_jit_execute_instruction>
+    //     call rax
+    //     test eax, eax                       ; InstructionResult::Continue?
+    //     jnz .epilogue
+    //
+    // wrapped in a prologue that stashes the state pointer in rbx (which
+    // also keeps the stack 16-byte aligned at each call site.) Instruction
+    // addresses can be baked in because a BasicBlock's buffer never moves
+    // once code generation has finished.
+    Vector<u8> code;
+
+    auto emit_u64 = [&](u64 value) {
+        for (size_t i = 0; i < 8; ++i)
+            code.append((value >> (i * 8)) & 0xff);
+    };
+
+    // push rbx
+    code.append(0x53);
+    // mov rbx, rdi
+    code.append(0x48);
+    code.append(0x89);
+    code.append(0xfb);
+
+    Vector<size_t> branch_patch_offsets;
+
+    InstructionStreamIterator it { block.instruction_stream() };
+    while (!it.at_end()) {
+        auto& instruction = *it;
+        // mov rdi, rbx
+        code.append(0x48);
+        code.append(0x89);
+        code.append(0xdf);
+        // mov rsi, imm64
+        code.append(0x48);
+        code.append(0xbe);
+        emit_u64(bit_cast<u64>(&instruction));
+        // mov rax, imm64
+        code.append(0x48);
+        code.append(0xb8);
+        emit_u64(bit_cast<u64>(&bytecode_jit_execute_instruction));
+        // call rax
+        code.append(0xff);
+        code.append(0xd0);
+        // test eax, eax
+        code.append(0x85);
+        code.append(0xc0);
+        // jnz rel32 (target patched in below)
+        code.append(0x0f);
+        code.append(0x85);
+        branch_patch_offsets.append(code.size());
+        for (size_t i = 0; i < 4; ++i)
+            code.append(0);
+        ++it;
+    }
+
+    // xor eax, eax (InstructionResult::Continue, i.e. we ran off the end)
+    code.append(0x31);
+    code.append(0xc0);
+
+    auto epilogue_offset = code.size();
+    // pop rbx
+    code.append(0x5b);
+    // ret
+    code.append(0xc3);
+
+    for (auto patch_offset : branch_patch_offsets) {
+        auto relative = static_cast<u32>(epilogue_offset - (patch_offset + 4));
+        for (size_t i = 0; i < 4; ++i)
+            code[patch_offset + i] = (relative >> (i * 8)) & 0xff;
+    }
+
+    auto* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (memory == MAP_FAILED)
+        return {};
+    memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) < 0) {
+        munmap(memory, code.size());
+        return {};
+    }
+
+    dbgln_if(JS_BYTECODE_DEBUG, "Baseline JIT compiled block {:p} ({} bytes of bytecode, {} bytes of machine code)", &block, block.size(), code.size());
+
+    return adopt_own(*new NativeCode(memory, code.size()));
+}
+
+u32 NativeCode::run(NativeExecutionState& state) const
+{
+    auto* entry_point = bit_cast<u32 (*)(NativeExecutionState*)>(m_code);
+    return entry_point(&state);
+}
+
+#else
+
+OwnPtr<NativeCode> NativeCode::compile(BasicBlock const&)
+{
+    return {};
+}
+
+u32 NativeCode::run(NativeExecutionState&) const
+{
+    VERIFY_NOT_REACHED();
+}
+
+#endif
+
+NativeCode::NativeCode(void* code, size_t size)
+    : m_code(code)
+    , m_size(size)
+{
+}
+
+NativeCode::~NativeCode()
+{
+    if (m_code)
+        munmap(m_code, m_size);
+}
+
+}
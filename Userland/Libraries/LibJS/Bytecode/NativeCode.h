@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/Types.h>
+#include <LibJS/Forward.h>
+
+namespace JS::Bytecode {
+
+class BasicBlock;
+class Interpreter;
+
+// State shared between the interpreter's run loop and JIT-compiled code.
+// The trampoline updates `block` and `will_jump` exactly like the
+// interpreted path does, so the run loop can pick up where the native
+// code left off.
+struct NativeExecutionState {
+    Interpreter& interpreter;
+    BasicBlock const* block;
+    bool will_jump { false };
+};
+
+// A BasicBlock's worth of machine code produced by the baseline JIT.
+// This is a template JIT in the simplest possible sense: each bytecode
+// instruction is compiled to a call into the shared runtime slow path
+// (Interpreter::execute_one_instruction), which removes the decode and
+// dispatch overhead of the interpreter loop without duplicating any
+// instruction semantics. Compilation is only attempted for blocks that
+// have proven themselves hot.
+class NativeCode {
+    AK_MAKE_NONCOPYABLE(NativeCode);
+    AK_MAKE_NONMOVABLE(NativeCode);
+
+public:
+    // Returns null if the block could not be compiled (e.g. unsupported
+    // architecture, or executable memory was unavailable.)
+    static OwnPtr<NativeCode> compile(BasicBlock const&);
+
+    ~NativeCode();
+
+    // Executes the block and returns an Interpreter::InstructionResult
+    // describing why execution stopped.
+    u32 run(NativeExecutionState&) const;
+
+private:
+    NativeCode(void* code, size_t size);
+
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+};
+
+}
@@ -224,16 +224,115 @@ void SetVariable::execute_impl(Bytecode::Interpreter& interpreter) const
     interpreter.vm().set_variable(interpreter.current_executable().get_string(m_identifier), interpreter.accumulator(), interpreter.global_object());
 }
 
+static bool object_supports_cached_property_lookup(Object const& object)
+{
+    // Exotic objects whose [[Get]]/[[Set]] overrides don't boil down to a
+    // plain storage slot access have to take the generic path every time.
+    return !object.is_proxy_object() && !object.is_typed_array() && !object.is_arguments_object();
+}
+
+static bool object_supports_direct_element_access(Object const& object)
+{
+    // String objects materialize their characters as integer-indexed
+    // properties via overridden internal methods, so element accesses can't
+    // go straight to the packed storage either.
+    return object_supports_cached_property_lookup(object) && !object.is_string_object();
+}
+
+static Optional<size_t> cacheable_property_offset(Object const& object, PropertyName const& property_name, bool for_write)
+{
+    auto& shape = object.shape();
+    // Unique shapes change layout without changing identity, so they can't
+    // serve as a cache key.
+    if (shape.is_unique())
+        return {};
+    auto metadata = shape.lookup(property_name.to_string_or_symbol());
+    if (!metadata.has_value())
+        return {};
+    if (for_write && !metadata->attributes.is_writable())
+        return {};
+    // Getters and setters still need the generic path.
+    if (object.get_direct(metadata->offset).is_accessor())
+        return {};
+    return metadata->offset;
+}
+
+static void add_property_lookup_cache_entry(PropertyLookupCache& cache, Shape& shape, size_t property_offset)
+{
+    // Insert at the front so the most recently seen shape is the first one
+    // checked; everything else moves down one slot.
+    for (size_t i = PropertyLookupCache::max_entries - 1; i > 0; --i)
+        cache.entries[i] = cache.entries[i - 1];
+    cache.entries[0] = { shape.make_weak_ptr(), property_offset };
+}
+
 void GetById::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    if (auto* object = interpreter.accumulator().to_object(interpreter.global_object()))
-        interpreter.accumulator() = object->get(interpreter.current_executable().get_string(m_property));
+    auto* object = interpreter.accumulator().to_object(interpreter.global_object());
+    if (!object)
+        return;
+
+    if (object_supports_cached_property_lookup(*object)) {
+        auto& shape = object->shape();
+        for (auto& entry : m_cache.entries) {
+            if (entry.shape.ptr() != &shape)
+                continue;
+            auto value = object->get_direct(entry.property_offset);
+            // Shape transitions are keyed on (name, attributes), which doesn't
+            // distinguish accessors from data properties - so the slot may hold
+            // an Accessor even though it didn't when the cache entry was made.
+            // Take the generic path in that case.
+            if (value.is_accessor())
+                break;
+            interpreter.accumulator() = value;
+            return;
+        }
+    }
+
+    auto property_name = interpreter.current_executable().get_string(m_property);
+    interpreter.accumulator() = object->get(property_name);
+    if (interpreter.vm().exception())
+        return;
+
+    if (!object_supports_cached_property_lookup(*object))
+        return;
+    // Note: Only own data properties get cached; anything found further up
+    // the prototype chain would also need the whole chain validated on hit.
+    if (auto offset = cacheable_property_offset(*object, property_name, false); offset.has_value())
+        add_property_lookup_cache_entry(m_cache, object->shape(), offset.value());
 }
 
 void PutById::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    if (auto* object = interpreter.reg(m_base).to_object(interpreter.global_object()))
-        object->set(interpreter.current_executable().get_string(m_property), interpreter.accumulator(), Object::ShouldThrowExceptions::Yes);
+    auto* object = interpreter.reg(m_base).to_object(interpreter.global_object());
+    if (!object)
+        return;
+
+    if (object_supports_cached_property_lookup(*object)) {
+        auto& shape = object->shape();
+        for (auto& entry : m_cache.entries) {
+            if (entry.shape.ptr() != &shape)
+                continue;
+            // Only writable own data properties get cached, but shape
+            // transitions are keyed on (name, attributes) and so don't
+            // distinguish accessors from data properties - re-check that the
+            // slot still holds a plain data property before storing into it.
+            if (object->get_direct(entry.property_offset).is_accessor())
+                break;
+            object->put_direct(entry.property_offset, interpreter.accumulator());
+            return;
+        }
+    }
+
+    auto property_name = interpreter.current_executable().get_string(m_property);
+    object->set(property_name, interpreter.accumulator(), Object::ShouldThrowExceptions::Yes);
+    if (interpreter.vm().exception())
+        return;
+
+    if (!object_supports_cached_property_lookup(*object))
+        return;
+    if (auto offset = cacheable_property_offset(*object, property_name, true); offset.has_value())
+        add_property_lookup_cache_entry(m_cache, object->shape(), offset.value());
 }
 
 void Jump::execute_impl(Bytecode::Interpreter& interpreter) const
@@ -410,10 +509,40 @@ void Yield::replace_references_impl(BasicBlock const& from, BasicBlock const& to
         m_continuation_label = Label { to };
 }
 
+// To write an element without consulting the prototype chain, nothing on that
+// chain may have indexed properties of its own that a [[Set]] walk could find.
+static bool prototype_chain_allows_direct_element_write(Object const& object)
+{
+    Object const* prototype = object.internal_get_prototype_of();
+    while (prototype) {
+        if (!object_supports_cached_property_lookup(*prototype))
+            return false;
+        if (!prototype->indexed_properties().is_empty())
+            return false;
+        prototype = prototype->internal_get_prototype_of();
+    }
+    return true;
+}
+
 void GetByValue::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    if (auto* object = interpreter.reg(m_base).to_object(interpreter.global_object())) {
-        auto property_key = interpreter.accumulator().to_property_key(interpreter.global_object());
+    auto base_value = interpreter.reg(m_base);
+    auto property_value = interpreter.accumulator();
+
+    // Fast path: reading an existing dense array element can go straight to the
+    // packed element storage instead of through ToPropertyKey and [[Get]].
+    if (base_value.is_object() && property_value.type() == Value::Type::Int32 && property_value.as_i32() >= 0) {
+        auto const& object = base_value.as_object();
+        if (object_supports_direct_element_access(object)) {
+            if (auto value = object.indexed_properties().get_packed_element(static_cast<u32>(property_value.as_i32())); value.has_value()) {
+                interpreter.accumulator() = *value;
+                return;
+            }
+        }
+    }
+
+    if (auto* object = base_value.to_object(interpreter.global_object())) {
+        auto property_key = property_value.to_property_key(interpreter.global_object());
         if (interpreter.vm().exception())
             return;
         interpreter.accumulator() = object->get(property_key);
@@ -422,8 +551,32 @@ void GetByValue::execute_impl(Bytecode::Interpreter& interpreter) const
 
 void PutByValue::execute_impl(Bytecode::Interpreter& interpreter) const
 {
-    if (auto* object = interpreter.reg(m_base).to_object(interpreter.global_object())) {
-        auto property_key = interpreter.reg(m_property).to_property_key(interpreter.global_object());
+    auto base_value = interpreter.reg(m_base);
+    auto property_value = interpreter.reg(m_property);
+
+    // Fast path: overwriting an existing dense array element writes to the packed
+    // storage directly. Appending one-past-the-end also goes direct when the
+    // prototype chain can't intercept the write and the object can take new
+    // properties; that keeps the classic a[i] = v fill loop on the fast path.
+    if (base_value.is_object() && property_value.type() == Value::Type::Int32 && property_value.as_i32() >= 0) {
+        auto& object = base_value.as_object();
+        if (object_supports_direct_element_access(object)) {
+            auto index = static_cast<u32>(property_value.as_i32());
+            auto& indexed_properties = object.indexed_properties();
+            if (indexed_properties.overwrite_packed_element(index, interpreter.accumulator()))
+                return;
+            if (index == indexed_properties.array_like_size()
+                && object.is_extensible()
+                && (!is<Array>(object) || static_cast<Array const&>(object).length_is_writable())
+                && prototype_chain_allows_direct_element_write(object)) {
+                indexed_properties.put(index, interpreter.accumulator());
+                return;
+            }
+        }
+    }
+
+    if (auto* object = base_value.to_object(interpreter.global_object())) {
+        auto property_key = property_value.to_property_key(interpreter.global_object());
         if (interpreter.vm().exception())
             return;
         object->set(property_key, interpreter.accumulator(), Object::ShouldThrowExceptions::Yes);
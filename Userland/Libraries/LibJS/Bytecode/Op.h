@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <AK/WeakPtr.h>
 #include <LibCrypto/BigInt/SignedBigInteger.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Label.h>
@@ -30,6 +31,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>& callback) { callback(m_src); }
+
+    Register src() const { return m_src; }
 
 private:
     Register m_src;
@@ -46,6 +50,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
+
+    Value value() const { return m_value; }
 
 private:
     Value m_value;
@@ -62,6 +69,9 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>& callback) { callback(m_dst); }
+
+    Register dst() const { return m_dst; }
 
 private:
     Register m_dst;
@@ -103,6 +113,9 @@ private:
         void execute_impl(Bytecode::Interpreter&) const;                       \
         String to_string_impl(Bytecode::Executable const&) const;              \
         void replace_references_impl(BasicBlock const&, BasicBlock const&) { } \
+        void visit_register_references_impl(Function<void(Register&)>& callback) { callback(m_lhs_reg); } \
+                                                                               \
+        Register lhs_reg() const { return m_lhs_reg; }                         \
                                                                                \
     private:                                                                   \
         Register m_lhs_reg;                                                    \
@@ -129,6 +142,7 @@ JS_ENUMERATE_COMMON_BINARY_OPS(JS_DECLARE_COMMON_BINARY_OP)
         void execute_impl(Bytecode::Interpreter&) const;                       \
         String to_string_impl(Bytecode::Executable const&) const;              \
         void replace_references_impl(BasicBlock const&, BasicBlock const&) { } \
+        void visit_register_references_impl(Function<void(Register&)>&) { }    \
     };
 
 JS_ENUMERATE_COMMON_UNARY_OPS(JS_DECLARE_COMMON_UNARY_OP)
@@ -145,6 +159,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 
 private:
     StringTableIndex m_string;
@@ -160,6 +175,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 };
 
 class NewRegExp final : public Instruction {
@@ -174,6 +190,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 
 private:
     StringTableIndex m_source_index;
@@ -195,6 +212,12 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>& callback)
+    {
+        callback(m_from_object);
+        for (size_t i = 0; i < m_excluded_names_count; ++i)
+            callback(m_excluded_names[i]);
+    }
 
     size_t length_impl() const { return sizeof(*this) + sizeof(Register) * m_excluded_names_count; }
 
@@ -215,6 +238,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 
 private:
     Crypto::SignedBigInteger m_bigint;
@@ -240,6 +264,11 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>& callback)
+    {
+        for (size_t i = 0; i < m_element_count; ++i)
+            callback(m_elements[i]);
+    }
 
     size_t length_impl() const
     {
@@ -261,6 +290,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 };
 
 class ConcatString final : public Instruction {
@@ -274,6 +304,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>& callback) { callback(m_lhs); }
 
 private:
     Register m_lhs;
@@ -290,6 +321,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 
 private:
     StringTableIndex m_identifier;
@@ -306,11 +338,28 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 
 private:
     StringTableIndex m_identifier;
 };
 
+// A per-instruction cache of where a property lives in the storage of
+// receivers with a given shape, so that repeated accesses from the same
+// instruction load a slot directly instead of doing hash lookups. The first
+// entry is the monomorphic fast path; the remaining entries absorb call
+// sites that see a handful of different shapes. Dead shapes drop out via
+// the WeakPtr, and shapes that mutate in place (unique shapes) are never
+// cached, so a pointer match means the offset is still right.
+struct PropertyLookupCache {
+    static constexpr size_t max_entries = 4;
+    struct Entry {
+        WeakPtr<Shape> shape;
+        size_t property_offset { 0 };
+    };
+    Entry entries[max_entries];
+};
+
 class GetById final : public Instruction {
 public:
     explicit GetById(StringTableIndex property)
@@ -322,9 +371,11 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 
 private:
     StringTableIndex m_property;
+    mutable PropertyLookupCache m_cache;
 };
 
 class PutById final : public Instruction {
@@ -339,10 +390,12 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>& callback) { callback(m_base); }
 
 private:
     Register m_base;
     StringTableIndex m_property;
+    mutable PropertyLookupCache m_cache;
 };
 
 class GetByValue final : public Instruction {
@@ -356,6 +409,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>& callback) { callback(m_base); }
 
 private:
     Register m_base;
@@ -373,6 +427,11 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>& callback)
+    {
+        callback(m_base);
+        callback(m_property);
+    }
 
 private:
     Register m_base;
@@ -406,6 +465,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 
     auto& true_target() const { return m_true_target; }
     auto& false_target() const { return m_false_target; }
@@ -470,6 +530,13 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>& callback)
+    {
+        callback(m_callee);
+        callback(m_this_value);
+        for (size_t i = 0; i < m_argument_count; ++i)
+            callback(m_arguments[i]);
+    }
 
     size_t length_impl() const
     {
@@ -495,6 +562,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 
 private:
     ClassExpression const& m_class_expression;
@@ -511,6 +579,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 
 private:
     FunctionNode const& m_function_node;
@@ -528,6 +597,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 };
 
 class Increment final : public Instruction {
@@ -540,6 +610,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 };
 
 class Decrement final : public Instruction {
@@ -552,6 +623,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 };
 
 class Throw final : public Instruction {
@@ -566,6 +638,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 };
 
 class EnterUnwindContext final : public Instruction {
@@ -583,6 +656,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 
     auto& entry_point() const { return m_entry_point; }
     auto& handler_target() const { return m_handler_target; }
@@ -604,6 +678,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 };
 
 class ContinuePendingUnwind final : public Instruction {
@@ -619,6 +694,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 
     auto& resume_target() const { return m_resume_target; }
 
@@ -644,6 +720,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&);
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 
     auto& continuation() const { return m_continuation_label; }
 
@@ -662,6 +739,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 
 private:
     HashMap<u32, Variable> m_variables;
@@ -677,6 +755,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 };
 
 class IteratorNext final : public Instruction {
@@ -689,6 +768,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 };
 
 class IteratorResultDone final : public Instruction {
@@ -701,6 +781,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 };
 
 class IteratorResultValue final : public Instruction {
@@ -713,6 +794,7 @@ public:
     void execute_impl(Bytecode::Interpreter&) const;
     String to_string_impl(Bytecode::Executable const&) const;
     void replace_references_impl(BasicBlock const&, BasicBlock const&) { }
+    void visit_register_references_impl(Function<void(Register&)>&) { }
 };
 
 }
@@ -749,6 +831,21 @@ ALWAYS_INLINE void Instruction::replace_references(BasicBlock const& from, Basic
 #undef __BYTECODE_OP
 }
 
+ALWAYS_INLINE void Instruction::visit_register_references(Function<void(Register&)> callback)
+{
+#define __BYTECODE_OP(op)       \
+    case Instruction::Type::op: \
+        return static_cast<Bytecode::Op::op&>(*this).visit_register_references_impl(callback);
+
+    switch (type()) {
+        ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+#undef __BYTECODE_OP
+}
+
 ALWAYS_INLINE size_t Instruction::length() const
 {
     if (type() == Type::Call)
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// Evaluates a binary operation on two constant operands, following the same
+// semantics as the runtime would. Only pure numeric operations are folded;
+// anything that could observe the global object (valueOf, string coercion,
+// and so on) is left for the interpreter.
+static Optional<Value> try_fold_binary_op(Instruction::Type type, Value lhs, Value rhs)
+{
+    if (!lhs.is_number() || !rhs.is_number())
+        return {};
+
+    bool both_int32 = lhs.type() == Value::Type::Int32 && rhs.type() == Value::Type::Int32;
+    auto fits_in_int32 = [](i64 value) {
+        return value >= NumericLimits<i32>::min() && value <= NumericLimits<i32>::max();
+    };
+
+    switch (type) {
+    case Instruction::Type::Add:
+        if (both_int32) {
+            auto result = static_cast<i64>(lhs.as_i32()) + rhs.as_i32();
+            if (fits_in_int32(result))
+                return Value(static_cast<i32>(result));
+        }
+        return Value(lhs.as_double() + rhs.as_double());
+    case Instruction::Type::Sub:
+        if (both_int32) {
+            auto result = static_cast<i64>(lhs.as_i32()) - rhs.as_i32();
+            if (fits_in_int32(result))
+                return Value(static_cast<i32>(result));
+        }
+        return Value(lhs.as_double() - rhs.as_double());
+    case Instruction::Type::Mul:
+        if (both_int32) {
+            auto result = static_cast<i64>(lhs.as_i32()) * rhs.as_i32();
+            // A zero result needs the sign of the operands to pick between
+            // +0 and -0, which Int32 cannot represent - use the double path.
+            if (fits_in_int32(result) && (result != 0 || (lhs.as_i32() >= 0 && rhs.as_i32() >= 0)))
+                return Value(static_cast<i32>(result));
+        }
+        return Value(lhs.as_double() * rhs.as_double());
+    case Instruction::Type::Div:
+        return Value(lhs.as_double() / rhs.as_double());
+    default:
+        return {};
+    }
+}
+
+void Peephole::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    VERIFY(executable.exported_blocks.has_value());
+
+    // Since instructions are variable-length and tightly packed, we can't
+    // splice them out in place; instead we plan all rewrites for a block and
+    // then rebuild it, MergeBlocks-style, retargeting any references.
+    struct Action {
+        enum Kind {
+            Copy,
+            Skip,
+            ReplaceWithLoadImmediate,
+        } kind { Copy };
+        size_t offset { 0 };
+        size_t length { 0 };
+        Value value;
+    };
+
+    for (size_t block_index = 0; block_index < executable.executable.basic_blocks.size(); ++block_index) {
+        auto& block = executable.executable.basic_blocks[block_index];
+
+        // Exported blocks may be referenced from outside the executable
+        // (e.g. a suspended generator), so we cannot swap them out.
+        if (executable.exported_blocks->contains(&block))
+            continue;
+
+        Vector<Action> actions;
+        bool did_optimize = false;
+
+        // Abstract interpretation state within the block: what constant the
+        // accumulator holds, what constants registers hold, and which
+        // register (if any) currently mirrors the accumulator. Only Store
+        // writes to a register, so other instructions just clobber the
+        // accumulator knowledge.
+        Optional<Value> accumulator_value;
+        HashMap<u32, Value> known_register_values;
+        Optional<u32> register_mirroring_accumulator;
+
+        // A pure accumulator write (Load/LoadImmediate) whose result hasn't
+        // been consumed yet; if the accumulator is overwritten before
+        // anything reads it, the write is dead and can be dropped.
+        Optional<size_t> pending_accumulator_load_action;
+        auto kill_pending_accumulator_load = [&] {
+            if (!pending_accumulator_load_action.has_value())
+                return;
+            actions[*pending_accumulator_load_action].kind = Action::Skip;
+            pending_accumulator_load_action = {};
+            did_optimize = true;
+        };
+
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            auto offset = it.offset();
+            auto& instruction = *it;
+            ++it;
+            auto length = it.offset() - offset;
+
+            switch (instruction.type()) {
+            case Instruction::Type::LoadImmediate:
+                kill_pending_accumulator_load();
+                accumulator_value = static_cast<Op::LoadImmediate const&>(instruction).value();
+                register_mirroring_accumulator = {};
+                actions.append({ Action::Copy, offset, length, {} });
+                pending_accumulator_load_action = actions.size() - 1;
+                break;
+            case Instruction::Type::Store: {
+                auto dst = static_cast<Op::Store const&>(instruction).dst();
+                if (accumulator_value.has_value())
+                    known_register_values.set(dst.index(), *accumulator_value);
+                else
+                    known_register_values.remove(dst.index());
+                register_mirroring_accumulator = dst.index();
+                pending_accumulator_load_action = {};
+                actions.append({ Action::Copy, offset, length, {} });
+                break;
+            }
+            case Instruction::Type::Load: {
+                auto src = static_cast<Op::Load const&>(instruction).src();
+                if (register_mirroring_accumulator == src.index()) {
+                    // The accumulator already holds this register's value.
+                    actions.append({ Action::Skip, offset, length, {} });
+                    did_optimize = true;
+                    break;
+                }
+                kill_pending_accumulator_load();
+                if (auto known_value = known_register_values.get(src.index()); known_value.has_value()) {
+                    actions.append({ Action::ReplaceWithLoadImmediate, offset, length, *known_value });
+                    did_optimize = true;
+                    accumulator_value = *known_value;
+                } else {
+                    accumulator_value = {};
+                    actions.append({ Action::Copy, offset, length, {} });
+                }
+                register_mirroring_accumulator = src.index();
+                pending_accumulator_load_action = actions.size() - 1;
+                break;
+            }
+            case Instruction::Type::Add:
+            case Instruction::Type::Sub:
+            case Instruction::Type::Mul:
+            case Instruction::Type::Div: {
+                // All the common binary ops share a layout; Add is as good a
+                // representative as any for reading the LHS register.
+                auto lhs_reg = static_cast<Op::Add const&>(instruction).lhs_reg();
+                Optional<Value> folded;
+                if (accumulator_value.has_value()) {
+                    if (auto lhs_value = known_register_values.get(lhs_reg.index()); lhs_value.has_value())
+                        folded = try_fold_binary_op(instruction.type(), *lhs_value, *accumulator_value);
+                }
+                if (folded.has_value()) {
+                    // The folded result replaces this op, so the instruction
+                    // that loaded the right-hand operand into the accumulator
+                    // no longer has a consumer.
+                    kill_pending_accumulator_load();
+                    actions.append({ Action::ReplaceWithLoadImmediate, offset, length, *folded });
+                    did_optimize = true;
+                    pending_accumulator_load_action = actions.size() - 1;
+                } else {
+                    pending_accumulator_load_action = {};
+                    actions.append({ Action::Copy, offset, length, {} });
+                }
+                accumulator_value = folded;
+                register_mirroring_accumulator = {};
+                break;
+            }
+            default:
+                accumulator_value = {};
+                register_mirroring_accumulator = {};
+                pending_accumulator_load_action = {};
+                actions.append({ Action::Copy, offset, length, {} });
+                break;
+            }
+        }
+
+        if (!did_optimize)
+            continue;
+
+        size_t new_size = 0;
+        for (auto& action : actions) {
+            if (action.kind == Action::Copy)
+                new_size += action.length;
+            else if (action.kind == Action::ReplaceWithLoadImmediate)
+                new_size += sizeof(Op::LoadImmediate);
+        }
+
+        auto new_block = BasicBlock::create(block.name(), new_size);
+        for (auto& action : actions) {
+            switch (action.kind) {
+            case Action::Copy:
+                __builtin_memcpy(new_block->next_slot(), block.instruction_stream().data() + action.offset, action.length);
+                new_block->grow(action.length);
+                break;
+            case Action::Skip:
+                break;
+            case Action::ReplaceWithLoadImmediate:
+                new (new_block->next_slot()) Op::LoadImmediate(action.value);
+                new_block->grow(sizeof(Op::LoadImmediate));
+                break;
+            }
+        }
+
+        auto* old_block = &block;
+        auto* replacement = new_block.ptr();
+        executable.executable.basic_blocks.insert(block_index, move(new_block));
+        for (auto& candidate : executable.executable.basic_blocks) {
+            InstructionStreamIterator rewrite_it { candidate.instruction_stream() };
+            while (!rewrite_it.at_end()) {
+                auto& candidate_instruction = *rewrite_it;
+                ++rewrite_it;
+                const_cast<Instruction&>(candidate_instruction).replace_references(*old_block, *replacement);
+            }
+        }
+        executable.executable.basic_blocks.remove(block_index + 1);
+    }
+
+    finished();
+}
+
+}
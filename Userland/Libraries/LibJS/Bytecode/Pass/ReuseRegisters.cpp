@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// The generator allocates a fresh register for nearly every intermediate value and
+// never hands one back, so frames end up far larger than the number of values that
+// are ever live at the same time. This pass runs a classic backwards liveness
+// analysis over the CFG, builds an interference graph, and renumbers the registers
+// so that values whose live ranges don't overlap share a slot.
+
+static bool is_reserved_register(Register const& reg)
+{
+    return reg.index() == Register::accumulator_index || reg.index() == Register::global_object_index;
+}
+
+void ReuseRegisters::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    VERIFY(executable.cfg.has_value());
+
+    struct BlockLiveness {
+        // Registers read before any write in the block.
+        HashTable<u32> use;
+        // Registers written in the block.
+        HashTable<u32> def;
+        HashTable<u32> live_in;
+        HashTable<u32> live_out;
+    };
+
+    // Note that only Store writes a register - everything else either reads one or
+    // only touches the accumulator.
+    auto is_definition = [](Instruction const& instruction) {
+        return instruction.type() == Instruction::Type::Store;
+    };
+
+    HashMap<BasicBlock const*, BlockLiveness> liveness;
+    HashTable<u32> seen_registers;
+    Vector<BasicBlock const*> handler_blocks;
+
+    for (auto& block : executable.executable.basic_blocks) {
+        auto& entry = liveness.ensure(&block);
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            ++it;
+            instruction.visit_register_references([&](Register& reg) {
+                if (is_reserved_register(reg))
+                    return;
+                seen_registers.set(reg.index());
+                if (is_definition(instruction)) {
+                    entry.def.set(reg.index());
+                } else if (!entry.def.contains(reg.index())) {
+                    entry.use.set(reg.index());
+                }
+            });
+            if (instruction.type() == Instruction::Type::EnterUnwindContext) {
+                auto& enter_unwind_context = static_cast<Op::EnterUnwindContext const&>(instruction);
+                if (enter_unwind_context.handler_target().has_value())
+                    handler_blocks.append(&enter_unwind_context.handler_target()->block());
+                if (enter_unwind_context.finalizer_target().has_value())
+                    handler_blocks.append(&enter_unwind_context.finalizer_target()->block());
+            }
+        }
+    }
+
+    if (seen_registers.is_empty()) {
+        finished();
+        return;
+    }
+
+    // Standard iterative dataflow: live_out is the union of the successors' live_in,
+    // live_in = use + (live_out - def). The sets only ever grow, so comparing sizes
+    // is enough to detect the fixpoint.
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto& block : executable.executable.basic_blocks) {
+            auto& entry = liveness.find(&block)->value;
+            if (auto successors = executable.cfg->find(&block); successors != executable.cfg->end()) {
+                for (auto& successor : successors->value) {
+                    for (auto index : liveness.find(successor)->value.live_in)
+                        entry.live_out.set(index);
+                }
+            }
+            auto old_live_in_size = entry.live_in.size();
+            for (auto index : entry.use)
+                entry.live_in.set(index);
+            for (auto index : entry.live_out) {
+                if (!entry.def.contains(index))
+                    entry.live_in.set(index);
+            }
+            if (entry.live_in.size() != old_live_in_size)
+                changed = true;
+        }
+    }
+
+    // The CFG only has an exception edge at the EnterUnwindContext instruction
+    // itself, while an exception can of course be thrown from anywhere inside the
+    // context. Registers that a handler or finalizer reads must therefore survive
+    // the whole protected region - pin them so nothing gets coalesced into them.
+    HashTable<u32> pinned_registers;
+    for (auto* block : handler_blocks) {
+        for (auto index : liveness.find(block)->value.live_in)
+            pinned_registers.set(index);
+    }
+    // A register that's live on function entry is read before any visible write;
+    // play it safe and pin those too.
+    for (auto index : liveness.find(&executable.executable.basic_blocks.first())->value.live_in)
+        pinned_registers.set(index);
+
+    // Build the interference graph: at every definition, the defined register
+    // interferes with everything live at that point. This needs a backwards walk,
+    // and the instruction stream only iterates forwards, so collect offsets first.
+    HashMap<u32, HashTable<u32>> interference;
+    for (auto index : seen_registers)
+        interference.ensure(index);
+
+    for (auto& block : executable.executable.basic_blocks) {
+        Vector<size_t> offsets;
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            offsets.append(it.offset());
+            ++it;
+        }
+
+        auto live = liveness.find(&block)->value.live_out;
+        for (size_t i = offsets.size(); i > 0; --i) {
+            auto& instruction = const_cast<Instruction&>(*reinterpret_cast<Instruction const*>(block.instruction_stream().data() + offsets[i - 1]));
+            if (is_definition(instruction)) {
+                instruction.visit_register_references([&](Register& reg) {
+                    if (is_reserved_register(reg))
+                        return;
+                    for (auto live_index : live) {
+                        if (live_index == reg.index())
+                            continue;
+                        interference.find(reg.index())->value.set(live_index);
+                        interference.find(live_index)->value.set(reg.index());
+                    }
+                    live.remove(reg.index());
+                });
+            } else {
+                instruction.visit_register_references([&](Register& reg) {
+                    if (!is_reserved_register(reg))
+                        live.set(reg.index());
+                });
+            }
+        }
+    }
+
+    // Greedily assign each register the lowest free slot, walking in increasing
+    // index order so early registers keep low numbers. Pinned registers keep their
+    // original index, and nothing else may move into a pinned slot.
+    Vector<u32> sorted_registers;
+    for (auto index : seen_registers)
+        sorted_registers.append(index);
+    quick_sort(sorted_registers);
+
+    HashMap<u32, u32> new_register_index;
+    u32 max_assigned_index = Register::global_object_index;
+
+    for (auto index : sorted_registers) {
+        if (pinned_registers.contains(index)) {
+            new_register_index.set(index, index);
+            max_assigned_index = max(max_assigned_index, index);
+        }
+    }
+
+    for (auto index : sorted_registers) {
+        if (pinned_registers.contains(index))
+            continue;
+        auto& neighbors = interference.find(index)->value;
+        for (u32 candidate = Register::global_object_index + 1;; ++candidate) {
+            if (pinned_registers.contains(candidate))
+                continue;
+            bool taken = false;
+            for (auto neighbor : neighbors) {
+                if (auto assigned = new_register_index.get(neighbor); assigned.has_value() && *assigned == candidate) {
+                    taken = true;
+                    break;
+                }
+            }
+            if (!taken) {
+                new_register_index.set(index, candidate);
+                max_assigned_index = max(max_assigned_index, candidate);
+                break;
+            }
+        }
+    }
+
+    for (auto& block : executable.executable.basic_blocks) {
+        InstructionStreamIterator it { block.instruction_stream() };
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            ++it;
+            instruction.visit_register_references([&](Register& reg) {
+                if (is_reserved_register(reg))
+                    return;
+                reg = Register { new_register_index.get(reg.index()).value() };
+            });
+        }
+    }
+
+    executable.executable.number_of_registers = max_assigned_index + 1;
+
+    finished();
+}
+
+}
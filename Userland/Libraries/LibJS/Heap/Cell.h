@@ -24,6 +24,9 @@ public:
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
+    bool is_old() const { return m_old; }
+    void set_old(bool b) { m_old = b; }
+
     enum class State {
         Live,
         Dead,
@@ -57,9 +60,16 @@ public:
 protected:
     Cell() { }
 
+    // Write barrier for the generational garbage collector. Minor collections
+    // don't trace the old generation, so any cell that has a reference to
+    // another cell stored into it after construction must report the mutation
+    // here to end up in the heap's remembered set.
+    void did_mutate();
+
 private:
     bool m_mark : 1 { false };
-    State m_state : 7 { State::Live };
+    bool m_old : 1 { false };
+    State m_state : 6 { State::Live };
 };
 
 }
@@ -71,7 +71,13 @@ Cell* Heap::allocate_cell(size_t size)
         collect_garbage();
     } else if (m_allocations_since_last_gc > m_max_allocations_between_gc) {
         m_allocations_since_last_gc = 0;
-        collect_garbage();
+        // Most collections only look at the young generation, where most
+        // garbage is. A full collection happens every so often to pick up
+        // old-generation garbage as well.
+        if (m_minor_collections_since_last_major_gc >= m_max_minor_collections_between_major_gc)
+            collect_garbage();
+        else
+            collect_garbage(CollectionType::CollectMinorGarbage);
     } else {
         ++m_allocations_since_last_gc;
     }
@@ -92,16 +98,25 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
 
     Core::ElapsedTimer collection_measurement_timer;
     collection_measurement_timer.start();
-    if (collection_type == CollectionType::CollectGarbage) {
+    if (collection_type != CollectionType::CollectEverything) {
         if (m_gc_deferrals) {
             m_should_gc_when_deferral_ends = true;
             return;
         }
         HashTable<Cell*> roots;
         gather_roots(roots);
-        mark_live_cells(roots);
+        mark_live_cells(collection_type, roots);
     }
-    sweep_dead_cells(print_report, collection_measurement_timer);
+    sweep_dead_cells(collection_type, print_report, collection_measurement_timer);
+
+    // Sweeping promotes every survivor to the old generation, so there are no
+    // old-to-young references left to remember.
+    m_remembered_set.clear();
+
+    if (collection_type == CollectionType::CollectMinorGarbage)
+        ++m_minor_collections_since_last_major_gc;
+    else
+        m_minor_collections_since_last_major_gc = 0;
 }
 
 void Heap::gather_roots(HashTable<Cell*>& roots)
@@ -137,17 +152,25 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
 
     HashTable<FlatPtr> possible_pointers;
 
+    // A word on the stack may hold a heap pointer either directly or NaN-boxed
+    // inside an encoded Value, so consider both interpretations.
+    auto add_possible_value = [&](FlatPtr data) {
+        possible_pointers.set(data);
+        if (auto pointer_bits = Value::extract_pointer_bits(data))
+            possible_pointers.set(pointer_bits);
+    };
+
     auto* raw_jmp_buf = reinterpret_cast<FlatPtr const*>(buf);
 
     for (size_t i = 0; i < ((size_t)sizeof(buf)) / sizeof(FlatPtr); i += sizeof(FlatPtr))
-        possible_pointers.set(raw_jmp_buf[i]);
+        add_possible_value(raw_jmp_buf[i]);
 
     auto stack_reference = bit_cast<FlatPtr>(&dummy);
     auto& stack_info = m_vm.stack_info();
 
     for (FlatPtr stack_address = stack_reference; stack_address < stack_info.top(); stack_address += sizeof(FlatPtr)) {
         auto data = *reinterpret_cast<FlatPtr*>(stack_address);
-        possible_pointers.set(data);
+        add_possible_value(data);
     }
 
     HashTable<HeapBlock*> all_live_heap_blocks;
@@ -176,33 +199,59 @@ __attribute__((no_sanitize("address"))) void Heap::gather_conservative_roots(Has
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    MarkingVisitor() { }
+    explicit MarkingVisitor(bool visit_old_generation)
+        : m_visit_old_generation(visit_old_generation)
+    {
+    }
 
     virtual void visit_impl(Cell& cell)
     {
         if (cell.is_marked())
             return;
+        // Minor collections never sweep the old generation, and all of its
+        // references into the young generation are covered by the remembered
+        // set, so marking can stop at the generation boundary.
+        if (!m_visit_old_generation && cell.is_old())
+            return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
         cell.set_marked(true);
         cell.visit_edges(*this);
     }
+
+private:
+    bool m_visit_old_generation { true };
 };
 
-void Heap::mark_live_cells(const HashTable<Cell*>& roots)
+void Heap::mark_live_cells(CollectionType collection_type, const HashTable<Cell*>& roots)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
-    MarkingVisitor visitor;
+    MarkingVisitor visitor(collection_type != CollectionType::CollectMinorGarbage);
+
+    if (collection_type == CollectionType::CollectMinorGarbage) {
+        // Mutated old cells may reference young cells, so their outgoing
+        // references count as roots. Note that we don't mark the old cells
+        // themselves; they are not eligible for sweeping anyway.
+        for (auto* cell : m_remembered_set)
+            cell->visit_edges(visitor);
+    }
+
     for (auto* root : roots)
         visitor.visit(root);
 
     for (auto& inverse_root : m_uprooted_cells)
         inverse_root->set_marked(false);
 
-    m_uprooted_cells.clear();
+    if (collection_type == CollectionType::CollectMinorGarbage) {
+        // Uprooted old cells survive minor collections; keep them around so
+        // the next full collection gets rid of them.
+        m_uprooted_cells.remove_all_matching([](auto* cell) { return !cell->is_old(); });
+    } else {
+        m_uprooted_cells.clear();
+    }
 }
 
-void Heap::sweep_dead_cells(bool print_report, const Core::ElapsedTimer& measurement_timer)
+void Heap::sweep_dead_cells(CollectionType collection_type, bool print_report, const Core::ElapsedTimer& measurement_timer)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
     Vector<HeapBlock*, 32> empty_blocks;
@@ -214,11 +263,23 @@ void Heap::sweep_dead_cells(bool print_report, const Core::ElapsedTimer& measure
     size_t collected_cell_bytes = 0;
     size_t live_cell_bytes = 0;
 
+    bool is_minor_collection = collection_type == CollectionType::CollectMinorGarbage;
+
     auto should_store_swept_cells = !m_weak_containers.is_empty();
     for_each_block([&](auto& block) {
+        // Blocks that haven't been allocated into since the last collection
+        // contain no young cells, so a minor collection can skip them.
+        if (is_minor_collection && !block.has_young_cells())
+            return IterationDecision::Continue;
         bool block_has_live_cells = false;
         bool block_was_full = block.is_full();
         block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (is_minor_collection && cell->is_old()) {
+                block_has_live_cells = true;
+                ++live_cells;
+                live_cell_bytes += block.cell_size();
+                return;
+            }
             if (!cell->is_marked()) {
                 dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
                 if (should_store_swept_cells)
@@ -228,11 +289,16 @@ void Heap::sweep_dead_cells(bool print_report, const Core::ElapsedTimer& measure
                 collected_cell_bytes += block.cell_size();
             } else {
                 cell->set_marked(false);
+                // Promote all survivors at once. This way there can be no
+                // references from promoted cells to cells left in the young
+                // generation, which keeps the write barrier simple.
+                cell->set_old(true);
                 block_has_live_cells = true;
                 ++live_cells;
                 live_cell_bytes += block.cell_size();
             }
         });
+        block.set_has_young_cells(false);
         if (!block_has_live_cells)
             empty_blocks.append(&block);
         else if (block_was_full != block.is_full())
@@ -338,4 +404,9 @@ void Heap::uproot_cell(Cell* cell)
     m_uprooted_cells.append(cell);
 }
 
+void Cell::did_mutate()
+{
+    heap().did_mutate_cell(*this);
+}
+
 }
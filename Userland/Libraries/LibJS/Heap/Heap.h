@@ -58,7 +58,13 @@ public:
     }
 
     enum class CollectionType {
+        // Mark and sweep the whole heap.
         CollectGarbage,
+        // Only sweep the young generation, using the remembered set to stand
+        // in for old-to-young references. This is what keeps steady-state
+        // pauses short; full collections still happen periodically to get rid
+        // of old-generation garbage.
+        CollectMinorGarbage,
         CollectEverything,
     };
 
@@ -85,13 +91,24 @@ public:
 
     void uproot_cell(Cell* cell);
 
+    // Called (via Cell::did_mutate()) whenever a reference to another cell is
+    // stored into an existing cell. Old cells that have been mutated may point
+    // into the young generation, so minor collections treat their outgoing
+    // references as roots.
+    void did_mutate_cell(Cell& cell)
+    {
+        if (!cell.is_old())
+            return;
+        m_remembered_set.set(&cell);
+    }
+
 private:
     Cell* allocate_cell(size_t);
 
     void gather_roots(HashTable<Cell*>&);
     void gather_conservative_roots(HashTable<Cell*>&);
-    void mark_live_cells(const HashTable<Cell*>& live_cells);
-    void sweep_dead_cells(bool print_report, const Core::ElapsedTimer&);
+    void mark_live_cells(CollectionType, const HashTable<Cell*>& live_cells);
+    void sweep_dead_cells(CollectionType, bool print_report, const Core::ElapsedTimer&);
 
     CellAllocator& allocator_for_size(size_t);
 
@@ -107,6 +124,9 @@ private:
     size_t m_max_allocations_between_gc { 10000 };
     size_t m_allocations_since_last_gc { 0 };
 
+    size_t m_max_minor_collections_between_major_gc { 16 };
+    size_t m_minor_collections_since_last_major_gc { 0 };
+
     bool m_should_collect_on_every_allocation { false };
 
     VM& m_vm;
@@ -121,6 +141,8 @@ private:
 
     Vector<Cell*> m_uprooted_cells;
 
+    HashTable<Cell*> m_remembered_set;
+
     BlockAllocator m_block_allocator;
 
     size_t m_gc_deferrals { 0 };
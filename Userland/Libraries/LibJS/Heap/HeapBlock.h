@@ -42,10 +42,16 @@ public:
 
         if (allocated_cell) {
             ASAN_UNPOISON_MEMORY_REGION(allocated_cell, m_cell_size);
+            m_has_young_cells = true;
         }
         return allocated_cell;
     }
 
+    // Minor collections only need to sweep blocks that have been allocated
+    // into since the last collection promoted all survivors.
+    bool has_young_cells() const { return m_has_young_cells; }
+    void set_has_young_cells(bool b) { m_has_young_cells = b; }
+
     void deallocate(Cell*);
 
     template<typename Callback>
@@ -110,6 +116,7 @@ private:
     size_t m_cell_size { 0 };
     size_t m_next_lazy_freelist_index { 0 };
     FreelistEntry* m_freelist { nullptr };
+    bool m_has_young_cells { false };
     alignas(Cell) u8 m_storage[];
 
 public:
@@ -1825,7 +1825,22 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u8 parse_options)
     m_state.function_parameters.append(parameters);
 
     bool is_strict = false;
-    auto body = parse_block_statement(is_strict, !is_simple_parameter_list(parameters));
+
+    // Plain function bodies don't have to be parsed until the function is actually
+    // called; see try_skip_function_body(). Anything whose body needs more of the
+    // surrounding parser context than that placeholder captures (methods, getters,
+    // setters, class constructors) keeps the eager path.
+    RefPtr<Statement> body;
+    constexpr u8 lazy_compatible_parse_options = FunctionNodeParseOptions::CheckForFunctionAndName | FunctionNodeParseOptions::IsGeneratorFunction;
+    if ((parse_options & ~lazy_compatible_parse_options) == 0)
+        body = try_skip_function_body(is_generator);
+    if (body) {
+        is_strict = m_state.strict_mode;
+    } else {
+        auto block = parse_block_statement(is_strict, !is_simple_parameter_list(parameters));
+        scope.add_to_scope_node(block);
+        body = move(block);
+    }
 
     // If the function contains 'use strict' we need to check the parameters (again).
     if (is_strict || is_generator) {
@@ -1865,14 +1880,89 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u8 parse_options)
 
     m_state.function_parameters.take_last();
 
-    scope.add_to_scope_node(body);
-
     return create_ast_node<FunctionNodeType>(
         { m_state.current_token.filename(), rule_start.position(), position() },
-        name, move(body), move(parameters), function_length,
+        name, body.release_nonnull(), move(parameters), function_length,
         is_generator ? FunctionKind::Generator : FunctionKind::Regular, is_strict);
 }
 
+RefPtr<LazyFunctionBody> Parser::try_skip_function_body(bool in_generator_context)
+{
+    auto rule_start = push_start();
+    if (!match(TokenType::CurlyOpen))
+        return {};
+
+    // Token::offset() records the lexer's position *after* the token, so derive a
+    // token's start offset from its value, which is a view into the source.
+    auto token_start_offset = [this](Token const& token) -> size_t {
+        return token.value().characters_without_null_termination() - m_state.lexer.source().characters_without_null_termination();
+    };
+
+    auto start_line = m_state.current_token.line_number();
+    auto start_column = m_state.current_token.line_column();
+    auto start_offset = token_start_offset(m_state.current_token);
+    auto filename = m_state.current_token.filename();
+
+    save_state();
+    ArmedScopeGuard state_rollback_guard = [&] {
+        load_state();
+    };
+
+    consume(TokenType::CurlyOpen);
+
+    // A directive prologue may switch the function into strict mode, which changes how
+    // its name and parameters get validated - those functions just parse eagerly.
+    if (match(TokenType::StringLiteral))
+        return {};
+
+    // Find the matching closing brace by walking the token stream. The lexer tracks
+    // template literal expressions itself and gives their braces dedicated token
+    // types, so a simple nesting count is enough here. Note that this only verifies
+    // that the body tokenizes with balanced braces - real syntax errors inside it are
+    // deferred until the function is first called.
+    size_t open_curlies = 1;
+    Optional<size_t> end_offset;
+    while (!done()) {
+        if (match(TokenType::CurlyOpen)) {
+            ++open_curlies;
+        } else if (match(TokenType::CurlyClose)) {
+            if (--open_curlies == 0) {
+                end_offset = token_start_offset(m_state.current_token) + 1;
+                consume();
+                break;
+            }
+        }
+        consume();
+    }
+
+    if (!end_offset.has_value())
+        return {};
+
+    state_rollback_guard.disarm();
+    discard_saved_state();
+
+    auto source_text = String { m_state.lexer.source().substring_view(start_offset, end_offset.value() - start_offset) };
+    return create_ast_node<LazyFunctionBody>(
+        { m_state.current_token.filename(), rule_start.position(), position() },
+        move(source_text), filename, start_line, start_column, m_state.strict_mode, in_generator_context);
+}
+
+NonnullRefPtr<Statement> Parser::parse_function_body_for_lazy_function(bool in_strict_mode, bool in_generator_context)
+{
+    ScopePusher scope(*this, ScopePusher::Var, Parser::Scope::Function);
+
+    TemporaryChange strict_mode_change(m_state.strict_mode, in_strict_mode);
+    TemporaryChange generator_change(m_state.in_generator_function_context, in_generator_context);
+    TemporaryChange function_change(m_state.in_function_context, true);
+
+    // NOTE: try_skip_function_body() only defers bodies without a directive prologue,
+    // so the non-simple parameter list check in parse_block_statement() cannot trigger.
+    bool is_strict = false;
+    auto body = parse_block_statement(is_strict, false);
+    scope.add_to_scope_node(body);
+    return body;
+}
+
 Vector<FunctionNode::Parameter> Parser::parse_formal_parameters(int& function_length, u8 parse_options)
 {
     auto rule_start = push_start();
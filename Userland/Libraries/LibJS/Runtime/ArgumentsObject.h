@@ -22,6 +22,8 @@ public:
 
     Environment& environment() { return m_environment; }
 
+    virtual bool is_arguments_object() const override { return true; }
+
     virtual Optional<PropertyDescriptor> internal_get_own_property(PropertyName const&) const override;
     virtual bool internal_define_own_property(PropertyName const&, PropertyDescriptor const&) override;
     virtual Value internal_get(PropertyName const&, Value receiver) const override;
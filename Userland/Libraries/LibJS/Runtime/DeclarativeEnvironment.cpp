@@ -50,6 +50,7 @@ Optional<Variable> DeclarativeEnvironment::get_from_environment(FlyString const&
 bool DeclarativeEnvironment::put_into_environment(FlyString const& name, Variable variable)
 {
     m_variables.set(name, variable);
+    did_mutate();
     return true;
 }
 
@@ -100,6 +101,7 @@ void DeclarativeEnvironment::initialize_binding(GlobalObject&, FlyString const&
     VERIFY(it->value.initialized == false);
     it->value.value = value;
     it->value.initialized = true;
+    did_mutate();
 }
 
 // 9.1.1.1.5 SetMutableBinding ( N, V, S ), https://tc39.es/ecma262/#sec-declarative-environment-records-setmutablebinding-n-v-s
@@ -126,6 +128,7 @@ void DeclarativeEnvironment::set_mutable_binding(GlobalObject& global_object, Fl
 
     if (it->value.mutable_) {
         it->value.value = value;
+        did_mutate();
     } else {
         if (strict) {
             global_object.vm().throw_exception<TypeError>(global_object, ErrorType::InvalidAssignToConst);
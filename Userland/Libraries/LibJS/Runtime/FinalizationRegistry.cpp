@@ -28,6 +28,7 @@ void FinalizationRegistry::add_finalization_record(Cell& target, Value held_valu
 {
     VERIFY(!held_value.is_empty());
     m_records.append({ &target, held_value, unregister_token });
+    did_mutate();
 }
 
 bool FinalizationRegistry::remove_by_token(Object& unregister_token)
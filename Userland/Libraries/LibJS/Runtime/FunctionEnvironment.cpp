@@ -77,6 +77,7 @@ Value FunctionEnvironment::bind_this_value(GlobalObject& global_object, Value th
     }
     m_this_value = this_value;
     m_this_binding_status = ThisBindingStatus::Initialized;
+    did_mutate();
     return this_value;
 }
 
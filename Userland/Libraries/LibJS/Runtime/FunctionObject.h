@@ -35,7 +35,11 @@ public:
     const Vector<Value>& bound_arguments() const { return m_bound_arguments; }
 
     Object* home_object() const { return m_home_object; }
-    void set_home_object(Object* home_object) { m_home_object = home_object; }
+    void set_home_object(Object* home_object)
+    {
+        m_home_object = home_object;
+        did_mutate();
+    }
 
     ConstructorKind constructor_kind() const { return m_constructor_kind; };
     void set_constructor_kind(ConstructorKind constructor_kind) { m_constructor_kind = constructor_kind; }
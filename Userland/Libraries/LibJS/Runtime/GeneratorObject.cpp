@@ -48,6 +48,9 @@ void GeneratorObject::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_generating_function);
     if (m_previous_value.is_object())
         visitor.visit(&m_previous_value.as_object());
+    // The captured frame keeps the suspended function's registers alive.
+    for (auto value : m_frame)
+        visitor.visit(value);
 }
 
 Value GeneratorObject::next_impl(VM& vm, GlobalObject& global_object, Optional<Value> value_to_throw)
@@ -111,6 +114,11 @@ Value GeneratorObject::next_impl(VM& vm, GlobalObject& global_object, Optional<V
 
     m_previous_value = bytecode_interpreter->run(*m_generating_function->bytecode_executable(), next_block);
 
+    // Resuming mutated both m_previous_value and the captured frame. The write
+    // barrier has to come after the stores: a collection during the run clears
+    // the remembered set, so a barrier issued up front would be lost.
+    did_mutate();
+
     bytecode_interpreter->leave_frame();
 
     m_done = generated_continuation(m_previous_value) == nullptr;
@@ -124,6 +124,39 @@ public:
     void put(u32 index, Value value, PropertyAttributes attributes = default_attributes);
     void remove(u32 index);
 
+    // Fast-path accessors for dense packed elements, so hot element loops don't
+    // have to go through the generic property machinery. An empty result (or
+    // false) means a hole, an accessor, or non-simple storage - the caller must
+    // then fall back to the generic path.
+    Optional<Value> get_packed_element(u32 index) const
+    {
+        if (!m_storage->is_simple_storage())
+            return {};
+        auto& storage = static_cast<SimpleIndexedPropertyStorage const&>(*m_storage);
+        if (!storage.has_index(index))
+            return {};
+        auto value = storage.elements()[index];
+        if (value.is_accessor())
+            return {};
+        return value;
+    }
+
+    // Overwrites an existing packed element in place. Only valid for elements
+    // that already exist, since those are plain own data properties that no
+    // setter on the prototype chain can intercept.
+    bool overwrite_packed_element(u32 index, Value value)
+    {
+        if (!m_storage->is_simple_storage())
+            return false;
+        auto& storage = static_cast<SimpleIndexedPropertyStorage&>(*m_storage);
+        if (!storage.has_index(index))
+            return false;
+        if (storage.elements()[index].is_accessor())
+            return false;
+        storage.put(index, value);
+        return true;
+    }
+
     ValueAndAttributes take_first(Object* this_object);
     ValueAndAttributes take_last(Object* this_object);
 
@@ -23,7 +23,15 @@ public:
     virtual ~Map() override;
 
     OrderedHashMap<Value, Value, ValueTraits> const& entries() const { return m_entries; };
-    OrderedHashMap<Value, Value, ValueTraits>& entries() { return m_entries; };
+    OrderedHashMap<Value, Value, ValueTraits>& entries()
+    {
+        // Handing out a mutable reference counts as a mutation as far as the
+        // generational GC's write barrier is concerned. Since the barrier is
+        // issued before the store here, callers must not allocate between
+        // obtaining the reference and mutating through it.
+        did_mutate();
+        return m_entries;
+    };
 
 private:
     virtual void visit_edges(Visitor& visitor) override;
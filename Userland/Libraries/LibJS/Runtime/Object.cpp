@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
 #include <AK/String.h>
 #include <AK/TemporaryChange.h>
 #include <LibJS/Interpreter.h>
@@ -55,7 +56,7 @@ Object::Object(Object& prototype)
 Object::Object(Shape& shape)
     : m_shape(&shape)
 {
-    m_storage.resize(shape.property_count());
+    resize_storage(shape.property_count());
 }
 
 void Object::initialize(GlobalObject&)
@@ -539,7 +540,7 @@ bool Object::internal_set_prototype_of(Object* new_prototype)
     if (shape.is_unique())
         shape.set_prototype_without_transition(new_prototype);
     else
-        m_shape = shape.create_prototype_transition(new_prototype);
+        set_shape(*shape.create_prototype_transition(new_prototype));
 
     // 10. Return true.
     return true;
@@ -918,7 +919,7 @@ Optional<ValueAndAttributes> Object::storage_get(PropertyName const& property_na
         auto metadata = shape().lookup(property_name.to_string_or_symbol());
         if (!metadata.has_value())
             return {};
-        value = m_storage[metadata->offset];
+        value = storage_value_at(metadata->offset);
         attributes = metadata->attributes;
     }
     return ValueAndAttributes { .value = value, .attributes = attributes };
@@ -936,6 +937,10 @@ void Object::storage_set(PropertyName const& property_name, ValueAndAttributes c
 {
     VERIFY(property_name.is_valid());
 
+    // The write barrier has to come after the store - a minor collection in
+    // between would clear the remembered set and lose the entry.
+    ScopeGuard barrier = [&] { did_mutate(); };
+
     auto [value, attributes] = value_and_attributes;
 
     if (property_name.is_number()) {
@@ -955,7 +960,7 @@ void Object::storage_set(PropertyName const& property_name, ValueAndAttributes c
         else
             m_shape->add_property_without_transition(property_name_string_or_symbol, attributes);
 
-        m_storage.append(value);
+        append_storage_value(value);
         return;
     }
 
@@ -975,7 +980,7 @@ void Object::storage_set(PropertyName const& property_name, ValueAndAttributes c
         else
             set_shape(*m_shape->create_put_transition(property_name_string_or_symbol, attributes));
 
-        m_storage.append(value);
+        append_storage_value(value);
         return;
     }
 
@@ -988,7 +993,7 @@ void Object::storage_set(PropertyName const& property_name, ValueAndAttributes c
             set_shape(*m_shape->create_configure_transition(property_name_string_or_symbol, attributes));
     }
 
-    m_storage[metadata->offset] = value;
+    set_storage_value_at(metadata->offset, value);
 }
 
 void Object::storage_delete(PropertyName const& property_name)
@@ -1005,7 +1010,7 @@ void Object::storage_delete(PropertyName const& property_name)
     ensure_shape_is_unique();
 
     shape().remove_property_from_unique_shape(property_name.to_string_or_symbol(), metadata->offset);
-    m_storage.remove(metadata->offset);
+    remove_storage_value_at(metadata->offset);
 }
 
 void Object::define_native_accessor(PropertyName const& property_name, Function<Value(VM&, GlobalObject&)> getter, Function<Value(VM&, GlobalObject&)> setter, PropertyAttributes attribute)
@@ -1070,7 +1075,59 @@ void Object::ensure_shape_is_unique()
     if (shape().is_unique())
         return;
 
-    m_shape = m_shape->create_unique_clone();
+    set_shape(*m_shape->create_unique_clone());
+}
+
+void Object::put_direct(size_t index, Value value)
+{
+    set_storage_value_at(index, value);
+    did_mutate();
+}
+
+void Object::append_storage_value(Value value)
+{
+    if (m_storage_size < inline_storage_capacity)
+        m_inline_storage[m_storage_size] = value;
+    else
+        m_overflow_storage.append(value);
+    ++m_storage_size;
+}
+
+void Object::remove_storage_value_at(size_t index)
+{
+    VERIFY(index < m_storage_size);
+    if (index < inline_storage_capacity) {
+        auto used_inline_slots = min(m_storage_size, inline_storage_capacity);
+        for (size_t i = index; i + 1 < used_inline_slots; ++i)
+            m_inline_storage[i] = m_inline_storage[i + 1];
+        if (m_storage_size > inline_storage_capacity)
+            m_inline_storage[inline_storage_capacity - 1] = m_overflow_storage.take_first();
+    } else {
+        m_overflow_storage.remove(index - inline_storage_capacity);
+    }
+    --m_storage_size;
+    // Clear the vacated slot so it doesn't keep a cell alive.
+    if (m_storage_size < inline_storage_capacity)
+        m_inline_storage[m_storage_size] = {};
+}
+
+void Object::resize_storage(size_t new_size)
+{
+    if (new_size < m_storage_size) {
+        for (size_t i = new_size; i < min(m_storage_size, inline_storage_capacity); ++i)
+            m_inline_storage[i] = {};
+    }
+    if (new_size > inline_storage_capacity)
+        m_overflow_storage.resize(new_size - inline_storage_capacity);
+    else
+        m_overflow_storage.clear();
+    m_storage_size = new_size;
+}
+
+void Object::set_shape(Shape& shape)
+{
+    m_shape = &shape;
+    did_mutate();
 }
 
 // Simple side-effect free property lookup, following the prototype chain. Non-standard.
@@ -1173,7 +1230,9 @@ void Object::visit_edges(Cell::Visitor& visitor)
     Cell::visit_edges(visitor);
     visitor.visit(m_shape);
 
-    for (auto& value : m_storage)
+    for (size_t i = 0; i < min(m_storage_size, inline_storage_capacity); ++i)
+        visitor.visit(m_inline_storage[i]);
+    for (auto& value : m_overflow_storage)
         visitor.visit(value);
 
     m_indexed_properties.for_each_value([&visitor](auto& value) {
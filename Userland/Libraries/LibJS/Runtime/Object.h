@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Badge.h>
 #include <AK/HashMap.h>
 #include <AK/String.h>
@@ -135,6 +136,7 @@ public:
     virtual bool is_string_object() const { return false; }
     virtual bool is_global_object() const { return false; }
     virtual bool is_proxy_object() const { return false; }
+    virtual bool is_arguments_object() const { return false; }
     virtual bool is_native_function() const { return false; }
     virtual bool is_ordinary_function_object() const { return false; }
 
@@ -148,11 +150,25 @@ public:
     virtual void visit_edges(Cell::Visitor&) override;
     virtual Value value_of() const { return Value(const_cast<Object*>(this)); }
 
-    Value get_direct(size_t index) const { return m_storage[index]; }
+    Value get_direct(size_t index) const { return storage_value_at(index); }
+    void put_direct(size_t index, Value);
 
     const IndexedProperties& indexed_properties() const { return m_indexed_properties; }
-    IndexedProperties& indexed_properties() { return m_indexed_properties; }
-    void set_indexed_property_elements(Vector<Value>&& values) { m_indexed_properties = IndexedProperties(move(values)); }
+    IndexedProperties& indexed_properties()
+    {
+        // Handing out a mutable reference counts as a mutation as far as the
+        // generational GC's write barrier is concerned. Since the barrier is
+        // issued before the store here, callers must not allocate between
+        // obtaining the reference and mutating through it - a collection in
+        // between would clear the remembered set and lose this entry.
+        did_mutate();
+        return m_indexed_properties;
+    }
+    void set_indexed_property_elements(Vector<Value>&& values)
+    {
+        m_indexed_properties = IndexedProperties(move(values));
+        did_mutate();
+    }
 
     Shape& shape() { return *m_shape; }
     Shape const& shape() const { return *m_shape; }
@@ -183,15 +199,42 @@ protected:
     bool m_has_parameter_map { false };
 
 private:
-    void set_shape(Shape& shape) { m_shape = &shape; }
+    void set_shape(Shape&);
 
     Object* prototype() { return shape().prototype(); }
     Object const* prototype() const { return shape().prototype(); }
 
+    // Property storage is a hybrid: the first few slots live directly inside
+    // the Object cell, so typical small objects get by with a single load and
+    // no separate storage allocation. Only objects with more properties than
+    // that pay for the out-of-line vector. The capacity is a compile-time
+    // constant since heap cells come from fixed-size allocators and can't be
+    // sized per-shape.
+    static constexpr size_t inline_storage_capacity = 4;
+
+    Value storage_value_at(size_t index) const
+    {
+        if (index < inline_storage_capacity)
+            return m_inline_storage[index];
+        return m_overflow_storage[index - inline_storage_capacity];
+    }
+    void set_storage_value_at(size_t index, Value value)
+    {
+        if (index < inline_storage_capacity)
+            m_inline_storage[index] = value;
+        else
+            m_overflow_storage[index - inline_storage_capacity] = value;
+    }
+    void append_storage_value(Value);
+    void remove_storage_value_at(size_t index);
+    void resize_storage(size_t new_size);
+
     bool m_transitions_enabled { true };
     bool m_initialized { false };
     Shape* m_shape { nullptr };
-    Vector<Value> m_storage;
+    size_t m_storage_size { 0 };
+    AK::Array<Value, inline_storage_capacity> m_inline_storage;
+    Vector<Value> m_overflow_storage;
     IndexedProperties m_indexed_properties;
 };
 
@@ -100,8 +100,29 @@ void OrdinaryFunctionObject::visit_edges(Visitor& visitor)
     visitor.visit(m_environment);
 }
 
+bool OrdinaryFunctionObject::ensure_function_body_is_parsed()
+{
+    if (!is<LazyFunctionBody>(*m_body))
+        return true;
+    auto& lazy_body = static_cast<const LazyFunctionBody&>(*m_body);
+    auto body = lazy_body.parsed_body();
+    if (!body) {
+        vm().throw_exception<SyntaxError>(global_object(), lazy_body.error_message());
+        return false;
+    }
+    m_lazy_body = move(m_body);
+    m_body = body.release_nonnull();
+    return true;
+}
+
 FunctionEnvironment* OrdinaryFunctionObject::create_environment(FunctionObject& function_being_invoked)
 {
+    // This is the first thing that happens when calling the function, so a deferred
+    // body is parsed here - both the variables below and execute_function_body()
+    // need the real thing.
+    if (!ensure_function_body_is_parsed())
+        return nullptr;
+
     HashMap<FlyString, Variable> variables;
     for (auto& parameter : m_parameters) {
         parameter.binding.visit(
@@ -143,6 +164,9 @@ Value OrdinaryFunctionObject::execute_function_body()
 {
     auto& vm = this->vm();
 
+    if (!ensure_function_body_is_parsed())
+        return {};
+
     Interpreter* ast_interpreter = nullptr;
     auto* bytecode_interpreter = Bytecode::Interpreter::current();
 
@@ -47,10 +47,14 @@ private:
     virtual FunctionEnvironment* create_environment(FunctionObject&) override;
     virtual void visit_edges(Visitor&) override;
 
+    bool ensure_function_body_is_parsed();
     Value execute_function_body();
 
     FlyString m_name;
     NonnullRefPtr<Statement> m_body;
+    // If m_body started out as a LazyFunctionBody it's kept alive here after parsing,
+    // since source ranges in the parsed body reference its source text.
+    RefPtr<Statement> m_lazy_body;
     const Vector<FunctionNode::Parameter> m_parameters;
     Optional<Bytecode::Executable> m_bytecode_executable;
     Environment* m_environment { nullptr };
@@ -5,12 +5,20 @@
  */
 
 #include <AK/CharacterTypes.h>
+#include <AK/StringBuilder.h>
 #include <AK/Utf16View.h>
 #include <LibJS/Runtime/PrimitiveString.h>
 #include <LibJS/Runtime/VM.h>
 
 namespace JS {
 
+PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
+    : m_is_rope(true)
+    , m_lhs(&lhs)
+    , m_rhs(&rhs)
+{
+}
+
 PrimitiveString::PrimitiveString(String string)
     : m_utf8_string(move(string))
     , m_has_utf8_string(true)
@@ -27,8 +35,64 @@ PrimitiveString::~PrimitiveString()
 {
 }
 
+void PrimitiveString::visit_edges(Cell::Visitor& visitor)
+{
+    Cell::visit_edges(visitor);
+    if (m_is_rope) {
+        visitor.visit(m_lhs);
+        visitor.visit(m_rhs);
+    }
+}
+
+bool PrimitiveString::is_empty() const
+{
+    // NOTE: Ropes are never empty, since js_rope_string() never puts an empty
+    //       string into one.
+    if (m_is_rope)
+        return false;
+    if (m_has_utf16_string)
+        return m_utf16_string.is_empty();
+    return m_utf8_string.is_empty();
+}
+
+void PrimitiveString::resolve_rope_if_needed() const
+{
+    if (!m_is_rope)
+        return;
+
+    // This vector will hold all the pieces of the rope that need to be assembled
+    // into the resolved string, in order.
+    Vector<PrimitiveString const*> pieces;
+
+    // NOTE: We traverse the rope tree without using recursion, since we'd run out
+    //       of stack space quickly when handling a long sequence of concatenations.
+    Vector<PrimitiveString const*> stack;
+    stack.append(m_rhs);
+    stack.append(m_lhs);
+    while (!stack.is_empty()) {
+        auto const* current = stack.take_last();
+        if (current->m_is_rope) {
+            stack.append(current->m_rhs);
+            stack.append(current->m_lhs);
+            continue;
+        }
+        pieces.append(current);
+    }
+
+    StringBuilder builder;
+    for (auto const* current : pieces)
+        builder.append(current->string());
+
+    m_utf8_string = builder.to_string();
+    m_has_utf8_string = true;
+    m_is_rope = false;
+    m_lhs = nullptr;
+    m_rhs = nullptr;
+}
+
 String const& PrimitiveString::string() const
 {
+    resolve_rope_if_needed();
     if (!m_has_utf8_string) {
         m_utf8_string = m_utf16_string.to_utf8();
         m_has_utf8_string = true;
@@ -38,6 +102,7 @@ String const& PrimitiveString::string() const
 
 Utf16String const& PrimitiveString::utf16_string() const
 {
+    resolve_rope_if_needed();
     if (!m_has_utf16_string) {
         m_utf16_string = Utf16String(m_utf8_string);
         m_has_utf16_string = true;
@@ -50,6 +115,16 @@ Utf16View PrimitiveString::utf16_string_view() const
     return utf16_string().view();
 }
 
+PrimitiveString* js_rope_string(VM& vm, PrimitiveString& lhs, PrimitiveString& rhs)
+{
+    // Concatenating with an empty string is a no-op, so no rope is needed.
+    if (lhs.is_empty())
+        return &rhs;
+    if (rhs.is_empty())
+        return &lhs;
+    return vm.heap().allocate_without_global_object<PrimitiveString>(lhs, rhs);
+}
+
 PrimitiveString* js_string(Heap& heap, Utf16View const& view)
 {
     return js_string(heap, Utf16String(view));
@@ -14,6 +14,7 @@ namespace JS {
 
 class PrimitiveString final : public Cell {
 public:
+    PrimitiveString(PrimitiveString&, PrimitiveString&);
     explicit PrimitiveString(String);
     explicit PrimitiveString(Utf16String);
     virtual ~PrimitiveString();
@@ -21,6 +22,8 @@ public:
     PrimitiveString(PrimitiveString const&) = delete;
     PrimitiveString& operator=(PrimitiveString const&) = delete;
 
+    bool is_empty() const;
+
     String const& string() const;
     bool has_utf8_string() const { return m_has_utf8_string; }
 
@@ -30,6 +33,13 @@ public:
 
 private:
     virtual const char* class_name() const override { return "PrimitiveString"; }
+    virtual void visit_edges(Cell::Visitor&) override;
+
+    void resolve_rope_if_needed() const;
+
+    mutable bool m_is_rope { false };
+    mutable PrimitiveString* m_lhs { nullptr };
+    mutable PrimitiveString* m_rhs { nullptr };
 
     mutable String m_utf8_string;
     mutable bool m_has_utf8_string { false };
@@ -38,6 +48,10 @@ private:
     mutable bool m_has_utf16_string { false };
 };
 
+// Creates a lazily-concatenated rope string out of two strings; the actual
+// concatenation is deferred until someone inspects the result.
+PrimitiveString* js_rope_string(VM&, PrimitiveString&, PrimitiveString&);
+
 PrimitiveString* js_string(Heap&, Utf16View const&);
 PrimitiveString* js_string(VM&, Utf16View const&);
 
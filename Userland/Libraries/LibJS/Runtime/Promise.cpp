@@ -118,6 +118,7 @@ Value Promise::fulfill(Value value)
     VERIFY(!value.is_empty());
     m_state = State::Fulfilled;
     m_result = value;
+    did_mutate();
     trigger_reactions();
     m_fulfill_reactions.clear();
     m_reject_reactions.clear();
@@ -133,6 +134,7 @@ Value Promise::reject(Value reason)
     auto& vm = this->vm();
     m_state = State::Rejected;
     m_result = reason;
+    did_mutate();
     if (!m_is_handled)
         vm.promise_rejection_tracker(*this, RejectionOperation::Reject);
     trigger_reactions();
@@ -186,6 +188,7 @@ Value Promise::perform_then(Value on_fulfilled, Value on_rejected, Optional<Prom
         dbgln_if(PROMISE_DEBUG, "[Promise @ {} / perform_then()]: state is State::Pending, adding fulfill/reject reactions", this);
         m_fulfill_reactions.append(fulfill_reaction);
         m_reject_reactions.append(reject_reaction);
+        did_mutate();
         break;
     case Promise::State::Fulfilled: {
         auto value = m_result;
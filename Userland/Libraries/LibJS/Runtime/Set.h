@@ -23,7 +23,15 @@ public:
     virtual ~Set() override;
 
     OrderedHashTable<Value, ValueTraits> const& values() const { return m_values; };
-    OrderedHashTable<Value, ValueTraits>& values() { return m_values; };
+    OrderedHashTable<Value, ValueTraits>& values()
+    {
+        // Handing out a mutable reference counts as a mutation as far as the
+        // generational GC's write barrier is concerned. Since the barrier is
+        // issued before the store here, callers must not allocate between
+        // obtaining the reference and mutating through it.
+        did_mutate();
+        return m_values;
+    };
 
 private:
     virtual void visit_edges(Visitor& visitor) override;
@@ -180,8 +180,10 @@ void Shape::add_property_to_unique_shape(const StringOrSymbol& property_name, Pr
     VERIFY(is_unique());
     VERIFY(m_property_table);
     VERIFY(!m_property_table->contains(property_name));
+    // Property keys may be symbols, which are heap cells.
     m_property_table->set(property_name, { m_property_table->size(), attributes });
     ++m_property_count;
+    did_mutate();
 }
 
 void Shape::reconfigure_property_in_unique_shape(const StringOrSymbol& property_name, PropertyAttributes attributes)
@@ -211,8 +213,10 @@ void Shape::add_property_without_transition(StringOrSymbol const& property_name,
 {
     VERIFY(property_name.is_valid());
     ensure_property_table();
+    // Property keys may be symbols, which are heap cells.
     if (m_property_table->set(property_name, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry)
         ++m_property_count;
+    did_mutate();
 }
 
 FLATTEN void Shape::add_property_without_transition(PropertyName const& property_name, PropertyAttributes attributes)
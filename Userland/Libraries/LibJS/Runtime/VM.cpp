@@ -8,6 +8,7 @@
 #include <AK/Debug.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Interpreter.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
@@ -123,6 +124,9 @@ void VM::gather_roots(HashTable<Cell*>& roots)
 
     for (auto* finalization_registry : m_finalization_registry_cleanup_jobs)
         roots.set(finalization_registry);
+
+    if (auto* bytecode_interpreter = Bytecode::Interpreter::current())
+        bytecode_interpreter->gather_roots(roots);
 }
 
 Symbol* VM::get_global_symbol(const String& description)
@@ -607,6 +611,12 @@ void VM::prepare_for_ordinary_call(FunctionObject& function, ExecutionContext& c
     // FIXME: This should call NewFunctionEnvironment instead of the ad-hoc FunctionObject::create_environment()
     auto* local_environment = function.create_environment(function);
 
+    // create_environment() parses a deferred function body on first call, and a
+    // syntax error in it throws - bail out before pushing an execution context,
+    // which would VERIFY that no exception is pending.
+    if (exception())
+        return;
+
     // 9. Set the LexicalEnvironment of calleeContext to localEnv.
     callee_context.lexical_environment = local_environment;
 
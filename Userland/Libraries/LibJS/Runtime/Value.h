@@ -28,6 +28,10 @@ static constexpr u64 NEGATIVE_ZERO_BITS = ((u64)1 << 63);
 
 namespace JS {
 
+// Value is NaN-boxed into a single 64-bit word. Doubles are stored with their
+// natural bit pattern (NaNs are canonicalized first), and all other types live
+// in the unused NaN space: the top 16 bits hold a tag and the low 48 bits hold
+// the payload. Pointers fit in 48 bits on all of our targets.
 class Value {
 public:
     enum class Type {
@@ -50,18 +54,20 @@ public:
         Number,
     };
 
-    bool is_empty() const { return m_type == Type::Empty; }
-    bool is_undefined() const { return m_type == Type::Undefined; }
-    bool is_null() const { return m_type == Type::Null; }
-    bool is_number() const { return m_type == Type::Int32 || m_type == Type::Double; }
-    bool is_string() const { return m_type == Type::String; }
-    bool is_object() const { return m_type == Type::Object; }
-    bool is_boolean() const { return m_type == Type::Boolean; }
-    bool is_symbol() const { return m_type == Type::Symbol; }
-    bool is_accessor() const { return m_type == Type::Accessor; };
-    bool is_bigint() const { return m_type == Type::BigInt; };
+    bool is_empty() const { return tag() == EMPTY_TAG; }
+    bool is_undefined() const { return tag() == UNDEFINED_TAG; }
+    bool is_null() const { return tag() == NULL_TAG; }
+    bool is_number() const { return is_int32() || is_double(); }
+    bool is_string() const { return tag() == STRING_TAG; }
+    bool is_object() const { return tag() == OBJECT_TAG; }
+    bool is_boolean() const { return tag() == BOOLEAN_TAG; }
+    bool is_symbol() const { return tag() == SYMBOL_TAG; }
+    bool is_accessor() const { return tag() == ACCESSOR_TAG; };
+    bool is_bigint() const { return tag() == BIGINT_TAG; };
     bool is_nullish() const { return is_null() || is_undefined(); }
-    bool is_cell() const { return is_string() || is_accessor() || is_object() || is_bigint() || is_symbol(); }
+    // The cell tags are the largest ones, so everything at or above the first
+    // of them holds a heap pointer.
+    bool is_cell() const { return m_encoded >= (FIRST_CELL_TAG << TAG_SHIFT); }
     bool is_array(GlobalObject&) const;
     bool is_function() const;
     bool is_constructor() const;
@@ -83,159 +89,189 @@ public:
     }
 
     Value()
-        : m_type(Type::Empty)
+        : m_encoded(EMPTY_TAG << TAG_SHIFT)
     {
     }
 
     explicit Value(bool value)
-        : m_type(Type::Boolean)
+        : m_encoded(BOOLEAN_TAG << TAG_SHIFT | (value ? 1 : 0))
     {
-        m_value.as_bool = value;
     }
 
     explicit Value(double value)
     {
         bool is_negative_zero = bit_cast<u64>(value) == NEGATIVE_ZERO_BITS;
-        if (value >= NumericLimits<i32>::min() && value <= NumericLimits<i32>::max() && trunc(value) == value && !is_negative_zero) {
-            m_type = Type::Int32;
-            m_value.as_i32 = static_cast<i32>(value);
-        } else {
-            m_type = Type::Double;
-            m_value.as_double = value;
-        }
+        if (value >= NumericLimits<i32>::min() && value <= NumericLimits<i32>::max() && trunc(value) == value && !is_negative_zero)
+            m_encoded = encode_int32(static_cast<i32>(value));
+        else
+            m_encoded = encode_double(value);
     }
 
     explicit Value(unsigned long value)
     {
-        if (value > NumericLimits<i32>::max()) {
-            m_value.as_double = static_cast<double>(value);
-            m_type = Type::Double;
-        } else {
-            m_value.as_i32 = static_cast<i32>(value);
-            m_type = Type::Int32;
-        }
+        if (value > NumericLimits<i32>::max())
+            m_encoded = encode_double(static_cast<double>(value));
+        else
+            m_encoded = encode_int32(static_cast<i32>(value));
     }
 
     explicit Value(unsigned value)
     {
-        if (value > NumericLimits<i32>::max()) {
-            m_value.as_double = static_cast<double>(value);
-            m_type = Type::Double;
-        } else {
-            m_value.as_i32 = static_cast<i32>(value);
-            m_type = Type::Int32;
-        }
+        if (value > NumericLimits<i32>::max())
+            m_encoded = encode_double(static_cast<double>(value));
+        else
+            m_encoded = encode_int32(static_cast<i32>(value));
     }
 
     explicit Value(i32 value)
-        : m_type(Type::Int32)
+        : m_encoded(encode_int32(value))
     {
-        m_value.as_i32 = value;
     }
 
     Value(const Object* object)
-        : m_type(object ? Type::Object : Type::Null)
+        : m_encoded(object ? encode_pointer(OBJECT_TAG, object) : NULL_TAG << TAG_SHIFT)
     {
-        m_value.as_object = const_cast<Object*>(object);
     }
 
     Value(const PrimitiveString* string)
-        : m_type(Type::String)
+        : m_encoded(encode_pointer(STRING_TAG, string))
     {
-        m_value.as_string = const_cast<PrimitiveString*>(string);
     }
 
     Value(const Symbol* symbol)
-        : m_type(Type::Symbol)
+        : m_encoded(encode_pointer(SYMBOL_TAG, symbol))
     {
-        m_value.as_symbol = const_cast<Symbol*>(symbol);
     }
 
     Value(const Accessor* accessor)
-        : m_type(Type::Accessor)
+        : m_encoded(encode_pointer(ACCESSOR_TAG, accessor))
     {
-        m_value.as_accessor = const_cast<Accessor*>(accessor);
     }
 
     Value(const BigInt* bigint)
-        : m_type(Type::BigInt)
+        : m_encoded(encode_pointer(BIGINT_TAG, bigint))
     {
-        m_value.as_bigint = const_cast<BigInt*>(bigint);
     }
 
     explicit Value(Type type)
-        : m_type(type)
     {
+        switch (type) {
+        case Type::Empty:
+            m_encoded = EMPTY_TAG << TAG_SHIFT;
+            break;
+        case Type::Undefined:
+            m_encoded = UNDEFINED_TAG << TAG_SHIFT;
+            break;
+        case Type::Null:
+            m_encoded = NULL_TAG << TAG_SHIFT;
+            break;
+        default:
+            // Everything else carries a payload and needs the matching constructor.
+            VERIFY_NOT_REACHED();
+        }
     }
 
-    Type type() const { return m_type; }
+    Type type() const
+    {
+        switch (tag()) {
+        case EMPTY_TAG:
+            return Type::Empty;
+        case UNDEFINED_TAG:
+            return Type::Undefined;
+        case NULL_TAG:
+            return Type::Null;
+        case BOOLEAN_TAG:
+            return Type::Boolean;
+        case INT32_TAG:
+            return Type::Int32;
+        case STRING_TAG:
+            return Type::String;
+        case SYMBOL_TAG:
+            return Type::Symbol;
+        case ACCESSOR_TAG:
+            return Type::Accessor;
+        case BIGINT_TAG:
+            return Type::BigInt;
+        case OBJECT_TAG:
+            return Type::Object;
+        default:
+            VERIFY(is_double());
+            return Type::Double;
+        }
+    }
 
     double as_double() const
     {
         VERIFY(is_number());
-        if (m_type == Type::Int32)
-            return m_value.as_i32;
-        return m_value.as_double;
+        if (is_int32())
+            return extract_int32();
+        return bit_cast<double>(m_encoded);
     }
 
     bool as_bool() const
     {
-        VERIFY(type() == Type::Boolean);
-        return m_value.as_bool;
+        VERIFY(is_boolean());
+        return (m_encoded & 1) != 0;
     }
 
     Object& as_object()
     {
-        VERIFY(type() == Type::Object);
-        return *m_value.as_object;
+        VERIFY(is_object());
+        return *extract_pointer<Object>();
     }
 
     const Object& as_object() const
     {
-        VERIFY(type() == Type::Object);
-        return *m_value.as_object;
+        VERIFY(is_object());
+        return *extract_pointer<Object>();
     }
 
     PrimitiveString& as_string()
     {
         VERIFY(is_string());
-        return *m_value.as_string;
+        return *extract_pointer<PrimitiveString>();
     }
 
     const PrimitiveString& as_string() const
     {
         VERIFY(is_string());
-        return *m_value.as_string;
+        return *extract_pointer<PrimitiveString>();
     }
 
     Symbol& as_symbol()
     {
         VERIFY(is_symbol());
-        return *m_value.as_symbol;
+        return *extract_pointer<Symbol>();
     }
 
     const Symbol& as_symbol() const
     {
         VERIFY(is_symbol());
-        return *m_value.as_symbol;
+        return *extract_pointer<Symbol>();
     }
 
     Cell& as_cell()
     {
         VERIFY(is_cell());
-        return *m_value.as_cell;
+        return *extract_pointer<Cell>();
     }
 
     Accessor& as_accessor()
     {
         VERIFY(is_accessor());
-        return *m_value.as_accessor;
+        return *extract_pointer<Accessor>();
     }
 
     BigInt& as_bigint()
     {
         VERIFY(is_bigint());
-        return *m_value.as_bigint;
+        return *extract_pointer<BigInt>();
+    }
+
+    const BigInt& as_bigint() const
+    {
+        VERIFY(is_bigint());
+        return *extract_pointer<BigInt>();
     }
 
     Array& as_array();
@@ -244,7 +280,7 @@ public:
     i32 as_i32() const;
     u32 as_u32() const;
 
-    u64 encoded() const { return m_value.encoded; }
+    u64 encoded() const { return m_encoded; }
 
     String to_string(GlobalObject&, bool legacy_null_to_empty_string = false) const;
     Utf16String to_utf16_string(GlobalObject&) const;
@@ -260,8 +296,8 @@ public:
     StringOrSymbol to_property_key(GlobalObject&) const;
     i32 to_i32(GlobalObject& global_object) const
     {
-        if (m_type == Type::Int32)
-            return m_value.as_i32;
+        if (is_int32())
+            return extract_int32();
         return to_i32_slow_case(global_object);
     }
     u32 to_u32(GlobalObject&) const;
@@ -294,28 +330,83 @@ public:
     template<typename... Args>
     [[nodiscard]] ALWAYS_INLINE Value invoke(GlobalObject& global_object, PropertyName const& property_name, Args... args);
 
+    // If the given word, interpreted as an encoded Value, would hold a heap
+    // pointer, returns that pointer's bits; otherwise returns 0. Used by the
+    // conservative stack scanner, which would not recognize tagged pointers
+    // by comparing raw words against heap addresses.
+    static FlatPtr extract_pointer_bits(u64 encoded)
+    {
+        auto tag = encoded >> TAG_SHIFT;
+        if (tag < FIRST_CELL_TAG || tag > OBJECT_TAG)
+            return 0;
+        return static_cast<FlatPtr>(encoded & PAYLOAD_MASK);
+    }
+
 private:
-    Type m_type { Type::Empty };
+    static constexpr u64 TAG_SHIFT = 48;
+    static constexpr u64 PAYLOAD_MASK = ((u64)1 << TAG_SHIFT) - 1;
+
+    // All NaN doubles are canonicalized on the way in, so every top-16-bit
+    // pattern at or above EMPTY_TAG (and its sign-bit counterparts) is free
+    // for tagging. The cell tags are deliberately the largest values so that
+    // is_cell() is a single comparison.
+    static constexpr u64 CANONICAL_NAN_BITS = 0x7FF8000000000000ULL;
+    static constexpr u64 EMPTY_TAG = 0x7FF9;
+    static constexpr u64 UNDEFINED_TAG = 0x7FFA;
+    static constexpr u64 NULL_TAG = 0x7FFB;
+    static constexpr u64 BOOLEAN_TAG = 0x7FFC;
+    static constexpr u64 INT32_TAG = 0x7FFD;
+    static constexpr u64 STRING_TAG = 0xFFF9;
+    static constexpr u64 SYMBOL_TAG = 0xFFFA;
+    static constexpr u64 ACCESSOR_TAG = 0xFFFB;
+    static constexpr u64 BIGINT_TAG = 0xFFFC;
+    static constexpr u64 OBJECT_TAG = 0xFFFD;
+    static constexpr u64 FIRST_CELL_TAG = STRING_TAG;
+
+    u64 tag() const { return m_encoded >> TAG_SHIFT; }
+
+    bool is_int32() const { return tag() == INT32_TAG; }
+    bool is_double() const
+    {
+        // Ignoring the sign bit, every encoded double is numerically below
+        // the smallest tag.
+        return (m_encoded & ~((u64)1 << 63)) < (EMPTY_TAG << TAG_SHIFT);
+    }
+
+    static u64 encode_double(double value)
+    {
+        if (__builtin_isnan(value))
+            return CANONICAL_NAN_BITS;
+        return bit_cast<u64>(value);
+    }
+
+    static u64 encode_int32(i32 value)
+    {
+        return INT32_TAG << TAG_SHIFT | static_cast<u32>(value);
+    }
+
+    static u64 encode_pointer(u64 tag, void const* pointer)
+    {
+        return tag << TAG_SHIFT | reinterpret_cast<FlatPtr>(pointer);
+    }
+
+    i32 extract_int32() const { return static_cast<i32>(m_encoded & 0xFFFFFFFFULL); }
+
+    // Note: All boxed pointer types derive from Cell as their one and only
+    // base class, so the stored address can be reinterpreted freely between
+    // the concrete type and Cell.
+    template<typename T>
+    T* extract_pointer() const { return reinterpret_cast<T*>(m_encoded & PAYLOAD_MASK); }
 
     [[nodiscard]] Value invoke_internal(GlobalObject& global_object, PropertyName const&, Optional<MarkedValueList> arguments);
 
     i32 to_i32_slow_case(GlobalObject&) const;
 
-    union {
-        bool as_bool;
-        i32 as_i32;
-        double as_double;
-        PrimitiveString* as_string;
-        Symbol* as_symbol;
-        Object* as_object;
-        Cell* as_cell;
-        Accessor* as_accessor;
-        BigInt* as_bigint;
-
-        u64 encoded;
-    } m_value { .encoded = 0 };
+    u64 m_encoded { EMPTY_TAG << TAG_SHIFT };
 };
 
+static_assert(sizeof(Value) == sizeof(double));
+
 inline Value js_undefined()
 {
     return Value(Value::Type::Undefined);
@@ -0,0 +1,58 @@
+// Plain function bodies are not parsed until the function is first called.
+// These tests make sure the deferred bodies actually run correctly.
+
+test("calling a lazily parsed function", () => {
+    function foo() {
+        return 7;
+    }
+    expect(foo()).toBe(7);
+    expect(foo()).toBe(7);
+});
+
+test("body starting with a nested block", () => {
+    function foo() {
+        {
+        }
+        return 7;
+    }
+    expect(foo()).toBe(7);
+});
+
+test("parameters and arguments", () => {
+    function add(a, b) {
+        return a + b;
+    }
+    expect(add(3, 4)).toBe(7);
+});
+
+test("closures from one function expression share the parsed body", () => {
+    function makeAdder(amount) {
+        return function (value) {
+            return value + amount;
+        };
+    }
+    const addOne = makeAdder(1);
+    const addTwo = makeAdder(2);
+    expect(addOne(5)).toBe(6);
+    expect(addTwo(5)).toBe(7);
+});
+
+test("constructing a lazily parsed function", () => {
+    function Foo() {
+        this.value = 7;
+    }
+    expect(new Foo().value).toBe(7);
+});
+
+test("syntax error in a deferred body is thrown on first call", () => {
+    // Note: eval, so a parser that doesn't defer the body doesn't take down
+    // this whole file.
+    const foo = eval("(function () { return 1 2; })");
+    expect(() => {
+        foo();
+    }).toThrow(SyntaxError);
+    // ...and again on the second call.
+    expect(() => {
+        foo();
+    }).toThrow(SyntaxError);
+});
@@ -74,6 +74,10 @@ bool Parser::initialize()
 Value Parser::parse_object_with_index(u32 index)
 {
     VERIFY(m_xref_table->has_object(index));
+
+    if (m_xref_table->is_object_compressed(index))
+        return parse_compressed_object_with_index(index);
+
     auto byte_offset = m_xref_table->byte_offset_for_object(index);
     m_reader.move_to(byte_offset);
     auto indirect_value = parse_indirect_value();
@@ -220,7 +224,8 @@ bool Parser::initialize_linearized_xref_table()
     if (!main_xref_table)
         return false;
 
-    return m_xref_table->merge(move(*main_xref_table));
+    m_xref_table->merge(move(*main_xref_table));
+    return true;
 }
 
 bool Parser::initialize_hint_tables()
@@ -310,6 +315,12 @@ bool Parser::initialize_non_linearized_xref_table()
     auto xref_offset = xref_offset_value.as_int();
 
     m_reader.move_to(xref_offset);
+
+    // As of PDF 1.5, the xref table may be a cross-reference stream instead
+    // of the classical ASCII table
+    if (!m_reader.matches("xref"))
+        return initialize_xref_stream_chain();
+
     m_xref_table = parse_xref_table();
     if (!m_xref_table)
         return false;
@@ -317,6 +328,239 @@ bool Parser::initialize_non_linearized_xref_table()
     return m_trailer;
 }
 
+bool Parser::initialize_xref_stream_chain()
+{
+    // The reader is positioned at the most recent cross-reference stream.
+    // Incremental updates chain older streams through /Prev; for objects
+    // that occur in more than one stream, the most recent entry wins.
+    while (true) {
+        RefPtr<DictObject> dict;
+        auto table = parse_xref_stream(dict);
+        if (!table || !dict)
+            return false;
+
+        if (!m_xref_table) {
+            m_xref_table = table;
+            // The stream dictionary doubles as the file trailer
+            m_trailer = dict;
+        } else {
+            m_xref_table->merge(move(*table));
+        }
+
+        if (!dict->contains(CommonNames::Prev))
+            return true;
+
+        auto prev_offset = dict->get_value(CommonNames::Prev).to_int();
+        m_reader.move_to(prev_offset);
+        m_reader.set_reading_forwards();
+    }
+}
+
+RefPtr<XRefTable> Parser::parse_xref_stream(RefPtr<DictObject>& out_dict)
+{
+    auto xref_stream = parse_indirect_value();
+    if (!xref_stream)
+        return {};
+
+    auto value = xref_stream->value();
+    if (!value.is_object() || !value.as_object()->is_stream())
+        return {};
+
+    auto stream = object_cast<StreamObject>(value.as_object());
+    auto dict = stream->dict();
+
+    if (!dict->contains(CommonNames::Type))
+        return {};
+    auto type = dict->get_name(m_document, CommonNames::Type)->name();
+    if (type != CommonNames::XRef)
+        return {};
+
+    if (!dict->contains(CommonNames::Size) || !dict->contains(CommonNames::W))
+        return {};
+    auto object_count = dict->get_value(CommonNames::Size).as_int();
+
+    auto field_widths = dict->get_array(m_document, CommonNames::W);
+    if (field_widths->size() != 3)
+        return {};
+    auto type_field_width = field_widths->at(0).as_int();
+    auto second_field_width = field_widths->at(1).as_int();
+    auto third_field_width = field_widths->at(2).as_int();
+
+    struct Subsection {
+        int first_object_index;
+        int object_count;
+    };
+
+    Vector<Subsection> subsections;
+    if (dict->contains(CommonNames::Index)) {
+        auto index_array = dict->get_array(m_document, CommonNames::Index);
+        if (index_array->size() % 2 != 0)
+            return {};
+        for (size_t i = 0; i < index_array->size(); i += 2)
+            subsections.append({ index_array->at(i).as_int(), index_array->at(i + 1).as_int() });
+    } else {
+        subsections.append({ 0, object_count });
+    }
+
+    auto data = stream->bytes();
+
+    // The stream data is commonly compressed with a PNG predictor on top of
+    // the regular filter, which has to be undone before reading entries.
+    // Xref stream fields are single-component 8-bit values, so each
+    // predictor row is /Columns bytes plus a leading filter type byte.
+    ByteBuffer unfiltered_buffer;
+    if (dict->contains(CommonNames::DecodeParms)) {
+        auto decode_parms = dict->get_dict(m_document, CommonNames::DecodeParms);
+        if (decode_parms->contains(CommonNames::Predictor)) {
+            auto predictor = decode_parms->get_value(CommonNames::Predictor).as_int();
+            if (predictor >= 10) {
+                int columns = 1;
+                if (decode_parms->contains(CommonNames::Columns))
+                    columns = decode_parms->get_value(CommonNames::Columns).as_int();
+                auto row_length = static_cast<size_t>(columns) + 1;
+                if (columns <= 0 || data.size() % row_length != 0)
+                    return {};
+
+                auto row_count = data.size() / row_length;
+                auto maybe_buffer = ByteBuffer::create_zeroed(row_count * columns);
+                if (!maybe_buffer.has_value())
+                    return {};
+                unfiltered_buffer = maybe_buffer.release_value();
+
+                for (size_t row = 0; row < row_count; row++) {
+                    auto filter_type = data[row * row_length];
+                    auto const* source = data.data() + row * row_length + 1;
+                    auto* destination = unfiltered_buffer.data() + row * columns;
+                    auto const* previous_row = row == 0 ? nullptr : destination - columns;
+
+                    for (int i = 0; i < columns; i++) {
+                        u8 left = i == 0 ? 0 : destination[i - 1];
+                        u8 above = previous_row ? previous_row[i] : 0;
+
+                        switch (filter_type) {
+                        case 0: // None
+                            destination[i] = source[i];
+                            break;
+                        case 1: // Sub
+                            destination[i] = source[i] + left;
+                            break;
+                        case 2: // Up
+                            destination[i] = source[i] + above;
+                            break;
+                        case 3: // Average
+                            destination[i] = source[i] + (left + above) / 2;
+                            break;
+                        case 4: { // Paeth
+                            u8 upper_left = (i == 0 || !previous_row) ? 0 : previous_row[i - 1];
+                            int p = left + above - upper_left;
+                            int pa = abs(p - left);
+                            int pb = abs(p - above);
+                            int pc = abs(p - upper_left);
+                            if (pa <= pb && pa <= pc)
+                                destination[i] = source[i] + left;
+                            else if (pb <= pc)
+                                destination[i] = source[i] + above;
+                            else
+                                destination[i] = source[i] + upper_left;
+                            break;
+                        }
+                        default:
+                            return {};
+                        }
+                    }
+                }
+
+                data = unfiltered_buffer.bytes();
+            } else if (predictor != 1) {
+                // FIXME: Support the TIFF predictor (2)
+                return {};
+            }
+        }
+    }
+
+    size_t data_offset = 0;
+    auto entry_size = static_cast<size_t>(type_field_width + second_field_width + third_field_width);
+
+    auto read_field = [&](int width) -> u64 {
+        u64 field_value = 0;
+        for (int i = 0; i < width; i++)
+            field_value = (field_value << 8) | data[data_offset++];
+        return field_value;
+    };
+
+    auto table = adopt_ref(*new XRefTable());
+
+    for (auto& subsection : subsections) {
+        if (data_offset + subsection.object_count * entry_size > data.size())
+            return {};
+
+        Vector<XRefEntry> entries;
+
+        for (int i = 0; i < subsection.object_count; i++) {
+            // A zero-width type field defaults to type 1 (an in-use object)
+            u64 entry_type = type_field_width > 0 ? read_field(type_field_width) : 1;
+            auto second_field = read_field(second_field_width);
+            auto third_field = read_field(third_field_width);
+
+            switch (entry_type) {
+            case 0: // Free object
+                entries.append(XRefEntry {});
+                break;
+            case 1: // In-use object at a byte offset
+                entries.append({ static_cast<long>(second_field), static_cast<u16>(third_field), true });
+                break;
+            case 2: // In-use object inside an object stream
+                entries.append({ static_cast<long>(second_field), static_cast<u16>(third_field), true, true });
+                break;
+            default:
+                return {};
+            }
+        }
+
+        table->add_section({ subsection.first_object_index, subsection.object_count, entries });
+    }
+
+    out_dict = dict;
+    return table;
+}
+
+Value Parser::parse_compressed_object_with_index(u32 index)
+{
+    auto object_stream_index = m_xref_table->object_stream_for_object(index);
+
+    // Loading through the document caches the (decompressed) object stream,
+    // so other objects in the same stream don't have to decode it again
+    auto stream_value = m_document->get_or_load_value(object_stream_index);
+    VERIFY(stream_value.is_object());
+    auto stream_object = stream_value.as_object();
+    VERIFY(stream_object->is_stream());
+    auto stream = object_cast<StreamObject>(stream_object);
+    auto dict = stream->dict();
+
+    auto type = dict->get_name(m_document, CommonNames::Type)->name();
+    VERIFY(type == CommonNames::ObjStm);
+
+    auto object_count = dict->get_value(CommonNames::N).as_int();
+    auto first_object_offset = dict->get_value(CommonNames::First).as_int();
+
+    auto stream_parser = adopt_ref(*new Parser(stream->bytes()));
+    stream_parser->m_document = m_document;
+
+    // The stream begins with pairs of object number and byte offset
+    // (relative to /First), one pair for every object it contains
+    long object_offset = -1;
+    for (int i = 0; i < object_count; i++) {
+        auto object_number = stream_parser->parse_number();
+        auto object_byte_offset = stream_parser->parse_number();
+        if (object_number.as_int() == static_cast<int>(index))
+            object_offset = object_byte_offset.as_int();
+    }
+    VERIFY(object_offset >= 0);
+
+    stream_parser->m_reader.move_to(first_object_offset + object_offset);
+    return stream_parser->parse_value();
+}
+
 RefPtr<XRefTable> Parser::parse_xref_table()
 {
     if (!m_reader.matches("xref"))
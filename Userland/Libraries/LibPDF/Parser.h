@@ -96,6 +96,16 @@ private:
     Optional<PageOffsetHintTable> parse_page_offset_hint_table(ReadonlyBytes const& hint_stream_bytes);
     Optional<Vector<PageOffsetHintTableEntry>> parse_all_page_offset_hint_table_entries(PageOffsetHintTable const&, ReadonlyBytes const& hint_stream_bytes);
     RefPtr<XRefTable> parse_xref_table();
+
+    // PDF 1.5+: the xref table may be stored in a cross-reference stream,
+    // possibly chained to older ones through /Prev for incremental updates
+    bool initialize_xref_stream_chain();
+    RefPtr<XRefTable> parse_xref_stream(RefPtr<DictObject>& out_dict);
+
+    // Parses an object that lives inside an object stream (a type 2
+    // xref entry)
+    Value parse_compressed_object_with_index(u32 index);
+
     RefPtr<DictObject> parse_file_trailer();
 
     bool navigate_to_before_eof_marker();
@@ -16,6 +16,11 @@ struct XRefEntry {
     long byte_offset { invalid_byte_offset };
     u16 generation_number { 0 };
     bool in_use { false };
+    // Entries from a cross-reference stream may point into an object stream
+    // instead of the file itself. For those, byte_offset holds the object
+    // number of the object stream, and generation_number holds the index
+    // of the object within that stream.
+    bool compressed { false };
 };
 
 struct XRefSection {
@@ -26,7 +31,7 @@ struct XRefSection {
 
 class XRefTable final : public RefCounted<XRefTable> {
 public:
-    bool merge(XRefTable&& other)
+    void merge(XRefTable&& other)
     {
         auto this_size = m_entries.size();
         auto other_size = other.m_entries.size();
@@ -43,13 +48,12 @@ public:
 
             if (this_entry.byte_offset == invalid_byte_offset) {
                 m_entries[i] = other_entry;
-            } else if (other_entry.byte_offset != invalid_byte_offset) {
-                // Both xref tables have an entry for the same object index
-                return false;
             }
-        }
 
-        return true;
+            // Otherwise, both tables have an entry for this object index. This
+            // happens when an incremental update overrides an object; our own
+            // entries come from the most recent table and take precedence.
+        }
     }
 
     void add_section(XRefSection const& section)
@@ -86,6 +90,24 @@ public:
         return m_entries[index].in_use;
     }
 
+    [[nodiscard]] ALWAYS_INLINE bool is_object_compressed(size_t index) const
+    {
+        VERIFY(has_object(index));
+        return m_entries[index].compressed;
+    }
+
+    [[nodiscard]] ALWAYS_INLINE u32 object_stream_for_object(size_t index) const
+    {
+        VERIFY(is_object_compressed(index));
+        return m_entries[index].byte_offset;
+    }
+
+    [[nodiscard]] ALWAYS_INLINE u32 object_stream_index_for_object(size_t index) const
+    {
+        VERIFY(is_object_compressed(index));
+        return m_entries[index].generation_number;
+    }
+
 private:
     friend struct AK::Formatter<PDF::XRefTable>;
 
@@ -24,34 +24,53 @@ void Request::stream_into(OutputStream& stream)
 {
     VERIFY(!m_internal_stream_data);
 
-    auto notifier = Core::Notifier::construct(fd(), Core::Notifier::Read);
-
-    m_internal_stream_data = make<InternalStreamData>(fd());
-    m_internal_stream_data->read_notifier = notifier;
+    m_internal_stream_data = make<InternalStreamData>();
+    m_internal_stream_data->stream = &stream;
 
     auto user_on_finish = move(on_finish);
-    on_finish = [this](auto success, auto total_size) {
-        m_internal_stream_data->success = success;
-        m_internal_stream_data->total_size = total_size;
+    on_finish = [this, user_on_finish = move(user_on_finish)](auto success, auto total_size) {
         m_internal_stream_data->request_done = true;
+        // Pick up whatever the server wrote after the last notification.
+        drain_payload();
+        user_on_finish(success, total_size);
     };
 
-    notifier->on_ready_to_read = [this, &stream, user_on_finish = move(user_on_finish)] {
-        constexpr size_t buffer_size = 4096;
-        static char buf[buffer_size];
-        auto nread = m_internal_stream_data->read_stream.read({ buf, buffer_size });
-        if (!stream.write_or_error({ buf, nread })) {
+    // Payload may already have piled up in the ring before we were told
+    // where to stream it.
+    if (drain_payload() > 0)
+        m_client->notify_request_payload_consumed({}, *this);
+}
+
+size_t Request::drain_payload()
+{
+    VERIFY(m_internal_stream_data);
+    auto& stream = *m_internal_stream_data->stream;
+    size_t total_consumed = 0;
+    for (;;) {
+        auto bytes = m_payload_ring->peek();
+        if (bytes.is_empty())
+            break;
+        if (!stream.write_or_error(bytes)) {
             // FIXME: What do we do here?
             TODO();
         }
+        m_payload_ring->consume(bytes.size());
+        total_consumed += bytes.size();
+    }
+    return total_consumed;
+}
 
-        if (m_internal_stream_data->read_stream.eof() && m_internal_stream_data->request_done) {
-            m_internal_stream_data->read_notifier->close();
-            user_on_finish(m_internal_stream_data->success, m_internal_stream_data->total_size);
-        } else {
-            m_internal_stream_data->read_stream.handle_any_error();
-        }
-    };
+void Request::did_receive_payload(Badge<RequestClient>)
+{
+    // Nobody has told us where to put the payload yet; leave it in the ring.
+    if (!m_internal_stream_data)
+        return;
+
+    auto consumed = drain_payload();
+    // Freed-up ring space is the server's cue to flush anything it was
+    // holding back; no point sending it once the request is over.
+    if (consumed > 0 && !m_internal_stream_data->request_done)
+        m_client->notify_request_payload_consumed({}, *this);
 }
 
 void Request::set_should_buffer_all_input(bool value)
@@ -68,7 +87,7 @@ void Request::set_should_buffer_all_input(bool value)
     VERIFY(!m_internal_stream_data);
     VERIFY(!m_internal_buffered_data);
     VERIFY(on_buffered_request_finish); // Not having this set makes no sense.
-    m_internal_buffered_data = make<InternalBufferedData>(fd());
+    m_internal_buffered_data = make<InternalBufferedData>();
     m_should_buffer_all_input = true;
 
     on_headers_received = [this](auto& headers, auto response_code) {
@@ -8,14 +8,14 @@
 
 #include <AK/Badge.h>
 #include <AK/ByteBuffer.h>
-#include <AK/FileStream.h>
 #include <AK/Function.h>
+#include <AK/HashMap.h>
 #include <AK/MemoryStream.h>
 #include <AK/RefCounted.h>
 #include <AK/String.h>
 #include <AK/WeakPtr.h>
-#include <LibCore/Notifier.h>
 #include <LibIPC/Forward.h>
+#include <LibProtocol/RequestPayloadRing.h>
 
 namespace Protocol {
 
@@ -34,7 +34,6 @@ public:
     }
 
     int id() const { return m_request_id; }
-    int fd() const { return m_fd; }
     bool stop();
 
     void stream_into(OutputStream&);
@@ -53,41 +52,31 @@ public:
     void did_finish(Badge<RequestClient>, bool success, u32 total_size);
     void did_progress(Badge<RequestClient>, Optional<u32> total_size, u32 downloaded_size);
     void did_receive_headers(Badge<RequestClient>, const HashMap<String, String, CaseInsensitiveStringTraits>& response_headers, Optional<u32> response_code);
+    void did_receive_payload(Badge<RequestClient>);
     void did_request_certificates(Badge<RequestClient>);
 
-    RefPtr<Core::Notifier>& write_notifier(Badge<RequestClient>) { return m_write_notifier; }
-    void set_request_fd(Badge<RequestClient>, int fd) { m_fd = fd; }
+    void set_payload_ring(Badge<RequestClient>, NonnullOwnPtr<RequestPayloadRing> ring) { m_payload_ring = move(ring); }
 
 private:
     explicit Request(RequestClient&, i32 request_id);
+
+    // Reads everything currently in the ring, in place, into the stream the
+    // user gave us; returns how much was consumed.
+    size_t drain_payload();
+
     WeakPtr<RequestClient> m_client;
     int m_request_id { -1 };
-    RefPtr<Core::Notifier> m_write_notifier;
-    int m_fd { -1 };
+    OwnPtr<RequestPayloadRing> m_payload_ring;
     bool m_should_buffer_all_input { false };
 
     struct InternalBufferedData {
-        InternalBufferedData(int fd)
-            : read_stream(fd)
-        {
-        }
-
-        InputFileStream read_stream;
         DuplexMemoryStream payload_stream;
         HashMap<String, String, CaseInsensitiveStringTraits> response_headers;
         Optional<u32> response_code;
     };
 
     struct InternalStreamData {
-        InternalStreamData(int fd)
-            : read_stream(fd)
-        {
-        }
-
-        InputFileStream read_stream;
-        RefPtr<Core::Notifier> read_notifier;
-        bool success;
-        u32 total_size { 0 };
+        OutputStream* stream { nullptr };
         bool request_done { false };
     };
 
@@ -28,14 +28,15 @@ RefPtr<Request> RequestClient::start_request(String const& method, URL const& ur
 
     auto response = IPCProxy::start_request(method, url, header_dictionary, body_result.release_value());
     auto request_id = response.request_id();
-    if (request_id < 0 || !response.response_fd().has_value())
+    if (request_id < 0 || !response.response_buffer().has_value())
+        return nullptr;
+    auto payload_ring = RequestPayloadRing::attach(response.response_buffer().value());
+    if (!payload_ring)
         return nullptr;
-    auto response_fd = response.response_fd().value().take_fd();
     auto request = Request::create_from_id({}, *this, request_id);
-    request->set_request_fd({}, response_fd);
+    request->set_payload_ring({}, payload_ring.release_nonnull());
     m_requests.set(request_id, request);
     return request;
-    return nullptr;
 }
 
 bool RequestClient::stop_request(Badge<Request>, Request& request)
@@ -52,6 +53,11 @@ bool RequestClient::set_certificate(Badge<Request>, Request& request, String cer
     return IPCProxy::set_certificate(request.id(), move(certificate), move(key));
 }
 
+void RequestClient::notify_request_payload_consumed(Badge<Request>, Request& request)
+{
+    IPCProxy::async_notify_request_payload_consumed(request.id());
+}
+
 void RequestClient::request_finished(i32 request_id, bool success, u32 total_size)
 {
     RefPtr<Request> request;
@@ -68,6 +74,13 @@ void RequestClient::request_progress(i32 request_id, Optional<u32> const& total_
     }
 }
 
+void RequestClient::request_payload_available(i32 request_id)
+{
+    if (auto request = const_cast<Request*>(m_requests.get(request_id).value_or(nullptr))) {
+        request->did_receive_payload({});
+    }
+}
+
 void RequestClient::headers_became_available(i32 request_id, IPC::Dictionary const& response_headers, Optional<u32> const& status_code)
 {
     if (auto request = const_cast<Request*>(m_requests.get(request_id).value_or(nullptr))) {
@@ -26,11 +26,13 @@ public:
 
     bool stop_request(Badge<Request>, Request&);
     bool set_certificate(Badge<Request>, Request&, String, String);
+    void notify_request_payload_consumed(Badge<Request>, Request&);
 
 private:
     RequestClient();
 
     virtual void request_progress(i32, Optional<u32> const&, u32) override;
+    virtual void request_payload_available(i32) override;
     virtual void request_finished(i32, bool, u32) override;
     virtual void certificate_requested(i32) override;
     virtual void headers_became_available(i32, IPC::Dictionary const&, Optional<u32> const&) override;
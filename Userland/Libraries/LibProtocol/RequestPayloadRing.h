@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/OwnPtr.h>
+#include <AK/Span.h>
+#include <AK/Types.h>
+#include <LibCore/AnonymousBuffer.h>
+
+namespace Protocol {
+
+// A single-producer single-consumer byte ring over anonymous shared memory,
+// used to carry response payloads from RequestServer to its clients without
+// copying them through the kernel. RequestServer writes each downloaded byte
+// into the ring exactly once; the client reads it in place via peek()/consume().
+//
+// The offsets are free-running u32s; u32 wraparound is harmless as long as the
+// capacity stays well below 4 GiB. Flow control is the consumer's read offset:
+// write() never stores more than the consumer has left room for, and the
+// producer is expected to hold on to (or retry) whatever didn't fit.
+class RequestPayloadRing {
+    AK_MAKE_NONCOPYABLE(RequestPayloadRing);
+    AK_MAKE_NONMOVABLE(RequestPayloadRing);
+
+public:
+    static constexpr size_t default_capacity = 256 * KiB;
+
+    static OwnPtr<RequestPayloadRing> create(size_t capacity = default_capacity)
+    {
+        VERIFY(capacity > 0 && capacity < NumericLimits<u32>::max() / 2);
+        auto buffer = Core::AnonymousBuffer::create_with_size(sizeof(Header) + capacity);
+        if (!buffer.is_valid())
+            return {};
+        // Anonymous memory starts out zero-filled, so both offsets are already 0.
+        return adopt_own(*new RequestPayloadRing(move(buffer)));
+    }
+
+    static OwnPtr<RequestPayloadRing> attach(Core::AnonymousBuffer buffer)
+    {
+        if (!buffer.is_valid() || buffer.size() <= sizeof(Header))
+            return {};
+        return adopt_own(*new RequestPayloadRing(move(buffer)));
+    }
+
+    const Core::AnonymousBuffer& buffer() const { return m_buffer; }
+    size_t capacity() const { return m_buffer.size() - sizeof(Header); }
+
+    size_t bytes_available() const
+    {
+        return header().write_offset.load(AK::memory_order_acquire) - header().read_offset.load(AK::memory_order_relaxed);
+    }
+
+    size_t space_for_writing() const
+    {
+        return capacity() - (header().write_offset.load(AK::memory_order_relaxed) - header().read_offset.load(AK::memory_order_acquire));
+    }
+
+    // Producer side: copies in as much as the consumer has left room for and
+    // returns how much that was.
+    size_t write(ReadonlyBytes bytes)
+    {
+        auto nwritten = min(bytes.size(), space_for_writing());
+        if (nwritten == 0)
+            return 0;
+        auto write_offset = header().write_offset.load(AK::memory_order_relaxed);
+        auto index = write_offset % capacity();
+        auto until_wrap = min(nwritten, capacity() - index);
+        __builtin_memcpy(data() + index, bytes.data(), until_wrap);
+        if (until_wrap < nwritten)
+            __builtin_memcpy(data(), bytes.data() + until_wrap, nwritten - until_wrap);
+        header().write_offset.store(write_offset + nwritten, AK::memory_order_release);
+        return nwritten;
+    }
+
+    // Consumer side: a contiguous view of readable bytes (up to the wrap
+    // point; call again after consume() for the rest). The view stays valid
+    // until consume() is called.
+    ReadonlyBytes peek() const
+    {
+        auto available = bytes_available();
+        auto index = header().read_offset.load(AK::memory_order_relaxed) % capacity();
+        return { data() + index, min(available, capacity() - index) };
+    }
+
+    void consume(size_t count)
+    {
+        auto read_offset = header().read_offset.load(AK::memory_order_relaxed);
+        VERIFY(count <= bytes_available());
+        header().read_offset.store(read_offset + count, AK::memory_order_release);
+    }
+
+private:
+    explicit RequestPayloadRing(Core::AnonymousBuffer&& buffer)
+        : m_buffer(move(buffer))
+    {
+    }
+
+    struct Header {
+        Atomic<u32> write_offset;
+        Atomic<u32> read_offset;
+    };
+
+    // Not data<Header>(): Atomic<u32> members make Header non-trivial.
+    Header& header() { return *reinterpret_cast<Header*>(m_buffer.data<u8>()); }
+    const Header& header() const { return *reinterpret_cast<const Header*>(m_buffer.data<u8>()); }
+    u8* data() { return m_buffer.data<u8>() + sizeof(Header); }
+    const u8* data() const { return m_buffer.data<u8>() + sizeof(Header); }
+
+    Core::AnonymousBuffer m_buffer;
+};
+
+}
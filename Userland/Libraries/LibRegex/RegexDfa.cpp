@@ -0,0 +1,529 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "RegexDfa.h"
+#include <AK/CharacterTypes.h>
+#include <AK/StringBuilder.h>
+
+namespace regex {
+
+size_t DfaMatcher::opcode_size_at(ByteCode const& bytecode, size_t ip)
+{
+    switch ((OpCodeId)bytecode.at(ip)) {
+    case OpCodeId::Compare:
+        return bytecode.at(ip + 2) + 3;
+    case OpCodeId::Exit:
+    case OpCodeId::Save:
+    case OpCodeId::Restore:
+    case OpCodeId::CheckBegin:
+    case OpCodeId::CheckEnd:
+    case OpCodeId::Checkpoint:
+        return 1;
+    case OpCodeId::Jump:
+    case OpCodeId::ForkJump:
+    case OpCodeId::ForkStay:
+    case OpCodeId::FailForks:
+    case OpCodeId::GoBack:
+    case OpCodeId::CheckBoundary:
+    case OpCodeId::ClearCaptureGroup:
+    case OpCodeId::SaveLeftCaptureGroup:
+    case OpCodeId::SaveRightCaptureGroup:
+    case OpCodeId::ResetRepeat:
+        return 2;
+    case OpCodeId::Repeat:
+    case OpCodeId::JumpNonEmpty:
+    case OpCodeId::SaveRightNamedCaptureGroup:
+        return 4;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+bool DfaMatcher::is_lone_string_compare(ByteCode const& bytecode, size_t ip)
+{
+    return bytecode.at(ip + 1) == 1 && (CharacterCompareType)bytecode.at(ip + 3) == CharacterCompareType::String;
+}
+
+bool DfaMatcher::suits(ByteCode const& bytecode)
+{
+    for (size_t ip = 0; ip < bytecode.size(); ip += opcode_size_at(bytecode, ip)) {
+        switch ((OpCodeId)bytecode.at(ip)) {
+        case OpCodeId::JumpNonEmpty: {
+            // The emitters all place the guarding Checkpoint inside the loop;
+            // anything else we wouldn't know how to simulate.
+            auto checkpoint = ip + 4 + (ssize_t)bytecode.at(ip + 2);
+            if (checkpoint >= ip || (OpCodeId)bytecode.at(checkpoint) != OpCodeId::Checkpoint)
+                return false;
+            auto form = (OpCodeId)bytecode.at(ip + 3);
+            if (form != OpCodeId::Jump && form != OpCodeId::ForkJump && form != OpCodeId::ForkStay)
+                return false;
+            continue;
+        }
+        case OpCodeId::Jump:
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::Checkpoint:
+        case OpCodeId::Exit:
+            continue;
+        case OpCodeId::Compare: {
+            auto arguments_count = bytecode.at(ip + 1);
+            if (is_lone_string_compare(bytecode, ip))
+                continue;
+            size_t offset = ip + 3;
+            for (size_t i = 0; i < arguments_count; ++i) {
+                switch ((CharacterCompareType)bytecode.at(offset++)) {
+                case CharacterCompareType::Inverse:
+                case CharacterCompareType::TemporaryInverse:
+                case CharacterCompareType::AnyChar:
+                    break;
+                case CharacterCompareType::Char:
+                case CharacterCompareType::CharClass:
+                case CharacterCompareType::CharRange:
+                    ++offset;
+                    break;
+                default:
+                    // References need captures, Strings with siblings don't
+                    // occur, and the unicode property classes would have to
+                    // replicate LibUnicode here; leave those to the VM.
+                    return false;
+                }
+            }
+            continue;
+        }
+        default:
+            // Everything else either tracks captures, moves the string
+            // position around (lookarounds), or counts repetitions - state
+            // a DFA cannot carry.
+            return false;
+        }
+    }
+    return true;
+}
+
+void DfaMatcher::close_over(ClosureResult& result, HashTable<String>& seen, Vector<u32>& checkpoints, ThreadIp thread, u32 source, bool at_begin, bool at_end) const
+{
+    // Finding an accepting path prunes all threads of lower priority; the
+    // backtracker would never get around to trying them.
+    if (result.accepts)
+        return;
+
+    // The visited set is keyed on the executed checkpoints as well, since a
+    // later JumpNonEmpty decides differently depending on them; the same
+    // instruction reached with and without an empty loop body behind it are
+    // different states to the backtracker.
+    StringBuilder key_builder;
+    key_builder.appendff("{}:{}", thread.ip, thread.sub);
+    for (auto checkpoint : checkpoints)
+        key_builder.appendff(":{}", checkpoint);
+    auto key = key_builder.build();
+    if (seen.contains(key))
+        return;
+    seen.set(move(key));
+
+    auto append_thread = [&]() {
+        if (result.appended.contains(((u64)thread.ip << 32) | thread.sub))
+            return;
+        result.appended.set(((u64)thread.ip << 32) | thread.sub);
+        result.threads.append(thread);
+        result.sources.append(source);
+    };
+
+    if (thread.ip >= m_bytecode.size()) {
+        result.accepts = true;
+        result.accept_source = source;
+        return;
+    }
+
+    // Mid-string threads stay put on their Compare until the string runs out.
+    if (thread.sub > 0) {
+        append_thread();
+        return;
+    }
+
+    auto ip = thread.ip;
+    switch ((OpCodeId)m_bytecode.at(ip)) {
+    case OpCodeId::Compare:
+        if (is_lone_string_compare(m_bytecode, ip) && m_bytecode.at(ip + 4) == 0) {
+            // An empty string comparison doesn't consume anything.
+            close_over(result, seen, checkpoints, { (u32)(ip + (u32)opcode_size_at(m_bytecode, ip)), 0 }, source, at_begin, at_end);
+            return;
+        }
+        append_thread();
+        return;
+    case OpCodeId::Jump:
+        close_over(result, seen, checkpoints, { (u32)(ip + 2 + (ssize_t)m_bytecode.at(ip + 1)), 0 }, source, at_begin, at_end);
+        return;
+    case OpCodeId::ForkJump:
+        // The jumped-to branch is tried first (Fork_PrioHigh).
+        close_over(result, seen, checkpoints, { (u32)(ip + 2 + (ssize_t)m_bytecode.at(ip + 1)), 0 }, source, at_begin, at_end);
+        close_over(result, seen, checkpoints, { (u32)(ip + 2), 0 }, source, at_begin, at_end);
+        return;
+    case OpCodeId::ForkStay:
+        close_over(result, seen, checkpoints, { (u32)(ip + 2), 0 }, source, at_begin, at_end);
+        close_over(result, seen, checkpoints, { (u32)(ip + 2 + (ssize_t)m_bytecode.at(ip + 1)), 0 }, source, at_begin, at_end);
+        return;
+    case OpCodeId::Checkpoint:
+        checkpoints.append(ip);
+        close_over(result, seen, checkpoints, { (u32)(ip + 1), 0 }, source, at_begin, at_end);
+        checkpoints.take_last();
+        return;
+    case OpCodeId::JumpNonEmpty: {
+        // The loop body was empty exactly when its Checkpoint was executed at
+        // the current input position, i.e. somewhere on this closure path.
+        auto checkpoint_ip = (u32)(ip + 4 + (ssize_t)m_bytecode.at(ip + 2));
+        bool empty = checkpoints.contains_slow(checkpoint_ip);
+        auto fallthrough = ThreadIp { (u32)(ip + 4), 0 };
+        if (empty) {
+            close_over(result, seen, checkpoints, fallthrough, source, at_begin, at_end);
+            return;
+        }
+        auto jump_target = ThreadIp { (u32)(ip + 4 + (ssize_t)m_bytecode.at(ip + 1)), 0 };
+        switch ((OpCodeId)m_bytecode.at(ip + 3)) {
+        case OpCodeId::Jump:
+            close_over(result, seen, checkpoints, jump_target, source, at_begin, at_end);
+            return;
+        case OpCodeId::ForkJump:
+            close_over(result, seen, checkpoints, jump_target, source, at_begin, at_end);
+            close_over(result, seen, checkpoints, fallthrough, source, at_begin, at_end);
+            return;
+        case OpCodeId::ForkStay:
+            close_over(result, seen, checkpoints, fallthrough, source, at_begin, at_end);
+            close_over(result, seen, checkpoints, jump_target, source, at_begin, at_end);
+            return;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+    case OpCodeId::CheckBegin:
+        if (at_begin)
+            close_over(result, seen, checkpoints, { (u32)(ip + 1), 0 }, source, at_begin, at_end);
+        return;
+    case OpCodeId::CheckEnd:
+        if (at_end) {
+            close_over(result, seen, checkpoints, { (u32)(ip + 1), 0 }, source, at_begin, at_end);
+            return;
+        }
+        // Keep the thread around; it gets resolved if this state turns out
+        // to sit at the end of the input.
+        append_thread();
+        return;
+    case OpCodeId::Exit:
+        // An explicit Exit in the middle of the program only succeeds past
+        // the end of the input, which a forward-only scan can't reach.
+        return;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+static bool character_class_matches(CharClass character_class, u32 ch, bool insensitive)
+{
+    switch (character_class) {
+    case CharClass::Alnum:
+        return is_ascii_alphanumeric(ch);
+    case CharClass::Alpha:
+        return is_ascii_alpha(ch);
+    case CharClass::Blank:
+        return is_ascii_blank(ch);
+    case CharClass::Cntrl:
+        return is_ascii_control(ch);
+    case CharClass::Digit:
+        return is_ascii_digit(ch);
+    case CharClass::Graph:
+        return is_ascii_graphical(ch);
+    case CharClass::Lower:
+        return is_ascii_lower_alpha(ch) || (insensitive && is_ascii_upper_alpha(ch));
+    case CharClass::Print:
+        return is_ascii_printable(ch);
+    case CharClass::Punct:
+        return is_ascii_punctuation(ch);
+    case CharClass::Space:
+        return is_ascii_space(ch);
+    case CharClass::Upper:
+        return is_ascii_upper_alpha(ch) || (insensitive && is_ascii_lower_alpha(ch));
+    case CharClass::Word:
+        return is_ascii_alphanumeric(ch) || ch == '_';
+    case CharClass::Xdigit:
+        return is_ascii_hex_digit(ch);
+    }
+    VERIFY_NOT_REACHED();
+}
+
+bool DfaMatcher::compare_accepts(ByteCode const& bytecode, size_t ip, size_t sub, u32 ch, bool insensitive)
+{
+    if ((OpCodeId)bytecode.at(ip) != OpCodeId::Compare)
+        return false;
+
+    if (is_lone_string_compare(bytecode, ip)) {
+        // The VM renders the string back into bytes before comparing, which
+        // truncates each character; match that.
+        auto expected = (u32)(u8)bytecode.at(ip + 5 + sub);
+        if (insensitive)
+            return to_ascii_lowercase(expected) == to_ascii_lowercase(ch);
+        return expected == ch;
+    }
+
+    // This mirrors OpCode_Compare::execute() for a single code point,
+    // including the inversion bookkeeping.
+    auto arguments_count = bytecode.at(ip + 1);
+    size_t offset = ip + 3;
+
+    bool inverse { false };
+    bool temporary_inverse { false };
+    bool reset_temp_inverse { false };
+    bool inverse_matched { false };
+
+    auto current_inversion_state = [&]() { return temporary_inverse ^ inverse; };
+
+    for (size_t i = 0; i < arguments_count; ++i) {
+        if (reset_temp_inverse) {
+            reset_temp_inverse = false;
+            temporary_inverse = false;
+        } else {
+            reset_temp_inverse = true;
+        }
+
+        auto compare_type = (CharacterCompareType)bytecode.at(offset++);
+
+        if (compare_type == CharacterCompareType::Inverse) {
+            inverse = true;
+        } else if (compare_type == CharacterCompareType::TemporaryInverse) {
+            temporary_inverse = true;
+            reset_temp_inverse = false;
+        } else if (compare_type == CharacterCompareType::Char) {
+            // As for strings above, compare_char() truncates to a byte.
+            auto expected = (u32)(u8)bytecode.at(offset++);
+            bool equal;
+            if (insensitive)
+                equal = to_ascii_lowercase(expected) == to_ascii_lowercase(ch);
+            else
+                equal = expected == ch;
+            if (equal) {
+                if (current_inversion_state())
+                    inverse_matched = true;
+                else
+                    return true;
+            }
+        } else if (compare_type == CharacterCompareType::AnyChar) {
+            return true;
+        } else if (compare_type == CharacterCompareType::CharClass) {
+            auto character_class = (CharClass)bytecode.at(offset++);
+            if (character_class_matches(character_class, ch, insensitive)) {
+                // Note: [[:alpha:]] ignores inversion, just like the VM does.
+                if (current_inversion_state() && character_class != CharClass::Alpha)
+                    inverse_matched = true;
+                else
+                    return true;
+            }
+        } else if (compare_type == CharacterCompareType::CharRange) {
+            auto value = (CharRange)bytecode.at(offset++);
+            auto from = value.from;
+            auto to = value.to;
+            auto needle = ch;
+            if (insensitive) {
+                from = to_ascii_lowercase(from);
+                to = to_ascii_lowercase(to);
+                needle = to_ascii_lowercase(needle);
+            }
+            if (needle >= from && needle <= to) {
+                if (current_inversion_state())
+                    inverse_matched = true;
+                else
+                    return true;
+            }
+        } else {
+            VERIFY_NOT_REACHED();
+        }
+    }
+
+    return current_inversion_state() && !inverse_matched;
+}
+
+DfaMatcher::ThreadIp DfaMatcher::successor_of(ThreadIp thread) const
+{
+    auto size = (u32)opcode_size_at(m_bytecode, thread.ip);
+    if (is_lone_string_compare(m_bytecode, thread.ip)) {
+        auto length = (u32)m_bytecode.at(thread.ip + 4);
+        if (thread.sub + 1 < length)
+            return { thread.ip, thread.sub + 1 };
+    }
+    return { thread.ip + size, 0 };
+}
+
+Optional<u32> DfaMatcher::intern_state(ClosureResult&& closure)
+{
+    StringBuilder builder;
+    for (auto& thread : closure.threads)
+        builder.appendff("{}:{};", thread.ip, thread.sub);
+    if (closure.accepts)
+        builder.append('!');
+    auto key = builder.build();
+
+    if (auto existing = m_state_ids.get(key); existing.has_value())
+        return existing.value();
+
+    if (m_states.size() >= max_cached_states)
+        return {};
+
+    auto state = make<State>();
+    state->threads = move(closure.threads);
+    state->accepts = closure.accepts;
+    m_states.append(move(state));
+    auto index = (u32)(m_states.size() - 1);
+    m_state_ids.set(move(key), index);
+    return index;
+}
+
+Optional<u32> DfaMatcher::start_state(bool at_begin)
+{
+    auto& cached = m_start_states[at_begin ? 1 : 0];
+    if (cached.has_value())
+        return cached;
+
+    ClosureResult closure;
+    HashTable<String> seen;
+    Vector<u32> checkpoints;
+    close_over(closure, seen, checkpoints, { 0, 0 }, seed_source, at_begin, false);
+    cached = intern_state(move(closure));
+    return cached;
+}
+
+Optional<u32> DfaMatcher::transition(u32 state_index, u32 ch, bool seeded, bool insensitive)
+{
+    auto& state = m_states[state_index];
+    auto mode = seeded ? 1 : 0;
+    if (auto cached = state.transitions[mode][ch]; cached >= 0)
+        return (u32)cached;
+
+    ClosureResult closure;
+    HashTable<String> seen;
+    Vector<u32> checkpoints;
+    for (size_t i = 0; i < state.threads.size(); ++i) {
+        if (closure.accepts)
+            break;
+        auto thread = state.threads[i];
+        if (thread.sub == 0 && (OpCodeId)m_bytecode.at(thread.ip) == OpCodeId::CheckEnd)
+            continue; // We just consumed a character, so this wasn't the end.
+        if (compare_accepts(m_bytecode, thread.ip, thread.sub, ch, insensitive))
+            close_over(closure, seen, checkpoints, successor_of(thread), (u32)i, false, false);
+    }
+    if (seeded && !closure.accepts) {
+        // Merge in a fresh attempt starting right after this character, at
+        // the lowest priority - matches starting earlier always win.
+        close_over(closure, seen, checkpoints, { 0, 0 }, seed_source, false, false);
+    }
+
+    auto accept_source = closure.accept_source;
+    auto sources = move(closure.sources);
+    auto maybe_target = intern_state(move(closure));
+    if (!maybe_target.has_value())
+        return {};
+
+    m_transitions.append({ maybe_target.value(), accept_source, move(sources) });
+    auto transition_index = (u32)(m_transitions.size() - 1);
+    // Note: intern_state() may have grown m_states, invalidating `state`.
+    m_states[state_index].transitions[mode][ch] = (i32)transition_index;
+    return transition_index;
+}
+
+void DfaMatcher::flush_cache()
+{
+    m_states.clear();
+    m_transitions.clear();
+    m_state_ids.clear();
+    m_start_states[0] = {};
+    m_start_states[1] = {};
+}
+
+DfaMatcher::RunResult DfaMatcher::run(RegexStringView const& view, size_t start_position, bool allow_restart, AllOptions options, size_t& operations, MatchSpan& match)
+{
+    bool insensitive = options.has_flag_set(AllFlags::Insensitive);
+    if (insensitive != m_cache_insensitive) {
+        // The cached transitions were computed for the other case
+        // sensitivity; start over.
+        flush_cache();
+        m_cache_insensitive = insensitive;
+    }
+
+    auto length = view.length();
+    auto maybe_state = start_state(start_position == 0);
+    if (!maybe_state.has_value())
+        return RunResult::GaveUp;
+    auto state_index = maybe_state.value();
+
+    bool seeding = allow_restart;
+    Optional<MatchSpan> recorded;
+    Vector<size_t> thread_starts;
+    Vector<size_t> previous_starts;
+    thread_starts.resize(m_states[state_index].threads.size());
+    for (auto& thread_start : thread_starts)
+        thread_start = start_position;
+
+    if (m_states[state_index].accepts) {
+        recorded = MatchSpan { start_position, start_position };
+        seeding = false;
+    }
+
+    auto position = start_position;
+    while (position < length) {
+        if (m_states[state_index].threads.is_empty())
+            break;
+
+        auto ch = (u32)view[position];
+        // A restart thread seeded here would begin its attempt at the next
+        // position; the match loop never starts one at the very end.
+        bool seed = seeding && position + 1 < length;
+        auto maybe_transition = transition(state_index, ch, seed, insensitive);
+        if (!maybe_transition.has_value())
+            return RunResult::GaveUp;
+        auto& step = m_transitions[maybe_transition.value()];
+        ++operations;
+
+        auto& target = m_states[step.target];
+        if (target.accepts) {
+            auto match_start = step.accept_source == seed_source ? position + 1 : thread_starts[step.accept_source];
+            recorded = MatchSpan { match_start, position + 1 };
+            seeding = false;
+        }
+
+        swap(thread_starts, previous_starts);
+        thread_starts.clear_with_capacity();
+        thread_starts.ensure_capacity(step.sources.size());
+        for (auto source : step.sources)
+            thread_starts.unchecked_append(source == seed_source ? position + 1 : previous_starts[source]);
+        state_index = step.target;
+        ++position;
+    }
+
+    if (position == length) {
+        // Resolve threads stuck on a $ anchor now that we know this is the
+        // end. They all outrank whatever match is recorded so far.
+        auto& state = m_states[state_index];
+        for (size_t i = 0; i < state.threads.size(); ++i) {
+            auto thread = state.threads[i];
+            if (thread.sub != 0 || (OpCodeId)m_bytecode.at(thread.ip) != OpCodeId::CheckEnd)
+                continue;
+            ClosureResult closure;
+            HashTable<String> seen;
+            Vector<u32> checkpoints;
+            close_over(closure, seen, checkpoints, thread, (u32)i, position == 0, true);
+            if (closure.accepts) {
+                recorded = MatchSpan { thread_starts[i], position };
+                break;
+            }
+        }
+    }
+
+    if (recorded.has_value()) {
+        match = recorded.value();
+        return RunResult::Matched;
+    }
+    return RunResult::NoMatch;
+}
+
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexMatch.h"
+#include "RegexOptions.h"
+
+#include <AK/Array.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/NonnullOwnPtrVector.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// A lazy-DFA execution tier for bytecode that doesn't need backtracking.
+//
+// The backtracking VM in Matcher::execute() re-runs the whole program for
+// every fork, which is slow for plain patterns and exponential for
+// pathological ones. When the bytecode contains no captures, backreferences,
+// lookarounds, counted repetitions or boundary checks, it is an ordinary NFA
+// and can be simulated by running all alternatives in lock-step, one input
+// code point at a time. The sets of alternatives ("threads") that come up are
+// memoized as DFA states, and the per-character steps between them as DFA
+// transitions, so the hot loop usually degenerates to one table lookup per
+// character - linear time, no matter the pattern.
+//
+// Threads are kept in the order the backtracker would try them, and finding
+// an accepting thread prunes every thread of lower priority, so the reported
+// match is exactly the one the backtracking VM would have produced
+// (leftmost, then fork-priority order, i.e. greedy/non-greedy as written).
+class DfaMatcher {
+public:
+    explicit DfaMatcher(ByteCode const& bytecode)
+        : m_bytecode(bytecode)
+    {
+    }
+
+    // Whether the bytecode only uses opcodes this engine understands.
+    static bool suits(ByteCode const&);
+
+    // The size in words of the instruction at `ip`.
+    static size_t opcode_size_at(ByteCode const&, size_t ip);
+
+    // Whether the instruction at `ip` is a Compare of a single String.
+    static bool is_lone_string_compare(ByteCode const&, size_t ip);
+
+    // Whether the Compare at `ip` accepts `ch`, replicating the VM's quirks
+    // exactly; `sub` indexes into the characters of a lone string compare
+    // (which must not be empty). Shared with the literal prefilter
+    // (RegexPrefilter.h).
+    static bool compare_accepts(ByteCode const&, size_t ip, size_t sub, u32 ch, bool insensitive);
+
+    struct MatchSpan {
+        size_t start { 0 };
+        size_t end { 0 };
+    };
+
+    enum class RunResult {
+        NoMatch, // No match starting at or after the given position.
+        Matched,
+        GaveUp, // State cache blew up; caller should use the backtracker.
+    };
+
+    // Finds a match in one left-to-right pass over the view: the leftmost
+    // match starting at or after start_position when allow_restart is set,
+    // and only a match starting exactly there otherwise. Only valid for plain
+    // string views and options without the MatchNot{Begin,End}OfLine quirks;
+    // callers check.
+    RunResult run(RegexStringView const& view, size_t start_position, bool allow_restart, AllOptions options, size_t& operations, MatchSpan&);
+
+private:
+    // A position in the program: an instruction pointer, plus an offset into
+    // the character list when the instruction is a Compare of a String.
+    struct ThreadIp {
+        u32 ip { 0 };
+        u32 sub { 0 };
+
+        bool operator==(ThreadIp const& other) const { return ip == other.ip && sub == other.sub; }
+    };
+
+    static constexpr u32 seed_source = 0xffffffff;
+    static constexpr u32 no_accept = 0xfffffffe;
+    static constexpr size_t max_cached_states = 1024;
+
+    struct State {
+        Vector<ThreadIp> threads; // In decreasing backtracker priority.
+        bool accepts { false };
+
+        // Lazily filled per-byte transition tables, [0] without and [1] with
+        // the restart thread merged in; -1 means "not computed yet".
+        Array<i32, 256> transitions[2];
+
+        State()
+        {
+            transitions[0].fill(-1);
+            transitions[1].fill(-1);
+        }
+    };
+
+    struct Transition {
+        u32 target { 0 };
+        // Thread index (in the source state) whose path accepted, seed_source
+        // for a fresh restart thread, or no_accept.
+        u32 accept_source { no_accept };
+        // For each thread of the target state, the index of the source
+        // thread it descended from, or seed_source.
+        Vector<u32> sources;
+    };
+
+    struct ClosureResult {
+        Vector<ThreadIp> threads;
+        Vector<u32> sources;
+        HashTable<u64> appended; // Only used while building; keeps `threads` duplicate-free.
+        bool accepts { false };
+        u32 accept_source { no_accept };
+    };
+
+    // `checkpoints` lists the Checkpoint instructions executed on the path to
+    // the current thread, i.e. those taken at the current input position.
+    void close_over(ClosureResult&, HashTable<String>& seen, Vector<u32>& checkpoints, ThreadIp, u32 source, bool at_begin, bool at_end) const;
+    ThreadIp successor_of(ThreadIp) const;
+    Optional<u32> intern_state(ClosureResult&&);
+    Optional<u32> start_state(bool at_begin);
+    Optional<u32> transition(u32 state_index, u32 ch, bool seeded, bool insensitive);
+    void flush_cache();
+
+    ByteCode const& m_bytecode;
+    NonnullOwnPtrVector<State> m_states;
+    Vector<Transition> m_transitions;
+    HashMap<String, u32> m_state_ids;
+    Optional<u32> m_start_states[2];
+    bool m_cache_insensitive { false };
+};
+
+}
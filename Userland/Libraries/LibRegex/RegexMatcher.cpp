@@ -8,8 +8,10 @@
 #include <AK/Debug.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
+#include <LibCore/PerformanceCounters.h>
 #include <LibRegex/RegexMatcher.h>
 #include <LibRegex/RegexParser.h>
+#include <pthread.h>
 
 #if REGEX_DEBUG
 #    include <LibRegex/RegexDebug.h>
@@ -21,26 +23,130 @@ namespace regex {
 static RegexDebug s_regex_dbg(stderr);
 #endif
 
+// A process-wide cache of compiled patterns. Compiled programs are immutable,
+// so identical (pattern, flags) pairs can share the parse work; LibJS in
+// particular recompiles the same RegExp sources over and over when scripts
+// construct patterns in loops. Only successful parses are cached, and the
+// cache holds a fixed number of entries, evicting the least recently used.
+static constexpr size_t c_pattern_cache_capacity = 64;
+
+struct PatternCacheEntry {
+    regex::Parser::Result result;
+    u64 last_used { 0 };
+};
+
+struct PatternCache {
+    HashMap<String, PatternCacheEntry> entries;
+    u64 use_counter { 0 };
+    Core::PerfCounter hits;
+    Core::PerfCounter misses;
+};
+
+static pthread_mutex_t s_pattern_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static PatternCache& pattern_cache()
+{
+    static PatternCache s_cache {
+        .entries = {},
+        .use_counter = 0,
+        .hits = Core::PerformanceCounters::register_counter("regex-cache-hits"),
+        .misses = Core::PerformanceCounters::register_counter("regex-cache-misses"),
+    };
+    return s_cache;
+}
+
+// Parsers with different grammars (or options) compile the same pattern text
+// differently, so both take part in the cache key.
+template<class Parser>
+static constexpr char parser_cache_tag = '?';
+template<>
+constexpr char parser_cache_tag<PosixBasicParser> = 'b';
+template<>
+constexpr char parser_cache_tag<PosixExtendedParser> = 'e';
+template<>
+constexpr char parser_cache_tag<ECMA262Parser> = 'j';
+
+static String pattern_cache_key(char parser_tag, StringView pattern, FlagsUnderlyingType flags)
+{
+    return String::formatted("{}{}:{}", parser_tag, flags, pattern);
+}
+
+static Optional<regex::Parser::Result> lookup_pattern_cache(char parser_tag, StringView pattern, FlagsUnderlyingType flags)
+{
+    auto& cache = pattern_cache();
+    pthread_mutex_lock(&s_pattern_cache_lock);
+    auto it = cache.entries.find(pattern_cache_key(parser_tag, pattern, flags));
+    Optional<regex::Parser::Result> result;
+    if (it != cache.entries.end()) {
+        it->value.last_used = ++cache.use_counter;
+        result = it->value.result;
+        cache.hits.add();
+    } else {
+        cache.misses.add();
+    }
+    pthread_mutex_unlock(&s_pattern_cache_lock);
+    return result;
+}
+
+static void store_in_pattern_cache(char parser_tag, StringView pattern, FlagsUnderlyingType flags, regex::Parser::Result const& result)
+{
+    auto entry = PatternCacheEntry { result, 0 };
+    // The error token views into the caller's pattern string, which won't
+    // outlive the cache; it carries no information for a successful parse.
+    entry.result.error_token = {};
+
+    auto& cache = pattern_cache();
+    pthread_mutex_lock(&s_pattern_cache_lock);
+    if (cache.entries.size() >= c_pattern_cache_capacity) {
+        auto least_recently_used = cache.entries.begin();
+        for (auto it = cache.entries.begin(); it != cache.entries.end(); ++it) {
+            if (it->value.last_used < least_recently_used->value.last_used)
+                least_recently_used = it;
+        }
+        cache.entries.remove(least_recently_used);
+    }
+    entry.last_used = ++cache.use_counter;
+    cache.entries.set(pattern_cache_key(parser_tag, pattern, flags), move(entry));
+    pthread_mutex_unlock(&s_pattern_cache_lock);
+}
+
 template<class Parser>
 regex::Parser::Result Regex<Parser>::parse_pattern(StringView pattern, typename ParserTraits<Parser>::OptionsType regex_options)
 {
+    auto flags = (FlagsUnderlyingType)regex_options.value();
+    if (auto cached = lookup_pattern_cache(parser_cache_tag<Parser>, pattern, flags); cached.has_value())
+        return cached.release_value();
+
     regex::Lexer lexer(pattern);
 
     Parser parser(lexer, regex_options);
-    return parser.parse();
+    auto result = parser.parse();
+
+    if (result.error == regex::Error::NoError)
+        store_in_pattern_cache(parser_cache_tag<Parser>, pattern, flags, result);
+    return result;
 }
 
 template<class Parser>
 Regex<Parser>::Regex(String pattern, typename ParserTraits<Parser>::OptionsType regex_options)
     : pattern_value(move(pattern))
 {
+    auto flags = (FlagsUnderlyingType)regex_options.value();
+    if (auto cached = lookup_pattern_cache(parser_cache_tag<Parser>, pattern_value, flags); cached.has_value()) {
+        parser_result = cached.release_value();
+        matcher = make<Matcher<Parser>>(this, regex_options);
+        return;
+    }
+
     regex::Lexer lexer(pattern_value);
 
     Parser parser(lexer, regex_options);
     parser_result = parser.parse();
 
-    if (parser_result.error == regex::Error::NoError)
+    if (parser_result.error == regex::Error::NoError) {
         matcher = make<Matcher<Parser>>(this, regex_options);
+        store_in_pattern_cache(parser_cache_tag<Parser>, pattern_value, flags, parser_result);
+    }
 }
 
 template<class Parser>
@@ -222,7 +328,19 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             }
         }
 
+        // Without continue_search this loop only ever tries the one start
+        // position, so there's nothing for the prefilter to skip.
+        auto* prefilter = continue_search ? prefilter_for(input) : nullptr;
         for (; view_index < view_length; ++view_index) {
+            if (prefilter) {
+                // Skip ahead to the next position a match could possibly
+                // start at; see RegexPrefilter.h.
+                auto candidate = prefilter->next_candidate(input.view.string_view(), view_index);
+                if (!candidate.has_value())
+                    break;
+                view_index = candidate.value();
+            }
+
             auto& match_length_minimum = m_pattern->parser_result.match_length_minimum;
             // FIXME: More performant would be to know the remaining minimum string
             //        length needed to match from the current position onwards within
@@ -241,7 +359,39 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             state.instruction_position = 0;
             state.repetition_marks.clear();
 
-            auto success = execute(input, state, operations);
+            Optional<bool> success;
+            if (auto* dfa = dfa_for(input)) {
+                DfaMatcher::MatchSpan span;
+                // Without continue_search this loop only ever tries the one
+                // start position, so don't let the DFA restart either. With a
+                // prefilter, skipping between candidates beats the DFA's own
+                // linear scan, so keep it pinned to this one as well.
+                bool allow_restart = continue_search && !prefilter;
+                auto outcome = dfa->run(input.view, view_index, allow_restart, input.regex_options, operations, span);
+                if (outcome == DfaMatcher::RunResult::GaveUp) {
+                    // Too many distinct states for this pattern; stick with
+                    // the backtracker from now on.
+                    m_dfa = nullptr;
+                    m_dfa_unsuitable = true;
+                } else if (outcome == DfaMatcher::RunResult::NoMatch) {
+                    if (!allow_restart) {
+                        // Nothing starting exactly here; try the next
+                        // candidate position.
+                        success = false;
+                    } else {
+                        // The DFA scanned the rest of the view in one pass,
+                        // so no later start position can match either.
+                        break;
+                    }
+                } else {
+                    view_index = span.start;
+                    state.string_position = span.end;
+                    state.string_position_in_code_units = span.end;
+                    success = true;
+                }
+            }
+            if (!success.has_value())
+                success = execute(input, state, operations);
             if (!success.has_value())
                 return { false, 0, {}, {}, {}, operations };
 
@@ -324,6 +474,67 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     return result;
 }
 
+template<class Parser>
+DfaMatcher* Matcher<Parser>::dfa_for(MatchInput const& input) const
+{
+    if constexpr (REGEX_DEBUG) {
+        // Debug tracing only exists for the backtracking VM.
+        return nullptr;
+    }
+
+    if (m_dfa_unsuitable)
+        return nullptr;
+
+    // The DFA consumes one byte per step, so it only handles plain string
+    // subjects; the UTF-* views have per-view-type comparison quirks that
+    // the backtracker deals with.
+    if (input.view.unicode() || !input.view.is_string_view())
+        return nullptr;
+
+    // It also has no notion of the MatchNot{Begin,End}OfLine quirks.
+    if (input.regex_options.has_flag_set(AllFlags::MatchNotBeginOfLine) || input.regex_options.has_flag_set(AllFlags::MatchNotEndOfLine))
+        return nullptr;
+
+    // Stateful matches fail outright when nothing matches at the exact start
+    // offset, while the DFA would happily report a later match.
+    if (input.regex_options.has_flag_set(AllFlags::Internal_Stateful))
+        return nullptr;
+
+    if (!m_dfa) {
+        if (!DfaMatcher::suits(m_pattern->parser_result.bytecode)) {
+            m_dfa_unsuitable = true;
+            return nullptr;
+        }
+        m_dfa = make<DfaMatcher>(m_pattern->parser_result.bytecode);
+    }
+    return m_dfa.ptr();
+}
+
+template<class Parser>
+Prefilter const* Matcher<Parser>::prefilter_for(MatchInput const& input) const
+{
+    // The prefilter skips start positions outright; a stateful match has to
+    // fail in place instead, and a pattern that can match the empty string
+    // can start anywhere.
+    if (input.regex_options.has_flag_set(AllFlags::Internal_Stateful))
+        return nullptr;
+    if (m_pattern->parser_result.match_length_minimum == 0)
+        return nullptr;
+
+    // Candidates are byte positions, so only plain string subjects apply.
+    if (input.view.unicode() || !input.view.is_string_view())
+        return nullptr;
+
+    auto index = input.regex_options.has_flag_set(AllFlags::Insensitive) ? 1 : 0;
+    if (!m_prefilter_computed[index]) {
+        m_prefilter[index] = Prefilter::create(m_pattern->parser_result.bytecode, index == 1);
+        m_prefilter_computed[index] = true;
+    }
+    if (!m_prefilter[index].has_value())
+        return nullptr;
+    return &m_prefilter[index].value();
+}
+
 template<typename T>
 class BumpAllocatedLinkedList {
 public:
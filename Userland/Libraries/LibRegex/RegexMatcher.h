@@ -7,9 +7,11 @@
 #pragma once
 
 #include "RegexByteCode.h"
+#include "RegexDfa.h"
 #include "RegexMatch.h"
 #include "RegexOptions.h"
 #include "RegexParser.h"
+#include "RegexPrefilter.h"
 
 #include <AK/Forward.h>
 #include <AK/GenericLexer.h>
@@ -62,13 +64,32 @@ public:
     void reset_pattern(Badge<Regex<Parser>>, Regex<Parser> const* pattern)
     {
         m_pattern = pattern;
+        // The DFA holds a reference into the old pattern's bytecode, and the
+        // prefilters were derived from it.
+        m_dfa = nullptr;
+        for (auto index : { 0, 1 }) {
+            m_prefilter[index] = {};
+            m_prefilter_computed[index] = false;
+        }
     }
 
 private:
     Optional<bool> execute(MatchInput const& input, MatchState& state, size_t& operations) const;
+    DfaMatcher* dfa_for(MatchInput const&) const;
+    Prefilter const* prefilter_for(MatchInput const&) const;
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
+
+    // Lazily-built DFA tier for bytecode that doesn't need backtracking,
+    // see RegexDfa.h. Dropped again if the state cache blows up.
+    mutable OwnPtr<DfaMatcher> m_dfa;
+    mutable bool m_dfa_unsuitable { false };
+
+    // Lazily-derived candidate scanners, see RegexPrefilter.h; [1] is the
+    // case-insensitive variant.
+    mutable Optional<Prefilter> m_prefilter[2];
+    mutable bool m_prefilter_computed[2] { false, false };
 };
 
 template<class Parser>
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "RegexPrefilter.h"
+#include "RegexDfa.h"
+#include <AK/HashTable.h>
+#include <AK/MemMem.h>
+
+namespace regex {
+
+// Collects the literal every match must start with, by walking the
+// straight-line head of the program and appending whatever the leading
+// Compares can only match one way. Stops (keeping what it has) at the first
+// fork, class, or anything else that allows more than one character.
+static Vector<u8> extract_literal_prefix(ByteCode const& bytecode)
+{
+    constexpr size_t max_literal_length = 64;
+
+    Vector<u8> literal;
+    size_t ip = 0;
+    while (ip < bytecode.size() && literal.size() < max_literal_length) {
+        switch ((OpCodeId)bytecode.at(ip)) {
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckBoundary:
+        case OpCodeId::Checkpoint:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::SaveLeftCaptureGroup:
+            // Doesn't consume input and can't fail the prefix.
+            ip += DfaMatcher::opcode_size_at(bytecode, ip);
+            continue;
+        case OpCodeId::Jump:
+            ip = ip + 2 + (ssize_t)bytecode.at(ip + 1);
+            continue;
+        case OpCodeId::Compare: {
+            if (DfaMatcher::is_lone_string_compare(bytecode, ip)) {
+                // The VM renders the string back into bytes before comparing,
+                // which truncates each character; match that.
+                auto length = bytecode.at(ip + 4);
+                for (size_t i = 0; i < length && literal.size() < max_literal_length; ++i)
+                    literal.append((u8)bytecode.at(ip + 5 + i));
+            } else if (bytecode.at(ip + 1) == 1 && (CharacterCompareType)bytecode.at(ip + 3) == CharacterCompareType::Char) {
+                literal.append((u8)bytecode.at(ip + 4));
+            } else {
+                return literal;
+            }
+            ip += DfaMatcher::opcode_size_at(bytecode, ip);
+            continue;
+        }
+        default:
+            return literal;
+        }
+    }
+    return literal;
+}
+
+// Collects the set of bytes a match can possibly start with by following
+// every non-consuming edge from the program start and evaluating the Compares
+// this reaches against all 256 byte values. Returns false when the head of
+// the program contains something we can't safely reason about (or the
+// pattern can match without consuming anything at all).
+static bool collect_first_bytes(ByteCode const& bytecode, bool insensitive, Array<bool, 256>& first_bytes)
+{
+    HashTable<size_t> seen;
+    Vector<size_t> work;
+    work.append(0);
+
+    while (!work.is_empty()) {
+        auto ip = work.take_last();
+        if (ip >= bytecode.size())
+            return false; // An empty match is possible, so any position is a candidate.
+        if (seen.contains(ip))
+            continue;
+        seen.set(ip);
+
+        switch ((OpCodeId)bytecode.at(ip)) {
+        case OpCodeId::Compare:
+            if (DfaMatcher::is_lone_string_compare(bytecode, ip) && bytecode.at(ip + 4) == 0) {
+                // Comparing against the empty string always passes.
+                work.append(ip + DfaMatcher::opcode_size_at(bytecode, ip));
+                continue;
+            }
+            for (size_t ch = 0; ch < 256; ++ch) {
+                if (!first_bytes[ch] && DfaMatcher::compare_accepts(bytecode, ip, 0, (u32)ch, insensitive))
+                    first_bytes[ch] = true;
+            }
+            continue;
+        case OpCodeId::Jump:
+            work.append(ip + 2 + (ssize_t)bytecode.at(ip + 1));
+            continue;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay:
+            work.append(ip + 2 + (ssize_t)bytecode.at(ip + 1));
+            work.append(ip + 2);
+            continue;
+        case OpCodeId::JumpNonEmpty:
+            // We don't track loop progress here; both edges are possible.
+            work.append(ip + 4 + (ssize_t)bytecode.at(ip + 1));
+            work.append(ip + 4);
+            continue;
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::CheckBoundary:
+        case OpCodeId::Checkpoint:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ResetRepeat:
+            // Assertions and capture bookkeeping don't consume input; passing
+            // through them unconditionally only over-approximates the set.
+            work.append(ip + DfaMatcher::opcode_size_at(bytecode, ip));
+            continue;
+        case OpCodeId::FailForks:
+            continue; // Dead end on this path.
+        default:
+            // Save/Restore/GoBack (lookarounds inspect input out of line) and
+            // whatever else: be conservative and keep no prefilter at all.
+            return false;
+        }
+    }
+    return true;
+}
+
+Optional<Prefilter> Prefilter::create(ByteCode const& bytecode, bool insensitive)
+{
+    Prefilter prefilter;
+
+    // A literal prefix beats a byte set, but memmem() compares exactly, so
+    // only use one when case matters.
+    if (!insensitive) {
+        prefilter.m_literal = extract_literal_prefix(bytecode);
+        if (prefilter.m_literal.size() >= 2)
+            return prefilter;
+        prefilter.m_literal.clear();
+    }
+
+    if (!collect_first_bytes(bytecode, insensitive, prefilter.m_first_bytes))
+        return {};
+
+    size_t set_count = 0;
+    u8 only_byte = 0;
+    for (size_t ch = 0; ch < 256; ++ch) {
+        if (prefilter.m_first_bytes[ch]) {
+            ++set_count;
+            only_byte = (u8)ch;
+        }
+    }
+    if (set_count == 1) {
+        // A single possible byte scans faster as a one-byte "literal".
+        prefilter.m_literal.append(only_byte);
+        return prefilter;
+    }
+    if (set_count > 128)
+        return {}; // Scanning wouldn't skip enough to pay for itself.
+    return prefilter;
+}
+
+Optional<size_t> Prefilter::next_candidate(StringView haystack, size_t position) const
+{
+    auto const* bytes = (u8 const*)haystack.characters_without_null_termination();
+    auto length = haystack.length();
+    if (position >= length)
+        return {};
+
+    if (!m_literal.is_empty()) {
+        auto found = AK::memmem_optional(bytes + position, length - position, m_literal.data(), m_literal.size());
+        if (!found.has_value())
+            return {};
+        return position + found.value();
+    }
+
+    for (auto i = position; i < length; ++i) {
+        if (m_first_bytes[bytes[i]])
+            return i;
+    }
+    return {};
+}
+
+}
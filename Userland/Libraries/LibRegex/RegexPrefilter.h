@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+
+#include <AK/Array.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// A candidate scanner for the matchers: every match has to begin with
+// something, and for most patterns the compiled bytecode pins that down to a
+// required literal prefix (e.g. "error" for error.*timeout) or at least a
+// small set of possible first bytes. Extracting that once lets the matcher
+// skip to the next plausible start position with a vectorized memmem/memchr
+// instead of invoking the engine at every single offset.
+//
+// The analysis is conservative: create() fails rather than guess whenever the
+// bytecode starts with something it doesn't understand (e.g. a lookaround),
+// and a byte set is only kept when it actually excludes a useful chunk of the
+// alphabet. A returned candidate is merely necessary, never sufficient - the
+// caller still runs the real matcher there.
+class Prefilter {
+public:
+    // Yields an empty Optional when no useful prefilter can be derived.
+    static Optional<Prefilter> create(ByteCode const&, bool insensitive);
+
+    // The next position at or after `position` where a match could possibly
+    // start, if any.
+    Optional<size_t> next_candidate(StringView haystack, size_t position) const;
+
+private:
+    Prefilter() = default;
+
+    // A literal every match starts with, byte-truncated the way the VM
+    // compares; searched with memmem(). Empty when only a byte set is known.
+    Vector<u8> m_literal;
+    // Otherwise, the set of bytes a match can start with.
+    Array<bool, 256> m_first_bytes {};
+};
+
+}
@@ -299,6 +299,7 @@ struct ExecutionContext {
     NonnullRefPtr<Database> database;
     RefPtr<SQLResult> result { nullptr };
     Tuple current_row {};
+    Vector<Value> placeholder_values {};
 };
 
 class Expression : public ASTNode {
@@ -355,6 +356,20 @@ public:
     virtual Value evaluate(ExecutionContext&) const override;
 };
 
+class Placeholder : public Expression {
+public:
+    explicit Placeholder(size_t parameter_index)
+        : m_parameter_index(parameter_index)
+    {
+    }
+
+    size_t parameter_index() const { return m_parameter_index; }
+    virtual Value evaluate(ExecutionContext&) const override;
+
+private:
+    size_t m_parameter_index;
+};
+
 class NestedExpression : public Expression {
 public:
     const NonnullRefPtr<Expression>& expression() const { return m_expression; }
@@ -429,6 +444,7 @@ public:
     const String& schema_name() const { return m_schema_name; }
     const String& table_name() const { return m_table_name; }
     const String& column_name() const { return m_column_name; }
+    virtual Value evaluate(ExecutionContext&) const override;
 
 private:
     String m_schema_name;
@@ -489,6 +505,7 @@ public:
     }
 
     BinaryOperator type() const { return m_type; }
+    virtual Value evaluate(ExecutionContext&) const override;
 
 private:
     BinaryOperator m_type;
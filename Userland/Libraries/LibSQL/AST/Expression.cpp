@@ -9,6 +9,76 @@
 
 namespace SQL::AST {
 
+// Anything in an expression that goes wrong at evaluation time comes from
+// client-supplied SQL, so it must surface as an SQL error on the result
+// rather than asserting. Callers check ExecutionContext::result after
+// evaluating; the returned null value keeps enclosing expressions harmless.
+static Value evaluation_error(ExecutionContext& context, SQLErrorCode code, String argument = {})
+{
+    if (!context.result)
+        context.result = SQLResult::construct();
+    context.result->set_error(code, move(argument));
+    return Value::null();
+}
+
+static char const* unary_operator_name(UnaryOperator op)
+{
+    switch (op) {
+    case UnaryOperator::Minus:
+        return "-";
+    case UnaryOperator::Plus:
+        return "+";
+    case UnaryOperator::BitwiseNot:
+        return "~";
+    case UnaryOperator::Not:
+        return "NOT";
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static char const* binary_operator_name(BinaryOperator op)
+{
+    switch (op) {
+    case BinaryOperator::Concatenate:
+        return "||";
+    case BinaryOperator::Multiplication:
+        return "*";
+    case BinaryOperator::Division:
+        return "/";
+    case BinaryOperator::Modulo:
+        return "%";
+    case BinaryOperator::Plus:
+        return "+";
+    case BinaryOperator::Minus:
+        return "-";
+    case BinaryOperator::ShiftLeft:
+        return "<<";
+    case BinaryOperator::ShiftRight:
+        return ">>";
+    case BinaryOperator::BitwiseAnd:
+        return "&";
+    case BinaryOperator::BitwiseOr:
+        return "|";
+    case BinaryOperator::LessThan:
+        return "<";
+    case BinaryOperator::LessThanEquals:
+        return "<=";
+    case BinaryOperator::GreaterThan:
+        return ">";
+    case BinaryOperator::GreaterThanEquals:
+        return ">=";
+    case BinaryOperator::Equals:
+        return "=";
+    case BinaryOperator::NotEquals:
+        return "!=";
+    case BinaryOperator::And:
+        return "AND";
+    case BinaryOperator::Or:
+        return "OR";
+    }
+    VERIFY_NOT_REACHED();
+}
+
 Value Expression::evaluate(ExecutionContext&) const
 {
     return Value::null();
@@ -33,6 +103,13 @@ Value NullLiteral::evaluate(ExecutionContext&) const
     return Value::null();
 }
 
+Value Placeholder::evaluate(ExecutionContext& context) const
+{
+    if (m_parameter_index >= context.placeholder_values.size())
+        return evaluation_error(context, SQLErrorCode::InvalidNumberOfPlaceholderValues);
+    return context.placeholder_values[m_parameter_index];
+}
+
 Value NestedExpression::evaluate(ExecutionContext& context) const
 {
     return expression()->evaluate(context);
@@ -52,12 +129,13 @@ Value ChainedExpression::evaluate(ExecutionContext& context) const
 Value UnaryOperatorExpression::evaluate(ExecutionContext& context) const
 {
     Value expression_value = NestedExpression::evaluate(context);
+    if (context.result && context.result->is_error())
+        return Value::null();
     switch (type()) {
     case UnaryOperator::Plus:
         if (expression_value.type() == SQLType::Integer || expression_value.type() == SQLType::Float)
             return expression_value;
-        // TODO: Error handling.
-        VERIFY_NOT_REACHED();
+        return evaluation_error(context, SQLErrorCode::NumericOperatorTypeMismatch, unary_operator_name(type()));
     case UnaryOperator::Minus:
         if (expression_value.type() == SQLType::Integer) {
             expression_value = -int(expression_value);
@@ -67,24 +145,77 @@ Value UnaryOperatorExpression::evaluate(ExecutionContext& context) const
             expression_value = -double(expression_value);
             return expression_value;
         }
-        // TODO: Error handling.
-        VERIFY_NOT_REACHED();
+        return evaluation_error(context, SQLErrorCode::NumericOperatorTypeMismatch, unary_operator_name(type()));
     case UnaryOperator::Not:
         if (expression_value.type() == SQLType::Boolean) {
             expression_value = !bool(expression_value);
             return expression_value;
         }
-        // TODO: Error handling.
-        VERIFY_NOT_REACHED();
+        return evaluation_error(context, SQLErrorCode::BooleanOperatorTypeMismatch, unary_operator_name(type()));
     case UnaryOperator::BitwiseNot:
         if (expression_value.type() == SQLType::Integer) {
             expression_value = ~u32(expression_value);
             return expression_value;
         }
-        // TODO: Error handling.
-        VERIFY_NOT_REACHED();
+        return evaluation_error(context, SQLErrorCode::NumericOperatorTypeMismatch, unary_operator_name(type()));
     }
     VERIFY_NOT_REACHED();
 }
 
+Value BinaryOperatorExpression::evaluate(ExecutionContext& context) const
+{
+    Value lhs_value = lhs()->evaluate(context);
+    Value rhs_value = rhs()->evaluate(context);
+    if (context.result && context.result->is_error())
+        return Value::null();
+    Value ret(SQLType::Boolean);
+    switch (type()) {
+    case BinaryOperator::Equals:
+        ret = (lhs_value.compare(rhs_value) == 0);
+        return ret;
+    case BinaryOperator::NotEquals:
+        ret = (lhs_value.compare(rhs_value) != 0);
+        return ret;
+    case BinaryOperator::LessThan:
+        ret = (lhs_value.compare(rhs_value) < 0);
+        return ret;
+    case BinaryOperator::LessThanEquals:
+        ret = (lhs_value.compare(rhs_value) <= 0);
+        return ret;
+    case BinaryOperator::GreaterThan:
+        ret = (lhs_value.compare(rhs_value) > 0);
+        return ret;
+    case BinaryOperator::GreaterThanEquals:
+        ret = (lhs_value.compare(rhs_value) >= 0);
+        return ret;
+    case BinaryOperator::And: {
+        auto lhs_bool = lhs_value.to_bool();
+        auto rhs_bool = rhs_value.to_bool();
+        if (!lhs_bool.has_value() || !rhs_bool.has_value())
+            return evaluation_error(context, SQLErrorCode::BooleanOperatorTypeMismatch, binary_operator_name(type()));
+        ret = (lhs_bool.value() && rhs_bool.value());
+        return ret;
+    }
+    case BinaryOperator::Or: {
+        auto lhs_bool = lhs_value.to_bool();
+        auto rhs_bool = rhs_value.to_bool();
+        if (!lhs_bool.has_value() || !rhs_bool.has_value())
+            return evaluation_error(context, SQLErrorCode::BooleanOperatorTypeMismatch, binary_operator_name(type()));
+        ret = (lhs_bool.value() || rhs_bool.value());
+        return ret;
+    }
+    default:
+        // TODO: Implement the arithmetic and bitwise operators.
+        return evaluation_error(context, SQLErrorCode::NotYetImplemented,
+            String::formatted("Operator '{}'", binary_operator_name(type())));
+    }
+}
+
+Value ColumnNameExpression::evaluate(ExecutionContext& context) const
+{
+    if (!context.current_row.has(column_name()))
+        return evaluation_error(context, SQLErrorCode::ColumnDoesNotExist, column_name());
+    return context.current_row[column_name()];
+}
+
 }
@@ -35,6 +35,8 @@ RefPtr<SQLResult> Insert::execute(ExecutionContext& context) const
             }
         }
         auto row_value = row_expr.evaluate(context);
+        if (context.result && context.result->is_error())
+            return context.result;
         VERIFY(row_value.type() == SQLType::Tuple);
         auto values = row_value.to_vector().value();
         for (auto ix = 0u; ix < values.size(); ix++) {
@@ -512,6 +512,9 @@ RefPtr<Expression> Parser::parse_literal_value_expression()
     if (consume_if(TokenType::Null))
         return create_ast_node<NullLiteral>();
 
+    if (consume_if(TokenType::Placeholder))
+        return create_ast_node<Placeholder>(m_parser_state.m_number_of_placeholders++);
+
     return {};
 }
 
@@ -569,63 +572,85 @@ RefPtr<Expression> Parser::parse_unary_operator_expression()
     return {};
 }
 
-RefPtr<Expression> Parser::parse_binary_operator_expression(NonnullRefPtr<Expression> lhs)
-{
-    if (consume_if(TokenType::DoublePipe))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Concatenate, move(lhs), parse_expression());
-
-    if (consume_if(TokenType::Asterisk))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Multiplication, move(lhs), parse_expression());
-
-    if (consume_if(TokenType::Divide))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Division, move(lhs), parse_expression());
-
-    if (consume_if(TokenType::Modulus))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Modulo, move(lhs), parse_expression());
-
-    if (consume_if(TokenType::Plus))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Plus, move(lhs), parse_expression());
-
-    if (consume_if(TokenType::Minus))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Minus, move(lhs), parse_expression());
-
-    if (consume_if(TokenType::ShiftLeft))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::ShiftLeft, move(lhs), parse_expression());
-
-    if (consume_if(TokenType::ShiftRight))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::ShiftRight, move(lhs), parse_expression());
-
-    if (consume_if(TokenType::Ampersand))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::BitwiseAnd, move(lhs), parse_expression());
-
-    if (consume_if(TokenType::Pipe))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::BitwiseOr, move(lhs), parse_expression());
-
-    if (consume_if(TokenType::LessThan))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::LessThan, move(lhs), parse_expression());
-
-    if (consume_if(TokenType::LessThanEquals))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::LessThanEquals, move(lhs), parse_expression());
+struct BinaryOperatorInfo {
+    BinaryOperator type;
+    int precedence;
+};
 
-    if (consume_if(TokenType::GreaterThan))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::GreaterThan, move(lhs), parse_expression());
-
-    if (consume_if(TokenType::GreaterThanEquals))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::GreaterThanEquals, move(lhs), parse_expression());
-
-    if (consume_if(TokenType::Equals) || consume_if(TokenType::EqualsEquals))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Equals, move(lhs), parse_expression());
+static Optional<BinaryOperatorInfo> binary_operator_for(TokenType token_type)
+{
+    switch (token_type) {
+    case TokenType::DoublePipe:
+        return BinaryOperatorInfo { BinaryOperator::Concatenate, 7 };
+    case TokenType::Asterisk:
+        return BinaryOperatorInfo { BinaryOperator::Multiplication, 6 };
+    case TokenType::Divide:
+        return BinaryOperatorInfo { BinaryOperator::Division, 6 };
+    case TokenType::Modulus:
+        return BinaryOperatorInfo { BinaryOperator::Modulo, 6 };
+    case TokenType::Plus:
+        return BinaryOperatorInfo { BinaryOperator::Plus, 5 };
+    case TokenType::Minus:
+        return BinaryOperatorInfo { BinaryOperator::Minus, 5 };
+    case TokenType::ShiftLeft:
+        return BinaryOperatorInfo { BinaryOperator::ShiftLeft, 4 };
+    case TokenType::ShiftRight:
+        return BinaryOperatorInfo { BinaryOperator::ShiftRight, 4 };
+    case TokenType::Ampersand:
+        return BinaryOperatorInfo { BinaryOperator::BitwiseAnd, 4 };
+    case TokenType::Pipe:
+        return BinaryOperatorInfo { BinaryOperator::BitwiseOr, 4 };
+    case TokenType::LessThan:
+        return BinaryOperatorInfo { BinaryOperator::LessThan, 3 };
+    case TokenType::LessThanEquals:
+        return BinaryOperatorInfo { BinaryOperator::LessThanEquals, 3 };
+    case TokenType::GreaterThan:
+        return BinaryOperatorInfo { BinaryOperator::GreaterThan, 3 };
+    case TokenType::GreaterThanEquals:
+        return BinaryOperatorInfo { BinaryOperator::GreaterThanEquals, 3 };
+    case TokenType::Equals:
+    case TokenType::EqualsEquals:
+        return BinaryOperatorInfo { BinaryOperator::Equals, 2 };
+    case TokenType::NotEquals1:
+    case TokenType::NotEquals2:
+        return BinaryOperatorInfo { BinaryOperator::NotEquals, 2 };
+    case TokenType::And:
+        return BinaryOperatorInfo { BinaryOperator::And, 1 };
+    case TokenType::Or:
+        return BinaryOperatorInfo { BinaryOperator::Or, 0 };
+    default:
+        return {};
+    }
+}
 
-    if (consume_if(TokenType::NotEquals1) || consume_if(TokenType::NotEquals2))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::NotEquals, move(lhs), parse_expression());
+RefPtr<Expression> Parser::parse_binary_operator_expression(NonnullRefPtr<Expression> lhs)
+{
+    if (!binary_operator_for(m_parser_state.m_token.type()).has_value())
+        return {};
+    return parse_binary_operator_expression(move(lhs), 0);
+}
 
-    if (consume_if(TokenType::And))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::And, move(lhs), parse_expression());
+// Precedence climbing, so that 'a = 1 OR b = 2 AND c = 3' groups as
+// 'a = 1 OR ((b = 2) AND (c = 3))' instead of nesting everything into the
+// right-hand side of the first operator.
+NonnullRefPtr<Expression> Parser::parse_binary_operator_expression(NonnullRefPtr<Expression> lhs, int min_precedence)
+{
+    for (;;) {
+        auto operator_info = binary_operator_for(m_parser_state.m_token.type());
+        if (!operator_info.has_value() || operator_info->precedence < min_precedence)
+            return lhs;
+        consume();
 
-    if (consume_if(TokenType::Or))
-        return create_ast_node<BinaryOperatorExpression>(BinaryOperator::Or, move(lhs), parse_expression());
+        auto rhs = parse_primary_expression();
+        for (;;) {
+            auto next_operator_info = binary_operator_for(m_parser_state.m_token.type());
+            if (!next_operator_info.has_value() || next_operator_info->precedence <= operator_info->precedence)
+                break;
+            rhs = parse_binary_operator_expression(move(rhs), next_operator_info->precedence);
+        }
 
-    return {};
+        lhs = create_ast_node<BinaryOperatorExpression>(operator_info->type, move(lhs), move(rhs));
+    }
 }
 
 RefPtr<Expression> Parser::parse_chained_expression()
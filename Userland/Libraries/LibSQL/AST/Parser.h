@@ -38,6 +38,7 @@ public:
 
     bool has_errors() const { return m_parser_state.m_errors.size(); }
     const Vector<Error>& errors() const { return m_parser_state.m_errors; }
+    size_t number_of_placeholders() const { return m_parser_state.m_number_of_placeholders; }
 
 protected:
     NonnullRefPtr<Expression> parse_expression(); // Protected for unit testing.
@@ -51,6 +52,7 @@ private:
         Vector<Error> m_errors;
         size_t m_current_expression_depth { 0 };
         size_t m_current_subquery_depth { 0 };
+        size_t m_number_of_placeholders { 0 };
     };
 
     NonnullRefPtr<Statement> parse_statement();
@@ -72,6 +74,7 @@ private:
     RefPtr<Expression> parse_column_name_expression(String with_parsed_identifier = {}, bool with_parsed_period = false);
     RefPtr<Expression> parse_unary_operator_expression();
     RefPtr<Expression> parse_binary_operator_expression(NonnullRefPtr<Expression> lhs);
+    NonnullRefPtr<Expression> parse_binary_operator_expression(NonnullRefPtr<Expression> lhs, int min_precedence);
     RefPtr<Expression> parse_chained_expression();
     RefPtr<Expression> parse_cast_expression();
     RefPtr<Expression> parse_case_expression();
@@ -22,6 +22,19 @@ RefPtr<SQLResult> Select::execute(ExecutionContext& context) const
             NonnullRefPtr<TupleDescriptor> descriptor = table->to_tuple_descriptor();
             context.result = SQLResult::construct();
             for (auto& row : context.database->select_all(*table)) {
+                context.current_row = row;
+
+                // The predicate is evaluated against each row as it streams
+                // by, so rows that don't match are dropped before they are
+                // materialized into the result set.
+                if (where_clause()) {
+                    auto where_result = where_clause()->evaluate(context).to_bool();
+                    if (context.result->is_error())
+                        return context.result;
+                    if (!where_result.has_value() || !where_result.value())
+                        continue;
+                }
+
                 Tuple tuple(descriptor);
                 for (auto ix = 0u; ix < descriptor->size(); ix++) {
                     tuple[ix] = row[ix];
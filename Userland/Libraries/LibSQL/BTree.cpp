@@ -5,8 +5,10 @@
  */
 
 #include <AK/Format.h>
+#include <AK/QuickSort.h>
 #include <LibSQL/BTree.h>
 #include <LibSQL/Meta.h>
+#include <LibSQL/Serializer.h>
 
 namespace SQL {
 
@@ -70,6 +72,134 @@ bool BTree::insert(Key const& key)
     return m_root->insert(key);
 }
 
+/**
+ * Build the tree bottom-up from a batch of keys. The keys are sorted and
+ * then packed into leaf nodes from left to right; keys that don't fit in
+ * the current node are promoted to the next level up, which is built the
+ * same way once the level below it is complete. This writes every node
+ * exactly once and packs nodes (almost) full, whereas repeated insert()
+ * calls rewrite the path to the leaf for every key and leave nodes
+ * half-empty after splits.
+ *
+ * The tree must be empty; on a non-empty tree this degrades to ordinary
+ * one-at-a-time insertion. Returns false if the batch contains duplicate
+ * keys and the tree does not allow duplicates.
+ */
+bool BTree::bulk_load(Vector<Key> keys)
+{
+    if (!m_root)
+        initialize_root();
+    VERIFY(m_root);
+    if (m_root->size() > 0 || !m_root->is_leaf()) {
+        auto all_inserted = true;
+        for (auto& key : keys)
+            all_inserted = m_root->insert(key) && all_inserted;
+        return all_inserted;
+    }
+    if (keys.is_empty())
+        return true;
+
+    quick_sort(keys, [](Key const& key1, Key const& key2) { return key1 < key2; });
+    if (!duplicates_allowed()) {
+        for (auto ix = 1u; ix < keys.size(); ix++) {
+            if (keys[ix - 1] == keys[ix])
+                return false;
+        }
+    }
+
+    Vector<u32> children;
+    auto is_leaf_level = true;
+    u32 root_pointer = 0;
+
+    // The empty root's block would be orphaned by the rebuild, and the heap
+    // cannot have holes in it. Recycle its pointer for the first new node:
+    u32 recycled_pointer = m_root->pointer();
+    auto next_pointer = [&]() {
+        if (recycled_pointer) {
+            auto pointer = recycled_pointer;
+            recycled_pointer = 0;
+            return pointer;
+        }
+        return new_record_pointer();
+    };
+
+    while (!root_pointer) {
+        Vector<Key> promoted;
+        Vector<u32> node_pointers;
+
+        // Only the current node and its closed left sibling are held in
+        // memory; everything else is written out as soon as it's full.
+        OwnPtr<TreeNode> open;
+        OwnPtr<TreeNode> pending;
+
+        auto make_node = [&](u32 leftmost_child) -> NonnullOwnPtr<TreeNode> {
+            if (is_leaf_level)
+                return make<TreeNode>(*this, nullptr, next_pointer());
+            auto node = make<TreeNode>(*this, next_pointer());
+            node->m_is_leaf = false;
+            node->m_down.empend(node.ptr(), leftmost_child);
+            return node;
+        };
+
+        open = make_node(is_leaf_level ? 0 : children[0]);
+        for (auto ix = 0u; ix < keys.size(); ix++) {
+            auto& key = keys[ix];
+            auto right_child = is_leaf_level ? 0 : children[ix + 1];
+
+            // Keep the serialized node within BLOCKSIZE, accounting for
+            // the down pointer both before and after the new key:
+            if (open->size() > 0 && open->length() + 2 * sizeof(u32) + key.length() > BLOCKSIZE) {
+                // The node is full. Close it, promote this key to the
+                // next level up, and open a fresh node to its right:
+                if (pending)
+                    serializer().serialize_and_write(*pending, pending->pointer());
+                node_pointers.append(open->pointer());
+                pending = move(open);
+                promoted.append(key);
+                open = make_node(right_child);
+            } else {
+                open->m_entries.append(key);
+                open->m_down.empend(open.ptr(), right_child);
+            }
+        }
+
+        if (open->size() == 0 && pending) {
+            // The last key of the level was promoted, leaving the
+            // rightmost node empty. Demote it again, and promote the
+            // last entry of its left sibling in its place:
+            VERIFY(pending->size() >= 2);
+            auto demoted = promoted.take_last();
+            promoted.append(pending->m_entries.take_last());
+            auto stolen_down = pending->m_down.take_last().pointer();
+            auto old_leftmost = open->m_down.take_first().pointer();
+            open->m_down.empend(open.ptr(), stolen_down);
+            open->m_entries.append(demoted);
+            open->m_down.empend(open.ptr(), old_leftmost);
+        }
+        if (pending)
+            serializer().serialize_and_write(*pending, pending->pointer());
+        node_pointers.append(open->pointer());
+        serializer().serialize_and_write(*open, open->pointer());
+
+        if (node_pointers.size() == 1) {
+            root_pointer = node_pointers.first();
+        } else {
+            // Build the next level up from the keys that didn't fit:
+            VERIFY(promoted.size() == node_pointers.size() - 1);
+            keys = move(promoted);
+            children = move(node_pointers);
+            is_leaf_level = false;
+        }
+    }
+
+    set_pointer(root_pointer);
+    m_root = nullptr;
+    initialize_root();
+    if (on_new_root)
+        on_new_root();
+    return true;
+}
+
 bool BTree::update_key_pointer(Key const& key)
 {
     if (!m_root)
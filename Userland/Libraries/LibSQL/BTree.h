@@ -101,6 +101,7 @@ public:
 
     u32 root() const { return (m_root) ? m_root->pointer() : 0; }
     bool insert(Key const&);
+    bool bulk_load(Vector<Key>);
     bool update_key_pointer(Key const&);
     Optional<u32> get(Key&);
     BTreeIterator find(Key const& key);
@@ -12,6 +12,7 @@
 #include <LibSQL/Serializer.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 namespace SQL {
 
@@ -37,18 +38,93 @@ Heap::Heap(String file_name)
         VERIFY_NOT_REACHED();
     }
     m_file = file_or_error.value();
-    if (file_size > 0)
+
+    auto wal_or_error = Core::File::open(String::formatted("{}.wal", name()), Core::OpenMode::ReadWrite);
+    if (wal_or_error.is_error()) {
+        warnln("Couldn't open '{}.wal': {}", name(), wal_or_error.error());
+        VERIFY_NOT_REACHED();
+    }
+    m_wal_file = wal_or_error.value();
+    auto replayed_anything = replay_wal();
+
+    if (file_size > 0 || replayed_anything)
         read_zero_block();
     else
         initialize_zero_block();
     dbgln_if(SQL_DEBUG, "Heap file {} opened. Size = {}", file_name, size());
 }
 
+// The write-ahead log is a sequence of transactions. Each transaction is a
+// run of page records (4-byte block number followed by the BLOCKSIZE bytes
+// of the block) terminated by a commit record: the sentinel block number
+// 0xffffffff followed by the number of pages in the transaction. Anything
+// after the last complete transaction is a torn write from a crash and is
+// thrown away.
+constexpr static u32 WAL_COMMIT_SENTINEL = 0xffffffff;
+constexpr static size_t WAL_CHECKPOINT_THRESHOLD = 1 * MiB;
+
+bool Heap::replay_wal()
+{
+    size_t valid_end = 0;
+    size_t offset = 0;
+    Vector<u32> pending_blocks;
+    Vector<ByteBuffer> pending_data;
+    bool replayed_anything = false;
+
+    for (;;) {
+        auto block_bytes = m_wal_file->read(sizeof(u32));
+        if (block_bytes.size() < sizeof(u32))
+            break;
+        offset += sizeof(u32);
+        u32 block;
+        memcpy(&block, block_bytes.data(), sizeof(u32));
+        if (block == WAL_COMMIT_SENTINEL) {
+            auto count_bytes = m_wal_file->read(sizeof(u32));
+            if (count_bytes.size() < sizeof(u32))
+                break;
+            offset += sizeof(u32);
+            u32 count;
+            memcpy(&count, count_bytes.data(), sizeof(u32));
+            if (count != pending_blocks.size())
+                break;
+            for (size_t ix = 0; ix < pending_blocks.size(); ix++) {
+                dbgln_if(SQL_DEBUG, "Replaying block {} from WAL", pending_blocks[ix]);
+                cache_block(pending_blocks[ix], pending_data[ix], CachedBlock::State::Logged);
+                if (pending_blocks[ix] >= m_next_block)
+                    m_next_block = pending_blocks[ix] + 1;
+                replayed_anything = true;
+            }
+            pending_blocks.clear();
+            pending_data.clear();
+            valid_end = offset;
+            continue;
+        }
+        auto data = m_wal_file->read(BLOCKSIZE);
+        if (data.size() < BLOCKSIZE)
+            break;
+        offset += BLOCKSIZE;
+        pending_blocks.append(block);
+        pending_data.append(move(data));
+    }
+
+    // Discard the torn tail (if any) and position the log for appending.
+    if (ftruncate(m_wal_file->fd(), valid_end) < 0)
+        VERIFY_NOT_REACHED();
+    VERIFY(m_wal_file->seek(valid_end));
+    m_wal_size = valid_end;
+    return replayed_anything;
+}
+
 Result<ByteBuffer, String> Heap::read_block(u32 block)
 {
-    auto buffer_or_empty = m_write_ahead_log.get(block);
-    if (buffer_or_empty.has_value())
-        return buffer_or_empty.value();
+    // Note: HashMap::get() would hand out a copy of the cached block, so
+    // this uses find() to be able to update the page in place.
+    if (auto it = m_block_cache.find(block); it != m_block_cache.end()) {
+        dbgln_if(SQL_DEBUG, "Read heap block {} from cache", block);
+        it->value.last_used = ++m_cache_use_counter;
+        // FIXME: Handle an OOM failure here.
+        return ByteBuffer::copy(it->value.data).release_value();
+    }
 
     VERIFY(block < m_next_block);
     dbgln_if(SQL_DEBUG, "Read heap block {}", block);
@@ -62,9 +138,102 @@ Result<ByteBuffer, String> Heap::read_block(u32 block)
         *ret.offset_pointer(2), *ret.offset_pointer(3),
         *ret.offset_pointer(4), *ret.offset_pointer(5),
         *ret.offset_pointer(6), *ret.offset_pointer(7));
+    cache_block(block, ret, CachedBlock::State::Clean);
     return ret;
 }
 
+ReadonlyBytes Heap::pin_block(u32 block)
+{
+    // Like read_block(), but instead of copying the page out of the buffer
+    // pool this hands out a view of the cached page itself and keeps it
+    // pinned (and thus un-evictable) until the matching unpin_block() call.
+    if (auto it = m_block_cache.find(block); it != m_block_cache.end()) {
+        dbgln_if(SQL_DEBUG, "Pin heap block {} from cache", block);
+        it->value.last_used = ++m_cache_use_counter;
+        it->value.pin_count++;
+        return it->value.data.bytes();
+    }
+    auto buffer_or_error = read_block(block);
+    if (buffer_or_error.is_error())
+        VERIFY_NOT_REACHED();
+    auto it = m_block_cache.find(block);
+    VERIFY(it != m_block_cache.end());
+    it->value.pin_count++;
+    return it->value.data.bytes();
+}
+
+void Heap::unpin_block(u32 block)
+{
+    auto it = m_block_cache.find(block);
+    VERIFY(it != m_block_cache.end());
+    VERIFY(it->value.pin_count > 0);
+    it->value.pin_count--;
+}
+
+void Heap::cache_block(u32 block, ByteBuffer const& buffer, CachedBlock::State state)
+{
+    Optional<CachedBlock::State> existing_state;
+    u32 existing_pin_count = 0;
+    if (auto it = m_block_cache.find(block); it != m_block_cache.end()) {
+        existing_state = it->value.state;
+        existing_pin_count = it->value.pin_count;
+    }
+    while (!existing_state.has_value() && m_block_cache.size() >= m_cache_block_limit) {
+        // If every cached block is pinned the pool is allowed to exceed its
+        // budget; the next checkpoint will make the pages evictable again.
+        if (!evict_one_clean_block())
+            break;
+    }
+
+    CachedBlock cached;
+    // Cached pages are zero-padded to full blocks so they can go into the
+    // write-ahead log and the heap file verbatim. Oversized buffers are
+    // tolerated here because the B-Tree writes out nodes before splitting
+    // them; they have to be replaced by a fitting version before the next
+    // flush, which insists on exact block sizes.
+    // FIXME: Handle an OOM failure here.
+    cached.data = ByteBuffer::create_zeroed(max((size_t)BLOCKSIZE, buffer.size())).release_value();
+    memcpy(cached.data.data(), buffer.data(), buffer.size());
+    cached.last_used = ++m_cache_use_counter;
+    cached.pin_count = existing_pin_count;
+    cached.state = state;
+    // A page that's already dirty or logged must not silently become clean.
+    if (existing_state.has_value() && existing_state.value() != CachedBlock::State::Clean && state == CachedBlock::State::Clean)
+        cached.state = existing_state.value();
+    m_block_cache.set(block, move(cached));
+}
+
+bool Heap::evict_one_clean_block()
+{
+    Optional<u32> victim;
+    u64 victim_last_used = 0;
+    for (auto& entry : m_block_cache) {
+        if (entry.value.state != CachedBlock::State::Clean)
+            continue;
+        if (entry.value.pin_count > 0)
+            continue;
+        if (!victim.has_value() || entry.value.last_used < victim_last_used) {
+            victim = entry.key;
+            victim_last_used = entry.value.last_used;
+        }
+    }
+    if (!victim.has_value())
+        return false;
+    dbgln_if(SQL_DEBUG, "Evicting heap block {} from cache", victim.value());
+    m_block_cache.remove(victim.value());
+    return true;
+}
+
+void Heap::set_cache_block_limit(size_t limit)
+{
+    VERIFY(limit > 0);
+    m_cache_block_limit = limit;
+    while (m_block_cache.size() > m_cache_block_limit) {
+        if (!evict_one_clean_block())
+            break;
+    }
+}
+
 bool Heap::write_block(u32 block, ByteBuffer& buffer)
 {
     dbgln_if(SQL_DEBUG, "write_block({}): m_next_block {}", block, m_next_block);
@@ -133,20 +302,79 @@ u32 Heap::new_record_pointer()
 void Heap::flush()
 {
     Vector<u32> blocks;
-    for (auto& wal_entry : m_write_ahead_log) {
-        blocks.append(wal_entry.key);
+    for (auto& cache_entry : m_block_cache) {
+        if (cache_entry.value.state == CachedBlock::State::Dirty)
+            blocks.append(cache_entry.key);
     }
+    if (blocks.is_empty())
+        return;
     quick_sort(blocks);
+
+    // Group commit: every page dirtied since the last flush goes into the
+    // log as a single sequential append, followed by one fsync() for the
+    // whole batch.
     for (auto& block : blocks) {
-        auto buffer_or_empty = m_write_ahead_log.get(block);
-        if (buffer_or_empty->is_empty()) {
+        auto& cached = m_block_cache.find(block)->value;
+        if (cached.data.is_empty()) {
             VERIFY_NOT_REACHED();
         }
-        dbgln_if(SQL_DEBUG, "Flushing block {} to {}", block, name());
-        write_block(block, buffer_or_empty.value());
+        dbgln_if(SQL_DEBUG, "Logging block {} to {}.wal", block, name());
+        VERIFY(cached.data.size() == BLOCKSIZE);
+        if (!m_wal_file->write((u8 const*)&block, sizeof(u32))
+            || !m_wal_file->write(cached.data.data(), BLOCKSIZE))
+            VERIFY_NOT_REACHED();
+        m_wal_size += sizeof(u32) + BLOCKSIZE;
+    }
+    u32 count = blocks.size();
+    if (!m_wal_file->write((u8 const*)&WAL_COMMIT_SENTINEL, sizeof(u32))
+        || !m_wal_file->write((u8 const*)&count, sizeof(u32)))
+        VERIFY_NOT_REACHED();
+    m_wal_size += 2 * sizeof(u32);
+    if (fsync(m_wal_file->fd()) < 0)
+        VERIFY_NOT_REACHED();
+
+    for (auto& block : blocks)
+        m_block_cache.find(block)->value.state = CachedBlock::State::Logged;
+    dbgln_if(SQL_DEBUG, "WAL flushed, {} blocks committed. Heap size = {}", blocks.size(), size());
+
+    if (m_wal_size >= WAL_CHECKPOINT_THRESHOLD)
+        checkpoint();
+}
+
+void Heap::checkpoint()
+{
+    // Commit anything still outstanding so the log is the single source of
+    // truth for every page we're about to copy into the heap file.
+    flush();
+
+    Vector<u32> blocks;
+    for (auto& cache_entry : m_block_cache) {
+        if (cache_entry.value.state == CachedBlock::State::Logged)
+            blocks.append(cache_entry.key);
+    }
+    if (blocks.is_empty() && m_wal_size == 0)
+        return;
+    quick_sort(blocks);
+    for (auto& block : blocks) {
+        auto& cached = m_block_cache.find(block)->value;
+        dbgln_if(SQL_DEBUG, "Checkpointing block {} to {}", block, name());
+        write_block(block, cached.data);
+        cached.state = CachedBlock::State::Clean;
+    }
+    if (fsync(m_file->fd()) < 0)
+        VERIFY_NOT_REACHED();
+
+    // Everything is safely in the heap file; the log can start over.
+    if (ftruncate(m_wal_file->fd(), 0) < 0)
+        VERIFY_NOT_REACHED();
+    VERIFY(m_wal_file->seek(0));
+    m_wal_size = 0;
+
+    while (m_block_cache.size() > m_cache_block_limit) {
+        if (!evict_one_clean_block())
+            break;
     }
-    m_write_ahead_log.clear();
-    dbgln_if(SQL_DEBUG, "WAL flushed. Heap size = {}", size());
+    dbgln_if(SQL_DEBUG, "Checkpointed {} blocks into {}", blocks.size(), name());
 }
 
 constexpr static const char* FILE_ID = "SerenitySQL ";
@@ -26,6 +26,22 @@ constexpr static u32 BLOCKSIZE = 1024;
  * A Heap can be thought of the backing storage of a single database. It's
  * assumed that a single SQL database is backed by a single Heap.
  *
+ * Blocks are cached in an in-memory buffer pool so B-Tree traversals don't
+ * re-read the same interior nodes from disk over and over. Clean pages are
+ * evicted in least-recently-used order once the pool exceeds its block
+ * budget; dirty pages are pinned in the pool until they have been written
+ * back to the heap file. Readers can pin a page too (pin_block()) and
+ * deserialize straight out of the pool without copying it first; a pinned
+ * page is never evicted until its last pin is dropped.
+ *
+ * Durability comes from a write-ahead log next to the heap file. flush()
+ * appends all pages dirtied since the last flush to the log as one
+ * transaction and syncs it with a single fsync(), instead of doing a
+ * synchronous random write per page. The logged pages are copied into the
+ * heap file ("checkpointed") once the log grows past a threshold, and the
+ * log is replayed on open so a crash between commit and checkpoint loses
+ * nothing.
+ *
  * Currently only B-Trees and tuple stores are implemented.
  */
 class Heap : public Core::Object {
@@ -33,14 +49,23 @@ class Heap : public Core::Object {
 
 public:
     explicit Heap(String);
-    virtual ~Heap() override { flush(); }
+    virtual ~Heap() override
+    {
+        flush();
+        checkpoint();
+    }
 
     u32 size() const { return m_end_of_file; }
     Result<ByteBuffer, String> read_block(u32);
+    ReadonlyBytes pin_block(u32);
+    void unpin_block(u32);
     bool write_block(u32, ByteBuffer&);
     u32 new_record_pointer();
     [[nodiscard]] bool has_block(u32 block) const { return block < size(); }
 
+    size_t cache_block_limit() const { return m_cache_block_limit; }
+    void set_cache_block_limit(size_t);
+
     u32 schemas_root() const { return m_schemas_root; }
 
     void set_schemas_root(u32 root)
@@ -87,18 +112,41 @@ public:
             *buffer.offset_pointer(2), *buffer.offset_pointer(3),
             *buffer.offset_pointer(4), *buffer.offset_pointer(5),
             *buffer.offset_pointer(6), *buffer.offset_pointer(7));
-        m_write_ahead_log.set(block, buffer);
+        cache_block(block, buffer, CachedBlock::State::Dirty);
     }
 
     void flush();
+    void checkpoint();
 
 private:
+    struct CachedBlock {
+        // Clean pages match the heap file and can be evicted. Dirty pages
+        // have not been committed anywhere yet. Logged pages are safe in the
+        // write-ahead log but not yet in the heap file, so they must stay
+        // pinned until the next checkpoint.
+        enum class State {
+            Clean,
+            Dirty,
+            Logged,
+        };
+
+        ByteBuffer data;
+        u64 last_used { 0 };
+        u32 pin_count { 0 };
+        State state { State::Clean };
+    };
+
     bool seek_block(u32);
     void read_zero_block();
     void initialize_zero_block();
     void update_zero_block();
+    void cache_block(u32 block, ByteBuffer const&, CachedBlock::State);
+    bool evict_one_clean_block();
+    bool replay_wal();
 
     RefPtr<Core::File> m_file;
+    RefPtr<Core::File> m_wal_file;
+    size_t m_wal_size { 0 };
     u32 m_free_list { 0 };
     u32 m_next_block { 1 };
     u32 m_end_of_file { 1 };
@@ -107,7 +155,9 @@ private:
     u32 m_table_columns_root { 0 };
     u32 m_version { 0x00000001 };
     Array<u32, 16> m_user_values;
-    HashMap<u32, ByteBuffer> m_write_ahead_log;
+    HashMap<u32, CachedBlock> m_block_cache;
+    size_t m_cache_block_limit { 512 };
+    u64 m_cache_use_counter { 0 };
 };
 
 }
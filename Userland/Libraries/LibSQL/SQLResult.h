@@ -52,7 +52,11 @@ constexpr char const* command_tag(SQLCommand command)
     S(ColumnDoesNotExist, "Column '{}' does not exist")           \
     S(TableExists, "Table '{}' already exist")                    \
     S(InvalidType, "Invalid type '{}'")                           \
-    S(InvalidDatabaseName, "Invalid database name '{}'")
+    S(InvalidDatabaseName, "Invalid database name '{}'")          \
+    S(InvalidNumberOfPlaceholderValues, "Number of values does not match number of placeholders") \
+    S(NotYetImplemented, "{} is not yet implemented")              \
+    S(NumericOperatorTypeMismatch, "Cannot apply '{}' operator to non-numeric operands") \
+    S(BooleanOperatorTypeMismatch, "Cannot apply '{}' operator to non-boolean operands")
 
 enum class SQLErrorCode {
 #undef __ENUMERATE_SQL_ERROR
@@ -106,6 +110,15 @@ public:
         m_result_set.append(tuple);
     }
 
+    // Expression evaluation has no other way to report a problem with
+    // client-supplied SQL than flagging it on the in-progress result.
+    void set_error(SQLErrorCode code, String argument = {})
+    {
+        m_error = { code, move(argument) };
+    }
+
+    bool is_error() const { return m_error.code != SQLErrorCode::NoError; }
+
     SQLCommand command() const { return m_command; }
     int updated() const { return m_update_count; }
     int inserted() const { return m_insert_count; }
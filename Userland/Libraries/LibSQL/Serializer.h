@@ -26,18 +26,43 @@ public:
     {
     }
 
+    // Copies share the heap but not the transient (de)serialization state;
+    // in particular a copy must not inherit the original's pinned page.
+    Serializer(Serializer const& other)
+        : m_heap(other.m_heap)
+    {
+    }
+
+    Serializer& operator=(Serializer const& other)
+    {
+        if (this != &other) {
+            reset();
+            m_heap = other.m_heap;
+        }
+        return *this;
+    }
+
+    ~Serializer()
+    {
+        release_pinned_block();
+    }
+
     void get_block(u32 pointer)
     {
         VERIFY(m_heap.ptr() != nullptr);
-        auto buffer_or_error = m_heap->read_block(pointer);
-        if (buffer_or_error.is_error())
-            VERIFY_NOT_REACHED();
-        m_buffer = buffer_or_error.value();
+        // Deserialization reads straight out of the pinned buffer pool page
+        // instead of a private copy of it, so scans touch each byte once.
+        release_pinned_block();
+        m_read_view = m_heap->pin_block(pointer);
+        m_pinned_block = pointer;
+        m_has_pinned_block = true;
+        m_buffer.clear();
         m_current_offset = 0;
     }
 
     void reset()
     {
+        release_pinned_block();
         m_buffer.clear();
         m_current_offset = 0;
     }
@@ -147,13 +172,24 @@ private:
 
     u8 const* read(size_t sz)
     {
-        auto buffer_ptr = m_buffer.offset_pointer((int)m_current_offset);
+        auto buffer_ptr = m_has_pinned_block
+            ? m_read_view.offset_pointer(m_current_offset)
+            : m_buffer.offset_pointer((int)m_current_offset);
         if constexpr (SQL_DEBUG)
             dump(buffer_ptr, sz, "<= (in)");
         m_current_offset += sz;
         return buffer_ptr;
     }
 
+    void release_pinned_block()
+    {
+        if (!m_has_pinned_block)
+            return;
+        m_heap->unpin_block(m_pinned_block);
+        m_has_pinned_block = false;
+        m_read_view = {};
+    }
+
     static void dump(u8 const* ptr, size_t sz, String const& prefix)
     {
         StringBuilder builder;
@@ -169,6 +205,9 @@ private:
     }
 
     ByteBuffer m_buffer {};
+    ReadonlyBytes m_read_view {};
+    u32 m_pinned_block { 0 };
+    bool m_has_pinned_block { false };
     size_t m_current_offset { 0 };
     RefPtr<Heap> m_heap { nullptr };
 };
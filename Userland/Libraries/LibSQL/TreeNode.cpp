@@ -116,6 +116,10 @@ void TreeNode::deserialize(Serializer& serializer)
     auto nodes = serializer.deserialize<u32>();
     dbgln_if(SQL_DEBUG, "Deserializing node. Size {}", nodes);
     if (nodes > 0) {
+        // The constructor may have seeded us with an empty leaf's down
+        // pointer; the serialized node knows whether it's a leaf or not:
+        m_entries.clear();
+        m_down.clear();
         for (u32 i = 0; i < nodes; i++) {
             auto left = serializer.deserialize<u32>();
             dbgln_if(SQL_DEBUG, "Down[{}] {}", i, left);
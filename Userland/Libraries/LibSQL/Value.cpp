@@ -4,6 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
 #include <LibSQL/Serializer.h>
 #include <LibSQL/Value.h>
 #include <math.h>
@@ -302,7 +305,8 @@ Value& Value::operator=(Vector<Value> const& vector)
 
 size_t Value::length() const
 {
-    return m_impl.visit([&](auto& impl) { return impl.length(); });
+    // One byte for the type/null flags, plus the value payload itself:
+    return sizeof(u8) + m_impl.visit([&](auto& impl) { return impl.length(); });
 }
 
 u32 Value::hash() const
@@ -986,3 +990,80 @@ bool ArrayImpl::validate(BaseTypeImpl const& impl)
 }
 
 }
+
+namespace IPC {
+
+bool encode(Encoder& encoder, SQL::Value const& value)
+{
+    encoder << (u8)value.type() << value.is_null();
+    if (value.is_null())
+        return true;
+    switch (value.type()) {
+    case SQL::SQLType::Null:
+        break;
+    case SQL::SQLType::Text:
+        encoder << value.to_string();
+        break;
+    case SQL::SQLType::Integer:
+        encoder << (i32)value.to_int().value();
+        break;
+    case SQL::SQLType::Float:
+        encoder << bit_cast<u64>(value.to_double().value());
+        break;
+    case SQL::SQLType::Boolean:
+        encoder << value.to_bool().value();
+        break;
+    default:
+        // Tuples and arrays don't travel over the wire.
+        return false;
+    }
+    return true;
+}
+
+bool decode(Decoder& decoder, SQL::Value& value)
+{
+    u8 type;
+    bool is_null;
+    if (!decoder.decode(type) || !decoder.decode(is_null))
+        return false;
+    value = SQL::Value((SQL::SQLType)type);
+    if (is_null)
+        return true;
+    switch ((SQL::SQLType)type) {
+    case SQL::SQLType::Null:
+        break;
+    case SQL::SQLType::Text: {
+        String text;
+        if (!decoder.decode(text))
+            return false;
+        value = text;
+        break;
+    }
+    case SQL::SQLType::Integer: {
+        i32 int_value;
+        if (!decoder.decode(int_value))
+            return false;
+        value = (int)int_value;
+        break;
+    }
+    case SQL::SQLType::Float: {
+        u64 bits;
+        if (!decoder.decode(bits))
+            return false;
+        value = bit_cast<double>(bits);
+        break;
+    }
+    case SQL::SQLType::Boolean: {
+        bool bool_value;
+        if (!decoder.decode(bool_value))
+            return false;
+        value = bool_value;
+        break;
+    }
+    default:
+        return false;
+    }
+    return true;
+}
+
+}
@@ -11,6 +11,7 @@
 #include <AK/ScopeGuard.h>
 #include <AK/String.h>
 #include <AK/Variant.h>
+#include <LibIPC/Forward.h>
 #include <LibSQL/Forward.h>
 #include <LibSQL/TupleDescriptor.h>
 #include <LibSQL/Type.h>
@@ -128,3 +129,10 @@ private:
 };
 
 }
+
+namespace IPC {
+
+bool encode(Encoder&, SQL::Value const&);
+bool decode(Decoder&, SQL::Value&);
+
+}
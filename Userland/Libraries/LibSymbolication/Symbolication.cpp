@@ -5,16 +5,246 @@
  */
 
 #include <AK/Checked.h>
+#include <AK/Demangle.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonValue.h>
 #include <AK/MappedFile.h>
+#include <AK/QuickSort.h>
+#include <AK/StringHash.h>
 #include <LibCore/File.h>
 #include <LibDebug/DebugInfo.h>
 #include <LibSymbolication/Symbolication.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace Symbolication {
 
+// An on-disk, per-binary address->symbol index.
+//
+// Parsing and sorting the full ELF symbol table of a big binary (notably
+// Kernel.debug) takes long enough that symbolicating a backtrace is visibly
+// slow, and the work is identical across processes and runs as long as the
+// binary doesn't change. The index is built once per binary, persisted under
+// /tmp/.symbol-index, and mmap()ed read-only thereafter, so a lookup is just
+// a binary search over pre-sorted entries.
+class SymbolIndex {
+public:
+    static OwnPtr<SymbolIndex> load_or_build(String const& binary_path);
+
+    struct LookupResult {
+        StringView name;
+        u32 offset { 0 };
+    };
+    Optional<LookupResult> lookup(FlatPtr address) const;
+
+private:
+    // On-disk layout: Header, then symbol_count Entries sorted by address,
+    // then the string table. The header records the identity of the binary
+    // the index was built from; any mismatch means rebuild.
+    struct Header {
+        u32 magic;
+        u32 version;
+        u32 symbol_count;
+        u32 string_table_size;
+        u64 device;
+        u64 inode;
+        u64 mtime_seconds;
+        u64 file_size;
+    };
+
+    struct Entry {
+        u64 address;
+        u32 size;
+        u32 name_offset;
+    };
+
+    static constexpr u32 index_magic = 0x53594d49; // "SYMI"
+    static constexpr u32 index_version = 1;
+    static constexpr char const* index_directory = "/tmp/.symbol-index";
+
+    explicit SymbolIndex(NonnullRefPtr<MappedFile> file)
+        : m_file(move(file))
+    {
+    }
+
+    static String index_path_for(String const& binary_path);
+    static bool build(String const& binary_path, String const& index_path, struct stat const& binary_stat);
+    bool validate(struct stat const& binary_stat);
+
+    NonnullRefPtr<MappedFile> m_file;
+    Entry const* m_entries { nullptr };
+    u32 m_entry_count { 0 };
+    char const* m_string_table { nullptr };
+    u32 m_string_table_size { 0 };
+};
+
+String SymbolIndex::index_path_for(String const& binary_path)
+{
+    return String::formatted("{}/{:08x}", index_directory, string_hash(binary_path.characters(), binary_path.length()));
+}
+
+bool SymbolIndex::validate(struct stat const& binary_stat)
+{
+    auto bytes = m_file->bytes();
+    if (bytes.size() < sizeof(Header))
+        return false;
+
+    auto const& header = *reinterpret_cast<Header const*>(bytes.data());
+    if (header.magic != index_magic || header.version != index_version)
+        return false;
+    if (header.device != (u64)binary_stat.st_dev || header.inode != (u64)binary_stat.st_ino)
+        return false;
+    if (header.mtime_seconds != (u64)binary_stat.st_mtime || header.file_size != (u64)binary_stat.st_size)
+        return false;
+    if (bytes.size() != sizeof(Header) + header.symbol_count * sizeof(Entry) + header.string_table_size)
+        return false;
+
+    auto const* entries = reinterpret_cast<Entry const*>(bytes.data() + sizeof(Header));
+    auto const* string_table = reinterpret_cast<char const*>(entries + header.symbol_count);
+    if (header.string_table_size == 0 || string_table[header.string_table_size - 1] != '\0')
+        return false;
+    for (u32 i = 0; i < header.symbol_count; ++i) {
+        if (entries[i].name_offset >= header.string_table_size)
+            return false;
+        if (i > 0 && entries[i - 1].address > entries[i].address)
+            return false;
+    }
+
+    m_entries = entries;
+    m_entry_count = header.symbol_count;
+    m_string_table = string_table;
+    m_string_table_size = header.string_table_size;
+    return true;
+}
+
+static bool write_fully(int fd, void const* data, size_t size)
+{
+    auto const* bytes = static_cast<u8 const*>(data);
+    while (size > 0) {
+        ssize_t nwritten = write(fd, bytes, size);
+        if (nwritten < 0)
+            return false;
+        bytes += nwritten;
+        size -= nwritten;
+    }
+    return true;
+}
+
+bool SymbolIndex::build(String const& binary_path, String const& index_path, struct stat const& binary_stat)
+{
+    auto mapped_file = MappedFile::map(binary_path);
+    if (mapped_file.is_error())
+        return false;
+    ELF::Image image(mapped_file.value()->bytes());
+    if (!image.is_valid())
+        return false;
+
+    struct UnsortedEntry {
+        FlatPtr address;
+        u32 size;
+        StringView name;
+    };
+    Vector<UnsortedEntry> unsorted_entries;
+    unsorted_entries.ensure_capacity(image.symbol_count());
+    image.for_each_symbol([&unsorted_entries](auto const& symbol) {
+        unsorted_entries.append({ symbol.value(), (u32)symbol.size(), symbol.name() });
+    });
+    quick_sort(unsorted_entries, [](auto const& a, auto const& b) {
+        return a.address < b.address;
+    });
+
+    Vector<char> string_table;
+    Vector<Entry> entries;
+    entries.ensure_capacity(unsorted_entries.size());
+    for (auto const& unsorted : unsorted_entries) {
+        u32 name_offset = string_table.size();
+        string_table.append(unsorted.name.characters_without_null_termination(), unsorted.name.length());
+        string_table.append('\0');
+        entries.append({ unsorted.address, unsorted.size, name_offset });
+    }
+
+    Header header {
+        index_magic,
+        index_version,
+        static_cast<u32>(entries.size()),
+        static_cast<u32>(string_table.size()),
+        (u64)binary_stat.st_dev,
+        (u64)binary_stat.st_ino,
+        (u64)binary_stat.st_mtime,
+        (u64)binary_stat.st_size,
+    };
+
+    if (mkdir(index_directory, 0755) < 0 && errno != EEXIST)
+        return false;
+
+    // Write a private temporary file and rename() it into place, so readers
+    // only ever see complete indices.
+    auto temporary_path = String::formatted("{}.{}", index_path, getpid());
+    int fd = ::open(temporary_path.characters(), O_WRONLY | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+        return false;
+
+    bool success = write_fully(fd, &header, sizeof(header))
+        && write_fully(fd, entries.data(), entries.size() * sizeof(Entry))
+        && write_fully(fd, string_table.data(), string_table.size());
+    close(fd);
+
+    if (success && ::rename(temporary_path.characters(), index_path.characters()) == 0)
+        return true;
+
+    unlink(temporary_path.characters());
+    return false;
+}
+
+OwnPtr<SymbolIndex> SymbolIndex::load_or_build(String const& binary_path)
+{
+    struct stat binary_stat;
+    if (stat(binary_path.characters(), &binary_stat) < 0)
+        return {};
+
+    auto index_path = index_path_for(binary_path);
+
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        struct stat index_stat;
+        // /tmp is world-writable, so only trust an index we would have
+        // written ourselves.
+        if (lstat(index_path.characters(), &index_stat) == 0
+            && S_ISREG(index_stat.st_mode) && index_stat.st_uid == geteuid() && (index_stat.st_mode & 022) == 0) {
+            auto mapped_index = MappedFile::map(index_path);
+            if (!mapped_index.is_error()) {
+                auto index = adopt_own(*new SymbolIndex(mapped_index.release_value()));
+                if (index->validate(binary_stat))
+                    return index;
+            }
+        }
+        if (attempt == 0 && !build(binary_path, index_path, binary_stat))
+            return {};
+    }
+    return {};
+}
+
+Optional<SymbolIndex::LookupResult> SymbolIndex::lookup(FlatPtr address) const
+{
+    // Find the last entry at or below the address, mirroring what
+    // ELF::Image::symbolicate() does with its in-memory sorted table.
+    size_t low = 0;
+    size_t high = m_entry_count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (m_entries[middle].address <= address)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low == 0)
+        return {};
+    auto const& entry = m_entries[low - 1];
+    return LookupResult { { m_string_table + entry.name_offset }, static_cast<u32>(address - entry.address) };
+}
+
 struct CachedELF {
     NonnullRefPtr<MappedFile> mapped_file;
     NonnullOwnPtr<Debug::DebugInfo> debug_info;
@@ -59,8 +289,39 @@ Optional<FlatPtr> kernel_base()
     return s_kernel_base;
 }
 
-Optional<Symbol> symbolicate(String const& path, FlatPtr address)
+static HashMap<String, OwnPtr<SymbolIndex>> s_indices;
+
+static SymbolIndex* symbol_index_for(String const& path)
+{
+    if (auto it = s_indices.find(path); it != s_indices.end())
+        return it->value.ptr();
+    auto index = SymbolIndex::load_or_build(path);
+    auto* raw_index = index.ptr();
+    s_indices.set(path, move(index));
+    return raw_index;
+}
+
+Optional<Symbol> symbolicate(String const& path, FlatPtr address, IncludeSourcePosition include_source_position)
 {
+    // Fast path: answer pure address->name queries from the on-disk index
+    // without mapping the binary or touching its DWARF data at all.
+    if (include_source_position == IncludeSourcePosition::No) {
+        if (auto* index = symbol_index_for(path)) {
+            String name = "??";
+            u32 offset = 0;
+            if (auto result = index->lookup(address); result.has_value()) {
+                name = demangle(result->name);
+                offset = result->offset;
+            }
+            return Symbol {
+                .address = address,
+                .name = move(name),
+                .offset = offset,
+                .source_positions = {},
+            };
+        }
+    }
+
     if (!s_cache.contains(path)) {
         auto mapped_file = MappedFile::map(path);
         if (mapped_file.is_error()) {
@@ -74,7 +335,7 @@ Optional<Symbol> symbolicate(String const& path, FlatPtr address)
             s_cache.set(path, {});
             {};
         }
-        auto cached_elf = make<CachedELF>(mapped_file.release_value(), make<Debug::DebugInfo>(*elf), move(elf));
+        auto cached_elf = make<CachedELF>(mapped_file.release_value(), make<Debug::DebugInfo>(*elf, String {}, 0, path), move(elf));
         s_cache.set(path, move(cached_elf));
     }
 
@@ -86,7 +347,19 @@ Optional<Symbol> symbolicate(String const& path, FlatPtr address)
         return {};
 
     u32 offset = 0;
-    auto symbol = cached_elf->debug_info->elf().symbolicate(address, &offset);
+    String symbol;
+    // Even when DWARF data is needed for source positions, the symbol name
+    // itself still comes cheaper out of the index.
+    if (auto* index = symbol_index_for(path)) {
+        if (auto result = index->lookup(address); result.has_value()) {
+            symbol = demangle(result->name);
+            offset = result->offset;
+        } else {
+            symbol = "??";
+        }
+    } else {
+        symbol = cached_elf->debug_info->elf().symbolicate(address, &offset);
+    }
     auto source_position_with_inlines = cached_elf->debug_info->get_source_position_with_inlines(address);
 
     Vector<Debug::DebugInfo::SourcePosition> positions;
@@ -18,8 +18,13 @@ struct Symbol {
     Vector<Debug::DebugInfo::SourcePosition> source_positions;
 };
 
+enum class IncludeSourcePosition {
+    Yes,
+    No,
+};
+
 Optional<FlatPtr> kernel_base();
 Vector<Symbol> symbolicate_thread(pid_t pid, pid_t tid);
-Optional<Symbol> symbolicate(String const& path, FlatPtr address);
+Optional<Symbol> symbolicate(String const& path, FlatPtr address, IncludeSourcePosition = IncludeSourcePosition::Yes);
 
 }
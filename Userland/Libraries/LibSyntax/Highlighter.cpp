@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/NumericLimits.h>
 #include <LibGUI/TextEditor.h>
 #include <LibGfx/Color.h>
 #include <LibSyntax/Highlighter.h>
@@ -102,6 +103,107 @@ void Highlighter::highlight_matching_token_pair()
     }
 }
 
+void Highlighter::rehighlight_incrementally(Palette const& palette, size_t first_changed_line, size_t last_changed_line, int line_delta)
+{
+    auto& document = m_client->get_document();
+    size_t line_count = document.line_count();
+    if (m_client->spans().is_empty() || line_count == 0 || first_changed_line >= line_count || last_changed_line >= line_count) {
+        rehighlight(palette);
+        return;
+    }
+    auto old_spans = m_client->spans();
+
+    // A multi-line token (e.g. a block comment) may begin above the edited
+    // lines, so walk upwards until no span crosses the start of the restart
+    // line. Spans are ordered by start position, so a single reverse pass
+    // finds the lowest restart line.
+    size_t restart_line = first_changed_line;
+    for (size_t i = old_spans.size(); i > 0; --i) {
+        auto& range = old_spans[i - 1].range;
+        if (range.start().line() < restart_line && range.end().line() >= restart_line)
+            restart_line = range.start().line();
+    }
+
+    auto spans_cross_line_start = [](Vector<GUI::TextDocumentSpan> const& spans, size_t line) {
+        for (auto& span : spans) {
+            if (span.range.start().line() >= line)
+                break;
+            if (span.range.end().line() >= line)
+                return true;
+        }
+        return false;
+    };
+
+    // Re-lex a window of lines starting at the restart line. If the old and
+    // new tokenizations haven't converged on a common line boundary by the
+    // end of the window, double it and try again; in the worst case (say, an
+    // unbalanced block comment opener) this degenerates into a full re-lex.
+    size_t changed_line_count = last_changed_line - first_changed_line + 1;
+    size_t window_line_count = max(static_cast<size_t>(256), changed_line_count * 2);
+
+    for (;;) {
+        size_t window_end_line = min(line_count, restart_line + window_line_count); // Exclusive.
+        auto window_text = document.text_in_range({ { restart_line, 0 }, { window_end_line - 1, document.line(window_end_line - 1).length() } });
+        ProxyHighlighterClient proxy_client(*m_client, { restart_line, 0 }, 0, window_text);
+        auto* outer_client = m_client;
+        m_client = &proxy_client;
+        rehighlight(palette);
+        m_client = outer_client;
+        auto new_spans = proxy_client.corrected_spans();
+
+        auto merge_spans = [&](size_t new_span_end_line, size_t old_span_resume_line) {
+            Vector<GUI::TextDocumentSpan> merged_spans;
+            merged_spans.ensure_capacity(old_spans.size() + new_spans.size());
+            for (auto& span : old_spans) {
+                if (span.range.start().line() >= restart_line)
+                    break;
+                merged_spans.append(span);
+            }
+            for (auto& span : new_spans) {
+                if (span.range.start().line() >= new_span_end_line)
+                    break;
+                merged_spans.append(span);
+            }
+            for (auto& span : old_spans) {
+                if (span.range.start().line() < old_span_resume_line)
+                    continue;
+                auto shifted_span = span;
+                shifted_span.range.start().set_line(span.range.start().line() + line_delta);
+                shifted_span.range.end().set_line(span.range.end().line() + line_delta);
+                merged_spans.append(shifted_span);
+            }
+            m_client->do_set_spans(move(merged_spans));
+            m_client->do_update();
+        };
+
+        if (window_end_line == line_count) {
+            // The window reached the end of the document, so everything from
+            // the restart line onwards has been re-lexed and no old spans
+            // remain to splice back in.
+            merge_spans(line_count, NumericLimits<size_t>::max());
+            return;
+        }
+
+        for (size_t line = last_changed_line + 1; line < window_end_line; ++line) {
+            if (line_delta > 0 && line < static_cast<size_t>(line_delta))
+                continue;
+            size_t old_line = line - line_delta;
+            // The tokenizations have converged once both the old and the new
+            // spans have a token boundary at the start of the same line; from
+            // there on the old spans remain valid, merely shifted by the
+            // number of lines the edit added or removed.
+            if (spans_cross_line_start(new_spans, line))
+                continue;
+            if (spans_cross_line_start(old_spans, old_line))
+                continue;
+            merge_spans(line, old_line);
+            return;
+        }
+
+        window_line_count *= 2;
+    }
+}
+
 void Highlighter::attach(HighlighterClient& client)
 {
     VERIFY(!m_client);
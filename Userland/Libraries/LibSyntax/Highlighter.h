@@ -39,6 +39,13 @@ public:
 
     virtual Language language() const = 0;
     virtual void rehighlight(const Palette&) = 0;
+    // Re-highlights only the part of the document affected by an edit to the
+    // given line range, splicing the result into the existing spans instead of
+    // re-tokenizing the whole document. Lines are in post-change coordinates;
+    // line_delta is the number of lines the edit added (negative for
+    // removals). Falls back to a full rehighlight() when there are no
+    // existing spans to splice against.
+    void rehighlight_incrementally(const Palette&, size_t first_changed_line, size_t last_changed_line, int line_delta);
     virtual void highlight_matching_token_pair();
 
     virtual bool is_identifier(u64) const { return false; };
@@ -70,7 +70,9 @@ enum class CipherSuite {
     ECDHE_ECDSA_WITH_AES_256_CCM_8 = 0xC0AF,
 
     // RFC 7905 - ChaCha20-Poly1305 Cipher Suites
+    ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256 = 0xCCA8,
     ECDHE_ECDSA_WITH_CHACHA20_POLY1305_SHA256 = 0xCCA9,
+    DHE_RSA_WITH_CHACHA20_POLY1305_SHA256 = 0xCCAA,
     ECDHE_PSK_WITH_CHACHA20_POLY1305_SHA256 = 0xCCAC,
     DHE_PSK_WITH_CHACHA20_POLY1305 = 0xCCAD,
 
@@ -164,6 +166,7 @@ enum class CipherAlgorithm {
     AES_128_CCM_8,
     AES_256_CBC,
     AES_256_GCM,
+    CHACHA20_POLY1305,
 };
 
 constexpr size_t cipher_key_size(CipherAlgorithm algorithm)
@@ -176,6 +179,7 @@ constexpr size_t cipher_key_size(CipherAlgorithm algorithm)
         return 128;
     case CipherAlgorithm::AES_256_CBC:
     case CipherAlgorithm::AES_256_GCM:
+    case CipherAlgorithm::CHACHA20_POLY1305:
         return 256;
     case CipherAlgorithm::Invalid:
     default:
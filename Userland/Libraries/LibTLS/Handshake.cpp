@@ -34,6 +34,14 @@ ByteBuffer TLSv12::build_hello()
     builder.append(version);
     builder.append(m_context.local_random, sizeof(m_context.local_random));
 
+    // If we have a cached session for this host, offer to resume it.
+    if (!m_context.is_server && !m_context.session_id_size) {
+        if (auto session = session_for_host(m_context.extensions.SNI); session.has_value()) {
+            memcpy(m_context.session_id, session->id, session->id_size);
+            m_context.session_id_size = session->id_size;
+        }
+    }
+
     builder.append(m_context.session_id_size);
     if (m_context.session_id_size)
         builder.append(m_context.session_id, m_context.session_id_size);
@@ -193,7 +201,6 @@ ssize_t TLSv12::handle_handshake_finished(ReadonlyBytes buffer, WritePacketStage
 
     // TODO: Compare Hashes
     dbgln_if(TLS_DEBUG, "FIXME: handle_handshake_finished :: Check message validity");
-    m_context.connection_status = ConnectionStatus::Established;
 
     if (m_handshake_timeout_timer) {
         // Disable the handshake timeout timer as handshake has been established.
@@ -202,6 +209,29 @@ ssize_t TLSv12::handle_handshake_finished(ReadonlyBytes buffer, WritePacketStage
         m_handshake_timeout_timer = nullptr;
     }
 
+    if (m_context.session_resumed) {
+        // Abbreviated handshake: the server's Finished comes first, and we
+        // reply with our own ChangeCipherSpec and Finished once this message
+        // has been added to the handshake hash. The connection only becomes
+        // established after those have been queued, so that nothing the user
+        // writes can sneak out ahead of them.
+        write_packets = WritePacketStage::Finished;
+        return index + size;
+    }
+
+    m_context.connection_status = ConnectionStatus::Established;
+
+    // Remember this session; a future connection to the same host can offer
+    // to resume it and skip the key exchange entirely.
+    if (m_context.session_id_size && !m_context.extensions.SNI.is_empty()) {
+        CachedSession session;
+        memcpy(session.id, m_context.session_id, m_context.session_id_size);
+        session.id_size = m_context.session_id_size;
+        session.cipher = m_context.cipher;
+        session.master_key = m_context.master_key;
+        store_session_for_host(m_context.extensions.SNI, move(session));
+    }
+
     if (on_tls_ready_to_write)
         on_tls_ready_to_write(*this);
 
@@ -523,6 +553,8 @@ ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
                 write_packet(packet);
             }
             m_context.connection_status = ConnectionStatus::Established;
+            if (on_tls_ready_to_write)
+                on_tls_ready_to_write(*this);
             break;
         }
         payload_size++;
@@ -56,6 +56,14 @@ ssize_t TLSv12::handle_server_hello(ReadonlyBytes buffer, WritePacketStage& writ
     }
 
     if (session_length && session_length <= 32) {
+        // If the server echoed the session id we offered, it has agreed to
+        // resume that session and both sides skip straight to
+        // ChangeCipherSpec+Finished with the cached master secret.
+        if (session_length == m_context.session_id_size
+            && memcmp(m_context.session_id, buffer.offset_pointer(res), session_length) == 0) {
+            m_context.session_resumed = true;
+            dbgln_if(TLS_DEBUG, "Server agreed to resume the cached session");
+        }
         memcpy(m_context.session_id, buffer.offset_pointer(res), session_length);
         m_context.session_id_size = session_length;
         if constexpr (TLS_DEBUG) {
@@ -177,6 +185,23 @@ ssize_t TLSv12::handle_server_hello(ReadonlyBytes buffer, WritePacketStage& writ
         }
     }
 
+    if (m_context.session_resumed) {
+        auto session = session_for_host(m_context.extensions.SNI);
+        if (!session.has_value() || session->cipher != cipher) {
+            // The cached session was evicted under us, or the server picked a
+            // different cipher for a session it claims to resume.
+            dbgln("Session resumption failed: cached session is gone or does not match");
+            return (i8)Error::NotSafe;
+        }
+
+        // There will be no key exchange; reuse the cached master secret and
+        // expect the server's ChangeCipherSpec and Finished next.
+        m_context.master_key = session->master_key;
+        if (!expand_key())
+            return (i8)Error::NotSafe;
+        m_context.connection_status = ConnectionStatus::KeyExchange;
+    }
+
     return res;
 }
 
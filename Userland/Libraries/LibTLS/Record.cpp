@@ -83,6 +83,13 @@ void TLSv12::update_packet(ByteBuffer& packet)
                     padding = 0;
                     mac_size = 0; // AEAD provides its own authentication scheme.
                 },
+                [&](Crypto::Cipher::ChaCha20Poly1305&) {
+                    VERIFY(is_aead());
+                    // A stream cipher; no block alignment, no padding, and the
+                    // tag is accounted for separately below.
+                    padding = 0;
+                    mac_size = 0;
+                },
                 [&](Crypto::Cipher::AESCipher::CBCMode& cbc) {
                     VERIFY(!is_aead());
                     block_size = cbc.cipher().block_size();
@@ -168,6 +175,55 @@ void TLSv12::update_packet(ByteBuffer& packet)
 
                         VERIFY(header_size + 8 + length + 16 == ct.size());
                     },
+                    [&](Crypto::Cipher::ChaCha20Poly1305& chacha) {
+                        VERIFY(is_aead());
+                        // We need enough space for a header, the data and a tag;
+                        // the nonce is entirely implicit (RFC 7905 section 2).
+                        auto ct_buffer_result = ByteBuffer::create_uninitialized(length + header_size + 16);
+                        if (!ct_buffer_result.has_value()) {
+                            dbgln("LibTLS: Failed to allocate enough memory for the ciphertext");
+                            VERIFY_NOT_REACHED();
+                        }
+                        ct = ct_buffer_result.release_value();
+
+                        // copy the header over
+                        ct.overwrite(0, packet.data(), header_size - 2);
+
+                        // AEAD AAD (13)
+                        // Seq. no (8)
+                        // content type (1)
+                        // version (2)
+                        // length (2)
+                        u8 aad[13];
+                        Bytes aad_bytes { aad, 13 };
+                        OutputMemoryStream aad_stream { aad_bytes };
+
+                        u64 seq_no = AK::convert_between_host_and_network_endian(m_context.local_sequence_number);
+                        u16 len = AK::convert_between_host_and_network_endian((u16)(packet.size() - header_size));
+
+                        aad_stream.write({ &seq_no, sizeof(seq_no) });
+                        aad_stream.write(packet.bytes().slice(0, 3)); // content-type + version
+                        aad_stream.write({ &len, sizeof(len) });      // length
+                        VERIFY(aad_stream.is_end());
+
+                        // The per-record nonce is the 12-byte IV from the key
+                        // block XORed with the padded sequence number.
+                        u8 nonce[12];
+                        Bytes nonce_bytes { nonce, 12 };
+                        Bytes { m_context.crypto.local_aead_iv, 12 }.copy_to(nonce_bytes);
+                        for (size_t i = 0; i < 8; ++i)
+                            nonce[4 + i] ^= ((const u8*)&seq_no)[i];
+
+                        // Write the encrypted data and the tag
+                        chacha.encrypt(
+                            packet.bytes().slice(header_size, length),
+                            ct.bytes().slice(header_size, length),
+                            nonce_bytes,
+                            aad_bytes,
+                            ct.bytes().slice(header_size + length, 16));
+
+                        VERIFY(header_size + length + 16 == ct.size());
+                    },
                     [&](Crypto::Cipher::AESCipher::CBCMode& cbc) {
                         VERIFY(!is_aead());
                         // We need enough space for a header, iv_length bytes of IV and whatever the packet contains
@@ -300,7 +356,7 @@ ByteBuffer TLSv12::hmac_message(const ReadonlyBytes& buf, const Optional<Readonl
     return mac_result.release_value();
 }
 
-ssize_t TLSv12::handle_message(ReadonlyBytes buffer)
+ssize_t TLSv12::handle_message(Bytes buffer)
 {
     auto res { 5ll };
     size_t header_size = res;
@@ -359,14 +415,7 @@ ssize_t TLSv12::handle_message(ReadonlyBytes buffer)
                 }
 
                 auto packet_length = length - iv_length() - 16;
-                auto payload = plain;
-                auto decrypted_result = ByteBuffer::create_uninitialized(packet_length);
-                if (!decrypted_result.has_value()) {
-                    dbgln("Failed to allocate memory for the packet");
-                    return_value = Error::DecryptionFailed;
-                    return;
-                }
-                decrypted = decrypted_result.release_value();
+                auto payload = buffer.slice(header_size, length);
 
                 // AEAD AAD (13)
                 // Seq. no (8)
@@ -386,7 +435,6 @@ ssize_t TLSv12::handle_message(ReadonlyBytes buffer)
                 VERIFY(aad_stream.is_end());
 
                 auto nonce = payload.slice(0, iv_length());
-                payload = payload.slice(iv_length());
 
                 // AEAD IV (12)
                 // IV (4)
@@ -399,12 +447,16 @@ ssize_t TLSv12::handle_message(ReadonlyBytes buffer)
                 nonce.copy_to(iv_bytes.slice(4));
                 memset(iv_bytes.offset(12), 0, 4);
 
-                auto ciphertext = payload.slice(0, payload.size() - 16);
-                auto tag = payload.slice(ciphertext.size());
+                auto ciphertext = payload.slice(iv_length(), packet_length);
+                auto tag = payload.slice(iv_length() + packet_length, 16);
 
+                // Decrypt right over the ciphertext in the record buffer: GCM
+                // authenticates the ciphertext before the CTR pass, and CTR
+                // reads each block before overwriting it, so no separate
+                // plaintext buffer is needed.
                 auto consistency = gcm.decrypt(
                     ciphertext,
-                    decrypted,
+                    ciphertext,
                     iv_bytes,
                     aad_bytes,
                     tag);
@@ -418,12 +470,75 @@ ssize_t TLSv12::handle_message(ReadonlyBytes buffer)
                     return;
                 }
 
-                plain = decrypted;
+                plain = ciphertext;
+            },
+            [&](Crypto::Cipher::ChaCha20Poly1305& chacha) {
+                VERIFY(is_aead());
+                if (length < 16) {
+                    dbgln("Invalid packet length");
+                    auto packet = build_alert(true, (u8)AlertDescription::DecryptError);
+                    write_packet(packet);
+                    return_value = Error::BrokenPacket;
+                    return;
+                }
+
+                auto packet_length = length - 16;
+                auto payload = buffer.slice(header_size, length);
+
+                // AEAD AAD (13)
+                // Seq. no (8)
+                // content type (1)
+                // version (2)
+                // length (2)
+                u8 aad[13];
+                Bytes aad_bytes { aad, 13 };
+                OutputMemoryStream aad_stream { aad_bytes };
+
+                u64 seq_no = AK::convert_between_host_and_network_endian(m_context.remote_sequence_number);
+                u16 len = AK::convert_between_host_and_network_endian((u16)packet_length);
+
+                aad_stream.write({ &seq_no, sizeof(seq_no) });      // Sequence number
+                aad_stream.write(buffer.slice(0, header_size - 2)); // content-type + version
+                aad_stream.write({ &len, sizeof(u16) });
+                VERIFY(aad_stream.is_end());
+
+                // The nonce is not on the wire; it's the 12-byte IV from the
+                // key block XORed with the padded sequence number.
+                u8 nonce[12];
+                Bytes nonce_bytes { nonce, 12 };
+                Bytes { m_context.crypto.remote_aead_iv, 12 }.copy_to(nonce_bytes);
+                for (size_t i = 0; i < 8; ++i)
+                    nonce[4 + i] ^= ((const u8*)&seq_no)[i];
+
+                auto ciphertext = payload.slice(0, packet_length);
+                auto tag = payload.slice(packet_length, 16);
+
+                // The tag is verified before any decryption happens, so
+                // decrypting in place is fine here too.
+                auto consistency = chacha.decrypt(
+                    ciphertext,
+                    ciphertext,
+                    nonce_bytes,
+                    aad_bytes,
+                    tag);
+
+                if (consistency != Crypto::VerificationConsistency::Consistent) {
+                    dbgln("integrity check failed (tag length {})", tag.size());
+                    auto packet = build_alert(true, (u8)AlertDescription::BadRecordMAC);
+                    write_packet(packet);
+
+                    return_value = Error::IntegrityCheckFailed;
+                    return;
+                }
+
+                plain = ciphertext;
             },
             [&](Crypto::Cipher::AESCipher::CBCMode& cbc) {
                 VERIFY(!is_aead());
                 auto iv_size = iv_length();
 
+                // Note: Unlike GCM, CBC can't decrypt in place; the mode keeps
+                //       its chaining IV pointing into the input buffer.
                 auto decrypted_result = cbc.create_aligned_buffer(length - iv_size);
                 if (!decrypted_result.has_value()) {
                     dbgln("Failed to allocate memory for the packet");
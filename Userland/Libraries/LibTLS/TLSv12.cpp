@@ -6,6 +6,7 @@
 
 #include <AK/Debug.h>
 #include <AK/Endian.h>
+#include <AK/HashMap.h>
 #include <LibCore/ConfigFile.h>
 #include <LibCore/DateTime.h>
 #include <LibCore/File.h>
@@ -22,6 +23,29 @@
 
 namespace TLS {
 
+// Sessions are cached per-process; anything that connects to the same host
+// repeatedly (e.g. RequestServer) gets abbreviated handshakes for free.
+static HashMap<String, CachedSession> s_session_cache;
+
+Optional<CachedSession> TLSv12::session_for_host(const String& host)
+{
+    if (host.is_empty())
+        return {};
+    return s_session_cache.get(host);
+}
+
+void TLSv12::store_session_for_host(const String& host, CachedSession session)
+{
+    if (host.is_empty() || !session.id_size)
+        return;
+    s_session_cache.set(host, move(session));
+}
+
+void TLSv12::forget_session_for_host(const String& host)
+{
+    s_session_cache.remove(host);
+}
+
 void TLSv12::consume(ReadonlyBytes record)
 {
     if (m_context.critical_error) {
@@ -84,6 +108,10 @@ void TLSv12::consume(ReadonlyBytes record)
         }
     }
     if (m_context.error_code != Error::NoError && m_context.error_code != Error::NeedMoreData) {
+        // If this was a resumption attempt gone wrong, forget the cached
+        // session so the next connection falls back to a full handshake.
+        if (m_context.session_resumed && m_context.connection_status != ConnectionStatus::Established)
+            forget_session_for_host(m_context.extensions.SNI);
         dbgln("consume error: {}", (i8)m_context.error_code);
         m_context.message_buffer.clear();
         return;
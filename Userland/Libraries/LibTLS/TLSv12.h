@@ -15,6 +15,7 @@
 #include <LibCrypto/Authentication/HMAC.h>
 #include <LibCrypto/BigInt/UnsignedBigInteger.h>
 #include <LibCrypto/Cipher/AES.h>
+#include <LibCrypto/Cipher/ChaCha20Poly1305.h>
 #include <LibCrypto/Hash/HashManager.h>
 #include <LibCrypto/PK/RSA.h>
 #include <LibTLS/CipherSuite.h>
@@ -164,7 +165,11 @@ enum ClientVerificationStaus {
 // 4 bytes of fixed IV, 8 random (nonce) bytes, 4 bytes for counter
 // GCM specifically asks us to transmit only the nonce, the counter is zero
 // and the fixed IV is derived from the premaster key.
-#define ENUMERATE_CIPHERS(C)                                                                                                                          \
+// ChaCha20-Poly1305 derives all 12 nonce bytes from the premaster key and
+// mixes in the sequence number per record, so nothing is transmitted at all.
+// The ciphers are listed in order of preference for the ClientHello.
+#define ENUMERATE_CIPHERS(C)                                                                                                                                  \
+    C(true, CipherSuite::DHE_RSA_WITH_CHACHA20_POLY1305_SHA256, KeyExchangeAlgorithm::DHE_RSA, CipherAlgorithm::CHACHA20_POLY1305, Crypto::Hash::SHA256, 12, true) \
     C(true, CipherSuite::RSA_WITH_AES_128_CBC_SHA, KeyExchangeAlgorithm::RSA, CipherAlgorithm::AES_128_CBC, Crypto::Hash::SHA1, 16, false)            \
     C(true, CipherSuite::RSA_WITH_AES_256_CBC_SHA, KeyExchangeAlgorithm::RSA, CipherAlgorithm::AES_256_CBC, Crypto::Hash::SHA1, 16, false)            \
     C(true, CipherSuite::RSA_WITH_AES_128_CBC_SHA256, KeyExchangeAlgorithm::RSA, CipherAlgorithm::AES_128_CBC, Crypto::Hash::SHA256, 16, false)       \
@@ -231,6 +236,16 @@ struct Options {
 #undef OPTION_WITH_DEFAULTS
 };
 
+// A successfully negotiated session, cached so that later connections to the
+// same host can offer to resume it and skip the whole key exchange (RFC 5246
+// section 7.3, "abbreviated handshake").
+struct CachedSession {
+    u8 id[32];
+    u8 id_size { 0 };
+    CipherSuite cipher;
+    ByteBuffer master_key;
+};
+
 struct Context {
     String to_string() const;
     bool verify() const;
@@ -244,6 +259,7 @@ struct Context {
     u8 local_random[32];
     u8 session_id[32];
     u8 session_id_size { 0 };
+    bool session_resumed { false };
     CipherSuite cipher;
     bool is_server { false };
     Vector<Certificate> certificates;
@@ -258,8 +274,10 @@ struct Context {
         u8 local_mac[32];
         u8 local_iv[16];
         u8 remote_iv[16];
-        u8 local_aead_iv[4];
-        u8 remote_aead_iv[4];
+        // GCM uses the first 4 bytes as the implicit part of the nonce;
+        // ChaCha20-Poly1305 uses all 12.
+        u8 local_aead_iv[12];
+        u8 remote_aead_iv[12];
     } crypto;
 
     Crypto::Hash::Manager handshake_hash;
@@ -421,7 +439,7 @@ private:
     ssize_t handle_server_hello_done(ReadonlyBytes);
     ssize_t handle_certificate_verify(ReadonlyBytes);
     ssize_t handle_handshake_payload(ReadonlyBytes);
-    ssize_t handle_message(ReadonlyBytes);
+    ssize_t handle_message(Bytes);
     ssize_t handle_random(ReadonlyBytes);
 
     size_t asn1_length(ReadonlyBytes, size_t* octets);
@@ -500,6 +518,10 @@ private:
 
     Optional<size_t> verify_chain_and_get_matching_certificate(const StringView& host) const;
 
+    static Optional<CachedSession> session_for_host(const String& host);
+    static void store_session_for_host(const String& host, CachedSession);
+    static void forget_session_for_host(const String& host);
+
     void try_disambiguate_error() const;
 
     Context m_context;
@@ -510,7 +532,8 @@ private:
     using CipherVariant = Variant<
         Empty,
         Crypto::Cipher::AESCipher::CBCMode,
-        Crypto::Cipher::AESCipher::GCMMode>;
+        Crypto::Cipher::AESCipher::GCMMode,
+        Crypto::Cipher::ChaCha20Poly1305>;
     CipherVariant m_cipher_local { Empty {} };
     CipherVariant m_cipher_remote { Empty {} };
 
@@ -8,7 +8,11 @@
 #include <LibTest/Macros.h> // intentionally first -- we redefine VERIFY and friends in here
 
 #include <AK/Function.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/NumericLimits.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
 #include <LibTest/TestSuite.h>
 #include <stdlib.h>
 #include <sys/time.h>
@@ -24,6 +28,11 @@ public:
     void restart() { gettimeofday(&m_started, nullptr); }
 
     u64 elapsed_milliseconds()
+    {
+        return elapsed_microseconds() / 1000;
+    }
+
+    u64 elapsed_microseconds()
     {
         struct timeval now = {};
         gettimeofday(&now, nullptr);
@@ -31,13 +40,25 @@ public:
         struct timeval delta = {};
         timersub(&now, &m_started, &delta);
 
-        return delta.tv_sec * 1000 + delta.tv_usec / 1000;
+        return delta.tv_sec * 1'000'000 + delta.tv_usec;
     }
 
 private:
     struct timeval m_started = {};
 };
 
+// The kernel's performance-event interface records profiling signposts rather
+// than exposing counter reads, so read the timestamp counter directly where
+// the architecture provides one.
+static u64 read_cycle_count()
+{
+#if defined(__i386__) || defined(__x86_64__)
+    return __builtin_ia32_rdtsc();
+#else
+    return 0;
+#endif
+}
+
 // Declared in Macros.h
 void current_test_case_did_fail()
 {
@@ -69,6 +90,8 @@ int TestSuite::main(const String& suite_name, int argc, char** argv)
 
     args_parser.add_option(do_tests_only, "Only run tests.", "tests", 0);
     args_parser.add_option(do_benchmarks_only, "Only run benchmarks.", "bench", 0);
+    args_parser.add_option(m_benchmark_repetitions, "Number of times to repeat each benchmark (default 1)", "bench-repeat", 0, "repetitions");
+    args_parser.add_option(m_results_json_path, "Write JSON results to the given path, for diffing between builds.", "json", 0, "path");
     args_parser.add_option(do_list_cases, "List available test cases.", "list", 0);
     args_parser.add_positional_argument(search_string, "Only run matching cases.", "pattern", Core::ArgsParser::Required::No);
     args_parser.parse(argc, argv);
@@ -117,30 +140,63 @@ int TestSuite::run(const NonnullRefPtrVector<TestCase>& tests)
     size_t test_failed_count = 0;
     size_t benchmark_count = 0;
     TestElapsedTimer global_timer;
+    JsonArray results;
 
     for (const auto& t : tests) {
         const auto test_type = t.is_benchmark() ? "benchmark" : "test";
+        const u64 repetitions = t.is_benchmark() ? m_benchmark_repetitions : 1;
 
         warnln("Running {} '{}'.", test_type, t.name());
         m_current_test_case_passed = true;
 
-        TestElapsedTimer timer;
-        t.func()();
-        const auto time = timer.elapsed_milliseconds();
+        u64 total_time = 0;
+        u64 min_time = NumericLimits<u64>::max();
+        u64 max_time = 0;
+        u64 total_cycles = 0;
+
+        for (u64 i = 0; i < repetitions; ++i) {
+            TestElapsedTimer timer;
+            const auto start_cycles = read_cycle_count();
+            t.func()();
+            total_cycles += read_cycle_count() - start_cycles;
+
+            const auto iteration_time = timer.elapsed_microseconds();
+            total_time += iteration_time;
+            min_time = min(min_time, iteration_time);
+            max_time = max(max_time, iteration_time);
+        }
 
-        dbgln("{} {} '{}' in {}ms", m_current_test_case_passed ? "Completed" : "Failed", test_type, t.name(), time);
+        if (repetitions != 1) {
+            dbgln("{} {} '{}' in {}ms ({} runs, min={}us, avg={}us, max={}us)",
+                m_current_test_case_passed ? "Completed" : "Failed", test_type, t.name(),
+                total_time / 1000, repetitions, min_time, total_time / repetitions, max_time);
+        } else {
+            dbgln("{} {} '{}' in {}ms", m_current_test_case_passed ? "Completed" : "Failed", test_type, t.name(), total_time / 1000);
+        }
 
         if (t.is_benchmark()) {
-            m_benchtime += time;
+            m_benchtime += total_time / 1000;
             benchmark_count++;
         } else {
-            m_testtime += time;
+            m_testtime += total_time / 1000;
             test_count++;
         }
 
         if (!m_current_test_case_passed) {
             test_failed_count++;
         }
+
+        JsonObject result;
+        result.set("name", t.name());
+        result.set("type", test_type);
+        result.set("passed", m_current_test_case_passed);
+        result.set("repetitions", repetitions);
+        result.set("total_microseconds", total_time);
+        result.set("min_microseconds", min_time);
+        result.set("average_microseconds", total_time / repetitions);
+        result.set("max_microseconds", max_time);
+        result.set("average_cycles", total_cycles / repetitions);
+        results.append(move(result));
     }
 
     dbgln("Finished {} tests and {} benchmarks in {}ms ({}ms tests, {}ms benchmarks, {}ms other).",
@@ -152,6 +208,19 @@ int TestSuite::run(const NonnullRefPtrVector<TestCase>& tests)
         global_timer.elapsed_milliseconds() - (m_testtime + m_benchtime));
     dbgln("Out of {} tests, {} passed and {} failed.", test_count, test_count - test_failed_count, test_failed_count);
 
+    if (!m_results_json_path.is_empty()) {
+        JsonObject suite_object;
+        suite_object.set("suite", m_suite_name);
+        suite_object.set("results", move(results));
+
+        auto file_or_error = Core::File::open(m_results_json_path, Core::OpenMode::WriteOnly | Core::OpenMode::Truncate);
+        if (file_or_error.is_error()) {
+            warnln("Unable to open '{}' for writing: {}", m_results_json_path, file_or_error.error());
+            return 1;
+        }
+        file_or_error.value()->write(suite_object.to_string());
+    }
+
     return (int)test_failed_count;
 }
 
@@ -51,6 +51,8 @@ private:
     u64 m_testtime = 0;
     u64 m_benchtime = 0;
     String m_suite_name;
+    unsigned m_benchmark_repetitions = 1;
+    String m_results_json_path;
     bool m_current_test_case_passed = true;
     Function<void()> m_setup;
 };
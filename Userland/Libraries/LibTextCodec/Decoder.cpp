@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteReader.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
 #include <LibTextCodec/Decoder.h>
@@ -192,10 +193,15 @@ Optional<String> get_standardized_encoding(const String& encoding)
     return {};
 }
 
+void Decoder::append_to_utf8(StringBuilder& builder, StringView const& input)
+{
+    process(input, [&builder](u32 c) { builder.append_code_point(c); });
+}
+
 String Decoder::to_utf8(const StringView& input)
 {
     StringBuilder builder(input.length());
-    process(input, [&builder](u32 c) { builder.append_code_point(c); });
+    append_to_utf8(builder, input);
     return builder.to_string();
 }
 
@@ -206,6 +212,11 @@ void UTF8Decoder::process(const StringView& input, Function<void(u32)> on_code_p
     }
 }
 
+void UTF8Decoder::append_to_utf8(StringBuilder& builder, StringView const& input)
+{
+    builder.append(input);
+}
+
 String UTF8Decoder::to_utf8(const StringView& input)
 {
     return input;
@@ -236,6 +247,36 @@ void Latin1Decoder::process(const StringView& input, Function<void(u32)> on_code
     }
 }
 
+void Latin1Decoder::append_to_utf8(StringBuilder& builder, StringView const& input)
+{
+    auto const* data = reinterpret_cast<u8 const*>(input.characters_without_null_termination());
+    size_t i = 0;
+
+    while (i < input.length()) {
+        // ASCII bytes are also valid UTF-8, so copy whole runs of them
+        // verbatim, checking for high bits a word at a time.
+        size_t run_start = i;
+        while (i + sizeof(u64) <= input.length()) {
+            auto word = ByteReader::load64(data + i);
+            if (word & 0x8080808080808080ull)
+                break;
+            i += sizeof(u64);
+        }
+        while (i < input.length() && data[i] < 0x80)
+            ++i;
+        if (i != run_start)
+            builder.append(input.substring_view(run_start, i - run_start));
+
+        // The remaining Latin1 bytes map to the same code points, which all
+        // encode as two UTF-8 bytes.
+        while (i < input.length() && data[i] >= 0x80) {
+            u8 ch = data[i++];
+            builder.append(static_cast<char>(0xc0 | (ch >> 6)));
+            builder.append(static_cast<char>(0x80 | (ch & 0x3f)));
+        }
+    }
+}
+
 namespace {
 u32 convert_latin2_to_utf8(u8 in)
 {
@@ -14,6 +14,13 @@ namespace TextCodec {
 class Decoder {
 public:
     virtual void process(StringView const&, Function<void(u32)> on_code_point) = 0;
+
+    // Bulk-transcodes the input into the builder, without going through a
+    // per-code-point callback. The default implementation falls back to
+    // process(); decoders with cheap mappings override it with a
+    // block-based fast path.
+    virtual void append_to_utf8(StringBuilder&, StringView const&);
+
     virtual String to_utf8(StringView const&);
 
 protected:
@@ -23,6 +30,7 @@ protected:
 class UTF8Decoder final : public Decoder {
 public:
     virtual void process(StringView const&, Function<void(u32)> on_code_point) override;
+    virtual void append_to_utf8(StringBuilder&, StringView const&) override;
     virtual String to_utf8(StringView const&) override;
 };
 
@@ -35,6 +43,7 @@ public:
 class Latin1Decoder final : public Decoder {
 public:
     virtual void process(StringView const&, Function<void(u32)> on_code_point) override;
+    virtual void append_to_utf8(StringBuilder&, StringView const&) override;
 };
 
 class Latin2Decoder final : public Decoder {
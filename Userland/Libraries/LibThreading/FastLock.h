@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/Types.h>
+#ifdef __serenity__
+#    include <serenity.h>
+#else
+#    include <sched.h>
+#endif
+
+namespace Threading {
+
+// A small non-recursive lock for short critical sections: the uncontended
+// path is a single atomic exchange, a contended acquire spins briefly in
+// the hope that the holder is about to leave, and only then parks the
+// thread on the lock's futex word.
+class FastLock {
+    AK_MAKE_NONCOPYABLE(FastLock);
+    AK_MAKE_NONMOVABLE(FastLock);
+
+    enum State : u32 {
+        Unlocked = 0,
+        Locked,
+        LockedWithWaiters,
+    };
+
+public:
+    FastLock() = default;
+
+    bool try_lock()
+    {
+        u32 expected = Unlocked;
+        return m_state.compare_exchange_strong(expected, Locked, AK::memory_order_acquire);
+    }
+
+    void lock()
+    {
+        if (try_lock())
+            return;
+
+        for (int i = 0; i < 64; ++i) {
+            if (m_state.load(AK::memory_order_relaxed) == Unlocked && try_lock())
+                return;
+#if defined(__x86_64__) || defined(__i386__)
+            asm volatile("pause");
+#endif
+        }
+
+        // Announce that we're going to sleep, so unlock() knows to wake us.
+        while (m_state.exchange(LockedWithWaiters, AK::memory_order_acquire) != Unlocked) {
+#ifdef __serenity__
+            futex_wait(m_state.ptr(), LockedWithWaiters, nullptr, 0);
+#else
+            sched_yield();
+#endif
+        }
+    }
+
+    void unlock()
+    {
+        if (m_state.exchange(Unlocked, AK::memory_order_release) == LockedWithWaiters) {
+#ifdef __serenity__
+            futex_wake(m_state.ptr(), 1);
+#endif
+        }
+    }
+
+private:
+    AK::Atomic<u32> m_state { Unlocked };
+};
+
+class FastLockLocker {
+public:
+    ALWAYS_INLINE explicit FastLockLocker(FastLock& lock)
+        : m_lock(lock)
+    {
+        m_lock.lock();
+    }
+    ALWAYS_INLINE ~FastLockLocker() { m_lock.unlock(); }
+
+private:
+    FastLock& m_lock;
+};
+
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/Singleton.h>
+#include <AK/String.h>
+#include <LibThreading/WorkerPool.h>
+#include <unistd.h>
+
+namespace Threading {
+
+// Note: intentionally never destroyed - tearing the pool down at exit would
+// pull the mutex and queue out from under the worker threads.
+static Singleton<WorkerPool> s_the;
+
+WorkerPool& WorkerPool::the()
+{
+    return *s_the;
+}
+
+WorkerPool::WorkerPool()
+{
+    pthread_mutex_init(&m_mutex, nullptr);
+    pthread_cond_init(&m_condition, nullptr);
+
+    long result = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t worker_count = result < 1 ? 1 : (size_t)result;
+
+    m_workers.resize(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        auto thread = Thread::construct(
+            [this, i]() -> intptr_t {
+                worker_loop(i);
+                return 0;
+            },
+            String::formatted("WorkerPool[{}]", i));
+        thread->start();
+        m_threads.append(move(thread));
+    }
+}
+
+void WorkerPool::enqueue(Function<void()> work, TaskPriority priority)
+{
+    pthread_mutex_lock(&m_mutex);
+    auto& worker = m_workers[m_next_queue];
+    m_next_queue = (m_next_queue + 1) % m_workers.size();
+    worker.queues[(size_t)priority].append(move(work));
+    pthread_cond_signal(&m_condition);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+// Must be called with m_mutex held.
+Function<void()> WorkerPool::take_task_for_worker(size_t index)
+{
+    auto& worker = m_workers[index];
+    for (auto& queue : worker.queues) {
+        if (!queue.is_empty())
+            return queue.take_first();
+    }
+
+    // Nothing local; steal the most recently queued task from the busiest peer.
+    size_t victim_index = index;
+    size_t victim_task_count = 0;
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        if (i == index)
+            continue;
+        size_t task_count = 0;
+        for (auto& queue : m_workers[i].queues)
+            task_count += queue.size();
+        if (task_count > victim_task_count) {
+            victim_task_count = task_count;
+            victim_index = i;
+        }
+    }
+    if (victim_task_count == 0)
+        return {};
+    for (auto& queue : m_workers[victim_index].queues) {
+        if (!queue.is_empty())
+            return queue.take_last();
+    }
+    return {};
+}
+
+void WorkerPool::worker_loop(size_t index)
+{
+    for (;;) {
+        pthread_mutex_lock(&m_mutex);
+        Function<void()> task;
+        for (;;) {
+            task = take_task_for_worker(index);
+            if (task)
+                break;
+            pthread_cond_wait(&m_condition, &m_mutex);
+        }
+        pthread_mutex_unlock(&m_mutex);
+        task();
+    }
+}
+
+void WorkerPool::parallel_for(size_t count, Function<void(size_t)> action)
+{
+    if (count == 0)
+        return;
+    if (count == 1) {
+        action(0);
+        return;
+    }
+
+    struct State : public RefCounted<State> {
+        State(size_t count, Function<void(size_t)>& action)
+            : count(count)
+            , action(action)
+        {
+        }
+
+        size_t count { 0 };
+        // The caller blocks until every index has completed, so borrowing
+        // its Function here is safe.
+        Function<void(size_t)>& action;
+        Atomic<size_t> next_index { 0 };
+        Atomic<size_t> completed_count { 0 };
+        pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+        pthread_cond_t condition = PTHREAD_COND_INITIALIZER;
+    };
+
+    auto state = adopt_ref(*new State(count, action));
+
+    auto process_indices = [](State& state) {
+        for (;;) {
+            size_t index = state.next_index.fetch_add(1);
+            if (index >= state.count)
+                return;
+            state.action(index);
+            if (state.completed_count.fetch_add(1) + 1 == state.count) {
+                pthread_mutex_lock(&state.mutex);
+                pthread_cond_broadcast(&state.condition);
+                pthread_mutex_unlock(&state.mutex);
+            }
+        }
+    };
+
+    size_t helper_count = min(m_workers.size(), count - 1);
+    for (size_t i = 0; i < helper_count; ++i) {
+        enqueue(
+            [state, process_indices]() mutable {
+                process_indices(*state);
+            },
+            TaskPriority::High);
+    }
+
+    process_indices(*state);
+
+    pthread_mutex_lock(&state->mutex);
+    while (state->completed_count.load() < state->count)
+        pthread_cond_wait(&state->condition, &state->mutex);
+    pthread_mutex_unlock(&state->mutex);
+}
+
+}
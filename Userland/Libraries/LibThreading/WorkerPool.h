@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/RefCounted.h>
+#include <AK/Singleton.h>
+#include <AK/Vector.h>
+#include <LibThreading/Thread.h>
+#include <pthread.h>
+
+namespace Threading {
+
+// A Future is fulfilled exactly once, by the worker that ran the task.
+// Any number of threads may wait() for the result.
+template<typename Result>
+class Future : public RefCounted<Future<Result>> {
+public:
+    Future()
+    {
+        pthread_mutex_init(&m_mutex, nullptr);
+        pthread_cond_init(&m_condition, nullptr);
+    }
+
+    ~Future()
+    {
+        pthread_mutex_destroy(&m_mutex);
+        pthread_cond_destroy(&m_condition);
+    }
+
+    bool is_ready() const
+    {
+        pthread_mutex_lock(&m_mutex);
+        bool ready = m_result.has_value();
+        pthread_mutex_unlock(&m_mutex);
+        return ready;
+    }
+
+    void fulfill(Result result)
+    {
+        pthread_mutex_lock(&m_mutex);
+        VERIFY(!m_result.has_value());
+        m_result = move(result);
+        pthread_cond_broadcast(&m_condition);
+        pthread_mutex_unlock(&m_mutex);
+    }
+
+    Result wait()
+    {
+        pthread_mutex_lock(&m_mutex);
+        while (!m_result.has_value())
+            pthread_cond_wait(&m_condition, &m_mutex);
+        Result result = m_result.value();
+        pthread_mutex_unlock(&m_mutex);
+        return result;
+    }
+
+private:
+    mutable pthread_mutex_t m_mutex;
+    pthread_cond_t m_condition;
+    Optional<Result> m_result;
+};
+
+enum class TaskPriority {
+    High = 0,
+    Normal,
+    Low,
+};
+
+class WorkerPool {
+public:
+    // The process-wide pool, created on first use with one worker per CPU.
+    static WorkerPool& the();
+
+    void enqueue(Function<void()>, TaskPriority = TaskPriority::Normal);
+
+    template<typename Result>
+    NonnullRefPtr<Future<Result>> submit(Function<Result()> action, TaskPriority priority = TaskPriority::Normal)
+    {
+        auto future = adopt_ref(*new Future<Result>);
+        enqueue(
+            [future, action = move(action)]() mutable {
+                future->fulfill(action());
+            },
+            priority);
+        return future;
+    }
+
+    // Runs action(0 .. count - 1) across the pool. The calling thread
+    // participates, and the call returns once every index has completed.
+    void parallel_for(size_t count, Function<void(size_t)> action);
+
+    size_t worker_count() const { return m_workers.size(); }
+
+private:
+    friend struct AK::SingletonInstanceCreator<WorkerPool>;
+
+    WorkerPool();
+
+    struct Worker {
+        // One queue per TaskPriority, oldest task first.
+        Vector<Function<void()>> queues[3];
+    };
+
+    void worker_loop(size_t index);
+    Function<void()> take_task_for_worker(size_t index);
+
+    pthread_mutex_t m_mutex;
+    pthread_cond_t m_condition;
+    Vector<Worker> m_workers;
+    Vector<NonnullRefPtr<Thread>> m_threads;
+    size_t m_next_queue { 0 };
+};
+
+}
@@ -213,6 +213,11 @@ static SpecialCasing const* find_matching_special_case(Utf8View const& string, O
 u32 to_unicode_lowercase(u32 code_point)
 {
 #if ENABLE_UNICODE_DATA
+    // The Unicode simple mappings for ASCII agree with ASCII case conversion,
+    // so the common case doesn't need to search the code point tables.
+    if (AK::is_ascii(code_point))
+        return AK::to_ascii_lowercase(code_point);
+
     auto unicode_data = Detail::unicode_data_for_code_point(code_point);
     if (unicode_data.has_value())
         return unicode_data->simple_lowercase_mapping;
@@ -225,6 +230,9 @@ u32 to_unicode_lowercase(u32 code_point)
 u32 to_unicode_uppercase(u32 code_point)
 {
 #if ENABLE_UNICODE_DATA
+    if (AK::is_ascii(code_point))
+        return AK::to_ascii_uppercase(code_point);
+
     auto unicode_data = Detail::unicode_data_for_code_point(code_point);
     if (unicode_data.has_value())
         return unicode_data->simple_uppercase_mapping;
@@ -73,7 +73,32 @@ public:
     }
 
     bool is_dirty() const { return m_dirty; }
-    void set_dirty(bool b) { m_dirty = b; }
+    void set_dirty(bool b)
+    {
+        m_dirty = b;
+        if (b) {
+            m_dirty_first_column = 0;
+            m_dirty_last_column = max(m_cells.size(), static_cast<size_t>(1)) - 1;
+        }
+    }
+
+    // Marks only the given (inclusive) column range as needing a repaint,
+    // merging it with whatever range is already dirty.
+    void mark_dirty(size_t first_column, size_t last_column)
+    {
+        if (!m_dirty) {
+            m_dirty = true;
+            m_dirty_first_column = first_column;
+            m_dirty_last_column = last_column;
+        } else {
+            m_dirty_first_column = min(m_dirty_first_column, first_column);
+            m_dirty_last_column = max(m_dirty_last_column, last_column);
+        }
+    }
+
+    // Only meaningful while is_dirty() is true.
+    size_t first_dirty_column() const { return m_dirty_first_column; }
+    size_t last_dirty_column() const { return m_dirty_last_column; }
 
     Optional<u16> termination_column() const { return m_terminated_at; }
     void set_terminated(u16 column) { m_terminated_at = column; }
@@ -83,6 +108,8 @@ private:
     void push_cells_into_next_line(size_t new_length, Line* next_line, bool cursor_is_on_next_line, CursorPosition* cursor);
 
     Vector<Cell> m_cells;
+    size_t m_dirty_first_column { 0 };
+    size_t m_dirty_last_column { 0 };
     bool m_dirty { false };
     // Note: The alignment is 8, so this member lives in the padding (that already existed before it was introduced)
     [[no_unique_address]] Optional<u16> m_terminated_at;
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibVT/Scrollback.h>
+
+namespace VT {
+
+// Attribute::operator== ignores hyperlinks, but packing must not merge
+// cells that differ only in their href.
+static bool attributes_identical(Attribute const& a, Attribute const& b)
+{
+    return a == b && a.href == b.href && a.href_id == b.href_id;
+}
+
+u16 Scrollback::PackedPage::index_for_attribute(Attribute const& attribute)
+{
+    for (size_t i = 0; i < m_attribute_palette.size(); ++i) {
+        if (attributes_identical(m_attribute_palette[i], attribute))
+            return i;
+    }
+    // A page holds at most lines_per_page * columns distinct attributes,
+    // far fewer than the literal_flag bit allows.
+    VERIFY(m_attribute_palette.size() < literal_flag);
+    m_attribute_palette.append(attribute);
+    return m_attribute_palette.size() - 1;
+}
+
+void Scrollback::PackedPage::pack(Line const& line)
+{
+    PackedLine packed;
+    packed.first_segment = m_segments.size();
+    packed.length = line.length();
+    packed.terminated_at = line.termination_column().value_or(no_termination);
+
+    size_t column = 0;
+    while (column < line.length()) {
+        auto const& attribute = line.attribute_at(column);
+        size_t run_end = column + 1;
+        while (run_end < line.length() && attributes_identical(line.attribute_at(run_end), attribute))
+            ++run_end;
+
+        bool all_code_points_equal = true;
+        for (size_t i = column + 1; i < run_end; ++i) {
+            if (line.code_point(i) != line.code_point(column)) {
+                all_code_points_equal = false;
+                break;
+            }
+        }
+
+        Segment segment;
+        segment.attribute_index_and_flags = index_for_attribute(attribute);
+        segment.cell_count = run_end - column;
+        if (all_code_points_equal) {
+            segment.code_point_or_index = line.code_point(column);
+        } else {
+            segment.attribute_index_and_flags |= literal_flag;
+            segment.code_point_or_index = m_code_points.size();
+            for (size_t i = column; i < run_end; ++i)
+                m_code_points.append(line.code_point(i));
+        }
+        m_segments.append(segment);
+        column = run_end;
+    }
+
+    packed.segment_count = m_segments.size() - packed.first_segment;
+    m_lines.append(packed);
+}
+
+NonnullOwnPtr<Line> Scrollback::PackedPage::unpack(size_t line_index) const
+{
+    auto const& packed = m_lines[line_index];
+    auto line = make<Line>(packed.length);
+    size_t column = 0;
+    for (size_t i = 0; i < packed.segment_count; ++i) {
+        auto const& segment = m_segments[packed.first_segment + i];
+        auto const& attribute = m_attribute_palette[segment.attribute_index_and_flags & ~literal_flag];
+        bool is_literal = segment.attribute_index_and_flags & literal_flag;
+        for (size_t j = 0; j < segment.cell_count; ++j, ++column) {
+            line->attribute_at(column) = attribute;
+            line->set_code_point(column, is_literal ? m_code_points[segment.code_point_or_index + j] : segment.code_point_or_index);
+        }
+    }
+    if (packed.terminated_at != no_termination)
+        line->set_terminated(packed.terminated_at);
+    return line;
+}
+
+Line& Scrollback::line(size_t index)
+{
+    VERIFY(index < size());
+    if (index >= m_packed_line_count)
+        return m_recent_lines[index - m_packed_line_count];
+
+    auto physical_index = index + m_dropped_from_oldest_page;
+    auto page_index = physical_index / lines_per_page;
+    if (page_index != m_unpacked_page_index) {
+        m_unpacked_lines.clear();
+        auto const& page = m_pages[page_index];
+        for (size_t i = 0; i < page.line_count(); ++i)
+            m_unpacked_lines.append(page.unpack(i));
+        m_unpacked_page_index = page_index;
+    }
+    return m_unpacked_lines[physical_index % lines_per_page];
+}
+
+void Scrollback::append(NonnullOwnPtr<Line> line)
+{
+    m_recent_lines.append(move(line));
+    // Keep a page's worth of lines unpacked so that scrolling near the
+    // bottom never has to touch a packed page.
+    if (m_recent_lines.size() >= 2 * lines_per_page)
+        pack_oldest_recent_lines();
+}
+
+void Scrollback::pack_oldest_recent_lines()
+{
+    PackedPage page;
+    for (size_t i = 0; i < lines_per_page; ++i)
+        page.pack(m_recent_lines[i]);
+    m_pages.append(move(page));
+    m_recent_lines.remove(0, lines_per_page);
+    m_packed_line_count += lines_per_page;
+}
+
+void Scrollback::drop_oldest(size_t count)
+{
+    auto packed_to_drop = min(count, m_packed_line_count);
+    m_dropped_from_oldest_page += packed_to_drop;
+    m_packed_line_count -= packed_to_drop;
+    count -= packed_to_drop;
+    while (m_dropped_from_oldest_page >= lines_per_page) {
+        m_pages.remove(0);
+        m_dropped_from_oldest_page -= lines_per_page;
+    }
+    m_unpacked_page_index = NumericLimits<size_t>::max();
+    m_unpacked_lines.clear();
+
+    if (count > 0)
+        m_recent_lines.remove(0, min(count, m_recent_lines.size()));
+}
+
+void Scrollback::clear()
+{
+    m_pages.clear();
+    m_dropped_from_oldest_page = 0;
+    m_packed_line_count = 0;
+    m_recent_lines.clear();
+    m_unpacked_page_index = NumericLimits<size_t>::max();
+    m_unpacked_lines.clear();
+}
+
+NonnullOwnPtrVector<Line> Scrollback::take_all_lines()
+{
+    NonnullOwnPtrVector<Line> lines;
+    for (size_t page_index = 0; page_index < m_pages.size(); ++page_index) {
+        auto const& page = m_pages[page_index];
+        auto first_line = page_index == 0 ? m_dropped_from_oldest_page : 0;
+        for (auto i = first_line; i < page.line_count(); ++i)
+            lines.append(page.unpack(i));
+    }
+    lines.extend(move(m_recent_lines));
+    clear();
+    return lines;
+}
+
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtrVector.h>
+#include <AK/NumericLimits.h>
+#include <AK/Vector.h>
+#include <LibVT/Line.h>
+
+namespace VT {
+
+// Paged storage for scrollback lines. The most recent lines are kept as
+// regular Line objects; once a whole page of them has accumulated, they
+// get packed into a run-length-encoded form that exploits how repetitive
+// terminal attributes are, and are unpacked again on demand when the
+// user scrolls back up. With large scrollback limits this keeps all but
+// the hot end of the history an order of magnitude smaller.
+class Scrollback {
+public:
+    static constexpr size_t lines_per_page = 64;
+
+    size_t size() const { return m_packed_line_count + m_recent_lines.size(); }
+    bool is_empty() const { return size() == 0; }
+
+    // Index 0 is the oldest line. References into the packed region stay
+    // valid only until the next line() call, and edits to them are lost;
+    // all current callers just read (painting, selection, hit testing).
+    Line& line(size_t index);
+
+    void append(NonnullOwnPtr<Line>);
+    void drop_oldest(size_t count);
+    void clear();
+
+    // Unpacks the entire history and leaves this object empty; used by
+    // the resize/rewrap path, which wants to edit every line in place.
+    NonnullOwnPtrVector<Line> take_all_lines();
+
+private:
+    class PackedPage {
+    public:
+        void pack(Line const&);
+        NonnullOwnPtr<Line> unpack(size_t line_index) const;
+        size_t line_count() const { return m_lines.size(); }
+
+    private:
+        static constexpr u16 literal_flag = 0x8000;
+        static constexpr u16 no_termination = 0xffff;
+
+        struct Segment {
+            u16 attribute_index_and_flags { 0 };
+            u16 cell_count { 0 };
+            // The code point itself for a repeat segment, or the index of
+            // the first of cell_count code points in m_code_points.
+            u32 code_point_or_index { 0 };
+        };
+
+        struct PackedLine {
+            u32 first_segment { 0 };
+            u16 segment_count { 0 };
+            u16 length { 0 };
+            u16 terminated_at { no_termination };
+        };
+
+        u16 index_for_attribute(Attribute const&);
+
+        // The palette also keeps any href Strings of packed lines alive.
+        Vector<Attribute> m_attribute_palette;
+        Vector<Segment> m_segments;
+        Vector<u32> m_code_points;
+        Vector<PackedLine> m_lines;
+    };
+
+    void pack_oldest_recent_lines();
+
+    Vector<PackedPage> m_pages;
+    // Lines logically removed from the front of the oldest page; the
+    // page itself is freed once all of its lines have been dropped.
+    size_t m_dropped_from_oldest_page { 0 };
+    size_t m_packed_line_count { 0 };
+    NonnullOwnPtrVector<Line> m_recent_lines;
+
+    // line() hands out references into the most recently unpacked page.
+    size_t m_unpacked_page_index { NumericLimits<size_t>::max() };
+    NonnullOwnPtrVector<Line> m_unpacked_lines;
+};
+
+}
@@ -42,7 +42,6 @@ void Terminal::clear_history()
     dbgln_if(TERMINAL_DEBUG, "Clear history");
     auto previous_history_size = m_history.size();
     m_history.clear();
-    m_history_start = 0;
     m_client.terminal_history_changed(-previous_history_size);
 }
 #endif
@@ -834,7 +833,7 @@ void Terminal::scroll_left(u16 row, u16 column, size_t count)
     for (size_t i = column; i < columns() - count; ++i)
         swap(line.cell_at(i), line.cell_at(i + count));
     clear_in_line(row, columns() - count, columns() - 1);
-    line.set_dirty(true);
+    line.mark_dirty(column, columns() - 1);
 }
 
 // Insert `count` blank cells after `row`. Text moves right.
@@ -849,7 +848,7 @@ void Terminal::scroll_right(u16 row, u16 column, size_t count)
     for (int i = columns() - 1; i >= static_cast<int>(column + count); --i)
         swap(line.cell_at(i), line.cell_at(i - count));
     clear_in_line(row, column, column + count - 1);
-    line.set_dirty(true);
+    line.mark_dirty(column, columns() - 1);
 }
 
 void Terminal::put_character_at(unsigned row, unsigned column, u32 code_point)
@@ -860,7 +859,7 @@ void Terminal::put_character_at(unsigned row, unsigned column, u32 code_point)
     line.set_code_point(column, code_point);
     line.attribute_at(column) = m_current_state.attribute;
     line.attribute_at(column).flags |= Attribute::Touched;
-    line.set_dirty(true);
+    line.mark_dirty(column, column);
 
     m_last_code_point = code_point;
 }
@@ -1494,18 +1493,22 @@ void Terminal::set_size(u16 columns, u16 rows)
     };
 
     auto old_history_size = m_history.size();
-    m_history.extend(move(m_normal_screen_buffer));
+    // The rewrap passes below want to edit every line in place, so unpack
+    // the entire scrollback for their duration. Resizing is rare enough
+    // that the temporary memory spike doesn't matter.
+    auto history = m_history.take_all_lines();
+    history.extend(move(m_normal_screen_buffer));
     CursorPosition cursor_tracker { cursor_row() + old_history_size, cursor_column() };
-    resize_and_rewrap(m_history, cursor_tracker);
-    if (auto extra_lines = m_history.size() - rows) {
+    resize_and_rewrap(history, cursor_tracker);
+    if (auto extra_lines = history.size() - rows) {
         while (extra_lines > 0) {
-            if (m_history.size() <= cursor_tracker.row)
+            if (history.size() <= cursor_tracker.row)
                 break;
-            if (m_history.last().is_empty()) {
-                if (m_history.size() >= 2 && m_history[m_history.size() - 2].termination_column().has_value())
+            if (history.last().is_empty()) {
+                if (history.size() >= 2 && history[history.size() - 2].termination_column().has_value())
                     break;
                 --extra_lines;
-                m_history.take_last();
+                history.take_last();
                 continue;
             }
             break;
@@ -1516,13 +1519,18 @@ void Terminal::set_size(u16 columns, u16 rows)
     //        from the history into the normal buffer
     m_normal_screen_buffer.ensure_capacity(rows);
     while (m_normal_screen_buffer.size() < rows) {
-        if (!m_history.is_empty())
-            m_normal_screen_buffer.prepend(m_history.take_last());
+        if (!history.is_empty())
+            m_normal_screen_buffer.prepend(history.take_last());
         else
             m_normal_screen_buffer.unchecked_append(make<Line>(columns));
     }
 
-    cursor_tracker.row -= m_history.size();
+    cursor_tracker.row -= history.size();
+
+    auto& history_lines = static_cast<Vector<NonnullOwnPtr<Line>>&>(history);
+    for (auto& line : history_lines)
+        m_history.append(move(line));
+    history_lines.clear();
 
     if (m_history.size() != old_history_size) {
         m_client.terminal_history_changed(-old_history_size);
@@ -1573,7 +1581,7 @@ void Terminal::set_size(u16 columns, u16 rows)
 void Terminal::invalidate_cursor()
 {
     if (cursor_row() < active_buffer().size())
-        active_buffer()[cursor_row()].set_dirty(true);
+        active_buffer()[cursor_row()].mark_dirty(cursor_column(), cursor_column());
 }
 
 Attribute Terminal::attribute_at(const Position& position) const
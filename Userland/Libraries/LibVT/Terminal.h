@@ -18,6 +18,7 @@
 #ifndef KERNEL
 #    include <LibVT/Attribute.h>
 #    include <LibVT/Line.h>
+#    include <LibVT/Scrollback.h>
 #else
 namespace Kernel {
 class VirtualConsole;
@@ -118,7 +119,7 @@ public:
             return m_alternate_screen_buffer[index];
         } else {
             if (index < m_history.size())
-                return m_history[(m_history_start + index) % m_history.size()];
+                return m_history.line(index);
             return m_normal_screen_buffer[index - m_history.size()];
         }
     }
@@ -143,22 +144,14 @@ public:
         if (value == 0) {
             auto previous_size = m_history.size();
             m_max_history_lines = 0;
-            m_history_start = 0;
             m_history.clear();
             m_client.terminal_history_changed(-previous_size);
             return;
         }
 
         if (m_max_history_lines > value) {
-            NonnullOwnPtrVector<Line> new_history;
-            new_history.ensure_capacity(value);
             auto existing_line_count = min(m_history.size(), value);
-            for (size_t i = m_history.size() - existing_line_count; i < m_history.size(); ++i) {
-                auto j = (m_history_start + i) % m_history.size();
-                new_history.unchecked_append(move(static_cast<Vector<NonnullOwnPtr<Line>>&>(m_history).at(j)));
-            }
-            m_history = move(new_history);
-            m_history_start = 0;
+            m_history.drop_oldest(m_history.size() - existing_line_count);
             m_client.terminal_history_changed(value - existing_line_count);
         }
         m_max_history_lines = value;
@@ -369,20 +362,15 @@ protected:
 
     EscapeSequenceParser m_parser;
 #ifndef KERNEL
-    size_t m_history_start = 0;
-    NonnullOwnPtrVector<Line> m_history;
+    Scrollback m_history;
     void add_line_to_history(NonnullOwnPtr<Line>&& line)
     {
         if (max_history_size() == 0)
             return;
 
-        if (m_history.size() < max_history_size()) {
-            VERIFY(m_history_start == 0);
-            m_history.append(move(line));
-            return;
-        }
-        m_history.ptr_at(m_history_start) = move(line);
-        m_history_start = (m_history_start + 1) % m_history.size();
+        if (m_history.size() >= max_history_size())
+            m_history.drop_oldest(m_history.size() - max_history_size() + 1);
+        m_history.append(move(line));
     }
 
     NonnullOwnPtrVector<Line>& active_buffer() { return m_use_alternate_screen_buffer ? m_alternate_screen_buffer : m_normal_screen_buffer; };
@@ -70,7 +70,17 @@ void TerminalWidget::set_pty_master_fd(int fd)
         }
         for (ssize_t i = 0; i < nread; ++i)
             m_terminal.on_input(buffer[i]);
-        flush_dirty_lines();
+
+        // When a command produces output quickly, the notifier fires many
+        // times per event loop pump. Coalesce all the input processed during
+        // one pump into a single flush instead of flushing per read().
+        if (!m_has_pending_flush) {
+            m_has_pending_flush = true;
+            deferred_invoke([this] {
+                m_has_pending_flush = false;
+                flush_dirty_lines();
+            });
+        }
     };
 }
 
@@ -119,6 +129,7 @@ TerminalWidget::TerminalWidget(int ptm_fd, bool automatic_size_policy)
         set_font(Gfx::FontDatabase::the().get_by_name(font_entry));
 
     m_line_height = font().glyph_height() + m_line_spacing;
+    m_column_width = font().glyph_width('x');
 
     m_terminal.set_size(Config::read_i32("Terminal", "Window", "Width", 80), Config::read_i32("Terminal", "Window", "Height", 25));
 
@@ -155,14 +166,14 @@ TerminalWidget::~TerminalWidget()
 Gfx::IntRect TerminalWidget::glyph_rect(u16 row, u16 column)
 {
     int y = row * m_line_height;
-    int x = column * font().glyph_width('x');
-    return { x + frame_thickness() + m_inset, y + frame_thickness() + m_inset, font().glyph_width('x'), font().glyph_height() };
+    int x = column * m_column_width;
+    return { x + frame_thickness() + m_inset, y + frame_thickness() + m_inset, m_column_width, font().glyph_height() };
 }
 
 Gfx::IntRect TerminalWidget::row_rect(u16 row)
 {
     int y = row * m_line_height;
-    Gfx::IntRect rect = { frame_thickness() + m_inset, y + frame_thickness() + m_inset, font().glyph_width('x') * m_terminal.columns(), font().glyph_height() };
+    Gfx::IntRect rect = { frame_thickness() + m_inset, y + frame_thickness() + m_inset, m_column_width * m_terminal.columns(), font().glyph_height() };
     rect.inflate(0, m_line_spacing);
     return rect;
 }
@@ -309,7 +320,7 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
     // Pass: Paint background & text decorations.
     for (u16 visual_row = 0; visual_row < m_terminal.rows(); ++visual_row) {
         auto row_rect = this->row_rect(visual_row);
-        if (!event.rect().contains(row_rect))
+        if (!event.rect().intersects(row_rect))
             continue;
         auto& line = m_terminal.line(first_row_from_history + visual_row);
         bool has_only_one_background_color = line.has_only_one_background_color();
@@ -328,6 +339,8 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
             auto attribute = line.attribute_at(column);
             auto character_rect = glyph_rect(visual_row, column);
             auto cell_rect = character_rect.inflated(0, m_line_spacing);
+            if (!event.rect().intersects(cell_rect))
+                continue;
             auto text_color_before_bold_change = should_reverse_fill_for_cursor_or_selection ? attribute.effective_background_color() : attribute.effective_foreground_color();
             auto text_color = terminal_color_to_rgb(m_show_bold_text_as_bright ? text_color_before_bold_change.to_bright() : text_color_before_bold_change);
             if ((!visual_beep_active && !has_only_one_background_color) || should_reverse_fill_for_cursor_or_selection)
@@ -388,7 +401,7 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
     // Pass: Paint foreground (text).
     for (u16 visual_row = 0; visual_row < m_terminal.rows(); ++visual_row) {
         auto row_rect = this->row_rect(visual_row);
-        if (!event.rect().contains(row_rect))
+        if (!event.rect().intersects(row_rect))
             continue;
         auto& line = m_terminal.line(first_row_from_history + visual_row);
         for (size_t column = 0; column < line.length(); ++column) {
@@ -407,6 +420,8 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
                 continue;
 
             auto character_rect = glyph_rect(visual_row, column);
+            if (!event.rect().intersects(character_rect.inflated(0, m_line_spacing)))
+                continue;
 
             if (!m_hovered_href_id.is_null() && attribute.href_id == m_hovered_href_id) {
                 text_color = palette().base_text();
@@ -482,14 +497,23 @@ void TerminalWidget::flush_dirty_lines()
         m_terminal.m_need_full_flush = false;
         return;
     }
-    Gfx::IntRect rect;
     for (int i = 0; i < m_terminal.rows(); ++i) {
-        if (m_terminal.visible_line(i).is_dirty()) {
-            rect = rect.united(row_rect(i));
-            m_terminal.visible_line(i).set_dirty(false);
+        auto& line = m_terminal.visible_line(i);
+        if (!line.is_dirty())
+            continue;
+        line.set_dirty(false);
+        if (!line.length()) {
+            update(row_rect(i));
+            continue;
         }
+        // Only invalidate the range of columns that actually changed, so a
+        // blinking cursor or a program updating a status line doesn't repaint
+        // the whole row. Window-side damage coalescing takes care of merging
+        // adjacent rects.
+        size_t first_column = min(line.first_dirty_column(), line.length() - 1);
+        size_t last_column = min(line.last_dirty_column(), line.length() - 1);
+        update(glyph_rect(i, first_column).united(glyph_rect(i, last_column)).inflated(0, m_line_spacing));
     }
-    update(rect);
 }
 
 void TerminalWidget::resize_event(GUI::ResizeEvent& event)
@@ -1117,6 +1141,7 @@ void TerminalWidget::did_change_font()
 {
     GUI::Frame::did_change_font();
     m_line_height = font().glyph_height() + m_line_spacing;
+    m_column_width = font().glyph_width('x');
     if (!size().is_empty())
         relayout(size());
 }
@@ -180,11 +180,13 @@ private:
     int m_inset { 2 };
     int m_line_spacing { 4 };
     int m_line_height { 0 };
+    int m_column_width { 1 };
 
     int m_ptm_fd { -1 };
 
     bool m_has_logical_focus { false };
     bool m_in_relayout { false };
+    bool m_has_pending_flush { false };
 
     RefPtr<Core::Notifier> m_notifier;
 
@@ -40,6 +40,11 @@ constexpr u32 CHANNELS_ID = 0x9F;
 constexpr u32 BIT_DEPTH_ID = 0x6264;
 constexpr u32 SIMPLE_BLOCK_ID = 0xA3;
 constexpr u32 TIMESTAMP_ID = 0xE7;
+constexpr u32 CUES_ID = 0x1C53BB6B;
+constexpr u32 CUE_POINT_ID = 0xBB;
+constexpr u32 CUE_TIME_ID = 0xB3;
+constexpr u32 CUE_TRACK_POSITIONS_ID = 0xB7;
+constexpr u32 CUE_CLUSTER_POSITION_ID = 0xF1;
 
 OwnPtr<MatroskaDocument> MatroskaReader::parse_matroska_from_file(StringView const& path)
 {
@@ -58,6 +63,20 @@ OwnPtr<MatroskaDocument> MatroskaReader::parse_matroska_from_data(u8 const* data
 }
 
 OwnPtr<MatroskaDocument> MatroskaReader::parse()
+{
+    auto matroska_document = parse_header();
+    if (!matroska_document)
+        return {};
+
+    while (auto cluster = next_cluster())
+        matroska_document->clusters().append(cluster.release_nonnull());
+    if (m_had_error)
+        return {};
+
+    return matroska_document;
+}
+
+OwnPtr<MatroskaDocument> MatroskaReader::parse_header()
 {
     auto first_element_id = m_streamer.read_variable_size_integer(false);
     dbgln_if(MATROSKA_TRACE_DEBUG, "First element ID is {:#010x}\n", first_element_id.value());
@@ -74,15 +93,101 @@ OwnPtr<MatroskaDocument> MatroskaReader::parse()
     if (!root_element_id.has_value() || root_element_id.value() != SEGMENT_ELEMENT_ID)
         return {};
 
+    auto segment_data_size = m_streamer.read_variable_size_integer();
+    if (!segment_data_size.has_value())
+        return {};
+    m_segment_contents_begin = m_streamer.position();
+    m_segment_contents_size = segment_data_size.value();
+
     auto matroska_document = make<MatroskaDocument>(header.value());
 
-    auto segment_parse_success = parse_segment_elements(*matroska_document);
-    if (!segment_parse_success)
-        return {};
+    // Walk the segment's children until the first cluster; everything from
+    // there on is demuxed on demand by next_cluster().
+    // Note: Cues are only picked up if the muxer put them in front of the
+    //       clusters (the usual layout for seekable files); following a
+    //       SeekHead to cues at the end of the file would take random access
+    //       we don't want to rely on here.
+    while (!at_end_of_segment()) {
+        auto element_position = m_streamer.position();
+        auto element_id = m_streamer.read_variable_size_integer(false);
+        if (!element_id.has_value())
+            return {};
+
+        if (element_id.value() == SEGMENT_INFORMATION_ELEMENT_ID) {
+            auto segment_information = parse_information();
+            if (!segment_information)
+                return {};
+            matroska_document->set_segment_information(move(segment_information));
+        } else if (element_id.value() == TRACK_ELEMENT_ID) {
+            if (!parse_tracks(*matroska_document))
+                return {};
+        } else if (element_id.value() == CUES_ID) {
+            if (!parse_cues())
+                return {};
+        } else if (element_id.value() == CLUSTER_ELEMENT_ID) {
+            m_position_of_first_cluster = element_position;
+            m_streamer.seek_to(element_position);
+            break;
+        } else {
+            if (!read_unknown_element())
+                return {};
+        }
+    }
 
     return matroska_document;
 }
 
+bool MatroskaReader::at_end_of_segment()
+{
+    return m_streamer.at_end() || m_streamer.position() >= m_segment_contents_begin + m_segment_contents_size;
+}
+
+OwnPtr<Cluster> MatroskaReader::next_cluster()
+{
+    while (!at_end_of_segment()) {
+        auto element_id = m_streamer.read_variable_size_integer(false);
+        if (!element_id.has_value()) {
+            m_had_error = true;
+            return {};
+        }
+
+        if (element_id.value() == CLUSTER_ELEMENT_ID) {
+            auto cluster = parse_cluster();
+            if (!cluster)
+                m_had_error = true;
+            return cluster;
+        }
+
+        // Cues, chapters, tags and the like may sit between clusters.
+        if (!read_unknown_element()) {
+            m_had_error = true;
+            return {};
+        }
+    }
+    return {};
+}
+
+bool MatroskaReader::seek_to_cue_for_timestamp(u64 timestamp)
+{
+    if (!m_position_of_first_cluster.has_value())
+        return false;
+
+    // The cue points are in timestamp order, so take the last one that
+    // doesn't overshoot; without a matching cue (or without cues at all)
+    // fall back to the very first cluster.
+    auto target_position = m_position_of_first_cluster.value();
+    for (auto& cue_point : m_cue_points) {
+        if (cue_point.timestamp > timestamp)
+            break;
+        target_position = m_segment_contents_begin + cue_point.cluster_position;
+    }
+
+    if (!m_streamer.seek_to(target_position))
+        return false;
+    m_had_error = false;
+    return true;
+}
+
 bool MatroskaReader::parse_master_element([[maybe_unused]] StringView const& element_name, Function<bool(u64)> element_consumer)
 {
     auto element_data_size = m_streamer.read_variable_size_integer();
@@ -136,33 +241,6 @@ Optional<EBMLHeader> MatroskaReader::parse_ebml_header()
     return header;
 }
 
-bool MatroskaReader::parse_segment_elements(MatroskaDocument& matroska_document)
-{
-    dbgln_if(MATROSKA_DEBUG, "Parsing segment elements");
-    auto success = parse_master_element("Segment", [&](u64 element_id) {
-        if (element_id == SEGMENT_INFORMATION_ELEMENT_ID) {
-            auto segment_information = parse_information();
-            if (!segment_information)
-                return false;
-            matroska_document.set_segment_information(move(segment_information));
-        } else if (element_id == TRACK_ELEMENT_ID) {
-            return parse_tracks(matroska_document);
-        } else if (element_id == CLUSTER_ELEMENT_ID) {
-            auto cluster = parse_cluster();
-            if (!cluster)
-                return false;
-            matroska_document.clusters().append(cluster.release_nonnull());
-        } else {
-            return read_unknown_element();
-        }
-
-        return true;
-    });
-
-    dbgln("Success {}", success);
-    return success;
-}
-
 OwnPtr<SegmentInformation> MatroskaReader::parse_information()
 {
     auto segment_information = make<SegmentInformation>();
@@ -430,6 +508,50 @@ OwnPtr<Block> MatroskaReader::parse_simple_block()
     return block;
 }
 
+bool MatroskaReader::parse_cues()
+{
+    m_cue_points.clear_with_capacity();
+    return parse_master_element("Cues", [&](u64 element_id) {
+        if (element_id == CUE_POINT_ID)
+            return parse_cue_point();
+        return read_unknown_element();
+    });
+}
+
+bool MatroskaReader::parse_cue_point()
+{
+    CuePoint cue_point;
+    auto success = parse_master_element("CuePoint", [&](u64 element_id) {
+        if (element_id == CUE_TIME_ID) {
+            auto cue_time = read_u64_element();
+            CHECK_HAS_VALUE(cue_time);
+            cue_point.timestamp = cue_time.value();
+            dbgln_if(MATROSKA_TRACE_DEBUG, "Read CueTime attribute: {}", cue_time.value());
+        } else if (element_id == CUE_TRACK_POSITIONS_ID) {
+            return parse_master_element("CueTrackPositions", [&](u64 positions_element_id) {
+                if (positions_element_id == CUE_CLUSTER_POSITION_ID) {
+                    auto cluster_position = read_u64_element();
+                    CHECK_HAS_VALUE(cluster_position);
+                    cue_point.cluster_position = cluster_position.value();
+                    dbgln_if(MATROSKA_TRACE_DEBUG, "Read CueClusterPosition attribute: {}", cluster_position.value());
+                } else {
+                    return read_unknown_element();
+                }
+                return true;
+            });
+        } else {
+            return read_unknown_element();
+        }
+
+        return true;
+    });
+
+    if (!success)
+        return false;
+    m_cue_points.append(cue_point);
+    return true;
+}
+
 Optional<String> MatroskaReader::read_string_element()
 {
     auto string_length = m_streamer.read_variable_size_integer();
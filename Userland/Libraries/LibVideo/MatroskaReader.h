@@ -25,13 +25,26 @@ public:
     static OwnPtr<MatroskaDocument> parse_matroska_from_file(StringView const& path);
     static OwnPtr<MatroskaDocument> parse_matroska_from_data(u8 const*, size_t);
 
+    // Parses the whole document, clusters and all, up front.
     OwnPtr<MatroskaDocument> parse();
 
+    // Streaming interface: parse_header() reads everything up to the first
+    // cluster (EBML header, segment information, tracks, and Cues if they
+    // precede the clusters), then each next_cluster() call demuxes a single
+    // cluster on demand.
+    OwnPtr<MatroskaDocument> parse_header();
+    OwnPtr<Cluster> next_cluster();
+    bool had_error() const { return m_had_error; }
+
+    bool has_cues() const { return !m_cue_points.is_empty(); }
+    bool seek_to_cue_for_timestamp(u64 timestamp);
+
 private:
     class Streamer {
     public:
         Streamer(u8 const* data, size_t size)
             : m_data_ptr(data)
+            , m_start(data)
             , m_size_remaining(size)
         {
         }
@@ -140,16 +153,36 @@ private:
         size_t remaining() const { return m_size_remaining; }
         void set_remaining(size_t remaining) { m_size_remaining = remaining; }
 
+        size_t position() const { return m_data_ptr - m_start; }
+
+        bool seek_to(size_t position)
+        {
+            auto total_size = this->position() + m_size_remaining;
+            if (position > total_size)
+                return false;
+            m_data_ptr = m_start + position;
+            m_size_remaining = total_size - position;
+            return true;
+        }
+
     private:
         u8 const* m_data_ptr { nullptr };
+        u8 const* m_start { nullptr };
         size_t m_size_remaining { 0 };
         Vector<size_t> m_octets_read { 0 };
     };
 
+    // A Cues entry mapping a timestamp to the position of the cluster (relative
+    // to the start of the segment contents) that should be entered to seek there.
+    struct CuePoint {
+        u64 timestamp { 0 };
+        u64 cluster_position { 0 };
+    };
+
     bool parse_master_element(StringView const& element_name, Function<bool(u64 element_id)> element_consumer);
     Optional<EBMLHeader> parse_ebml_header();
 
-    bool parse_segment_elements(MatroskaDocument&);
+    bool at_end_of_segment();
     OwnPtr<SegmentInformation> parse_information();
 
     bool parse_tracks(MatroskaDocument&);
@@ -158,12 +191,19 @@ private:
     Optional<TrackEntry::AudioTrack> parse_audio_track_information();
     OwnPtr<Cluster> parse_cluster();
     OwnPtr<Block> parse_simple_block();
+    bool parse_cues();
+    bool parse_cue_point();
 
     Optional<String> read_string_element();
     Optional<u64> read_u64_element();
     bool read_unknown_element();
 
     Streamer m_streamer;
+    size_t m_segment_contents_begin { 0 };
+    size_t m_segment_contents_size { 0 };
+    Optional<size_t> m_position_of_first_cluster;
+    Vector<CuePoint> m_cue_points;
+    bool m_had_error { false };
 };
 
 }
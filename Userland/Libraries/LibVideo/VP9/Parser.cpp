@@ -760,6 +760,13 @@ void Parser::allocate_tile_data()
 
 bool Parser::decode_tiles()
 {
+    // FIXME: The bitstream lays out tile columns precisely so that they can
+    //        be entropy-decoded in parallel; this loop decodes them serially
+    //        instead. Doing better requires moving the per-tile decode state
+    //        (bit stream, above/left contexts, syntax element counts) out of
+    //        the Parser so each tile can run on its own worker, with the
+    //        counts merged afterwards. Worth doing once reconstruction
+    //        exists and decode time actually matters.
     auto tile_cols = 1 << m_tile_cols_log2;
     auto tile_rows = 1 << m_tile_rows_log2;
     allocate_tile_data();
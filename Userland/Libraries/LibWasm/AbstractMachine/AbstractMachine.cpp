@@ -9,9 +9,81 @@
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
 #include <LibWasm/Types.h>
+#include <sys/mman.h>
 
 namespace Wasm {
 
+MemoryInstance::MemoryInstance(MemoryType const& type)
+    : m_type(type)
+{
+    auto minimum_size = (size_t)(m_type.limits().min() * Constants::page_size);
+    // Reserve address space for the whole memory up front, as PROT_NONE:
+    // the declared maximum if there is one, otherwise the full 2^16 pages
+    // the spec allows. grow() then commits pages into the reservation.
+    auto wanted_reservation = (u64)min(m_type.limits().max().value_or(65536), 65536u) * Constants::page_size;
+    // A full 2^16-page memory does not even fit in a 32-bit address space,
+    // so clamp the first attempt to something the platform could provide.
+    auto reservation_size = (size_t)min(wanted_reservation, (u64)(NumericLimits<size_t>::max() / 2));
+    while (reservation_size > 0) {
+        auto* region = mmap(nullptr, reservation_size, PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE, -1, 0);
+        if (region != MAP_FAILED) {
+            m_data = static_cast<u8*>(region);
+            m_reservation_size = reservation_size;
+            break;
+        }
+        // A cramped (32-bit) address space might not fit the full
+        // reservation; back off towards the minimum. Growing past the
+        // reservation will fail, which the spec permits.
+        if (reservation_size <= max(minimum_size, (size_t)Constants::page_size))
+            break;
+        reservation_size = max(reservation_size / 2, max(minimum_size, (size_t)Constants::page_size));
+    }
+    grow(minimum_size);
+}
+
+MemoryInstance::MemoryInstance(MemoryInstance&& other)
+    : m_type(other.m_type)
+    , m_size(exchange(other.m_size, 0))
+    , m_committed_size(exchange(other.m_committed_size, 0))
+    , m_reservation_size(exchange(other.m_reservation_size, 0))
+    , m_data(exchange(other.m_data, nullptr))
+{
+}
+
+MemoryInstance::~MemoryInstance()
+{
+    if (m_data)
+        munmap(m_data, m_reservation_size);
+}
+
+bool MemoryInstance::grow(size_t size_to_grow)
+{
+    if (size_to_grow == 0)
+        return true;
+    auto new_size = m_size + size_to_grow;
+    // Can't grow past 2^16 pages.
+    if (new_size >= Constants::page_size * 65536)
+        return false;
+    if (auto max = m_type.limits().max(); max.has_value()) {
+        if (max.value() * Constants::page_size < new_size)
+            return false;
+    }
+    if (new_size > m_reservation_size)
+        return false;
+    // Commit whole wasm pages at a time, so the mprotect() range stays
+    // aligned even when a data segment grows the memory by a byte count.
+    auto new_committed_size = align_up_to(new_size, (size_t)Constants::page_size);
+    if (new_committed_size > m_committed_size) {
+        if (mprotect(m_data + m_committed_size, new_committed_size - m_committed_size, PROT_READ | PROT_WRITE) != 0)
+            return false;
+        // Freshly committed anonymous pages are already zeroed, as the
+        // spec requires of grown memory.
+        m_committed_size = new_committed_size;
+    }
+    m_size = new_size;
+    return true;
+}
+
 Optional<FunctionAddress> Store::allocate(ModuleInstance& module, Module::Function const& function)
 {
     FunctionAddress address { m_functions.size() };
@@ -110,7 +182,14 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
         main_module_instance.types() = section.types();
     });
 
-    // FIXME: Validate stuff
+    // FIXME: Validate stuff.
+    //        When that happens, don't add a separate pass that re-walks every
+    //        function body here: the spec's validation algorithm is single-pass,
+    //        so it should be fused into the parser, and per-function-body
+    //        validation should be deferred until the function is first invoked
+    //        (or farmed out per function). Modules get loaded at
+    //        user-interaction time, so time-to-runnable matters more than
+    //        time-to-first-call.
 
     Vector<Value> global_values;
     Vector<Vector<Reference>> elements;
@@ -9,6 +9,7 @@
 #include <AK/Function.h>
 #include <AK/HashMap.h>
 #include <AK/HashTable.h>
+#include <AK/Noncopyable.h>
 #include <AK/OwnPtr.h>
 #include <AK/Result.h>
 #include <LibWasm/Types.h>
@@ -324,43 +325,32 @@ private:
 };
 
 class MemoryInstance {
+    AK_MAKE_NONCOPYABLE(MemoryInstance);
+
 public:
-    explicit MemoryInstance(MemoryType const& type)
-        : m_type(type)
-    {
-        grow(m_type.limits().min() * Constants::page_size);
-    }
+    explicit MemoryInstance(MemoryType const& type);
+    MemoryInstance(MemoryInstance&&);
+    ~MemoryInstance();
 
     auto& type() const { return m_type; }
     auto size() const { return m_size; }
-    auto& data() const { return m_data; }
-    auto& data() { return m_data; }
+    ReadonlyBytes data() const { return { m_data, m_size }; }
+    Bytes data() { return { m_data, m_size }; }
 
-    bool grow(size_t size_to_grow)
-    {
-        if (size_to_grow == 0)
-            return true;
-        auto new_size = m_data.size() + size_to_grow;
-        // Can't grow past 2^16 pages.
-        if (new_size >= Constants::page_size * 65536)
-            return false;
-        if (auto max = m_type.limits().max(); max.has_value()) {
-            if (max.value() * Constants::page_size < new_size)
-                return false;
-        }
-        auto previous_size = m_size;
-        if (!m_data.try_resize(new_size))
-            return false;
-        m_size = new_size;
-        // The spec requires that we zero out everything on grow
-        __builtin_memset(m_data.offset_pointer(previous_size), 0, size_to_grow);
-        return true;
-    }
+    bool grow(size_t size_to_grow);
 
 private:
     MemoryType const& m_type;
     size_t m_size { 0 };
-    ByteBuffer m_data;
+    // The memory lives in one mmap'd reservation sized for the declared
+    // maximum (or the 2^16-page spec limit), with only the first
+    // m_committed_size bytes accessible; everything past that is PROT_NONE.
+    // grow() commits further pages in place, so m_data never moves and
+    // nothing ever gets copied, and a stray access past the committed part
+    // faults instead of scribbling over unrelated heap memory.
+    size_t m_committed_size { 0 };
+    size_t m_reservation_size { 0 };
+    u8* m_data { nullptr };
 };
 
 class GlobalInstance {
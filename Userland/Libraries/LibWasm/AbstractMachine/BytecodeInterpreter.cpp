@@ -29,7 +29,631 @@ namespace Wasm {
         }                                                                                      \
     } while (false)
 
+// Every instruction the interpreter knows how to execute, grouped by the
+// shape of its handler. The order of these lists defines the dense opcode
+// numbering of the pre-decoded instruction stream, so everything generated
+// from them (the id enum, the dispatch table, the handlers) has to use them
+// in the same order.
+#define ENUMERATE_SPECIAL_INSTRUCTIONS(M) \
+    M(unreachable)                        \
+    M(nop)                                \
+    M(local_get)                          \
+    M(local_set)                          \
+    M(local_tee)                          \
+    M(i32_const)                          \
+    M(i64_const)                          \
+    M(f32_const)                          \
+    M(f64_const)                          \
+    M(block)                              \
+    M(loop)                               \
+    M(if_)                                \
+    M(structured_end)                     \
+    M(structured_else)                    \
+    M(return_)                            \
+    M(br)                                 \
+    M(br_if)                              \
+    M(br_table)                           \
+    M(call)                               \
+    M(call_indirect)                      \
+    M(global_get)                         \
+    M(global_set)                         \
+    M(memory_size)                        \
+    M(memory_grow)                        \
+    M(ref_null)                           \
+    M(ref_func)                           \
+    M(ref_is_null)                        \
+    M(drop)                               \
+    M(select)                             \
+    M(select_typed)
+
+#define ENUMERATE_UNARY_INSTRUCTIONS(M)                     \
+    M(i32_eqz, i32, i32, EqualsZero)                        \
+    M(i64_eqz, i64, i32, EqualsZero)                        \
+    M(i32_clz, i32, i32, CountLeadingZeros)                 \
+    M(i32_ctz, i32, i32, CountTrailingZeros)                \
+    M(i32_popcnt, i32, i32, PopCount)                       \
+    M(i64_clz, i64, i64, CountLeadingZeros)                 \
+    M(i64_ctz, i64, i64, CountTrailingZeros)                \
+    M(i64_popcnt, i64, i64, PopCount)                       \
+    M(f32_abs, float, float, Absolute)                      \
+    M(f32_neg, float, float, Negate)                        \
+    M(f32_ceil, float, float, Ceil)                         \
+    M(f32_floor, float, float, Floor)                       \
+    M(f32_trunc, float, float, Truncate)                    \
+    M(f32_nearest, float, float, NearbyIntegral)            \
+    M(f32_sqrt, float, float, SquareRoot)                   \
+    M(f64_abs, double, double, Absolute)                    \
+    M(f64_neg, double, double, Negate)                      \
+    M(f64_ceil, double, double, Ceil)                       \
+    M(f64_floor, double, double, Floor)                     \
+    M(f64_trunc, double, double, Truncate)                  \
+    M(f64_nearest, double, double, NearbyIntegral)          \
+    M(f64_sqrt, double, double, SquareRoot)                 \
+    M(i32_wrap_i64, i64, i32, Wrap<i32>)                    \
+    M(i32_trunc_sf32, float, i32, CheckedTruncate<i32>)     \
+    M(i32_trunc_uf32, float, i32, CheckedTruncate<u32>)     \
+    M(i32_trunc_sf64, double, i32, CheckedTruncate<i32>)    \
+    M(i32_trunc_uf64, double, i32, CheckedTruncate<u32>)    \
+    M(i64_trunc_sf32, float, i64, CheckedTruncate<i64>)     \
+    M(i64_trunc_uf32, float, i64, CheckedTruncate<u64>)     \
+    M(i64_trunc_sf64, double, i64, CheckedTruncate<i64>)    \
+    M(i64_trunc_uf64, double, i64, CheckedTruncate<u64>)    \
+    M(i64_extend_si32, i32, i64, Extend<i64>)               \
+    M(i64_extend_ui32, u32, i64, Extend<i64>)               \
+    M(f32_convert_si32, i32, float, Convert<float>)         \
+    M(f32_convert_ui32, u32, float, Convert<float>)         \
+    M(f32_convert_si64, i64, float, Convert<float>)         \
+    M(f32_convert_ui64, u64, float, Convert<float>)         \
+    M(f32_demote_f64, double, float, Demote)                \
+    M(f64_convert_si32, i32, double, Convert<double>)       \
+    M(f64_convert_ui32, u32, double, Convert<double>)       \
+    M(f64_convert_si64, i64, double, Convert<double>)       \
+    M(f64_convert_ui64, u64, double, Convert<double>)       \
+    M(f64_promote_f32, float, double, Promote)              \
+    M(i32_reinterpret_f32, float, i32, Reinterpret<i32>)    \
+    M(i64_reinterpret_f64, double, i64, Reinterpret<i64>)   \
+    M(f32_reinterpret_i32, i32, float, Reinterpret<float>)  \
+    M(f64_reinterpret_i64, i64, double, Reinterpret<double>) \
+    M(i32_extend8_s, i32, i32, SignExtend<i8>)              \
+    M(i32_extend16_s, i32, i32, SignExtend<i16>)            \
+    M(i64_extend8_s, i64, i64, SignExtend<i8>)              \
+    M(i64_extend16_s, i64, i64, SignExtend<i16>)            \
+    M(i64_extend32_s, i64, i64, SignExtend<i32>)            \
+    M(i32_trunc_sat_f32_s, float, i32, SaturatingTruncate<i32>)  \
+    M(i32_trunc_sat_f32_u, float, i32, SaturatingTruncate<u32>)  \
+    M(i32_trunc_sat_f64_s, double, i32, SaturatingTruncate<i32>) \
+    M(i32_trunc_sat_f64_u, double, i32, SaturatingTruncate<u32>) \
+    M(i64_trunc_sat_f32_s, float, i64, SaturatingTruncate<i64>)  \
+    M(i64_trunc_sat_f32_u, float, i64, SaturatingTruncate<u64>)  \
+    M(i64_trunc_sat_f64_s, double, i64, SaturatingTruncate<i64>) \
+    M(i64_trunc_sat_f64_u, double, i64, SaturatingTruncate<u64>)
+
+#define ENUMERATE_BINARY_INSTRUCTIONS(M)                    \
+    M(i32_eq, i32, i32, Equals)                             \
+    M(i32_ne, i32, i32, NotEquals)                          \
+    M(i32_lts, i32, i32, LessThan)                          \
+    M(i32_ltu, u32, i32, LessThan)                          \
+    M(i32_gts, i32, i32, GreaterThan)                       \
+    M(i32_gtu, u32, i32, GreaterThan)                       \
+    M(i32_les, i32, i32, LessThanOrEquals)                  \
+    M(i32_leu, u32, i32, LessThanOrEquals)                  \
+    M(i32_ges, i32, i32, GreaterThanOrEquals)               \
+    M(i32_geu, u32, i32, GreaterThanOrEquals)               \
+    M(i64_eq, i64, i32, Equals)                             \
+    M(i64_ne, i64, i32, NotEquals)                          \
+    M(i64_lts, i64, i32, LessThan)                          \
+    M(i64_ltu, u64, i32, LessThan)                          \
+    M(i64_gts, i64, i32, GreaterThan)                       \
+    M(i64_gtu, u64, i32, GreaterThan)                       \
+    M(i64_les, i64, i32, LessThanOrEquals)                  \
+    M(i64_leu, u64, i32, LessThanOrEquals)                  \
+    M(i64_ges, i64, i32, GreaterThanOrEquals)               \
+    M(i64_geu, u64, i32, GreaterThanOrEquals)               \
+    M(f32_eq, float, i32, Equals)                           \
+    M(f32_ne, float, i32, NotEquals)                        \
+    M(f32_lt, float, i32, LessThan)                         \
+    M(f32_gt, float, i32, GreaterThan)                      \
+    M(f32_le, float, i32, LessThanOrEquals)                 \
+    M(f32_ge, float, i32, GreaterThanOrEquals)              \
+    M(f64_eq, double, i32, Equals)                          \
+    M(f64_ne, double, i32, NotEquals)                       \
+    M(f64_lt, double, i32, LessThan)                        \
+    M(f64_gt, double, i32, GreaterThan)                     \
+    M(f64_le, double, i32, LessThanOrEquals)                \
+    M(f64_ge, double, i32, GreaterThanOrEquals)             \
+    M(i32_add, u32, i32, Add)                               \
+    M(i32_sub, u32, i32, Subtract)                          \
+    M(i32_mul, u32, i32, Multiply)                          \
+    M(i32_divs, i32, i32, Divide)                           \
+    M(i32_divu, u32, i32, Divide)                           \
+    M(i32_rems, i32, i32, Modulo)                           \
+    M(i32_remu, u32, i32, Modulo)                           \
+    M(i32_and, i32, i32, BitAnd)                            \
+    M(i32_or, i32, i32, BitOr)                              \
+    M(i32_xor, i32, i32, BitXor)                            \
+    M(i32_shl, u32, i32, BitShiftLeft)                      \
+    M(i32_shrs, i32, i32, BitShiftRight)                    \
+    M(i32_shru, u32, i32, BitShiftRight)                    \
+    M(i32_rotl, u32, i32, BitRotateLeft)                    \
+    M(i32_rotr, u32, i32, BitRotateRight)                   \
+    M(i64_add, u64, i64, Add)                               \
+    M(i64_sub, u64, i64, Subtract)                          \
+    M(i64_mul, u64, i64, Multiply)                          \
+    M(i64_divs, i64, i64, Divide)                           \
+    M(i64_divu, u64, i64, Divide)                           \
+    M(i64_rems, i64, i64, Modulo)                           \
+    M(i64_remu, u64, i64, Modulo)                           \
+    M(i64_and, i64, i64, BitAnd)                            \
+    M(i64_or, i64, i64, BitOr)                              \
+    M(i64_xor, i64, i64, BitXor)                            \
+    M(i64_shl, u64, i64, BitShiftLeft)                      \
+    M(i64_shrs, i64, i64, BitShiftRight)                    \
+    M(i64_shru, u64, i64, BitShiftRight)                    \
+    M(i64_rotl, u64, i64, BitRotateLeft)                    \
+    M(i64_rotr, u64, i64, BitRotateRight)                   \
+    M(f32_add, float, float, Add)                           \
+    M(f32_sub, float, float, Subtract)                      \
+    M(f32_mul, float, float, Multiply)                      \
+    M(f32_div, float, float, Divide)                        \
+    M(f32_min, float, float, Minimum)                       \
+    M(f32_max, float, float, Maximum)                       \
+    M(f32_copysign, float, float, CopySign)                 \
+    M(f64_add, double, double, Add)                         \
+    M(f64_sub, double, double, Subtract)                    \
+    M(f64_mul, double, double, Multiply)                    \
+    M(f64_div, double, double, Divide)                      \
+    M(f64_min, double, double, Minimum)                     \
+    M(f64_max, double, double, Maximum)                     \
+    M(f64_copysign, double, double, CopySign)
+
+#define ENUMERATE_LOAD_INSTRUCTIONS(M) \
+    M(i32_load, i32, i32)              \
+    M(i64_load, i64, i64)              \
+    M(f32_load, float, float)          \
+    M(f64_load, double, double)        \
+    M(i32_load8_s, i8, i32)            \
+    M(i32_load8_u, u8, i32)            \
+    M(i32_load16_s, i16, i32)          \
+    M(i32_load16_u, u16, i32)          \
+    M(i64_load8_s, i8, i64)            \
+    M(i64_load8_u, u8, i64)            \
+    M(i64_load16_s, i16, i64)          \
+    M(i64_load16_u, u16, i64)          \
+    M(i64_load32_s, i32, i64)          \
+    M(i64_load32_u, u32, i64)
+
+#define ENUMERATE_STORE_INSTRUCTIONS(M) \
+    M(i32_store, i32, i32)              \
+    M(i64_store, i64, i64)              \
+    M(f32_store, float, float)          \
+    M(f64_store, double, double)        \
+    M(i32_store8, i32, i8)              \
+    M(i32_store16, i32, i16)            \
+    M(i64_store8, i64, i8)              \
+    M(i64_store16, i64, i16)            \
+    M(i64_store32, i64, i32)
+
+namespace {
+
+enum class DenseOpcode : u16 {
+#define M(name, ...) name,
+    ENUMERATE_SPECIAL_INSTRUCTIONS(M)
+    ENUMERATE_UNARY_INSTRUCTIONS(M)
+    ENUMERATE_BINARY_INSTRUCTIONS(M)
+    ENUMERATE_LOAD_INSTRUCTIONS(M)
+    ENUMERATE_STORE_INSTRUCTIONS(M)
+#undef M
+    unimplemented,
+};
+
+DenseOpcode dense_opcode_for(OpCode opcode)
+{
+    switch (opcode.value()) {
+#define M(name, ...)                 \
+    case Instructions::name.value(): \
+        return DenseOpcode::name;
+        ENUMERATE_SPECIAL_INSTRUCTIONS(M)
+        ENUMERATE_UNARY_INSTRUCTIONS(M)
+        ENUMERATE_BINARY_INSTRUCTIONS(M)
+        ENUMERATE_LOAD_INSTRUCTIONS(M)
+        ENUMERATE_STORE_INSTRUCTIONS(M)
+#undef M
+    default:
+        return DenseOpcode::unimplemented;
+    }
+}
+
+}
+
+BytecodeInterpreter::PredecodedExpression const& BytecodeInterpreter::predecode(Expression const& expression)
+{
+    if (auto it = m_predecoded_expressions.find(&expression); it != m_predecoded_expressions.end())
+        return *it->value;
+
+    auto predecoded = make<PredecodedExpression>();
+    predecoded->instructions.ensure_capacity(expression.instructions().size());
+    for (auto& instruction : expression.instructions()) {
+        PredecodedInstruction flat;
+        flat.dense_opcode = static_cast<u16>(dense_opcode_for(instruction.opcode()));
+        flat.source = &instruction;
+        switch (static_cast<DenseOpcode>(flat.dense_opcode)) {
+        case DenseOpcode::local_get:
+        case DenseOpcode::local_set:
+        case DenseOpcode::local_tee:
+            flat.index = instruction.arguments().get<LocalIndex>().value();
+            break;
+        case DenseOpcode::global_get:
+        case DenseOpcode::global_set:
+            flat.index = instruction.arguments().get<GlobalIndex>().value();
+            break;
+        case DenseOpcode::call:
+        case DenseOpcode::ref_func:
+            flat.index = instruction.arguments().get<FunctionIndex>().value();
+            break;
+        case DenseOpcode::br:
+        case DenseOpcode::br_if:
+            flat.index = instruction.arguments().get<LabelIndex>().value();
+            break;
+        case DenseOpcode::i32_const:
+            flat.payload = static_cast<u64>(bit_cast<u32>(instruction.arguments().get<i32>()));
+            break;
+        case DenseOpcode::i64_const:
+            flat.payload = bit_cast<u64>(instruction.arguments().get<i64>());
+            break;
+        case DenseOpcode::f32_const:
+            flat.payload = static_cast<u64>(bit_cast<u32>(instruction.arguments().get<float>()));
+            break;
+        case DenseOpcode::f64_const:
+            flat.payload = bit_cast<u64>(instruction.arguments().get<double>());
+            break;
+        case DenseOpcode::block:
+        case DenseOpcode::loop:
+        case DenseOpcode::if_: {
+            auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
+            flat.index = args.block_type.kind() == BlockType::Empty ? 0 : 1;
+            flat.payload = args.end_ip.value();
+            if (args.else_ip.has_value())
+                flat.extra = args.else_ip->value() + 1;
+            break;
+        }
+#define M(name, ...) case DenseOpcode::name:
+            ENUMERATE_LOAD_INSTRUCTIONS(M)
+            ENUMERATE_STORE_INSTRUCTIONS(M)
+#undef M
+            flat.payload = instruction.arguments().get<Instruction::MemoryArgument>().offset;
+            break;
+        default:
+            break;
+        }
+        predecoded->instructions.unchecked_append(move(flat));
+    }
+
+    auto& result = *predecoded;
+    m_predecoded_expressions.set(&expression, move(predecoded));
+    return result;
+}
+
 void BytecodeInterpreter::interpret(Configuration& configuration)
+{
+    m_trap.clear();
+    auto& predecoded = predecode(configuration.frame().expression());
+    auto const* flat_instructions = predecoded.instructions.data();
+    auto max_ip_value = InstructionPointer { predecoded.instructions.size() };
+    auto& current_ip_value = configuration.ip();
+    auto const should_limit_instruction_count = configuration.should_limit_instruction_count();
+    u64 executed_instructions = 0;
+
+    // Token-threaded dispatch: each pre-decoded instruction carries an index
+    // into this table, so executing one costs a single indirect jump instead
+    // of a switch over the (sparse) wasm opcode space.
+    static void* const s_dispatch_table[] = {
+#define M(name, ...) &&handle_##name,
+        ENUMERATE_SPECIAL_INSTRUCTIONS(M)
+        ENUMERATE_UNARY_INSTRUCTIONS(M)
+        ENUMERATE_BINARY_INSTRUCTIONS(M)
+        ENUMERATE_LOAD_INSTRUCTIONS(M)
+        ENUMERATE_STORE_INSTRUCTIONS(M)
+#undef M
+        &&handle_unimplemented,
+    };
+
+    while (current_ip_value < max_ip_value) {
+        if (should_limit_instruction_count) {
+            if (executed_instructions++ >= Constants::max_allowed_executed_instructions_per_call) [[unlikely]] {
+                m_trap = Trap { "Exceeded maximum allowed number of instructions" };
+                return;
+            }
+        }
+        auto& flat = flat_instructions[current_ip_value.value()];
+        auto old_ip = current_ip_value;
+        goto* s_dispatch_table[flat.dense_opcode];
+
+    finish_instruction:
+        if (m_trap.has_value())
+            return;
+        if (current_ip_value == old_ip) // If no jump occurred
+            ++current_ip_value;
+        continue;
+
+    handle_unreachable:
+        m_trap = Trap { "Unreachable" };
+        return;
+    handle_nop:
+        goto finish_instruction;
+    handle_local_get:
+        configuration.stack().push(Value(configuration.frame().locals()[flat.index]));
+        goto finish_instruction;
+    handle_local_set: {
+        TRAP_IF_NOT(!configuration.stack().is_empty());
+        auto entry = configuration.stack().pop();
+        TRAP_IF_NOT(entry.has<Value>());
+        configuration.frame().locals()[flat.index] = move(entry.get<Value>());
+        goto finish_instruction;
+    }
+    handle_local_tee: {
+        TRAP_IF_NOT(!configuration.stack().is_empty());
+        auto& entry = configuration.stack().peek();
+        TRAP_IF_NOT(entry.has<Value>());
+        auto value = entry.get<Value>();
+        TRAP_IF_NOT(configuration.frame().locals().size() > flat.index);
+        dbgln_if(WASM_TRACE_DEBUG, "stack:peek -> locals({})", flat.index);
+        configuration.frame().locals()[flat.index] = move(value);
+        goto finish_instruction;
+    }
+    handle_i32_const:
+        configuration.stack().push(Value(ValueType { ValueType::I32 }, static_cast<i64>(bit_cast<i32>(static_cast<u32>(flat.payload)))));
+        goto finish_instruction;
+    handle_i64_const:
+        configuration.stack().push(Value(ValueType { ValueType::I64 }, bit_cast<i64>(flat.payload)));
+        goto finish_instruction;
+    handle_f32_const:
+        configuration.stack().push(Value(ValueType { ValueType::F32 }, static_cast<double>(bit_cast<float>(static_cast<u32>(flat.payload)))));
+        goto finish_instruction;
+    handle_f64_const:
+        configuration.stack().push(Value(ValueType { ValueType::F64 }, bit_cast<double>(flat.payload)));
+        goto finish_instruction;
+    handle_block:
+        configuration.stack().push(Label(flat.index, static_cast<size_t>(flat.payload)));
+        goto finish_instruction;
+    handle_loop:
+        configuration.stack().push(Label(flat.index, current_ip_value.value() + 1));
+        goto finish_instruction;
+    handle_if_: {
+        TRAP_IF_NOT(!configuration.stack().is_empty());
+        auto entry = configuration.stack().pop();
+        TRAP_IF_NOT(entry.has<Value>());
+        auto value = entry.get<Value>().to<i32>();
+        TRAP_IF_NOT(value.has_value());
+        auto end_label = Label(flat.index, static_cast<size_t>(flat.payload));
+        if (value.value() == 0) {
+            if (flat.extra != 0) {
+                configuration.ip() = flat.extra - 1;
+                configuration.stack().push(move(end_label));
+            } else {
+                configuration.ip() = static_cast<size_t>(flat.payload) + 1;
+            }
+        } else {
+            configuration.stack().push(move(end_label));
+        }
+        goto finish_instruction;
+    }
+    handle_structured_end: {
+        auto index = configuration.nth_label_index(0);
+        TRAP_IF_NOT(index.has_value());
+        configuration.stack().entries().remove(*index, 1);
+        goto finish_instruction;
+    }
+    handle_structured_else: {
+        auto index = configuration.nth_label_index(0);
+        TRAP_IF_NOT(index.has_value());
+        auto label = configuration.stack().entries()[*index].get<Label>();
+        configuration.stack().entries().remove(*index, 1);
+        // Jump to the end label
+        configuration.ip() = label.continuation();
+        goto finish_instruction;
+    }
+    handle_return_: {
+        auto& frame = configuration.frame();
+        size_t end = configuration.stack().size() - frame.arity();
+        size_t start = end;
+        for (; start + 1 > 0 && start < configuration.stack().size(); --start) {
+            auto& entry = configuration.stack().entries()[start];
+            if (entry.has<Frame>()) {
+                // Leave the frame, _and_ its label.
+                start += 2;
+                break;
+            }
+        }
+
+        configuration.stack().entries().remove(start, end - start);
+
+        // Jump past the call/indirect instruction
+        configuration.ip() = configuration.frame().expression().instructions().size();
+        goto finish_instruction;
+    }
+    handle_br:
+        branch_to_label(configuration, LabelIndex { flat.index });
+        goto finish_instruction;
+    handle_br_if: {
+        TRAP_IF_NOT(!configuration.stack().is_empty());
+        auto entry = configuration.stack().pop();
+        TRAP_IF_NOT(entry.has<Value>());
+        if (entry.get<Value>().to<i32>().value_or(0) == 0)
+            goto finish_instruction;
+        branch_to_label(configuration, LabelIndex { flat.index });
+        goto finish_instruction;
+    }
+    handle_br_table: {
+        auto& arguments = flat.source->arguments().get<Instruction::TableBranchArgs>();
+        TRAP_IF_NOT(!configuration.stack().is_empty());
+        auto entry = configuration.stack().pop();
+        TRAP_IF_NOT(entry.has<Value>());
+        auto maybe_i = entry.get<Value>().to<i32>();
+        TRAP_IF_NOT(maybe_i.has_value());
+        if (0 <= *maybe_i) {
+            size_t i = *maybe_i;
+            if (i < arguments.labels.size()) {
+                branch_to_label(configuration, arguments.labels[i]);
+                goto finish_instruction;
+            }
+        }
+        branch_to_label(configuration, arguments.default_);
+        goto finish_instruction;
+    }
+    handle_call: {
+        TRAP_IF_NOT(flat.index < configuration.frame().module().functions().size());
+        auto address = configuration.frame().module().functions()[flat.index];
+        dbgln_if(WASM_TRACE_DEBUG, "call({})", address.value());
+        call_address(configuration, address);
+        goto finish_instruction;
+    }
+    handle_call_indirect: {
+        auto& args = flat.source->arguments().get<Instruction::IndirectCallArgs>();
+        TRAP_IF_NOT(args.table.value() < configuration.frame().module().tables().size());
+        auto table_address = configuration.frame().module().tables()[args.table.value()];
+        auto table_instance = configuration.store().get(table_address);
+        TRAP_IF_NOT(!configuration.stack().is_empty());
+        auto entry = configuration.stack().pop();
+        TRAP_IF_NOT(entry.has<Value>());
+        auto index = entry.get<Value>().to<i32>();
+        TRAP_IF_NOT(index.has_value());
+        TRAP_IF_NOT(index.value() >= 0);
+        TRAP_IF_NOT(static_cast<size_t>(index.value()) < table_instance->elements().size());
+        auto element = table_instance->elements()[index.value()];
+        TRAP_IF_NOT(element.has_value());
+        TRAP_IF_NOT(element->ref().has<Reference::Func>());
+        auto address = element->ref().get<Reference::Func>().address;
+        dbgln_if(WASM_TRACE_DEBUG, "call_indirect({} -> {})", index.value(), address.value());
+        call_address(configuration, address);
+        goto finish_instruction;
+    }
+    handle_global_get: {
+        TRAP_IF_NOT(configuration.frame().module().globals().size() > flat.index);
+        auto address = configuration.frame().module().globals()[flat.index];
+        dbgln_if(WASM_TRACE_DEBUG, "global({}) -> stack", address.value());
+        auto global = configuration.store().get(address);
+        configuration.stack().push(Value(global->value()));
+        goto finish_instruction;
+    }
+    handle_global_set: {
+        TRAP_IF_NOT(configuration.frame().module().globals().size() > flat.index);
+        auto address = configuration.frame().module().globals()[flat.index];
+        TRAP_IF_NOT(!configuration.stack().is_empty());
+        auto entry = configuration.stack().pop();
+        TRAP_IF_NOT(entry.has<Value>());
+        auto value = entry.get<Value>();
+        dbgln_if(WASM_TRACE_DEBUG, "stack -> global({})", address.value());
+        auto global = configuration.store().get(address);
+        global->set_value(move(value));
+        goto finish_instruction;
+    }
+    handle_memory_size: {
+        TRAP_IF_NOT(configuration.frame().module().memories().size() > 0);
+        auto address = configuration.frame().module().memories()[0];
+        auto instance = configuration.store().get(address);
+        auto pages = instance->size() / Constants::page_size;
+        dbgln_if(WASM_TRACE_DEBUG, "memory.size -> stack({})", pages);
+        configuration.stack().push(Value((i32)pages));
+        goto finish_instruction;
+    }
+    handle_memory_grow: {
+        TRAP_IF_NOT(configuration.frame().module().memories().size() > 0);
+        auto address = configuration.frame().module().memories()[0];
+        auto instance = configuration.store().get(address);
+        i32 old_pages = instance->size() / Constants::page_size;
+        TRAP_IF_NOT(!configuration.stack().is_empty());
+        auto& entry = configuration.stack().peek();
+        TRAP_IF_NOT(entry.has<Value>());
+        auto new_pages = entry.get<Value>().to<i32>();
+        TRAP_IF_NOT(new_pages.has_value());
+        dbgln_if(WASM_TRACE_DEBUG, "memory.grow({}), previously {} pages...", *new_pages, old_pages);
+        if (instance->grow(new_pages.value() * Constants::page_size))
+            configuration.stack().peek() = Value((i32)old_pages);
+        else
+            configuration.stack().peek() = Value((i32)-1);
+        goto finish_instruction;
+    }
+    handle_ref_null: {
+        auto type = flat.source->arguments().get<ValueType>();
+        TRAP_IF_NOT(type.is_reference());
+        configuration.stack().push(Value(Reference(Reference::Null { type })));
+        goto finish_instruction;
+    }
+    handle_ref_func: {
+        auto& functions = configuration.frame().module().functions();
+        TRAP_IF_NOT(functions.size() > flat.index);
+        auto address = functions[flat.index];
+        configuration.stack().push(Value(ValueType(ValueType::FunctionReference), address.value()));
+        goto finish_instruction;
+    }
+    handle_ref_is_null: {
+        TRAP_IF_NOT(!configuration.stack().is_empty());
+        auto top = configuration.stack().peek().get_pointer<Value>();
+        TRAP_IF_NOT(top);
+        TRAP_IF_NOT(top->type().is_reference());
+        auto is_null = top->to<Reference::Null>().has_value();
+        configuration.stack().peek() = Value(ValueType(ValueType::I32), static_cast<u64>(is_null ? 1 : 0));
+        goto finish_instruction;
+    }
+    handle_drop:
+        TRAP_IF_NOT(!configuration.stack().is_empty());
+        configuration.stack().pop();
+        goto finish_instruction;
+    handle_select:
+    handle_select_typed: {
+        // Note: The type seems to only be used for validation.
+        TRAP_IF_NOT(!configuration.stack().is_empty());
+        auto entry = configuration.stack().pop();
+        TRAP_IF_NOT(entry.has<Value>());
+        auto value = entry.get<Value>().to<i32>();
+        TRAP_IF_NOT(value.has_value());
+        dbgln_if(WASM_TRACE_DEBUG, "select({})", value.value());
+        auto rhs_entry = configuration.stack().pop();
+        TRAP_IF_NOT(rhs_entry.has<Value>());
+        auto& lhs_entry = configuration.stack().peek();
+        TRAP_IF_NOT(lhs_entry.has<Value>());
+        auto rhs = move(rhs_entry.get<Value>());
+        auto lhs = move(lhs_entry.get<Value>());
+        configuration.stack().peek() = value.value() != 0 ? move(lhs) : move(rhs);
+        goto finish_instruction;
+    }
+
+#define M(name, pop_type, push_type, operation)                                     \
+    handle_##name:                                                                  \
+        unary_operation<pop_type, push_type, Operators::operation>(configuration);  \
+        goto finish_instruction;
+        ENUMERATE_UNARY_INSTRUCTIONS(M)
+#undef M
+
+#define M(name, pop_type, push_type, operation)                                            \
+    handle_##name:                                                                         \
+        binary_numeric_operation<pop_type, push_type, Operators::operation>(configuration); \
+        goto finish_instruction;
+        ENUMERATE_BINARY_INSTRUCTIONS(M)
+#undef M
+
+#define M(name, read_type, push_type)                                \
+    handle_##name:                                                   \
+        load_and_push<read_type, push_type>(configuration, flat.payload); \
+        goto finish_instruction;
+        ENUMERATE_LOAD_INSTRUCTIONS(M)
+#undef M
+
+#define M(name, pop_type, store_type)                                 \
+    handle_##name:                                                    \
+        pop_and_store<pop_type, store_type>(configuration, flat.payload); \
+        goto finish_instruction;
+        ENUMERATE_STORE_INSTRUCTIONS(M)
+#undef M
+
+    handle_unimplemented:
+        dbgln("Instruction '{}' not implemented", instruction_name(flat.source->opcode()));
+        m_trap = Trap { String::formatted("Unimplemented instruction {}", instruction_name(flat.source->opcode())) };
+        return;
+    }
+}
+
+void BytecodeInterpreter::interpret_without_predecoding(Configuration& configuration)
 {
     m_trap.clear();
     auto& instructions = configuration.frame().expression().instructions();
@@ -80,7 +704,7 @@ void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelInd
 }
 
 template<typename ReadType, typename PushType>
-void BytecodeInterpreter::load_and_push(Configuration& configuration, Instruction const& instruction)
+void BytecodeInterpreter::load_and_push(Configuration& configuration, u64 memory_offset)
 {
     auto& address = configuration.frame().module().memories().first();
     auto memory = configuration.store().get(address);
@@ -88,7 +712,6 @@ void BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
         m_trap = Trap { "Nonexistent memory" };
         return;
     }
-    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
     TRAP_IF_NOT(!configuration.stack().is_empty());
     auto& entry = configuration.stack().peek();
     TRAP_IF_NOT(entry.has<Value>());
@@ -97,7 +720,7 @@ void BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
         m_trap = Trap { "Memory access out of bounds" };
         return;
     }
-    u64 instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + arg.offset;
+    u64 instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + memory_offset;
     Checked addition { instance_address };
     addition += sizeof(ReadType);
     if (addition.has_overflow() || addition.value() > memory->size()) {
@@ -106,7 +729,7 @@ void BytecodeInterpreter::load_and_push(Configuration& configuration, Instructio
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
-    auto slice = memory->data().bytes().slice(instance_address, sizeof(ReadType));
+    auto slice = memory->data().slice(instance_address, sizeof(ReadType));
     configuration.stack().peek() = Value(static_cast<PushType>(read_value<ReadType>(slice)));
 }
 
@@ -235,28 +858,27 @@ struct ConvertToRaw<double> {
 };
 
 template<typename PopT, typename StoreT>
-void BytecodeInterpreter::pop_and_store(Configuration& configuration, Instruction const& instruction)
+void BytecodeInterpreter::pop_and_store(Configuration& configuration, u64 memory_offset)
 {
     TRAP_IF_NOT(!configuration.stack().is_empty());
     auto entry = configuration.stack().pop();
     TRAP_IF_NOT(entry.has<Value>());
     auto value = ConvertToRaw<StoreT> {}(*entry.get<Value>().to<PopT>());
     dbgln_if(WASM_TRACE_DEBUG, "stack({}) -> temporary({}b)", value, sizeof(StoreT));
-    store_to_memory(configuration, instruction, { &value, sizeof(StoreT) });
+    store_to_memory(configuration, memory_offset, { &value, sizeof(StoreT) });
 }
 
-void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruction const& instruction, ReadonlyBytes data)
+void BytecodeInterpreter::store_to_memory(Configuration& configuration, u64 memory_offset, ReadonlyBytes data)
 {
     auto& address = configuration.frame().module().memories().first();
     auto memory = configuration.store().get(address);
     TRAP_IF_NOT(memory);
-    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
     TRAP_IF_NOT(!configuration.stack().is_empty());
     auto entry = configuration.stack().pop();
     TRAP_IF_NOT(entry.has<Value>());
     auto base = entry.get<Value>().to<i32>();
     TRAP_IF_NOT(base.has_value());
-    u64 instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + arg.offset;
+    u64 instance_address = static_cast<u64>(bit_cast<u32>(base.value())) + memory_offset;
     Checked addition { instance_address };
     addition += data.size();
     if (addition.has_overflow() || addition.value() > memory->size()) {
@@ -265,7 +887,7 @@ void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruct
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "tempoaray({}b) -> store({})", data.size(), instance_address);
-    data.copy_to(memory->data().bytes().slice(instance_address, data.size()));
+    data.copy_to(memory->data().slice(instance_address, data.size()));
 }
 
 template<typename T>
@@ -521,51 +1143,51 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
         return;
     }
     case Instructions::i32_load.value():
-        return load_and_push<i32, i32>(configuration, instruction);
+        return load_and_push<i32, i32>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i64_load.value():
-        return load_and_push<i64, i64>(configuration, instruction);
+        return load_and_push<i64, i64>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::f32_load.value():
-        return load_and_push<float, float>(configuration, instruction);
+        return load_and_push<float, float>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::f64_load.value():
-        return load_and_push<double, double>(configuration, instruction);
+        return load_and_push<double, double>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i32_load8_s.value():
-        return load_and_push<i8, i32>(configuration, instruction);
+        return load_and_push<i8, i32>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i32_load8_u.value():
-        return load_and_push<u8, i32>(configuration, instruction);
+        return load_and_push<u8, i32>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i32_load16_s.value():
-        return load_and_push<i16, i32>(configuration, instruction);
+        return load_and_push<i16, i32>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i32_load16_u.value():
-        return load_and_push<u16, i32>(configuration, instruction);
+        return load_and_push<u16, i32>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i64_load8_s.value():
-        return load_and_push<i8, i64>(configuration, instruction);
+        return load_and_push<i8, i64>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i64_load8_u.value():
-        return load_and_push<u8, i64>(configuration, instruction);
+        return load_and_push<u8, i64>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i64_load16_s.value():
-        return load_and_push<i16, i64>(configuration, instruction);
+        return load_and_push<i16, i64>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i64_load16_u.value():
-        return load_and_push<u16, i64>(configuration, instruction);
+        return load_and_push<u16, i64>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i64_load32_s.value():
-        return load_and_push<i32, i64>(configuration, instruction);
+        return load_and_push<i32, i64>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i64_load32_u.value():
-        return load_and_push<u32, i64>(configuration, instruction);
+        return load_and_push<u32, i64>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i32_store.value():
-        return pop_and_store<i32, i32>(configuration, instruction);
+        return pop_and_store<i32, i32>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i64_store.value():
-        return pop_and_store<i64, i64>(configuration, instruction);
+        return pop_and_store<i64, i64>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::f32_store.value():
-        return pop_and_store<float, float>(configuration, instruction);
+        return pop_and_store<float, float>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::f64_store.value():
-        return pop_and_store<double, double>(configuration, instruction);
+        return pop_and_store<double, double>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i32_store8.value():
-        return pop_and_store<i32, i8>(configuration, instruction);
+        return pop_and_store<i32, i8>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i32_store16.value():
-        return pop_and_store<i32, i16>(configuration, instruction);
+        return pop_and_store<i32, i16>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i64_store8.value():
-        return pop_and_store<i64, i8>(configuration, instruction);
+        return pop_and_store<i64, i8>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i64_store16.value():
-        return pop_and_store<i64, i16>(configuration, instruction);
+        return pop_and_store<i64, i16>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::i64_store32.value():
-        return pop_and_store<i64, i32>(configuration, instruction);
+        return pop_and_store<i64, i32>(configuration, instruction.arguments().get<Instruction::MemoryArgument>().offset);
     case Instructions::local_tee.value(): {
         TRAP_IF_NOT(!configuration.stack().is_empty());
         auto& entry = configuration.stack().peek();
@@ -963,6 +1585,11 @@ void BytecodeInterpreter::interpret(Configuration& configuration, InstructionPoi
     }
 }
 
+void DebuggerBytecodeInterpreter::interpret(Configuration& configuration)
+{
+    interpret_without_predecoding(configuration);
+}
+
 void DebuggerBytecodeInterpreter::interpret(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
 {
     if (pre_interpret_hook) {
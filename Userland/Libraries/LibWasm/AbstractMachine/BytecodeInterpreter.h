@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/StackInfo.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
@@ -33,13 +35,34 @@ struct BytecodeInterpreter : public Interpreter {
     };
 
 protected:
+    // One instruction of a function body pre-decoded into a flat stream:
+    // a dense opcode id for threaded dispatch, with the hot immediates
+    // (locals/globals indices, constants, branch targets, memory offsets)
+    // pulled out of the Instruction's argument Variant up front. Anything
+    // rare keeps going through `source`. See BytecodeInterpreter.cpp for
+    // the dense opcode list.
+    struct PredecodedInstruction {
+        u16 dense_opcode { 0 };
+        u32 index { 0 };
+        u32 extra { 0 };
+        u64 payload { 0 };
+        Instruction const* source { nullptr };
+    };
+
+    struct PredecodedExpression {
+        Vector<PredecodedInstruction> instructions;
+    };
+
+    PredecodedExpression const& predecode(Expression const&);
+    void interpret_without_predecoding(Configuration&);
+
     virtual void interpret(Configuration&, InstructionPointer&, Instruction const&);
     void branch_to_label(Configuration&, LabelIndex);
     template<typename ReadT, typename PushT>
-    void load_and_push(Configuration&, Instruction const&);
+    void load_and_push(Configuration&, u64 memory_offset);
     template<typename PopT, typename StoreT>
-    void pop_and_store(Configuration&, Instruction const&);
-    void store_to_memory(Configuration&, Instruction const&, ReadonlyBytes data);
+    void pop_and_store(Configuration&, u64 memory_offset);
+    void store_to_memory(Configuration&, u64 memory_offset, ReadonlyBytes data);
     void call_address(Configuration&, FunctionAddress);
 
     template<typename PopType, typename PushType, typename Operator>
@@ -67,11 +90,18 @@ protected:
 
     Optional<Trap> m_trap;
     StackInfo m_stack_info;
+    // Keyed by Expression address; an entry becomes stale if its module is
+    // dropped while this interpreter is kept around, so don't do that.
+    HashMap<Expression const*, NonnullOwnPtr<PredecodedExpression>> m_predecoded_expressions;
 };
 
 struct DebuggerBytecodeInterpreter : public BytecodeInterpreter {
     virtual ~DebuggerBytecodeInterpreter() override = default;
 
+    // The hooks want to see every single instruction, so this interpreter
+    // sticks with the one-at-a-time dispatch loop.
+    virtual void interpret(Configuration&) override;
+
     Function<bool(Configuration&, InstructionPointer&, Instruction const&)> pre_interpret_hook;
     Function<bool(Configuration&, InstructionPointer&, Instruction const&, Interpreter const&)> post_interpret_hook;
 
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/CSS/AncestorFilter.h>
+#include <LibWeb/DOM/Element.h>
+#include <LibWeb/HTML/AttributeNames.h>
+
+namespace Web::CSS {
+
+// The different identifier kinds are salted so that e.g. a tag name <foo>
+// doesn't satisfy a selector looking for an ancestor with class "foo".
+static constexpr u32 salt_for_identifier_kind(AncestorFilter::IdentifierKind kind)
+{
+    switch (kind) {
+    case AncestorFilter::IdentifierKind::TagName:
+        return 0x1fa0u;
+    case AncestorFilter::IdentifierKind::Id:
+        return 0xbeef0u;
+    case AncestorFilter::IdentifierKind::Class:
+        return 0xc1a550u;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+u32 AncestorFilter::identifier_hash(FlyString const& value, IdentifierKind kind)
+{
+    return value.hash() ^ salt_for_identifier_kind(kind);
+}
+
+u32 AncestorFilter::identifier_hash(String const& value, IdentifierKind kind)
+{
+    return value.hash() ^ salt_for_identifier_kind(kind);
+}
+
+void AncestorFilter::add(DOM::Element const& element)
+{
+    insert(identifier_hash(element.local_name(), IdentifierKind::TagName));
+
+    auto id = element.attribute(HTML::AttributeNames::id);
+    if (!id.is_null())
+        insert(identifier_hash(id, IdentifierKind::Id));
+
+    for (auto& class_name : element.class_names())
+        insert(identifier_hash(class_name, IdentifierKind::Class));
+}
+
+}
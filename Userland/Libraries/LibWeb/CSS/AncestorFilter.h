@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/FlyString.h>
+#include <AK/Vector.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::CSS {
+
+// A bloom filter over the identifiers (tag names, ids and class names) of an
+// element's ancestor chain. A selector with descendant or child combinators
+// can only match if every identifier it requires of an ancestor is present in
+// the filter, so most candidate selectors on deep trees can be rejected with
+// a couple of bit tests instead of a walk up the tree. False positives just
+// mean we fall through to the regular matching code.
+class AncestorFilter {
+public:
+    AncestorFilter() = default;
+
+    enum class IdentifierKind {
+        TagName,
+        Id,
+        Class,
+    };
+
+    static u32 identifier_hash(FlyString const& value, IdentifierKind);
+    static u32 identifier_hash(String const& value, IdentifierKind);
+
+    void add(DOM::Element const&);
+
+    bool may_contain_all(Vector<u32> const& identifier_hashes) const
+    {
+        for (auto hash : identifier_hashes) {
+            if (!may_contain(hash))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    static constexpr u32 bit_count = 8192;
+    static constexpr u32 bit_mask = bit_count - 1;
+
+    void insert(u32 hash)
+    {
+        set_bit(hash & bit_mask);
+        set_bit((hash >> 13) & bit_mask);
+    }
+
+    bool may_contain(u32 hash) const
+    {
+        return test_bit(hash & bit_mask) && test_bit((hash >> 13) & bit_mask);
+    }
+
+    void set_bit(u32 index) { m_bits[index / 32] |= 1u << (index % 32); }
+    bool test_bit(u32 index) const { return (m_bits[index / 32] & (1u << (index % 32))) != 0; }
+
+    Array<u32, bit_count / 32> m_bits {};
+};
+
+}
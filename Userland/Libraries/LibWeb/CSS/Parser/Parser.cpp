@@ -37,22 +37,19 @@ ParsingContext::ParsingContext()
 
 ParsingContext::ParsingContext(DOM::Document& document)
     : m_document(&document)
+    , m_base_url(document.url())
+    , m_in_quirks_mode(document.in_quirks_mode())
 {
 }
 
 ParsingContext::ParsingContext(DOM::ParentNode& parent_node)
-    : m_document(&parent_node.document())
+    : ParsingContext(parent_node.document())
 {
 }
 
-bool ParsingContext::in_quirks_mode() const
-{
-    return m_document ? m_document->in_quirks_mode() : false;
-}
-
 URL ParsingContext::complete_url(String const& addr) const
 {
-    return m_document ? m_document->url().complete_url(addr) : URL::create_with_url_or_path(addr);
+    return m_base_url.is_valid() ? m_base_url.complete_url(addr) : URL::create_with_url_or_path(addr);
 }
 
 template<typename T>
@@ -1749,7 +1746,7 @@ RefPtr<StyleValue> Parser::parse_image_value(ParsingContext const& context, Styl
 {
     auto url = parse_url_function(context, component_value);
     if (url.has_value())
-        return ImageStyleValue::create(url.value(), *context.document());
+        return ImageStyleValue::create(url.value());
     // FIXME: Handle gradients.
 
     return {};
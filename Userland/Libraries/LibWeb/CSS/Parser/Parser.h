@@ -30,18 +30,23 @@ class CSSStyleRule;
 struct StyleProperty;
 enum class PropertyID;
 
+// Snapshots everything the parser needs from the document (base URL, quirks
+// mode) at construction time, so parsing itself never touches the document
+// and can safely run on a background thread.
 class ParsingContext {
 public:
     ParsingContext();
     explicit ParsingContext(DOM::Document&);
     explicit ParsingContext(DOM::ParentNode&);
 
-    bool in_quirks_mode() const;
+    bool in_quirks_mode() const { return m_in_quirks_mode; }
     DOM::Document* document() const { return m_document; }
     URL complete_url(String const&) const;
 
 private:
     DOM::Document* m_document { nullptr };
+    URL m_base_url;
+    bool m_in_quirks_mode { false };
 };
 
 template<typename T>
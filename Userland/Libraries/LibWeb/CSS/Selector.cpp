@@ -7,6 +7,7 @@
 #include "Selector.h"
 #include <AK/GenericLexer.h>
 #include <AK/StringUtils.h>
+#include <LibWeb/CSS/AncestorFilter.h>
 #include <ctype.h>
 
 namespace Web::CSS {
@@ -20,6 +21,47 @@ Selector::~Selector()
 {
 }
 
+Vector<u32> const& Selector::ancestor_identifier_hashes() const
+{
+    if (m_ancestor_identifier_hashes.has_value())
+        return *m_ancestor_identifier_hashes;
+
+    Vector<u32> hashes;
+
+    // Every compound selector to the left of the subject that is connected
+    // purely through descendant or child combinators must match an ancestor
+    // of the subject, so its tag name, id and class requirements have to be
+    // present in the ancestor filter. A sibling combinator breaks the chain:
+    // anything further left constrains a sibling's ancestry, not ours.
+    if (m_compound_selectors.size() > 1) {
+        size_t index = m_compound_selectors.size() - 1;
+        while (index > 0) {
+            auto combinator = m_compound_selectors[index].combinator;
+            if (combinator != Combinator::Descendant && combinator != Combinator::ImmediateChild)
+                break;
+            --index;
+            for (auto& simple_selector : m_compound_selectors[index].simple_selectors) {
+                switch (simple_selector.type) {
+                case SimpleSelector::Type::TagName:
+                    hashes.append(AncestorFilter::identifier_hash(simple_selector.value, AncestorFilter::IdentifierKind::TagName));
+                    break;
+                case SimpleSelector::Type::Id:
+                    hashes.append(AncestorFilter::identifier_hash(simple_selector.value, AncestorFilter::IdentifierKind::Id));
+                    break;
+                case SimpleSelector::Type::Class:
+                    hashes.append(AncestorFilter::identifier_hash(simple_selector.value, AncestorFilter::IdentifierKind::Class));
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+    }
+
+    m_ancestor_identifier_hashes = move(hashes);
+    return *m_ancestor_identifier_hashes;
+}
+
 u32 Selector::specificity() const
 {
     unsigned ids = 0;
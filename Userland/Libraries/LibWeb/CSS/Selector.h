@@ -132,10 +132,15 @@ public:
 
     u32 specificity() const;
 
+    // Hashes of identifiers that any matching element must have somewhere in
+    // its ancestor chain, for fast rejection via CSS::AncestorFilter.
+    Vector<u32> const& ancestor_identifier_hashes() const;
+
 private:
     explicit Selector(Vector<CompoundSelector>&&);
 
     Vector<CompoundSelector> m_compound_selectors;
+    mutable Optional<Vector<u32>> m_ancestor_identifier_hashes;
 };
 
 }
@@ -6,7 +6,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashTable.h>
 #include <AK/QuickSort.h>
+#include <LibWeb/CSS/AncestorFilter.h>
 #include <LibWeb/CSS/CSSStyleRule.h>
 #include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/SelectorEngine.h>
@@ -15,6 +17,7 @@
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
 #include <LibWeb/Dump.h>
+#include <LibWeb/HTML/AttributeNames.h>
 #include <ctype.h>
 #include <stdio.h>
 
@@ -62,27 +65,115 @@ void StyleResolver::for_each_stylesheet(Callback callback) const
     }
 }
 
-Vector<MatchingRule> StyleResolver::collect_matching_rules(DOM::Element const& element) const
+StyleResolver::RuleCache const& StyleResolver::rule_cache() const
 {
-    Vector<MatchingRule> matching_rules;
+    // The set of stylesheets changes when the quirks mode sheet kicks in, so
+    // a cache built under the other mode is no longer valid.
+    if (m_rule_cache && m_rule_cache->built_in_quirks_mode != document().in_quirks_mode())
+        m_rule_cache = nullptr;
+
+    if (m_rule_cache)
+        return *m_rule_cache;
+
+    m_rule_cache = make<RuleCache>();
+    m_rule_cache->built_in_quirks_mode = document().in_quirks_mode();
 
     size_t style_sheet_index = 0;
     for_each_stylesheet([&](auto& sheet) {
         size_t rule_index = 0;
         static_cast<CSSStyleSheet const&>(sheet).for_each_effective_style_rule([&](auto& rule) {
-            size_t selector_index = 0;
             for (auto& selector : rule.selectors()) {
-                if (SelectorEngine::matches(selector, element)) {
-                    matching_rules.append({ rule, style_sheet_index, rule_index, selector_index, selector.specificity() });
-                    break;
+                // File the rule under the most selective identifier that its
+                // subject (rightmost) compound selector requires of the
+                // element: an id beats a class, which beats a tag name.
+                // Selectors whose subject requires none of these go into the
+                // catch-all bucket that every element has to test.
+                FlyString const* id_key = nullptr;
+                FlyString const* class_key = nullptr;
+                FlyString const* tag_name_key = nullptr;
+                if (!selector.compound_selectors().is_empty()) {
+                    for (auto& simple_selector : selector.compound_selectors().last().simple_selectors) {
+                        if (simple_selector.type == Selector::SimpleSelector::Type::Id && !id_key)
+                            id_key = &simple_selector.value;
+                        else if (simple_selector.type == Selector::SimpleSelector::Type::Class && !class_key)
+                            class_key = &simple_selector.value;
+                        else if (simple_selector.type == Selector::SimpleSelector::Type::TagName && !tag_name_key)
+                            tag_name_key = &simple_selector.value;
+                    }
                 }
-                ++selector_index;
+                RuleCache::Entry entry { rule, style_sheet_index, rule_index };
+                if (id_key)
+                    m_rule_cache->rules_by_id.ensure(*id_key).append(move(entry));
+                else if (class_key)
+                    m_rule_cache->rules_by_class.ensure(*class_key).append(move(entry));
+                else if (tag_name_key)
+                    m_rule_cache->rules_by_tag_name.ensure(*tag_name_key).append(move(entry));
+                else
+                    m_rule_cache->other_rules.append(move(entry));
             }
             ++rule_index;
         });
         ++style_sheet_index;
     });
 
+    return *m_rule_cache;
+}
+
+void StyleResolver::invalidate_rule_cache()
+{
+    m_rule_cache = nullptr;
+}
+
+Vector<MatchingRule> StyleResolver::collect_matching_rules(DOM::Element const& element) const
+{
+    Vector<MatchingRule> matching_rules;
+
+    // Collect the element's ancestor identifiers once, so selectors with
+    // descendant combinators can be rejected without walking up the tree for
+    // each of them.
+    CSS::AncestorFilter ancestor_filter;
+    for (auto* ancestor = element.parent_element(); ancestor; ancestor = ancestor->parent_element())
+        ancestor_filter.add(*ancestor);
+
+    auto& cache = rule_cache();
+
+    // A rule with several selectors can sit in more than one bucket, so keep
+    // track of the rules we've already tested to avoid matching them twice.
+    HashTable<CSSStyleRule const*> visited_rules;
+
+    auto try_match_rules = [&](Vector<RuleCache::Entry> const& entries) {
+        for (auto& entry : entries) {
+            if (visited_rules.contains(entry.rule.ptr()))
+                continue;
+            visited_rules.set(entry.rule.ptr());
+            size_t selector_index = 0;
+            for (auto& selector : entry.rule->selectors()) {
+                if (!ancestor_filter.may_contain_all(selector.ancestor_identifier_hashes())) {
+                    ++selector_index;
+                    continue;
+                }
+                if (SelectorEngine::matches(selector, element)) {
+                    matching_rules.append({ entry.rule, entry.style_sheet_index, entry.rule_index, selector_index, selector.specificity() });
+                    break;
+                }
+                ++selector_index;
+            }
+        }
+    };
+
+    auto id = element.attribute(HTML::AttributeNames::id);
+    if (!id.is_null()) {
+        if (auto it = cache.rules_by_id.find(id); it != cache.rules_by_id.end())
+            try_match_rules(it->value);
+    }
+    for (auto& class_name : element.class_names()) {
+        if (auto it = cache.rules_by_class.find(class_name); it != cache.rules_by_class.end())
+            try_match_rules(it->value);
+    }
+    if (auto it = cache.rules_by_tag_name.find(element.local_name()); it != cache.rules_by_tag_name.end())
+        try_match_rules(it->value);
+    try_match_rules(cache.other_rules);
+
     return matching_rules;
 }
 
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <AK/NonnullRefPtrVector.h>
 #include <AK/OwnPtr.h>
 #include <LibWeb/CSS/CSSStyleDeclaration.h>
@@ -41,11 +42,34 @@ public:
     CustomPropertyResolutionTuple resolve_custom_property_with_specificity(DOM::Element&, String const&) const;
     Optional<StyleProperty> resolve_custom_property(DOM::Element&, String const&) const;
 
+    // Must be called whenever the set of style rules changes (a sheet is
+    // added or removed, or an @import finishes loading.)
+    void invalidate_rule_cache();
+
 private:
     template<typename Callback>
     void for_each_stylesheet(Callback) const;
 
+    // Style rules bucketed by the id, class or tag name that their rightmost
+    // compound selector requires. An element only has to test the buckets for
+    // its own id, classes and tag name (plus the catch-all bucket), instead
+    // of every rule in every sheet.
+    struct RuleCache {
+        struct Entry {
+            NonnullRefPtr<CSSStyleRule> rule;
+            size_t style_sheet_index { 0 };
+            size_t rule_index { 0 };
+        };
+        HashMap<FlyString, Vector<Entry>> rules_by_id;
+        HashMap<FlyString, Vector<Entry>> rules_by_class;
+        HashMap<FlyString, Vector<Entry>> rules_by_tag_name;
+        Vector<Entry> other_rules;
+        bool built_in_quirks_mode { false };
+    };
+    RuleCache const& rule_cache() const;
+
     DOM::Document& m_document;
+    mutable OwnPtr<RuleCache> m_rule_cache;
 };
 
 }
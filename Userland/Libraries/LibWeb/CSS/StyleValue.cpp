@@ -152,12 +152,18 @@ Color IdentifierStyleValue::to_color(const DOM::Document& document) const
     }
 }
 
-ImageStyleValue::ImageStyleValue(const URL& url, DOM::Document& document)
+ImageStyleValue::ImageStyleValue(const URL& url)
     : StyleValue(Type::Image)
     , m_url(url)
-    , m_document(document)
 {
-    auto request = LoadRequest::create_for_url_on_page(url, document.page());
+}
+
+void ImageStyleValue::load_bitmap(DOM::Document& document)
+{
+    if (resource())
+        return;
+    m_document = document;
+    auto request = LoadRequest::create_for_url_on_page(m_url, document.page());
     set_resource(ResourceLoader::the().load_resource(Resource::Type::Image, request));
 }
 
@@ -651,15 +651,21 @@ class ImageStyleValue final
     : public StyleValue
     , public ImageResourceClient {
 public:
-    static NonnullRefPtr<ImageStyleValue> create(const URL& url, DOM::Document& document) { return adopt_ref(*new ImageStyleValue(url, document)); }
+    static NonnullRefPtr<ImageStyleValue> create(const URL& url) { return adopt_ref(*new ImageStyleValue(url)); }
     virtual ~ImageStyleValue() override { }
 
     String to_string() const override { return String::formatted("Image({})", m_url.to_string()); }
 
     const Gfx::Bitmap* bitmap() const { return m_bitmap; }
 
+    // Starts the image fetch. Deliberately not done at construction: style
+    // values may be created during off-main-thread stylesheet parsing, so
+    // loading (which touches the document and the event loop) waits until
+    // the style is applied.
+    void load_bitmap(DOM::Document&);
+
 private:
-    ImageStyleValue(const URL&, DOM::Document&);
+    explicit ImageStyleValue(const URL&);
 
     // ^ResourceClient
     virtual void resource_did_load() override;
@@ -391,26 +391,130 @@ void Document::invalidate_layout()
     tear_down_layout_tree();
 }
 
+// Invalidates layout after a localized DOM mutation. Instead of throwing the
+// whole layout tree away, we rebuild only the layout nodes for the mutated
+// DOM subtree and mark the surrounding containing block chain as needing
+// layout, so update_layout() can scope the relayout accordingly.
+void Document::invalidate_subtree_layout(Node& node)
+{
+    // No layout tree yet; the next update_layout() will build everything.
+    if (!m_layout_root)
+        return;
+
+    Node* subtree_root = &node;
+    while (subtree_root && !subtree_root->layout_node())
+        subtree_root = subtree_root->parent_or_shadow_host();
+    if (!subtree_root || subtree_root == this) {
+        invalidate_layout();
+        return;
+    }
+
+    auto& subtree_layout_root = *subtree_root->layout_node();
+
+    // The rebuild below may destroy boxes that have stacking contexts (which
+    // would leave dangling child pointers in the enclosing contexts) and
+    // create boxes that need new ones, so drop the whole stacking context
+    // tree up front; update_layout() rebuilds it after relayout.
+    m_layout_root->for_each_in_inclusive_subtree_of_type<Layout::Box>([](auto& box) {
+        box.clear_stacking_context();
+        return IterationDecision::Continue;
+    });
+
+    // Drop the now-stale layout children (including any that belonged to DOM
+    // nodes that have since been removed) and regenerate them from the DOM.
+    while (auto* child = subtree_layout_root.first_child())
+        subtree_layout_root.remove_child(*child);
+    if (is<ParentNode>(*subtree_root) && subtree_layout_root.can_have_children()) {
+        verify_cast<ParentNode>(*subtree_root).for_each_child([&](auto& dom_child) {
+            Layout::TreeBuilder tree_builder;
+            (void)tree_builder.build(dom_child);
+        });
+    }
+
+    subtree_layout_root.set_needs_layout();
+}
+
 void Document::force_layout()
 {
     invalidate_layout();
     update_layout();
 }
 
+// Picks the box to relay out: normally the initial containing block, but when
+// only a single subtree is dirty and it sits inside a box that establishes its
+// own block formatting context and has definite dimensions, relaying out that
+// box cannot affect anything outside it, so we start there instead.
+Layout::Box& Document::find_relayout_root()
+{
+    // Find the lowest common ancestor of everything that needs layout.
+    Layout::Node* candidate = m_layout_root;
+    while (!candidate->needs_layout()) {
+        Layout::Node* dirty_child = nullptr;
+        bool multiple_dirty_children = false;
+        candidate->for_each_child([&](auto& child) {
+            if (child.needs_layout() || child.child_needs_layout()) {
+                if (dirty_child)
+                    multiple_dirty_children = true;
+                dirty_child = &child;
+            }
+        });
+        if (!dirty_child || multiple_dirty_children)
+            break;
+        candidate = dirty_child;
+    }
+
+    for (auto* ancestor = candidate; ancestor; ancestor = ancestor->parent()) {
+        if (!is<Layout::Box>(*ancestor))
+            continue;
+        auto& box = verify_cast<Layout::Box>(*ancestor);
+        if (box.is_initial_containing_block_box())
+            break;
+        if (box.is_anonymous() || !box.has_style())
+            continue;
+        if (!Layout::FormattingContext::creates_block_formatting_context(box))
+            continue;
+        if (!box.computed_values().width().is_absolute() || !box.computed_values().height().is_absolute())
+            continue;
+        return box;
+    }
+    return *m_layout_root;
+}
+
 void Document::update_layout()
 {
     if (!browsing_context())
         return;
 
+    // Nothing has been marked dirty since the last pass, so the current
+    // layout is still valid.
+    if (m_layout_root && !m_layout_root->needs_layout() && !m_layout_root->child_needs_layout())
+        return;
+
     if (!m_layout_root) {
         Layout::TreeBuilder tree_builder;
         m_layout_root = static_ptr_cast<Layout::InitialContainingBlockBox>(tree_builder.build(*this));
+        m_layout_root->set_needs_layout();
     }
 
-    Layout::BlockFormattingContext root_formatting_context(*m_layout_root, nullptr);
-    root_formatting_context.run(*m_layout_root, Layout::LayoutMode::Default);
+    auto& relayout_root = find_relayout_root();
+    Layout::BlockFormattingContext root_formatting_context(relayout_root, nullptr);
+    root_formatting_context.run(relayout_root, Layout::LayoutMode::Default);
+
+    // No-op unless invalidate_subtree_layout() dropped the context tree.
+    m_layout_root->build_stacking_context_tree();
+
+    // Refresh the per-box paint bounding boxes so the painter can cull
+    // offscreen subtrees against the viewport.
+    m_layout_root->recompute_paint_bounding_box();
+
+    relayout_root.for_each_in_inclusive_subtree([](auto& node) {
+        node.clear_needs_layout();
+        return IterationDecision::Continue;
+    });
+    for (auto* ancestor = relayout_root.parent(); ancestor; ancestor = ancestor->parent())
+        ancestor->set_child_needs_layout(false);
 
-    m_layout_root->set_needs_display();
+    relayout_root.set_needs_display();
 
     if (browsing_context()->is_top_level()) {
         if (auto* page = this->page())
@@ -141,6 +141,7 @@ public:
 
     void force_layout();
     void invalidate_layout();
+    void invalidate_subtree_layout(Node&);
 
     void update_style();
     void update_layout();
@@ -280,6 +281,7 @@ private:
     virtual EventTarget& global_event_handlers_to_event_target() final { return *this; }
 
     void tear_down_layout_tree();
+    Layout::Box& find_relayout_root();
 
     void increment_referencing_node_count()
     {
@@ -263,7 +263,7 @@ void Element::set_inner_html(StringView markup)
     }
 
     set_needs_style_update(true);
-    document().invalidate_layout();
+    document().invalidate_subtree_layout(*this);
 }
 
 String Element::inner_html() const
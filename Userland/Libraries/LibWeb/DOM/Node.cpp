@@ -140,7 +140,7 @@ void Node::set_text_content(String const& content)
     }
 
     set_needs_style_update(true);
-    document().invalidate_layout();
+    document().invalidate_subtree_layout(*this);
 }
 
 RefPtr<Layout::Node> Node::create_layout_node()
@@ -95,7 +95,7 @@ void HTMLElement::set_inner_text(StringView text)
     append_child(document().create_text_node(text));
 
     set_needs_style_update(true);
-    document().invalidate_layout();
+    document().invalidate_subtree_layout(*this);
 }
 
 String HTMLElement::inner_text()
@@ -23,6 +23,7 @@
 #include <LibWeb/HTML/HTMLTemplateElement.h>
 #include <LibWeb/HTML/Parser/HTMLDocumentParser.h>
 #include <LibWeb/HTML/Parser/HTMLEncodingDetection.h>
+#include <LibWeb/HTML/Parser/HTMLPreloadScanner.h>
 #include <LibWeb/HTML/Parser/HTMLToken.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/SVG/TagNames.h>
@@ -120,6 +121,13 @@ void HTMLDocumentParser::run(const URL& url)
     m_document->set_url(url);
     m_document->set_source(m_tokenizer.source());
 
+    // Scan ahead of the tree builder for fetchable resources, so their loads
+    // are in flight while we parse (and while parsing blocks on scripts.)
+    // Fragment parsing (for e.g. innerHTML) uses detached documents without a
+    // page; there's nothing useful to preload for those.
+    if (m_document->page())
+        HTMLPreloadScanner::scan_and_preload(document(), m_tokenizer.source());
+
     for (;;) {
         auto optional_token = m_tokenizer.next_token();
         if (!optional_token.has_value())
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/Parser/HTMLPreloadScanner.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Loader/ResourceLoader.h>
+
+namespace Web::HTML {
+
+static void preload_url(DOM::Document& document, URL const& url, Resource::Type type)
+{
+    if (!url.is_valid())
+        return;
+    // Fire and forget: the resource cache keeps the fetch alive, and the
+    // element's own loader picks the response up from there once the tree
+    // builder reaches it. A speculated URL that turns out to be unused just
+    // ages out of the cache.
+    auto request = LoadRequest::create_for_url_on_page(url, document.page());
+    (void)ResourceLoader::the().load_resource(type, request);
+}
+
+void HTMLPreloadScanner::scan_and_preload(DOM::Document& document, StringView const& input)
+{
+    HTMLTokenizer tokenizer(input, "utf-8");
+    for (;;) {
+        auto token = tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+        if (!token->is_start_tag())
+            continue;
+
+        auto& tag_name = token->tag_name();
+
+        // Mirror the tree builder's tokenizer state switches so that script
+        // and style payloads aren't misinterpreted as markup.
+        if (tag_name == TagNames::title || tag_name == TagNames::textarea) {
+            tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+            continue;
+        }
+        if (tag_name == TagNames::style || tag_name == TagNames::xmp || tag_name == TagNames::iframe || tag_name == TagNames::noembed || tag_name == TagNames::noframes) {
+            tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+            continue;
+        }
+
+        if (tag_name == TagNames::script) {
+            tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+            auto src = token->attribute(AttributeNames::src);
+            if (!src.is_empty())
+                preload_url(document, document.complete_url(src), Resource::Type::Generic);
+        } else if (tag_name == TagNames::img) {
+            auto src = token->attribute(AttributeNames::src);
+            if (!src.is_empty())
+                preload_url(document, document.complete_url(src), Resource::Type::Image);
+        } else if (tag_name == TagNames::link) {
+            // Only the link types that HTMLLinkElement fetches during parsing.
+            auto rel = token->attribute(AttributeNames::rel);
+            auto href = token->attribute(AttributeNames::href);
+            if (!href.is_empty() && (rel.equals_ignoring_case("stylesheet") || rel.equals_ignoring_case("icon")))
+                preload_url(document, document.complete_url(href), Resource::Type::Generic);
+        }
+    }
+}
+
+}
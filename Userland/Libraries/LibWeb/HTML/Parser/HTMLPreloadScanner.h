@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Forward.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::HTML {
+
+// Tokenizes document source independently of the tree builder and starts
+// fetches for the <img>, <script src> and <link> resources it discovers, so
+// their network latency overlaps with parsing (and with the synchronous
+// script loads that block it) instead of being paid one at a time as the
+// tree builder reaches each element.
+class HTMLPreloadScanner {
+public:
+    static void scan_and_preload(DOM::Document&, StringView const& input);
+};
+
+}
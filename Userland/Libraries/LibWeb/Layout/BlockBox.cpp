@@ -52,6 +52,11 @@ void BlockBox::paint(PaintContext& context, PaintPhase phase)
 
     for (auto& line_box : m_line_boxes) {
         for (auto& fragment : line_box.fragments()) {
+            // Skip fragments that are entirely outside the viewport. On huge
+            // documents most fragments are offscreen, and walking them is
+            // much cheaper than rasterizing them.
+            if (!context.viewport_rect().intersects(enclosing_int_rect(fragment.absolute_rect().translated(-m_scroll_offset))))
+                continue;
             if (context.should_show_line_box_borders())
                 context.painter().draw_rect(enclosing_int_rect(fragment.absolute_rect()), Color::Green);
             fragment.paint(context, phase);
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Function.h>
 #include <LibGfx/DisjointRectSet.h>
 #include <LibGfx/Filters/FastBoxBlurFilter.h>
 #include <LibGfx/Painter.h>
@@ -14,6 +15,7 @@
 #include <LibWeb/Layout/Box.h>
 #include <LibWeb/Page/BrowsingContext.h>
 #include <LibWeb/Painting/BorderPainting.h>
+#include <LibWeb/Painting/StackingContext.h>
 
 namespace Web::Layout {
 
@@ -334,6 +336,7 @@ HitTestResult Box::hit_test(const Gfx::IntPoint& position, HitTestType type) con
 void Box::set_needs_display()
 {
     if (!is_inline()) {
+        invalidate_stacking_context_layers();
         browsing_context().set_needs_display(enclosing_int_rect(absolute_rect()));
         return;
     }
@@ -351,6 +354,7 @@ void Box::set_offset(const Gfx::FloatPoint& offset)
     if (m_offset == offset)
         return;
     m_offset = offset;
+    invalidate_stacking_context_layers();
     did_set_rect();
 }
 
@@ -359,6 +363,7 @@ void Box::set_size(const Gfx::FloatSize& size)
     if (m_size == size)
         return;
     m_size = size;
+    invalidate_stacking_context_layers();
     did_set_rect();
 }
 
@@ -383,6 +388,76 @@ void Box::set_containing_line_box_fragment(LineBoxFragment& fragment)
     m_containing_line_box_fragment = fragment.make_weak_ptr();
 }
 
+void Box::clear_stacking_context()
+{
+    m_stacking_context = nullptr;
+}
+
+Gfx::FloatRect Box::recompute_paint_bounding_box()
+{
+    // Margins are included so the inspector overlay stays visible, and the
+    // box shadow extent matches what paint_box_shadow() actually rasterizes.
+    auto margin_box = box_model().margin_box();
+    Gfx::FloatRect bounding_box = {
+        absolute_x() - margin_box.left,
+        absolute_y() - margin_box.top,
+        width() + margin_box.left + margin_box.right,
+        height() + margin_box.top + margin_box.bottom,
+    };
+    bounding_box = bounding_box.united(bordered_rect());
+
+    if (auto box_shadow = computed_values().box_shadow(); box_shadow.has_value()) {
+        auto offset_x = box_shadow->offset_x.resolved_or_zero(*this, width()).to_px(*this);
+        auto offset_y = box_shadow->offset_y.resolved_or_zero(*this, width()).to_px(*this);
+        auto blur_radius = box_shadow->blur_radius.resolved_or_zero(*this, width()).to_px(*this);
+        auto shadow_rect = bordered_rect().inflated(4 * blur_radius, 4 * blur_radius).translated(offset_x, offset_y);
+        bounding_box = bounding_box.united(shadow_rect);
+    }
+
+    if (is<BlockBox>(*this)) {
+        verify_cast<BlockBox>(*this).for_each_fragment([&](auto& fragment) {
+            bounding_box = bounding_box.united(fragment.absolute_rect());
+            return IterationDecision::Continue;
+        });
+    }
+
+    m_subtree_contains_fixed_position = is_fixed_position();
+
+    // Non-box children (inline nodes, text) paint through their containing
+    // block's line box fragments, but they can still have box descendants
+    // (inline-block, replaced elements), so look through them.
+    Function<void(Node&)> recurse_through_non_boxes = [&](Node& node) {
+        node.for_each_child([&](auto& child) {
+            if (is<Box>(child)) {
+                auto& child_box = verify_cast<Box>(child);
+                bounding_box = bounding_box.united(child_box.recompute_paint_bounding_box());
+                if (child_box.subtree_contains_fixed_position())
+                    m_subtree_contains_fixed_position = true;
+            } else {
+                recurse_through_non_boxes(child);
+            }
+        });
+    };
+    recurse_through_non_boxes(*this);
+
+    m_paint_bounding_box = bounding_box;
+    m_paint_bounding_box_valid = true;
+    return bounding_box;
+}
+
+bool Box::is_out_of_view(PaintContext& context) const
+{
+    if (!m_paint_bounding_box_valid)
+        return false;
+
+    // Fixed-position content paints at a scroll-dependent offset, so its
+    // document-space bounds say nothing about where it ends up on screen.
+    if (m_subtree_contains_fixed_position)
+        return false;
+
+    return !context.viewport_rect().intersects(enclosing_int_rect(m_paint_bounding_box));
+}
+
 StackingContext* Box::enclosing_stacking_context()
 {
     for (auto* ancestor = parent(); ancestor; ancestor = ancestor->parent()) {
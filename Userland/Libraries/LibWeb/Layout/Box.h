@@ -100,6 +100,11 @@ public:
     virtual HitTestResult hit_test(const Gfx::IntPoint&, HitTestType) const override;
     virtual void set_needs_display() override;
 
+    Gfx::FloatRect recompute_paint_bounding_box();
+    const Gfx::FloatRect& paint_bounding_box() const { return m_paint_bounding_box; }
+    bool subtree_contains_fixed_position() const { return m_subtree_contains_fixed_position; }
+    bool is_out_of_view(PaintContext&) const;
+
     bool is_body() const;
 
     void set_containing_line_box_fragment(LineBoxFragment&);
@@ -107,6 +112,7 @@ public:
     StackingContext* stacking_context() { return m_stacking_context; }
     const StackingContext* stacking_context() const { return m_stacking_context; }
     void set_stacking_context(NonnullOwnPtr<StackingContext> context) { m_stacking_context = move(context); }
+    void clear_stacking_context();
     StackingContext* enclosing_stacking_context();
 
     virtual void paint(PaintContext&, PaintPhase) override;
@@ -158,6 +164,13 @@ private:
     // Some boxes hang off of line box fragments. (inline-block, inline-table, replaced, etc)
     WeakPtr<LineBoxFragment> m_containing_line_box_fragment;
 
+    // Everything this box and its inclusive subtree can paint falls within
+    // this rect. Recomputed after layout; used to cull paint traversal of
+    // subtrees that are entirely outside the viewport.
+    Gfx::FloatRect m_paint_bounding_box;
+    bool m_paint_bounding_box_valid { false };
+    bool m_subtree_contains_fixed_position { false };
+
     OwnPtr<StackingContext> m_stacking_context;
 };
 
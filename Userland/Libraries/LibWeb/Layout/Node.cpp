@@ -16,6 +16,7 @@
 #include <LibWeb/Layout/Node.h>
 #include <LibWeb/Layout/TextNode.h>
 #include <LibWeb/Page/BrowsingContext.h>
+#include <LibWeb/Painting/StackingContext.h>
 #include <typeinfo>
 
 namespace Web::Layout {
@@ -34,6 +35,16 @@ Node::~Node()
         m_dom_node->set_layout_node({}, nullptr);
 }
 
+void Node::set_needs_layout()
+{
+    m_needs_layout = true;
+    for (auto* ancestor = parent(); ancestor; ancestor = ancestor->parent()) {
+        if (ancestor->m_child_needs_layout)
+            break;
+        ancestor->m_child_needs_layout = true;
+    }
+}
+
 bool Node::can_contain_boxes_with_position_absolute() const
 {
     return computed_values().position() != CSS::Position::Static || is<InitialContainingBlockBox>(*this);
@@ -139,8 +150,21 @@ void Node::split_into_lines(InlineFormattingContext& context, LayoutMode layout_
     });
 }
 
+void Node::invalidate_stacking_context_layers()
+{
+    for (auto* node = this; node; node = node->parent()) {
+        if (!is<Box>(*node))
+            continue;
+        if (auto* stacking_context = verify_cast<Box>(*node).stacking_context()) {
+            stacking_context->invalidate_cached_layers();
+            return;
+        }
+    }
+}
+
 void Node::set_needs_display()
 {
+    invalidate_stacking_context_layers();
     if (auto* block = containing_block()) {
         block->for_each_fragment([&](auto& fragment) {
             if (&fragment.layout_node() == this || is_ancestor_of(fragment.layout_node())) {
@@ -235,6 +259,7 @@ void NodeWithStyle::apply_style(const CSS::StyleProperties& specified_style)
     auto bgimage = specified_style.property(CSS::PropertyID::BackgroundImage);
     if (bgimage.has_value() && bgimage.value()->is_image()) {
         m_background_image = static_ptr_cast<CSS::ImageStyleValue>(bgimage.value());
+        m_background_image->load_bitmap(document());
     }
 
     // FIXME: BorderXRadius properties are now BorderRadiusStyleValues, so make use of that.
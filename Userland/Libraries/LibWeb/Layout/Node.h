@@ -82,6 +82,20 @@ public:
     bool is_inline() const { return m_inline; }
     void set_inline(bool b) { m_inline = b; }
 
+    // Layout dirty bits, mirroring the style update bits on DOM::Node:
+    // needs_layout means this node's subtree must be laid out again, while
+    // child_needs_layout means some descendant needs it. Document::update_layout()
+    // uses these to scope relayout to the affected part of the tree.
+    bool needs_layout() const { return m_needs_layout; }
+    bool child_needs_layout() const { return m_child_needs_layout; }
+    void set_needs_layout();
+    void set_child_needs_layout(bool b) { m_child_needs_layout = b; }
+    void clear_needs_layout()
+    {
+        m_needs_layout = false;
+        m_child_needs_layout = false;
+    }
+
     bool is_inline_block() const;
 
     virtual bool wants_mouse_events() const { return false; }
@@ -137,6 +151,10 @@ public:
 
     virtual void set_needs_display();
 
+    // Drops the cached paint layer of the nearest enclosing stacking context
+    // (and its ancestors), so the next paint re-rasterizes this node.
+    void invalidate_stacking_context_layers();
+
     bool children_are_inline() const { return m_children_are_inline; }
     void set_children_are_inline(bool value) { m_children_are_inline = value; }
 
@@ -182,6 +200,8 @@ private:
     RefPtr<DOM::Node> m_dom_node;
 
     bool m_inline { false };
+    bool m_needs_layout { false };
+    bool m_child_needs_layout { false };
     bool m_has_style { false };
     bool m_visible { true };
     bool m_children_are_inline { false };
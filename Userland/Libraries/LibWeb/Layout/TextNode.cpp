@@ -196,6 +196,45 @@ void TextNode::compute_text_for_rendering(bool collapse, bool previous_is_empty_
     m_text_for_rendering = builder.to_string();
 }
 
+// Chunk boundaries and advance widths depend only on the rendered text, the
+// font, and the splitting flags - not on the available width - so they can be
+// reused across layout passes (window resizes, incremental relayouts) as long
+// as none of those inputs changed. Measuring text is one of the most
+// expensive parts of layout, so the bookkeeping pays for itself quickly.
+Vector<TextNode::MeasuredChunk> const& TextNode::measured_chunks(Gfx::Font const& font, LayoutMode layout_mode, bool do_wrap_lines, bool do_respect_linebreaks)
+{
+    if (m_measured_chunk_cache.has_value()
+        && m_measured_chunk_cache->font == &font
+        && m_measured_chunk_cache->text == m_text_for_rendering
+        && m_measured_chunk_cache->layout_mode == layout_mode
+        && m_measured_chunk_cache->wrap_lines == do_wrap_lines
+        && m_measured_chunk_cache->respect_linebreaks == do_respect_linebreaks) {
+        return m_measured_chunk_cache->chunks;
+    }
+
+    MeasuredChunkCache cache;
+    cache.font = font;
+    cache.text = m_text_for_rendering;
+    cache.layout_mode = layout_mode;
+    cache.wrap_lines = do_wrap_lines;
+    cache.respect_linebreaks = do_respect_linebreaks;
+
+    ChunkIterator iterator(cache.text, layout_mode, do_wrap_lines, do_respect_linebreaks);
+    for (;;) {
+        auto chunk_opt = iterator.next();
+        if (!chunk_opt.has_value())
+            break;
+        MeasuredChunk measured { chunk_opt.release_value(), 0, 0 };
+        measured.width = font.width(measured.chunk.view);
+        if (measured.chunk.view.byte_length() > 0 && is_ascii_space(*measured.chunk.view.begin()))
+            measured.width_without_leading_character = font.width(measured.chunk.view.substring_view(1, measured.chunk.view.byte_length() - 1));
+        cache.chunks.append(move(measured));
+    }
+
+    m_measured_chunk_cache = move(cache);
+    return m_measured_chunk_cache->chunks;
+}
+
 void TextNode::split_into_lines_by_rules(InlineFormattingContext& context, LayoutMode layout_mode, bool do_collapse, bool do_wrap_lines, bool do_respect_linebreaks)
 {
     auto& containing_block = context.containing_block();
@@ -207,13 +246,10 @@ void TextNode::split_into_lines_by_rules(InlineFormattingContext& context, Layou
     float available_width = context.available_width_at_line(line_boxes.size() - 1) - line_boxes.last().width();
 
     compute_text_for_rendering(do_collapse, line_boxes.last().is_empty_or_ends_in_whitespace());
-    ChunkIterator iterator(m_text_for_rendering, layout_mode, do_wrap_lines, do_respect_linebreaks);
 
-    for (;;) {
-        auto chunk_opt = iterator.next();
-        if (!chunk_opt.has_value())
-            break;
-        auto& chunk = chunk_opt.value();
+    for (auto measured_chunk : measured_chunks(font, layout_mode, do_wrap_lines, do_respect_linebreaks)) {
+        auto& chunk = measured_chunk.chunk;
+        float measured_width = measured_chunk.width;
 
         // Collapse entire fragment into non-existence if previous fragment on line ended in whitespace.
         if (do_collapse && line_boxes.last().is_empty_or_ends_in_whitespace() && chunk.is_all_whitespace)
@@ -228,9 +264,10 @@ void TextNode::split_into_lines_by_rules(InlineFormattingContext& context, Layou
                 ++chunk.start;
                 --chunk.length;
                 chunk.view = chunk.view.substring_view(1, chunk.view.byte_length() - 1);
+                measured_width = measured_chunk.width_without_leading_character;
             }
 
-            chunk_width = font.width(chunk.view) + font.glyph_spacing();
+            chunk_width = measured_width + font.glyph_spacing();
 
             if (line_boxes.last().width() > 0 && chunk_width > available_width) {
                 containing_block.add_line_box();
@@ -240,7 +277,7 @@ void TextNode::split_into_lines_by_rules(InlineFormattingContext& context, Layou
                     continue;
             }
         } else {
-            chunk_width = font.width(chunk.view);
+            chunk_width = measured_width;
         }
 
         line_boxes.last().add_fragment(*this, chunk.start, chunk.length, chunk_width, font.glyph_height());
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Utf8View.h>
+#include <LibGfx/Font.h>
 #include <LibWeb/DOM/Text.h>
 #include <LibWeb/Layout/Node.h>
 
@@ -54,6 +55,14 @@ public:
 
     void compute_text_for_rendering(bool collapse, bool previous_is_empty_or_ends_in_whitespace);
 
+    struct MeasuredChunk {
+        Chunk chunk;
+        float width { 0 };
+        // Only meaningful when the chunk starts with collapsible whitespace
+        // that line splitting may strip.
+        float width_without_leading_character { 0 };
+    };
+
 private:
     virtual bool is_text_node() const final { return true; }
     virtual bool wants_mouse_events() const override;
@@ -64,7 +73,21 @@ private:
     void paint_cursor_if_needed(PaintContext&, const LineBoxFragment&) const;
     void paint_text_decoration(Gfx::Painter&, LineBoxFragment const&) const;
 
+    Vector<MeasuredChunk> const& measured_chunks(Gfx::Font const&, LayoutMode, bool do_wrap_lines, bool do_respect_linebreaks);
+
     String m_text_for_rendering;
+
+    // Measured chunks from the last layout pass; the chunk views point into
+    // the "text" member, which keeps their buffer alive.
+    struct MeasuredChunkCache {
+        RefPtr<Gfx::Font const> font;
+        String text;
+        LayoutMode layout_mode { LayoutMode::Default };
+        bool wrap_lines { false };
+        bool respect_linebreaks { false };
+        Vector<MeasuredChunk> chunks;
+    };
+    Optional<MeasuredChunkCache> m_measured_chunk_cache;
 };
 
 template<>
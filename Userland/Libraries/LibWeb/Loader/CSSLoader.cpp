@@ -7,8 +7,10 @@
 #include <AK/Debug.h>
 #include <AK/URL.h>
 #include <LibWeb/CSS/Parser/Parser.h>
+#include <LibWeb/CSS/StyleResolver.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibThreading/BackgroundAction.h>
 #include <LibWeb/Loader/CSSLoader.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 
@@ -49,25 +51,41 @@ void CSSLoader::resource_did_load()
         dbgln_if(CSS_LOADER_DEBUG, "CSSLoader: Resource did load, has encoded data. URL: {}", resource()->url());
     }
 
-    auto sheet = parse_css(CSS::ParsingContext(m_owner_element.document()), resource()->encoded_data());
-    if (!sheet) {
-        dbgln_if(CSS_LOADER_DEBUG, "CSSLoader: Failed to parse stylesheet: {}", resource()->url());
-        return;
-    }
-
-    bool was_imported = m_style_sheet->for_first_not_loaded_import_rule([&](auto& rule) {
-        rule.set_style_sheet(sheet);
-    });
-
-    // Transfer the rules from the successfully parsed sheet into the sheet we've already inserted.
-    if (!was_imported) {
-        m_style_sheet->rules() = sheet->rules();
-    }
-
-    if (on_load)
-        on_load();
-
-    load_next_import_if_needed();
+    // Parse on a background thread: ParsingContext snapshots everything it
+    // needs from the document up front and the parser no longer touches
+    // document state, so the main thread can keep parsing HTML and painting
+    // while (possibly multiple) stylesheets are parsed. The protector keeps
+    // the owner element (and thereby this CSSLoader) alive until completion.
+    auto parsing_context = CSS::ParsingContext(m_owner_element.document());
+    auto protector = NonnullRefPtr<DOM::Element>(m_owner_element);
+    Threading::BackgroundAction<RefPtr<CSS::CSSStyleSheet>>::create(
+        [parsing_context, loaded_resource = NonnullRefPtr<Resource>(*resource())](auto&) -> RefPtr<CSS::CSSStyleSheet> {
+            return parse_css(parsing_context, loaded_resource->encoded_data());
+        },
+        [this, protector = move(protector)](RefPtr<CSS::CSSStyleSheet> sheet) {
+            if (!sheet) {
+                dbgln_if(CSS_LOADER_DEBUG, "CSSLoader: Failed to parse stylesheet: {}", resource()->url());
+                return;
+            }
+
+            bool was_imported = m_style_sheet->for_first_not_loaded_import_rule([&](auto& rule) {
+                rule.set_style_sheet(sheet);
+            });
+
+            // Transfer the rules from the successfully parsed sheet into the sheet we've already inserted.
+            if (!was_imported) {
+                m_style_sheet->rules() = sheet->rules();
+            }
+
+            // The sheet may already be in the document's style sheet list, in which
+            // case the set of effective rules just changed under the resolver's feet.
+            m_owner_element.document().style_resolver().invalidate_rule_cache();
+
+            if (on_load)
+                on_load();
+
+            load_next_import_if_needed();
+        });
 }
 
 void CSSLoader::resource_did_fail()
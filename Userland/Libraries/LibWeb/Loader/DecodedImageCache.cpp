@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibWeb/Loader/DecodedImageCache.h>
+
+namespace Web {
+
+static constexpr size_t maximum_cache_size_in_bytes = 32 * MiB;
+
+DecodedImageCache& DecodedImageCache::the()
+{
+    static DecodedImageCache cache;
+    return cache;
+}
+
+static size_t decoded_image_size_in_bytes(DecodedImageCache::DecodedImage const& image)
+{
+    size_t size = 0;
+    for (auto& frame : image.frames) {
+        if (frame.bitmap)
+            size += frame.bitmap->size_in_bytes();
+    }
+    return size;
+}
+
+RefPtr<DecodedImageCache::DecodedImage> DecodedImageCache::get(URL const& url, u32 content_hash)
+{
+    auto url_string = url.to_string();
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        auto& entry = m_entries[i];
+        if (entry.url != url_string || entry.content_hash != content_hash)
+            continue;
+
+        // The kernel may have purged the frames while they were volatile
+        // (ImageResource marks off-screen bitmaps volatile); a purged entry
+        // is no better than a miss.
+        bool usable = true;
+        for (auto& frame : entry.image->frames) {
+            if (!frame.bitmap)
+                continue;
+            bool was_purged = false;
+            if (!frame.bitmap->set_nonvolatile(was_purged) || was_purged)
+                usable = false;
+        }
+        if (!usable) {
+            m_total_size_in_bytes -= entry.size_in_bytes;
+            m_entries.remove(i);
+            return nullptr;
+        }
+
+        // Move the hit to the most-recently-used end.
+        auto taken = m_entries.take(i);
+        m_entries.append(move(taken));
+        return m_entries.last().image;
+    }
+    return nullptr;
+}
+
+void DecodedImageCache::set(URL const& url, u32 content_hash, NonnullRefPtr<DecodedImage> image)
+{
+    auto size = decoded_image_size_in_bytes(*image);
+    if (size > maximum_cache_size_in_bytes)
+        return;
+    evict_to_fit(size);
+    m_total_size_in_bytes += size;
+    m_entries.append({ url.to_string(), content_hash, size, move(image) });
+}
+
+void DecodedImageCache::evict_to_fit(size_t needed_bytes)
+{
+    while (!m_entries.is_empty() && m_total_size_in_bytes + needed_bytes > maximum_cache_size_in_bytes) {
+        m_total_size_in_bytes -= m_entries.first().size_in_bytes;
+        m_entries.remove(0);
+    }
+}
+
+}
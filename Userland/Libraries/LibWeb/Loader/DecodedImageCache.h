@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/String.h>
+#include <AK/URL.h>
+#include <AK/Vector.h>
+#include <LibGfx/Forward.h>
+
+namespace Web {
+
+// Caches the decoded frames of images across documents, so revisiting a page
+// (or hitting the same site logo on every page of a site) skips the
+// ImageDecoder service round-trip entirely. Entries are keyed by URL plus a
+// hash of the encoded bytes, so stale cache hits for changed content are
+// impossible. Total decoded size is bounded; least-recently-used entries are
+// evicted first.
+class DecodedImageCache {
+public:
+    struct Frame {
+        RefPtr<Gfx::Bitmap> bitmap;
+        size_t duration { 0 };
+    };
+
+    struct DecodedImage : public RefCounted<DecodedImage> {
+        bool is_animated { false };
+        int loop_count { 0 };
+        Vector<Frame> frames;
+    };
+
+    static DecodedImageCache& the();
+
+    RefPtr<DecodedImage> get(URL const&, u32 content_hash);
+    void set(URL const&, u32 content_hash, NonnullRefPtr<DecodedImage>);
+
+private:
+    struct Entry {
+        String url;
+        u32 content_hash { 0 };
+        size_t size_in_bytes { 0 };
+        NonnullRefPtr<DecodedImage> image;
+    };
+
+    void evict_to_fit(size_t needed_bytes);
+
+    // Ordered least- to most-recently used.
+    Vector<Entry> m_entries;
+    size_t m_total_size_in_bytes { 0 };
+};
+
+}
@@ -6,6 +6,7 @@
 
 #include <LibGfx/Bitmap.h>
 #include <LibImageDecoderClient/Client.h>
+#include <LibWeb/Loader/DecodedImageCache.h>
 #include <LibWeb/Loader/ImageResource.h>
 
 namespace Web {
@@ -50,6 +51,19 @@ void ImageResource::decode_if_needed() const
     if (!m_decoded_frames.is_empty())
         return;
 
+    auto content_hash = string_hash((char const*)encoded_data().data(), encoded_data().size());
+    if (auto cached = DecodedImageCache::the().get(url(), content_hash)) {
+        m_loop_count = cached->loop_count;
+        m_animated = cached->is_animated;
+        m_decoded_frames.resize(cached->frames.size());
+        for (size_t i = 0; i < m_decoded_frames.size(); ++i) {
+            m_decoded_frames[i].bitmap = cached->frames[i].bitmap;
+            m_decoded_frames[i].duration = cached->frames[i].duration;
+        }
+        m_has_attempted_decode = true;
+        return;
+    }
+
     NonnullRefPtr decoder = image_decoder_client();
     auto image = decoder->decode_image(encoded_data());
 
@@ -62,6 +76,16 @@ void ImageResource::decode_if_needed() const
             frame.bitmap = image.value().frames[i].bitmap;
             frame.duration = image.value().frames[i].duration;
         }
+
+        auto cache_entry = adopt_ref(*new DecodedImageCache::DecodedImage);
+        cache_entry->is_animated = m_animated;
+        cache_entry->loop_count = m_loop_count;
+        cache_entry->frames.resize(m_decoded_frames.size());
+        for (size_t i = 0; i < m_decoded_frames.size(); ++i) {
+            cache_entry->frames[i].bitmap = m_decoded_frames[i].bitmap;
+            cache_entry->frames[i].duration = m_decoded_frames[i].duration;
+        }
+        DecodedImageCache::the().set(url(), content_hash, move(cache_entry));
     }
 
     m_has_attempted_decode = true;
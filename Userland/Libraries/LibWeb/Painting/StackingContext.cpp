@@ -37,6 +37,12 @@ void StackingContext::paint_descendants(PaintContext& context, Node& box, Stacki
     box.for_each_child([&](auto& child) {
         if (child.establishes_stacking_context())
             return;
+        // A subtree entirely outside the viewport can't produce any visible
+        // pixels, so don't walk into it. (Descendants that establish stacking
+        // contexts of their own are painted from paint_internal() and make
+        // this decision for themselves.)
+        if (is<Box>(child) && verify_cast<Box>(child).is_out_of_view(context))
+            return;
         switch (phase) {
         case StackingContextPaintPhase::BackgroundAndBorders:
             if (!child.is_floating() && !child.is_positioned()) {
@@ -105,12 +111,97 @@ void StackingContext::paint_internal(PaintContext& context)
     paint_descendants(context, m_box, StackingContextPaintPhase::FocusAndOverlay);
 }
 
+// Keeping every stacking context's pixels alive would get expensive on large
+// pages, so only layers up to this size are cached.
+static constexpr int max_cached_layer_area = 2048 * 2048;
+
+bool StackingContext::is_cacheable_layer() const
+{
+    // The initial containing block covers the entire document; caching it
+    // would duplicate the whole page as a bitmap.
+    if (is<InitialContainingBlockBox>(m_box))
+        return false;
+
+    // The root element paints the canvas background over the whole viewport,
+    // which makes its output scroll-dependent too.
+    if (m_box.is_root_element())
+        return false;
+
+    // Fixed-position content is painted at a scroll-dependent offset, so a
+    // layer with any of it baked in would be wrong after scrolling.
+    bool contains_fixed_position = false;
+    m_box.for_each_in_inclusive_subtree([&](auto& node) {
+        if (node.is_fixed_position()) {
+            contains_fixed_position = true;
+            return IterationDecision::Break;
+        }
+        return IterationDecision::Continue;
+    });
+    return !contains_fixed_position;
+}
+
+bool StackingContext::prepare_cached_layer(PaintContext& context)
+{
+    // FIXME: This assumes the subtree paints within the context root's border
+    //        box. We don't track ink overflow yet, so overhanging shadows and
+    //        overflowing children get clipped to it, just like they already
+    //        were on the whole-context opacity path below.
+    auto layer_rect = enclosing_int_rect(m_box.absolute_rect());
+    if (m_cached_layer_valid && m_cached_layer && m_cached_layer_rect == layer_rect)
+        return true;
+
+    if (layer_rect.is_empty() || layer_rect.width() * layer_rect.height() > max_cached_layer_area)
+        return false;
+    if (!is_cacheable_layer())
+        return false;
+
+    if (!m_cached_layer || m_cached_layer->size() != layer_rect.size()) {
+        m_cached_layer = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, layer_rect.size());
+        if (!m_cached_layer)
+            return false;
+    }
+    m_cached_layer->fill(Color::Transparent);
+
+    // Record the subtree at its absolute position, shifted to the layer's
+    // origin. Since painting only depends on absolute coordinates, the layer
+    // stays valid no matter how the viewport moves over it.
+    Gfx::Painter painter(*m_cached_layer);
+    painter.translate(-layer_rect.location());
+    PaintContext layer_context(painter, context.palette(), context.scroll_offset());
+    // The layer has to contain the whole subtree no matter where the viewport
+    // currently is, so viewport culling inside it is relative to the layer.
+    layer_context.set_viewport_rect(layer_rect);
+    layer_context.set_should_show_line_box_borders(context.should_show_line_box_borders());
+    layer_context.set_has_focus(context.has_focus());
+    paint_internal(layer_context);
+
+    m_cached_layer_rect = layer_rect;
+    m_cached_layer_valid = true;
+    return true;
+}
+
+void StackingContext::invalidate_cached_layers()
+{
+    for (auto* context = this; context; context = context->m_parent)
+        context->m_cached_layer_valid = false;
+}
+
 void StackingContext::paint(PaintContext& context)
 {
     auto opacity = m_box.computed_values().opacity();
     if (opacity.has_value() && opacity.value() == 0.0f)
         return;
 
+    if (m_box.is_out_of_view(context))
+        return;
+
+    // Replaying a cached layer is a blit, so repainting an unchanged subtree
+    // (e.g. scrolling over static content) no longer re-rasterizes it.
+    if (prepare_cached_layer(context)) {
+        context.painter().blit(m_cached_layer_rect.location(), *m_cached_layer, m_cached_layer->rect(), opacity.value_or(1.0f));
+        return;
+    }
+
     if (opacity.has_value() && opacity.value() != 1.0f) {
         auto bitmap = context.painter().target();
         auto new_bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, bitmap->size());
@@ -118,6 +209,7 @@ void StackingContext::paint(PaintContext& context)
             return;
         Gfx::Painter painter(*new_bitmap);
         PaintContext paint_context(painter, context.palette(), context.scroll_offset());
+        paint_context.set_viewport_rect(context.viewport_rect());
         paint_internal(paint_context);
         context.painter().blit(Gfx::IntPoint(m_box.absolute_position()), *new_bitmap, Gfx::IntRect(m_box.absolute_rect()), opacity.value());
     } else {
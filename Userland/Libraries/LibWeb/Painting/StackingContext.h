@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
 #include <LibWeb/Layout/Node.h>
 
 namespace Web::Layout {
@@ -29,6 +30,10 @@ public:
     void paint(PaintContext&);
     HitTestResult hit_test(const Gfx::IntPoint&, HitTestType) const;
 
+    // Drops the cached paint layer for this stacking context and every
+    // ancestor context (whose layers have this subtree's pixels baked in.)
+    void invalidate_cached_layers();
+
     void dump(int indent = 0) const;
 
 private:
@@ -37,6 +42,12 @@ private:
     Vector<StackingContext*> m_children;
 
     void paint_internal(PaintContext&);
+    bool is_cacheable_layer() const;
+    bool prepare_cached_layer(PaintContext&);
+
+    RefPtr<Gfx::Bitmap> m_cached_layer;
+    Gfx::IntRect m_cached_layer_rect;
+    bool m_cached_layer_valid { false };
 };
 
 }
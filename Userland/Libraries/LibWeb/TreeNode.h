@@ -14,9 +14,25 @@
 
 namespace Web {
 
+// Slab allocation for tree nodes; see TreeNodeAllocator.cpp.
+void* allocate_tree_node(size_t);
+void free_tree_node(void*, size_t);
+
 template<typename T>
 class TreeNode : public Weakable<T> {
 public:
+    void* operator new(size_t size)
+    {
+        return allocate_tree_node(size);
+    }
+
+    // NOTE: Only the sized form is declared, so the compiler always passes
+    //       the most-derived object size here (via the virtual destructor.)
+    void operator delete(void* ptr, size_t size)
+    {
+        free_tree_node(ptr, size);
+    }
+
     void ref()
     {
         VERIFY(!m_in_removed_last_ref);
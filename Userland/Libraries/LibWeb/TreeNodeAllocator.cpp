@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Types.h>
+#include <LibWeb/TreeNode.h>
+#include <stdlib.h>
+
+namespace Web {
+
+// DOM and layout nodes are small, allocated in large numbers while building
+// trees, and freed in large numbers when trees are torn down. Carving them
+// out of dedicated slabs instead of going through malloc() for every node
+// makes tree construction cheaper and keeps the nodes of a tree close
+// together in memory, which the tree walks in style, layout and paint
+// benefit from. Freed nodes go on per-size free lists and get recycled by
+// later allocations; the slabs themselves are never returned to the heap.
+
+static constexpr size_t slab_size = 64 * KiB;
+static constexpr size_t size_classes[] = { 32, 64, 128, 256, 512, 1024, 2048 };
+static constexpr size_t size_class_count = array_size(size_classes);
+
+struct FreeListEntry {
+    FreeListEntry* next;
+};
+
+struct SizeClassAllocator {
+    FreeListEntry* free_list { nullptr };
+    u8* slab_cursor { nullptr };
+    u8* slab_end { nullptr };
+};
+
+static SizeClassAllocator s_allocators[size_class_count];
+
+static Optional<size_t> size_class_index_for(size_t size)
+{
+    for (size_t i = 0; i < size_class_count; ++i) {
+        if (size <= size_classes[i])
+            return i;
+    }
+    return {};
+}
+
+void* allocate_tree_node(size_t size)
+{
+    auto index = size_class_index_for(size);
+    if (!index.has_value())
+        return malloc(size);
+
+    auto& allocator = s_allocators[index.value()];
+    if (allocator.free_list) {
+        auto* entry = allocator.free_list;
+        allocator.free_list = entry->next;
+        return entry;
+    }
+
+    auto chunk_size = size_classes[index.value()];
+    if (allocator.slab_cursor + chunk_size > allocator.slab_end) {
+        auto* slab = static_cast<u8*>(malloc(slab_size));
+        VERIFY(slab);
+        allocator.slab_cursor = slab;
+        allocator.slab_end = slab + slab_size;
+    }
+
+    auto* ptr = allocator.slab_cursor;
+    allocator.slab_cursor += chunk_size;
+    return ptr;
+}
+
+void free_tree_node(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    auto index = size_class_index_for(size);
+    if (!index.has_value()) {
+        free(ptr);
+        return;
+    }
+
+    auto& allocator = s_allocators[index.value()];
+    auto* entry = static_cast<FreeListEntry*>(ptr);
+    entry->next = allocator.free_list;
+    allocator.free_list = entry;
+}
+
+}
@@ -55,7 +55,15 @@ JS_DEFINE_NATIVE_FUNCTION(WebAssemblyMemoryPrototype::buffer_getter)
     if (!memory)
         return JS::js_undefined();
 
-    auto array_buffer = JS::ArrayBuffer::create(global_object, &memory->data());
+    // The memory's storage lives in an mmap'd reservation now, which an
+    // ArrayBuffer cannot alias, so hand out a copy of the current contents.
+    // FIXME: This should really be a live view of the memory.
+    auto buffer = ByteBuffer::copy(memory->data());
+    if (!buffer.has_value()) {
+        vm.throw_exception<JS::RangeError>(global_object, JS::ErrorType::NotEnoughMemoryToAllocate, memory->size());
+        return {};
+    }
+    auto* array_buffer = global_object.heap().allocate<JS::ArrayBuffer>(global_object, buffer.release_value(), *global_object.array_buffer_prototype());
     array_buffer->set_detach_key(JS::js_string(vm, "WebAssembly.Memory"));
     return array_buffer;
 }
@@ -73,16 +73,14 @@ void ClientConnection::set_sample_rate(u16 sample_rate)
     m_mixer.audiodevice_set_sample_rate(sample_rate);
 }
 
-Messages::AudioServer::EnqueueBufferResponse ClientConnection::enqueue_buffer(Core::AnonymousBuffer const& buffer, i32 buffer_id, int sample_count)
+void ClientConnection::set_sample_ring(Core::AnonymousBuffer const& ring)
 {
     if (!m_queue)
         m_queue = m_mixer.create_queue(*this);
 
-    if (m_queue->is_full())
-        return false;
-
-    m_queue->enqueue(Audio::Buffer::create_with_anonymous_buffer(buffer, buffer_id, sample_count));
-    return true;
+    // Only the first ring a client provides is accepted; replacing the
+    // mapping while the mixer reads from it would race.
+    m_queue->set_ring(ring);
 }
 
 Messages::AudioServer::GetRemainingSamplesResponse ClientConnection::get_remaining_samples()
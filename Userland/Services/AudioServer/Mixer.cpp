@@ -67,7 +67,12 @@ void Mixer::mix()
     for (;;) {
         if (active_mix_queues.is_empty() || m_added_queue) {
             pthread_mutex_lock(&m_pending_mutex);
-            pthread_cond_wait(&m_pending_cond, &m_pending_mutex);
+            // Only sleep when there is nothing to mix at all; a newly
+            // added queue is already in m_pending_mixing by the time the
+            // flag is set, so waiting for another signal here would lose
+            // the wakeup (and stall a mixer that has active queues).
+            while (active_mix_queues.is_empty() && m_pending_mixing.is_empty())
+                pthread_cond_wait(&m_pending_cond, &m_pending_mutex);
             active_mix_queues.extend(move(m_pending_mixing));
             pthread_mutex_unlock(&m_pending_mutex);
             m_added_queue = false;
@@ -75,8 +80,8 @@ void Mixer::mix()
 
         active_mix_queues.remove_all_matching([&](auto& entry) { return !entry->client(); });
 
-        Audio::Frame mixed_buffer[1024];
-        auto mixed_buffer_length = (int)(sizeof(mixed_buffer) / sizeof(Audio::Frame));
+        constexpr size_t mixed_buffer_length = 1024;
+        Audio::Frame mixed_buffer[mixed_buffer_length];
 
         // Mix the buffers together into the output
         for (auto& queue : active_mix_queues) {
@@ -85,7 +90,7 @@ void Mixer::mix()
                 continue;
             }
 
-            for (int i = 0; i < mixed_buffer_length; ++i) {
+            for (size_t i = 0; i < mixed_buffer_length; ++i) {
                 auto& mixed_sample = mixed_buffer[i];
                 Audio::Frame sample;
                 if (!queue->get_next_sample(sample))
@@ -97,26 +102,20 @@ void Mixer::mix()
         if (m_muted) {
             m_device->write(m_zero_filled_buffer, sizeof(m_zero_filled_buffer));
         } else {
-            Array<u8, 4096> buffer;
-            OutputMemoryStream stream { buffer };
+            // Scale, clip and convert in one pass of plain arithmetic on
+            // the flat sample array, so the compiler can vectorize it.
+            Array<LittleEndian<i16>, mixed_buffer_length * 2> out_samples;
+            double volume = m_main_volume / 100.0;
 
-            for (int i = 0; i < mixed_buffer_length; ++i) {
+            for (size_t i = 0; i < mixed_buffer_length; ++i) {
                 auto& mixed_sample = mixed_buffer[i];
-
-                mixed_sample.scale(m_main_volume);
-                mixed_sample.clip();
-
-                LittleEndian<i16> out_sample;
-                out_sample = mixed_sample.left * NumericLimits<i16>::max();
-                stream << out_sample;
-
-                out_sample = mixed_sample.right * NumericLimits<i16>::max();
-                stream << out_sample;
+                double left = clamp(mixed_sample.left * volume, -1.0, 1.0);
+                double right = clamp(mixed_sample.right * volume, -1.0, 1.0);
+                out_samples[i * 2] = static_cast<i16>(left * NumericLimits<i16>::max());
+                out_samples[i * 2 + 1] = static_cast<i16>(right * NumericLimits<i16>::max());
             }
 
-            VERIFY(stream.is_end());
-            VERIFY(!stream.has_any_error());
-            m_device->write(stream.data(), stream.size());
+            m_device->write(reinterpret_cast<u8 const*>(out_samples.data()), out_samples.size() * sizeof(LittleEndian<i16>));
         }
     }
 }
@@ -187,9 +186,14 @@ BufferQueue::BufferQueue(ClientConnection& client)
 {
 }
 
-void BufferQueue::enqueue(NonnullRefPtr<Audio::Buffer>&& buffer)
+bool BufferQueue::set_ring(Core::AnonymousBuffer ring_buffer)
 {
-    m_remaining_samples += buffer->sample_count();
-    m_queue.enqueue(move(buffer));
+    if (m_ring.load(AK::MemoryOrder::memory_order_relaxed))
+        return false;
+    if (!ring_buffer.is_valid() || ring_buffer.size() < sizeof(Audio::SampleRing))
+        return false;
+    m_ring_buffer = move(ring_buffer);
+    m_ring.store(reinterpret_cast<Audio::SampleRing*>(m_ring_buffer.data<u8>()), AK::MemoryOrder::memory_order_release);
+    return true;
 }
 }
@@ -12,10 +12,12 @@
 #include <AK/Badge.h>
 #include <AK/ByteBuffer.h>
 #include <AK/NonnullRefPtrVector.h>
-#include <AK/Queue.h>
+#include <AK/Optional.h>
 #include <AK/RefCounted.h>
 #include <AK/WeakPtr.h>
 #include <LibAudio/Buffer.h>
+#include <LibAudio/SampleRing.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/File.h>
 #include <LibCore/Timer.h>
 #include <LibThreading/Mutex.h>
@@ -25,33 +27,59 @@ namespace AudioServer {
 
 class ClientConnection;
 
+// The mixer-side view of a client's shared-memory SampleRing. The
+// client writes chunk descriptors and frames into the ring; the mixer
+// thread is the only reader, so the whole sample path is lock-free and
+// involves no copies or syscalls. Control operations (pause, clear)
+// arrive on the IPC thread as atomic flags that the mixer thread acts
+// on at the next sample it pulls.
 class BufferQueue : public RefCounted<BufferQueue> {
 public:
     explicit BufferQueue(ClientConnection&);
     ~BufferQueue() { }
 
-    bool is_full() const { return m_queue.size() >= 3; }
-    void enqueue(NonnullRefPtr<Audio::Buffer>&&);
+    // IPC thread; accepts only the first ring a client provides, since
+    // swapping the mapping under the mixer thread would race.
+    bool set_ring(Core::AnonymousBuffer);
 
+    // Consumer side (mixer thread) only!
     bool get_next_sample(Audio::Frame& sample)
     {
-        if (m_paused)
+        auto* ring = m_ring.load(AK::MemoryOrder::memory_order_acquire);
+        if (!ring)
             return false;
 
-        while (!m_current && !m_queue.is_empty())
-            m_current = m_queue.dequeue();
+        if (m_clear_generation.load(AK::MemoryOrder::memory_order_acquire) != m_seen_clear_generation)
+            discard_pending_chunks(*ring);
 
-        if (!m_current)
+        if (m_paused.load(AK::MemoryOrder::memory_order_relaxed))
             return false;
 
-        sample = m_current->samples()[m_position++];
-        --m_remaining_samples;
-        ++m_played_samples;
+        if (!m_current_chunk.has_value()) {
+            Audio::SampleRing::Chunk chunk;
+            if (!ring->peek_chunk(chunk))
+                return false;
+            ring->skip_frames_before(chunk.first_frame);
+            m_current_chunk = chunk;
+            m_chunk_position = 0;
+            m_playing_buffer_id.store(chunk.buffer_id, AK::MemoryOrder::memory_order_relaxed);
+        }
+
+        // The client may still be writing this chunk's frames; playing
+        // what has arrived so far is what lets chunks larger than the
+        // frame ring through.
+        if (!ring->read_frame(sample))
+            return false;
 
-        if (m_position >= m_current->sample_count()) {
-            m_client->did_finish_playing_buffer({}, m_current->id());
-            m_current = nullptr;
-            m_position = 0;
+        ++m_chunk_position;
+        ring->remaining_samples().fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+        ring->played_samples().fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+
+        if (m_chunk_position >= m_current_chunk->sample_count) {
+            ring->pop_chunk();
+            m_client->did_finish_playing_buffer({}, m_current_chunk->buffer_id);
+            m_current_chunk.clear();
+            m_playing_buffer_id.store(-1, AK::MemoryOrder::memory_order_relaxed);
         }
         return true;
     }
@@ -60,35 +88,65 @@ public:
 
     void clear(bool paused = false)
     {
-        m_queue.clear();
-        m_position = 0;
-        m_remaining_samples = 0;
-        m_played_samples = 0;
-        m_current = nullptr;
-        m_paused = paused;
+        m_paused.store(paused, AK::MemoryOrder::memory_order_relaxed);
+        // The mixer thread drops its current chunk and drains the ring
+        // when it sees the new generation; touching the ring from this
+        // thread would make it multi-consumer.
+        m_clear_generation.fetch_add(1, AK::MemoryOrder::memory_order_release);
     }
 
     void set_paused(bool paused)
     {
-        m_paused = paused;
+        m_paused.store(paused, AK::MemoryOrder::memory_order_relaxed);
     }
 
-    int get_remaining_samples() const { return m_remaining_samples; }
-    int get_played_samples() const { return m_played_samples; }
-    int get_playing_buffer() const
+    int get_remaining_samples() const
+    {
+        auto* ring = m_ring.load(AK::MemoryOrder::memory_order_acquire);
+        return ring ? static_cast<int>(ring->remaining_samples().load(AK::MemoryOrder::memory_order_relaxed)) : 0;
+    }
+    int get_played_samples() const
     {
-        if (m_current)
-            return m_current->id();
-        return -1;
+        auto* ring = m_ring.load(AK::MemoryOrder::memory_order_acquire);
+        return ring ? static_cast<int>(ring->played_samples().load(AK::MemoryOrder::memory_order_relaxed)) : 0;
     }
+    int get_playing_buffer() const { return m_playing_buffer_id.load(AK::MemoryOrder::memory_order_relaxed); }
 
 private:
-    RefPtr<Audio::Buffer> m_current;
-    Queue<NonnullRefPtr<Audio::Buffer>> m_queue;
-    int m_position { 0 };
-    int m_remaining_samples { 0 };
-    int m_played_samples { 0 };
-    bool m_paused { false };
+    // Consumer side only
+    void discard_pending_chunks(Audio::SampleRing& ring)
+    {
+        m_seen_clear_generation = m_clear_generation.load(AK::MemoryOrder::memory_order_acquire);
+        if (m_current_chunk.has_value()) {
+            // The chunk being played is still at the head of the chunk
+            // ring (it's only popped once it finishes), so pop it here
+            // lest the drain loop below count it a second time.
+            ring.remaining_samples().fetch_sub(m_current_chunk->sample_count - m_chunk_position, AK::MemoryOrder::memory_order_relaxed);
+            ring.pop_chunk();
+            m_current_chunk.clear();
+        }
+        m_chunk_position = 0;
+        Audio::SampleRing::Chunk chunk;
+        while (ring.peek_chunk(chunk)) {
+            ring.remaining_samples().fetch_sub(chunk.sample_count, AK::MemoryOrder::memory_order_relaxed);
+            ring.pop_chunk();
+        }
+        // Frames of a chunk the client is mid-write get skipped later
+        // via the next chunk's first_frame.
+        ring.discard_written_frames();
+        m_playing_buffer_id.store(-1, AK::MemoryOrder::memory_order_relaxed);
+        ring.played_samples().store(0, AK::MemoryOrder::memory_order_relaxed);
+    }
+
+    // Keeps the client's mapping alive for the lifetime of the queue
+    Core::AnonymousBuffer m_ring_buffer;
+    Atomic<Audio::SampleRing*> m_ring { nullptr };
+    Optional<Audio::SampleRing::Chunk> m_current_chunk;
+    u32 m_chunk_position { 0 };
+    Atomic<int> m_playing_buffer_id { -1 };
+    Atomic<bool> m_paused { false };
+    Atomic<u32> m_clear_generation { 0 };
+    u32 m_seen_clear_generation { 0 };
     WeakPtr<ClientConnection> m_client;
 };
 
@@ -5,10 +5,10 @@
  */
 
 #include <AK/LexicalPath.h>
-#include <AK/MappedFile.h>
 #include <Kernel/API/InodeWatcherEvent.h>
 #include <LibCompress/Gzip.h>
 #include <LibCore/File.h>
+#include <LibCore/FileStream.h>
 #include <LibCore/FileWatcher.h>
 #include <LibCoredump/Backtrace.h>
 #include <LibCoredump/Reader.h>
@@ -35,27 +35,34 @@ static void wait_until_coredump_is_ready(const String& coredump_path)
 
 static bool compress_coredump(const String& coredump_path)
 {
-    auto file_or_error = MappedFile::map(coredump_path);
-    if (file_or_error.is_error()) {
-        dbgln("Could not open coredump '{}': {}", coredump_path, file_or_error.error());
-        return false;
-    }
-    auto coredump_file = file_or_error.value();
-    auto compressed_coredump = Compress::GzipCompressor::compress_all(coredump_file->bytes());
-    if (!compressed_coredump.has_value()) {
-        dbgln("Could not compress coredump '{}'", coredump_path);
+    auto input_file_or_error = Core::File::open(coredump_path, Core::OpenMode::ReadOnly);
+    if (input_file_or_error.is_error()) {
+        dbgln("Could not open coredump '{}': {}", coredump_path, input_file_or_error.error());
         return false;
     }
+    auto input_file = input_file_or_error.value();
+
     auto output_path = String::formatted("{}.gz", coredump_path);
-    auto output_file_or_error = Core::File::open(output_path, Core::OpenMode::WriteOnly);
-    if (output_file_or_error.is_error()) {
-        dbgln("Could not open '{}' for writing: {}", output_path, output_file_or_error.error());
+    auto output_stream_or_error = Core::OutputFileStream::open(output_path);
+    if (output_stream_or_error.is_error()) {
+        dbgln("Could not open '{}' for writing: {}", output_path, output_stream_or_error.error());
         return false;
     }
-    auto output_file = output_file_or_error.value();
-    if (!output_file->write(compressed_coredump.value().data(), compressed_coredump.value().size())) {
-        dbgln("Could not write compressed coredump '{}'", output_path);
-        return false;
+    auto output_stream = output_stream_or_error.release_value();
+    Compress::GzipCompressor gzip_stream { output_stream };
+
+    // Stream the coredump through the compressor in chunks (each chunk
+    // becomes its own gzip member, which GzipDecompressor handles fine)
+    // instead of mapping the whole file, so a large coredump never needs
+    // both itself and its compressed form in memory at once.
+    while (true) {
+        auto chunk = input_file->read(1 * MiB);
+        if (chunk.is_empty())
+            break;
+        if (!gzip_stream.write_or_error(chunk.bytes())) {
+            dbgln("Could not write compressed coredump '{}'", output_path);
+            return false;
+        }
     }
     return true;
 }
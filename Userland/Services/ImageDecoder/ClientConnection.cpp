@@ -4,16 +4,39 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/Debug.h>
 #include <ImageDecoder/ClientConnection.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
+#include <LibCore/EventLoop.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageDecoder.h>
+#include <LibThreading/WorkerPool.h>
 
 namespace ImageDecoder {
 
 static HashMap<int, RefPtr<ClientConnection>> s_connections;
 
+struct ClientConnection::Job : public RefCounted<Job> {
+    Job(i64 image_id, Core::AnonymousBuffer encoded_buffer)
+        : image_id(image_id)
+        , encoded_buffer(move(encoded_buffer))
+    {
+    }
+
+    i64 image_id { 0 };
+    Core::AnonymousBuffer encoded_buffer;
+    Atomic<bool> cancelled { false };
+};
+
+struct DecodeResult {
+    bool success { false };
+    bool is_animated { false };
+    u32 loop_count { 0 };
+    Vector<Gfx::ShareableBitmap> bitmaps;
+    Vector<u32> durations;
+};
+
 ClientConnection::ClientConnection(NonnullRefPtr<Core::LocalSocket> socket, int client_id)
     : IPC::ClientConnection<ImageDecoderClientEndpoint, ImageDecoderServerEndpoint>(*this, move(socket), client_id)
 {
@@ -30,37 +53,85 @@ void ClientConnection::die()
     exit(0);
 }
 
-Messages::ImageDecoderServer::DecodeImageResponse ClientConnection::decode_image(Core::AnonymousBuffer const& encoded_buffer)
+// Runs on a worker thread; may only touch its arguments.
+static DecodeResult decode_encoded_data(Core::AnonymousBuffer const& encoded_buffer, Atomic<bool> const& cancelled)
 {
-    if (!encoded_buffer.is_valid()) {
-        dbgln_if(IMAGE_DECODER_DEBUG, "Encoded data is invalid");
-        return nullptr;
-    }
+    DecodeResult result;
 
     auto decoder = Gfx::ImageDecoder::try_create(ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() });
 
     if (!decoder) {
         dbgln_if(IMAGE_DECODER_DEBUG, "Could not find suitable image decoder plugin for data");
-        return { false, 0, Vector<Gfx::ShareableBitmap> {}, Vector<u32> {} };
+        return result;
     }
 
     if (!decoder->frame_count()) {
         dbgln_if(IMAGE_DECODER_DEBUG, "Could not decode image from encoded data");
-        return { false, 0, Vector<Gfx::ShareableBitmap> {}, Vector<u32> {} };
+        return result;
     }
 
-    Vector<Gfx::ShareableBitmap> bitmaps;
-    Vector<u32> durations;
     for (size_t i = 0; i < decoder->frame_count(); ++i) {
+        // The requesting page may have navigated away mid-decode; bail
+        // between frames instead of finishing work nobody wants.
+        if (cancelled.load(AK::memory_order_relaxed))
+            return result;
         auto frame = decoder->frame(i);
         if (frame.image)
-            bitmaps.append(frame.image->to_shareable_bitmap());
+            result.bitmaps.append(frame.image->to_shareable_bitmap());
         else
-            bitmaps.append(Gfx::ShareableBitmap {});
-        durations.append(frame.duration);
+            result.bitmaps.append(Gfx::ShareableBitmap {});
+        result.durations.append(frame.duration);
     }
 
-    return { decoder->is_animated(), static_cast<u32>(decoder->loop_count()), bitmaps, durations };
+    result.success = true;
+    result.is_animated = decoder->is_animated();
+    result.loop_count = static_cast<u32>(decoder->loop_count());
+    return result;
+}
+
+void ClientConnection::decode_image(i64 image_id, Core::AnonymousBuffer const& encoded_buffer, i32 priority)
+{
+    if (!encoded_buffer.is_valid()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Encoded data for image {} is invalid", image_id);
+        async_did_fail_decoding(image_id);
+        return;
+    }
+
+    auto task_priority = Threading::TaskPriority::Normal;
+    if (priority <= 0)
+        task_priority = Threading::TaskPriority::High;
+    else if (priority >= 2)
+        task_priority = Threading::TaskPriority::Low;
+
+    auto job = adopt_ref(*new Job(image_id, encoded_buffer));
+    m_jobs.set(image_id, job);
+
+    Threading::WorkerPool::the().enqueue(
+        [this, protector = NonnullRefPtr(*this), job]() mutable {
+            auto result = decode_encoded_data(job->encoded_buffer, job->cancelled);
+            // IPC must happen on the main thread; hand the result back there.
+            Core::EventLoop::main().deferred_invoke([this, protector = move(protector), job, result = move(result)]() mutable {
+                // A job that's no longer tracked was cancelled while decoding.
+                if (!m_jobs.remove(job->image_id))
+                    return;
+                if (!result.success) {
+                    async_did_fail_decoding(job->image_id);
+                    return;
+                }
+                async_did_decode_image(job->image_id, result.is_animated, result.loop_count, move(result.bitmaps), move(result.durations));
+            });
+            Core::EventLoop::wake();
+        },
+        task_priority);
+}
+
+void ClientConnection::cancel_decoding(i64 image_id)
+{
+    auto it = m_jobs.find(image_id);
+    if (it == m_jobs.end())
+        return;
+    it->value->cancelled.store(true, AK::memory_order_relaxed);
+    m_jobs.remove(image_id);
 }
 
 }
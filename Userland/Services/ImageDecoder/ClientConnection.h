@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
 #include <ImageDecoder/Forward.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
@@ -26,7 +27,15 @@ public:
     virtual void die() override;
 
 private:
-    virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer const&) override;
+    virtual void decode_image(i64 image_id, Core::AnonymousBuffer const&, i32 priority) override;
+    virtual void cancel_decoding(i64 image_id) override;
+
+    struct Job;
+
+    // Jobs that have been handed to the worker pool but whose result hasn't
+    // been sent back yet. Cancellation removes the entry, so a finished job
+    // that's no longer in here gets dropped instead of sent.
+    HashMap<i64, NonnullRefPtr<Job>> m_jobs;
 };
 
 }
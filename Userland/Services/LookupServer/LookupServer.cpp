@@ -13,10 +13,12 @@
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/ConfigFile.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/File.h>
 #include <LibCore/LocalServer.h>
 #include <LibCore/UDPSocket.h>
 #include <stdio.h>
+#include <sys/select.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -25,6 +27,15 @@ namespace LookupServer {
 static LookupServer* s_the;
 // NOTE: This is the TTL we return for the hostname or answers from /etc/hosts.
 static constexpr u32 s_static_ttl = 86400;
+// How long we remember that a name has no records of some type. Proper
+// negative caching would take this from the SOA minimum TTL, but we don't
+// parse authority records, so use a conservative fixed value.
+static constexpr u32 s_negative_ttl = 60;
+
+static String negative_cache_key(const DNSName& name, DNSRecordType record_type)
+{
+    return String::formatted("{}/{}", name.as_string().to_lowercase(), (u16)record_type);
+}
 
 LookupServer& LookupServer::the()
 {
@@ -180,18 +191,31 @@ Vector<DNSAnswer> LookupServer::lookup(const DNSName& name, DNSRecordType record
     }
 
     // Third, try our cache.
-    if (auto cached_answers = m_lookup_cache.get(name); cached_answers.has_value()) {
-        for (auto& answer : cached_answers.value()) {
-            // TODO: Actually remove expired answers from the cache.
-            if (answer.type() == record_type && !answer.has_expired()) {
+    if (auto it = m_lookup_cache.find(name); it != m_lookup_cache.end()) {
+        it->value.remove_all_matching([](DNSAnswer const& answer) { return answer.has_expired(); });
+        for (auto& answer : it->value) {
+            if (answer.type() == record_type) {
                 dbgln_if(LOOKUPSERVER_DEBUG, "Cache hit: {} -> {}", name.as_string(), answer.record_data());
                 add_answer(answer);
             }
         }
+        if (it->value.is_empty())
+            m_lookup_cache.remove(it);
         if (!answers.is_empty())
             return answers;
     }
 
+    // Also check whether we recently learned that this name has no
+    // records of this type; repeated lookups for a missing name are just
+    // as common as ones that resolve.
+    if (auto negative_expiry = m_negative_cache.get(negative_cache_key(name, record_type)); negative_expiry.has_value()) {
+        if (time(nullptr) < negative_expiry.value()) {
+            dbgln_if(LOOKUPSERVER_DEBUG, "Negative cache hit for '{}'", name.as_string());
+            return {};
+        }
+        m_negative_cache.remove(negative_cache_key(name, record_type));
+    }
+
     // Fourth, look up .local names using mDNS instead of DNS nameservers.
     if (name.as_string().ends_with(".local")) {
         answers = m_mdns->lookup(name, record_type);
@@ -200,129 +224,189 @@ Vector<DNSAnswer> LookupServer::lookup(const DNSName& name, DNSRecordType record
         return answers;
     }
 
-    // Fifth, ask the upstream nameservers.
-    for (auto& nameserver : m_nameservers) {
-        dbgln_if(LOOKUPSERVER_DEBUG, "Doing lookup using nameserver '{}'", nameserver);
-        bool did_get_response = false;
-        int retries = 3;
-        Vector<DNSAnswer> upstream_answers;
-        do {
-            upstream_answers = lookup(name, nameserver, did_get_response, record_type);
-            if (did_get_response)
-                break;
-        } while (--retries);
-        if (!upstream_answers.is_empty()) {
-            for (auto& answer : upstream_answers)
-                add_answer(answer);
-            break;
-        } else {
-            if (!did_get_response)
-                dbgln("Never got a response from '{}', trying next nameserver", nameserver);
-            else
-                dbgln("Received response from '{}' but no result(s), trying next nameserver", nameserver);
-        }
-    }
+    // Fifth, ask all the upstream nameservers in parallel; the first
+    // useful answer wins.
+    bool did_get_response = false;
+    auto upstream_answers = lookup_upstream(name, record_type, did_get_response);
+    for (auto& answer : upstream_answers)
+        add_answer(answer);
 
-    // Sixth, fail.
+    // Sixth, fail. If some nameserver did answer (just with no records),
+    // remember that so the next lookup for this name doesn't go back to
+    // the network right away.
     if (answers.is_empty()) {
-        dbgln("Tried all nameservers but never got a response :(");
+        if (did_get_response)
+            m_negative_cache.set(negative_cache_key(name, record_type), time(nullptr) + s_negative_ttl);
+        else
+            dbgln("Tried all nameservers but never got a response :(");
         return {};
     }
 
     return answers;
 }
 
-Vector<DNSAnswer> LookupServer::lookup(const DNSName& name, const String& nameserver, bool& did_get_response, DNSRecordType record_type, ShouldRandomizeCase should_randomize_case)
+Vector<DNSAnswer> LookupServer::lookup_upstream(const DNSName& name, DNSRecordType record_type, bool& did_get_response)
 {
-    DNSPacket request;
-    request.set_is_query();
-    request.set_id(get_random_uniform(UINT16_MAX));
-    DNSName name_in_question = name;
-    if (should_randomize_case == ShouldRandomizeCase::Yes)
-        name_in_question.randomize_case();
-    request.add_question({ name_in_question, record_type, DNSRecordClass::IN, false });
-
-    auto buffer = request.to_byte_buffer();
-
-    auto udp_socket = Core::UDPSocket::construct();
-    udp_socket->set_blocking(true);
+    struct UpstreamQuery {
+        String nameserver;
+        NonnullRefPtr<Core::UDPSocket> socket;
+        DNSPacket request;
+        ShouldRandomizeCase randomize_case { ShouldRandomizeCase::Yes };
+        bool done { false };
+    };
 
-    struct timeval timeout {
-        1, 0
+    auto build_request = [&](ShouldRandomizeCase should_randomize_case) {
+        DNSPacket request;
+        request.set_is_query();
+        request.set_id(get_random_uniform(UINT16_MAX));
+        DNSName name_in_question = name;
+        if (should_randomize_case == ShouldRandomizeCase::Yes)
+            name_in_question.randomize_case();
+        request.add_question({ name_in_question, record_type, DNSRecordClass::IN, false });
+        return request;
     };
 
-    int rc = setsockopt(udp_socket->fd(), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
-    if (rc < 0) {
-        perror("setsockopt(SOL_SOCKET, SO_RCVTIMEO)");
-        return {};
+    Vector<UpstreamQuery> queries;
+    for (auto& nameserver : m_nameservers) {
+        auto socket = Core::UDPSocket::construct();
+        if (!socket->connect(nameserver, 53))
+            continue;
+        dbgln_if(LOOKUPSERVER_DEBUG, "Doing lookup using nameserver '{}'", nameserver);
+        queries.append({ nameserver, move(socket), build_request(ShouldRandomizeCase::Yes) });
     }
 
-    if (!udp_socket->connect(nameserver, 53))
-        return {};
-
-    if (!udp_socket->write(buffer))
-        return {};
-
-    u8 response_buffer[4096];
-    int nrecv = udp_socket->read(response_buffer, sizeof(response_buffer));
-    if (nrecv == 0)
-        return {};
-
-    did_get_response = true;
-
-    auto o_response = DNSPacket::from_raw_packet(response_buffer, nrecv);
-    if (!o_response.has_value())
-        return {};
-
-    auto& response = o_response.value();
-
-    if (response.id() != request.id()) {
-        dbgln("LookupServer: ID mismatch ({} vs {}) :(", response.id(), request.id());
-        return {};
-    }
+    auto send_request = [](UpstreamQuery& query) {
+        auto buffer = query.request.to_byte_buffer();
+        if (!query.socket->write(buffer))
+            query.done = true;
+    };
 
-    if (response.code() == DNSPacket::Code::REFUSED) {
-        if (should_randomize_case == ShouldRandomizeCase::Yes) {
-            // Retry with 0x20 case randomization turned off.
-            return lookup(name, nameserver, did_get_response, record_type, ShouldRandomizeCase::No);
+    // Three one-second rounds; a round re-sends to every nameserver that
+    // hasn't answered yet, so one dead server costs nothing as long as
+    // another one responds.
+    for (int retries = 3; retries > 0; --retries) {
+        for (auto& query : queries) {
+            if (!query.done)
+                send_request(query);
         }
-        return {};
-    }
 
-    if (response.question_count() != request.question_count()) {
-        dbgln("LookupServer: Question count ({} vs {}) :(", response.question_count(), request.question_count());
-        return {};
-    }
-
-    // Verify the questions in our request and in their response match exactly, including case.
-    for (size_t i = 0; i < request.question_count(); ++i) {
-        auto& request_question = request.questions()[i];
-        auto& response_question = response.questions()[i];
-        bool exact_match = request_question.class_code() == response_question.class_code()
-            && request_question.record_type() == response_question.record_type()
-            && request_question.name().as_string() == response_question.name().as_string();
-        if (!exact_match) {
-            dbgln("Request and response questions do not match");
-            dbgln("   Request: name=_{}_, type={}, class={}", request_question.name().as_string(), response_question.record_type(), response_question.class_code());
-            dbgln("  Response: name=_{}_, type={}, class={}", response_question.name().as_string(), response_question.record_type(), response_question.class_code());
-            return {};
-        }
-    }
+        Core::ElapsedTimer timer;
+        timer.start();
+        for (;;) {
+            fd_set read_fds;
+            FD_ZERO(&read_fds);
+            int max_fd = -1;
+            size_t pending_count = 0;
+            for (auto& query : queries) {
+                if (query.done)
+                    continue;
+                FD_SET(query.socket->fd(), &read_fds);
+                max_fd = max(max_fd, query.socket->fd());
+                ++pending_count;
+            }
+            if (pending_count == 0)
+                return {};
 
-    if (response.answer_count() < 1) {
-        dbgln("LookupServer: No answers :(");
-        return {};
-    }
+            int remaining_ms = 1000 - timer.elapsed();
+            if (remaining_ms <= 0)
+                break;
+            struct timeval timeout {
+                remaining_ms / 1000, (remaining_ms % 1000) * 1000
+            };
+            int rc = select(max_fd + 1, &read_fds, nullptr, nullptr, &timeout);
+            if (rc < 0) {
+                if (errno == EINTR)
+                    continue;
+                perror("select");
+                return {};
+            }
+            if (rc == 0)
+                break;
 
-    Vector<DNSAnswer, 8> answers;
-    for (auto& answer : response.answers()) {
-        put_in_cache(answer);
-        if (answer.type() != record_type)
-            continue;
-        answers.append(answer);
+            for (auto& query : queries) {
+                if (query.done || !FD_ISSET(query.socket->fd(), &read_fds))
+                    continue;
+
+                u8 response_buffer[4096];
+                int nrecv = query.socket->read(response_buffer, sizeof(response_buffer));
+                if (nrecv <= 0) {
+                    query.done = true;
+                    continue;
+                }
+
+                auto o_response = DNSPacket::from_raw_packet(response_buffer, nrecv);
+                if (!o_response.has_value())
+                    continue;
+
+                auto& response = o_response.value();
+
+                if (response.id() != query.request.id()) {
+                    dbgln("LookupServer: ID mismatch ({} vs {}) :(", response.id(), query.request.id());
+                    continue;
+                }
+
+                if (response.code() == DNSPacket::Code::REFUSED) {
+                    if (query.randomize_case == ShouldRandomizeCase::Yes) {
+                        // Retry with 0x20 case randomization turned off.
+                        query.randomize_case = ShouldRandomizeCase::No;
+                        query.request = build_request(ShouldRandomizeCase::No);
+                        send_request(query);
+                        continue;
+                    }
+                    query.done = true;
+                    continue;
+                }
+
+                if (response.question_count() != query.request.question_count()) {
+                    dbgln("LookupServer: Question count ({} vs {}) :(", response.question_count(), query.request.question_count());
+                    query.done = true;
+                    continue;
+                }
+
+                // Verify the questions in our request and in their response match exactly, including case.
+                bool questions_match = true;
+                for (size_t i = 0; i < query.request.question_count(); ++i) {
+                    auto& request_question = query.request.questions()[i];
+                    auto& response_question = response.questions()[i];
+                    bool exact_match = request_question.class_code() == response_question.class_code()
+                        && request_question.record_type() == response_question.record_type()
+                        && request_question.name().as_string() == response_question.name().as_string();
+                    if (!exact_match) {
+                        dbgln("Request and response questions do not match");
+                        dbgln("   Request: name=_{}_, type={}, class={}", request_question.name().as_string(), response_question.record_type(), response_question.class_code());
+                        dbgln("  Response: name=_{}_, type={}, class={}", response_question.name().as_string(), response_question.record_type(), response_question.class_code());
+                        questions_match = false;
+                        break;
+                    }
+                }
+                if (!questions_match) {
+                    query.done = true;
+                    continue;
+                }
+
+                did_get_response = true;
+
+                if (response.answer_count() < 1) {
+                    dbgln("LookupServer: No answers from '{}'", query.nameserver);
+                    query.done = true;
+                    continue;
+                }
+
+                Vector<DNSAnswer> answers;
+                for (auto& answer : response.answers()) {
+                    put_in_cache(answer);
+                    if (answer.type() != record_type)
+                        continue;
+                    answers.append(answer);
+                }
+                if (!answers.is_empty())
+                    return answers;
+                query.done = true;
+            }
+        }
     }
 
-    return answers;
+    return {};
 }
 
 void LookupServer::put_in_cache(const DNSAnswer& answer)
@@ -330,10 +414,23 @@ void LookupServer::put_in_cache(const DNSAnswer& answer)
     if (answer.has_expired())
         return;
 
-    // Prevent the cache from growing too big.
-    // TODO: Evict least used entries.
-    if (m_lookup_cache.size() >= 256)
-        m_lookup_cache.remove(m_lookup_cache.begin());
+    // A fresh record supersedes any cached negative result.
+    m_negative_cache.remove(negative_cache_key(answer.name(), answer.type()));
+
+    // Prevent the cache from growing too big: drop whatever has expired
+    // first, and only evict an arbitrary entry if everything is still live.
+    if (m_lookup_cache.size() >= 256) {
+        Vector<DNSName> expired_names;
+        for (auto& it : m_lookup_cache) {
+            it.value.remove_all_matching([](DNSAnswer const& cached_answer) { return cached_answer.has_expired(); });
+            if (it.value.is_empty())
+                expired_names.append(it.key);
+        }
+        for (auto& expired_name : expired_names)
+            m_lookup_cache.remove(expired_name);
+        if (m_lookup_cache.size() >= 256)
+            m_lookup_cache.remove(m_lookup_cache.begin());
+    }
 
     auto it = m_lookup_cache.find(answer.name());
     if (it == m_lookup_cache.end())
@@ -41,22 +41,22 @@ Messages::RequestServer::StartRequestResponse ClientConnection::start_request(St
 {
     if (!url.is_valid()) {
         dbgln("StartRequest: Invalid URL requested: '{}'", url);
-        return { -1, Optional<IPC::File> {} };
+        return { -1, Optional<Core::AnonymousBuffer> {} };
     }
     auto* protocol = Protocol::find_by_name(url.protocol());
     if (!protocol) {
         dbgln("StartRequest: No protocol handler for URL: '{}'", url);
-        return { -1, Optional<IPC::File> {} };
+        return { -1, Optional<Core::AnonymousBuffer> {} };
     }
     auto request = protocol->start_request(*this, method, url, request_headers.entries(), request_body);
     if (!request) {
         dbgln("StartRequest: Protocol handler failed to start request: '{}'", url);
-        return { -1, Optional<IPC::File> {} };
+        return { -1, Optional<Core::AnonymousBuffer> {} };
     }
     auto id = request->id();
-    auto fd = request->request_fd();
+    auto buffer = request->payload_buffer();
     m_requests.set(id, move(request));
-    return { id, IPC::File(fd, IPC::File::CloseAfterSending) };
+    return { id, move(buffer) };
 }
 
 Messages::RequestServer::StopRequestResponse ClientConnection::stop_request(i32 request_id)
@@ -99,6 +99,12 @@ void ClientConnection::did_request_certificates(Badge<Request>, Request& request
     async_certificate_requested(request.id());
 }
 
+void ClientConnection::notify_request_payload_consumed(i32 request_id)
+{
+    if (auto* request = const_cast<Request*>(m_requests.get(request_id).value_or(nullptr)))
+        request->payload_was_consumed();
+}
+
 Messages::RequestServer::SetCertificateResponse ClientConnection::set_certificate(i32 request_id, String const& certificate, String const& key)
 {
     auto* request = const_cast<Request*>(m_requests.get(request_id).value_or(nullptr));
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ConnectionCache.h"
+
+namespace RequestServer::ConnectionCache {
+
+CacheType<Core::TCPSocket> g_tcp_connection_cache {};
+CacheType<TLS::TLSv12> g_tls_connection_cache {};
+
+String key_for_url(const URL& url)
+{
+    return String::formatted("{}:{}", url.host(), url.port());
+}
+
+}
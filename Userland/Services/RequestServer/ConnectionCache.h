@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Debug.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtrVector.h>
+#include <AK/URL.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/TCPSocket.h>
+#include <LibCore/Timer.h>
+#include <LibTLS/TLSv12.h>
+
+namespace RequestServer::ConnectionCache {
+
+// Keep-alive connections to recently used servers, keyed by host:port.
+// A connection serves one job at a time; when that job finishes with a
+// reusable connection (keep-alive, body fully delimited), the socket
+// goes back into the pool instead of being torn down, sparing the next
+// request to the same host the TCP connect and - far more noticeably -
+// the TLS handshake. Idle connections are dropped after a timeout or
+// as soon as the server closes its end. Each host keeps at most
+// max_connections_per_host pooled sockets; requests beyond the cap get
+// a one-shot connection that is not pooled.
+
+constexpr size_t max_connections_per_host = 4;
+constexpr int connection_idle_timeout_ms = 30'000;
+
+template<typename Socket>
+struct Connection {
+    NonnullRefPtr<Socket> socket;
+    RefPtr<Core::Timer> removal_timer;
+    bool busy { false };
+};
+
+template<typename Socket>
+using CacheType = HashMap<String, NonnullOwnPtrVector<Connection<Socket>>>;
+
+extern CacheType<Core::TCPSocket> g_tcp_connection_cache;
+extern CacheType<TLS::TLSv12> g_tls_connection_cache;
+
+String key_for_url(const URL&);
+
+template<typename Socket>
+void remove_connection(CacheType<Socket>& cache, String const& key, Socket const* socket)
+{
+    auto it = cache.find(key);
+    if (it == cache.end())
+        return;
+    for (size_t i = 0; i < it->value.size(); ++i) {
+        if (it->value[i].socket.ptr() == socket) {
+            it->value.remove(i);
+            break;
+        }
+    }
+    if (it->value.is_empty())
+        cache.remove(key);
+}
+
+// An idle connection becoming readable means the server closed it (or
+// sent something we never asked for); either way it's of no further use.
+template<typename Socket>
+void watch_idle_connection(CacheType<Socket>& cache, String const& key, Socket& socket)
+{
+    if constexpr (IsSame<Socket, Core::TCPSocket>) {
+        socket.on_ready_to_read = [&cache, key, &socket] { remove_connection(cache, key, &socket); };
+    } else {
+        socket.on_tls_ready_to_read = [&cache, key, &socket](auto&) { remove_connection(cache, key, &socket); };
+        socket.on_tls_error = [&cache, key, &socket](auto) { remove_connection(cache, key, &socket); };
+        socket.on_tls_finished = [&cache, key, &socket] { remove_connection(cache, key, &socket); };
+    }
+}
+
+template<typename Socket>
+void unwatch_connection(Socket& socket)
+{
+    if constexpr (IsSame<Socket, Core::TCPSocket>) {
+        socket.on_ready_to_read = nullptr;
+    } else {
+        socket.on_tls_ready_to_read = nullptr;
+        socket.on_tls_error = nullptr;
+        socket.on_tls_finished = nullptr;
+    }
+}
+
+// Returns a busy-marked pooled socket (an idle one, or a freshly made
+// one if there's room under the cap), or nullptr if the host is at its
+// connection cap.
+template<typename Socket>
+RefPtr<Socket> get_or_create_connection(CacheType<Socket>& cache, const URL& url)
+{
+    auto key = key_for_url(url);
+    auto& connections = cache.ensure(key);
+    for (auto& connection : connections) {
+        if (connection.busy)
+            continue;
+        connection.busy = true;
+        connection.removal_timer->stop();
+        unwatch_connection(*connection.socket);
+        dbgln_if(REQUESTSERVER_DEBUG, "ConnectionCache: Reusing a connection to {}", key);
+        return connection.socket;
+    }
+    if (connections.size() >= max_connections_per_host)
+        return nullptr;
+
+    NonnullRefPtr<Socket> socket = Socket::construct(nullptr);
+    auto* socket_ptr = socket.ptr();
+    auto removal_timer = Core::Timer::create_single_shot(connection_idle_timeout_ms, [&cache, key, socket_ptr] {
+        dbgln_if(REQUESTSERVER_DEBUG, "ConnectionCache: Dropping an idle connection to {}", key);
+        remove_connection(cache, key, socket_ptr);
+    });
+    removal_timer->stop();
+    connections.append(adopt_own(*new Connection<Socket> { move(socket), move(removal_timer), true }));
+    return connections.last().socket;
+}
+
+template<typename Socket>
+void request_did_finish(CacheType<Socket>& cache, const URL& url, Socket const* socket, bool can_reuse)
+{
+    auto key = key_for_url(url);
+    auto it = cache.find(key);
+    if (it == cache.end())
+        return;
+    for (auto& connection : it->value) {
+        if (connection.socket.ptr() != socket)
+            continue;
+        if (!can_reuse) {
+            remove_connection(cache, key, socket);
+            return;
+        }
+        connection.busy = false;
+        connection.removal_timer->start(connection_idle_timeout_ms);
+        watch_idle_connection(cache, key, *connection.socket);
+        return;
+    }
+}
+
+template<typename Socket, typename JobType>
+void start_job(CacheType<Socket>& cache, URL const& url, JobType& job)
+{
+    auto pooled_socket = get_or_create_connection(cache, url);
+    if (!pooled_socket) {
+        // This host is at its connection cap; serve the request over a
+        // one-shot connection that the job tears down as usual.
+        job.start(Socket::construct(nullptr));
+        return;
+    }
+
+    NonnullRefPtr<Socket> socket = pooled_socket.release_nonnull();
+    auto on_finish = move(job.on_finish);
+    job.on_finish = [&job, &cache, url, socket, on_finish = move(on_finish)](bool success) {
+        bool can_reuse = success && !socket->eof();
+        if (can_reuse) {
+            if (auto* response = job.response()) {
+                auto connection_header = response->headers().get("Connection");
+                if (connection_header.has_value() && connection_header->trim_whitespace().equals_ignoring_case("close"))
+                    can_reuse = false;
+            } else {
+                can_reuse = false;
+            }
+        }
+        // The job detaches from the socket right after this callback
+        // returns, so hand the connection back on the next event loop
+        // pass.
+        Core::deferred_invoke([&cache, url, socket, can_reuse] {
+            request_did_finish(cache, url, socket.ptr(), can_reuse);
+        });
+        on_finish(success);
+    };
+    job.start(move(socket));
+}
+
+}
@@ -6,6 +6,7 @@
 
 #include <LibGemini/GeminiJob.h>
 #include <LibGemini/GeminiRequest.h>
+#include <RequestServer/ClientConnection.h>
 #include <RequestServer/GeminiProtocol.h>
 #include <RequestServer/GeminiRequest.h>
 
@@ -25,15 +26,17 @@ OwnPtr<Request> GeminiProtocol::start_request(ClientConnection& client, const St
     Gemini::GeminiRequest request;
     request.set_url(url);
 
-    auto pipe_result = get_pipe_for_request();
-    if (pipe_result.is_error())
+    auto ring = ::Protocol::RequestPayloadRing::create();
+    if (!ring)
         return {};
 
-    auto output_stream = make<OutputFileStream>(pipe_result.value().write_fd);
-    output_stream->make_unbuffered();
+    auto output_stream = make<RequestPayloadStream>(ring.release_nonnull());
     auto job = Gemini::GeminiJob::construct(request, *output_stream);
     auto protocol_request = GeminiRequest::create_with_job({}, client, (Gemini::GeminiJob&)*job, move(output_stream));
-    protocol_request->set_request_fd(pipe_result.value().read_fd);
+    auto request_id = protocol_request->id();
+    protocol_request->output_stream().on_data_written = [&client, request_id] {
+        client.async_request_payload_available(request_id);
+    };
     job->start();
     return protocol_request;
 }
@@ -10,7 +10,7 @@
 
 namespace RequestServer {
 
-GeminiRequest::GeminiRequest(ClientConnection& client, NonnullRefPtr<Gemini::GeminiJob> job, NonnullOwnPtr<OutputFileStream>&& output_stream)
+GeminiRequest::GeminiRequest(ClientConnection& client, NonnullRefPtr<Gemini::GeminiJob> job, NonnullOwnPtr<RequestPayloadStream>&& output_stream)
     : Request(client, move(output_stream))
     , m_job(job)
 {
@@ -49,6 +49,11 @@ void GeminiRequest::set_certificate(String certificate, String key)
     m_job->set_certificate(move(certificate), move(key));
 }
 
+void GeminiRequest::payload_was_consumed()
+{
+    m_job->flush_received_buffers();
+}
+
 GeminiRequest::~GeminiRequest()
 {
     m_job->on_finish = nullptr;
@@ -56,7 +61,7 @@ GeminiRequest::~GeminiRequest()
     m_job->shutdown();
 }
 
-NonnullOwnPtr<GeminiRequest> GeminiRequest::create_with_job(Badge<GeminiProtocol>, ClientConnection& client, NonnullRefPtr<Gemini::GeminiJob> job, NonnullOwnPtr<OutputFileStream>&& output_stream)
+NonnullOwnPtr<GeminiRequest> GeminiRequest::create_with_job(Badge<GeminiProtocol>, ClientConnection& client, NonnullRefPtr<Gemini::GeminiJob> job, NonnullOwnPtr<RequestPayloadStream>&& output_stream)
 {
     return adopt_own(*new GeminiRequest(client, move(job), move(output_stream)));
 }
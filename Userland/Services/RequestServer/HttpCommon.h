@@ -14,7 +14,9 @@
 #include <AK/String.h>
 #include <AK/Types.h>
 #include <LibHTTP/HttpRequest.h>
+#include <LibHTTP/HttpsJob.h>
 #include <RequestServer/ClientConnection.h>
+#include <RequestServer/ConnectionCache.h>
 #include <RequestServer/Request.h>
 
 namespace RequestServer::Detail {
@@ -52,15 +54,15 @@ void init(TSelf* self, TJob job)
     }
 }
 
-template<typename TBadgedProtocol, typename TPipeResult>
-OwnPtr<Request> start_request(TBadgedProtocol&& protocol, ClientConnection& client, const String& method, const URL& url, const HashMap<String, String>& headers, ReadonlyBytes body, TPipeResult&& pipe_result)
+template<typename TBadgedProtocol>
+OwnPtr<Request> start_request(TBadgedProtocol&& protocol, ClientConnection& client, const String& method, const URL& url, const HashMap<String, String>& headers, ReadonlyBytes body)
 {
     using TJob = typename TBadgedProtocol::Type::JobType;
     using TRequest = typename TBadgedProtocol::Type::RequestType;
 
-    if (pipe_result.is_error()) {
+    auto ring = ::Protocol::RequestPayloadRing::create();
+    if (!ring)
         return {};
-    }
 
     HTTP::HttpRequest request;
     if (method.equals_ignoring_case("post"))
@@ -75,12 +77,17 @@ OwnPtr<Request> start_request(TBadgedProtocol&& protocol, ClientConnection& clie
         return {};
     request.set_body(allocated_body_result.release_value());
 
-    auto output_stream = make<OutputFileStream>(pipe_result.value().write_fd);
-    output_stream->make_unbuffered();
+    auto output_stream = make<RequestPayloadStream>(ring.release_nonnull());
     auto job = TJob::construct(request, *output_stream);
     auto protocol_request = TRequest::create_with_job(forward<TBadgedProtocol>(protocol), client, (TJob&)*job, move(output_stream));
-    protocol_request->set_request_fd(pipe_result.value().read_fd);
-    job->start();
+    auto request_id = protocol_request->id();
+    protocol_request->output_stream().on_data_written = [&client, request_id] {
+        client.async_request_payload_available(request_id);
+    };
+    if constexpr (IsSame<TJob, HTTP::HttpsJob>)
+        ConnectionCache::start_job(ConnectionCache::g_tls_connection_cache, url, *job);
+    else
+        ConnectionCache::start_job(ConnectionCache::g_tcp_connection_cache, url, *job);
     return protocol_request;
 }
 
@@ -24,7 +24,7 @@ HttpsProtocol::HttpsProtocol()
 
 OwnPtr<Request> HttpsProtocol::start_request(ClientConnection& client, const String& method, const URL& url, const HashMap<String, String>& headers, ReadonlyBytes body)
 {
-    return Detail::start_request(Badge<HttpsProtocol> {}, client, method, url, headers, body, get_pipe_for_request());
+    return Detail::start_request(Badge<HttpsProtocol> {}, client, method, url, headers, body);
 }
 
 }
@@ -11,7 +11,7 @@
 
 namespace RequestServer {
 
-HttpsRequest::HttpsRequest(ClientConnection& client, NonnullRefPtr<HTTP::HttpsJob> job, NonnullOwnPtr<OutputFileStream>&& output_stream)
+HttpsRequest::HttpsRequest(ClientConnection& client, NonnullRefPtr<HTTP::HttpsJob> job, NonnullOwnPtr<RequestPayloadStream>&& output_stream)
     : Request(client, move(output_stream))
     , m_job(job)
 {
@@ -23,6 +23,11 @@ void HttpsRequest::set_certificate(String certificate, String key)
     m_job->set_certificate(move(certificate), move(key));
 }
 
+void HttpsRequest::payload_was_consumed()
+{
+    m_job->flush_received_buffers();
+}
+
 HttpsRequest::~HttpsRequest()
 {
     m_job->on_finish = nullptr;
@@ -30,7 +35,7 @@ HttpsRequest::~HttpsRequest()
     m_job->shutdown();
 }
 
-NonnullOwnPtr<HttpsRequest> HttpsRequest::create_with_job(Badge<HttpsProtocol>&&, ClientConnection& client, NonnullRefPtr<HTTP::HttpsJob> job, NonnullOwnPtr<OutputFileStream>&& output_stream)
+NonnullOwnPtr<HttpsRequest> HttpsRequest::create_with_job(Badge<HttpsProtocol>&&, ClientConnection& client, NonnullRefPtr<HTTP::HttpsJob> job, NonnullOwnPtr<RequestPayloadStream>&& output_stream)
 {
     return adopt_own(*new HttpsRequest(client, move(job), move(output_stream)));
 }
@@ -6,16 +6,57 @@
 
 #pragma once
 
-#include <AK/FileStream.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Optional.h>
 #include <AK/RefCounted.h>
+#include <AK/Stream.h>
 #include <AK/URL.h>
+#include <LibProtocol/RequestPayloadRing.h>
 #include <RequestServer/Forward.h>
 
 namespace RequestServer {
 
+// The stream a protocol job writes its downloaded payload into. Writes go
+// straight into the shared ring the client reads from; when the client has
+// stopped consuming and the ring is full, write() comes up short and the job
+// holds on to the rest (all jobs handle short writes and retry).
+class RequestPayloadStream final : public OutputStream {
+public:
+    explicit RequestPayloadStream(NonnullOwnPtr<::Protocol::RequestPayloadRing> ring)
+        : m_ring(move(ring))
+    {
+    }
+
+    // Invoked whenever bytes make it into the ring, to poke the client.
+    Function<void()> on_data_written;
+
+    const Core::AnonymousBuffer& buffer() const { return m_ring->buffer(); }
+    size_t size() const { return m_total_written; }
+
+    virtual size_t write(ReadonlyBytes bytes) override
+    {
+        auto nwritten = m_ring->write(bytes);
+        m_total_written += nwritten;
+        if (nwritten > 0 && on_data_written)
+            on_data_written();
+        return nwritten;
+    }
+
+    virtual bool write_or_error(ReadonlyBytes bytes) override
+    {
+        if (write(bytes) < bytes.size()) {
+            set_recoverable_error();
+            return false;
+        }
+        return true;
+    }
+
+private:
+    NonnullOwnPtr<::Protocol::RequestPayloadRing> m_ring;
+    size_t m_total_written { 0 };
+};
+
 class Request {
 public:
     virtual ~Request();
@@ -31,9 +72,11 @@ public:
     void stop();
     virtual void set_certificate(String, String);
 
-    // FIXME: Want Badge<Protocol>, but can't make one from HttpProtocol, etc.
-    void set_request_fd(int fd) { m_request_fd = fd; }
-    int request_fd() const { return m_request_fd; }
+    // The client consumed bytes from the ring; give the job a chance to
+    // flush anything it had to hold back.
+    virtual void payload_was_consumed() { }
+
+    const Core::AnonymousBuffer& payload_buffer() const { return m_output_stream->buffer(); }
 
     void did_finish(bool success);
     void did_progress(Optional<u32> total_size, u32 downloaded_size);
@@ -41,20 +84,20 @@ public:
     void did_request_certificates();
     void set_response_headers(const HashMap<String, String, CaseInsensitiveStringTraits>&);
     void set_downloaded_size(size_t size) { m_downloaded_size = size; }
-    const OutputFileStream& output_stream() const { return *m_output_stream; }
+    RequestPayloadStream& output_stream() { return *m_output_stream; }
+    const RequestPayloadStream& output_stream() const { return *m_output_stream; }
 
 protected:
-    explicit Request(ClientConnection&, NonnullOwnPtr<OutputFileStream>&&);
+    explicit Request(ClientConnection&, NonnullOwnPtr<RequestPayloadStream>&&);
 
 private:
     ClientConnection& m_client;
     i32 m_id { 0 };
-    int m_request_fd { -1 }; // Passed to client.
     URL m_url;
     Optional<u32> m_status_code;
     Optional<u32> m_total_size {};
     size_t m_downloaded_size { 0 };
-    NonnullOwnPtr<OutputFileStream> m_output_stream;
+    NonnullOwnPtr<RequestPayloadStream> m_output_stream;
     HashMap<String, String, CaseInsensitiveStringTraits> m_response_headers;
 };
 
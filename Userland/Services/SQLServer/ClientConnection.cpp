@@ -81,4 +81,16 @@ void ClientConnection::statement_execute(int statement_id)
     }
 }
 
+void ClientConnection::statement_execute_with_parameters(int statement_id, Vector<SQL::Value> const& parameters)
+{
+    dbgln_if(SQLSERVER_DEBUG, "ClientConnection::statement_execute_with_parameters(statement_id: {}, {} parameter(s))", statement_id, parameters.size());
+    auto statement = SQLStatement::statement_for(statement_id);
+    if (statement && statement->connection()->client_id() == client_id()) {
+        statement->execute(parameters);
+    } else {
+        dbgln_if(SQLSERVER_DEBUG, "Statement has disappeared");
+        async_execution_error(statement_id, (int)SQL::SQLErrorCode::StatementUnavailable, String::formatted("{}", statement_id));
+    }
+}
+
 }
@@ -51,7 +51,7 @@ void SQLStatement::report_error(SQL::SQLError error)
     m_result = nullptr;
 }
 
-void SQLStatement::execute()
+void SQLStatement::execute(Vector<SQL::Value> placeholder_values)
 {
     dbgln_if(SQLSERVER_DEBUG, "SQLStatement::execute(statement_id {}", statement_id());
     auto client_connection = ClientConnection::client_connection_for(connection()->client_id());
@@ -60,25 +60,53 @@ void SQLStatement::execute()
         return;
     }
 
-    deferred_invoke([&] {
+    deferred_invoke([this, placeholder_values = move(placeholder_values)] {
         auto maybe_error = parse();
         if (maybe_error.has_value()) {
             report_error(maybe_error.value());
             return;
         }
+
+        // The values for one execution are bound positionally; handing in
+        // a multiple of the placeholder count executes the statement once
+        // per group, all in this one round trip.
+        size_t number_of_executions = 1;
+        if (m_number_of_placeholders > 0) {
+            if (placeholder_values.size() == 0 || placeholder_values.size() % m_number_of_placeholders != 0) {
+                report_error({ SQL::SQLErrorCode::InvalidNumberOfPlaceholderValues, m_sql });
+                return;
+            }
+            number_of_executions = placeholder_values.size() / m_number_of_placeholders;
+        }
+
         VERIFY(!connection()->database().is_null());
         SQL::AST::ExecutionContext context { connection()->database().release_nonnull() };
-        m_result = m_statement->execute(context);
-        if (m_result->error().code != SQL::SQLErrorCode::NoError) {
-            report_error(m_result->error());
-            return;
+        int updated = 0;
+        int inserted = 0;
+        int deleted = 0;
+        for (auto execution = 0u; execution < number_of_executions; execution++) {
+            context.placeholder_values.clear_with_capacity();
+            for (auto ix = 0u; ix < m_number_of_placeholders; ix++)
+                context.placeholder_values.append(placeholder_values[execution * m_number_of_placeholders + ix]);
+            m_result = m_statement->execute(context);
+            if (m_result->error().code != SQL::SQLErrorCode::NoError) {
+                report_error(m_result->error());
+                return;
+            }
+            updated += m_result->updated();
+            inserted += m_result->inserted();
+            deleted += m_result->deleted();
         }
+        // Commit the changes of all executions at once. This groups every
+        // page they dirtied into a single write-ahead log append with one
+        // fsync().
+        connection()->database()->commit();
         auto client_connection = ClientConnection::client_connection_for(connection()->client_id());
         if (!client_connection) {
             warnln("Cannot return statement execution results. Client disconnected");
             return;
         }
-        client_connection->async_execution_success(statement_id(), m_result->has_results(), m_result->updated(), m_result->inserted(), m_result->deleted());
+        client_connection->async_execution_success(statement_id(), m_result->has_results(), updated, inserted, deleted);
         if (m_result->has_results()) {
             m_index = 0;
             next();
@@ -88,11 +116,17 @@ void SQLStatement::execute()
 
 Optional<SQL::SQLError> SQLStatement::parse()
 {
+    // The statement is parsed once and the AST reused by subsequent
+    // executions; only the bound values change.
+    if (m_statement)
+        return {};
     auto parser = SQL::AST::Parser(SQL::AST::Lexer(m_sql));
     m_statement = parser.next_statement();
     if (parser.has_errors()) {
+        m_statement = nullptr;
         return SQL::SQLError { SQL::SQLErrorCode::SyntaxError, parser.errors()[0].to_string() };
     }
+    m_number_of_placeholders = parser.number_of_placeholders();
     return {};
 }
 
@@ -8,9 +8,11 @@
 
 #include <AK/NonnullRefPtr.h>
 #include <AK/String.h>
+#include <AK/Vector.h>
 #include <LibCore/Object.h>
 #include <LibSQL/AST/AST.h>
 #include <LibSQL/SQLResult.h>
+#include <LibSQL/Value.h>
 #include <SQLServer/DatabaseConnection.h>
 #include <SQLServer/Forward.h>
 
@@ -24,7 +26,7 @@ class SQLStatement final : public Core::Object {
     int statement_id() const { return m_statement_id; }
     String const& sql() const { return m_sql; }
     DatabaseConnection* connection() { return dynamic_cast<DatabaseConnection*>(parent()); }
-    void execute();
+    void execute(Vector<SQL::Value> placeholder_values = {});
 
 private:
     SQLStatement(DatabaseConnection&, String sql);
@@ -35,6 +37,7 @@ private:
     int m_statement_id;
     String m_sql;
     size_t m_index { 0 };
+    size_t m_number_of_placeholders { 0 };
     RefPtr<SQL::AST::Statement> m_statement { nullptr };
     RefPtr<SQL::SQLResult> m_result { nullptr };
 };
@@ -14,6 +14,7 @@
 #include <LibCore/File.h>
 #include <LibCore/Socket.h>
 #include <fcntl.h>
+#include <netinet/in.h>
 #include <sched.h>
 #include <stdio.h>
 #include <sys/ioctl.h>
@@ -33,6 +34,37 @@ void Service::setup_socket(SocketDescriptor& socket)
 {
     VERIFY(socket.fd == -1);
 
+    // A pseudo-path like "tcp:23" asks for an AF_INET listener on that port
+    // instead of a local socket, so TCP services can be socket-activated too.
+    if (socket.path.starts_with("tcp:")) {
+        auto port = socket.path.substring_view(4).to_uint<u16>();
+        if (!port.has_value()) {
+            dbgln("{}: Invalid TCP socket spec \"{}\"", name(), socket.path);
+            VERIFY_NOT_REACHED();
+        }
+
+        int socket_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (socket_fd < 0) {
+            perror("socket");
+            VERIFY_NOT_REACHED();
+        }
+        socket.fd = socket_fd;
+
+        sockaddr_in sin {};
+        sin.sin_family = AF_INET;
+        sin.sin_port = htons(port.value());
+        sin.sin_addr.s_addr = htonl(INADDR_ANY);
+        if (bind(socket_fd, (const sockaddr*)&sin, sizeof(sin)) < 0) {
+            perror("bind");
+            VERIFY_NOT_REACHED();
+        }
+        if (listen(socket_fd, 16) < 0) {
+            perror("listen");
+            VERIFY_NOT_REACHED();
+        }
+        return;
+    }
+
     auto ok = Core::File::ensure_parent_directories(socket.path);
     VERIFY(ok);
 
@@ -123,6 +155,7 @@ void Service::activate()
 {
     VERIFY(m_pid < 0);
 
+    m_activated = true;
     if (m_lazy)
         setup_notifier();
     else
@@ -317,6 +350,7 @@ Service::Service(const Core::ConfigFile& config, const StringView& name)
     m_boot_modes = config.read_entry(name, "BootModes", "graphical").split(',');
     m_multi_instance = config.read_bool_entry(name, "MultiInstance");
     m_accept_socket_connections = config.read_bool_entry(name, "AcceptSocketConnections");
+    m_dependencies = config.read_entry(name, "DependsOn").split(',');
 
     String socket_entry = config.read_entry(name, "Socket");
     String socket_permissions_entry = config.read_entry(name, "SocketPermissions", "0600");
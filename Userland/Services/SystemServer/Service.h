@@ -21,6 +21,10 @@ public:
     void activate();
     void did_exit(int exit_code);
 
+    // Names of the services (config groups) that must be activated before this one.
+    Vector<String> const& dependencies() const { return m_dependencies; }
+    bool has_been_activated() const { return m_activated; }
+
     static Service* find_by_pid(pid_t);
 
     // FIXME: Port to Core::Property
@@ -65,6 +69,10 @@ private:
     Vector<String> m_boot_modes;
     // Whether several instances of this service can run at once.
     bool m_multi_instance { false };
+    // Services that have to be activated before this one.
+    Vector<String> m_dependencies;
+    // Whether activate() has been called on this service yet.
+    bool m_activated { false };
     // Environment variables to pass to the service.
     Vector<String> m_environment;
     // Socket descriptors for this service.
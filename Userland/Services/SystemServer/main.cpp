@@ -8,6 +8,7 @@
 #include <AK/Assertions.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Debug.h>
+#include <AK/HashMap.h>
 #include <LibCore/ConfigFile.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/Event.h>
@@ -484,10 +485,51 @@ int main(int, char**)
             services.append(service);
     }
 
-    // After we've set them all up, activate them!
+    // After we've set them all up, activate them! Services may declare
+    // DependsOn= other services, and only start once everything they depend
+    // on has been activated. Since activation just forks (the pre-created
+    // sockets queue up any connection attempts until the service is ready),
+    // all services whose dependencies are met get started back to back and
+    // initialize concurrently instead of one after the other.
     dbgln("Activating {} services...", services.size());
+    HashMap<String, Service*> services_by_name;
     for (auto& service : services)
-        service.activate();
+        services_by_name.set(service.name(), &service);
+
+    size_t activated_count = 0;
+    while (activated_count < services.size()) {
+        bool activated_any = false;
+        for (auto& service : services) {
+            if (service.has_been_activated())
+                continue;
+            bool dependencies_met = true;
+            for (auto& dependency : service.dependencies()) {
+                auto it = services_by_name.find(dependency);
+                // A dependency that's disabled in this boot mode (or simply
+                // unknown) can never be met; don't hold the service back on it.
+                if (it == services_by_name.end())
+                    continue;
+                if (!it->value->has_been_activated()) {
+                    dependencies_met = false;
+                    break;
+                }
+            }
+            if (!dependencies_met)
+                continue;
+            service.activate();
+            ++activated_count;
+            activated_any = true;
+        }
+        if (!activated_any) {
+            dbgln("Dependency cycle in SystemServer config! Activating the remaining services in config order.");
+            for (auto& service : services) {
+                if (!service.has_been_activated()) {
+                    service.activate();
+                    ++activated_count;
+                }
+            }
+        }
+    }
 
     return event_loop.exec();
 }
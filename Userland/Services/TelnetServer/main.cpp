@@ -98,7 +98,14 @@ int main(int argc, char** argv)
     Core::EventLoop event_loop;
     auto server = Core::TCPServer::construct();
 
-    if (!server->listen({}, port)) {
+    // When spawned by SystemServer's socket activation, take over the
+    // already-listening socket instead of binding our own.
+    if (getenv("SOCKET_TAKEOVER")) {
+        if (!server->take_over_from_system_server()) {
+            warnln("Taking over the listening socket from SystemServer failed");
+            exit(1);
+        }
+    } else if (!server->listen({}, port)) {
         warnln("Listening on 0.0.0.0:{} failed", port);
         exit(1);
     }
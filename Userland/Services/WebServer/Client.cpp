@@ -7,6 +7,7 @@
 
 #include <AK/Base64.h>
 #include <AK/Debug.h>
+#include <AK/HashMap.h>
 #include <AK/LexicalPath.h>
 #include <AK/MappedFile.h>
 #include <AK/MemoryStream.h>
@@ -16,18 +17,55 @@
 #include <LibCore/DateTime.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/File.h>
-#include <LibCore/FileStream.h>
 #include <LibCore/MimeData.h>
 #include <LibHTTP/HttpRequest.h>
 #include <LibHTTP/HttpResponse.h>
 #include <WebServer/Client.h>
 #include <WebServer/Configuration.h>
+#include <errno.h>
 #include <stdio.h>
+#include <sys/sendfile.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
 namespace WebServer {
 
+// A small cache of open files and their stats for hot static assets, so
+// repeat requests (firmware images, icons, ...) skip the open() and serve
+// straight off an already-open fd. Entries are revalidated with a stat()
+// on every hit and dropped when the file changed underneath us.
+struct CachedFile {
+    NonnullRefPtr<Core::File> file;
+    struct stat st;
+};
+
+static HashMap<String, CachedFile> s_file_cache;
+static constexpr size_t file_cache_max_entries = 32;
+
+static CachedFile* cached_file_for_path(String const& path)
+{
+    struct stat st = {};
+    if (stat(path.characters(), &st) < 0)
+        return nullptr;
+
+    auto it = s_file_cache.find(path);
+    if (it != s_file_cache.end()) {
+        auto& cached = it->value;
+        if (cached.st.st_ino == st.st_ino && cached.st.st_mtime == st.st_mtime && cached.st.st_size == st.st_size)
+            return &cached;
+        s_file_cache.remove(path);
+    }
+
+    auto file = Core::File::construct(path);
+    if (!file->open(Core::OpenMode::ReadOnly))
+        return nullptr;
+
+    if (s_file_cache.size() >= file_cache_max_entries)
+        s_file_cache.remove(s_file_cache.begin()->key);
+    s_file_cache.set(path, CachedFile { move(file), st });
+    return &s_file_cache.find(path)->value;
+}
+
 Client::Client(NonnullRefPtr<Core::TCPSocket> socket, Core::Object* parent)
     : Core::Object(parent)
     , m_socket(socket)
@@ -117,20 +155,64 @@ void Client::handle_request(ReadonlyBytes raw_request)
         real_path = index_html_path;
     }
 
-    auto file = Core::File::construct(real_path);
-    if (!file->open(Core::OpenMode::ReadOnly)) {
+    auto* cached = cached_file_for_path(real_path);
+    if (!cached) {
         send_error_response(404, request);
         return;
     }
 
-    if (file->is_device()) {
+    if (!S_ISREG(cached->st.st_mode)) {
         send_error_response(403, request);
         return;
     }
 
-    Core::InputFileStream stream { file };
+    send_file_response(*cached->file, cached->st.st_size, request, Core::guess_mime_type_based_on_filename(real_path));
+}
 
-    send_response(stream, request, Core::guess_mime_type_based_on_filename(real_path));
+void Client::send_file_response(Core::File& file, size_t total_size, HTTP::HttpRequest const& request, String const& content_type)
+{
+    StringBuilder builder;
+    builder.append("HTTP/1.0 200 OK\r\n");
+    builder.append("Server: WebServer (SerenityOS)\r\n");
+    builder.append("X-Frame-Options: SAMEORIGIN\r\n");
+    builder.append("X-Content-Type-Options: nosniff\r\n");
+    builder.append("Pragma: no-cache\r\n");
+    builder.append("Content-Type: ");
+    builder.append(content_type);
+    builder.append("\r\n");
+    builder.appendff("Content-Length: {}\r\n", total_size);
+    builder.append("\r\n");
+
+    m_socket->write(builder.to_string());
+    log_response(200, request);
+
+    // Ship the body with sendfile(), so the bytes go from the file straight
+    // to the socket inside the kernel. The explicit offset keeps the cached
+    // fd's cursor untouched, so concurrent requests can share it.
+    off_t offset = 0;
+    while ((size_t)offset < total_size) {
+        auto nsent = sendfile(m_socket->fd(), file.fd(), &offset, total_size - offset);
+        if (nsent >= 0) {
+            if (nsent == 0)
+                break;
+            continue;
+        }
+        if (errno == EINTR || errno == EAGAIN)
+            continue;
+        // Unexpected failure; finish the response with a plain copy loop so
+        // the client still gets the rest of the body.
+        perror("sendfile");
+        lseek(file.fd(), offset, SEEK_SET);
+        char buffer[PAGE_SIZE];
+        while ((size_t)offset < total_size) {
+            auto nread = read(file.fd(), buffer, sizeof(buffer));
+            if (nread <= 0)
+                break;
+            m_socket->write({ buffer, (size_t)nread });
+            offset += nread;
+        }
+        break;
+    }
 }
 
 void Client::send_response(InputStream& response, HTTP::HttpRequest const& request, String const& content_type)
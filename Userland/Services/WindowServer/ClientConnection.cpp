@@ -658,6 +658,16 @@ void ClientConnection::set_global_mouse_tracking(bool enabled)
     m_does_global_mouse_tracking = enabled;
 }
 
+void ClientConnection::set_unbuffered_mouse_events(i32 window_id, bool enabled)
+{
+    auto it = m_windows.find(window_id);
+    if (it == m_windows.end()) {
+        did_misbehave("SetUnbufferedMouseEvents: Bad window ID");
+        return;
+    }
+    it->value->set_unbuffered_mouse_events(enabled);
+}
+
 void ClientConnection::set_window_cursor(i32 window_id, i32 cursor_type)
 {
     auto it = m_windows.find(window_id);
@@ -107,12 +107,12 @@ void CompositorScreenData::init_bitmaps(Compositor& compositor, Screen& screen)
     if (m_screen_can_set_buffer)
         m_back_bitmap = Gfx::Bitmap::try_create_wrapper(Gfx::BitmapFormat::BGRx8888, size, screen.scale_factor(), screen.pitch(), screen.scanline(1, 0));
     else
-        m_back_bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, size, screen.scale_factor());
+        m_back_bitmap = Gfx::Bitmap::try_create_pooled(Gfx::BitmapFormat::BGRx8888, size, screen.scale_factor());
     m_back_painter = make<Gfx::Painter>(*m_back_bitmap);
     m_back_painter->translate(-screen.rect().location());
 
     m_temp_bitmap = nullptr;
-    m_temp_bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRx8888, size, screen.scale_factor());
+    m_temp_bitmap = Gfx::Bitmap::try_create_pooled(Gfx::BitmapFormat::BGRx8888, size, screen.scale_factor());
     m_temp_painter = make<Gfx::Painter>(*m_temp_bitmap);
     m_temp_painter->translate(-screen.rect().location());
 }
@@ -154,6 +154,16 @@ Gfx::IntPoint Compositor::window_transition_offset(Window& window)
 
 void Compositor::compose()
 {
+    m_frame_start_timer.start();
+
+    // When clients have display links enabled, deliver their frame callbacks
+    // as part of the compose wakeup rather than from the free-running timer.
+    // That batches animation ticks and rendering into a single aligned wakeup
+    // per frame; the timer only ends up firing for frames where nothing
+    // composed at all.
+    if (m_display_link_count && (!m_display_link_frame_timer.is_valid() || m_display_link_frame_timer.elapsed() >= 1000 / 60))
+        notify_display_links();
+
     auto& wm = WindowManager::the();
 
     {
@@ -265,8 +275,11 @@ void Compositor::compose()
         if (m_current_cursor_screen) {
             if (m_current_cursor_screen->compositor_screen_data().restore_cursor_back(*m_current_cursor_screen, previous_cursor_rect))
                 previous_cursor_screen = m_current_cursor_screen;
+            if (m_hardware_cursor_enabled && m_current_cursor_screen->can_set_hardware_cursor())
+                m_current_cursor_screen->set_hardware_cursor(nullptr);
         }
         m_current_cursor_screen = &cursor_screen;
+        update_hardware_cursor();
     }
 
     auto prepare_rect = [&](Screen& screen, const Gfx::IntRect& rect) {
@@ -591,8 +604,14 @@ void Compositor::compose()
     }
 
     if (need_to_draw_cursor) {
-        auto& screen_data = cursor_screen.compositor_screen_data();
-        screen_data.draw_cursor(cursor_screen, cursor_rect);
+        if (m_hardware_cursor_enabled) {
+            // The cursor plane composes the cursor on top of the framebuffer,
+            // so there's nothing to paint; just update the position.
+            cursor_screen.move_hardware_cursor(ScreenInput::the().cursor_location());
+        } else {
+            auto& screen_data = cursor_screen.compositor_screen_data();
+            screen_data.draw_cursor(cursor_screen, cursor_rect);
+        }
     }
 
     Screen::for_each([&](auto& screen) {
@@ -759,12 +778,22 @@ void Compositor::invalidate_window()
 
 void Compositor::start_compose_async_timer()
 {
-    // We delay composition by a timer interval, but to not affect latency too
-    // much, if a pending compose is not already scheduled, we also schedule an
-    // immediate compose the next spin of the event loop.
-    if (!m_compose_timer->is_active()) {
-        m_compose_timer->start();
+    if (m_compose_timer->is_active())
+        return;
+    // Pace frames relative to when the previous compose *started* rather than
+    // when it finished, so the time spent composing doesn't get added to the
+    // frame interval; during animations a slow compose would otherwise stretch
+    // every frame and make the cadence drift. If a full refresh interval has
+    // already gone by, also schedule an immediate compose on the next spin of
+    // the event loop, so sporadic updates don't pay a whole interval of
+    // latency.
+    const int refresh_interval_ms = 1000 / 60;
+    int elapsed_ms = m_frame_start_timer.is_valid() ? m_frame_start_timer.elapsed() : refresh_interval_ms;
+    if (elapsed_ms >= refresh_interval_ms) {
+        m_compose_timer->start(refresh_interval_ms);
         m_immediate_compose_timer->start();
+    } else {
+        m_compose_timer->start(refresh_interval_ms - elapsed_ms);
     }
 }
 
@@ -829,6 +858,7 @@ void Compositor::screen_resolution_changed()
 {
     // Screens may be gone now, invalidate any references to them
     m_current_cursor_screen = nullptr;
+    m_hardware_cursor_enabled = false;
 
     init_bitmaps();
     invalidate_occlusions();
@@ -845,6 +875,8 @@ Gfx::IntRect Compositor::current_cursor_rect() const
 
 void Compositor::invalidate_cursor(bool compose_immediately)
 {
+    if (update_hardware_cursor_position())
+        return;
     if (m_invalidated_cursor)
         return;
     m_invalidated_cursor = true;
@@ -877,6 +909,41 @@ void Compositor::change_cursor(const Cursor* cursor)
                 invalidate_cursor(true);
             });
     }
+    update_hardware_cursor();
+}
+
+void Compositor::update_hardware_cursor()
+{
+    bool was_enabled = m_hardware_cursor_enabled;
+    m_hardware_cursor_enabled = false;
+    auto* cursor_screen = m_current_cursor_screen;
+    if (!cursor_screen || !cursor_screen->can_set_hardware_cursor())
+        return;
+    auto& cursor = m_current_cursor ? *m_current_cursor : WindowManager::the().active_cursor();
+    if (cursor_screen->set_hardware_cursor(&cursor)) {
+        m_hardware_cursor_enabled = true;
+        cursor_screen->move_hardware_cursor(ScreenInput::the().cursor_location());
+    } else if (was_enabled) {
+        // E.g. an animated cursor: hide the cursor plane, the software path takes over
+        cursor_screen->set_hardware_cursor(nullptr);
+    }
+}
+
+bool Compositor::update_hardware_cursor_position()
+{
+    if (!m_hardware_cursor_enabled)
+        return false;
+    // A cursor shape change or a move onto a different screen may require
+    // uploading a new cursor image, so those take the full compose path.
+    auto& wm = WindowManager::the();
+    auto& current_cursor = m_current_cursor ? *m_current_cursor : wm.active_cursor();
+    if (&current_cursor != &wm.active_cursor())
+        return false;
+    auto& cursor_screen = ScreenInput::the().cursor_location_screen();
+    if (&cursor_screen != m_current_cursor_screen)
+        return false;
+    cursor_screen.move_hardware_cursor(ScreenInput::the().cursor_location());
+    return true;
 }
 
 void Compositor::render_overlays()
@@ -977,6 +1044,11 @@ void Compositor::update_fonts()
 
 void Compositor::notify_display_links()
 {
+    m_display_link_frame_timer.start();
+    // Re-anchor the standalone timer so it only fires for frames where no
+    // compose pass delivered the notifications already.
+    if (m_display_link_notify_timer->is_active())
+        m_display_link_notify_timer->restart();
     ClientConnection::for_each_client([](auto& client) {
         client.notify_display_link({});
     });
@@ -1236,21 +1308,26 @@ void Compositor::recompute_occlusions()
                 if (opaque_rects.is_empty() && transparent_rects.is_empty())
                     return IterationDecision::Continue;
                 VERIFY(!opaque_rects.intersects(transparent_rects));
-                for (auto& covering : opaque_rects.rects()) {
-                    opaque_covering.add(covering);
+                if (!opaque_rects.is_empty()) {
+                    opaque_covering.add(opaque_rects);
                     if (!visible_window_rects.is_empty())
-                        visible_window_rects = visible_window_rects.shatter(covering);
-                    if (!visible_opaque.is_empty()) {
-                        auto uncovered_opaque = visible_opaque.shatter(covering);
-                        visible_opaque = move(uncovered_opaque);
-                    }
-                    if (!transparency_rects.is_empty()) {
-                        auto uncovered_transparency = transparency_rects.shatter(covering);
-                        transparency_rects = move(uncovered_transparency);
-                    }
-                    if (!transparent_covering.is_empty()) {
-                        auto uncovered_transparency = transparent_covering.shatter(covering);
-                        transparent_covering = move(uncovered_transparency);
+                        visible_window_rects = visible_window_rects.shatter(opaque_rects);
+                    if (!visible_opaque.is_empty())
+                        visible_opaque = visible_opaque.shatter(opaque_rects);
+                    if (!transparency_rects.is_empty())
+                        transparency_rects = transparency_rects.shatter(opaque_rects);
+                    if (!transparent_covering.is_empty())
+                        transparent_covering = transparent_covering.shatter(opaque_rects);
+
+                    // If the opaque windows above completely cover our render rect
+                    // there is nothing left that could possibly become visible, so
+                    // stop looking at the rest of the stack.
+                    if (opaque_covering.contains(render_rect_on_screen)) {
+                        VERIFY(visible_window_rects.is_empty());
+                        VERIFY(visible_opaque.is_empty());
+                        VERIFY(transparency_rects.is_empty());
+                        VERIFY(transparent_covering.is_empty());
+                        return IterationDecision::Break;
                     }
                 }
                 if (!transparent_rects.is_empty())
@@ -8,6 +8,7 @@
 
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/Object.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/DisjointRectSet.h>
@@ -111,7 +112,11 @@ public:
     void invalidate_cursor(bool = false);
     Gfx::IntRect current_cursor_rect() const;
     const Cursor* current_cursor() const { return m_current_cursor; }
-    void current_cursor_was_reloaded(const Cursor* new_cursor) { m_current_cursor = new_cursor; }
+    void current_cursor_was_reloaded(const Cursor* new_cursor)
+    {
+        m_current_cursor = new_cursor;
+        update_hardware_cursor();
+    }
 
     void increment_display_link_count(Badge<ClientConnection>);
     void decrement_display_link_count(Badge<ClientConnection>);
@@ -202,6 +207,8 @@ private:
     void recompute_overlay_rects();
     void recompute_occlusions();
     void change_cursor(const Cursor*);
+    void update_hardware_cursor();
+    bool update_hardware_cursor_position();
     void flush(Screen&);
     Gfx::IntPoint window_transition_offset(Window&);
     void update_animations(Screen&, Gfx::DisjointRectSet& flush_rects);
@@ -213,6 +220,7 @@ private:
 
     RefPtr<Core::Timer> m_compose_timer;
     RefPtr<Core::Timer> m_immediate_compose_timer;
+    Core::ElapsedTimer m_frame_start_timer;
     bool m_flash_flush { false };
     bool m_occlusions_dirty { true };
     bool m_invalidated_any { true };
@@ -233,9 +241,11 @@ private:
     const Cursor* m_current_cursor { nullptr };
     Screen* m_current_cursor_screen { nullptr };
     unsigned m_current_cursor_frame { 0 };
+    bool m_hardware_cursor_enabled { false };
     RefPtr<Core::Timer> m_cursor_timer;
 
     RefPtr<Core::Timer> m_display_link_notify_timer;
+    Core::ElapsedTimer m_display_link_frame_timer;
     size_t m_display_link_count { 0 };
 
     WindowStack* m_current_window_stack { nullptr };
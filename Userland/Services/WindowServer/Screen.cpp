@@ -6,6 +6,7 @@
 
 #include "Screen.h"
 #include "Compositor.h"
+#include "Cursor.h"
 #include "Event.h"
 #include "EventLoop.h"
 #include "WindowManager.h"
@@ -231,6 +232,9 @@ bool Screen::open_device()
     }
 
     m_can_set_buffer = (fb_set_buffer(m_framebuffer_fd, 0) == 0);
+    // Moving the cursor before an image was set is harmless, so it makes
+    // for a good probe of whether the device has a hardware cursor at all.
+    m_can_set_hardware_cursor = (fb_move_cursor(m_framebuffer_fd, 0, 0) == 0);
     m_can_device_flush_buffers = true; // If the device can't do it we revert to false
     set_resolution(true);
     return true;
@@ -384,6 +388,50 @@ void Screen::set_buffer(int index)
     VERIFY(rc == 0);
 }
 
+bool Screen::set_hardware_cursor(Cursor const* cursor)
+{
+    if (!m_can_set_hardware_cursor)
+        return false;
+    if (!cursor) {
+        // An empty image hides the hardware cursor
+        FBCursorImage image {};
+        return fb_set_cursor(m_framebuffer_fd, &image) == 0;
+    }
+    // Animated cursors need a recomposite for every frame anyway,
+    // so they stay on the software path.
+    if (cursor->params().frames() > 1)
+        return false;
+    int width = cursor->rect().width() * scale_factor();
+    int height = cursor->rect().height() * scale_factor();
+    if (width <= 0 || height <= 0 || width > 64 || height > 64)
+        return false;
+    auto& bitmap = cursor->bitmap(scale_factor());
+    if (bitmap.physical_width() < width || bitmap.physical_height() < height)
+        return false;
+    Vector<u32> pixels;
+    pixels.ensure_capacity(width * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++)
+            pixels.unchecked_append(bitmap.get_pixel(x, y).value());
+    }
+    auto hotspot = cursor->params().hotspot() * scale_factor();
+    FBCursorImage image {
+        .width = (unsigned)width,
+        .height = (unsigned)height,
+        .hot_x = (unsigned)hotspot.x(),
+        .hot_y = (unsigned)hotspot.y(),
+        .pixels = pixels.data()
+    };
+    return fb_set_cursor(m_framebuffer_fd, &image) == 0;
+}
+
+void Screen::move_hardware_cursor(Gfx::IntPoint const& cursor_location)
+{
+    VERIFY(m_can_set_hardware_cursor);
+    auto physical_location = cursor_location.translated(-rect().location()) * scale_factor();
+    fb_move_cursor(m_framebuffer_fd, physical_location.x(), physical_location.y());
+}
+
 size_t Screen::buffer_offset(int index) const
 {
     if (index == 0)
@@ -28,6 +28,7 @@ constexpr size_t default_screen_count = 4;
 // We currently only support 2 scale factors: 1x and 2x
 constexpr size_t default_scale_factors_in_use_count = 2;
 
+class Cursor;
 class Screen;
 
 class ScreenInput {
@@ -150,6 +151,10 @@ public:
     void set_buffer(int index);
     size_t buffer_offset(int index) const;
 
+    bool can_set_hardware_cursor() const { return m_can_set_hardware_cursor; }
+    bool set_hardware_cursor(Cursor const*);
+    void move_hardware_cursor(Gfx::IntPoint const& cursor_location);
+
     int physical_width() const { return width() * scale_factor(); }
     int physical_height() const { return height() * scale_factor(); }
     size_t pitch() const { return m_pitch; }
@@ -207,6 +212,7 @@ private:
 
     Gfx::RGBA32* m_framebuffer { nullptr };
     bool m_can_set_buffer { false };
+    bool m_can_set_hardware_cursor { false };
     bool m_can_device_flush_buffers { true }; // If the device can't do it we revert to false
 
     int m_pitch { 0 };
@@ -246,13 +246,39 @@ void Window::set_minimum_size(const Gfx::IntSize& size)
     m_minimum_size = size;
 }
 
+void Window::send_pending_mouse_move_event()
+{
+    if (!m_pending_mouse_move_event)
+        return;
+    auto event = move(m_pending_mouse_move_event);
+    if (m_destroyed)
+        return;
+    m_client->async_mouse_move(m_window_id, event->position(), (u32)event->button(), event->buttons(), event->modifiers(), event->wheel_delta(), event->is_drag(), event->mime_types());
+}
+
 void Window::handle_mouse_event(const MouseEvent& event)
 {
     set_automatic_cursor_tracking_enabled(event.buttons() != 0);
 
+    // Button transitions and wheel events must be delivered in order relative
+    // to any buffered motion, so flush the pending move first.
+    if (event.type() != Event::MouseMove)
+        send_pending_mouse_move_event();
+
     switch (event.type()) {
     case Event::MouseMove:
-        m_client->async_mouse_move(m_window_id, event.position(), (u32)event.button(), event.buttons(), event.modifiers(), event.wheel_delta(), event.is_drag(), event.mime_types());
+        if (m_unbuffered_mouse_events) {
+            m_client->async_mouse_move(m_window_id, event.position(), (u32)event.button(), event.buttons(), event.modifiers(), event.wheel_delta(), event.is_drag(), event.mime_types());
+            break;
+        }
+        // A high-polling-rate mouse can deliver motion packets faster than
+        // clients can hit-test and repaint, so the queues just build up and
+        // dragging starts to lag. Buffer the latest move and deliver it once
+        // the event loop finishes pumping the current batch; every move in
+        // between simply overwrites the previous one.
+        if (!m_pending_mouse_move_event)
+            deferred_invoke([this] { send_pending_mouse_move_event(); });
+        m_pending_mouse_move_event = make<MouseEvent>(event);
         break;
     case Event::MouseDown:
         m_client->async_mouse_down(m_window_id, event.position(), (u32)event.button(), event.buttons(), event.modifiers(), event.wheel_delta());
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "HitTestResult.h"
+#include <AK/OwnPtr.h>
 #include <AK/String.h>
 #include <AK/WeakPtr.h>
 #include <LibCore/Object.h>
@@ -155,6 +156,10 @@ public:
     {
         m_hit_testing_enabled = value;
     }
+    void set_unbuffered_mouse_events(bool value)
+    {
+        m_unbuffered_mouse_events = value;
+    }
     float alpha_hit_threshold() const { return m_alpha_hit_threshold; }
     void set_alpha_hit_threshold(float threshold)
     {
@@ -383,6 +388,7 @@ private:
 
     virtual void event(Core::Event&) override;
     void handle_mouse_event(const MouseEvent&);
+    void send_pending_mouse_move_event();
     void handle_keydown_event(const KeyEvent&);
     void add_child_window(Window&);
     void add_accessory_window(Window&);
@@ -430,6 +436,8 @@ private:
     bool m_invalidated_all { true };
     bool m_invalidated_frame { true };
     bool m_hit_testing_enabled { true };
+    bool m_unbuffered_mouse_events { false };
+    OwnPtr<MouseEvent> m_pending_mouse_move_event;
     bool m_modified { false };
     bool m_pinned { false };
     bool m_moving_to_another_stack { false };
@@ -410,7 +410,7 @@ void WindowFrame::PerScaleRenderedCache::render(WindowFrame& frame, Screen& scre
             if (tmp_it != s_tmp_bitmap_cache.end())
                 tmp_it->value = nullptr;
 
-            auto bitmap = Gfx::Bitmap::try_create(Gfx::BitmapFormat::BGRA8888, frame_rect_including_shadow.size(), scale);
+            auto bitmap = Gfx::Bitmap::try_create_pooled(Gfx::BitmapFormat::BGRA8888, frame_rect_including_shadow.size(), scale);
             if (!bitmap) {
                 s_tmp_bitmap_cache.remove(scale);
                 dbgln("Could not create bitmap of size {}", frame_rect_including_shadow.size());
@@ -725,6 +725,15 @@ RefPtr<Job> Shell::run_command(const AST::Command& command)
     Vector<String> copy_argv = command.argv;
     argv.ensure_capacity(command.argv.size() + 1);
 
+    // Resolve the program through the executable cache up front: exec'ing
+    // a full path spares every spawn the child-side $PATH walk. If the
+    // cache misses (or the entry has gone stale), argv[0] stays untouched
+    // and execvp() falls back to the old search.
+    if (!copy_argv.is_empty() && !copy_argv.first().contains('/')) {
+        if (auto resolved_path = find_in_path(copy_argv.first()); !resolved_path.is_empty())
+            copy_argv.first() = move(resolved_path);
+    }
+
     for (auto& arg : copy_argv)
         argv.append(arg.characters());
 
@@ -1279,21 +1288,41 @@ String Shell::unescape_token(const String& token)
     return builder.build();
 }
 
+const Shell::PathDirectoryCache* Shell::validated_directory_cache(const String& directory)
+{
+    struct stat st;
+    if (stat(directory.characters(), &st) < 0)
+        return nullptr;
+
+    auto it = m_path_directory_cache.find(directory);
+    if (it != m_path_directory_cache.end() && it->value.mtime == st.st_mtime)
+        return &it->value;
+
+    PathDirectoryCache cache;
+    cache.mtime = st.st_mtime;
+    Core::DirIterator programs(directory.characters(), Core::DirIterator::SkipDots);
+    while (programs.has_next()) {
+        auto program = programs.next_path();
+        auto program_path = String::formatted("{}/{}", directory, program);
+        if (access(program_path.characters(), X_OK) == 0)
+            cache.executables.set(move(program));
+    }
+
+    m_path_directory_cache.set(directory, move(cache));
+    return &m_path_directory_cache.find(directory)->value;
+}
+
 String Shell::find_in_path(const StringView& program_name)
 {
     String path = getenv("PATH");
     if (!path.is_empty()) {
         auto directories = path.split(':');
         for (const auto& directory : directories) {
-            Core::DirIterator programs(directory.characters(), Core::DirIterator::SkipDots);
-            while (programs.has_next()) {
-                auto program = programs.next_path();
-                auto program_path = String::formatted("{}/{}", directory, program);
-                if (access(program_path.characters(), X_OK) != 0)
-                    continue;
-                if (program == program_name)
-                    return program_path;
-            }
+            auto* cache = validated_directory_cache(directory);
+            if (!cache)
+                continue;
+            if (cache->executables.contains(program_name))
+                return String::formatted("{}/{}", directory, program_name);
         }
     }
 
@@ -1332,15 +1361,14 @@ void Shell::cache_path()
     if (!path.is_empty()) {
         auto directories = path.split(':');
         for (const auto& directory : directories) {
-            Core::DirIterator programs(directory.characters(), Core::DirIterator::SkipDots);
-            while (programs.has_next()) {
-                auto program = programs.next_path();
-                auto program_path = String::formatted("{}/{}", directory, program);
+            auto* cache = validated_directory_cache(directory);
+            if (!cache)
+                continue;
+            for (auto& program : cache->executables) {
                 auto escaped_name = escape_token(program);
                 if (cached_path.contains_slow(escaped_name))
                     continue;
-                if (access(program_path.characters(), X_OK) == 0)
-                    cached_path.append(escaped_name);
+                cached_path.append(escaped_name);
             }
         }
     }
@@ -10,6 +10,7 @@
 #include "Parser.h"
 #include <AK/CircularQueue.h>
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/NonnullOwnPtrVector.h>
 #include <AK/String.h>
 #include <AK/StringBuilder.h>
@@ -105,7 +106,7 @@ public:
     String resolve_path(String) const;
     String resolve_alias(const String&) const;
 
-    static String find_in_path(const StringView& program_name);
+    String find_in_path(const StringView& program_name);
 
     static bool has_history_event(StringView);
 
@@ -287,6 +288,16 @@ private:
     void bring_cursor_to_beginning_of_a_line() const;
 
     Optional<int> resolve_job_spec(const String&);
+
+    // Cached contents of a $PATH directory, revalidated against its mtime
+    // so a lookup usually costs one stat() instead of a full rescan.
+    struct PathDirectoryCache {
+        time_t mtime { 0 };
+        HashTable<String> executables;
+    };
+    const PathDirectoryCache* validated_directory_cache(const String& directory);
+    HashMap<String, PathDirectoryCache> m_path_directory_cache;
+
     void cache_path();
     void add_entry_to_cache(const String&);
     void remove_entry_from_cache(const String&);
@@ -6,6 +6,7 @@
 
 #include <LibAudio/ClientConnection.h>
 #include <LibAudio/Loader.h>
+#include <LibAudio/Resampler.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/EventLoop.h>
 #include <stdio.h>
@@ -36,7 +37,7 @@ int main(int argc, char** argv)
         loader->num_channels() == 1 ? "Mono" : "Stereo");
     out("\033[34;1mProgress\033[0m: \033[s");
 
-    auto resampler = Audio::ResampleHelper<double>(loader->sample_rate(), audio_client->get_sample_rate());
+    auto resampler = Audio::PolyphaseResampler(loader->sample_rate(), audio_client->get_sample_rate());
 
     for (;;) {
         auto samples = loader->get_more_samples();
@@ -44,7 +45,6 @@ int main(int argc, char** argv)
             out("\033[u");
             out("{}/{}", loader->loaded_samples(), loader->total_samples());
             fflush(stdout);
-            resampler.reset();
             samples = Audio::resample_buffer(resampler, *samples);
             audio_client->enqueue(*samples);
         } else if (loader->has_error()) {
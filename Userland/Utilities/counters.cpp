@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MappedFile.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/PerformanceCounters.h>
+#include <stdio.h>
+#include <unistd.h>
+
+int main(int argc, char** argv)
+{
+    if (pledge("stdio rpath", nullptr) < 0) {
+        perror("pledge");
+        return 1;
+    }
+
+    pid_t pid = 0;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Show the performance counters published by a running process.");
+    args_parser.add_positional_argument(pid, "Process ID", "pid");
+    args_parser.parse(argc, argv);
+
+    auto path = Core::PerformanceCounters::path_for_pid(pid);
+    auto file_or_error = MappedFile::map(path);
+    if (file_or_error.is_error()) {
+        warnln("Failed to open {}: {}", path, file_or_error.error().string());
+        warnln("(The process either doesn't exist or doesn't publish performance counters.)");
+        return 1;
+    }
+    auto mapped_file = file_or_error.release_value();
+
+    if (mapped_file->size() < sizeof(Core::PerformanceCounters::SharedData)) {
+        warnln("{} is too small to hold a counter page", path);
+        return 1;
+    }
+    auto& data = *(Core::PerformanceCounters::SharedData*)mapped_file->data();
+    if (data.magic != Core::PerformanceCounters::shared_data_magic || data.version != Core::PerformanceCounters::shared_data_version) {
+        warnln("{} does not contain a recognized counter page", path);
+        return 1;
+    }
+
+    u32 counter_count = min((u32)Core::PerformanceCounters::max_counters, data.counter_count.load());
+    if (counter_count > 0) {
+        outln("Counters:");
+        for (u32 i = 0; i < counter_count; ++i) {
+            auto const& slot = data.counters[i];
+            outln("  {:40} {}", (char const*)slot.name, slot.value.load());
+        }
+    }
+
+    u32 histogram_count = min((u32)Core::PerformanceCounters::max_histograms, data.histogram_count.load());
+    if (histogram_count > 0) {
+        outln("Histograms:");
+        for (u32 i = 0; i < histogram_count; ++i) {
+            auto const& slot = data.histograms[i];
+            u64 count = slot.count.load();
+            u64 total_us = slot.total_us.load();
+            outln("  {:40} count={} total={}us avg={}us", (char const*)slot.name, count, total_us, count ? total_us / count : 0);
+            for (size_t bucket = 0; bucket < Core::DurationHistogram::bucket_count; ++bucket) {
+                u64 bucket_value = slot.buckets[bucket].load();
+                if (bucket_value == 0)
+                    continue;
+                outln("    [{}us..{}us) {}", bucket == 0 ? 0 : (1ull << bucket), 1ull << (bucket + 1), bucket_value);
+            }
+        }
+    }
+
+    if (counter_count == 0 && histogram_count == 0)
+        outln("No counters registered.");
+
+    return 0;
+}
@@ -9,7 +9,10 @@
 #include <AK/LexicalPath.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/OwnPtr.h>
+#include <AK/RefPtr.h>
+#include <AK/String.h>
 #include <AK/Vector.h>
+#include <LibThreading/WorkerPool.h>
 #include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -500,37 +503,48 @@ static const char* parse_options(int argc, char* argv[])
     }
 }
 
-static void walk_tree(FileData& root_data, Command& command)
+// We should try to read directory entries if either:
+// * This is a directory.
+// * This is a symlink (that could point to a directory),
+//   and we're following symlinks.
+// * The type is unknown, so it could be a directory.
+static bool could_be_directory(unsigned char d_type)
 {
-    command.evaluate(root_data);
-
-    // We should try to read directory entries if either:
-    // * This is a directory.
-    // * This is a symlink (that could point to a directory),
-    //   and we're following symlinks.
-    // * The type is unknown, so it could be a directory.
-    switch (root_data.d_type) {
+    switch (d_type) {
     case DT_DIR:
     case DT_UNKNOWN:
-        break;
+        return true;
     case DT_LNK:
-        if (g_follow_symlinks)
-            break;
-        return;
+        return g_follow_symlinks;
     default:
-        return;
+        return false;
     }
+}
+
+struct DirectoryEntry {
+    String name;
+    unsigned char d_type { DT_UNKNOWN };
+};
+
+// Everything one readdir() pass produced. The listing itself happens on the
+// worker pool, so the directory I/O for several subtrees can overlap; the
+// commands are still evaluated on the main thread, in the same depth-first
+// order as before.
+struct DirectoryListing {
+    int dirfd { -1 };
+    int open_error { 0 };
+    int readdir_error { 0 };
+    Vector<DirectoryEntry> entries;
+};
 
-    int dirfd = openat(root_data.dirfd, root_data.basename, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+static DirectoryListing list_directory(int parent_dirfd, String const& basename)
+{
+    DirectoryListing listing;
+
+    int dirfd = openat(parent_dirfd, basename.characters(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
     if (dirfd < 0) {
-        if (errno == ENOTDIR) {
-            // Above we decided to try to open this file because it could
-            // be a directory, but turns out it's not. This is fine though.
-            return;
-        }
-        perror(root_data.full_path.string().characters());
-        g_there_was_an_error = true;
-        return;
+        listing.open_error = errno;
+        return listing;
     }
 
     DIR* dir = fdopendir(dirfd);
@@ -544,23 +558,100 @@ static void walk_tree(FileData& root_data, Command& command)
         if (strcmp(dirent->d_name, ".") == 0 || strcmp(dirent->d_name, "..") == 0)
             continue;
 
+        listing.entries.append({ dirent->d_name, dirent->d_type });
+    }
+    listing.readdir_error = errno;
+
+    // Hand the fd itself back to the caller; it stays valid after closedir()
+    // would have invalidated it, so steal it out of the DIR first.
+    listing.dirfd = dup(dirfd);
+    closedir(dir);
+    return listing;
+}
+
+// Each pending listing holds an open fd for its directory, so cap how many we
+// read ahead; anything beyond the cap is simply listed on demand instead.
+// Only touched on the main thread.
+static constexpr size_t c_max_prefetched_listings = 64;
+static size_t g_outstanding_listings = 0;
+
+static NonnullRefPtr<Threading::Future<DirectoryListing>> submit_directory_listing(int parent_dirfd, const char* basename)
+{
+    // Deep-copy the name for the worker; the dirent it points into won't
+    // outlive this call, and String's reference count isn't atomic anyway.
+    String name_for_worker { basename };
+    return Threading::WorkerPool::the().submit<DirectoryListing>([parent_dirfd, name_for_worker = move(name_for_worker)] {
+        return list_directory(parent_dirfd, name_for_worker);
+    });
+}
+
+static void process_directory(FileData& dir_data, Threading::Future<DirectoryListing>& listing_future, Command& command)
+{
+    auto listing = listing_future.wait();
+
+    if (listing.open_error != 0) {
+        if (listing.open_error == ENOTDIR) {
+            // We decided to try to open this file because it could be a
+            // directory, but turns out it's not. This is fine though.
+            return;
+        }
+        warnln("{}: {}", dir_data.full_path, strerror(listing.open_error));
+        g_there_was_an_error = true;
+        return;
+    }
+
+    if (listing.readdir_error != 0) {
+        warnln("{}: {}", dir_data.full_path, strerror(listing.readdir_error));
+        g_there_was_an_error = true;
+    }
+
+    // Kick off the listings for everything that could itself be a directory
+    // before evaluating any commands, so the workers read ahead while the
+    // main thread works through the entries in order.
+    Vector<RefPtr<Threading::Future<DirectoryListing>>> child_listings;
+    child_listings.ensure_capacity(listing.entries.size());
+    for (auto& entry : listing.entries) {
+        if (could_be_directory(entry.d_type) && g_outstanding_listings < c_max_prefetched_listings) {
+            child_listings.append(submit_directory_listing(listing.dirfd, entry.name.characters()));
+            ++g_outstanding_listings;
+        } else {
+            child_listings.append(nullptr);
+        }
+    }
+
+    for (size_t i = 0; i < listing.entries.size(); ++i) {
+        auto& entry = listing.entries[i];
         FileData file_data {
-            root_data.full_path.append(dirent->d_name),
-            dirfd,
-            dirent->d_name,
+            dir_data.full_path.append(entry.name),
+            listing.dirfd,
+            entry.name.characters(),
             (struct stat) {},
             false,
-            dirent->d_type,
+            entry.d_type,
         };
-        walk_tree(file_data, command);
+        command.evaluate(file_data);
+        if (child_listings[i]) {
+            --g_outstanding_listings;
+            process_directory(file_data, *child_listings[i], command);
+        } else if (could_be_directory(entry.d_type)) {
+            // This one didn't make it under the prefetch cap; list it now.
+            auto listing_future = submit_directory_listing(listing.dirfd, entry.name.characters());
+            process_directory(file_data, *listing_future, command);
+        }
     }
 
-    if (errno != 0) {
-        perror(root_data.full_path.string().characters());
-        g_there_was_an_error = true;
-    }
+    close(listing.dirfd);
+}
 
-    closedir(dir);
+static void walk_tree(FileData& root_data, Command& command)
+{
+    command.evaluate(root_data);
+
+    if (!could_be_directory(root_data.d_type))
+        return;
+
+    auto listing_future = submit_directory_listing(root_data.dirfd, root_data.basename);
+    process_directory(root_data, *listing_future, command);
 }
 
 int main(int argc, char* argv[])
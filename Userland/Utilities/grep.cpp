@@ -1,20 +1,26 @@
 /*
  * Copyright (c) 2020, Emanuel Sprung <emanuel.sprung@gmail.com>
+ * Copyright (c) 2021, the SerenityOS developers.
  *
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
 #include <AK/Assertions.h>
-#include <AK/ByteBuffer.h>
+#include <AK/NonnullRefPtrVector.h>
 #include <AK/ScopeGuard.h>
 #include <AK/String.h>
-#include <AK/Utf8View.h>
+#include <AK/StringBuilder.h>
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/File.h>
 #include <LibRegex/Regex.h>
+#include <LibThreading/WorkerPool.h>
+#include <fcntl.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 enum class BinaryFileMode {
@@ -23,18 +29,18 @@ enum class BinaryFileMode {
     Skip,
 };
 
-template<typename... Ts>
-void fail(StringView format, Ts... args)
-{
-    warn("\x1b[31m");
-    warnln(format, forward<Ts>(args)...);
-    warn("\x1b[0m");
-    abort();
-}
+// Everything one file's search produced, so searches can run on the worker
+// pool and still print their results in input order afterwards.
+struct SearchOutcome {
+    bool matched { false };
+    bool failed { false };
+    String output;
+    String error;
+};
 
 int main(int argc, char** argv)
 {
-    if (pledge("stdio rpath", nullptr) < 0) {
+    if (pledge("stdio rpath thread", nullptr) < 0) {
         perror("pledge");
         return 1;
     }
@@ -120,70 +126,152 @@ int main(int argc, char** argv)
     if (case_insensitive)
         options |= PosixFlags::Insensitive;
 
-    auto grep_logic = [&](auto&& re) {
-        if (re.parser_result.error != Error::NoError) {
+    auto grep_logic = [&](auto regex_factory) {
+        if (regex_factory().parser_result.error != Error::NoError) {
             return 1;
         }
 
-        auto matches = [&](StringView str, StringView filename = "", bool print_filename = false, bool is_binary = false) {
-            size_t last_printed_char_pos { 0 };
+        // Searches a whole buffer at once: the lines are only split up as
+        // views, and the regex engine runs over all of them in a single call,
+        // so its prefilter can skip the uninteresting parts of the buffer.
+        // Constructs its own regex so it can run on any thread (compiled
+        // patterns are shared through the LibRegex pattern cache).
+        auto search_buffer = [&, regex_factory](StringView buffer, StringView filename, bool print_filename) -> SearchOutcome {
+            SearchOutcome outcome;
+            bool is_binary = memchr(buffer.characters_without_null_termination(), 0, buffer.length()) != nullptr;
             if (is_binary && binary_mode == BinaryFileMode::Skip)
-                return false;
+                return outcome;
+
+            Vector<RegexStringView> lines;
+            Vector<size_t> line_offsets;
+            size_t offset = 0;
+            while (offset < buffer.length()) {
+                auto const* start = buffer.characters_without_null_termination() + offset;
+                auto const* newline = (char const*)memchr(start, '\n', buffer.length() - offset);
+                size_t length = newline ? (size_t)(newline - start) : buffer.length() - offset;
+                lines.empend(StringView { start, length });
+                line_offsets.append(offset);
+                offset += length + 1;
+            }
+
+            auto re = regex_factory();
+            auto result = re.match(lines, PosixFlags::Global);
+
+            Vector<bool> line_has_match;
+            line_has_match.resize(lines.size());
+            for (auto& match : result.matches)
+                line_has_match[match.line] = true;
+
+            StringBuilder builder;
+            size_t next_match = 0;
+            for (size_t i = 0; i < lines.size(); ++i) {
+                if (!(line_has_match[i] ^ invert_match)) {
+                    while (next_match < result.matches.size() && result.matches[next_match].line == i)
+                        ++next_match;
+                    continue;
+                }
+                outcome.matched = true;
 
-            auto result = re.match(str, PosixFlags::Global);
-            if (result.success ^ invert_match) {
                 if (is_binary && binary_mode == BinaryFileMode::Binary) {
-                    outln(colored_output ? "binary file \x1B[34m{}\x1B[0m matches" : "binary file {} matches", filename);
-                } else {
-                    if ((result.matches.size() || invert_match) && print_filename)
-                        out(colored_output ? "\x1B[34m{}:\x1B[0m" : "{}:", filename);
-
-                    for (auto& match : result.matches) {
-                        out(colored_output ? "{}\x1B[32m{}\x1B[0m" : "{}{}",
-                            StringView(&str[last_printed_char_pos], match.global_offset - last_printed_char_pos),
-                            match.view.to_string());
-                        last_printed_char_pos = match.global_offset + match.view.length();
-                    }
-                    outln("{}", StringView(&str[last_printed_char_pos], str.length() - last_printed_char_pos));
+                    builder.appendff(colored_output ? "binary file \x1B[34m{}\x1B[0m matches\n" : "binary file {} matches\n", filename);
+                    break;
                 }
 
-                return true;
+                if (print_filename)
+                    builder.appendff(colored_output ? "\x1B[34m{}:\x1B[0m" : "{}:", filename);
+
+                auto line = lines[i].string_view();
+                size_t last_printed_char_pos = 0;
+                while (next_match < result.matches.size() && result.matches[next_match].line == i) {
+                    auto& match = result.matches[next_match];
+                    auto column = match.global_offset - line_offsets[i];
+                    builder.appendff(colored_output ? "{}\x1B[32m{}\x1B[0m" : "{}{}",
+                        line.substring_view(last_printed_char_pos, column - last_printed_char_pos),
+                        match.view.to_string());
+                    last_printed_char_pos = column + match.view.length();
+                    ++next_match;
+                }
+                builder.appendff("{}\n", line.substring_view(last_printed_char_pos, line.length() - last_printed_char_pos));
             }
 
-            return false;
+            outcome.output = builder.build();
+            return outcome;
         };
 
-        auto handle_file = [&matches, binary_mode](StringView filename, bool print_filename) -> bool {
-            auto file = Core::File::construct(filename);
-            if (!file->open(Core::OpenMode::ReadOnly)) {
-                warnln("Failed to open {}: {}", filename, file->error_string());
-                return false;
+        auto load_and_search = [&, search_buffer](StringView filename, bool print_filename) -> SearchOutcome {
+            int fd = open(String(filename).characters(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+                return { false, true, {}, String::formatted("Failed to open {}: {}", filename, strerror(errno)) };
+            ScopeGuard close_fd = [fd] { close(fd); };
+
+            struct stat st;
+            if (fstat(fd, &st) < 0)
+                return { false, true, {}, String::formatted("Failed to stat {}: {}", filename, strerror(errno)) };
+
+            if (S_ISREG(st.st_mode) && st.st_size > 0) {
+                // Map regular files instead of streaming them through stdio.
+                auto* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapped != MAP_FAILED) {
+                    ScopeGuard unmap = [=] { munmap(mapped, st.st_size); };
+                    return search_buffer(StringView { (char const*)mapped, (size_t)st.st_size }, filename, print_filename);
+                }
             }
 
-            while (file->can_read_line()) {
-                auto line = file->read_line();
-                auto is_binary = memchr(line.characters(), 0, line.length()) != nullptr;
+            // Not a regular file (or it refused to map); read it in full.
+            StringBuilder content;
+            char chunk[64 * KiB];
+            ssize_t nread;
+            while ((nread = read(fd, chunk, sizeof(chunk))) > 0)
+                content.append(StringView { chunk, (size_t)nread });
+            if (nread < 0)
+                return { false, true, {}, String::formatted("Failed to read {}: {}", filename, strerror(errno)) };
+            auto content_string = content.build();
+            return search_buffer(content_string.view(), filename, print_filename);
+        };
+
+        bool did_match_something = false;
 
-                if (matches(line, filename, print_filename, is_binary) && is_binary && binary_mode == BinaryFileMode::Binary)
-                    return true;
+        // Searches the files on the worker pool; the outcomes are printed in
+        // input order as they become ready.
+        auto search_files_in_parallel = [&](Vector<String> const& paths, bool print_filename) -> bool {
+            NonnullRefPtrVector<Threading::Future<SearchOutcome>> futures;
+            for (auto& path : paths) {
+                // Deep-copy the path for the worker; String's reference count
+                // isn't atomic, so the two threads must not share an impl.
+                String path_for_worker { path.characters() };
+                futures.append(Threading::WorkerPool::the().submit<SearchOutcome>([load_and_search, path_for_worker = move(path_for_worker), print_filename]() {
+                    return load_and_search(path_for_worker, print_filename);
+                }));
             }
-            return true;
+            bool all_ok = true;
+            for (auto& future : futures) {
+                auto outcome = future.wait();
+                if (outcome.failed) {
+                    warnln("{}", outcome.error);
+                    all_ok = false;
+                    continue;
+                }
+                out("{}", outcome.output);
+                did_match_something = did_match_something || outcome.matched;
+            }
+            return all_ok;
         };
 
-        auto add_directory = [&handle_file, user_has_specified_files](String base, Optional<String> recursive, auto handle_directory) -> void {
-            Core::DirIterator it(recursive.value_or(base), Core::DirIterator::Flags::SkipDots);
+        auto add_directory = [&](String base, Optional<String> recursive_path, auto handle_directory, Vector<String>& out_paths) -> void {
+            Core::DirIterator it(recursive_path.value_or(base), Core::DirIterator::Flags::SkipDots);
             while (it.has_next()) {
                 auto path = it.next_full_path();
                 if (!Core::File::is_directory(path)) {
-                    auto key = user_has_specified_files ? path.view() : path.substring_view(base.length() + 1, path.length() - base.length() - 1);
-                    handle_file(key, true);
+                    if (user_has_specified_files)
+                        out_paths.append(path);
+                    else
+                        out_paths.append(path.substring(base.length() + 1, path.length() - base.length() - 1));
                 } else {
-                    handle_directory(base, path, handle_directory);
+                    handle_directory(base, path, handle_directory, out_paths);
                 }
             }
         };
 
-        bool did_match_something = false;
         if (!files.size() && !recursive) {
             char* line = nullptr;
             size_t line_len = 0;
@@ -199,27 +287,31 @@ int main(int argc, char** argv)
                 if (is_binary && binary_mode == BinaryFileMode::Skip)
                     return 1;
 
-                auto matched = matches(line_view, "stdin", false, is_binary);
-                did_match_something = did_match_something || matched;
-                if (matched && is_binary && binary_mode == BinaryFileMode::Binary)
+                auto outcome = search_buffer(line_view, "stdin", false);
+                out("{}", outcome.output);
+                did_match_something = did_match_something || outcome.matched;
+                if (outcome.matched && is_binary && binary_mode == BinaryFileMode::Binary)
                     return 0;
             }
         } else {
             if (recursive) {
+                Vector<String> paths;
                 if (user_has_specified_files) {
                     for (auto& filename : files) {
-                        add_directory(filename, {}, add_directory);
+                        add_directory(filename, {}, add_directory, paths);
                     }
                 } else {
-                    add_directory(".", {}, add_directory);
+                    add_directory(".", {}, add_directory, paths);
                 }
+                search_files_in_parallel(paths, true);
 
             } else {
                 bool print_filename { files.size() > 1 };
-                for (auto& filename : files) {
-                    if (!handle_file(filename, print_filename))
-                        return 1;
-                }
+                Vector<String> paths;
+                for (auto& filename : files)
+                    paths.append(filename);
+                if (!search_files_in_parallel(paths, print_filename))
+                    return 1;
             }
         }
 
@@ -227,7 +319,7 @@ int main(int argc, char** argv)
     };
 
     if (use_ere)
-        return grep_logic(Regex<PosixExtended>(pattern, options));
+        return grep_logic([&] { return Regex<PosixExtended>(pattern, options); });
 
-    return grep_logic(Regex<PosixBasic>(pattern, options));
+    return grep_logic([&] { return Regex<PosixBasic>(pattern, options); });
 }
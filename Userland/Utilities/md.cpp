@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/MappedFile.h>
 #include <AK/String.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/File.h>
@@ -42,17 +43,26 @@ int main(int argc, char* argv[])
             view_width = 80;
         }
     }
-    auto file = Core::File::construct();
-    bool success;
+    RefPtr<MappedFile> mapped_file;
+    String stdin_input;
+    StringView input;
     if (filename == nullptr) {
-        success = file->open(STDIN_FILENO, Core::OpenMode::ReadOnly, Core::File::ShouldCloseFileDescriptor::No);
+        auto file = Core::File::construct();
+        if (!file->open(STDIN_FILENO, Core::OpenMode::ReadOnly, Core::File::ShouldCloseFileDescriptor::No)) {
+            warnln("Error: {}", file->error_string());
+            return 1;
+        }
+        stdin_input = String::copy(file->read_all());
+        input = stdin_input;
     } else {
-        file->set_filename(filename);
-        success = file->open(Core::OpenMode::ReadOnly);
-    }
-    if (!success) {
-        warnln("Error: {}", file->error_string());
-        return 1;
+        // Map the file instead of buffering it through read().
+        auto file_or_error = MappedFile::map(filename);
+        if (file_or_error.is_error()) {
+            warnln("Error: {}", file_or_error.error().string());
+            return 1;
+        }
+        mapped_file = file_or_error.release_value();
+        input = StringView { mapped_file->bytes() };
     }
 
     if (pledge("stdio", nullptr) < 0) {
@@ -60,10 +70,6 @@ int main(int argc, char* argv[])
         return 1;
     }
 
-    auto buffer = file->read_all();
-    dbgln("Read size {}", buffer.size());
-
-    auto input = String::copy(buffer);
     auto document = Markdown::Document::parse(input);
 
     if (!document) {
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2021, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
+#include <stdlib.h>
+
+struct PhaseMarker {
+    u64 timestamp { 0 };
+    String name;
+};
+
+struct ProcessStartup {
+    String executable;
+    Optional<u64> exec_timestamp;
+    Vector<PhaseMarker> markers;
+};
+
+int main(int argc, char** argv)
+{
+    const char* perfcore_file_path = nullptr;
+    const char* pid_argument = nullptr;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help(
+        "Print a per-phase breakdown of process startup from a perfcore file.\n"
+        "The phases come from signpost events emitted by the dynamic loader,\n"
+        "LibC and LibGUI while the process is being profiled (see profile(1)).");
+    args_parser.add_option(pid_argument, "Only show the process with this PID", "pid", 'p', "PID");
+    args_parser.add_positional_argument(perfcore_file_path, "Path of perfcore file", "perfcore-file");
+    args_parser.parse(argc, argv);
+
+    pid_t pid_filter = -1;
+    if (pid_argument)
+        pid_filter = atoi(pid_argument);
+
+    auto file = Core::File::construct(perfcore_file_path);
+    if (!file->open(Core::OpenMode::ReadOnly)) {
+        warnln("Unable to open {}: {}", perfcore_file_path, file->error_string());
+        return 1;
+    }
+
+    auto json = JsonValue::from_string(file->read_all());
+    if (!json.has_value() || !json.value().is_object()) {
+        warnln("Invalid perfcore format (not a JSON object)");
+        return 1;
+    }
+    auto& object = json.value().as_object();
+
+    auto strings_value = object.get_ptr("strings"sv);
+    if (!strings_value || !strings_value->is_array()) {
+        warnln("Malformed perfcore file (strings is not an array)");
+        return 1;
+    }
+    Vector<String> profile_strings;
+    for (auto& value : strings_value->as_array().values())
+        profile_strings.append(value.to_string());
+
+    auto events_value = object.get_ptr("events"sv);
+    if (!events_value || !events_value->is_array()) {
+        warnln("Malformed perfcore file (events is not an array)");
+        return 1;
+    }
+
+    OrderedHashMap<pid_t, ProcessStartup> startups;
+
+    for (auto& event_value : events_value->as_array().values()) {
+        auto& event = event_value.as_object();
+        auto pid = event.get("pid"sv).to_i32();
+        if (pid_filter != -1 && pid != pid_filter)
+            continue;
+        auto type = event.get("type"sv).to_string();
+        if (type == "process_exec"sv || type == "process_create"sv) {
+            // A fresh exec starts a fresh timeline for this PID.
+            ProcessStartup startup;
+            startup.executable = event.get("executable"sv).to_string();
+            startup.exec_timestamp = event.get("timestamp"sv).to_number<u64>();
+            startups.set(pid, move(startup));
+        } else if (type == "signpost"sv) {
+            auto string_id = event.get("arg1"sv).to_number<size_t>();
+            String name;
+            if (string_id < profile_strings.size())
+                name = profile_strings[string_id];
+            else
+                name = String::formatted("Signpost #{}", string_id);
+            auto& startup = startups.ensure(pid);
+            startup.markers.append({ event.get("timestamp"sv).to_number<u64>(), move(name) });
+        }
+    }
+
+    bool printed_anything = false;
+    for (auto& it : startups) {
+        auto& startup = it.value;
+        if (startup.markers.is_empty())
+            continue;
+        if (printed_anything)
+            outln();
+        printed_anything = true;
+
+        // If we never saw the exec event (e.g. profiling was started after
+        // the process), fall back to the first marker as the baseline.
+        u64 baseline = startup.exec_timestamp.value_or(startup.markers.first().timestamp);
+
+        outln("{} (pid {}):", startup.executable.is_empty() ? "<unknown>" : startup.executable, it.key);
+        outln("{:>9} {:>9}  {}", "total", "delta", "phase");
+        u64 previous = baseline;
+        if (startup.exec_timestamp.has_value())
+            outln("{:>7}ms {:>7}ms  {}", 0, 0, "exec");
+        for (auto& marker : startup.markers) {
+            outln("{:>7}ms {:>7}ms  {}", marker.timestamp - baseline, marker.timestamp - previous, marker.name);
+            previous = marker.timestamp;
+        }
+    }
+
+    if (!printed_anything) {
+        warnln("No signpost events found. Profile with signposts enabled, e.g.: profile -c <command>");
+        return 1;
+    }
+    return 0;
+}
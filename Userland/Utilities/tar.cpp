@@ -8,18 +8,16 @@
 #include <AK/LexicalPath.h>
 #include <AK/Span.h>
 #include <AK/Vector.h>
+#include <LibArchive/Extract.h>
 #include <LibArchive/TarStream.h>
 #include <LibCompress/Gzip.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/FileStream.h>
-#include <fcntl.h>
 #include <stdio.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
-constexpr size_t buffer_size = 4096;
-
 int main(int argc, char** argv)
 {
     bool create = false;
@@ -67,56 +65,25 @@ int main(int argc, char** argv)
             warnln("the provided file is not a well-formatted ustar file");
             return 1;
         }
-        for (; !tar_stream.finished(); tar_stream.advance()) {
-            if (list || verbose)
-                outln("{}", tar_stream.header().filename());
-
-            if (extract) {
-                Archive::TarFileStream file_stream = tar_stream.file_contents();
-
-                const Archive::TarFileHeader& header = tar_stream.header();
-                switch (header.type_flag()) {
-                case Archive::TarFileType::NormalFile:
-                case Archive::TarFileType::AlternateNormalFile: {
-                    int fd = open(String(header.filename()).characters(), O_CREAT | O_WRONLY, header.mode());
-                    if (fd < 0) {
-                        perror("open");
-                        return 1;
-                    }
-
-                    Array<u8, buffer_size> buffer;
-                    size_t nread;
-                    while ((nread = file_stream.read(buffer)) > 0) {
-                        if (write(fd, buffer.data(), nread) < 0) {
-                            perror("write");
-                            return 1;
-                        }
-                    }
-                    close(fd);
-                    break;
-                }
-                case Archive::TarFileType::Directory: {
-                    if (mkdir(String(header.filename()).characters(), header.mode())) {
-                        perror("mkdir");
-                        return 1;
-                    }
-                    break;
-                }
-                case Archive::TarFileType::GlobalExtendedHeader: {
-                    dbgln("ignoring global extended header: {}", header.filename());
-                    break;
-                }
-                case Archive::TarFileType::ExtendedHeader: {
-                    dbgln("ignoring extended header: {}", header.filename());
-                    break;
-                }
-                default:
-                    // FIXME: Implement other file types
-                    warnln("file type '{}' of {} is not yet supported", (char)header.type_flag(), header.filename());
-                    VERIFY_NOT_REACHED();
-                }
+        if (extract) {
+            Archive::ExtractionOptions options;
+            if (verbose) {
+                options.on_entry = [](const String& path) {
+                    outln("{}", path);
+                };
             }
+            options.on_error = [](const String& path, const String& message) {
+                warnln("Failed to extract {}: {}", path, message);
+            };
+
+            bool ok = Archive::extract_tar_archive(tar_stream, options);
+            file_stream.close();
+            return ok ? 0 : 1;
         }
+
+        for (; !tar_stream.finished(); tar_stream.advance())
+            outln("{}", tar_stream.header().filename());
+
         file_stream.close();
         return 0;
     }
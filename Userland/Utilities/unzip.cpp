@@ -7,70 +7,12 @@
 #include <AK/Assertions.h>
 #include <AK/MappedFile.h>
 #include <AK/NumberFormat.h>
+#include <LibArchive/Extract.h>
 #include <LibArchive/Zip.h>
-#include <LibCompress/Deflate.h>
 #include <LibCore/ArgsParser.h>
-#include <LibCore/File.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
-static bool unpack_zip_member(Archive::ZipMember zip_member, bool quiet)
-{
-    if (zip_member.is_directory) {
-        if (mkdir(zip_member.name.characters(), 0755) < 0) {
-            perror("mkdir");
-            return false;
-        }
-        if (!quiet)
-            outln(" extracting: {}", zip_member.name);
-        return true;
-    }
-    auto new_file = Core::File::construct(zip_member.name);
-    if (!new_file->open(Core::OpenMode::WriteOnly)) {
-        warnln("Can't write file {}: {}", zip_member.name, new_file->error_string());
-        return false;
-    }
-
-    if (!quiet)
-        outln(" extracting: {}", zip_member.name);
-
-    // TODO: verify CRC32s match!
-    switch (zip_member.compression_method) {
-    case Archive::ZipCompressionMethod::Store: {
-        if (!new_file->write(zip_member.compressed_data.data(), zip_member.compressed_data.size())) {
-            warnln("Can't write file contents in {}: {}", zip_member.name, new_file->error_string());
-            return false;
-        }
-        break;
-    }
-    case Archive::ZipCompressionMethod::Deflate: {
-        auto decompressed_data = Compress::DeflateDecompressor::decompress_all(zip_member.compressed_data);
-        if (!decompressed_data.has_value()) {
-            warnln("Failed decompressing file {}", zip_member.name);
-            return false;
-        }
-        if (decompressed_data.value().size() != zip_member.uncompressed_size) {
-            warnln("Failed decompressing file {}", zip_member.name);
-            return false;
-        }
-        if (!new_file->write(decompressed_data.value().data(), decompressed_data.value().size())) {
-            warnln("Can't write file contents in {}: {}", zip_member.name, new_file->error_string());
-            return false;
-        }
-        break;
-    }
-    default:
-        VERIFY_NOT_REACHED();
-    }
-
-    if (!new_file->close()) {
-        warnln("Can't close file {}: {}", zip_member.name, new_file->error_string());
-        return false;
-    }
-
-    return true;
-}
-
 int main(int argc, char** argv)
 {
     const char* path;
@@ -134,9 +76,15 @@ int main(int argc, char** argv)
         }
     }
 
-    auto success = zip_file->for_each_member([&](auto zip_member) {
-        return unpack_zip_member(zip_member, quiet) ? IterationDecision::Continue : IterationDecision::Break;
-    });
+    Archive::ExtractionOptions options;
+    if (!quiet) {
+        options.on_entry = [](const String& name) {
+            outln(" extracting: {}", name);
+        };
+    }
+    options.on_error = [](const String& name, const String& message) {
+        warnln("Failed to extract {}: {}", name, message);
+    };
 
-    return success ? 0 : 1;
+    return Archive::extract_zip_archive(zip_file.value(), options) ? 0 : 1;
 }